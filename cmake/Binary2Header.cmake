@@ -186,23 +186,39 @@ Options:
     if(conversion_type MATCHES HEADER)
       bin2h(SOURCE_FILE ${source} HEADER_FILE ${target} ${options})
     elseif(conversion_type MATCHES LOCALES)
-      file(WRITE ${target} "#include <unordered_map>\n")
+      file(WRITE ${target} "#include <string>\n#include <unordered_map>\n#include <utility>\n#include <vector>\n")
       file(GLOB json_files LIST_DIRECTORIES FALSE "${source}/*.json")
       foreach(file ${json_files})
         get_filename_component(name "${file}" NAME)
         bin2h(SOURCE_FILE ${file} HEADER_FILE ${target} VARIABLE_NAME ${name} APPEND RAW)
       endforeach()
 
-      set(map "\nconst std::unordered_map<std::string, std::string> locales_json = {\n")
+      # the json is referenced in place so nothing is copied until a locale is actually used
+      set(map "\nconst std::unordered_map<std::string, std::pair<const unsigned char*, size_t>> locales_json = {\n")
       foreach(file ${json_files})
         get_filename_component(name "${file}" NAME)
         get_filename_component(locale "${file}" NAME_WE)
         string(MAKE_C_IDENTIFIER "${name}" name)
         string(TOLOWER "${name}" name)
-        set(map "${map}    {\"${locale}\", {${name}, ${name} + ${name}_len}},\n")
+        set(map "${map}    {\"${locale}\", {${name}, ${name}_len}},\n")
       endforeach()
       set(map "${map}};\n")
       file(APPEND ${target} "${map}")
+
+      # the aliases are pulled out of the json here so they can be resolved without parsing it
+      set(aliases "\nconst std::vector<std::pair<std::string, std::string>> locales_aliases = {\n")
+      foreach(file ${json_files})
+        get_filename_component(locale "${file}" NAME_WE)
+        file(READ ${file} contents)
+        string(REGEX MATCH "\"aliases\"[ \t\r\n]*:[ \t\r\n]*\\[[^]]*\\]" alias_array "${contents}")
+        string(REGEX REPLACE "^\"aliases\"" "" alias_array "${alias_array}")
+        string(REGEX MATCHALL "\"[^\"]+\"" alias_names "${alias_array}")
+        foreach(alias ${alias_names})
+          set(aliases "${aliases}    {${alias}, \"${locale}\"},\n")
+        endforeach()
+      endforeach()
+      set(aliases "${aliases}};\n")
+      file(APPEND ${target} "${aliases}")
     endif()
   endif()
 endif()
@@ -0,0 +1,40 @@
+#include "baldr/cache_utils.h"
+
+#include <chrono>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+namespace valhalla {
+namespace baldr {
+
+std::string cache_tile_source(const boost::property_tree::ptree& config) {
+  return config.get<std::string>("mjolnir.tile_extract", "") + "|" +
+         config.get<std::string>("mjolnir.tile_dir", "");
+}
+
+std::string cache_time_bucket(const Options& options) {
+  for (const auto& location : options.locations()) {
+    if (location.date_time() == "current") {
+      auto now = std::chrono::duration_cast<std::chrono::seconds>(
+                     std::chrono::system_clock::now().time_since_epoch())
+                     .count();
+      return 'c' + std::to_string(now / kCacheTimeBucket);
+    }
+  }
+  return {};
+}
+
+std::string cache_serialize(const google::protobuf::MessageLite& message) {
+  std::string serialized;
+  {
+    google::protobuf::io::StringOutputStream stream(&serialized);
+    google::protobuf::io::CodedOutputStream coded(&stream);
+    coded.SetSerializationDeterministic(true);
+    message.SerializeToCodedStream(&coded);
+  }
+  return serialized;
+}
+
+} // namespace baldr
+} // namespace valhalla
@@ -23,29 +23,36 @@ constexpr size_t AVERAGE_MM_TILE_SIZE = 1024;         // 1k
 namespace valhalla {
 namespace baldr {
 
+// Definition of the constant GetBinSegments passes by reference
+constexpr uint32_t BinSegments::kNoEdgeInfo;
+
 struct GraphReader::tile_extract_t {
-  tile_extract_t(const boost::property_tree::ptree& pt) {
+  tile_extract_t(const boost::property_tree::ptree& pt) : index(nullptr), index_size(0) {
     // if you really meant to load it
     if (pt.get_optional<std::string>("tile_extract")) {
       try {
-        // load the tar
-        archive.reset(new midgard::tar(pt.get<std::string>("tile_extract")));
-        // map files to graph ids
-        for (auto& c : archive->contents) {
-          try {
-            auto id = GraphTile::GetTileId(c.first);
-            tiles[id] = std::make_pair(const_cast<char*>(c.second.first), c.second.second);
-          } catch (...) {
-            // skip files we dont understand
+        // an indexed extract only needs its first entry, the index, to be read
+        auto tile_extract = pt.get<std::string>("tile_extract");
+        archive.reset(new midgard::tar(tile_extract, true, false));
+        if (!load_index()) {
+          // otherwise load the tar and map files to graph ids
+          archive.reset(new midgard::tar(tile_extract));
+          for (auto& c : archive->contents) {
+            try {
+              auto id = GraphTile::GetTileId(c.first);
+              tiles[id] = std::make_pair(const_cast<char*>(c.second.first), c.second.second);
+            } catch (...) {
+              // skip files we dont understand
+            }
           }
         }
         // couldn't load it
-        if (tiles.empty()) {
+        if (empty()) {
           LOG_WARN("Tile extract contained no usuable tiles");
         } // loaded ok but with possibly bad blocks
         else {
-          LOG_INFO("Tile extract successfully loaded with tile count: " +
-                   std::to_string(tiles.size()));
+          LOG_INFO("Tile extract successfully loaded with tile count: " + std::to_string(size()) +
+                   (index ? " from its index" : ""));
           if (archive->corrupt_blocks) {
             LOG_WARN("Tile extract had " + std::to_string(archive->corrupt_blocks) +
                      " corrupt blocks");
@@ -57,8 +64,78 @@ struct GraphReader::tile_extract_t {
       }
     }
   }
+
+  // Use the index at the start of the extract if it has one
+  bool load_index() {
+    auto found = archive->contents.find(kTileIndexName);
+    if (found == archive->contents.cend() ||
+        found->second.second % sizeof(tile_index_entry_t) != 0) {
+      return false;
+    }
+    const auto* entries = reinterpret_cast<const tile_index_entry_t*>(found->second.first);
+    const size_t count = found->second.second / sizeof(tile_index_entry_t);
+
+    // make sure the index is sorted and within the extract, this only reads the index
+    for (size_t i = 0; i < count; ++i) {
+      if ((i > 0 && entries[i - 1].tile_id >= entries[i].tile_id) ||
+          entries[i].offset + entries[i].size > archive->mm.size()) {
+        LOG_WARN("Tile extract index is invalid, reading the whole extract");
+        return false;
+      }
+    }
+    index = entries;
+    index_size = count;
+    return true;
+  }
+
+  bool empty() const {
+    return index ? index_size == 0 : tiles.empty();
+  }
+
+  size_t size() const {
+    return index ? index_size : tiles.size();
+  }
+
+  // Get the data and size of a tile, the data is nullptr if the tile isnt in the extract
+  std::pair<char*, size_t> find(const GraphId& graphid) const {
+    if (index) {
+      const auto* end = index + index_size;
+      const auto* entry =
+          std::lower_bound(index, end, static_cast<uint32_t>(graphid.value),
+                           [](const tile_index_entry_t& e, uint32_t id) { return e.tile_id < id; });
+      if (entry == end || entry->tile_id != graphid.value) {
+        return {nullptr, 0};
+      }
+      return {archive->mm.get() + entry->offset, entry->size};
+    }
+    auto t = tiles.find(graphid);
+    return t == tiles.cend() ? std::pair<char*, size_t>{nullptr, 0} : t->second;
+  }
+
+  // Get the ids of the tiles, only those on one level if level is not negative
+  std::unordered_set<GraphId> tile_set(const int level = -1) const {
+    std::unordered_set<GraphId> ids;
+    auto add = [&ids, level](const GraphId& id) {
+      if (level < 0 || id.level() == static_cast<uint32_t>(level)) {
+        ids.emplace(id);
+      }
+    };
+    if (index) {
+      for (size_t i = 0; i < index_size; ++i) {
+        add(GraphId(index[i].tile_id));
+      }
+    } else {
+      for (const auto& t : tiles) {
+        add(GraphId(t.first));
+      }
+    }
+    return ids;
+  }
+
   // TODO: dont remove constness, and actually make graphtile read only?
   std::unordered_map<uint64_t, std::pair<char*, size_t>> tiles;
+  const tile_index_entry_t* index; // Sorted index of the tiles of an indexed extract
+  size_t index_size;
   std::shared_ptr<midgard::tar> archive;
 };
 
@@ -274,6 +351,79 @@ SynchronizedTileCache::Put(const GraphId& graphid, const GraphTile& tile, size_t
   return cache_.Put(graphid, tile, size);
 }
 
+// ----------------------------------------------------------------------------
+// SharedTileCache implementation
+// ----------------------------------------------------------------------------
+
+// Constructor.
+SharedTileCache::SharedTileCache(size_t max_size)
+    : cache_(max_size), users_(0), trim_pending_(false) {
+}
+
+// Reserves enough cache to hold (max_cache_size / tile_size) items.
+void SharedTileCache::Reserve(size_t tile_size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  cache_.Reserve(tile_size);
+}
+
+// Checks if tile exists in the cache.
+bool SharedTileCache::Contains(const GraphId& graphid) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.Contains(graphid);
+}
+
+// Lets you know if the cache is too large.
+bool SharedTileCache::OverCommitted() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.OverCommitted();
+}
+
+// Clears the cache, or leaves it to the last user to release it.
+void SharedTileCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (users_ == 0) {
+    cache_.Clear();
+  } else {
+    trim_pending_ = true;
+  }
+}
+
+// Same as Clear, the simple cache has no better way to trim.
+void SharedTileCache::Trim() {
+  Clear();
+}
+
+// Get a pointer to a graph tile object given a GraphId.
+const GraphTile* SharedTileCache::Get(const GraphId& graphid) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.Get(graphid);
+}
+
+// Puts a copy of a tile of into the cache. The simple cache never evicts on a put.
+const GraphTile* SharedTileCache::Put(const GraphId& graphid, const GraphTile& tile, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return cache_.Put(graphid, tile, size);
+}
+
+// Marks the start of the use of the cache by a thread.
+void SharedTileCache::Acquire() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  released_.wait(lock, [this]() { return !trim_pending_; });
+  ++users_;
+}
+
+// Marks the end of the use of the cache by a thread.
+void SharedTileCache::Release() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--users_ == 0 && trim_pending_) {
+      cache_.Clear();
+      trim_pending_ = false;
+    }
+  }
+  released_.notify_all();
+}
+
 // Constructs tile cache.
 TileCache* TileCacheFactory::createTileCache(const boost::property_tree::ptree& pt) {
   size_t max_cache_size = pt.get<size_t>("max_cache_size", DEFAULT_MAX_CACHE_SIZE);
@@ -308,20 +458,31 @@ TileCache* TileCacheFactory::createTileCache(const boost::property_tree::ptree&
   return new SimpleTileCache(max_cache_size);
 }
 
+// Constructs a tile cache to be shared by a group of threads.
+SharedTileCache* TileCacheFactory::createSharedTileCache(const boost::property_tree::ptree& pt) {
+  return new SharedTileCache(pt.get<size_t>("max_cache_size", DEFAULT_MAX_CACHE_SIZE));
+}
+
 // Constructor using separate tile files
 GraphReader::GraphReader(const boost::property_tree::ptree& pt)
+    : GraphReader(pt, std::shared_ptr<TileCache>(TileCacheFactory::createTileCache(pt))) {
+}
+
+// Constructor using a given tile cache
+GraphReader::GraphReader(const boost::property_tree::ptree& pt,
+                         const std::shared_ptr<TileCache>& cache)
     : tile_extract_(get_extract_instance(pt)), tile_dir_(pt.get<std::string>("tile_dir", "")),
       curlers_(std::make_unique<curler_pool_t>(pt.get<size_t>("max_concurrent_reader_users", 1),
                                                pt.get<std::string>("user_agent", ""))),
       tile_url_(pt.get<std::string>("tile_url", "")),
       tile_url_gz_(pt.get<bool>("tile_url_gz", false)),
-      cache_(TileCacheFactory::createTileCache(pt)) {
+      cache_(cache), cache_bin_segments_(pt.get<bool>("cache_bin_segments", false)) {
   // validate tile url
   if (!tile_url_.empty() && tile_url_.find(GraphTile::kTilePathPattern) == std::string::npos)
     throw std::runtime_error("Not found tilePath pattern in tile url");
   // Reserve cache (based on whether using individual tile files or shared,
   // mmap'd file
-  cache_->Reserve(tile_extract_->tiles.empty() ? AVERAGE_TILE_SIZE : AVERAGE_MM_TILE_SIZE);
+  cache_->Reserve(tile_extract_->empty() ? AVERAGE_TILE_SIZE : AVERAGE_MM_TILE_SIZE);
 }
 
 // Method to test if tile exists
@@ -330,8 +491,8 @@ bool GraphReader::DoesTileExist(const GraphId& graphid) const {
     return false;
   }
   // if you are using an extract only check that
-  if (!tile_extract_->tiles.empty()) {
-    return tile_extract_->tiles.find(graphid) != tile_extract_->tiles.cend();
+  if (!tile_extract_->empty()) {
+    return tile_extract_->find(graphid).first != nullptr;
   }
   // otherwise check memory or disk
   if (cache_->Contains(graphid)) {
@@ -352,8 +513,8 @@ bool GraphReader::DoesTileExist(const boost::property_tree::ptree& pt, const Gra
   }
   // if you are using an extract only check that
   auto extract = get_extract_instance(pt);
-  if (!extract->tiles.empty()) {
-    return extract->tiles.find(graphid) != extract->tiles.cend();
+  if (!extract->empty()) {
+    return extract->find(graphid).first != nullptr;
   }
   // otherwise check the disk
   std::string file_location = pt.get<std::string>("tile_dir") +
@@ -382,16 +543,16 @@ const GraphTile* GraphReader::GetGraphTile(const GraphId& graphid) {
   }
 
   // Try getting it from the memmapped tar extract
-  if (!tile_extract_->tiles.empty()) {
+  if (!tile_extract_->empty()) {
     // Do we have this tile
-    auto t = tile_extract_->tiles.find(base);
-    if (t == tile_extract_->tiles.cend()) {
+    auto t = tile_extract_->find(base);
+    if (t.first == nullptr) {
       // LOG_DEBUG("Memory map cache miss " + GraphTile::FileSuffix(base));
       return nullptr;
     }
 
     // This initializes the tile from mmap
-    GraphTile tile(base, t->second.first, t->second.second);
+    GraphTile tile(base, t.first, t.second);
     if (!tile.header()) {
       // LOG_DEBUG("Memory map cache miss " + GraphTile::FileSuffix(base));
       return nullptr;
@@ -440,6 +601,50 @@ const GraphTile* GraphReader::GetGraphTile(const GraphId& graphid) {
   }
 }
 
+// Get the decoded segments of a bin, building them on first use
+std::shared_ptr<const BinSegments> GraphReader::GetBinSegments(const GraphTile* tile, size_t bin) {
+  if (!cache_bin_segments_ || !tile) {
+    return nullptr;
+  }
+  auto cached = tile->bin_segments(bin);
+  if (cached) {
+    return cached;
+  }
+
+  // copy the edges out first, getting the tiles they are in could evict this one
+  auto segments = std::make_shared<BinSegments>();
+  auto bin_edges = tile->GetBin(bin);
+  segments->edges.assign(bin_edges.begin(), bin_edges.end());
+  const auto tile_id = tile->id();
+
+  segments->edgeinfo_offsets.reserve(segments->edges.size());
+  segments->point_offsets.reserve(segments->edges.size() + 1);
+  const GraphTile* edge_tile = nullptr;
+  for (const auto& edge_id : segments->edges) {
+    segments->point_offsets.push_back(segments->lngs.size());
+    // the searcher skips edges whose tile it cant get so these dont need any points
+    if (!GetGraphTile(edge_id, edge_tile)) {
+      segments->edgeinfo_offsets.push_back(BinSegments::kNoEdgeInfo);
+      continue;
+    }
+    const auto* edge = edge_tile->directededge(edge_id);
+    segments->edgeinfo_offsets.push_back(edge->edgeinfo_offset());
+    auto shape = edge_tile->edgeinfo(edge->edgeinfo_offset()).lazy_shape();
+    while (!shape.empty()) {
+      auto point = shape.pop();
+      segments->lngs.push_back(point.lng());
+      segments->lats.push_back(point.lat());
+    }
+  }
+  segments->point_offsets.push_back(segments->lngs.size());
+
+  // keep them with the cached copy of the tile
+  if ((tile = GetGraphTile(tile_id))) {
+    tile->set_bin_segments(bin, segments);
+  }
+  return segments;
+}
+
 // Convenience method to get an opposing directed edge graph Id.
 GraphId GraphReader::GetOpposingEdgeId(const GraphId& edgeid, const GraphTile*& tile) {
   // If you cant get the tile you get an invalid id
@@ -755,10 +960,8 @@ std::string GraphReader::encoded_edge_shape(const valhalla::baldr::GraphId& edge
 std::unordered_set<GraphId> GraphReader::GetTileSet() const {
   // either mmap'd tiles
   std::unordered_set<GraphId> tiles;
-  if (tile_extract_->tiles.size()) {
-    for (const auto& t : tile_extract_->tiles) {
-      tiles.emplace(t.first);
-    }
+  if (!tile_extract_->empty()) {
+    tiles = tile_extract_->tile_set();
   } // or individually on disk
   else if (!tile_dir_.empty()) {
     // for each level
@@ -788,12 +991,9 @@ std::unordered_set<GraphId> GraphReader::GetTileSet() const {
 std::unordered_set<GraphId> GraphReader::GetTileSet(const uint8_t level) const {
   // either mmap'd tiles
   std::unordered_set<GraphId> tiles;
-  if (tile_extract_->tiles.size()) {
-    for (const auto& t : tile_extract_->tiles) {
-      if (static_cast<GraphId>(t.first).level() == level) {
-        tiles.emplace(t.first);
-      }
-    } // or individually on disk
+  if (!tile_extract_->empty()) {
+    tiles = tile_extract_->tile_set(level);
+    // or individually on disk
   } else if (!tile_dir_.empty()) {
     // crack open this level of tiles directory
     filesystem::path root_dir(tile_dir_ + filesystem::path::preferred_separator +
@@ -52,7 +52,8 @@ GraphTile::GraphTile()
       complex_restriction_reverse_(nullptr), edgeinfo_(nullptr), textlist_(nullptr),
       complex_restriction_forward_size_(0), complex_restriction_reverse_size_(0), edgeinfo_size_(0),
       textlist_size_(0), lane_connectivity_(nullptr), lane_connectivity_size_(0),
-      turnlanes_(nullptr) {
+      turnlanes_(nullptr), edge_reach_(nullptr), node_components_(nullptr),
+      node_component_count_(0) {
 }
 
 // Constructor given a filename. Reads the graph data into memory.
@@ -313,10 +314,29 @@ void GraphTile::Initialize(const GraphId& graphid, char* tile_ptr, const size_t
     predictedspeeds_.set_profiles(reinterpret_cast<int16_t*>(ptr2));
 
     lane_connectivity_size_ = header_->predictedspeeds_offset() - header_->lane_connectivity_offset();
+  } else if (header_->reach_offset() > 0) {
+    lane_connectivity_size_ = header_->reach_offset() - header_->lane_connectivity_offset();
+  } else if (header_->component_offset() > 0) {
+    lane_connectivity_size_ = header_->component_offset() - header_->lane_connectivity_offset();
   } else {
     lane_connectivity_size_ = header_->end_offset() - header_->lane_connectivity_offset();
   }
 
+  // Start of the edge reach computed at build time (only node components can follow it)
+  edge_reach_ = header_->reach_offset() > 0
+                    ? reinterpret_cast<EdgeReach*>(tile_ptr + header_->reach_offset())
+                    : nullptr;
+
+  // Node components computed at build time (they are after the edge reach at the end of the tile)
+  if (header_->component_offset() > 0) {
+    node_components_ = reinterpret_cast<NodeComponent*>(tile_ptr + header_->component_offset());
+    node_component_count_ =
+        (header_->end_offset() - header_->component_offset()) / sizeof(NodeComponent);
+  } else {
+    node_components_ = nullptr;
+    node_component_count_ = 0;
+  }
+
   // For reference - how to use the end offset to set size of an object (that
   // is not fixed size and count).
   // example_size_ = header_->end_offset() - header_->example_offset();
@@ -745,6 +765,22 @@ std::vector<LaneConnectivity> GraphTile::GetLaneConnectivity(const uint32_t idx)
   return lcs;
 }
 
+// Get the connected component of a node. Only the nodes outside of the main component
+// are stored (sorted by node and mode) so binary search for the node.
+const NodeComponent* GraphTile::node_component(const uint32_t idx, const size_t mode) const {
+  if (node_components_ == nullptr) {
+    return nullptr;
+  }
+  const NodeComponent key(idx, mode);
+  const NodeComponent* begin = node_components_;
+  const NodeComponent* end = begin + node_component_count_;
+  const auto* found = std::lower_bound(begin, end, key);
+  if (found != end && found->node() == idx && found->mode() == mode) {
+    return found;
+  }
+  return &NodeComponent::main();
+}
+
 // Get the next departure given the directed line Id and the current
 // time (seconds from midnight).
 const TransitDeparture* GraphTile::GetNextDeparture(const uint32_t lineid,
@@ -886,8 +922,8 @@ const TransitDeparture* GraphTile::GetTransitDeparture(const uint32_t lineid,
     }
   }
 
-  LOG_INFO("No departures found for lineid = " + std::to_string(lineid) +
-           " and tripid = " + std::to_string(tripid));
+  LOG_DEBUG("No departures found for lineid = " + std::to_string(lineid) +
+            " and tripid = " + std::to_string(tripid));
   return nullptr;
 }
 
@@ -1011,6 +1047,19 @@ midgard::iterable_t<GraphId> GraphTile::GetBin(size_t index) const {
   return iterable_t<GraphId>{edge_bins_ + offsets.first, edge_bins_ + offsets.second};
 }
 
+// Keep the decoded segments of a bin, allocating the bins on first use
+void GraphTile::set_bin_segments(size_t index, std::shared_ptr<const BinSegments> segments) const {
+  auto bins = std::atomic_load(&bin_segments_);
+  if (!bins) {
+    // if another thread allocated them first bins is set to theirs
+    auto created = std::make_shared<BinSegmentsArray>();
+    if (std::atomic_compare_exchange_strong(&bin_segments_, &bins, created)) {
+      bins = std::move(created);
+    }
+  }
+  std::atomic_store(&(*bins)[index], std::move(segments));
+}
+
 // Get turn lanes for this edge.
 uint32_t GraphTile::turnlanes_offset(const uint32_t idx) const {
   uint32_t count = header_->turnlane_count();
@@ -3,12 +3,18 @@
 #include <boost/optional.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/shared_ptr.hpp>
+#include <condition_variable>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <napi.h>
 #include <sstream>
 #include <string>
+#include <vector>
 
+#include "baldr/graphreader.h"
 #include "baldr/rapidjson_utils.h"
 #include "midgard/logging.h"
 #include "midgard/util.h"
@@ -27,23 +33,123 @@ boost::property_tree::ptree make_conf(const char* config) {
   return json_to_pt(config);
 }
 
+// the number of threads libuv runs async work on, so the most actors that can be busy at once
+size_t uv_threadpool_size() {
+  const char* size = std::getenv("UV_THREADPOOL_SIZE");
+  try {
+    return size ? std::min(std::max(std::stoul(size), 1ul), 1024ul) : 4;
+  } catch (...) { return 4; }
+}
+
+// Independent actors, each with its own workers and graph reader, so that concurrent calls don't
+// share any state. Their readers share the pool's tile cache, which no actor trims while another is
+// still using its tiles. Actors are made as calls need them, up to the max, after which calls wait
+// for one to be released.
+class ActorPool {
+public:
+  ActorPool(const boost::property_tree::ptree& conf, size_t max_size)
+      : config(conf), max_size(max_size),
+        cache(valhalla::baldr::TileCacheFactory::createSharedTileCache(
+            conf.get_child("mjolnir"))) {
+    // make the first one right away so a bad config is reported to the constructor
+    actors.emplace_back(make_actor());
+    idle.push_back(actors.back().get());
+  }
+
+  // an actor reserved for as long as the lease lives, along with the tiles it gets from the cache
+  class Lease {
+  public:
+    explicit Lease(ActorPool& pool) : pool(pool), actor(pool.acquire()) {
+      pool.cache->Acquire();
+    }
+    ~Lease() {
+      pool.cache->Release();
+      pool.release(actor);
+    }
+    valhalla::tyr::actor_t& operator*() const {
+      return *actor;
+    }
+
+  private:
+    ActorPool& pool;
+    valhalla::tyr::actor_t* actor;
+  };
+
+private:
+  valhalla::tyr::actor_t* make_actor() const {
+    auto reader =
+        std::make_shared<valhalla::baldr::GraphReader>(config.get_child("mjolnir"), cache);
+    return new valhalla::tyr::actor_t(config, reader, true);
+  }
+
+  valhalla::tyr::actor_t* acquire() {
+    std::unique_lock<std::mutex> l(lock);
+    released.wait(l, [this]() { return !idle.empty() || actors.size() + making < max_size; });
+    if (!idle.empty()) {
+      auto* actor = idle.back();
+      idle.pop_back();
+      return actor;
+    }
+
+    // make a new one outside of the lock, opening the tiles takes a while
+    ++making;
+    l.unlock();
+    std::unique_ptr<valhalla::tyr::actor_t> actor;
+    try {
+      actor.reset(make_actor());
+    } catch (...) {
+      l.lock();
+      --making;
+      released.notify_one();
+      throw;
+    }
+    l.lock();
+    --making;
+    actors.emplace_back(std::move(actor));
+    return actors.back().get();
+  }
+
+  void release(valhalla::tyr::actor_t* actor) {
+    {
+      std::lock_guard<std::mutex> _(lock);
+      idle.push_back(actor);
+    }
+    released.notify_one();
+  }
+
+  boost::property_tree::ptree config;
+  size_t max_size;
+  std::shared_ptr<valhalla::baldr::SharedTileCache> cache;
+  size_t making = 0;
+  std::vector<std::unique_ptr<valhalla::tyr::actor_t>> actors;
+  std::vector<valhalla::tyr::actor_t*> idle;
+  std::mutex lock;
+  std::condition_variable released;
+};
+
 class ActorWorker : public Napi::AsyncWorker {
 public:
   ActorWorker(Napi::Function& callback,
               const std::string request,
-              valhalla::tyr::actor_t& actor,
+              const std::shared_ptr<ActorPool>& pool,
               const std::function<std::string(valhalla::tyr::actor_t& actor,
                                               const std::string& request)>& func)
-      : Napi::AsyncWorker(callback), request(request), actor(actor), func(func) {
+      : Napi::AsyncWorker(callback), request(request), pool(pool), func(func) {
   }
   ~ActorWorker() {
   }
 
   void Execute() {
     try {
-      response = func(actor, request);
+      ActorPool::Lease lease(*pool);
+      auto& actor = *lease;
+      try {
+        response = func(actor, request);
+      } catch (...) {
+        actor.cleanup();
+        throw;
+      }
     } catch (const valhalla::valhalla_exception_t& e) {
-      actor.cleanup();
       rapidjson::StringBuffer err_message;
       rapidjson::Writer<rapidjson::StringBuffer> writer(err_message);
 
@@ -56,10 +162,7 @@ public:
       writer.String(e.message);
       writer.EndObject();
       throw std::runtime_error(err_message.GetString());
-    } catch (const std::exception& e) {
-      actor.cleanup();
-      throw std::runtime_error(e.what());
-    }
+    } catch (const std::exception& e) { throw std::runtime_error(e.what()); }
   }
 
   void OnOK() {
@@ -72,7 +175,7 @@ public:
     Callback().MakeCallback(Receiver().Value(), {e.Value(), env.Undefined()});
   }
 
-  valhalla::tyr::actor_t actor;
+  std::shared_ptr<ActorPool> pool;
   std::function<std::string(valhalla::tyr::actor_t& actor, std::string& request)> func;
 
 private:
@@ -124,7 +227,8 @@ public:
   };
 
   Actor(const Napi::CallbackInfo& info)
-      : actor(get_conf_from_info(info), true), Napi::ObjectWrap<Actor>(info) {
+      : pool(std::make_shared<ActorPool>(get_conf_from_info(info), uv_threadpool_size())),
+        Napi::ObjectWrap<Actor>(info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
 
@@ -157,7 +261,7 @@ private:
     const std::string req = std::string(info[0].As<Napi::String>());
     Napi::Function callback = info[1].As<Napi::Function>();
 
-    ActorWorker* actorWorker = new ActorWorker(callback, req, actor, actor_func);
+    ActorWorker* actorWorker = new ActorWorker(callback, req, pool, actor_func);
     actorWorker->Queue();
     return info.Env().Undefined();
   }
@@ -222,7 +326,7 @@ private:
                               -> std::string { return actor.expansion(request); });
   }
 
-  valhalla::tyr::actor_t actor;
+  std::shared_ptr<ActorPool> pool;
 };
 
 Napi::FunctionReference Actor::constructor;
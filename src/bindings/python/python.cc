@@ -1,15 +1,24 @@
 // Note: keep include boost/python.hpp first - fixes https://bugs.python.org/issue10910 on
 // FreeBSD/macOS
 #include <boost/python.hpp>
+#include <boost/python/stl_iterator.hpp>
 
+#include "baldr/graphreader.h"
 #include "baldr/rapidjson_utils.h"
 #include <boost/make_shared.hpp>
 #include <boost/noncopyable.hpp>
 #include <boost/optional.hpp>
 #include <boost/property_tree/ptree.hpp>
 #include <boost/shared_ptr.hpp>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include "midgard/logging.h"
 #include "midgard/util.h"
@@ -53,16 +62,190 @@ void py_configure(const std::string& config_file) {
   configure(config_file);
 }
 
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(route_overloads, route, 1, 1);
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(locate_overloads, locate, 1, 1);
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(optimized_route_overloads, optimized_route, 1, 1);
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(matrix_overloads, matrix, 1, 1);
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(isochrone_overloads, isochrone, 1, 1);
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(trace_route_overloads, trace_route, 1, 1);
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(trace_attributes_overloads, trace_attributes, 1, 1);
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(height_overloads, height, 1, 1);
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(transit_available_overloads, transit_available, 1, 1);
-BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(expansion_overloads, expansion, 1, 1);
+// releases the gil for as long as it lives so other python threads can run while we work
+struct gil_release_t {
+  gil_release_t() : state(PyEval_SaveThread()) {
+  }
+  ~gil_release_t() {
+    PyEval_RestoreThread(state);
+  }
+  PyThreadState* state;
+};
+
+// keeps the tiles a thread gets from a shared tile cache valid for as long as it lives
+struct cache_use_t {
+  explicit cache_use_t(valhalla::baldr::SharedTileCache& cache) : cache(cache) {
+    cache.Acquire();
+  }
+  ~cache_use_t() {
+    cache.Release();
+  }
+  valhalla::baldr::SharedTileCache& cache;
+};
+
+using action_t = std::string (valhalla::tyr::actor_t::*)(const std::string&,
+                                                         const std::function<void()>&);
+
+template <action_t action>
+std::string act(valhalla::tyr::actor_t& actor, const std::string& request) {
+  gil_release_t _;
+  return (actor.*action)(request, []() -> void {});
+}
+
+// the responses of a list of requests handed to the pool, iterated in the order of the requests
+// or as (index, response) tuples in the order they complete
+class batch_t {
+public:
+  batch_t(action_t action, std::vector<std::string>&& requests, bool ordered)
+      : action(action), requests(std::move(requests)), ordered(ordered),
+        responses(this->requests.size()), errors(this->requests.size()),
+        finished(this->requests.size(), false), yielded(0) {
+  }
+
+  // called from the pool's threads
+  void run(size_t index, valhalla::tyr::actor_t& actor) {
+    std::string response;
+    std::exception_ptr error;
+    try {
+      response = (actor.*action)(requests[index], []() -> void {});
+    } catch (...) { error = std::current_exception(); }
+    std::lock_guard<std::mutex> _(lock);
+    responses[index] = std::move(response);
+    errors[index] = error;
+    finished[index] = true;
+    completed.push_back(index);
+    done.notify_all();
+  }
+
+  boost::python::object next() {
+    size_t index;
+    {
+      gil_release_t _;
+      std::unique_lock<std::mutex> l(lock);
+      if (yielded == requests.size()) {
+        index = requests.size();
+      } else if (ordered) {
+        index = yielded;
+        done.wait(l, [this, index]() { return finished[index]; });
+      } else {
+        done.wait(l, [this]() { return !completed.empty(); });
+        index = completed.front();
+        completed.pop_front();
+      }
+      yielded += index < requests.size();
+    }
+
+    if (index == requests.size()) {
+      PyErr_SetString(PyExc_StopIteration, "No more responses");
+      boost::python::throw_error_already_set();
+    }
+    // a failed request raises when it comes up, the ones after it can still be iterated
+    if (errors[index]) {
+      std::rethrow_exception(errors[index]);
+    }
+    boost::python::str response(responses[index]);
+    std::string().swap(responses[index]);
+    if (ordered) {
+      return std::move(response);
+    }
+    return boost::python::make_tuple(index, response);
+  }
+
+  size_t size() const {
+    return requests.size();
+  }
+
+protected:
+  action_t action;
+  std::vector<std::string> requests;
+  bool ordered;
+  std::vector<std::string> responses;
+  std::vector<std::exception_ptr> errors;
+  std::vector<bool> finished;
+  std::deque<size_t> completed;
+  size_t yielded;
+  std::mutex lock;
+  std::condition_variable done;
+};
+
+// a fixed set of threads each with its own actor, all of them sharing the pool's tile cache which
+// is never trimmed while one of them is using its tiles
+class actor_pool_t {
+public:
+  actor_pool_t(const boost::property_tree::ptree& config, size_t threads)
+      : cache(valhalla::baldr::TileCacheFactory::createSharedTileCache(
+            config.get_child("mjolnir"))),
+        stopping(false) {
+    if (threads == 0) {
+      threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    actors.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+      auto reader =
+          std::make_shared<valhalla::baldr::GraphReader>(config.get_child("mjolnir"), cache);
+      actors.emplace_back(config, reader, true);
+    }
+    for (auto& actor : actors) {
+      workers.emplace_back(&actor_pool_t::work, this, std::ref(actor));
+    }
+  }
+
+  // finishes the outstanding requests before returning so batches still being iterated complete
+  ~actor_pool_t() {
+    {
+      std::lock_guard<std::mutex> _(lock);
+      stopping = true;
+    }
+    queued.notify_all();
+    gil_release_t _;
+    for (auto& worker : workers) {
+      worker.join();
+    }
+  }
+
+  template <action_t action>
+  static boost::shared_ptr<batch_t>
+  submit(actor_pool_t& pool, const boost::python::object& requests, bool ordered) {
+    std::vector<std::string> request_strs;
+    boost::python::stl_input_iterator<std::string> begin(requests), end;
+    request_strs.assign(begin, end);
+    auto batch = boost::make_shared<batch_t>(action, std::move(request_strs), ordered);
+    {
+      std::lock_guard<std::mutex> _(pool.lock);
+      for (size_t i = 0; i < batch->size(); ++i) {
+        pool.tasks.emplace_back(batch, i);
+      }
+    }
+    pool.queued.notify_all();
+    return batch;
+  }
+
+protected:
+  void work(valhalla::tyr::actor_t& actor) {
+    while (true) {
+      std::pair<boost::shared_ptr<batch_t>, size_t> task;
+      {
+        std::unique_lock<std::mutex> l(lock);
+        queued.wait(l, [this]() { return stopping || !tasks.empty(); });
+        if (tasks.empty()) {
+          return;
+        }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      cache_use_t _(*cache);
+      task.first->run(task.second, actor);
+    }
+  }
+
+  std::shared_ptr<valhalla::baldr::SharedTileCache> cache;
+  std::vector<valhalla::tyr::actor_t> actors;
+  std::vector<std::thread> workers;
+  std::deque<std::pair<boost::shared_ptr<batch_t>, size_t>> tasks;
+  bool stopping;
+  std::mutex lock;
+  std::condition_variable queued;
+};
 } // namespace
 
 BOOST_PYTHON_MODULE(valhalla) {
@@ -75,16 +258,50 @@ BOOST_PYTHON_MODULE(valhalla) {
       .def("__init__", boost::python::make_constructor(+[]() {
              return boost::make_shared<valhalla::tyr::actor_t>(configure(), true);
            }))
-      .def("Route", &valhalla::tyr::actor_t::route, route_overloads())
-      .def("Locate", &valhalla::tyr::actor_t::route, locate_overloads())
-      .def("OptimizedRoute", &valhalla::tyr::actor_t::route, optimized_route_overloads())
-      .def("Matrix", &valhalla::tyr::actor_t::route, matrix_overloads())
-      .def("Isochrone", &valhalla::tyr::actor_t::route, isochrone_overloads())
-      .def("TraceRoute", &valhalla::tyr::actor_t::route, trace_route_overloads())
-      .def("TraceAttributes", &valhalla::tyr::actor_t::route, trace_attributes_overloads())
-      .def("Height", &valhalla::tyr::actor_t::route, height_overloads())
-      .def("TransitAvailable", &valhalla::tyr::actor_t::route, transit_available_overloads())
-      .def("Expansion", &valhalla::tyr::actor_t::route, expansion_overloads())
+      .def("Route", &act<&valhalla::tyr::actor_t::route>)
+      .def("Locate", &act<&valhalla::tyr::actor_t::locate>)
+      .def("OptimizedRoute", &act<&valhalla::tyr::actor_t::optimized_route>)
+      .def("Matrix", &act<&valhalla::tyr::actor_t::matrix>)
+      .def("Isochrone", &act<&valhalla::tyr::actor_t::isochrone>)
+      .def("TraceRoute", &act<&valhalla::tyr::actor_t::trace_route>)
+      .def("TraceAttributes", &act<&valhalla::tyr::actor_t::trace_attributes>)
+      .def("Height", &act<&valhalla::tyr::actor_t::height>)
+      .def("TransitAvailable", &act<&valhalla::tyr::actor_t::transit_available>)
+      .def("Expansion", &act<&valhalla::tyr::actor_t::expansion>)
 
       ;
+
+  // iterator over the responses of a batch of requests
+  boost::python::class_<batch_t, boost::noncopyable, boost::shared_ptr<batch_t>>(
+      "Batch", boost::python::no_init)
+      .def("__iter__", +[](const boost::python::object& self) { return self; })
+      .def("__next__", &batch_t::next)
+      .def("next", &batch_t::next)
+      .def("__len__", &batch_t::size);
+
+  // python interface for running lists of requests on a pool of threads, each batch method takes
+  // an iterable of requests and returns a Batch, its responses are in request order unless ordered
+  // is False in which case they are (index, response) tuples as soon as each one completes
+  using pool_t = actor_pool_t;
+  auto batch_args = (boost::python::arg("requests"), boost::python::arg("ordered") = true);
+  boost::python::class_<pool_t, boost::noncopyable, boost::shared_ptr<pool_t>>(
+      "ActorPool", boost::python::no_init)
+      .def("__init__", boost::python::make_constructor(
+                           +[](size_t threads) {
+                             return boost::make_shared<pool_t>(configure(), threads);
+                           },
+                           boost::python::default_call_policies(),
+                           (boost::python::arg("threads") = 0)))
+      .def("Route", &pool_t::submit<&valhalla::tyr::actor_t::route>, batch_args)
+      .def("Locate", &pool_t::submit<&valhalla::tyr::actor_t::locate>, batch_args)
+      .def("OptimizedRoute", &pool_t::submit<&valhalla::tyr::actor_t::optimized_route>, batch_args)
+      .def("Matrix", &pool_t::submit<&valhalla::tyr::actor_t::matrix>, batch_args)
+      .def("Isochrone", &pool_t::submit<&valhalla::tyr::actor_t::isochrone>, batch_args)
+      .def("TraceRoute", &pool_t::submit<&valhalla::tyr::actor_t::trace_route>, batch_args)
+      .def("TraceAttributes", &pool_t::submit<&valhalla::tyr::actor_t::trace_attributes>,
+           batch_args)
+      .def("Height", &pool_t::submit<&valhalla::tyr::actor_t::height>, batch_args)
+      .def("TransitAvailable", &pool_t::submit<&valhalla::tyr::actor_t::transit_available>,
+           batch_args)
+      .def("Expansion", &pool_t::submit<&valhalla::tyr::actor_t::expansion>, batch_args);
 }
@@ -1,6 +1,7 @@
 #include "loki/worker.h"
 #include "midgard/encoded.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include "tyr/serializers.h"
 
 using namespace valhalla;
@@ -80,7 +81,8 @@ std::string loki_worker_t::height(Api& request) {
   // get the elevation of each posting
   std::vector<double> heights = sample.get_all(shape);
   if (!request.options().do_not_track()) {
-    valhalla::midgard::logging::Log("sample_count::" + std::to_string(shape.size()), " [ANALYTICS] ");
+    midgard::metrics::Observe("valhalla_height_samples", shape.size(), {},
+                              midgard::metrics::kSizeBounds);
   }
 
   // get the distances between the postings if desired
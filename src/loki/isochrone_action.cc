@@ -3,6 +3,7 @@
 #include "loki/search.h"
 #include "loki/worker.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 
 using namespace valhalla;
 using namespace valhalla::baldr;
@@ -75,16 +76,15 @@ void loki_worker_t::isochrones(Api& request) {
   auto max_location_distance = std::numeric_limits<float>::min();
   check_distance(options.locations(), max_distance.find("isochrone")->second, max_location_distance);
   if (!options.do_not_track()) {
-    valhalla::midgard::logging::Log("max_location_distance::" +
-                                        std::to_string(max_location_distance * midgard::kKmPerMeter) +
-                                        "km",
-                                    " [ANALYTICS] ");
+    midgard::metrics::Observe("valhalla_location_distance_km",
+                              max_location_distance * midgard::kKmPerMeter,
+                              {{"action", "isochrone"}}, midgard::metrics::kSizeBounds);
   }
 
   try {
     // correlate the various locations to the underlying graph
     auto locations = PathLocation::fromPBF(options.locations());
-    const auto projections = loki::Search(locations, *reader, costing);
+    const auto projections = search(locations, options);
     for (size_t i = 0; i < locations.size(); ++i) {
       const auto& projection = projections.at(locations[i]);
       PathLocation::toPBF(projection, options.mutable_locations(i), *reader);
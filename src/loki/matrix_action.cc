@@ -7,6 +7,7 @@
 #include "baldr/rapidjson_utils.h"
 #include "baldr/tilehierarchy.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include "tyr/actor.h"
 
 using namespace valhalla;
@@ -115,7 +116,7 @@ void loki_worker_t::matrix(Api& request) {
   // correlate the various locations to the underlying graph
   std::unordered_map<size_t, size_t> color_counts;
   try {
-    const auto searched = loki::Search(sources_targets, *reader, costing);
+    const auto searched = search(sources_targets, options);
     for (size_t i = 0; i < sources_targets.size(); ++i) {
       const auto& l = sources_targets[i];
       const auto& projection = searched.at(l);
@@ -142,6 +143,23 @@ void loki_worker_t::matrix(Api& request) {
     }
   } catch (const std::exception&) { throw valhalla_exception_t{171}; }
 
+  // can any of the sources reach any of the targets
+  bool reachable = false;
+  for (const auto& source : options.sources()) {
+    for (const auto& target : options.targets()) {
+      if (connected(source, target)) {
+        reachable = true;
+        break;
+      }
+    }
+    if (reachable) {
+      break;
+    }
+  }
+  if (!reachable) {
+    throw valhalla_exception_t{170};
+  }
+
   // are all the locations in the same color regions
   if (!connectivity_map) {
     return;
@@ -157,10 +175,10 @@ void loki_worker_t::matrix(Api& request) {
     throw valhalla_exception_t{170};
   };
   if (!options.do_not_track()) {
-    valhalla::midgard::logging::Log("max_location_distance::" +
-                                        std::to_string(max_location_distance * midgard::kKmPerMeter) +
-                                        "km",
-                                    " [ANALYTICS] ");
+    midgard::metrics::Observe("valhalla_location_distance_km",
+                              max_location_distance * midgard::kKmPerMeter,
+                              {{"action", Options_Action_Enum_Name(options.action())}},
+                              midgard::metrics::kSizeBounds);
   }
 }
 } // namespace loki
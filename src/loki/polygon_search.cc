@@ -0,0 +1,194 @@
+#include "loki/polygon_search.h"
+#include "baldr/tilehierarchy.h"
+#include "midgard/aabb2.h"
+#include "midgard/pointll.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace valhalla::baldr;
+using namespace valhalla::midgard;
+
+namespace {
+
+using ring_t = std::vector<PointLL>;
+
+// Get the points of a ring, closing it if needed
+ring_t to_ring(const valhalla::Ring& ring) {
+  ring_t points;
+  points.reserve(ring.coords_size() + 1);
+  for (const auto& ll : ring.coords()) {
+    points.emplace_back(ll.lng(), ll.lat());
+  }
+  if (!points.empty() && points.front() != points.back()) {
+    points.push_back(points.front());
+  }
+  return points;
+}
+
+// Which side of the line through a and b the point p is on (> 0 left, < 0 right, 0 on the line)
+double side(const PointLL& a, const PointLL& b, const PointLL& p) {
+  return (static_cast<double>(b.lng()) - a.lng()) * (static_cast<double>(p.lat()) - a.lat()) -
+         (static_cast<double>(b.lat()) - a.lat()) * (static_cast<double>(p.lng()) - a.lng());
+}
+
+// Is p, known to be on the line through a and b, within the segment from a to b
+bool within(const PointLL& a, const PointLL& b, const PointLL& p) {
+  return std::min(a.lng(), b.lng()) <= p.lng() && p.lng() <= std::max(a.lng(), b.lng()) &&
+         std::min(a.lat(), b.lat()) <= p.lat() && p.lat() <= std::max(a.lat(), b.lat());
+}
+
+// Do the segments from a to b and from c to d intersect (touching counts)
+bool intersect(const PointLL& a, const PointLL& b, const PointLL& c, const PointLL& d) {
+  const double d1 = side(c, d, a), d2 = side(c, d, b);
+  const double d3 = side(a, b, c), d4 = side(a, b, d);
+  if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) && ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0))) {
+    return true;
+  }
+  return (d1 == 0 && within(c, d, a)) || (d2 == 0 && within(c, d, b)) ||
+         (d3 == 0 && within(a, b, c)) || (d4 == 0 && within(a, b, d));
+}
+
+// Is the point inside the (closed) ring, using the even-odd rule
+bool contains(const ring_t& ring, const PointLL& p) {
+  bool inside = false;
+  for (size_t i = 0; i + 1 < ring.size(); ++i) {
+    const auto& a = ring[i];
+    const auto& b = ring[i + 1];
+    if ((a.lat() > p.lat()) != (b.lat() > p.lat()) &&
+        p.lng() < (b.lng() - a.lng()) * (p.lat() - a.lat()) / (b.lat() - a.lat()) + a.lng()) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+} // namespace
+
+namespace valhalla {
+namespace loki {
+
+std::unordered_set<GraphId>
+edges_in_rings(const google::protobuf::RepeatedPtrField<valhalla::Ring>& rings,
+               GraphReader& reader) {
+  // The bins are stored in the tiles of the highest level and hold the edges of every level
+  const auto& level = TileHierarchy::levels().rbegin()->second;
+  const auto& tiles = level.tiles;
+  const float bin_size = tiles.SubdivisionSize();
+
+  // Add an edge, its opposing edge and the shortcuts containing them
+  std::unordered_set<GraphId> edges;
+  auto add = [&edges, &reader](const GraphId& edge_id, const GraphTile* tile) {
+    if (!edges.insert(edge_id).second) {
+      return;
+    }
+    if (tile->directededge(edge_id)->superseded()) {
+      auto shortcut = reader.GetShortcut(edge_id);
+      if (shortcut.Is_Valid()) {
+        edges.insert(shortcut);
+      }
+    }
+    auto opp_edge_id = reader.GetOpposingEdgeId(edge_id, tile);
+    if (opp_edge_id.Is_Valid() && edges.insert(opp_edge_id).second &&
+        tile->directededge(opp_edge_id)->superseded()) {
+      auto shortcut = reader.GetShortcut(opp_edge_id);
+      if (shortcut.Is_Valid()) {
+        edges.insert(shortcut);
+      }
+    }
+  };
+
+  for (const auto& pbf_ring : rings) {
+    auto ring = to_ring(pbf_ring);
+    if (ring.size() < 4) {
+      continue;
+    }
+
+    // Edges whose first shape point was tested against the ring
+    std::unordered_set<GraphId> tested;
+    for (const auto& tile_bins : tiles.Intersect(AABB2<PointLL>(ring))) {
+      const GraphTile* tile = reader.GetGraphTile(GraphId(tile_bins.first, level.level, 0));
+      if (tile == nullptr) {
+        continue;
+      }
+      const auto tile_bounds = tiles.TileBounds(tile_bins.first);
+      for (const auto bin : tile_bins.second) {
+        const float minx = tile_bounds.minx() + (bin % kBinsDim) * bin_size;
+        const float miny = tile_bounds.miny() + (bin / kBinsDim) * bin_size;
+        const AABB2<PointLL> bin_bounds(minx, miny, minx + bin_size, miny + bin_size);
+
+        // The parts of the boundary crossing the bin. A bin not crossed by the boundary is either
+        // entirely inside the ring, so all of its edges intersect it, or entirely outside.
+        std::vector<size_t> crossing;
+        for (size_t i = 0; i + 1 < ring.size(); ++i) {
+          if (bin_bounds.Intersects(ring[i], ring[i + 1])) {
+            crossing.push_back(i);
+          }
+        }
+        if (crossing.empty() && !contains(ring, bin_bounds.Center())) {
+          continue;
+        }
+
+        for (const auto edge_id : tile->GetBin(bin)) {
+          const GraphTile* edge_tile = tile;
+          if (edges.count(edge_id) || !reader.GetGraphTile(edge_id, edge_tile)) {
+            continue;
+          }
+
+          // An edge in a bin crossed by the boundary intersects the ring if it crosses the
+          // boundary or starts inside of it. The bins hold at least one direction of an edge
+          // wherever its shape goes, so crossings outside of this bin are found in other bins.
+          bool inside = crossing.empty();
+          if (!inside) {
+            const auto* edge = edge_tile->directededge(edge_id);
+            const auto edge_info = edge_tile->edgeinfo(edge->edgeinfo_offset());
+            auto shape = edge_info.lazy_shape();
+            if (shape.empty()) {
+              continue;
+            }
+            auto u = shape.pop();
+            inside = tested.insert(edge_id).second && contains(ring, u);
+            while (!inside && !shape.empty()) {
+              auto v = shape.pop();
+              inside = std::any_of(crossing.begin(), crossing.end(), [&](const size_t i) {
+                return intersect(u, v, ring[i], ring[i + 1]);
+              });
+              u = v;
+            }
+          }
+          if (inside) {
+            add(edge_id, edge_tile);
+          }
+        }
+      }
+    }
+  }
+  return edges;
+}
+
+std::unordered_map<GraphId, std::string> edge_bitsets(const std::unordered_set<GraphId>& edges) {
+  std::unordered_map<GraphId, std::string> bitsets;
+  for (const auto& edge_id : edges) {
+    auto& bitset = bitsets[edge_id.Tile_Base()];
+    const size_t byte = edge_id.id() / 8;
+    if (bitset.size() <= byte) {
+      bitset.resize(byte + 1, 0);
+    }
+    bitset[byte] |= static_cast<char>(1 << (edge_id.id() % 8));
+  }
+  return bitsets;
+}
+
+float rings_length(const google::protobuf::RepeatedPtrField<valhalla::Ring>& rings) {
+  float length = 0.0f;
+  for (const auto& pbf_ring : rings) {
+    auto ring = to_ring(pbf_ring);
+    for (size_t i = 0; i + 1 < ring.size(); ++i) {
+      length += ring[i].Distance(ring[i + 1]);
+    }
+  }
+  return length;
+}
+
+} // namespace loki
+} // namespace valhalla
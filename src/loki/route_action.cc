@@ -5,6 +5,7 @@
 #include "baldr/rapidjson_utils.h"
 #include "baldr/tilehierarchy.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 
 using namespace valhalla;
 using namespace valhalla::baldr;
@@ -34,10 +35,9 @@ void check_distance(const google::protobuf::RepeatedPtrField<valhalla::Location>
     }
     total_path_distance += path_distance;
   }
-  valhalla::midgard::logging::Log("total_location_distance::" +
-                                      std::to_string(total_path_distance * midgard::kKmPerMeter) +
-                                      "km",
-                                  " [ANALYTICS] ");
+  midgard::metrics::Observe("valhalla_location_distance_km",
+                            total_path_distance * midgard::kKmPerMeter, {{"action", "route"}},
+                            midgard::metrics::kSizeBounds);
 }
 
 } // namespace
@@ -89,7 +89,7 @@ void loki_worker_t::route(Api& request) {
   std::unordered_map<size_t, size_t> color_counts;
   try {
     auto locations = PathLocation::fromPBF(options.locations(), true);
-    const auto projections = loki::Search(locations, *reader, costing);
+    const auto projections = search(locations, options);
     for (size_t i = 0; i < locations.size(); ++i) {
       const auto& correlated = projections.at(locations[i]);
       PathLocation::toPBF(correlated, options.mutable_locations(i), *reader);
@@ -111,6 +111,13 @@ void loki_worker_t::route(Api& request) {
     }
   } catch (const std::exception&) { throw valhalla_exception_t{171}; }
 
+  // can each location be reached from the one before it
+  for (int i = 1; i < options.locations_size(); ++i) {
+    if (!connected(options.locations(i - 1), options.locations(i))) {
+      throw valhalla_exception_t{170};
+    }
+  }
+
   // are all the locations in the same color regions
   if (!connectivity_map) {
     return;
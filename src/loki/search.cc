@@ -82,6 +82,27 @@ std::function<std::tuple<int32_t, unsigned short, float>()> make_binner(const Po
   return tiles.ClosestFirst(p);
 }
 
+// Project a point onto the segments between each pair of consecutive points and write the squared
+// distance to each projection. Unlike projector_t this has no branches so that the compiler can
+// vectorize it over the arrays, the distances it computes are the same though: clamping the scale
+// to 0 or 1 gives back exactly u or v and a zero length segment always clamps to u
+void project_segments(const projector_t& project,
+                      const float* lngs,
+                      const float* lats,
+                      size_t count,
+                      float* sq_distances) {
+  for (size_t i = 0; i + 1 < count; ++i) {
+    auto bx = double(lngs[i + 1]) - lngs[i];
+    auto by = double(lats[i + 1]) - lats[i];
+    auto bx2 = bx * project.lon_scale;
+    auto sq = bx2 * bx2 + by * by;
+    auto scale = (project.lng - lngs[i]) * project.lon_scale * bx2 + (project.lat - lats[i]) * by;
+    scale = scale <= 0.0 ? 0.0 : (scale >= sq ? 1.0 : scale / sq);
+    sq_distances[i] =
+        project.approx.DistanceSquared(PointLL(lngs[i] + bx * scale, lats[i] + by * scale));
+  }
+}
+
 // Model a segment (2 consecutive points in an edge in a bin).
 struct candidate_t {
   double sq_distance;
@@ -200,7 +221,9 @@ struct bin_handler_t {
   NodeFilter node_filter;
   std::shared_ptr<DynamicCost> costing;
   unsigned int max_reach_limit;
+  size_t reach_mode;
   std::vector<candidate_t> bin_candidates;
+  std::vector<float> bin_distances;
   std::unordered_set<uint64_t> correlated_edges;
   Reach reach_finder;
 
@@ -225,6 +248,9 @@ struct bin_handler_t {
     // very annoying but it saves a lot of time to preallocate this instead of doing it in the loop
     // in handle_bins
     bin_candidates.resize(pps.size());
+    // the reach stored in the tiles is only usable if the costing filters no more than the build did
+    reach_mode = costing->AllowPrecomputedReach() ? EdgeReach::mode_index(costing->access_mode())
+                                                  : kReachModeCount;
     // TODO: make space for reach check in a more empirical way
     auto reservation = std::max(max_reach_limit, static_cast<decltype(max_reach_limit)>(1));
     directed_reaches.reserve(reservation * 1024);
@@ -385,12 +411,36 @@ struct bin_handler_t {
     if (itr != directed_reaches.cend())
       return itr->second;
 
-    // notice we do both directions here because in the end we use this reach for all input locations
-    auto reach = reach_finder(edge, edge_id, max_reach_limit, reader, costing, kInbound | kOutbound);
+    auto reach = find_reach(edge_id, edge, nullptr);
     directed_reaches[edge] = reach;
     return reach;
   }
 
+  // look up the reach that was computed when the tiles were built and expand only in the directions
+  // where it doesnt meet the limit. the stored reach comes from the same conservative expansion that
+  // the reach finder starts with so it is a lower bound of what the reach finder would return
+  directed_reach find_reach(const GraphId edge_id, const DirectedEdge* edge, const GraphTile* tile) {
+    directed_reach reach{};
+    const EdgeReach* edge_reach = nullptr;
+    if (reach_mode < kReachModeCount && (tile || reader.GetGraphTile(edge_id, tile)) &&
+        (edge_reach = tile->edge_reach(edge_id.id()))) {
+      reach.outbound = std::min(edge_reach->outbound(reach_mode), max_reach_limit);
+      reach.inbound = std::min(edge_reach->inbound(reach_mode), max_reach_limit);
+    }
+
+    // notice we do both directions here because in the end we use this reach for all input locations
+    uint8_t direction = (reach.outbound < max_reach_limit ? kOutbound : 0) |
+                        (reach.inbound < max_reach_limit ? kInbound : 0);
+    if (direction) {
+      auto found = reach_finder(edge, edge_id, max_reach_limit, reader, costing, direction);
+      if (direction & kOutbound)
+        reach.outbound = found.outbound;
+      if (direction & kInbound)
+        reach.inbound = found.inbound;
+    }
+    return reach;
+  }
+
   // do a mini network expansion or maybe not
   directed_reach check_reachability(std::vector<projector_wrapper>::iterator begin,
                                     std::vector<projector_wrapper>::iterator end,
@@ -419,8 +469,7 @@ struct bin_handler_t {
     if (!check)
       return {max_reach_limit, max_reach_limit};
 
-    // notice we do both directions here because in the end we use this reach for all input locations
-    auto reach = reach_finder(edge, edge_id, max_reach_limit, reader, costing, kInbound | kOutbound);
+    auto reach = find_reach(edge_id, edge, tile);
     directed_reaches[edge] = reach;
 
     // if the inbound reach is not 0 and the outbound reach is not 0 and the opposing edge is not
@@ -436,11 +485,32 @@ struct bin_handler_t {
   // handle a bin for the range of candidates that share it
   void handle_bin(std::vector<projector_wrapper>::iterator begin,
                   std::vector<projector_wrapper>::iterator end) {
-    // iterate over the edges in the bin
+    // when the decoded segments of the bin are available project every location onto all of them
     auto tile = begin->cur_tile;
-    auto edges = tile->GetBin(begin->bin_index);
-    for (auto edge_id : edges) {
+    auto segments = reader.GetBinSegments(tile, begin->bin_index);
+    size_t point_count = segments ? segments->lngs.size() : 0;
+    if (segments) {
+      bin_distances.resize((end - begin) * point_count);
+      auto* distances = bin_distances.data();
+      for (auto p_itr = begin; p_itr != end; ++p_itr, distances += point_count) {
+        project_segments(p_itr->project, segments->lngs.data(), segments->lats.data(), point_count,
+                         distances);
+      }
+    }
+
+    // iterate over the edges in the bin
+    const GraphId *first_edge, *last_edge;
+    if (segments) {
+      first_edge = segments->edges.data();
+      last_edge = first_edge + segments->edges.size();
+    } else {
+      auto edges = tile->GetBin(begin->bin_index);
+      first_edge = edges.begin();
+      last_edge = edges.end();
+    }
+    for (auto e_itr = first_edge; e_itr != last_edge; ++e_itr) {
       // get the tile and edge
+      auto edge_id = *e_itr;
       if (!reader.GetGraphTile(edge_id, tile)) {
         continue;
       }
@@ -473,33 +543,72 @@ struct bin_handler_t {
       // of the shape which are on the same side of h that p is. to make this fast we would need a
       // a trivial half plane test as maybe a single dot product and comparison?
 
-      // get some shape of the edge
-      auto edge_info = std::make_shared<const EdgeInfo>(tile->edgeinfo(edge->edgeinfo_offset()));
-      auto shape = edge_info->lazy_shape();
-      PointLL v;
-      if (!shape.empty()) {
-        v = shape.pop();
-      }
-
-      // iterate along this edges segments projecting each of the points
-      for (size_t i = 0; !shape.empty(); ++i) {
-        auto u = v;
-        v = shape.pop();
-        // for each input point
+      // the decoded segments can be used unless we switched to an opposing edge in another tile
+      // which has its own copy of the shape
+      size_t bin_edge = e_itr - first_edge;
+      if (segments && edge_id.Tile_Base() == e_itr->Tile_Base() &&
+          edge->edgeinfo_offset() == segments->edgeinfo_offsets[bin_edge]) {
+        auto first_point = segments->point_offsets[bin_edge];
+        auto last_point = segments->point_offsets[bin_edge + 1];
+        const auto* distances = bin_distances.data();
         c_itr = bin_candidates.begin();
-        for (p_itr = begin; p_itr != end; ++p_itr, ++c_itr) {
-          // how close is the input to this segment
-          auto point = p_itr->project(u, v);
-          auto sq_distance = p_itr->project.approx.DistanceSquared(point);
-          // do we want to keep it
-          if (sq_distance < c_itr->sq_distance) {
-            c_itr->sq_distance = sq_distance;
-            c_itr->point = std::move(point);
-            c_itr->index = i;
+        for (p_itr = begin; p_itr != end; ++p_itr, ++c_itr, distances += point_count) {
+          // find the closest of this edges segments, the first one wins a tie as it does below
+          size_t closest = last_point;
+          for (auto i = first_point; i + 1 < last_point; ++i) {
+            if (distances[i] < c_itr->sq_distance) {
+              c_itr->sq_distance = distances[i];
+              closest = i;
+            }
+          }
+          // only the closest projection needs its point
+          if (closest != last_point) {
+            const auto& lngs = segments->lngs;
+            const auto& lats = segments->lats;
+            c_itr->point = p_itr->project({lngs[closest], lats[closest]},
+                                          {lngs[closest + 1], lats[closest + 1]});
+            c_itr->index = closest - first_point;
+          }
+        }
+      } else {
+        // get some shape of the edge
+        auto shape = tile->edgeinfo(edge->edgeinfo_offset()).lazy_shape();
+        PointLL v;
+        if (!shape.empty()) {
+          v = shape.pop();
+        }
+
+        // iterate along this edges segments projecting each of the points
+        for (size_t i = 0; !shape.empty(); ++i) {
+          auto u = v;
+          v = shape.pop();
+          // for each input point
+          c_itr = bin_candidates.begin();
+          for (p_itr = begin; p_itr != end; ++p_itr, ++c_itr) {
+            // how close is the input to this segment
+            auto point = p_itr->project(u, v);
+            auto sq_distance = p_itr->project.approx.DistanceSquared(point);
+            // do we want to keep it
+            if (sq_distance < c_itr->sq_distance) {
+              c_itr->sq_distance = sq_distance;
+              c_itr->point = std::move(point);
+              c_itr->index = i;
+            }
           }
         }
       }
 
+      // the edge info is only needed by the candidates we keep
+      std::shared_ptr<const EdgeInfo> edge_info;
+      const auto* info_tile = tile;
+      auto get_edge_info = [&edge_info, info_tile, edge]() {
+        if (!edge_info) {
+          edge_info =
+              std::make_shared<const EdgeInfo>(info_tile->edgeinfo(edge->edgeinfo_offset()));
+        }
+        return edge_info;
+      };
+
       // if we already have a better reachable candidate we can just assume this one is reachable
       auto reach = check_reachability(begin, end, tile, edge, edge_id);
 
@@ -512,9 +621,10 @@ struct bin_handler_t {
         // it's possible that it isnt reachable but the opposing is, switch to that if so
         const GraphTile* opp_tile = tile;
         const DirectedEdge* opp_edge = nullptr;
-        if (!reachable && (opp_edge = reader.GetOpposingEdge(edge, opp_tile)) &&
-            edge_filter(opp_edge) > 0.f) {
-          auto opp_reach = check_reachability(begin, end, opp_tile, opp_edge, edge_id);
+        GraphId opp_edge_id;
+        if (!reachable && (opp_edge_id = reader.GetOpposingEdgeId(edge_id, opp_tile)).Is_Valid() &&
+            (opp_edge = opp_tile->directededge(opp_edge_id)) && edge_filter(opp_edge) > 0.f) {
+          auto opp_reach = check_reachability(begin, end, opp_tile, opp_edge, opp_edge_id);
           if (opp_reach.outbound >= p_itr->location.min_outbound_reach_ &&
               opp_reach.inbound >= p_itr->location.min_inbound_reach_) {
             tile = opp_tile;
@@ -531,7 +641,7 @@ struct bin_handler_t {
         if (batch->empty()) {
           c_itr->edge = edge;
           c_itr->edge_id = edge_id;
-          c_itr->edge_info = edge_info;
+          c_itr->edge_info = get_edge_info();
           c_itr->tile = tile;
           batch->emplace_back(std::move(*c_itr));
           continue;
@@ -553,7 +663,7 @@ struct bin_handler_t {
         if (in_radius || better) {
           c_itr->edge = edge;
           c_itr->edge_id = edge_id;
-          c_itr->edge_info = edge_info;
+          c_itr->edge_info = get_edge_info();
           c_itr->tile = tile;
           // the last one wasnt in the radius so replace it with this one because its better or is
           // in the radius
@@ -0,0 +1,178 @@
+#include "loki/search_cache.h"
+#include "baldr/cache_utils.h"
+#include "loki/search.h"
+#include "worker.h"
+
+#include <boost/functional/hash.hpp>
+#include <tuple>
+
+using namespace valhalla::baldr;
+using namespace valhalla::sif;
+
+namespace valhalla {
+namespace loki {
+
+bool search_cache_t::key_t::operator==(const key_t& other) const {
+  return std::tie(lng, lat, stop_type, preferred_side, has_heading, heading, heading_tolerance,
+                  node_snap_tolerance, street_side_tolerance, search_cutoff, min_outbound_reach,
+                  min_inbound_reach, radius, dataset_id, costing) ==
+         std::tie(other.lng, other.lat, other.stop_type, other.preferred_side, other.has_heading,
+                  other.heading, other.heading_tolerance, other.node_snap_tolerance,
+                  other.street_side_tolerance, other.search_cutoff, other.min_outbound_reach,
+                  other.min_inbound_reach, other.radius, other.dataset_id, other.costing);
+}
+
+size_t search_cache_t::key_hash_t::operator()(const key_t& key) const {
+  // the other members rarely differ for the same coordinates
+  size_t seed = 0;
+  boost::hash_combine(seed, key.lng);
+  boost::hash_combine(seed, key.lat);
+  boost::hash_combine(seed, key.radius);
+  boost::hash_combine(seed, key.dataset_id);
+  boost::hash_combine(seed, key.costing);
+  return seed;
+}
+
+search_cache_t::search_cache_t(size_t max_size)
+    : max_size(max_size), cur_size(0), hit_count(0), miss_count(0) {
+}
+
+std::shared_ptr<search_cache_t> search_cache_t::shared(const std::string& tile_source,
+                                                       size_t max_size) {
+  auto cache = shared_cache<search_cache_t>(tile_source, [max_size]() {
+    return std::make_shared<search_cache_t>(max_size);
+  });
+  // workers configured with a larger size grow the one they share
+  std::lock_guard<std::mutex> _(cache->lock);
+  cache->max_size = std::max(cache->max_size, max_size);
+  return cache;
+}
+
+std::string search_cache_t::costing_key(const Options& options) {
+  if (options.avoid_locations_size() || options.avoid_edges_size() ||
+      options.avoid_polygons_size() || options.avoid_tiles_size()) {
+    return {};
+  }
+  // multimodal searches its locations with the pedestrian costing
+  auto costing =
+      options.costing() == Costing::multimodal ? Costing::pedestrian : options.costing();
+  auto key = Costing_Enum_Name(costing);
+  if (static_cast<int>(costing) < options.costing_options_size()) {
+    key.push_back(':');
+    key.append(cache_serialize(options.costing_options(static_cast<int>(costing))));
+  }
+  return key;
+}
+
+std::unordered_map<baldr::Location, PathLocation>
+search_cache_t::search(const std::vector<baldr::Location>& locations,
+                       GraphReader& reader,
+                       const std::shared_ptr<DynamicCost>& costing,
+                       const std::string& costing_key) {
+  std::unordered_map<baldr::Location, PathLocation> searched;
+  std::vector<baldr::Location> misses;
+  std::vector<std::pair<const baldr::Location*, key_t>> uncached;
+  for (const auto& location : locations) {
+    // without a tile there is no dataset id to tell whether the candidates are still valid
+    const auto* tile = reader.GetGraphTile(location.latlng_);
+    if (costing_key.empty() || !tile) {
+      misses.push_back(location);
+      continue;
+    }
+
+    key_t key{location.latlng_.lng(),
+              location.latlng_.lat(),
+              location.stoptype_,
+              location.preferred_side_,
+              static_cast<bool>(location.heading_),
+              location.heading_ ? *location.heading_ : 0.f,
+              location.heading_tolerance_,
+              location.node_snap_tolerance_,
+              location.street_side_tolerance_,
+              location.search_cutoff_,
+              location.min_outbound_reach_,
+              location.min_inbound_reach_,
+              location.radius_,
+              tile->header()->dataset_id(),
+              costing_key};
+    PathLocation correlated(location);
+    if (get(key, correlated)) {
+      if (!correlated.edges.empty()) {
+        searched.emplace(location, std::move(correlated));
+      }
+      continue;
+    }
+    misses.push_back(location);
+    uncached.emplace_back(&location, std::move(key));
+  }
+
+  // search for all of the misses at once and remember what was found, including nothing
+  if (!misses.empty()) {
+    auto found = loki::Search(misses, reader, costing);
+    for (auto& miss : uncached) {
+      entry_t entry{std::move(miss.second), {}, {}, 0};
+      auto correlated = found.find(*miss.first);
+      if (correlated != found.cend()) {
+        entry.edges = correlated->second.edges;
+        entry.filtered_edges = correlated->second.filtered_edges;
+      }
+      put(std::move(entry));
+    }
+    searched.insert(std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+  }
+  return searched;
+}
+
+size_t search_cache_t::size() const {
+  std::lock_guard<std::mutex> _(lock);
+  return cur_size;
+}
+
+uint64_t search_cache_t::hits() const {
+  std::lock_guard<std::mutex> _(lock);
+  return hit_count;
+}
+
+uint64_t search_cache_t::misses() const {
+  std::lock_guard<std::mutex> _(lock);
+  return miss_count;
+}
+
+bool search_cache_t::get(const key_t& key, PathLocation& correlated) {
+  std::lock_guard<std::mutex> _(lock);
+  auto found = index.find(key);
+  if (found == index.cend()) {
+    ++miss_count;
+    return false;
+  }
+  ++hit_count;
+  entries.splice(entries.begin(), entries, found->second);
+  correlated.edges = found->second->edges;
+  correlated.filtered_edges = found->second->filtered_edges;
+  return true;
+}
+
+void search_cache_t::put(entry_t&& entry) {
+  entry.size = kCacheEntryOverhead + entry.key.costing.size() +
+               (entry.edges.size() + entry.filtered_edges.size()) * sizeof(PathLocation::PathEdge);
+  if (entry.size > max_size) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> _(lock);
+  // another thread may have searched the same location in the meantime
+  if (index.find(entry.key) != index.cend()) {
+    return;
+  }
+  cur_size += entry.size;
+  entries.emplace_front(std::move(entry));
+  index.emplace(entries.front().key, entries.begin());
+  while (cur_size > max_size) {
+    cur_size -= entries.back().size;
+    index.erase(entries.back().key);
+    entries.pop_back();
+  }
+}
+
+} // namespace loki
+} // namespace valhalla
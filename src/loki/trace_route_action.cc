@@ -4,6 +4,7 @@
 #include "baldr/rapidjson_utils.h"
 #include "midgard/encoded.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include "midgard/pointll.h"
 #include "tyr/actor.h"
 
@@ -35,7 +36,7 @@ void check_shape(const google::protobuf::RepeatedPtrField<valhalla::Location>& s
                                         std::to_string(max_shape)};
   };
 
-  valhalla::midgard::logging::Log("trace_size::" + std::to_string(shape.size()), " [ANALYTICS] ");
+  midgard::metrics::Observe("valhalla_trace_size", shape.size(), {}, midgard::metrics::kSizeBounds);
 }
 
 void check_distance(const google::protobuf::RepeatedPtrField<valhalla::Location>& shape,
@@ -51,9 +52,8 @@ void check_distance(const google::protobuf::RepeatedPtrField<valhalla::Location>
     throw valhalla_exception_t{154};
   }
 
-  valhalla::midgard::logging::Log("location_distance::" +
-                                      std::to_string(crow_distance * kKmPerMeter) + "km",
-                                  " [ANALYTICS] ");
+  midgard::metrics::Observe("valhalla_location_distance_km", crow_distance * kKmPerMeter,
+                            {{"action", "trace"}}, midgard::metrics::kSizeBounds);
 }
 
 void check_best_paths(unsigned int best_paths, unsigned int max_best_paths) {
@@ -89,8 +89,8 @@ void check_gps_accuracy(const float input_gps_accuracy, const float max_gps_accu
     throw valhalla_exception_t{158};
   }
 
-  valhalla::midgard::logging::Log("gps_accuracy::" + std::to_string(input_gps_accuracy) + "meters",
-                                  " [ANALYTICS] ");
+  midgard::metrics::Observe("valhalla_trace_gps_accuracy_m", input_gps_accuracy, {},
+                            midgard::metrics::kSizeBounds);
 }
 
 void check_search_radius(const float input_search_radius, const float max_search_radius) {
@@ -98,8 +98,8 @@ void check_search_radius(const float input_search_radius, const float max_search
     throw valhalla_exception_t{158};
   }
 
-  valhalla::midgard::logging::Log("search_radius::" + std::to_string(input_search_radius) + "meters",
-                                  " [ANALYTICS] ");
+  midgard::metrics::Observe("valhalla_trace_search_radius_m", input_search_radius, {},
+                            midgard::metrics::kSizeBounds);
 }
 
 void check_turn_penalty_factor(const float input_turn_penalty_factor) {
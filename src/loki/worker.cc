@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <boost/property_tree/ptree.hpp>
 #include <cstdint>
 #include <functional>
@@ -7,9 +8,11 @@
 #include <unordered_map>
 #include <unordered_set>
 
+#include "baldr/cache_utils.h"
 #include "baldr/json.h"
 #include "baldr/rapidjson_utils.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include "sif/autocost.h"
 #include "sif/bicyclecost.h"
 #include "sif/motorcyclecost.h"
@@ -17,7 +20,9 @@
 #include "sif/pedestriancost.h"
 #include "tyr/actor.h"
 
+#include "loki/polygon_search.h"
 #include "loki/search.h"
+#include "loki/search_cache.h"
 #include "loki/worker.h"
 
 using namespace valhalla;
@@ -27,6 +32,13 @@ using namespace valhalla::baldr;
 using namespace valhalla::sif;
 using namespace valhalla::loki;
 
+namespace {
+
+// Default maximum total length of the rings of the avoid polygons of a request
+constexpr float kDefaultMaxAvoidPolygonsLength = 100000.0f; // 100 km
+
+} // namespace
+
 namespace valhalla {
 namespace loki {
 void loki_worker_t::parse_locations(google::protobuf::RepeatedPtrField<valhalla::Location>* locations,
@@ -69,7 +81,9 @@ void loki_worker_t::parse_costing(Api& api, bool allow_none) {
 
   const auto& costing_str = Costing_Enum_Name(options.costing());
   if (!options.do_not_track()) {
-    valhalla::midgard::logging::Log("costing_type::" + costing_str, " [ANALYTICS] ");
+    midgard::metrics::Increment("valhalla_requests_total",
+                                {{"action", Options_Action_Enum_Name(options.action())},
+                                 {"costing", costing_str}});
   }
 
   try {
@@ -84,6 +98,11 @@ void loki_worker_t::parse_costing(Api& api, bool allow_none) {
     }
   } catch (const std::runtime_error&) { throw valhalla_exception_t{125, "'" + costing_str + "'"}; }
 
+  // the walking at the ends of multimodal does not tell us whether the locations are connected
+  component_mode = options.costing() != Costing::multimodal && costing->AllowPrecomputedComponents()
+                       ? NodeComponent::mode_index(costing->access_mode())
+                       : kComponentModeCount;
+
   // See if we have avoids and take care of them
   if (options.avoid_locations_size() > max_avoid_locations) {
     throw valhalla_exception_t{157, std::to_string(max_avoid_locations)};
@@ -130,6 +149,24 @@ void loki_worker_t::parse_costing(Api& api, bool allow_none) {
     }
   }
 
+  // Process avoid polygons. Add a bitset of the edges intersecting them for each tile.
+  if (options.avoid_polygons_size()) {
+    if (rings_length(options.avoid_polygons()) > max_avoid_polygons_length) {
+      auto limit = std::to_string(static_cast<size_t>(max_avoid_polygons_length));
+      throw valhalla_exception_t{165, limit + " meters"};
+    }
+    try {
+      for (const auto& bitset : edge_bitsets(edges_in_rings(options.avoid_polygons(), *reader))) {
+        auto* avoid = options.add_avoid_tiles();
+        avoid->set_id(bitset.first);
+        avoid->set_edges(bitset.second);
+      }
+    } // swallow all failures on optional avoids
+    catch (...) {
+      LOG_WARN("Failed to find avoid_polygons");
+    }
+  }
+
   // If more alternates are requested than we support we cap it
   if (options.alternates() > max_alternates)
     options.set_alternates(max_alternates);
@@ -137,7 +174,7 @@ void loki_worker_t::parse_costing(Api& api, bool allow_none) {
 
 loki_worker_t::loki_worker_t(const boost::property_tree::ptree& config,
                              const std::shared_ptr<baldr::GraphReader>& graph_reader)
-    : config(config), reader(graph_reader),
+    : config(config), component_mode(kComponentModeCount), reader(graph_reader),
       connectivity_map(config.get<bool>("loki.use_connectivity", true)
                            ? new connectivity_map_t(config.get_child("mjolnir"))
                            : nullptr),
@@ -145,7 +182,9 @@ loki_worker_t::loki_worker_t(const boost::property_tree::ptree& config,
       max_contours(config.get<size_t>("service_limits.isochrone.max_contours")),
       max_time(config.get<size_t>("service_limits.isochrone.max_time")),
       max_trace_shape(config.get<size_t>("service_limits.trace.max_shape")),
-      sample(config.get<std::string>("additional_data.elevation", "test/data/")),
+      sample(config.get<std::string>("additional_data.elevation", "test/data/"),
+             config.get<size_t>("additional_data.elevation_cache_size",
+                                skadi::sample::kDefaultCacheSize)),
       max_elevation_shape(config.get<size_t>("service_limits.skadi.max_shape")),
       min_resample(config.get<float>("service_limits.skadi.min_resample")) {
   // If we weren't provided with a graph reader make our own
@@ -170,7 +209,7 @@ loki_worker_t::loki_worker_t(const boost::property_tree::ptree& config,
   for (const auto& kv : config.get_child("service_limits")) {
     if (kv.first == "max_avoid_locations" || kv.first == "max_reachability" ||
         kv.first == "max_radius" || kv.first == "max_timedep_distance" ||
-        kv.first == "max_alternates") {
+        kv.first == "max_alternates" || kv.first == "max_avoid_polygons_length") {
       continue;
     }
     if (kv.first != "skadi" && kv.first != "trace") {
@@ -211,6 +250,8 @@ loki_worker_t::loki_worker_t(const boost::property_tree::ptree& config,
       config.get<size_t>("service_limits.pedestrian.max_transit_walking_distance");
 
   max_avoid_locations = config.get<size_t>("service_limits.max_avoid_locations");
+  max_avoid_polygons_length = config.get<float>("service_limits.max_avoid_polygons_length",
+                                                kDefaultMaxAvoidPolygonsLength);
   max_reachability = config.get<unsigned int>("service_limits.max_reachability");
   default_reachability = config.get<unsigned int>("loki.service_defaults.minimum_reachability");
   max_radius = config.get<unsigned int>("service_limits.max_radius");
@@ -226,10 +267,84 @@ loki_worker_t::loki_worker_t(const boost::property_tree::ptree& config,
   max_best_paths_shape = config.get<size_t>("service_limits.trace.max_best_paths_shape");
   max_alternates = config.get<unsigned int>("service_limits.max_alternates");
 
+  // Share the candidates of locations that are searched over and over between the workers
+  auto search_cache_size = config.get<size_t>("loki.search_cache_size", 0);
+  if (search_cache_size) {
+    search_cache = search_cache_t::shared(baldr::cache_tile_source(config), search_cache_size);
+  }
+
   // Register standard edge/node costing methods
   factory.RegisterStandardCostingModels();
 }
 
+std::unordered_map<baldr::Location, baldr::PathLocation>
+loki_worker_t::search(const std::vector<baldr::Location>& locations, const Options& options) {
+  if (!search_cache) {
+    return loki::Search(locations, *reader, costing);
+  }
+  return search_cache->search(locations, *reader, costing, search_cache_t::costing_key(options));
+}
+
+bool loki_worker_t::connected(const valhalla::Location& from, const valhalla::Location& to) {
+  if (component_mode >= kComponentModeCount) {
+    return true;
+  }
+
+  // thor falls back to the filtered edges so they count as well
+  std::vector<GraphId> from_edges, to_edges;
+  for (const auto* edges : {&from.path_edges(), &from.filtered_edges()}) {
+    for (const auto& edge : *edges) {
+      from_edges.emplace_back(edge.graph_id());
+    }
+  }
+  for (const auto* edges : {&to.path_edges(), &to.filtered_edges()}) {
+    for (const auto& edge : *edges) {
+      to_edges.emplace_back(edge.graph_id());
+    }
+  }
+
+  // a path along a single edge does not pass through any node
+  for (const auto& from_edge : from_edges) {
+    if (std::find(to_edges.cbegin(), to_edges.cend(), from_edge) != to_edges.cend()) {
+      return true;
+    }
+  }
+
+  // the path leaves from the end nodes of the edges of the origin and arrives at the start
+  // nodes of the edges of the destination, missing components mean the tile has none stored
+  const GraphTile* tile = nullptr;
+  auto component = [this, &tile](const GraphId& node) -> const NodeComponent* {
+    if (!node.Is_Valid() || !reader->GetGraphTile(node, tile)) {
+      return nullptr;
+    }
+    return tile->node_component(node.id(), component_mode);
+  };
+  std::vector<const NodeComponent*> from_components, to_components;
+  for (const auto& edge : from_edges) {
+    const auto* c = component(reader->edge_endnode(edge, tile));
+    if (!c) {
+      return true;
+    }
+    from_components.push_back(c);
+  }
+  for (const auto& edge : to_edges) {
+    const auto* c = component(reader->edge_startnode(edge, tile));
+    if (!c) {
+      return true;
+    }
+    to_components.push_back(c);
+  }
+
+  for (const auto* f : from_components) {
+    for (const auto* t : to_components) {
+      if (NodeComponent::Connected(*f, *t)) {
+        return true;
+      }
+    }
+  }
+  return from_components.empty() || to_components.empty();
+}
+
 void loki_worker_t::cleanup() {
   if (reader->OverCommitted()) {
     reader->Trim();
@@ -272,7 +387,7 @@ loki_worker_t::work(const std::list<zmq::message_t>& job,
         result.messages.emplace_back(request.SerializeAsString());
         break;
       case Options::locate:
-        result = to_response_json(locate(request), info, request);
+        result = to_response(locate(request), info, request);
         break;
       case Options::sources_to_targets:
       case Options::optimized_route:
@@ -294,6 +409,11 @@ loki_worker_t::work(const std::list<zmq::message_t>& job,
       case Options::transit_available:
         result = to_response_json(transit_available(request), info, request);
         break;
+      case Options::metrics:
+        // forwarded so thor and odin add theirs, scraping the metrics shouldn't show up in them
+        add_metrics(request);
+        result.messages.emplace_back(request.SerializeAsString());
+        return result;
       default:
         // apparently you wanted something that we figured we'd support but havent written yet
         return jsonify_error({107}, info, request);
@@ -309,15 +429,23 @@ loki_worker_t::work(const std::list<zmq::message_t>& job,
     if (!options.do_not_track() && elapsed_time.count() / work_units > long_request) {
       LOG_WARN("loki::request elapsed time (ms)::" + std::to_string(elapsed_time.count()));
       LOG_WARN("loki::request exceeded threshold::" + std::to_string(info.id));
-      midgard::logging::Log("valhalla_loki_long_request", " [ANALYTICS] ");
+      midgard::metrics::Increment("valhalla_long_requests_total",
+                                  {{"stage", "loki"},
+                                   {"action", Options_Action_Enum_Name(options.action())}});
+    }
+    if (!options.do_not_track()) {
+      midgard::metrics::Observe("valhalla_stage_latency_ms", elapsed_time.count(),
+                                {{"stage", "loki"},
+                                 {"action", Options_Action_Enum_Name(options.action())}});
     }
 
     return result;
   } catch (const valhalla_exception_t& e) {
-    valhalla::midgard::logging::Log("400::" + std::string(e.what()), " [ANALYTICS] ");
+    midgard::metrics::Increment("valhalla_errors_total",
+                                {{"stage", "loki"}, {"code", std::to_string(e.code)}});
     return jsonify_error(e, info, request);
   } catch (const std::exception& e) {
-    valhalla::midgard::logging::Log("400::" + std::string(e.what()), " [ANALYTICS] ");
+    midgard::metrics::Increment("valhalla_errors_total", {{"stage", "loki"}, {"code", "199"}});
     return jsonify_error({199, std::string(e.what())}, info, request);
   }
 }
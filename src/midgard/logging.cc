@@ -1,13 +1,18 @@
 #include "midgard/logging.h"
 
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <cstdlib>
 #include <ctime>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 #ifdef __ANDROID__
 #include <android/log.h>
@@ -28,14 +33,17 @@ inline std::tm* get_gmtime(const std::time_t* time, std::tm* tm) {
 }
 
 // returns formatted to: 'year/mo/dy hr:mn:sc.xxxxxx'
-std::string TimeStamp() {
-  // get the time
-  std::chrono::system_clock::time_point tp = std::chrono::system_clock::now();
+std::string TimeStamp(const std::chrono::system_clock::time_point tp) {
+  // breaking the time down is only needed once a second per thread
   std::time_t tt = std::chrono::system_clock::to_time_t(tp);
-  std::tm gmt{};
-  get_gmtime(&tt, &gmt);
+  thread_local std::time_t cached_tt = -1;
+  thread_local std::tm gmt{};
+  if (tt != cached_tt) {
+    get_gmtime(&tt, &gmt);
+    cached_tt = tt;
+  }
   using sec_t = std::chrono::duration<double>;
-  std::chrono::duration<double> fractional_seconds =
+  sec_t fractional_seconds =
       (tp - std::chrono::system_clock::from_time_t(tt)) + std::chrono::seconds(gmt.tm_sec);
   // format the string
   std::string buffer("year/mo/dy hr:mn:sc.xxxxxx");
@@ -44,6 +52,11 @@ std::string TimeStamp() {
   return buffer;
 }
 
+// returns the current time formatted to: 'year/mo/dy hr:mn:sc.xxxxxx'
+std::string TimeStamp() {
+  return TimeStamp(std::chrono::system_clock::now());
+}
+
 // the Log levels we support
 struct EnumHasher {
   template <typename T> std::size_t operator()(T t) const {
@@ -78,6 +91,9 @@ namespace midgard {
 
 namespace logging {
 
+// wraps a logger so that its lines are written by a background thread
+Logger* MakeAsync(const LoggingConfig& config, Logger* sink);
+
 // a factory that can create loggers (that derive from 'logger') via function pointers
 // this way you could make your own logger that sends log messages to who knows where
 Logger* LoggerFactory::Produce(const LoggingConfig& config) const {
@@ -89,6 +105,10 @@ Logger* LoggerFactory::Produce(const LoggingConfig& config) const {
   // grab the logger
   auto found = find(type->second);
   if (found != end()) {
+    auto async = config.find("async");
+    if (async != config.end() && async->second == "true") {
+      return MakeAsync(config, found->second(config));
+    }
     return found->second(config);
   }
   // couldn't get a logger
@@ -112,6 +132,16 @@ Logger::Logger(const LoggingConfig& config){};
 Logger::~Logger(){};
 void Logger::Log(const std::string&, const LogLevel){};
 void Logger::Log(const std::string&, const std::string&){};
+void Logger::Log(const std::string& message,
+                 const LogLevel level,
+                 const char* file,
+                 const int line) {
+  Log(std::string(file) + ": " + std::to_string(line) + ": " + message, level);
+}
+void Logger::Write(const std::string&){};
+const std::string& Logger::Directive(const LogLevel level) const {
+  return uncolored.find(level)->second;
+}
 bool logger_registered = RegisterLogger("", [](const LoggingConfig& config) {
   Logger* l = new Logger(config);
   return l;
@@ -144,14 +174,24 @@ public:
     output.append(custom_directive);
     output.append(message);
     output.push_back('\n');
+    Write(output);
+#endif
+  }
+  virtual void Write(const std::string& lines) {
+#ifdef __ANDROID__
+    __android_log_print(ANDROID_LOG_INFO, "valhalla", "%s", lines.c_str());
+#else
     // cout is thread safe, to avoid multiple threads interleaving on one line
     // though, we make sure to only call the << operator once on std::cout
     // otherwise the << operators from different threads could interleave
     // obviously we dont care if flushes interleave
-    std::cout << output;
+    std::cout << lines;
     std::cout.flush();
 #endif
   }
+  virtual const std::string& Directive(const LogLevel level) const {
+    return levels.find(level)->second;
+  }
 
 protected:
   const std::unordered_map<LogLevel, std::string, EnumHasher> levels;
@@ -167,13 +207,14 @@ class StdErrLogger : public StdOutLogger {
 #ifdef __ANDROID__
     __android_log_print(ANDROID_LOG_ERROR, "valhalla", "%s", message.c_str());
 #else
-    std::string output;
-    output.reserve(message.length() + 64);
-    output.append(TimeStamp());
-    output.append(custom_directive);
-    output.append(message);
-    output.push_back('\n');
-    std::cerr << output;
+    StdOutLogger::Log(message, custom_directive);
+#endif
+  }
+  virtual void Write(const std::string& lines) {
+#ifdef __ANDROID__
+    __android_log_print(ANDROID_LOG_ERROR, "valhalla", "%s", lines.c_str());
+#else
+    std::cerr << lines;
     std::cerr.flush();
 #endif
   }
@@ -220,8 +261,11 @@ public:
     output.append(custom_directive);
     output.append(message);
     output.push_back('\n');
+    Write(output);
+  }
+  virtual void Write(const std::string& lines) {
     lock.lock();
-    file << output;
+    file << lines;
     file.flush();
     lock.unlock();
     ReOpen();
@@ -260,6 +304,197 @@ bool file_logger_registered = RegisterLogger("file", [](const LoggingConfig& con
   return l;
 });
 
+// logger that queues the lines in a lock-free ring buffer (a bounded multi producer queue where
+// each slot has a sequence number saying whose turn it is) and formats and writes them to
+// another logger from a background thread. Threads logging never wait on each other or on the
+// output, if the buffer is full the line is dropped and counted instead
+class AsyncLogger : public Logger {
+public:
+  AsyncLogger() = delete;
+  AsyncLogger(const LoggingConfig& config, std::unique_ptr<Logger> sink)
+      : Logger(config), sink(std::move(sink)), enqueue_pos(0), dequeue_pos(0), dropped(0),
+        running(true), waiting(false) {
+    // the size of the queue is rounded up to a power of 2 so positions can be masked
+    long size = 8192;
+    auto queue_size = config.find("queue_size");
+    if (queue_size != config.end()) {
+      try {
+        size = std::stol(queue_size->second);
+      } catch (...) { size = 0; }
+      if (size < 1 || size > (1 << 24)) {
+        throw std::runtime_error(queue_size->second + " is not a valid queue size");
+      }
+    }
+    size_t capacity = 2;
+    while (capacity < static_cast<size_t>(size)) {
+      capacity <<= 1;
+    }
+    slots.reset(new Slot[capacity]);
+    for (size_t i = 0; i < capacity; ++i) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    mask = capacity - 1;
+    writer = std::thread(&AsyncLogger::Run, this);
+  }
+  virtual ~AsyncLogger() {
+    // the writer empties the queue before it stops
+    {
+      std::lock_guard<std::mutex> lock(wake_lock);
+      running.store(false, std::memory_order_release);
+    }
+    wake.notify_one();
+    writer.join();
+  }
+  virtual void Log(const std::string& message, const LogLevel level) {
+    Push(message, level, nullptr, nullptr, 0);
+  }
+  virtual void Log(const std::string& message, const std::string& custom_directive = " [TRACE] ") {
+    Push(message, LogLevel::TRACE, &custom_directive, nullptr, 0);
+  }
+  virtual void
+  Log(const std::string& message, const LogLevel level, const char* file, const int line) {
+    Push(message, level, nullptr, file, line);
+  }
+  virtual void Write(const std::string& lines) {
+    sink->Write(lines);
+  }
+  virtual const std::string& Directive(const LogLevel level) const {
+    return sink->Directive(level);
+  }
+
+protected:
+  struct Slot {
+    std::atomic<size_t> sequence;
+    std::chrono::system_clock::time_point time;
+    LogLevel level;
+    bool custom;
+    std::string directive;
+    std::string message;
+    const char* file;
+    int line;
+  };
+
+  void Push(const std::string& message,
+            const LogLevel level,
+            const std::string* custom_directive,
+            const char* file,
+            const int line) {
+    // claim the slot at the back of the queue, a slot whose sequence is behind is still full
+    size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+      slot = &slots[pos & mask];
+      auto sequence = slot->sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+      } else {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+
+    // only copy, formatting is left to the writer
+    slot->time = std::chrono::system_clock::now();
+    slot->level = level;
+    slot->custom = custom_directive != nullptr;
+    if (custom_directive) {
+      slot->directive = *custom_directive;
+    }
+    slot->message = message;
+    slot->file = file;
+    slot->line = line;
+    slot->sequence.store(pos + 1, std::memory_order_seq_cst);
+
+    // only bother the writer if it is asleep, taking the lock means it can't miss the wake up
+    if (waiting.load(std::memory_order_seq_cst)) {
+      { std::lock_guard<std::mutex> lock(wake_lock); }
+      wake.notify_one();
+    }
+  }
+
+  // whether the slot at the front of the queue has a line in it
+  bool Ready() const {
+    return slots[dequeue_pos & mask].sequence.load(std::memory_order_seq_cst) == dequeue_pos + 1;
+  }
+
+  // formats everything in the queue into lines, returns how many there were
+  size_t Drain(std::string& lines) {
+    size_t count = 0;
+    while (true) {
+      auto& slot = slots[dequeue_pos & mask];
+      if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos + 1) {
+        break;
+      }
+      lines.append(TimeStamp(slot.time));
+      lines.append(slot.custom ? slot.directive : sink->Directive(slot.level));
+      if (slot.file) {
+        lines.append(slot.file);
+        lines.append(": ");
+        lines.append(std::to_string(slot.line));
+        lines.append(": ");
+      }
+      lines.append(slot.message);
+      lines.push_back('\n');
+      // keep the capacity of the strings for the next time the slot is used
+      slot.message.clear();
+      slot.sequence.store(dequeue_pos + mask + 1, std::memory_order_release);
+      ++dequeue_pos;
+      ++count;
+    }
+    auto lost = dropped.exchange(0, std::memory_order_relaxed);
+    if (lost) {
+      lines.append(TimeStamp());
+      lines.append(sink->Directive(LogLevel::WARN));
+      lines.append(std::to_string(lost) + " log lines were dropped, the queue was full\n");
+      ++count;
+    }
+    return count;
+  }
+
+  void Run() {
+    std::string lines;
+    while (true) {
+      bool stopping = !running.load(std::memory_order_acquire);
+      if (Drain(lines)) {
+        sink->Write(lines);
+        lines.clear();
+        continue;
+      }
+      if (stopping) {
+        break;
+      }
+      // sleep until a producer pushes a line or we are told to stop, anything dropped while the
+      // queue was full is picked up by the next drain
+      std::unique_lock<std::mutex> lock(wake_lock);
+      waiting.store(true, std::memory_order_seq_cst);
+      wake.wait(lock, [this]() { return Ready() || !running.load(std::memory_order_acquire); });
+      waiting.store(false, std::memory_order_relaxed);
+    }
+  }
+
+  std::unique_ptr<Logger> sink;
+  std::unique_ptr<Slot[]> slots;
+  size_t mask;
+  std::atomic<size_t> enqueue_pos;
+  size_t dequeue_pos; // only used by the writer
+  std::atomic<size_t> dropped;
+  std::atomic<bool> running;
+  std::atomic<bool> waiting; // whether the writer is asleep on wake
+  std::mutex wake_lock;
+  std::condition_variable wake;
+  std::thread writer;
+};
+
+Logger* MakeAsync(const LoggingConfig& config, Logger* sink) {
+  Logger* l = new AsyncLogger(config, std::unique_ptr<Logger>(sink));
+  return l;
+}
+
 } // namespace logging
 
 // statically get a logger using the factory
@@ -0,0 +1,237 @@
+#include "midgard/metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+#include <unordered_map>
+
+namespace {
+
+// label values can hold anything but backslashes, quotes and newlines have to be escaped
+void append_escaped(std::string& out, const std::string& value) {
+  for (auto c : value) {
+    switch (c) {
+      case '\\':
+        out.append("\\\\");
+        break;
+      case '"':
+        out.append("\\\"");
+        break;
+      case '\n':
+        out.append("\\n");
+        break;
+      default:
+        out.push_back(c);
+    }
+  }
+}
+
+// splits a key into its name and its labels without the braces
+std::pair<std::string, std::string> split_key(const std::string& key) {
+  auto brace = key.find('{');
+  if (brace == std::string::npos) {
+    return {key, ""};
+  }
+  return {key.substr(0, brace), key.substr(brace + 1, key.size() - brace - 2)};
+}
+
+// groups the series of each metric by name, sorting by key alone would put foo_bar{...} between
+// foo and foo{...}
+template <class value_t>
+std::map<std::string, std::vector<std::pair<std::string, const value_t*>>>
+group_by_name(const std::map<std::string, value_t>& series) {
+  std::map<std::string, std::vector<std::pair<std::string, const value_t*>>> metrics;
+  for (const auto& s : series) {
+    auto name_labels = split_key(s.first);
+    metrics[name_labels.first].emplace_back(std::move(name_labels.second), &s.second);
+  }
+  return metrics;
+}
+
+std::string format_value(const double value) {
+  if (std::isinf(value)) {
+    return value > 0 ? "+Inf" : "-Inf";
+  }
+  std::ostringstream stream;
+  stream.precision(15);
+  stream << value;
+  return stream.str();
+}
+
+} // namespace
+
+namespace valhalla {
+namespace midgard {
+
+namespace metrics {
+
+const std::vector<double> kLatencyBounds{1,   2.5,  5,    10,   25,    50,    100,
+                                         250, 500,  1000, 2500, 5000,  10000, 30000};
+const std::vector<double> kSizeBounds{1,   2,   5,    10,   20,   50,    100,
+                                      200, 500, 1000, 2000, 5000, 10000, 100000};
+
+Histogram::Histogram(const std::vector<double>& bounds)
+    : bounds_(bounds), buckets_(new std::atomic<uint64_t>[bounds.size() + 1]), count_(0),
+      sum_(0) {
+  for (size_t i = 0; i <= bounds_.size(); ++i) {
+    buckets_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void Histogram::Observe(const double value) {
+  // the last bucket holds everything above the bounds
+  auto bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+  buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  auto sum = sum_.load(std::memory_order_relaxed);
+  while (!sum_.compare_exchange_weak(sum, sum + value, std::memory_order_relaxed)) {
+  }
+}
+
+Registry& Registry::Get() {
+  static Registry registry;
+  return registry;
+}
+
+std::string Registry::Key(const std::string& name, const Labels& labels) {
+  std::string key(name);
+  if (labels.empty()) {
+    return key;
+  }
+  key.push_back('{');
+  for (const auto& label : labels) {
+    if (key.back() != '{') {
+      key.push_back(',');
+    }
+    key.append(label.first);
+    key.append("=\"");
+    append_escaped(key, label.second);
+    key.push_back('"');
+  }
+  key.push_back('}');
+  return key;
+}
+
+Counter& Registry::counter(const std::string& name, const Labels& labels) {
+  // each thread remembers the series it used so only the first use takes the lock
+  thread_local std::unordered_map<std::string, Counter*> cache;
+  auto key = Key(name, labels);
+  auto cached = cache.find(key);
+  if (cached != cache.end()) {
+    return *cached->second;
+  }
+  std::lock_guard<std::mutex> _(lock_);
+  auto& series = counters_[key];
+  if (!series) {
+    series.reset(new Counter());
+  }
+  cache.emplace(std::move(key), series.get());
+  return *series;
+}
+
+Histogram& Registry::histogram(const std::string& name,
+                               const Labels& labels,
+                               const std::vector<double>& bounds) {
+  thread_local std::unordered_map<std::string, Histogram*> cache;
+  auto key = Key(name, labels);
+  auto cached = cache.find(key);
+  if (cached != cache.end()) {
+    return *cached->second;
+  }
+  std::lock_guard<std::mutex> _(lock_);
+  auto& series = histograms_[key];
+  if (!series) {
+    series.reset(new Histogram(bounds));
+  }
+  cache.emplace(std::move(key), series.get());
+  return *series;
+}
+
+Snapshot Registry::GetSnapshot() const {
+  Snapshot snapshot;
+  std::lock_guard<std::mutex> _(lock_);
+  for (const auto& series : counters_) {
+    snapshot.counters.emplace(series.first, series.second->value());
+  }
+  for (const auto& series : histograms_) {
+    const auto& histogram = *series.second;
+    Snapshot::HistogramValues values{histogram.bounds(), {}, histogram.count(), histogram.sum()};
+    for (size_t i = 0; i <= histogram.bounds().size(); ++i) {
+      values.buckets.push_back(histogram.bucket(i));
+    }
+    snapshot.histograms.emplace(series.first, std::move(values));
+  }
+  return snapshot;
+}
+
+void Snapshot::Merge(const Snapshot& other) {
+  for (const auto& series : other.counters) {
+    counters[series.first] += series.second;
+  }
+  for (const auto& series : other.histograms) {
+    auto inserted = histograms.insert(series);
+    auto& values = inserted.first->second;
+    if (inserted.second || values.bounds != series.second.bounds) {
+      continue;
+    }
+    for (size_t i = 0; i < values.buckets.size(); ++i) {
+      values.buckets[i] += series.second.buckets[i];
+    }
+    values.count += series.second.count;
+    values.sum += series.second.sum;
+  }
+}
+
+std::string Snapshot::Serialize() const {
+  std::string text;
+
+  // each metric has its type once followed by all of its series
+  for (const auto& metric : group_by_name(counters)) {
+    const auto& name = metric.first;
+    text.append("# TYPE " + name + " counter\n");
+    for (const auto& series : metric.second) {
+      auto braced = series.first.empty() ? "" : "{" + series.first + "}";
+      text.append(name + braced + " " + std::to_string(*series.second) + "\n");
+    }
+  }
+
+  for (const auto& metric : group_by_name(histograms)) {
+    const auto& name = metric.first;
+    text.append("# TYPE " + name + " histogram\n");
+    for (const auto& series : metric.second) {
+      auto labels = series.first.empty() ? "" : series.first + ",";
+
+      // buckets are cumulative, the last one being all of the values
+      const auto& histogram = *series.second;
+      uint64_t cumulative = 0;
+      for (size_t i = 0; i < histogram.bounds.size(); ++i) {
+        cumulative += histogram.buckets[i];
+        text.append(name + "_bucket{" + labels + "le=\"" + format_value(histogram.bounds[i]) +
+                    "\"} " + std::to_string(cumulative) + "\n");
+      }
+      text.append(name + "_bucket{" + labels + "le=\"+Inf\"} " +
+                  std::to_string(histogram.count) + "\n");
+      auto braced = series.first.empty() ? "" : "{" + series.first + "}";
+      text.append(name + "_sum" + braced + " " + format_value(histogram.sum) + "\n");
+      text.append(name + "_count" + braced + " " + std::to_string(histogram.count) + "\n");
+    }
+  }
+  return text;
+}
+
+void Increment(const std::string& name, const Labels& labels, const uint64_t n) {
+  Registry::Get().counter(name, labels).Increment(n);
+}
+
+void Observe(const std::string& name,
+             const double value,
+             const Labels& labels,
+             const std::vector<double>& bounds) {
+  Registry::Get().histogram(name, labels, bounds).Observe(value);
+}
+
+} // namespace metrics
+
+} // namespace midgard
+} // namespace valhalla
@@ -0,0 +1,458 @@
+#include "mjolnir/componentbuilder.h"
+#include "mjolnir/graphtilebuilder.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "baldr/graphconstants.h"
+#include "baldr/graphid.h"
+#include "baldr/graphreader.h"
+#include "baldr/nodecomponent.h"
+#include "midgard/logging.h"
+
+using namespace valhalla::baldr;
+using namespace valhalla::mjolnir;
+
+namespace {
+
+// Marks nodes which have not been visited yet and nodes in tiles which do not exist
+constexpr uint32_t kInvalidIndex = std::numeric_limits<uint32_t>::max();
+
+// Components of the nodes outside of the main components, by tile
+using tile_components_t = std::unordered_map<GraphId, std::vector<NodeComponent>>;
+
+// Can the access mode travel along the edge. Unlike the stored reach this has to be the least
+// restrictive any costing of the mode can be so that a path the costing could take is never
+// missed, which means only looking at access
+bool allowed(const DirectedEdge* edge, const uint32_t access) {
+  return !edge->is_shortcut() && (edge->forwardaccess() & access);
+}
+
+std::string mode_name(const uint32_t access) {
+  switch (access) {
+    case kAutoAccess:
+      return "auto";
+    case kTruckAccess:
+      return "truck";
+    case kBicycleAccess:
+      return "bicycle";
+    case kPedestrianAccess:
+      return "pedestrian";
+    default:
+      return std::to_string(access);
+  }
+}
+
+/**
+ * The graph of an access mode over the nodes of all of the tiles (at all levels), which are
+ * numbered consecutively tile by tile. A node the mode can pass has arcs to the end nodes of the
+ * edges the mode can take and to its copies on the other levels. A node the mode cannot pass has
+ * none since the costings never expand from such a node.
+ */
+class ModeGraph {
+public:
+  ModeGraph(GraphReader& reader, const std::vector<GraphId>& tiles, const uint32_t access)
+      : reader_(reader), access_(access), size_(0) {
+    for (const auto& tile_id : tiles) {
+      const auto* tile = reader_.GetGraphTile(tile_id);
+      if (tile == nullptr) {
+        continue;
+      }
+      auto count = tile->header()->nodecount();
+      if (size_ + count >= kInvalidIndex) {
+        throw std::runtime_error("ComponentBuilder: too many nodes to number");
+      }
+      bases_.emplace(tile_id, static_cast<uint32_t>(size_));
+      tiles_.emplace_back(tile_id, count);
+      size_ += count;
+      Trim();
+    }
+  }
+
+  // Tiles and their node counts in the order the nodes are numbered
+  const std::vector<std::pair<GraphId, uint32_t>>& tiles() const {
+    return tiles_;
+  }
+
+  // Number of nodes
+  size_t size() const {
+    return size_;
+  }
+
+  // Index of a node or kInvalidIndex if its tile does not exist
+  uint32_t index(const GraphId& node) const {
+    auto base = bases_.find(node.Tile_Base());
+    return base == bases_.cend() ? kInvalidIndex : base->second + node.id();
+  }
+
+  // Get the next node the node has an arc to starting at the position among its edges and
+  // transitions, the position is moved past it. Returns an invalid id if there are no more
+  GraphId Next(const GraphId& node, uint32_t& position) {
+    const GraphTile* tile = nullptr;
+    if (!reader_.GetGraphTile(node, tile)) {
+      return {};
+    }
+    const auto* info = tile->node(node);
+    if (!(info->access() & access_)) {
+      return {};
+    }
+    while (position < info->edge_count()) {
+      const auto* edge = tile->directededge(info->edge_index() + position++);
+      if (allowed(edge, access_)) {
+        return edge->endnode();
+      }
+    }
+    uint32_t transition = position - info->edge_count();
+    if (transition < info->transition_count()) {
+      ++position;
+      return tile->transition(info->transition_index() + transition)->endnode();
+    }
+    return {};
+  }
+
+  // Calls the function with every node the node has an arc to
+  template <typename function_t> void Successors(const GraphId& node, function_t&& function) {
+    uint32_t position = 0;
+    for (auto next = Next(node, position); next.Is_Valid(); next = Next(node, position)) {
+      function(next);
+    }
+  }
+
+  // Calls the function with every node which has an arc to the node
+  template <typename function_t> void Predecessors(const GraphId& node, function_t&& function) {
+    const GraphTile* tile = nullptr;
+    if (!reader_.GetGraphTile(node, tile)) {
+      return;
+    }
+    const GraphTile* end_tile = nullptr;
+    const auto* info = tile->node(node);
+    for (const auto& edge : tile->GetDirectedEdges(info)) {
+      // the opposing edge is the one that arrives at this node
+      if (edge.is_shortcut() || !reader_.GetGraphTile(edge.endnode(), end_tile)) {
+        continue;
+      }
+      const auto* end_node = end_tile->node(edge.endnode());
+      const auto* opp_edge = end_tile->directededge(end_node->edge_index() + edge.opp_index());
+      if ((end_node->access() & access_) && allowed(opp_edge, access_)) {
+        function(edge.endnode());
+      }
+    }
+    // copies of a node on other levels can be passed the same way as the node
+    if (info->access() & access_) {
+      for (const auto& transition : tile->GetNodeTransitions(info)) {
+        function(transition.endnode());
+      }
+    }
+  }
+
+  // Can a location be at the node, meaning the mode can pass it and some edge at the node can
+  // be taken by the mode in one direction or the other. No other node needs to be stored
+  bool Locatable(const GraphId& node) {
+    const GraphTile* tile = nullptr;
+    if (!reader_.GetGraphTile(node, tile)) {
+      return false;
+    }
+    const auto* info = tile->node(node);
+    if (!(info->access() & access_)) {
+      return false;
+    }
+    for (const auto& edge : tile->GetDirectedEdges(info)) {
+      if (!edge.is_shortcut() && ((edge.forwardaccess() | edge.reverseaccess()) & access_)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Clear the tile cache if it is over committed
+  void Trim() {
+    if (reader_.OverCommitted()) {
+      reader_.Trim();
+    }
+  }
+
+protected:
+  GraphReader& reader_;
+  uint32_t access_;
+  size_t size_;
+  std::unordered_map<GraphId, uint32_t> bases_;
+  std::vector<std::pair<GraphId, uint32_t>> tiles_;
+};
+
+/**
+ * Computes the components of an access mode and returns those of the nodes outside of its
+ * main component (the largest strongly connected component) by tile.
+ */
+tile_components_t
+find_components(GraphReader& reader, const std::vector<GraphId>& tiles, const size_t mode) {
+  ModeGraph graph(reader, tiles, kComponentAccessModes[mode]);
+  auto for_each_node = [&graph](const std::function<void(const GraphId&, uint32_t)>& function) {
+    uint32_t index = 0;
+    for (const auto& tile : graph.tiles()) {
+      GraphId node = tile.first;
+      for (uint32_t n = 0; n < tile.second; ++n, ++node, ++index) {
+        function(node, index);
+      }
+      graph.Trim();
+    }
+  };
+
+  // Label the strongly connected components with an iterative version of Tarjan's algorithm.
+  // While a node is on the stack its component holds its lowlink
+  std::vector<uint32_t> order(graph.size(), kInvalidIndex);
+  std::vector<uint32_t> component(graph.size(), kInvalidIndex);
+  std::vector<bool> on_stack(graph.size(), false);
+  std::vector<uint32_t> stack;
+  std::vector<std::pair<GraphId, uint32_t>> calls; // node and position among its arcs
+  std::vector<uint32_t> sizes;                     // number of nodes in each component
+  uint32_t visited = 0;
+  auto visit = [&](const GraphId& node, const uint32_t index) {
+    order[index] = component[index] = visited++;
+    on_stack[index] = true;
+    stack.push_back(index);
+    calls.emplace_back(node, 0);
+  };
+  for_each_node([&](const GraphId& root, const uint32_t root_index) {
+    if (order[root_index] != kInvalidIndex) {
+      return;
+    }
+    visit(root, root_index);
+    while (!calls.empty()) {
+      auto node = calls.back().first;
+      auto v = graph.index(node);
+      auto next = graph.Next(node, calls.back().second);
+      if (next.Is_Valid()) {
+        auto w = graph.index(next);
+        if (w == kInvalidIndex) {
+          continue;
+        }
+        if (order[w] == kInvalidIndex) {
+          visit(next, w);
+        } else if (on_stack[w]) {
+          component[v] = std::min(component[v], order[w]);
+        }
+        continue;
+      }
+
+      // all of the arcs are done, either the node is the root of a component which is popped
+      // off the stack or its lowlink is passed back to the node it was visited from
+      calls.pop_back();
+      if (component[v] == order[v]) {
+        uint32_t id = sizes.size();
+        sizes.push_back(0);
+        uint32_t w;
+        do {
+          w = stack.back();
+          stack.pop_back();
+          on_stack[w] = false;
+          component[w] = id;
+          ++sizes.back();
+        } while (w != v);
+      } else {
+        auto u = graph.index(calls.back().first);
+        component[u] = std::min(component[u], component[v]);
+      }
+      graph.Trim();
+    }
+  });
+  on_stack = std::vector<bool>();
+  if (sizes.empty()) {
+    return {};
+  }
+  uint32_t main = std::max_element(sizes.begin(), sizes.end()) - sizes.begin();
+
+  // The islands are the weakly connected components, join the ends of every arc. The order
+  // is no longer needed so it holds the parent of each node
+  auto& parent = order;
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&parent](uint32_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+  GraphId main_node;
+  for_each_node([&](const GraphId& node, const uint32_t v) {
+    if (component[v] == main && !main_node.Is_Valid()) {
+      main_node = node;
+    }
+    graph.Successors(node, [&](const GraphId& next) {
+      auto w = graph.index(next);
+      if (w == kInvalidIndex) {
+        return;
+      }
+      auto a = find(v), b = find(w);
+      if (a != b) {
+        parent[std::max(a, b)] = std::min(a, b);
+      }
+    });
+  });
+  auto main_island = find(graph.index(main_node));
+
+  // Mark what can be reached from the main component and what can reach it
+  auto mark = [&graph](const GraphId& start, const bool forward) {
+    std::vector<bool> marked(graph.size(), false);
+    std::vector<GraphId> queue{start};
+    marked[graph.index(start)] = true;
+    while (!queue.empty()) {
+      auto node = queue.back();
+      queue.pop_back();
+      auto enqueue = [&](const GraphId& next) {
+        auto w = graph.index(next);
+        if (w != kInvalidIndex && !marked[w]) {
+          marked[w] = true;
+          queue.push_back(next);
+        }
+      };
+      if (forward) {
+        graph.Successors(node, enqueue);
+      } else {
+        graph.Predecessors(node, enqueue);
+      }
+      graph.Trim();
+    }
+    return marked;
+  };
+  auto reached_from_main = mark(main_node, true);
+  auto reaches_main = mark(main_node, false);
+
+  // Only the nodes a location can be at are stored
+  size_t stored = 0;
+  tile_components_t found;
+  for_each_node([&](const GraphId& node, const uint32_t v) {
+    if (component[v] == main || !graph.Locatable(node)) {
+      return;
+    }
+    auto island = find(v);
+    found[node.Tile_Base()].emplace_back(node.id(), mode, component[v] + 1,
+                                         island == main_island ? kMainComponent : island + 1,
+                                         reaches_main[v], reached_from_main[v]);
+    ++stored;
+  });
+  LOG_INFO(mode_name(kComponentAccessModes[mode]) + ": " + std::to_string(sizes.size()) +
+           " components, the main one has " + std::to_string(sizes[main]) + " of " +
+           std::to_string(graph.size()) + " nodes, storing " + std::to_string(stored) + " nodes");
+  return found;
+}
+
+/**
+ * Computes the components of the access modes. Each thread pulls a mode off the queue.
+ */
+void add_modes(const boost::property_tree::ptree& pt,
+               const std::vector<GraphId>& tiles,
+               std::deque<size_t>& modequeue,
+               std::mutex& lock,
+               tile_components_t& components) {
+  GraphReader graphreader(pt.get_child("mjolnir"));
+  while (true) {
+    lock.lock();
+    if (modequeue.empty()) {
+      lock.unlock();
+      break;
+    }
+    auto mode = modequeue.front();
+    modequeue.pop_front();
+    lock.unlock();
+
+    auto found = find_components(graphreader, tiles, mode);
+    graphreader.Clear();
+
+    // Hand them over
+    std::lock_guard<std::mutex> _(lock);
+    for (auto& tile : found) {
+      auto& tile_components = components[tile.first];
+      tile_components.insert(tile_components.end(), tile.second.begin(), tile.second.end());
+    }
+  }
+}
+
+/**
+ * Adds the node components to a set of tiles. Each thread pulls a tile off the queue.
+ */
+void add_components(const boost::property_tree::ptree& pt,
+                    std::deque<GraphId>& tilequeue,
+                    std::mutex& lock,
+                    tile_components_t& components) {
+  auto tile_dir = pt.get<std::string>("mjolnir.tile_dir");
+  while (true) {
+    lock.lock();
+    if (tilequeue.empty()) {
+      lock.unlock();
+      break;
+    }
+    GraphId tile_id = tilequeue.front();
+    tilequeue.pop_front();
+    std::vector<NodeComponent> tile_components;
+    auto found = components.find(tile_id);
+    if (found != components.end()) {
+      tile_components.swap(found->second);
+    }
+    lock.unlock();
+
+    // Tiles without any are updated too, they then have all of their nodes in the main components
+    GraphTileBuilder tilebuilder(tile_dir, tile_id, false);
+    tilebuilder.UpdateComponents(std::move(tile_components));
+  }
+}
+
+} // namespace
+
+namespace valhalla {
+namespace mjolnir {
+
+void ComponentBuilder::Build(const boost::property_tree::ptree& pt) {
+  // Sort the tiles (at all levels) so that the nodes are always numbered the same way
+  GraphReader reader(pt.get_child("mjolnir"));
+  auto tileset = reader.GetTileSet();
+  std::vector<GraphId> tiles(tileset.begin(), tileset.end());
+  std::sort(tiles.begin(), tiles.end());
+
+  // An mutex we can use to do the synchronization
+  std::mutex lock;
+
+  // Setup threads, each of them holds the graph of a mode in memory
+  uint32_t nthreads =
+      std::max(static_cast<unsigned int>(1),
+               pt.get<unsigned int>("concurrency", std::thread::hardware_concurrency()));
+  std::vector<std::shared_ptr<std::thread>> threads(std::min<size_t>(nthreads, kComponentModeCount));
+
+  LOG_INFO("Finding the connected components of " + std::to_string(kComponentModeCount) +
+           " modes in " + std::to_string(tiles.size()) + " tiles with " +
+           std::to_string(threads.size()) + " threads...");
+
+  // Compute the components of each mode
+  std::deque<size_t> modequeue(kComponentModeCount);
+  std::iota(modequeue.begin(), modequeue.end(), 0);
+  tile_components_t components;
+  for (auto& thread : threads) {
+    thread.reset(new std::thread(add_modes, std::cref(pt), std::cref(tiles), std::ref(modequeue),
+                                 std::ref(lock), std::ref(components)));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  // Write them to the tiles
+  std::deque<GraphId> tilequeue(tiles.begin(), tiles.end());
+  threads.resize(nthreads);
+  for (auto& thread : threads) {
+    thread.reset(new std::thread(add_components, std::cref(pt), std::ref(tilequeue),
+                                 std::ref(lock), std::ref(components)));
+  }
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  LOG_INFO("Finished");
+}
+
+} // namespace mjolnir
+} // namespace valhalla
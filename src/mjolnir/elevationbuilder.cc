@@ -1,7 +1,9 @@
 #include "mjolnir/util.h"
 
+#include <algorithm>
 #include <boost/filesystem/operations.hpp>
 #include <boost/format.hpp>
+#include <cmath>
 #include <future>
 #include <set>
 #include <thread>
@@ -10,6 +12,7 @@
 #include "baldr/graphconstants.h"
 #include "baldr/graphid.h"
 #include "baldr/graphreader.h"
+#include "baldr/tilehierarchy.h"
 #include "midgard/logging.h"
 #include "midgard/pointll.h"
 #include "midgard/polyline2.h"
@@ -32,6 +35,26 @@ constexpr double POSTING_INTERVAL = 60;
 // Do not compute grade for intervals less than 10 meters.
 constexpr double kMinimumInterval = 10.0f;
 
+// A level 0 graph tile covers 4x4 DEM tiles, 5x5 counting the edges leaving it
+constexpr size_t kMaxDEMTilesPerGraphTile = 25;
+
+/**
+ * Gets the 1x1 degree DEM tile which the center of a graph tile falls in. Rows of DEM tiles
+ * alternate direction so that consecutive indices are always neighbouring DEM tiles.
+ */
+uint32_t dem_tile_index(const GraphId& tile_id) {
+  const auto& levels = TileHierarchy::levels();
+  const auto& level = tile_id.level() == TileHierarchy::GetTransitLevel().level
+                          ? TileHierarchy::GetTransitLevel()
+                          : levels.at(tile_id.level());
+  auto center = level.tiles.Center(tile_id.tileid());
+  auto row = static_cast<uint32_t>(
+      std::min(std::max(std::floor(center.lat()) + 90.0, 0.0), 179.0));
+  auto col = static_cast<uint32_t>(
+      std::min(std::max(std::floor(center.lng()) + 180.0, 0.0), 359.0));
+  return row * 360 + (row % 2 ? 359 - col : col);
+}
+
 /**
  * Adds elevation to a set of tiles. Each thread pulls a tile of the queue
  */
@@ -166,38 +189,39 @@ namespace valhalla {
 namespace mjolnir {
 
 void ElevationBuilder::Build(const boost::property_tree::ptree& pt) {
+  // Queue all of the tiles (at all levels) ordered by the DEM tile they are in so that the
+  // threads work on neighbouring graph tiles and mostly sample already decompressed DEM tiles
+  // rather than each inflating their own
+  GraphReader reader(pt.get_child("mjolnir"));
+  Build(pt, ScheduleTiles(reader.GetTileSet()));
+}
 
-  auto hierarchy_properties = pt.get_child("mjolnir");
-  std::string tile_dir = hierarchy_properties.get<std::string>("tile_dir");
+void ElevationBuilder::Build(const boost::property_tree::ptree& pt, std::deque<GraphId> tilequeue) {
+  // Setup threads
+  uint32_t nthreads =
+      std::max(static_cast<unsigned int>(1),
+               pt.get<unsigned int>("concurrency", std::thread::hardware_concurrency()));
+  std::vector<std::shared_ptr<std::thread>> threads(nthreads);
 
-  // Crack open some elevation data if its there. Return if it is not.
+  // Crack open some elevation data if its there. Return if it is not. All threads share the
+  // decompressed DEM tiles so by default keep enough of them around for every thread to be
+  // working within a level 0 graph tile without evicting the DEM tiles another thread needs
   boost::optional<std::string> elevation = pt.get_optional<std::string>("additional_data.elevation");
   std::unique_ptr<const skadi::sample> sample;
   if (elevation && boost::filesystem::exists(*elevation)) {
-    sample.reset(new skadi::sample(*elevation));
+    size_t cache_size =
+        pt.get<size_t>("additional_data.elevation_cache_size",
+                       std::max(skadi::sample::kDefaultCacheSize,
+                                (kMaxDEMTilesPerGraphTile + nthreads) * skadi::sample::kTileSize));
+    sample.reset(new skadi::sample(*elevation, cache_size));
   } else {
     LOG_INFO("ElevationBuilder: no elevation data, skipping");
     return;
   }
 
-  // Create a randomized queue of tiles (at all levels) to work from
-  std::deque<GraphId> tilequeue;
-  GraphReader reader(pt.get_child("mjolnir"));
-  auto tileset = reader.GetTileSet();
-  for (const auto& id : tileset) {
-    tilequeue.emplace_back(id);
-  }
-  std::random_shuffle(tilequeue.begin(), tilequeue.end());
-
   // An mutex we can use to do the synchronization
   std::mutex lock;
 
-  // Setup threads
-  uint32_t nthreads =
-      std::max(static_cast<unsigned int>(1),
-               pt.get<unsigned int>("concurrency", std::thread::hardware_concurrency()));
-  std::vector<std::shared_ptr<std::thread>> threads(nthreads);
-
   // Setup promises. Hold the results for the threads
   std::vector<std::promise<uint32_t>> results(nthreads);
 
@@ -229,5 +253,22 @@ void ElevationBuilder::Build(const boost::property_tree::ptree& pt) {
   LOG_INFO("Finished");
 }
 
+std::deque<GraphId> ElevationBuilder::ScheduleTiles(const std::unordered_set<GraphId>& tile_ids) {
+  std::vector<std::pair<uint32_t, GraphId>> dem_ordered;
+  dem_ordered.reserve(tile_ids.size());
+  for (const auto& id : tile_ids) {
+    dem_ordered.emplace_back(dem_tile_index(id), id);
+  }
+  std::sort(dem_ordered.begin(), dem_ordered.end(),
+            [](const std::pair<uint32_t, GraphId>& a, const std::pair<uint32_t, GraphId>& b) {
+              return a.first == b.first ? a.second.value < b.second.value : a.first < b.first;
+            });
+  std::deque<GraphId> tilequeue;
+  for (const auto& tile : dem_ordered) {
+    tilequeue.emplace_back(tile.second);
+  }
+  return tilequeue;
+}
+
 } // namespace mjolnir
 } // namespace valhalla
@@ -339,6 +339,11 @@ void GraphTileBuilder::StoreTileData() {
     header_builder_.set_end_offset(header_builder_.lane_connectivity_offset() +
                                    (lane_connectivity_builder_.size() * sizeof(LaneConnectivity)));
 
+    // Any edge reach or node components are not carried over, they have to be computed again
+    // once the graph is complete
+    header_builder_.set_reach_offset(0);
+    header_builder_.set_component_offset(0);
+
     // Sanity check for the end offset
     uint32_t curr =
         static_cast<uint32_t>(in_mem.tellp()) + static_cast<uint32_t>(sizeof(GraphTileHeader));
@@ -948,6 +953,12 @@ void GraphTileBuilder::AddBins(const std::string& tile_dir,
   header.set_edgeinfo_offset(header.edgeinfo_offset() + shift);
   header.set_textlist_offset(header.textlist_offset() + shift);
   header.set_lane_connectivity_offset(header.lane_connectivity_offset() + shift);
+  if (header.reach_offset() > 0) {
+    header.set_reach_offset(header.reach_offset() + shift);
+  }
+  if (header.component_offset() > 0) {
+    header.set_component_offset(header.component_offset() + shift);
+  }
   header.set_end_offset(header.end_offset() + shift);
   // rewrite the tile
   boost::filesystem::path filename =
@@ -1022,12 +1033,23 @@ void GraphTileBuilder::UpdatePredictedSpeeds(const std::vector<DirectedEdge>& di
   std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
   if (file.is_open()) {
     // Write a new header - add the offset to predicted speed data and the profile count.
-    // Update the end offset (shift by the amount of predicted speed data added).
-    size_t offset = header_->end_offset();
-    header_builder_.set_end_offset(header_->end_offset() +
-                                   (speed_profile_offset_builder_.size() * sizeof(uint32_t)) +
-                                   (speed_profile_builder_.size() * sizeof(int16_t)));
+    // Update the end offset (shift by the amount of predicted speed data added). Edge reach
+    // and node components are always the last sections of the tile so they move after the
+    // predicted speed data.
+    size_t offset = header_->reach_offset() > 0       ? header_->reach_offset()
+                    : header_->component_offset() > 0 ? header_->component_offset()
+                                                      : header_->end_offset();
+    size_t computed_size = header_->end_offset() - offset;
+    size_t shift = (speed_profile_offset_builder_.size() * sizeof(uint32_t)) +
+                   (speed_profile_builder_.size() * sizeof(int16_t));
+    header_builder_.set_end_offset(header_->end_offset() + shift);
     header_builder_.set_predictedspeeds_offset(offset);
+    if (header_->reach_offset() > 0) {
+      header_builder_.set_reach_offset(header_->reach_offset() + shift);
+    }
+    if (header_->component_offset() > 0) {
+      header_builder_.set_component_offset(header_->component_offset() + shift);
+    }
     header_builder_.set_predictedspeeds_count(speed_profile_builder_.size() / kCoefficientCount);
     file.write(reinterpret_cast<const char*>(&header_builder_), sizeof(GraphTileHeader));
 
@@ -1056,13 +1078,113 @@ void GraphTileBuilder::UpdatePredictedSpeeds(const std::vector<DirectedEdge>& di
     file.write(reinterpret_cast<const char*>(speed_profile_builder_.data()),
                speed_profile_builder_.size() * sizeof(int16_t));
 
-    // Write the rest of the tiles. TBD (if anything is added after the speed profiles
-    // then this will need to be updated)
+    // Write the edge reach and node components (if any) after the speed profiles
+    file.write(reinterpret_cast<const char*>(header()) + offset, computed_size);
 
     // Close the file
     file.close();
   }
 }
 
+// Updates a tile with the reach of each directed edge. The reach is written
+// at the end of the tile, replacing any reach already in the tile. Node components
+// (if any) stay after the reach.
+void GraphTileBuilder::UpdateReach(const std::vector<EdgeReach>& reach) {
+  // Make sure there is reach for every directed edge
+  if (reach.size() != header_->directededgecount()) {
+    throw std::runtime_error("GraphTileBuilder::UpdateReach - directed edge count does not match");
+  }
+
+  // Get the name of the file
+  boost::filesystem::path filename = tile_dir_ + filesystem::path::preferred_separator +
+                                     GraphTile::FileSuffix(header_builder_.graphid());
+
+  // Make sure the directory exists on the system
+  if (!boost::filesystem::exists(filename.parent_path()))
+    boost::filesystem::create_directories(filename.parent_path());
+
+  // Other threads keep reading tiles while reach is computed so write to a temporary file
+  // and move it into place once it is complete
+  boost::filesystem::path tmp_filename = filename.string() + ".tmp";
+  std::ofstream file(tmp_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (file.is_open()) {
+    // Write a new header - set the offset to the reach data and update the end offset
+    size_t offset = header_->reach_offset() > 0       ? header_->reach_offset()
+                    : header_->component_offset() > 0 ? header_->component_offset()
+                                                      : header_->end_offset();
+    size_t reach_size = reach.size() * sizeof(EdgeReach);
+    size_t components_size = header_->component_offset() > 0
+                                 ? header_->end_offset() - header_->component_offset()
+                                 : 0;
+    header_builder_.set_reach_offset(offset);
+    if (header_->component_offset() > 0) {
+      header_builder_.set_component_offset(offset + reach_size);
+    }
+    header_builder_.set_end_offset(offset + reach_size + components_size);
+    file.write(reinterpret_cast<const char*>(&header_builder_), sizeof(GraphTileHeader));
+
+    // Copy everything after the header up to the reach data (unchanged)
+    auto begin = reinterpret_cast<const char*>(header()) + sizeof(GraphTileHeader);
+    auto end = reinterpret_cast<const char*>(header()) + offset;
+    file.write(begin, end - begin);
+
+    // Append the reach and the node components after it (unchanged)
+    file.write(reinterpret_cast<const char*>(reach.data()), reach_size);
+    file.write(reinterpret_cast<const char*>(header()) + header_->component_offset(),
+               components_size);
+
+    // Close the file and replace the tile
+    file.close();
+    boost::filesystem::rename(tmp_filename, filename);
+  } else {
+    throw std::runtime_error("GraphTileBuilder::UpdateReach - Failed to open file " +
+                             tmp_filename.string());
+  }
+}
+
+// Updates a tile with the components of the nodes outside of the main component of
+// each mode. The components are written as the last section of the tile, replacing any
+// components already in the tile.
+void GraphTileBuilder::UpdateComponents(std::vector<NodeComponent> components) {
+  // Get the name of the file
+  boost::filesystem::path filename = tile_dir_ + filesystem::path::preferred_separator +
+                                     GraphTile::FileSuffix(header_builder_.graphid());
+
+  // Make sure the directory exists on the system
+  if (!boost::filesystem::exists(filename.parent_path()))
+    boost::filesystem::create_directories(filename.parent_path());
+
+  // Other threads keep reading tiles while components are written so write to a temporary
+  // file and move it into place once it is complete
+  boost::filesystem::path tmp_filename = filename.string() + ".tmp";
+  std::ofstream file(tmp_filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (file.is_open()) {
+    // Write a new header - set the offset to the components and update the end offset. An
+    // empty section still tells that all of the nodes are in the main components
+    size_t offset =
+        header_->component_offset() > 0 ? header_->component_offset() : header_->end_offset();
+    header_builder_.set_component_offset(offset);
+    header_builder_.set_end_offset(offset + components.size() * sizeof(NodeComponent));
+    file.write(reinterpret_cast<const char*>(&header_builder_), sizeof(GraphTileHeader));
+
+    // Copy everything after the header up to the components (unchanged)
+    auto begin = reinterpret_cast<const char*>(header()) + sizeof(GraphTileHeader);
+    auto end = reinterpret_cast<const char*>(header()) + offset;
+    file.write(begin, end - begin);
+
+    // Append the components sorted so they can be binary searched
+    std::sort(components.begin(), components.end());
+    file.write(reinterpret_cast<const char*>(components.data()),
+               components.size() * sizeof(NodeComponent));
+
+    // Close the file and replace the tile
+    file.close();
+    boost::filesystem::rename(tmp_filename, filename);
+  } else {
+    throw std::runtime_error("GraphTileBuilder::UpdateComponents - Failed to open file " +
+                             tmp_filename.string());
+  }
+}
+
 } // namespace mjolnir
 } // namespace valhalla
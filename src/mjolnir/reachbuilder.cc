@@ -0,0 +1,255 @@
+#include "mjolnir/reachbuilder.h"
+#include "mjolnir/graphtilebuilder.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "baldr/edgereach.h"
+#include "baldr/graphconstants.h"
+#include "baldr/graphid.h"
+#include "baldr/graphreader.h"
+#include "midgard/logging.h"
+
+using namespace valhalla::baldr;
+using namespace valhalla::mjolnir;
+
+namespace {
+
+// Default max reachability (used if service_limits.max_reachability is not in the config)
+constexpr uint32_t kDefaultMaxReachability = 100;
+
+// Is the edge traversable by the access mode. These match the edge filters of the costings
+// that use the stored reach. For pedestrians this is the most restrictive the filter can be
+// (no hiking difficulty allowed) so the stored reach never exceeds what the costing allows.
+bool allowed(const DirectedEdge* edge, const uint32_t access) {
+  if (edge->is_shortcut() || !(edge->forwardaccess() & access)) {
+    return false;
+  }
+  return access != kPedestrianAccess ||
+         (edge->use() < Use::kRail && edge->sac_scale() == SacScale::kNone);
+}
+
+/**
+ * Computes the reach of nodes for an access mode using the same simple expansion that
+ * loki::Reach starts with: the number of nodes which can be reached from (forward) or
+ * which can reach (reverse) a node, stopping at restrictions. Results are cached by node.
+ */
+class NodeReach {
+public:
+  NodeReach(GraphReader& reader, const uint32_t access, const bool forward, const uint32_t max_reach)
+      : reader_(reader), access_(access), forward_(forward), max_reach_(max_reach), transitions_(0) {
+  }
+
+  uint32_t operator()(const GraphId& node_id) {
+    // we may have already expanded from this node
+    auto cached = cache_.find(node_id);
+    if (cached != cache_.cend()) {
+      return cached->second;
+    }
+
+    // expand until we either hit the max reach or can no longer expand
+    queue_.clear();
+    done_.clear();
+    transitions_ = 0;
+    enqueue(node_id);
+    const GraphTile* tile = nullptr;
+    const GraphTile* end_tile = nullptr;
+    while (queue_.size() + done_.size() - transitions_ < max_reach_ && !queue_.empty()) {
+      // increase the reach and get the nodes id
+      auto id = GraphId(*done_.insert(*queue_.begin()).first);
+      queue_.erase(queue_.begin());
+      if (!reader_.GetGraphTile(id, tile)) {
+        continue;
+      }
+      for (const auto& edge : tile->GetDirectedEdges(id)) {
+        // forward we need to be able to take this edge, reverse we need to be able to take its
+        // opposing edge. either way we stop at the restrictions like the loki expansion does
+        if (forward_) {
+          if (allowed(&edge, access_) && !edge.end_restriction() && !edge.restrictions()) {
+            enqueue(edge.endnode());
+          }
+          continue;
+        }
+        if (!reader_.GetGraphTile(edge.endnode(), end_tile)) {
+          continue;
+        }
+        const auto* node = end_tile->node(edge.endnode());
+        const auto* opp_edge = end_tile->directededge(node->edge_index() + edge.opp_index());
+        if (allowed(opp_edge, access_) && !opp_edge->start_restriction() &&
+            !opp_edge->restrictions()) {
+          enqueue(edge.endnode());
+        }
+      }
+    }
+
+    // settled nodes + will be settled nodes - duplicated transitions nodes
+    auto reach = std::min(static_cast<uint32_t>(queue_.size() + done_.size() - transitions_),
+                          max_reach_);
+    cache_.emplace(node_id, reach);
+    return reach;
+  }
+
+  void Clear() {
+    cache_.clear();
+  }
+
+protected:
+  void enqueue(const GraphId& node_id) {
+    // skip nodes which are done or invalid
+    const GraphTile* tile = nullptr;
+    if (!node_id.Is_Valid() || done_.find(node_id) != done_.cend() ||
+        !reader_.GetGraphTile(node_id, tile)) {
+      return;
+    }
+    // if the node isnt accessible bail
+    const auto* node = tile->node(node_id);
+    if (!(node->access() & access_)) {
+      return;
+    }
+    // otherwise we enqueue it and its doppelgangers on the other levels
+    queue_.insert(node_id);
+    for (const auto& transition : tile->GetNodeTransitions(node)) {
+      queue_.insert(transition.endnode());
+    }
+    transitions_ += node->transition_count();
+  }
+
+  GraphReader& reader_;
+  uint32_t access_;
+  bool forward_;
+  uint32_t max_reach_;
+  std::unordered_set<uint64_t> queue_, done_;
+  size_t transitions_;
+  std::unordered_map<uint64_t, uint32_t> cache_;
+};
+
+/**
+ * Adds edge reach to a set of tiles. Each thread pulls a tile of the queue
+ */
+void add_reach(const boost::property_tree::ptree& pt,
+               std::deque<GraphId>& tilequeue,
+               std::mutex& lock,
+               const uint32_t max_reach) {
+  // Local Graphreader
+  GraphReader graphreader(pt.get_child("mjolnir"));
+
+  // Outbound reach of an edge is the forward reach of its end node and inbound reach
+  // is the reverse reach of its begin node so we compute (and cache) reach per node
+  std::vector<NodeReach> outbound, inbound;
+  for (const auto access : kReachAccessModes) {
+    outbound.emplace_back(graphreader, access, true, max_reach);
+    inbound.emplace_back(graphreader, access, false, max_reach);
+  }
+
+  // Check for more tiles
+  std::vector<EdgeReach> reach;
+  while (true) {
+    lock.lock();
+    if (tilequeue.empty()) {
+      lock.unlock();
+      break;
+    }
+    // Get the next tile Id
+    GraphId tile_id = tilequeue.front();
+    tilequeue.pop_front();
+    lock.unlock();
+
+    // Get the tile, we only append to it so there is no need to serialize it
+    GraphTileBuilder tilebuilder(graphreader.tile_dir(), tile_id, false);
+    reach.assign(tilebuilder.header()->directededgecount(), EdgeReach());
+
+    // Iterate through the nodes and the directed edges leaving them
+    GraphId node_id = tile_id;
+    for (uint32_t n = 0; n < tilebuilder.header()->nodecount(); ++n, ++node_id) {
+      const NodeInfo& node = tilebuilder.node(n);
+      for (uint32_t idx = node.edge_index(); idx < node.edge_index() + node.edge_count(); ++idx) {
+        const DirectedEdge& edge = tilebuilder.directededge(idx);
+        for (size_t mode = 0; mode < kReachModeCount; ++mode) {
+          if (!allowed(&edge, kReachAccessModes[mode])) {
+            continue;
+          }
+          // we cant start on a simple restriction without predecessor information
+          uint32_t out = edge.restrictions() ? 0 : outbound[mode](edge.endnode());
+          reach[idx].set_reach(mode, out, inbound[mode](node_id));
+        }
+      }
+    }
+
+    // Update the tile
+    tilebuilder.UpdateReach(reach);
+
+    // Reach of nodes in other tiles is less likely to be needed again
+    for (auto& node_reach : outbound) {
+      node_reach.Clear();
+    }
+    for (auto& node_reach : inbound) {
+      node_reach.Clear();
+    }
+
+    // Check if we need to clear the tile cache
+    if (graphreader.OverCommitted()) {
+      lock.lock();
+      graphreader.Trim();
+      lock.unlock();
+    }
+  }
+}
+
+} // namespace
+
+namespace valhalla {
+namespace mjolnir {
+
+void ReachBuilder::Build(const boost::property_tree::ptree& pt) {
+  // The reach is capped at the max reachability the service allows (and what fits in the tile)
+  uint32_t max_reach = std::min(pt.get<uint32_t>("service_limits.max_reachability",
+                                                 kDefaultMaxReachability),
+                                kMaxStoredReach);
+  if (max_reach == 0) {
+    LOG_INFO("ReachBuilder: max reachability is 0, skipping");
+    return;
+  }
+
+  // Create a randomized queue of tiles (at all levels) to work from
+  std::deque<GraphId> tilequeue;
+  GraphReader reader(pt.get_child("mjolnir"));
+  auto tileset = reader.GetTileSet();
+  for (const auto& id : tileset) {
+    tilequeue.emplace_back(id);
+  }
+  std::random_shuffle(tilequeue.begin(), tilequeue.end());
+
+  // An mutex we can use to do the synchronization
+  std::mutex lock;
+
+  // Setup threads
+  uint32_t nthreads =
+      std::max(static_cast<unsigned int>(1),
+               pt.get<unsigned int>("concurrency", std::thread::hardware_concurrency()));
+  std::vector<std::shared_ptr<std::thread>> threads(nthreads);
+
+  LOG_INFO("Adding reach (max " + std::to_string(max_reach) + ") to " +
+           std::to_string(tilequeue.size()) + " tiles with " + std::to_string(nthreads) +
+           " threads...");
+
+  // Spawn the threads
+  for (auto& thread : threads) {
+    thread.reset(new std::thread(add_reach, std::cref(pt), std::ref(tilequeue), std::ref(lock),
+                                 max_reach));
+  }
+
+  // Wait for threads to finish
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  LOG_INFO("Finished");
+}
+
+} // namespace mjolnir
+} // namespace valhalla
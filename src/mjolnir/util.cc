@@ -1,12 +1,16 @@
 #include "mjolnir/util.h"
 
+#include "baldr/graphreader.h"
+#include "baldr/graphtile.h"
 #include "baldr/tilehierarchy.h"
 #include "filesystem.h"
 #include "midgard/aabb2.h"
 #include "midgard/logging.h"
 #include "midgard/point2.h"
 #include "midgard/polyline2.h"
+#include "midgard/sequence.h"
 #include "mjolnir/bssbuilder.h"
+#include "mjolnir/componentbuilder.h"
 #include "mjolnir/elevationbuilder.h"
 #include "mjolnir/graphbuilder.h"
 #include "mjolnir/graphenhancer.h"
@@ -15,6 +19,7 @@
 #include "mjolnir/hierarchybuilder.h"
 #include "mjolnir/osmpbfparser.h"
 #include "mjolnir/pbfgraphparser.h"
+#include "mjolnir/reachbuilder.h"
 #include "mjolnir/restrictionbuilder.h"
 #include "mjolnir/shortcutbuilder.h"
 #include "mjolnir/transitbuilder.h"
@@ -23,6 +28,9 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/filesystem/operations.hpp>
 #include <boost/property_tree/ptree.hpp>
+#include <ctime>
+#include <fstream>
+#include <map>
 
 using namespace valhalla::midgard;
 
@@ -289,6 +297,16 @@ bool build_tile_set(const boost::property_tree::ptree& config,
     GraphValidator::Validate(config);
   }
 
+  // Compute the reach of each edge now that the graph is complete so loki can skip most expansions
+  if (start_stage <= BuildStage::kReach && BuildStage::kReach <= end_stage) {
+    ReachBuilder::Build(config);
+  }
+
+  // Label the connected components of each mode so loki can reject locations that cant be connected
+  if (start_stage <= BuildStage::kComponents && BuildStage::kComponents <= end_stage) {
+    ComponentBuilder::Build(config);
+  }
+
   // Cleanup bin files
   if (start_stage <= BuildStage::kCleanup && BuildStage::kCleanup <= end_stage) {
     LOG_INFO("Cleaning up temporary *.bin files within " + tile_dir);
@@ -307,5 +325,80 @@ bool build_tile_set(const boost::property_tree::ptree& config,
   return true;
 }
 
+size_t build_tile_extract(const std::string& tile_dir, const std::string& tile_extract) {
+  if (!filesystem::is_directory(tile_dir)) {
+    throw std::runtime_error("Tile directory does not exist: " + tile_dir);
+  }
+
+  // Find the tiles and their sizes, sorted by id
+  std::map<uint32_t, std::pair<std::string, uint64_t>> tiles;
+  for (filesystem::recursive_directory_iterator i(tile_dir), end; i != end; ++i) {
+    const auto file_name = i->path().string();
+    if ((!i->is_regular_file() && !i->is_symlink()) || file_name.size() < 4 ||
+        file_name.compare(file_name.size() - 4, 4, ".gph") != 0) {
+      continue;
+    }
+    try {
+      auto tile_id = baldr::GraphTile::GetTileId(file_name);
+      std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+      tiles.emplace(tile_id.value, std::make_pair(file_name, static_cast<uint64_t>(file.tellg())));
+    } catch (...) {
+      // skip files we dont understand
+    }
+  }
+
+  // The position of every tile follows from the sizes of the tiles before it so
+  // the index can be written before the tiles
+  constexpr uint64_t kBlockSize = sizeof(tar::header_t);
+  auto padded = [](const uint64_t size) { return (size + kBlockSize - 1) / kBlockSize * kBlockSize; };
+  std::vector<baldr::tile_index_entry_t> index;
+  index.reserve(tiles.size());
+  uint64_t offset = kBlockSize + padded(tiles.size() * sizeof(baldr::tile_index_entry_t));
+  for (const auto& tile : tiles) {
+    if (tile.second.second > std::numeric_limits<uint32_t>::max()) {
+      throw std::runtime_error("Tile too large for a tile extract: " + tile.second.first);
+    }
+    index.push_back({offset + kBlockSize, tile.first, static_cast<uint32_t>(tile.second.second)});
+    offset += kBlockSize + padded(tile.second.second);
+  }
+
+  std::ofstream extract(tile_extract, std::ios::binary | std::ios::trunc);
+  if (!extract.is_open()) {
+    throw std::runtime_error("Could not open tile extract for writing: " + tile_extract);
+  }
+  const std::vector<char> padding(kBlockSize, 0);
+  const uint64_t mtime = std::time(nullptr);
+  auto write_entry = [&extract, &padding, &padded, mtime](const std::string& name,
+                                                          const char* data, const uint64_t size) {
+    auto header = tar::header_t::create(name, size, mtime);
+    extract.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    extract.write(data, size);
+    extract.write(padding.data(), padded(size) - size);
+  };
+
+  // The index comes first so that readers only need the first entry to find the tiles
+  write_entry(baldr::kTileIndexName, reinterpret_cast<const char*>(index.data()),
+              index.size() * sizeof(baldr::tile_index_entry_t));
+  std::vector<char> data;
+  for (const auto& tile : tiles) {
+    data.resize(tile.second.second);
+    std::ifstream file(tile.second.first, std::ios::binary);
+    if (!file.read(data.data(), data.size())) {
+      throw std::runtime_error("Could not read tile: " + tile.second.first);
+    }
+    write_entry(baldr::GraphTile::FileSuffix(baldr::GraphId(tile.first)), data.data(),
+                data.size());
+  }
+
+  // A tar ends with two empty blocks
+  extract.write(padding.data(), kBlockSize);
+  extract.write(padding.data(), kBlockSize);
+  if (!extract) {
+    throw std::runtime_error("Could not write tile extract: " + tile_extract);
+  }
+  LOG_INFO("Wrote " + std::to_string(tiles.size()) + " tiles to " + tile_extract);
+  return tiles.size();
+}
+
 } // namespace mjolnir
 } // namespace valhalla
@@ -0,0 +1,109 @@
+#include <string>
+
+#include "config.h"
+#include "mjolnir/util.h"
+
+using namespace valhalla::mjolnir;
+
+#include "baldr/rapidjson_utils.h"
+#include <boost/optional.hpp>
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <iostream>
+
+#include "filesystem.h"
+#include "midgard/logging.h"
+#include "midgard/util.h"
+
+namespace bpo = boost::program_options;
+
+int main(int argc, char** argv) {
+  // Program options
+  std::string config_file_path;
+  std::string inline_config;
+  std::string tile_dir;
+  std::string tile_extract;
+  bpo::options_description options(
+      "valhalla_build_extract " VALHALLA_VERSION "\n\n"
+      "Usage: valhalla_build_extract [options]\n\n"
+      "valhalla_build_extract is a program that writes the tiles of mjolnir.tile_dir to an "
+      "indexed tile extract at mjolnir.tile_extract. The extract is a tar of the tiles that "
+      "starts with an index of them so that it loads without reading every tile header.\n\n");
+
+  options.add_options()("help,h", "Print this help message.")("version,v",
+                                                              "Print the version of this software.")(
+      "config,c", boost::program_options::value<std::string>(&config_file_path),
+      "Path to the json configuration file.")("inline-config,i",
+                                              boost::program_options::value<std::string>(
+                                                  &inline_config),
+                                              "Inline json config.")(
+      "tile-dir,d", boost::program_options::value<std::string>(&tile_dir),
+      "Directory of the tiles, defaults to mjolnir.tile_dir.")(
+      "tile-extract,o", boost::program_options::value<std::string>(&tile_extract),
+      "Path of the extract to write, defaults to mjolnir.tile_extract.");
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv).options(options).run(), vm);
+    bpo::notify(vm);
+
+  } catch (std::exception& e) {
+    std::cerr << "Unable to parse command line options because: " << e.what() << "\n";
+    return EXIT_FAILURE;
+  }
+
+  // Print out help or version and return
+  if (vm.count("help")) {
+    std::cout << options << "\n";
+    return EXIT_SUCCESS;
+  }
+  if (vm.count("version")) {
+    std::cout << "valhalla_build_extract " << VALHALLA_VERSION << "\n";
+    return EXIT_SUCCESS;
+  }
+
+  // Read the config file
+  boost::property_tree::ptree pt;
+  if (vm.count("inline-config")) {
+    std::stringstream ss;
+    ss << inline_config;
+    rapidjson::read_json(ss, pt);
+  } else if (vm.count("config") && filesystem::is_regular_file(config_file_path)) {
+    rapidjson::read_json(config_file_path, pt);
+  } else if (tile_dir.empty() || tile_extract.empty()) {
+    std::cerr << "Configuration is required\n\n" << options << "\n\n";
+    return EXIT_FAILURE;
+  }
+
+  // configure logging
+  boost::optional<boost::property_tree::ptree&> logging_subtree =
+      pt.get_child_optional("mjolnir.logging");
+  if (logging_subtree) {
+    auto logging_config =
+        valhalla::midgard::ToMap<const boost::property_tree::ptree&,
+                                 std::unordered_map<std::string, std::string>>(logging_subtree.get());
+    valhalla::midgard::logging::Configure(logging_config);
+  }
+
+  // Command line paths win over the config
+  if (tile_dir.empty()) {
+    tile_dir = pt.get<std::string>("mjolnir.tile_dir", "");
+  }
+  if (tile_extract.empty()) {
+    tile_extract = pt.get<std::string>("mjolnir.tile_extract", "");
+  }
+  if (tile_dir.empty() || tile_extract.empty()) {
+    std::cerr << "Both a tile directory and a tile extract are required\n\n" << options << "\n\n";
+    return EXIT_FAILURE;
+  }
+
+  try {
+    if (build_tile_extract(tile_dir, tile_extract) == 0) {
+      LOG_WARN("No tiles found in " + tile_dir);
+    }
+  } catch (const std::exception& e) {
+    LOG_ERROR(e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
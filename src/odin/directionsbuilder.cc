@@ -406,8 +406,8 @@ void DirectionsBuilder::PopulateDirectionsLeg(const Options& options,
   mutable_bbox->mutable_max_ll()->set_lat(etp->bbox().max_ll().lat());
   mutable_bbox->mutable_max_ll()->set_lng(etp->bbox().max_ll().lng());
 
-  // Populate shape
-  trip_directions.set_shape(etp->shape());
+  // Populate shape, the deltas are copied as is and only encoded by the serializer
+  *trip_directions.mutable_shape() = etp->shape();
 
   // Populate has_time_restrictions
   bool has_time_restrictions = false;
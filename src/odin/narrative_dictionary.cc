@@ -1,4 +1,5 @@
 #include <stdexcept>
+#include <string>
 
 #include <boost/property_tree/ptree.hpp>
 
@@ -30,11 +31,101 @@ std::unordered_map<K, V> as_unordered_map(boost::property_tree::ptree const& pt,
   return items;
 }
 
+// The phrase tags that are compiled into tag segments
+const std::unordered_map<std::string, valhalla::odin::PhraseTag> kPhraseTags =
+    {{kCardinalDirectionTag, valhalla::odin::PhraseTag::kCardinalDirection},
+     {kRelativeDirectionTag, valhalla::odin::PhraseTag::kRelativeDirection},
+     {kOrdinalValueTag, valhalla::odin::PhraseTag::kOrdinalValue},
+     {kStreetNamesTag, valhalla::odin::PhraseTag::kStreetNames},
+     {kPreviousStreetNamesTag, valhalla::odin::PhraseTag::kPreviousStreetNames},
+     {kBeginStreetNamesTag, valhalla::odin::PhraseTag::kBeginStreetNames},
+     {kCrossStreetNamesTag, valhalla::odin::PhraseTag::kCrossStreetNames},
+     {kLengthTag, valhalla::odin::PhraseTag::kLength},
+     {kDestinationTag, valhalla::odin::PhraseTag::kDestination},
+     {kCurrentVerbalCueTag, valhalla::odin::PhraseTag::kCurrentVerbalCue},
+     {kNextVerbalCueTag, valhalla::odin::PhraseTag::kNextVerbalCue},
+     {kNumberSignTag, valhalla::odin::PhraseTag::kNumberSign},
+     {kBranchSignTag, valhalla::odin::PhraseTag::kBranchSign},
+     {kTowardSignTag, valhalla::odin::PhraseTag::kTowardSign},
+     {kNameSignTag, valhalla::odin::PhraseTag::kNameSign},
+     {kFerryLabelTag, valhalla::odin::PhraseTag::kFerryLabel},
+     {kTransitPlatformTag, valhalla::odin::PhraseTag::kTransitPlatform},
+     {kStationLabelTag, valhalla::odin::PhraseTag::kStationLabel},
+     {kTimeTag, valhalla::odin::PhraseTag::kTime},
+     {kTransitNameTag, valhalla::odin::PhraseTag::kTransitName},
+     {kTransitHeadSignTag, valhalla::odin::PhraseTag::kTransitHeadSign},
+     {kTransitPlatformCountTag, valhalla::odin::PhraseTag::kTransitPlatformCount},
+     {kTransitPlatformCountLabelTag, valhalla::odin::PhraseTag::kTransitPlatformCountLabel}};
+
 } // namespace
 
 namespace valhalla {
 namespace odin {
 
+PhraseTemplate::PhraseTemplate() : defined_(false) {
+}
+
+PhraseTemplate::PhraseTemplate(const std::string& phrase) : text_(phrase), defined_(true) {
+  size_t literal_begin = 0;
+  size_t tag_begin = text_.find('<');
+  while (tag_begin != std::string::npos) {
+    size_t tag_end = text_.find('>', tag_begin);
+    if (tag_end == std::string::npos) {
+      break;
+    }
+
+    // Only known tags become tag segments, anything else remains literal text
+    auto found = kPhraseTags.find(text_.substr(tag_begin, tag_end - tag_begin + 1));
+    if (found != kPhraseTags.end()) {
+      if (tag_begin > literal_begin) {
+        segments_.push_back({static_cast<uint32_t>(literal_begin),
+                             static_cast<uint32_t>(tag_begin - literal_begin), PhraseTag::kNone});
+      }
+      segments_.push_back({static_cast<uint32_t>(tag_begin),
+                           static_cast<uint32_t>(tag_end - tag_begin + 1), found->second});
+      literal_begin = tag_end + 1;
+      tag_begin = text_.find('<', literal_begin);
+    } else {
+      tag_begin = text_.find('<', tag_begin + 1);
+    }
+  }
+
+  // Add the trailing literal text
+  if (literal_begin < text_.size()) {
+    segments_.push_back({static_cast<uint32_t>(literal_begin),
+                         static_cast<uint32_t>(text_.size() - literal_begin), PhraseTag::kNone});
+  }
+}
+
+void PhraseTemplate::Render(std::string& output,
+                            std::initializer_list<PhraseTagValue> values) const {
+  output.clear();
+  for (const auto& segment : segments_) {
+    const std::string* value = nullptr;
+    if (segment.tag != PhraseTag::kNone) {
+      for (const auto& tag_value : values) {
+        if (tag_value.tag == segment.tag) {
+          value = &tag_value.value;
+          break;
+        }
+      }
+    }
+
+    if (value) {
+      output.append(*value);
+    } else {
+      output.append(text_, segment.offset, segment.length);
+    }
+  }
+}
+
+const PhraseTemplate& PhraseSet::GetTemplate(size_t phrase_id) const {
+  if (phrase_id >= templates.size() || !templates[phrase_id].defined()) {
+    throw std::out_of_range("Phrase id not found: " + std::to_string(phrase_id));
+  }
+  return templates[phrase_id];
+}
+
 NarrativeDictionary::NarrativeDictionary(const std::string& language_tag,
                                          const boost::property_tree::ptree& narrative_pt) {
   this->language_tag = language_tag;
@@ -331,6 +422,16 @@ void NarrativeDictionary::Load(PhraseSet& phrase_handle,
                                const boost::property_tree::ptree& phrase_pt) {
 
   phrase_handle.phrases = as_unordered_map<std::string, std::string>(phrase_pt, kPhrasesKey);
+
+  // Compile the phrases so that instructions are rendered without any phrase lookups or scans
+  phrase_handle.templates.clear();
+  for (const auto& phrase : phrase_handle.phrases) {
+    size_t phrase_id = std::stoul(phrase.first);
+    if (phrase_id >= phrase_handle.templates.size()) {
+      phrase_handle.templates.resize(phrase_id + 1);
+    }
+    phrase_handle.templates[phrase_id] = PhraseTemplate(phrase.second);
+  }
 }
 
 void NarrativeDictionary::Load(StartSubset& start_handle,
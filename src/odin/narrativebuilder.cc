@@ -501,13 +501,11 @@ std::string NarrativeBuilder::FormStartInstruction(Maneuver& maneuver) {
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.start_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.start_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -559,16 +557,17 @@ std::string NarrativeBuilder::FormVerbalStartInstruction(Maneuver& maneuver,
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.start_verbal_subset.phrases.at(std::to_string(phrase_id));
+  // Set length value
+  std::string length =
+      FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
+                 dictionary_.start_verbal_subset.us_customary_lengths);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.start_verbal_subset.metric_lengths,
-                                dictionary_.start_verbal_subset.us_customary_lengths));
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.start_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kBeginStreetNames, begin_street_names},
+                            {PhraseTag::kLength, length}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -612,14 +611,10 @@ std::string NarrativeBuilder::FormDestinationInstruction(Maneuver& maneuver) {
     relative_direction = dictionary_.destination_subset.relative_directions.at(1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_subset.phrases.at(std::to_string(phrase_id));
-
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.destination_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -668,14 +663,10 @@ std::string NarrativeBuilder::FormVerbalAlertDestinationInstruction(Maneuver& ma
     relative_direction = dictionary_.destination_subset.relative_directions.at(1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_verbal_alert_subset.phrases.at(std::to_string(phrase_id));
-
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.destination_verbal_alert_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -724,14 +715,10 @@ std::string NarrativeBuilder::FormVerbalDestinationInstruction(Maneuver& maneuve
     relative_direction = dictionary_.destination_subset.relative_directions.at(1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.destination_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  if (phrase_id > 0) {
-    // Replace phrase tags with values
-    boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-    boost::replace_all(instruction, kDestinationTag, destination);
-  }
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.destination_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kDestination, destination}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -754,12 +741,10 @@ std::string NarrativeBuilder::FormBecomesInstruction(Maneuver& maneuver, Maneuve
   // Determine which phrase to use
   uint8_t phrase_id = 0;
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.becomes_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kPreviousStreetNamesTag, prev_street_names);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.becomes_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kPreviousStreetNames, prev_street_names},
+                            {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -789,12 +774,10 @@ std::string NarrativeBuilder::FormVerbalBecomesInstruction(Maneuver& maneuver,
   // Determine which phrase to use
   uint8_t phrase_id = 0;
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.becomes_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kPreviousStreetNamesTag, prev_street_names);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.becomes_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kPreviousStreetNames, prev_street_names},
+                            {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -822,11 +805,9 @@ std::string NarrativeBuilder::FormContinueInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.continue_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -857,11 +838,9 @@ std::string NarrativeBuilder::FormVerbalAlertContinueInstruction(Maneuver& maneu
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_verbal_alert_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.continue_verbal_alert_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -893,14 +872,15 @@ std::string NarrativeBuilder::FormVerbalContinueInstruction(Maneuver& maneuver,
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.continue_verbal_subset.phrases.at(std::to_string(phrase_id));
+  // Set length value
+  std::string length =
+      FormLength(maneuver, dictionary_.continue_verbal_subset.metric_lengths,
+                 dictionary_.continue_verbal_subset.us_customary_lengths);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.continue_verbal_subset.metric_lengths,
-                                dictionary_.continue_verbal_subset.us_customary_lengths));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.continue_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kLength, length},
+                            {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -956,14 +936,15 @@ std::string NarrativeBuilder::FormTurnInstruction(Maneuver& maneuver) {
     phrase_id = 3;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = subset->phrases.at(std::to_string(phrase_id));
+  // Set relative_direction value
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), subset->relative_directions);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(), subset->relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  subset->GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1035,14 +1016,15 @@ std::string NarrativeBuilder::FormVerbalTurnInstruction(Maneuver& maneuver,
     phrase_id = 3;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = subset->phrases.at(std::to_string(phrase_id));
+  // Set relative_direction value
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), subset->relative_directions);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(), subset->relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  subset->GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1083,15 +1065,15 @@ std::string NarrativeBuilder::FormUturnInstruction(Maneuver& maneuver) {
     phrase_id += 3;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.uturn_subset.phrases.at(std::to_string(phrase_id));
+  // Set relative_direction value
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), dictionary_.uturn_subset.relative_directions);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.uturn_subset.relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kCrossStreetNamesTag, cross_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.uturn_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kCrossStreetNames, cross_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1192,13 +1174,11 @@ std::string NarrativeBuilder::FormVerbalUturnInstruction(uint8_t phrase_id,
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.uturn_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kCrossStreetNamesTag, cross_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.uturn_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kCrossStreetNames, cross_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1244,13 +1224,11 @@ std::string NarrativeBuilder::FormRampStraightInstruction(Maneuver& maneuver,
         maneuver.signs().GetExitNameString(element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_straight_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.ramp_straight_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kBranchSign, exit_branch_sign},
+                            {PhraseTag::kTowardSign, exit_toward_sign},
+                            {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1347,13 +1325,11 @@ std::string NarrativeBuilder::FormVerbalRampStraightInstruction(uint8_t phrase_i
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_straight_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.ramp_straight_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kBranchSign, exit_branch_sign},
+                            {PhraseTag::kTowardSign, exit_toward_sign},
+                            {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1421,16 +1397,16 @@ std::string NarrativeBuilder::FormRampInstruction(Maneuver& maneuver,
         maneuver.signs().GetExitNameString(element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_subset.phrases.at(std::to_string(phrase_id));
+  // Set relative_direction value
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), dictionary_.ramp_subset.relative_directions);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.ramp_subset.relative_directions));
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.ramp_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kBranchSign, exit_branch_sign},
+                            {PhraseTag::kTowardSign, exit_toward_sign},
+                            {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1579,14 +1555,12 @@ std::string NarrativeBuilder::FormVerbalRampInstruction(uint8_t phrase_id,
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.ramp_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.ramp_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                            {PhraseTag::kBranchSign, exit_branch_sign},
+                            {PhraseTag::kTowardSign, exit_toward_sign},
+                            {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1664,17 +1638,17 @@ std::string NarrativeBuilder::FormExitInstruction(Maneuver& maneuver,
         maneuver.signs().GetExitNameString(element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_subset.phrases.at(std::to_string(phrase_id));
+  // Set relative_direction value
+  std::string relative_direction =
+      FormRelativeTwoDirection(maneuver.type(), dictionary_.exit_subset.relative_directions);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeTwoDirection(maneuver.type(),
-                                              dictionary_.exit_subset.relative_directions));
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.exit_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kNumberSign, exit_number_sign},
+                            {PhraseTag::kBranchSign, exit_branch_sign},
+                            {PhraseTag::kTowardSign, exit_toward_sign},
+                            {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1831,15 +1805,13 @@ std::string NarrativeBuilder::FormVerbalExitInstruction(uint8_t phrase_id,
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kBranchSignTag, exit_branch_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
-  boost::replace_all(instruction, kNameSignTag, exit_name_sign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.exit_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                            {PhraseTag::kNumberSign, exit_number_sign},
+                            {PhraseTag::kBranchSign, exit_branch_sign},
+                            {PhraseTag::kTowardSign, exit_toward_sign},
+                            {PhraseTag::kNameSign, exit_name_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -1904,16 +1876,16 @@ std::string NarrativeBuilder::FormKeepInstruction(Maneuver& maneuver,
         maneuver.signs().GetExitTowardString(element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_subset.phrases.at(std::to_string(phrase_id));
+  // Set relative_direction value
+  std::string relative_direction =
+      FormRelativeThreeDirection(maneuver.type(), dictionary_.keep_subset.relative_directions);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeThreeDirection(maneuver.type(),
-                                                dictionary_.keep_subset.relative_directions));
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.keep_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kNumberSign, exit_number_sign},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kTowardSign, exit_toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2037,14 +2009,12 @@ std::string NarrativeBuilder::FormVerbalKeepInstruction(uint8_t phrase_id,
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.keep_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                            {PhraseTag::kNumberSign, exit_number_sign},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kTowardSign, exit_toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2089,16 +2059,17 @@ std::string NarrativeBuilder::FormKeepToStayOnInstruction(Maneuver& maneuver,
         maneuver.signs().GetExitTowardString(element_max_count, limit_by_consecutive_count);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_to_stay_on_subset.phrases.at(std::to_string(phrase_id));
+  // Set relative_direction value
+  std::string relative_direction =
+      FormRelativeThreeDirection(maneuver.type(),
+                                 dictionary_.keep_to_stay_on_subset.relative_directions);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag,
-                     FormRelativeThreeDirection(maneuver.type(), dictionary_.keep_to_stay_on_subset
-                                                                     .relative_directions));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.keep_to_stay_on_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kNumberSign, exit_number_sign},
+                            {PhraseTag::kTowardSign, exit_toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2179,14 +2150,12 @@ std::string NarrativeBuilder::FormVerbalKeepToStayOnInstruction(uint8_t phrase_i
   std::string instruction;
   instruction.reserve(kInstructionInitialCapacity);
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.keep_to_stay_on_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_dir);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kNumberSignTag, exit_number_sign);
-  boost::replace_all(instruction, kTowardSignTag, exit_toward_sign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.keep_to_stay_on_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_dir},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kNumberSign, exit_number_sign},
+                            {PhraseTag::kTowardSign, exit_toward_sign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2225,12 +2194,10 @@ std::string NarrativeBuilder::FormMergeInstruction(Maneuver& maneuver) {
     phrase_id += 2;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.merge_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.merge_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2284,12 +2251,10 @@ std::string NarrativeBuilder::FormVerbalMergeInstruction(Maneuver& maneuver,
     phrase_id += 2;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.merge_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kRelativeDirectionTag, relative_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.merge_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kRelativeDirection, relative_direction},
+                            {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2317,11 +2282,9 @@ std::string NarrativeBuilder::FormEnterRoundaboutInstruction(Maneuver& maneuver)
         dictionary_.enter_roundabout_subset.ordinal_values.at(maneuver.roundabout_exit_count() - 1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.enter_roundabout_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kOrdinalValue, ordinal_value}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2351,11 +2314,9 @@ std::string NarrativeBuilder::FormVerbalAlertEnterRoundaboutInstruction(Maneuver
         maneuver.roundabout_exit_count() - 1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.enter_roundabout_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kOrdinalValue, ordinal_value}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2385,11 +2346,9 @@ std::string NarrativeBuilder::FormVerbalEnterRoundaboutInstruction(Maneuver& man
         maneuver.roundabout_exit_count() - 1);
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kOrdinalValueTag, ordinal_value);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.enter_roundabout_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kOrdinalValue, ordinal_value}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2425,12 +2384,10 @@ std::string NarrativeBuilder::FormExitRoundaboutInstruction(Maneuver& maneuver)
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_roundabout_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.exit_roundabout_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2470,12 +2427,10 @@ std::string NarrativeBuilder::FormVerbalExitRoundaboutInstruction(Maneuver& mane
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_roundabout_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.exit_roundabout_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2509,12 +2464,10 @@ std::string NarrativeBuilder::FormEnterFerryInstruction(Maneuver& maneuver) {
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_ferry_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kFerryLabelTag, ferry_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.enter_ferry_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kFerryLabel, ferry_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2561,12 +2514,10 @@ std::string NarrativeBuilder::FormVerbalEnterFerryInstruction(Maneuver& maneuver
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.enter_ferry_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kFerryLabelTag, ferry_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.enter_ferry_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kFerryLabel, ferry_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2622,13 +2573,11 @@ std::string NarrativeBuilder::FormExitFerryInstruction(Maneuver& maneuver) {
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_ferry_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.exit_ferry_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2707,13 +2656,11 @@ std::string NarrativeBuilder::FormVerbalExitFerryInstruction(Maneuver& maneuver,
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.exit_ferry_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.exit_ferry_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2746,12 +2693,10 @@ std::string NarrativeBuilder::FormTransitConnectionStartInstruction(Maneuver& ma
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_start_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_connection_start_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                            {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2784,13 +2729,10 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionStartInstruction(Maneuv
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_start_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_connection_start_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                            {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2823,12 +2765,10 @@ std::string NarrativeBuilder::FormTransitConnectionTransferInstruction(Maneuver&
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_connection_transfer_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_connection_transfer_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                            {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2861,13 +2801,10 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionTransferInstruction(Man
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_transfer_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_connection_transfer_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                            {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2900,13 +2837,10 @@ std::string NarrativeBuilder::FormTransitConnectionDestinationInstruction(Maneuv
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_destination_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_connection_destination_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                            {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2939,13 +2873,10 @@ std::string NarrativeBuilder::FormVerbalTransitConnectionDestinationInstruction(
     }
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.transit_connection_destination_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop);
-  boost::replace_all(instruction, kStationLabelTag, station_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_connection_destination_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop},
+                            {PhraseTag::kStationLabel, station_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2968,13 +2899,13 @@ std::string NarrativeBuilder::FormDepartInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.depart_subset.phrases.at(std::to_string(phrase_id));
+  // Set time value
+  std::string time = get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale());
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.depart_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                            {PhraseTag::kTime, time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -2997,13 +2928,13 @@ std::string NarrativeBuilder::FormVerbalDepartInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.depart_verbal_subset.phrases.at(std::to_string(phrase_id));
+  // Set time value
+  std::string time = get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale());
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitDepartureTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.depart_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                            {PhraseTag::kTime, time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3026,13 +2957,13 @@ std::string NarrativeBuilder::FormArriveInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.arrive_subset.phrases.at(std::to_string(phrase_id));
+  // Set time value
+  std::string time = get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale());
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.arrive_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                            {PhraseTag::kTime, time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3055,13 +2986,13 @@ std::string NarrativeBuilder::FormVerbalArriveInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.arrive_verbal_subset.phrases.at(std::to_string(phrase_id));
+  // Set time value
+  std::string time = get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale());
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformTag, transit_stop_name);
-  boost::replace_all(instruction, kTimeTag,
-                     get_localized_time(maneuver.GetTransitArrivalTime(), dictionary_.GetLocale()));
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.arrive_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatform, transit_stop_name},
+                            {PhraseTag::kTime, time}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3088,16 +3019,17 @@ std::string NarrativeBuilder::FormTransitInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_subset.phrases.at(std::to_string(phrase_id));
+  // Set transit_name value
+  std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_subset.empty_transit_name_labels);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver, dictionary_.transit_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                            {PhraseTag::kTransitHeadSign, transit_headsign},
+                            // TODO: locale specific numerals
+                            {PhraseTag::kTransitPlatformCount, std::to_string(stop_count)},
+                            {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3120,14 +3052,14 @@ std::string NarrativeBuilder::FormVerbalTransitInstruction(Maneuver& maneuver) {
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_verbal_subset.phrases.at(std::to_string(phrase_id));
+  // Set transit_name value
+  std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_verbal_subset.empty_transit_name_labels);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver,
-                                     dictionary_.transit_verbal_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                            {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3155,17 +3087,17 @@ std::string NarrativeBuilder::FormTransitRemainOnInstruction(Maneuver& maneuver)
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_remain_on_subset.phrases.at(std::to_string(phrase_id));
+  // Set transit_name value
+  std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_remain_on_subset.empty_transit_name_labels);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver,
-                                     dictionary_.transit_remain_on_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_remain_on_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                            {PhraseTag::kTransitHeadSign, transit_headsign},
+                            // TODO: locale specific numerals
+                            {PhraseTag::kTransitPlatformCount, std::to_string(stop_count)},
+                            {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3188,14 +3120,15 @@ std::string NarrativeBuilder::FormVerbalTransitRemainOnInstruction(Maneuver& man
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_remain_on_verbal_subset.phrases.at(std::to_string(phrase_id));
+  // Set transit_name value
+  std::string transit_name =
+      FormTransitName(maneuver,
+                      dictionary_.transit_remain_on_verbal_subset.empty_transit_name_labels);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver, dictionary_.transit_remain_on_verbal_subset
-                                                   .empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_remain_on_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                            {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3223,17 +3156,17 @@ std::string NarrativeBuilder::FormTransitTransferInstruction(Maneuver& maneuver)
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_transfer_subset.phrases.at(std::to_string(phrase_id));
+  // Set transit_name value
+  std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_transfer_subset.empty_transit_name_labels);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver,
-                                     dictionary_.transit_transfer_subset.empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_transfer_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                            {PhraseTag::kTransitHeadSign, transit_headsign},
+                            // TODO: locale specific numerals
+                            {PhraseTag::kTransitPlatformCount, std::to_string(stop_count)},
+                            {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3256,14 +3189,14 @@ std::string NarrativeBuilder::FormVerbalTransitTransferInstruction(Maneuver& man
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.transit_transfer_verbal_subset.phrases.at(std::to_string(phrase_id));
+  // Set transit_name value
+  std::string transit_name =
+      FormTransitName(maneuver, dictionary_.transit_transfer_verbal_subset.empty_transit_name_labels);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitNameTag,
-                     FormTransitName(maneuver, dictionary_.transit_transfer_verbal_subset
-                                                   .empty_transit_name_labels));
-  boost::replace_all(instruction, kTransitHeadSignTag, transit_headsign);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.transit_transfer_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitName, transit_name},
+                            {PhraseTag::kTransitHeadSign, transit_headsign}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3322,14 +3255,11 @@ std::string NarrativeBuilder::FormPostTransitConnectionDestinationInstruction(Ma
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.post_transit_connection_destination_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.post_transit_connection_destination_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3393,14 +3323,11 @@ NarrativeBuilder::FormVerbalPostTransitConnectionDestinationInstruction(Maneuver
     phrase_id += 16;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.post_transit_connection_destination_verbal_subset.phrases.at(
-      std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCardinalDirectionTag, cardinal_direction);
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
-  boost::replace_all(instruction, kBeginStreetNamesTag, begin_street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.post_transit_connection_destination_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kCardinalDirection, cardinal_direction},
+                            {PhraseTag::kStreetNames, street_names},
+                            {PhraseTag::kBeginStreetNames, begin_street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3432,14 +3359,15 @@ std::string NarrativeBuilder::FormVerbalPostTransitionInstruction(Maneuver& mane
     phrase_id = 1;
   }
 
-  // Set instruction to the determined tagged phrase
-  instruction = dictionary_.post_transition_verbal_subset.phrases.at(std::to_string(phrase_id));
+  // Set length value
+  std::string length =
+      FormLength(maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
+                 dictionary_.post_transition_verbal_subset.us_customary_lengths);
 
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kLengthTag,
-                     FormLength(maneuver, dictionary_.post_transition_verbal_subset.metric_lengths,
-                                dictionary_.post_transition_verbal_subset.us_customary_lengths));
-  boost::replace_all(instruction, kStreetNamesTag, street_names);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  dictionary_.post_transition_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kLength, length},
+                            {PhraseTag::kStreetNames, street_names}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3460,14 +3388,11 @@ std::string NarrativeBuilder::FormVerbalPostTransitionTransitInstruction(Maneuve
       FormTransitPlatformCountLabel(stop_count, dictionary_.post_transition_transit_verbal_subset
                                                     .transit_stop_count_labels);
 
-  // Set instruction to the determined tagged phrase
-  instruction =
-      dictionary_.post_transition_transit_verbal_subset.phrases.at(std::to_string(phrase_id));
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kTransitPlatformCountTag,
-                     std::to_string(stop_count)); // TODO: locale specific numerals
-  boost::replace_all(instruction, kTransitPlatformCountLabelTag, stop_count_label);
+  // Set instruction to the determined tagged phrase and replace phrase tags with values
+  // TODO: locale specific numerals
+  dictionary_.post_transition_transit_verbal_subset.GetTemplate(phrase_id)
+      .Render(instruction, {{PhraseTag::kTransitPlatformCount, std::to_string(stop_count)},
+                            {PhraseTag::kTransitPlatformCountLabel, stop_count_label}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
@@ -3781,12 +3706,10 @@ std::string NarrativeBuilder::FormVerbalMultiCue(Maneuver* maneuver, Maneuver& n
                                     ? next_maneuver.verbal_transition_alert_instruction()
                                     : next_maneuver.verbal_pre_transition_instruction();
 
-  // Set instruction to the verbal multi-cue
-  instruction = dictionary_.verbal_multi_cue_subset.phrases.at("0");
-
-  // Replace phrase tags with values
-  boost::replace_all(instruction, kCurrentVerbalCueTag, current_verbal_cue);
-  boost::replace_all(instruction, kNextVerbalCueTag, next_verbal_cue);
+  // Set instruction to the verbal multi-cue and replace phrase tags with values
+  dictionary_.verbal_multi_cue_subset.GetTemplate(0)
+      .Render(instruction, {{PhraseTag::kCurrentVerbalCue, current_verbal_cue},
+                            {PhraseTag::kNextVerbalCue, next_verbal_cue}});
 
   // If enabled, form articulated prepositions
   if (articulated_preposition_enabled_) {
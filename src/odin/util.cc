@@ -5,7 +5,9 @@
 #include <boost/algorithm/string/replace.hpp>
 
 #include <chrono>
+#include <mutex>
 #include <sstream>
+#include <tuple>
 
 #include <date/date.h>
 #include <date/tz.h>
@@ -16,37 +18,60 @@
 
 namespace {
 
-valhalla::odin::locales_singleton_t load_narrative_locals() {
-  valhalla::odin::locales_singleton_t locales;
-  // for each locale
-  for (const auto& json : locales_json) {
-    LOG_TRACE("LOCALES");
-    LOG_TRACE("-------");
-    LOG_TRACE("- " + json.first);
-    // load the json
-    boost::property_tree::ptree narrative_pt;
-    std::stringstream ss;
-    ss << json.second;
-    rapidjson::read_json(ss, narrative_pt);
-    LOG_TRACE("JSON read");
-    // parse it into an object and add it to the map
-    auto narrative_dictionary =
-        std::make_shared<valhalla::odin::NarrativeDictionary>(json.first, narrative_pt);
-    LOG_TRACE("NarrativeDictionary created");
-    locales.insert(std::make_pair(json.first, narrative_dictionary));
-    // insert all the aliases as this same object
-    auto aliases = narrative_pt.get_child("aliases");
-    for (const auto& alias : aliases) {
-      auto name = alias.second.get_value<std::string>();
-      auto inserted = locales.insert(std::make_pair(name, narrative_dictionary));
+// Parses the embedded json of a locale into its narrative dictionary
+std::shared_ptr<valhalla::odin::NarrativeDictionary>
+load_narrative_locale(const std::string& locale_tag,
+                      const std::pair<const unsigned char*, size_t>& json) {
+  LOG_TRACE("LOCALES");
+  LOG_TRACE("-------");
+  LOG_TRACE("- " + locale_tag);
+  // load the json
+  boost::property_tree::ptree narrative_pt;
+  std::stringstream ss;
+  ss.write(reinterpret_cast<const char*>(json.first), json.second);
+  rapidjson::read_json(ss, narrative_pt);
+  LOG_TRACE("JSON read");
+  // parse it into an object
+  auto narrative_dictionary =
+      std::make_shared<valhalla::odin::NarrativeDictionary>(locale_tag, narrative_pt);
+  LOG_TRACE("NarrativeDictionary created");
+  return narrative_dictionary;
+}
+
+// A locale whose narrative dictionary is parsed the first time it is asked for
+struct lazy_locale_t {
+  std::once_flag loaded;
+  std::shared_ptr<valhalla::odin::NarrativeDictionary> dictionary;
+};
+
+// Every language tag, the locales and their aliases, resolved to the locale that serves it
+struct locale_index_t {
+  std::unordered_map<std::string, lazy_locale_t> locales;
+  std::unordered_map<std::string, std::pair<const std::string, lazy_locale_t>*> tags;
+
+  locale_index_t() {
+    for (const auto& json : locales_json) {
+      auto& locale = *locales.emplace(std::piecewise_construct, std::forward_as_tuple(json.first),
+                                      std::forward_as_tuple())
+                          .first;
+      tags.emplace(json.first, &locale);
+    }
+    // insert all the aliases as the same locale
+    for (const auto& alias : locales_aliases) {
+      auto inserted = tags.emplace(alias.first, &*locales.find(alias.second));
       if (!inserted.second) {
-        throw std::logic_error("Alias '" + name + "' in json locale '" + json.first +
-                               "' has duplicate with posix_locale '" +
-                               inserted.first->second->GetLocale().name());
+        throw std::logic_error("Alias '" + alias.first + "' in json locale '" + alias.second +
+                               "' has duplicate with locale '" + inserted.first->second->first +
+                               "'");
       }
     }
   }
-  return locales;
+};
+
+locale_index_t& get_locale_index() {
+  // thread safe static initializer, only the index is built here not the dictionaries
+  static locale_index_t index;
+  return index;
 }
 
 } // namespace
@@ -124,14 +149,51 @@ std::string get_localized_date(const std::string& date_time, const std::locale&
   return date::format(locale, "%x", local_tp);
 }
 
+bool is_supported_locale(const std::string& language_tag) {
+  const auto& tags = get_locale_index().tags;
+  return tags.find(language_tag) != tags.cend();
+}
+
+std::shared_ptr<const NarrativeDictionary> get_locale(const std::string& language_tag) {
+  const auto& tags = get_locale_index().tags;
+  auto tag = tags.find(language_tag);
+  if (tag == tags.cend()) {
+    return nullptr;
+  }
+
+  // parse the locale the first time any of its tags is used, concurrent callers wait for it
+  auto& locale = *tag->second;
+  std::call_once(locale.second.loaded, [&locale]() {
+    locale.second.dictionary =
+        load_narrative_locale(locale.first, locales_json.find(locale.first)->second);
+  });
+  return locale.second.dictionary;
+}
+
 const locales_singleton_t& get_locales() {
-  // thread safe static initializer for singleton
-  static locales_singleton_t locales(load_narrative_locals());
+  // thread safe static initializer for singleton, this parses every locale
+  static locales_singleton_t locales([]() {
+    locales_singleton_t locales;
+    for (const auto& tag : get_locale_index().tags) {
+      get_locale(tag.first);
+      locales.emplace(tag.first, tag.second->second.dictionary);
+    }
+    return locales;
+  }());
   return locales;
 }
 
 const std::unordered_map<std::string, std::string>& get_locales_json() {
-  return locales_json;
+  // copied out of the embedded json only when asked for
+  static const std::unordered_map<std::string, std::string> jsons([]() {
+    std::unordered_map<std::string, std::string> jsons;
+    for (const auto& json : locales_json) {
+      jsons.emplace(json.first, std::string(reinterpret_cast<const char*>(json.second.first),
+                                            json.second.second));
+    }
+    return jsons;
+  }());
+  return jsons;
 }
 
 } // namespace odin
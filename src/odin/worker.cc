@@ -1,3 +1,4 @@
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <sstream>
@@ -10,6 +11,7 @@
 
 #include "baldr/json.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 
 #include "odin/directionsbuilder.h"
 #include "odin/util.h"
@@ -47,6 +49,8 @@ prime_server::worker_t::result_t
 odin_worker_t::work(const std::list<zmq::message_t>& job,
                     void* request_info,
                     const std::function<void()>& interrupt_function) {
+  // get time for start of request
+  auto s = std::chrono::system_clock::now();
   auto& info = *static_cast<prime_server::http_request_info_t*>(request_info);
   LOG_INFO("Got Odin Request " + std::to_string(info.id));
   Api request;
@@ -57,13 +61,27 @@ odin_worker_t::work(const std::list<zmq::message_t>& job,
     // crack open the in progress request
     request.ParseFromArray(job.front().data(), job.front().size());
 
+    // the last stage answers with the metrics of every stage
+    if (request.options().action() == Options::metrics) {
+      add_metrics(request);
+      return to_response_text(serialize_metrics(request), info, request);
+    }
+
     // narrate them and serialize them along
     narrate(request);
     auto response = tyr::serializeDirections(request);
-    auto* to_response =
-        request.options().format() == Options::gpx ? to_response_xml : to_response_json;
+    if (!request.options().do_not_track()) {
+      std::chrono::duration<float, std::milli> elapsed_time = std::chrono::system_clock::now() - s;
+      midgard::metrics::Observe("valhalla_stage_latency_ms", elapsed_time.count(),
+                                {{"stage", "odin"},
+                                 {"action", Options_Action_Enum_Name(request.options().action())}});
+    }
+    if (request.options().format() == Options::gpx) {
+      return to_response_xml(response, info, request);
+    }
     return to_response(response, info, request);
   } catch (const std::exception& e) {
+    midgard::metrics::Increment("valhalla_errors_total", {{"stage", "odin"}, {"code", "299"}});
     return jsonify_error({299, std::string(e.what())}, info, request);
   }
 }
@@ -9,7 +9,11 @@
 #include "midgard/util.h"
 #include "sif/dynamiccost.h"
 
+#include <typeinfo>
+
 #ifdef INLINE_TEST
+#include "baldr/graphtile.h"
+#include "sif/costdispatch.h"
 #include "test/test.h"
 #include "worker.h"
 #include <random>
@@ -42,16 +46,6 @@ constexpr float kDefaultUseFerry = 0.5f;    // Factor between 0 and 1
 constexpr float kDefaultUseHighways = 1.0f; // Factor between 0 and 1
 constexpr float kDefaultUseTolls = 0.5f;    // Factor between 0 and 1
 
-// Default turn costs
-constexpr float kTCStraight = 0.5f;
-constexpr float kTCSlight = 0.75f;
-constexpr float kTCFavorable = 1.0f;
-constexpr float kTCFavorableSharp = 1.5f;
-constexpr float kTCCrossing = 2.0f;
-constexpr float kTCUnfavorable = 2.5f;
-constexpr float kTCUnfavorableSharp = 3.5f;
-constexpr float kTCReverse = 5.0f;
-
 // How much to favor hov roads.
 constexpr float kHOVFactor = 0.85f;
 
@@ -61,14 +55,6 @@ constexpr float kTaxiFactor = 0.85f;
 // Do not avoid alleys by default
 constexpr float kDefaultAlleyFactor = 1.0f;
 
-// Turn costs based on side of street driving
-constexpr float kRightSideTurnCosts[] = {kTCStraight,       kTCSlight,  kTCFavorable,
-                                         kTCFavorableSharp, kTCReverse, kTCUnfavorableSharp,
-                                         kTCUnfavorable,    kTCSlight};
-constexpr float kLeftSideTurnCosts[] = {kTCStraight,         kTCSlight,  kTCUnfavorable,
-                                        kTCUnfavorableSharp, kTCReverse, kTCFavorableSharp,
-                                        kTCFavorable,        kTCSlight};
-
 constexpr float kMinFactor = 0.1f;
 constexpr float kMaxFactor = 100000.0f;
 
@@ -91,36 +77,29 @@ constexpr ranged_default_t<float> kUseFerryRange{0, kDefaultUseFerry, 1.0f};
 constexpr ranged_default_t<float> kUseHighwaysRange{0, kDefaultUseHighways, 1.0f};
 constexpr ranged_default_t<float> kUseTollsRange{0, kDefaultUseTolls, 1.0f};
 
-constexpr float kHighwayFactor[] = {
-    10.0f, // Motorway
-    0.5f,  // Trunk
-    0.0f,  // Primary
-    0.0f,  // Secondary
-    0.0f,  // Tertiary
-    0.0f,  // Unclassified
-    0.0f,  // Residential
-    0.0f   // Service, other
-};
-
-constexpr float kSurfaceFactor[] = {
-    0.0f, // kPavedSmooth
-    0.0f, // kPaved
-    0.0f, // kPaveRough
-    0.1f, // kCompacted
-    0.2f, // kDirt
-    0.5f, // kGravel
-    1.0f  // kPath
-};
-
 } // namespace
 
+// Definitions of the constants AutoCostBase uses in its inline costing methods
+constexpr float AutoCostBase::kTCStraight;
+constexpr float AutoCostBase::kTCSlight;
+constexpr float AutoCostBase::kTCFavorable;
+constexpr float AutoCostBase::kTCFavorableSharp;
+constexpr float AutoCostBase::kTCCrossing;
+constexpr float AutoCostBase::kTCUnfavorable;
+constexpr float AutoCostBase::kTCUnfavorableSharp;
+constexpr float AutoCostBase::kTCReverse;
+constexpr float AutoCostBase::kRightSideTurnCosts[];
+constexpr float AutoCostBase::kLeftSideTurnCosts[];
+constexpr float AutoCostBase::kHighwayFactor[];
+constexpr float AutoCostBase::kSurfaceFactor[];
+
 /**
  * Derived class providing dynamic edge costing for "direct" auto routes. This
  * is a route that is generally shortest time but uses route hierarchies that
  * can result in slightly longer routes that avoid shortcuts on residential
  * roads.
  */
-class AutoCost : public DynamicCost {
+class AutoCost : public AutoCostBase {
 public:
   /**
    * Construct auto costing. Pass in cost type and options using protocol buffer(pbf).
@@ -142,71 +121,29 @@ public:
   }
 
   /**
-   * Get the access mode used by this costing method.
-   * @return  Returns access mode.
+   * Can the reach computed when the tiles were built be used. The edge and node
+   * filters only look at auto access so the stored reach applies.
+   * @return  Returns true if the costing model can use the precomputed reach.
    */
-  uint32_t access_mode() const {
-    return kAutoAccess;
+  virtual bool AllowPrecomputedReach() const {
+    return true;
   }
 
   /**
-   * Checks if access is allowed for the provided directed edge.
-   * This is generally based on mode of travel and the access modes
-   * allowed on the edge. However, it can be extended to exclude access
-   * based on other parameters such as conditional restrictions and
-   * conditional access that can depend on time and travel mode.
-   * @param  edge           Pointer to a directed edge.
-   * @param  pred           Predecessor edge information.
-   * @param  tile           Current tile.
-   * @param  edgeid         GraphId of the directed edge.
-   * @param  current_time   Current time (seconds since epoch). A value of 0
-   *                        indicates the route is not time dependent.
-   * @param  tz_index       timezone index for the node
-   * @return Returns true if access is allowed, false if not.
-   */
-  virtual bool Allowed(const baldr::DirectedEdge* edge,
-                       const EdgeLabel& pred,
-                       const baldr::GraphTile*& tile,
-                       const baldr::GraphId& edgeid,
-                       const uint64_t current_time,
-                       const uint32_t tz_index,
-                       bool& has_time_restrictions) const;
-
-  /**
-   * Checks if access is allowed for an edge on the reverse path
-   * (from destination towards origin). Both opposing edges (current and
-   * predecessor) are provided. The access check is generally based on mode
-   * of travel and the access modes allowed on the edge. However, it can be
-   * extended to exclude access based on other parameters such as conditional
-   * restrictions and conditional access that can depend on time and travel
-   * mode.
-   * @param  edge           Pointer to a directed edge.
-   * @param  pred           Predecessor edge information.
-   * @param  opp_edge       Pointer to the opposing directed edge.
-   * @param  tile           Current tile.
-   * @param  edgeid         GraphId of the opposing edge.
-   * @param  current_time   Current time (seconds since epoch). A value of 0
-   *                        indicates the route is not time dependent.
-   * @param  tz_index       timezone index for the node
-   * @return  Returns true if access is allowed, false if not.
+   * Can the components computed when the tiles were built be used. Edges and
+   * nodes without auto access are never allowed.
+   * @return  Returns true if the costing model can use the precomputed components.
    */
-  virtual bool AllowedReverse(const baldr::DirectedEdge* edge,
-                              const EdgeLabel& pred,
-                              const baldr::DirectedEdge* opp_edge,
-                              const baldr::GraphTile*& tile,
-                              const baldr::GraphId& opp_edgeid,
-                              const uint64_t current_time,
-                              const uint32_t tz_index,
-                              bool& has_time_restrictions) const;
+  virtual bool AllowPrecomputedComponents() const {
+    return true;
+  }
 
   /**
-   * Checks if access is allowed for the provided node. Node access can
-   * be restricted if bollards or gates are present.
-   * @param  node  Pointer to node information.
-   * @return  Returns true if access is allowed, false if not.
+   * Get the access mode used by this costing method.
+   * @return  Returns access mode.
    */
-  virtual bool Allowed(const baldr::NodeInfo* node) const {
-    return (node->access() & kAutoAccess);
+  uint32_t access_mode() const {
+    return baldr::kAutoAccess;
   }
 
   /**
@@ -222,45 +159,6 @@ public:
     throw std::runtime_error("AutoCost::EdgeCost does not support transit edges");
   }
 
-  /**
-   * Get the cost to traverse the specified directed edge. Cost includes
-   * the time (seconds) to traverse the edge.
-   * @param   edge    Pointer to a directed edge.
-   * @param   tile    Graph tile.
-   * @param   seconds Time of week in seconds.
-   * @return  Returns the cost and time (seconds)
-   */
-  virtual Cost EdgeCost(const baldr::DirectedEdge* edge,
-                        const baldr::GraphTile* tile,
-                        const uint32_t seconds) const;
-
-  /**
-   * Returns the cost to make the transition from the predecessor edge.
-   * Defaults to 0. Costing models that wish to include edge transition
-   * costs (i.e., intersection/turn costs) must override this method.
-   * @param  edge  Directed edge (the to edge)
-   * @param  node  Node (intersection) where transition occurs.
-   * @param  pred  Predecessor edge information.
-   * @return  Returns the cost and time (seconds)
-   */
-  virtual Cost TransitionCost(const baldr::DirectedEdge* edge,
-                              const baldr::NodeInfo* node,
-                              const EdgeLabel& pred) const;
-
-  /**
-   * Returns the cost to make the transition from the predecessor edge
-   * when using a reverse search (from destination towards the origin).
-   * @param  idx   Directed edge local index
-   * @param  node  Node (intersection) where transition occurs.
-   * @param  pred  the opposing current edge in the reverse tree.
-   * @param  edge  the opposing predecessor in the reverse tree
-   * @return  Returns the cost and time (seconds)
-   */
-  virtual Cost TransitionCostReverse(const uint32_t idx,
-                                     const baldr::NodeInfo* node,
-                                     const baldr::DirectedEdge* pred,
-                                     const baldr::DirectedEdge* edge) const;
-
   /**
    * Get the cost factor for A* heuristics. This factor is multiplied
    * with the distance to the destination to produce an estimate of the
@@ -270,7 +168,7 @@ public:
    * estimate is less than the least possible time along roads.
    */
   virtual float AStarCostFactor() const {
-    return speedfactor_[kMaxSpeedKph];
+    return speedfactor_[baldr::kMaxSpeedKph];
   }
 
   /**
@@ -291,7 +189,7 @@ public:
   virtual const EdgeFilter GetEdgeFilter() const {
     // Throw back a lambda that checks the access for this type of costing
     return [](const baldr::DirectedEdge* edge) {
-      if (edge->is_shortcut() || !(edge->forwardaccess() & kAutoAccess)) {
+      if (edge->is_shortcut() || !(edge->forwardaccess() & baldr::kAutoAccess)) {
         return 0.0f;
       } else {
         // TODO - use classification/use to alter the factor
@@ -307,30 +205,19 @@ public:
    */
   virtual const NodeFilter GetNodeFilter() const {
     // throw back a lambda that checks the access for this type of costing
-    return [](const baldr::NodeInfo* node) { return !(node->access() & kAutoAccess); };
+    return [](const baldr::NodeInfo* node) { return !(node->access() & baldr::kAutoAccess); };
   }
 
-  // Hidden in source file so we don't need it to be protected
-  // We expose it within the source file for testing purposes
-public:
   VehicleType type_; // Vehicle type: car (default), motorcycle, etc
-  float speedfactor_[kMaxSpeedKph + 1];
-  float density_factor_[16]; // Density factor
-  float highway_factor_;     // Factor applied when road is a motorway or trunk
-  float alley_factor_;       // Avoid alleys factor.
-  float toll_factor_;        // Factor applied when road has a toll
-  float surface_factor_;     // How much the surface factors are applied.
-
-  // Density factor used in edge transition costing
-  std::vector<float> trans_density_factor_;
 };
 
+bool AutoCostBase::Is(const DynamicCost& costing) {
+  return typeid(costing) == typeid(AutoCost);
+}
+
 // Constructor
 AutoCost::AutoCost(const Costing costing, const Options& options)
-    : DynamicCost(options, TravelMode::kDrive), trans_density_factor_{1.0f, 1.0f, 1.0f, 1.0f,
-                                                                      1.0f, 1.1f, 1.2f, 1.3f,
-                                                                      1.4f, 1.6f, 1.9f, 2.2f,
-                                                                      2.5f, 2.8f, 3.1f, 3.5f} {
+    : AutoCostBase(options, TravelMode::kDrive) {
 
   // Grab the costing options based on the specified costing type
   const CostingOptions& costing_options = options.costing_options(static_cast<int>(costing));
@@ -383,161 +270,6 @@ AutoCost::AutoCost(const Costing costing, const Options& options)
   }
 }
 
-// Check if access is allowed on the specified edge.
-bool AutoCost::Allowed(const baldr::DirectedEdge* edge,
-                       const EdgeLabel& pred,
-                       const baldr::GraphTile*& tile,
-                       const baldr::GraphId& edgeid,
-                       const uint64_t current_time,
-                       const uint32_t tz_index,
-                       bool& has_time_restrictions) const {
-  // Check access, U-turn, and simple turn restriction.
-  // Allow U-turns at dead-end nodes in case the origin is inside
-  // a not thru region and a heading selected an edge entering the
-  // region.
-  if (!(edge->forwardaccess() & kAutoAccess) ||
-      (!pred.deadend() && pred.opp_local_idx() == edge->localedgeidx()) ||
-      (pred.restrictions() & (1 << edge->localedgeidx())) ||
-      edge->surface() == Surface::kImpassable || IsUserAvoidEdge(edgeid) ||
-      (!allow_destination_only_ && !pred.destonly() && edge->destonly())) {
-    return false;
-  }
-
-  return DynamicCost::EvaluateRestrictions(kAutoAccess, edge, tile, edgeid, current_time, tz_index,
-                                           has_time_restrictions);
-}
-
-// Checks if access is allowed for an edge on the reverse path (from
-// destination towards origin). Both opposing edges are provided.
-bool AutoCost::AllowedReverse(const baldr::DirectedEdge* edge,
-                              const EdgeLabel& pred,
-                              const baldr::DirectedEdge* opp_edge,
-                              const baldr::GraphTile*& tile,
-                              const baldr::GraphId& opp_edgeid,
-                              const uint64_t current_time,
-                              const uint32_t tz_index,
-                              bool& has_time_restrictions) const {
-  // Check access, U-turn, and simple turn restriction.
-  // Allow U-turns at dead-end nodes.
-  if (!(opp_edge->forwardaccess() & kAutoAccess) ||
-      (!pred.deadend() && pred.opp_local_idx() == edge->localedgeidx()) ||
-      (opp_edge->restrictions() & (1 << pred.opp_local_idx())) ||
-      opp_edge->surface() == Surface::kImpassable || IsUserAvoidEdge(opp_edgeid) ||
-      (!allow_destination_only_ && !pred.destonly() && opp_edge->destonly())) {
-    return false;
-  }
-
-  return DynamicCost::EvaluateRestrictions(kAutoAccess, edge, tile, opp_edgeid, current_time,
-                                           tz_index, has_time_restrictions);
-}
-
-// Get the cost to traverse the edge in seconds
-Cost AutoCost::EdgeCost(const baldr::DirectedEdge* edge,
-                        const baldr::GraphTile* tile,
-                        const uint32_t seconds) const {
-  auto speed = tile->GetSpeed(edge, flow_mask_, seconds);
-  float factor = (edge->use() == Use::kFerry) ? ferry_factor_ : density_factor_[edge->density()];
-
-  factor += highway_factor_ * kHighwayFactor[static_cast<uint32_t>(edge->classification())] +
-            surface_factor_ * kSurfaceFactor[static_cast<uint32_t>(edge->surface())];
-  if (edge->toll()) {
-    factor += toll_factor_;
-  }
-
-  if (edge->use() == Use::kAlley) {
-    factor *= alley_factor_;
-  }
-
-  float sec = (edge->length() * speedfactor_[speed]);
-  return Cost(sec * factor, sec);
-}
-
-// Returns the time (in seconds) to make the transition from the predecessor
-Cost AutoCost::TransitionCost(const baldr::DirectedEdge* edge,
-                              const baldr::NodeInfo* node,
-                              const EdgeLabel& pred) const {
-  // Get the transition cost for country crossing, ferry, gate, toll booth,
-  // destination only, alley, maneuver penalty
-  uint32_t idx = pred.opp_local_idx();
-  Cost c = base_transition_cost(node, edge, pred, idx);
-
-  // Intersection transition time = factor * stopimpact * turncost. Factor depends
-  // on density and whether traffic is available
-  if (edge->stopimpact(idx) > 0) {
-    float turn_cost;
-    if (edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
-      turn_cost = kTCCrossing;
-    } else {
-      turn_cost = (node->drive_on_right())
-                      ? kRightSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))]
-                      : kLeftSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))];
-    }
-
-    if ((edge->use() != Use::kRamp && pred.use() == Use::kRamp) ||
-        (edge->use() == Use::kRamp && pred.use() != Use::kRamp)) {
-      turn_cost += 1.5f;
-      if (edge->roundabout())
-        turn_cost += 0.5f;
-    }
-
-    // Separate time and penalty when traffic is present. With traffic, edge speeds account for
-    // much of the intersection transition time (TODO - evaluate different elapsed time settings).
-    // Still want to add a penalty so routes avoid high cost intersections.
-    float seconds = turn_cost * edge->stopimpact(idx);
-    // Apply density factor penality if there isnt traffic on this edge or youre not using traffic
-    if (!edge->has_flow_speed() || flow_mask_ == 0)
-      seconds *= trans_density_factor_[node->density()];
-
-    c.cost += seconds;
-    c.secs += seconds;
-  }
-  return c;
-}
-
-// Returns the cost to make the transition from the predecessor edge
-// when using a reverse search (from destination towards the origin).
-// pred is the opposing current edge in the reverse tree
-// edge is the opposing predecessor in the reverse tree
-Cost AutoCost::TransitionCostReverse(const uint32_t idx,
-                                     const baldr::NodeInfo* node,
-                                     const baldr::DirectedEdge* pred,
-                                     const baldr::DirectedEdge* edge) const {
-  // Get the transition cost for country crossing, ferry, gate, toll booth,
-  // destination only, alley, maneuver penalty
-  Cost c = base_transition_cost(node, edge, pred, idx);
-
-  // Transition time = densityfactor * stopimpact * turncost
-  if (edge->stopimpact(idx) > 0) {
-    float turn_cost;
-    if (edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
-      turn_cost = kTCCrossing;
-    } else {
-      turn_cost = (node->drive_on_right())
-                      ? kRightSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))]
-                      : kLeftSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))];
-    }
-
-    if ((edge->use() != Use::kRamp && pred->use() == Use::kRamp) ||
-        (edge->use() == Use::kRamp && pred->use() != Use::kRamp)) {
-      turn_cost += 1.5f;
-      if (edge->roundabout())
-        turn_cost += 0.5f;
-    }
-
-    // Separate time and penalty when traffic is present. With traffic, edge speeds account for
-    // much of the intersection transition time (TODO - evaluate different elapsed time settings).
-    // Still want to add a penalty so routes avoid high cost intersections.
-    float seconds = turn_cost * edge->stopimpact(idx);
-    // Apply density factor penality if there isnt traffic on this edge or youre not using traffic
-    if (!edge->has_flow_speed() || flow_mask_ == 0)
-      seconds *= trans_density_factor_[node->density()];
-
-    c.secs += seconds;
-    c.cost += seconds;
-  }
-  return c;
-}
-
 void ParseAutoCostOptions(const rapidjson::Document& doc,
                           const std::string& costing_options_key,
                           CostingOptions* pbf_costing_options) {
@@ -1296,6 +1028,15 @@ public:
   virtual ~AutoDataFix() {
   }
 
+  /**
+   * Can the components computed when the tiles were built be used. Edges with
+   * auto access in either direction are allowed so they cannot.
+   * @return  Returns true if the costing model can use the precomputed components.
+   */
+  virtual bool AllowPrecomputedComponents() const {
+    return false;
+  }
+
   /**
    * Checks if access is allowed for the provided directed edge.
    * This is generally based on mode of travel and the access modes
@@ -1557,6 +1298,48 @@ TEST(AutoCost, testAutoCostParams) {
     EXPECT_EQ(tester->flow_mask_, expected);
   }
 }
+// Tells which DirectCost visit_costing hands to its visitor
+struct VisitsAutoCostBase {
+  bool operator()(const DirectCost<AutoCostBase>&) const {
+    return true;
+  }
+  template <class costing_t> bool operator()(const DirectCost<costing_t>&) const {
+    return false;
+  }
+};
+
+TEST(AutoCost, testVisitCosting) {
+  Api request;
+  ParseApi("{}", valhalla::Options::route, request);
+  auto autocost = CreateAutoCost(Costing::auto_, request.options());
+  auto buscost = CreateBusCost(Costing::bus, request.options());
+  auto tester = std::make_shared<TestAutoCost>(Costing::auto_, request.options());
+
+  // Only an AutoCost gets the inlined per edge costing, the costings derived from it override
+  // those methods and fall back to the virtual calls
+  EXPECT_TRUE(AutoCostBase::Is(*autocost));
+  EXPECT_FALSE(AutoCostBase::Is(*buscost));
+  EXPECT_FALSE(AutoCostBase::Is(*tester));
+  EXPECT_TRUE(visit_costing(*autocost, VisitsAutoCostBase()));
+  EXPECT_FALSE(visit_costing(*buscost, VisitsAutoCostBase()));
+  EXPECT_FALSE(visit_costing(*tester, VisitsAutoCostBase()));
+
+  // Either way the costs are the ones of the virtual methods
+  DirectedEdge edge;
+  edge.set_length(1000);
+  edge.set_speed(50);
+  edge.set_density(9);
+  edge.set_forwardaccess(kAutoAccess);
+  edge.set_use(Use::kRoad);
+  GraphTile tile;
+  for (const auto& costing : {autocost, buscost}) {
+    Cost expected = costing->EdgeCost(&edge, &tile, kInvalidSecondsOfWeek);
+    Cost cost = visit_costing(*costing,
+                              [&](const auto& direct) { return direct.EdgeCost(&edge, &tile); });
+    EXPECT_EQ(cost.cost, expected.cost);
+    EXPECT_EQ(cost.secs, expected.secs);
+  }
+}
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -52,6 +52,11 @@ DynamicCost::DynamicCost(const Options& options, const TravelMode mode)
   for (auto& edge : options.avoid_edges()) {
     user_avoid_edges_.insert({GraphId(edge.id()), edge.percent_along()});
   }
+
+  // Add the bitsets of the edges inside avoid polygons
+  for (auto& tile : options.avoid_tiles()) {
+    user_avoid_tiles_.emplace(GraphId(tile.id()), tile.edges());
+  }
 }
 
 DynamicCost::~DynamicCost() {
@@ -64,6 +69,19 @@ bool DynamicCost::AllowMultiPass() const {
   return false;
 }
 
+// Can the reach stored in the tiles be used by this costing. Defaults to false.
+// Costing methods whose filters only look at access (and so match the filters
+// used when building the reach) override this method.
+bool DynamicCost::AllowPrecomputedReach() const {
+  return false;
+}
+
+// Can the components stored in the tiles be used by this costing. Defaults to false.
+// Costing methods which always require access for their mode override this method.
+bool DynamicCost::AllowPrecomputedComponents() const {
+  return false;
+}
+
 // We provide a convenience method for those algorithms which dont have time components or aren't
 // using them for the current route. Here we just call out to the derived classes costing function
 // with a time that tells the function that we aren't using time. This avoids having to worry about
@@ -72,6 +90,11 @@ Cost DynamicCost::EdgeCost(const baldr::DirectedEdge* edge, const baldr::GraphTi
   return EdgeCost(edge, tile, kInvalidSecondsOfWeek);
 }
 
+// Enable the edge cost cache for the rest of the request
+void DynamicCost::EnableEdgeCostCache(const size_t max_size) {
+  edge_cost_cache_.reset(max_size > 0 ? new EdgeCostCache(max_size) : nullptr);
+}
+
 // Returns the cost to make the transition from the predecessor edge.
 // Defaults to 0. Costing models that wish to include edge transition
 // costs (i.e., intersection/turn costs) must override this method.
@@ -0,0 +1,60 @@
+#include "sif/edgecostcache.h"
+
+#include <algorithm>
+
+using namespace valhalla::baldr;
+
+namespace valhalla {
+namespace sif {
+
+constexpr size_t EdgeCostCache::kBlockEntries;
+
+EdgeCostCache::EdgeCostCache(const size_t max_size)
+    : max_entries_(max_size / sizeof(entry_t)), entries_(0), block_used_(0), block_size_(0),
+      last_tile_id_(kInvalidGraphId), last_entries_(nullptr), hits_(0), misses_(0) {
+}
+
+void EdgeCostCache::Clear() {
+  entries_ = 0;
+  block_used_ = 0;
+  block_size_ = 0;
+  blocks_.clear();
+  tiles_.clear();
+  last_tile_id_ = kInvalidGraphId;
+  last_entries_ = nullptr;
+  hits_ = 0;
+  misses_ = 0;
+}
+
+size_t EdgeCostCache::size() const {
+  return entries_ * sizeof(entry_t);
+}
+
+EdgeCostCache::entry_t* EdgeCostCache::AllocateTile(const GraphTile* tile) {
+  const uint64_t tile_id = tile->header()->graphid().value;
+  auto found = tiles_.find(tile_id);
+  if (found != tiles_.end()) {
+    return found->second;
+  }
+
+  // Tiles that do not fit are remembered as not cached so they are not tried again
+  const size_t count = tile->header()->directededgecount();
+  entry_t* entries = nullptr;
+  if (count > 0 && entries_ + count <= max_entries_) {
+    // The edges of a tile have to be contiguous so start a new block if they do not
+    // fit in what is left of the last one. Entries start out zeroed (empty).
+    if (block_used_ + count > block_size_) {
+      block_size_ = std::max(kBlockEntries, count);
+      block_used_ = 0;
+      blocks_.emplace_back(new entry_t[block_size_]());
+    }
+    entries = blocks_.back().get() + block_used_;
+    block_used_ += count;
+    entries_ += count;
+  }
+  tiles_.emplace(tile_id, entries);
+  return entries;
+}
+
+} // namespace sif
+} // namespace valhalla
@@ -8,6 +8,8 @@
 #include "midgard/constants.h"
 #include "midgard/util.h"
 
+#include <typeinfo>
+
 #ifdef INLINE_TEST
 #include "test/test.h"
 #include "worker.h"
@@ -42,26 +44,6 @@ constexpr float kDefaultUseHighways = 0.5f; // Factor between 0 and 1
 constexpr float kDefaultUseTolls = 0.5f;    // Factor between 0 and 1
 constexpr float kDefaultUseTrails = 0.0f;   // Factor between 0 and 1
 
-constexpr Surface kMinimumMotorcycleSurface = Surface::kDirt;
-
-// Default turn costs
-constexpr float kTCStraight = 0.5f;
-constexpr float kTCSlight = 0.75f;
-constexpr float kTCFavorable = 1.0f;
-constexpr float kTCFavorableSharp = 1.5f;
-constexpr float kTCCrossing = 2.0f;
-constexpr float kTCUnfavorable = 2.5f;
-constexpr float kTCUnfavorableSharp = 3.5f;
-constexpr float kTCReverse = 5.0f;
-
-// Turn costs based on side of street driving
-constexpr float kRightSideTurnCosts[] = {kTCStraight,       kTCSlight,  kTCFavorable,
-                                         kTCFavorableSharp, kTCReverse, kTCUnfavorableSharp,
-                                         kTCUnfavorable,    kTCSlight};
-constexpr float kLeftSideTurnCosts[] = {kTCStraight,         kTCSlight,  kTCUnfavorable,
-                                        kTCUnfavorableSharp, kTCReverse, kTCFavorableSharp,
-                                        kTCFavorable,        kTCSlight};
-
 // Valid ranges and defaults
 constexpr ranged_default_t<float> kManeuverPenaltyRange{0, kDefaultManeuverPenalty, kMaxPenalty};
 constexpr ranged_default_t<float> kAlleyPenaltyRange{0, kDefaultAlleyPenalty, kMaxPenalty};
@@ -84,38 +66,31 @@ constexpr ranged_default_t<float> kDestinationOnlyPenaltyRange{0, kDefaultDestin
 // Maximum highway avoidance bias (modulates the highway factors based on road class)
 constexpr float kMaxHighwayBiasFactor = 8.0f;
 
-constexpr float kHighwayFactor[] = {
-    1.0f, // Motorway
-    0.5f, // Trunk
-    0.0f, // Primary
-    0.0f, // Secondary
-    0.0f, // Tertiary
-    0.0f, // Unclassified
-    0.0f, // Residential
-    0.0f  // Service, other
-};
-
 constexpr float kMaxTrailBiasFactor = 8.0f;
 
-constexpr float kSurfaceFactor[] = {
-    0.0f, // kPavedSmooth
-    0.0f, // kPaved
-    0.0f, // kPaveRough
-    0.1f, // kCompacted
-    0.2f, // kDirt
-    0.5f, // kGravel
-    1.0f  // kPath
-};
-
 } // namespace
 
+// Definitions of the constants MotorcycleCostBase uses in its inline costing methods
+constexpr float MotorcycleCostBase::kTCStraight;
+constexpr float MotorcycleCostBase::kTCSlight;
+constexpr float MotorcycleCostBase::kTCFavorable;
+constexpr float MotorcycleCostBase::kTCFavorableSharp;
+constexpr float MotorcycleCostBase::kTCCrossing;
+constexpr float MotorcycleCostBase::kTCUnfavorable;
+constexpr float MotorcycleCostBase::kTCUnfavorableSharp;
+constexpr float MotorcycleCostBase::kTCReverse;
+constexpr float MotorcycleCostBase::kRightSideTurnCosts[];
+constexpr float MotorcycleCostBase::kLeftSideTurnCosts[];
+constexpr float MotorcycleCostBase::kHighwayFactor[];
+constexpr float MotorcycleCostBase::kSurfaceFactor[];
+
 /**
  * Derived class providing dynamic edge costing for "direct" auto routes. This
  * is a route that is generally shortest time but uses route hierarchies that
  * can result in slightly longer routes that avoid shortcuts on residential
  * roads.
  */
-class MotorcycleCost : public DynamicCost {
+class MotorcycleCost : public MotorcycleCostBase {
 public:
   /**
    * Construct motorcycle costing. Pass in cost type and options using protocol buffer(pbf).
@@ -140,67 +115,7 @@ public:
    * @return  Returns access mode.
    */
   uint32_t access_mode() const {
-    return kMotorcycleAccess;
-  }
-
-  /**
-   * Checks if access is allowed for the provided directed edge.
-   * This is generally based on mode of travel and the access modes
-   * allowed on the edge. However, it can be extended to exclude access
-   * based on other parameters such as conditional restrictions and
-   * conditional access that can depend on time and travel mode.
-   * @param  edge           Pointer to a directed edge.
-   * @param  pred           Predecessor edge information.
-   * @param  tile           Current tile.
-   * @param  edgeid         GraphId of the directed edge.
-   * @param  current_time   Current time (seconds since epoch). A value of 0
-   *                        indicates the route is not time dependent.
-   * @param  tz_index       timezone index for the node
-   * @return Returns true if access is allowed, false if not.
-   */
-  virtual bool Allowed(const baldr::DirectedEdge* edge,
-                       const EdgeLabel& pred,
-                       const baldr::GraphTile*& tile,
-                       const baldr::GraphId& edgeid,
-                       const uint64_t current_time,
-                       const uint32_t tz_index,
-                       bool& time_restricted) const;
-
-  /**
-   * Checks if access is allowed for an edge on the reverse path
-   * (from destination towards origin). Both opposing edges (current and
-   * predecessor) are provided. The access check is generally based on mode
-   * of travel and the access modes allowed on the edge. However, it can be
-   * extended to exclude access based on other parameters such as conditional
-   * restrictions and conditional access that can depend on time and travel
-   * mode.
-   * @param  edge           Pointer to a directed edge.
-   * @param  pred           Predecessor edge information.
-   * @param  opp_edge       Pointer to the opposing directed edge.
-   * @param  tile           Current tile.
-   * @param  edgeid         GraphId of the opposing edge.
-   * @param  current_time   Current time (seconds since epoch). A value of 0
-   *                        indicates the route is not time dependent.
-   * @param  tz_index       timezone index for the node
-   * @return  Returns true if access is allowed, false if not.
-   */
-  virtual bool AllowedReverse(const baldr::DirectedEdge* edge,
-                              const EdgeLabel& pred,
-                              const baldr::DirectedEdge* opp_edge,
-                              const baldr::GraphTile*& tile,
-                              const baldr::GraphId& opp_edgeid,
-                              const uint64_t current_time,
-                              const uint32_t tz_index,
-                              bool& has_time_restrictions) const;
-
-  /**
-   * Checks if access is allowed for the provided node. Node access can
-   * be restricted if bollards or gates are present.
-   * @param  node  Pointer to node information.
-   * @return  Returns true if access is allowed, false if not.
-   */
-  virtual bool Allowed(const baldr::NodeInfo* node) const {
-    return (node->access() & kMotorcycleAccess);
+    return baldr::kMotorcycleAccess;
   }
 
   /**
@@ -216,49 +131,6 @@ public:
     throw std::runtime_error("MotorcycleCost::EdgeCost does not support transit edges");
   }
 
-  /**
-   * Get the cost to traverse the specified directed edge. Cost includes
-   * the time (seconds) to traverse the edge.
-   * @param  edge      Pointer to a directed edge.
-   * @param  tile      Current tile.
-   * @param  seconds   Time of week in seconds.
-   * @return  Returns the cost and time (seconds)
-   */
-  virtual Cost EdgeCost(const baldr::DirectedEdge* edge,
-                        const baldr::GraphTile* tile,
-                        const uint32_t seconds) const;
-
-  /**
-   * Returns the cost to make the transition from the predecessor edge.
-   * Defaults to 0. Costing models that wish to include edge transition
-   * costs (i.e., intersection/turn costs) must override this method.
-   * @param  edge  Directed edge (the to edge)
-   * @param  node  Node (intersection) where transition occurs.
-   * @param  pred  Predecessor edge information.
-   * @param  has_traffic  Does the transition have traffic information.
-   * @return  Returns the cost and time (seconds)
-   */
-  virtual Cost TransitionCost(const baldr::DirectedEdge* edge,
-                              const baldr::NodeInfo* node,
-                              const EdgeLabel& pred,
-                              const bool has_traffic) const;
-
-  /**
-   * Returns the cost to make the transition from the predecessor edge
-   * when using a reverse search (from destination towards the origin).
-   * @param  idx   Directed edge local index
-   * @param  node  Node (intersection) where transition occurs.
-   * @param  pred  the opposing current edge in the reverse tree.
-   * @param  edge  the opposing predecessor in the reverse tree
-   * @param  has_traffic  Does the transition have traffic information.
-   * @return  Returns the cost and time (seconds)
-   */
-  virtual Cost TransitionCostReverse(const uint32_t idx,
-                                     const baldr::NodeInfo* node,
-                                     const baldr::DirectedEdge* pred,
-                                     const baldr::DirectedEdge* edge,
-                                     const bool has_traffic) const;
-
   /**
    * Get the cost factor for A* heuristics. This factor is multiplied
    * with the distance to the destination to produce an estimate of the
@@ -268,7 +140,7 @@ public:
    * estimate is less than the least possible time along roads.
    */
   virtual float AStarCostFactor() const {
-    return speedfactor_[kMaxSpeedKph];
+    return speedfactor_[baldr::kMaxSpeedKph];
   }
 
   /**
@@ -289,7 +161,7 @@ public:
   virtual const EdgeFilter GetEdgeFilter() const {
     // Throw back a lambda that checks the access for this type of costing
     return [](const baldr::DirectedEdge* edge) {
-      if (edge->is_shortcut() || !(edge->forwardaccess() & kMotorcycleAccess) ||
+      if (edge->is_shortcut() || !(edge->forwardaccess() & baldr::kMotorcycleAccess) ||
           edge->surface() > kMinimumMotorcycleSurface)
         return 0.0f;
       else {
@@ -306,30 +178,19 @@ public:
    */
   virtual const NodeFilter GetNodeFilter() const {
     // throw back a lambda that checks the access for this type of costing
-    return [](const baldr::NodeInfo* node) { return !(node->access() & kMotorcycleAccess); };
+    return [](const baldr::NodeInfo* node) { return !(node->access() & baldr::kMotorcycleAccess); };
   }
 
-  // Hidden in source file so we don't need it to be protected
-  // We expose it within the source file for testing purposes
-public:
   VehicleType type_; // Vehicle type: car (default), motorcycle, etc
-  float speedfactor_[kMaxSpeedKph + 1];
-  float density_factor_[16]; // Density factor
-  float ferry_factor_;       // Weighting to apply to ferry edges
-  float toll_factor_;        // Factor applied when road has a toll
-  float surface_factor_;     // How much the surface factors are applied when using trails
-  float highway_factor_;     // Factor applied when road is a motorway or trunk
-
-  // Density factor used in edge transition costing
-  std::vector<float> trans_density_factor_;
 };
 
+bool MotorcycleCostBase::Is(const DynamicCost& costing) {
+  return typeid(costing) == typeid(MotorcycleCost);
+}
+
 // Constructor
 MotorcycleCost::MotorcycleCost(const Costing costing, const Options& options)
-    : DynamicCost(options, TravelMode::kDrive), trans_density_factor_{1.0f, 1.0f, 1.0f, 1.0f,
-                                                                      1.0f, 1.1f, 1.2f, 1.3f,
-                                                                      1.4f, 1.6f, 1.9f, 2.2f,
-                                                                      2.5f, 2.8f, 3.1f, 3.5f} {
+    : MotorcycleCostBase(options, TravelMode::kDrive) {
 
   // Grab the costing options based on the specified costing type
   const CostingOptions& costing_options = options.costing_options(static_cast<int>(costing));
@@ -395,165 +256,6 @@ MotorcycleCost::MotorcycleCost(const Costing costing, const Options& options)
 MotorcycleCost::~MotorcycleCost() {
 }
 
-// Check if access is allowed on the specified edge.
-bool MotorcycleCost::Allowed(const baldr::DirectedEdge* edge,
-                             const EdgeLabel& pred,
-                             const baldr::GraphTile*& tile,
-                             const baldr::GraphId& edgeid,
-                             const uint64_t current_time,
-                             const uint32_t tz_index,
-                             bool& has_time_restrictions) const {
-  // Check access, U-turn, and simple turn restriction.
-  // Allow U-turns at dead-end nodes.
-  if (!(edge->forwardaccess() & kMotorcycleAccess) ||
-      (!pred.deadend() && pred.opp_local_idx() == edge->localedgeidx()) ||
-      (pred.restrictions() & (1 << edge->localedgeidx())) || IsUserAvoidEdge(edgeid) ||
-      (!allow_destination_only_ && !pred.destonly() && edge->destonly())) {
-    return false;
-  }
-  if (edge->surface() > kMinimumMotorcycleSurface) {
-    return false;
-  }
-  return DynamicCost::EvaluateRestrictions(kMotorcycleAccess, edge, tile, edgeid, current_time,
-                                           tz_index, has_time_restrictions);
-}
-
-// Checks if access is allowed for an edge on the reverse path (from
-// destination towards origin). Both opposing edges are provided.
-bool MotorcycleCost::AllowedReverse(const baldr::DirectedEdge* edge,
-                                    const EdgeLabel& pred,
-                                    const baldr::DirectedEdge* opp_edge,
-                                    const baldr::GraphTile*& tile,
-                                    const baldr::GraphId& opp_edgeid,
-                                    const uint64_t current_time,
-                                    const uint32_t tz_index,
-                                    bool& has_time_restrictions) const {
-  // Check access, U-turn, and simple turn restriction.
-  // Allow U-turns at dead-end nodes.
-  if (!(opp_edge->forwardaccess() & kMotorcycleAccess) ||
-      (!pred.deadend() && pred.opp_local_idx() == edge->localedgeidx()) ||
-      (opp_edge->restrictions() & (1 << pred.opp_local_idx())) || IsUserAvoidEdge(opp_edgeid) ||
-      (!allow_destination_only_ && !pred.destonly() && opp_edge->destonly())) {
-    return false;
-  }
-
-  if (opp_edge->surface() > kMinimumMotorcycleSurface) {
-    return false;
-  }
-  return DynamicCost::EvaluateRestrictions(kMotorcycleAccess, edge, tile, opp_edgeid, current_time,
-                                           tz_index, has_time_restrictions);
-}
-
-Cost MotorcycleCost::EdgeCost(const baldr::DirectedEdge* edge,
-                              const baldr::GraphTile* tile,
-                              const uint32_t seconds) const {
-  auto speed = tile->GetSpeed(edge, flow_mask_, seconds);
-
-  // Special case for travel on a ferry
-  if (edge->use() == Use::kFerry) {
-    // Use the edge speed (should be the speed of the ferry)
-    float sec = (edge->length() * speedfactor_[edge->speed()]);
-    return {sec * ferry_factor_, sec};
-  }
-
-  float factor = density_factor_[edge->density()] +
-                 highway_factor_ * kHighwayFactor[static_cast<uint32_t>(edge->classification())] +
-                 surface_factor_ * kSurfaceFactor[static_cast<uint32_t>(edge->surface())];
-  if (edge->toll()) {
-    factor += toll_factor_;
-  }
-
-  float sec = (edge->length() * speedfactor_[speed]);
-  return {sec * factor, sec};
-}
-
-// Returns the time (in seconds) to make the transition from the predecessor
-Cost MotorcycleCost::TransitionCost(const baldr::DirectedEdge* edge,
-                                    const baldr::NodeInfo* node,
-                                    const EdgeLabel& pred,
-                                    const bool has_traffic) const {
-  // Get the transition cost for country crossing, ferry, gate, toll booth,
-  // destination only, alley, maneuver penalty
-  uint32_t idx = pred.opp_local_idx();
-  Cost c = base_transition_cost(node, edge, pred, idx);
-
-  // Transition time = densityfactor * stopimpact * turncost
-  if (edge->stopimpact(idx) > 0) {
-    float turn_cost;
-    if (edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
-      turn_cost = kTCCrossing;
-    } else {
-      turn_cost = (node->drive_on_right())
-                      ? kRightSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))]
-                      : kLeftSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))];
-    }
-
-    if ((edge->use() != Use::kRamp && pred.use() == Use::kRamp) ||
-        (edge->use() == Use::kRamp && pred.use() != Use::kRamp)) {
-      turn_cost += 1.5f;
-      if (edge->roundabout())
-        turn_cost += 0.5f;
-    }
-
-    // Separate time and penalty when traffic is present. With traffic, edge speeds account for
-    // much of the intersection transition time (TODO - evaluate different elapsed time settings).
-    // Still want to add a penalty so routes avoid high cost intersections.
-    float seconds = turn_cost * edge->stopimpact(idx);
-    // Apply density factor penality if there isnt traffic on this edge or youre not using traffic
-    if (!edge->has_flow_speed() || flow_mask_ == 0)
-      seconds *= trans_density_factor_[node->density()];
-
-    c.cost += seconds;
-    c.secs += seconds;
-  }
-  return c;
-}
-
-// Returns the cost to make the transition from the predecessor edge
-// when using a reverse search (from destination towards the origin).
-// pred is the opposing current edge in the reverse tree
-// edge is the opposing predecessor in the reverse tree
-Cost MotorcycleCost::TransitionCostReverse(const uint32_t idx,
-                                           const baldr::NodeInfo* node,
-                                           const baldr::DirectedEdge* pred,
-                                           const baldr::DirectedEdge* edge,
-                                           const bool has_traffic) const {
-  // Get the transition cost for country crossing, ferry, gate, toll booth,
-  // destination only, alley, maneuver penalty
-  Cost c = base_transition_cost(node, edge, pred, idx);
-
-  // Transition time = densityfactor * stopimpact * turncost
-  if (edge->stopimpact(idx) > 0) {
-    float turn_cost;
-    if (edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
-      turn_cost = kTCCrossing;
-    } else {
-      turn_cost = (node->drive_on_right())
-                      ? kRightSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))]
-                      : kLeftSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))];
-    }
-
-    if ((edge->use() != Use::kRamp && pred->use() == Use::kRamp) ||
-        (edge->use() == Use::kRamp && pred->use() != Use::kRamp)) {
-      turn_cost += 1.5f;
-      if (edge->roundabout())
-        turn_cost += 0.5f;
-    }
-
-    // Separate time and penalty when traffic is present. With traffic, edge speeds account for
-    // much of the intersection transition time (TODO - evaluate different elapsed time settings).
-    // Still want to add a penalty so routes avoid high cost intersections.
-    float seconds = turn_cost * edge->stopimpact(idx);
-    // Apply density factor penality if there isnt traffic on this edge or youre not using traffic
-    if (!edge->has_flow_speed() || flow_mask_ == 0)
-      seconds *= trans_density_factor_[node->density()];
-
-    c.cost += seconds;
-    c.secs += seconds;
-  }
-  return c;
-}
-
 void ParseMotorcycleCostOptions(const rapidjson::Document& doc,
                                 const std::string& costing_options_key,
                                 CostingOptions* pbf_costing_options) {
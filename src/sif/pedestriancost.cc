@@ -6,6 +6,8 @@
 #include "midgard/constants.h"
 #include "midgard/util.h"
 
+#include <typeinfo>
+
 #ifdef INLINE_TEST
 #include "test/test.h"
 #include "worker.h"
@@ -67,17 +69,10 @@ constexpr uint32_t kTransitStartEndMaxDistance = 2415; // 1.5 miles
 // distance you are willing to walk between transfers.
 constexpr uint32_t kTransitTransferMaxDistance = 805; // 0.5 miles
 
-// Avoid roundabouts
-constexpr float kRoundaboutFactor = 2.0f;
-
 // Minimum and maximum average pedestrian speed (to validate input).
 constexpr float kMinPedestrianSpeed = 0.5f;
 constexpr float kMaxPedestrianSpeed = 25.0f;
 
-// Crossing penalties. TODO - may want to lower stop impact when
-// 2 cycleways or walkways cross
-constexpr uint32_t kCrossingCosts[] = {0, 0, 1, 1, 2, 3, 5, 15};
-
 constexpr float kMinFactor = 0.1f;
 constexpr float kMaxFactor = 100000.0f;
 
@@ -126,32 +121,18 @@ constexpr ranged_default_t<uint32_t> kTransitTransferMaxDistanceRange{0, kTransi
                                                                       50000}; // Max 50k
 constexpr ranged_default_t<float> kUseFerryRange{0, kDefaultUseFerry, 1.0f};
 
-constexpr float kSacScaleSpeedFactor[] = {
-    1.0f,  // kNone
-    1.11f, // kHiking (~90% speed)
-    1.25f, // kMountainHiking (80% speed)
-    1.54f, // kDemandingMountainHiking (~65% speed)
-    2.5f,  // kAlpineHiking (40% speed)
-    4.0f,  // kDemandingAlpineHiking (25% speed)
-    6.67f  // kDifficultAlpineHiking (~15% speed)
-};
-
-constexpr float kSacScaleCostFactor[] = {
-    0.0f,  // kNone
-    0.25f, // kHiking
-    0.75f, // kMountainHiking
-    1.25f, // kDemandingMountainHiking
-    2.0f,  // kAlpineHiking
-    2.5f,  // kDemandingAlpineHiking
-    3.0f   // kDifficultAlpineHiking
-};
-
 } // namespace
 
+// Definitions of the constants PedestrianCostBase uses in its inline costing methods
+constexpr float PedestrianCostBase::kRoundaboutFactor;
+constexpr uint32_t PedestrianCostBase::kCrossingCosts[];
+constexpr float PedestrianCostBase::kSacScaleSpeedFactor[];
+constexpr float PedestrianCostBase::kSacScaleCostFactor[];
+
 /**
  * Derived class providing dynamic edge costing for pedestrian routes.
  */
-class PedestrianCost : public DynamicCost {
+class PedestrianCost : public PedestrianCostBase {
 public:
   /**
    * Construct pedestrian costing. Pass in cost type and options using protocol buffer(pbf).
@@ -173,6 +154,25 @@ public:
     return true;
   }
 
+  /**
+   * Can the reach computed when the tiles were built be used. The stored reach
+   * avoids every path with a hiking difficulty so it never exceeds what this
+   * costing allows.
+   * @return  Returns true if the costing model can use the precomputed reach.
+   */
+  virtual bool AllowPrecomputedReach() const {
+    return true;
+  }
+
+  /**
+   * Can the components computed when the tiles were built be used. Edges and
+   * nodes without access for the pedestrian type are never allowed.
+   * @return  Returns true if the costing model can use the precomputed components.
+   */
+  virtual bool AllowPrecomputedComponents() const {
+    return true;
+  }
+
   /**
    * This method overrides the max_distance with the max_distance_mm per segment
    * distance. An example is a pure walking route may have a max distance of
@@ -209,66 +209,6 @@ public:
     return access_mask_;
   }
 
-  /**
-   * Checks if access is allowed for the provided directed edge.
-   * This is generally based on mode of travel and the access modes
-   * allowed on the edge. However, it can be extended to exclude access
-   * based on other parameters such as conditional restrictions and
-   * conditional access that can depend on time and travel mode.
-   * @param  edge           Pointer to a directed edge.
-   * @param  pred           Predecessor edge information.
-   * @param  tile           Current tile.
-   * @param  edgeid         GraphId of the directed edge.
-   * @param  current_time   Current time (seconds since epoch). A value of 0
-   *                        indicates the route is not time dependent.
-   * @param  tz_index       timezone index for the node
-   * @return Returns true if access is allowed, false if not.
-   */
-  virtual bool Allowed(const baldr::DirectedEdge* edge,
-                       const EdgeLabel& pred,
-                       const baldr::GraphTile*& tile,
-                       const baldr::GraphId& edgeid,
-                       const uint64_t current_time,
-                       const uint32_t tz_index,
-                       bool& time_restricted) const;
-
-  /**
-   * Checks if access is allowed for an edge on the reverse path
-   * (from destination towards origin). Both opposing edges (current and
-   * predecessor) are provided. The access check is generally based on mode
-   * of travel and the access modes allowed on the edge. However, it can be
-   * extended to exclude access based on other parameters such as conditional
-   * restrictions and conditional access that can depend on time and travel
-   * mode.
-   * @param  edge           Pointer to a directed edge.
-   * @param  pred           Predecessor edge information.
-   * @param  opp_edge       Pointer to the opposing directed edge.
-   * @param  tile           Current tile.
-   * @param  edgeid         GraphId of the opposing edge.
-   * @param  current_time   Current time (seconds since epoch). A value of 0
-   *                        indicates the route is not time dependent.
-   * @param  tz_index       timezone index for the node
-   * @return  Returns true if access is allowed, false if not.
-   */
-  virtual bool AllowedReverse(const baldr::DirectedEdge* edge,
-                              const EdgeLabel& pred,
-                              const baldr::DirectedEdge* opp_edge,
-                              const baldr::GraphTile*& tile,
-                              const baldr::GraphId& opp_edgeid,
-                              const uint64_t current_time,
-                              const uint32_t tz_index,
-                              bool& has_time_restrictions) const;
-
-  /**
-   * Checks if access is allowed for the provided node. Node access can
-   * be restricted if bollards or gates are present.
-   * @param  node  Pointer to node information.
-   * @return  Returns true if access is allowed, false if not.
-   */
-  virtual bool Allowed(const baldr::NodeInfo* node) const {
-    return (node->access() & access_mask_);
-  }
-
   /**
    * Only transit costings are valid for this method call, hence we throw
    * @param edge
@@ -282,47 +222,6 @@ public:
     throw std::runtime_error("PedestrianCost::EdgeCost does not support transit edges");
   }
 
-  /**
-   * Get the cost to traverse the specified directed edge. Cost includes
-   * the time (seconds) to traverse the edge.
-   * @param  edge      Pointer to a directed edge.
-   * @param  tile      Current tile.
-   * @param  seconds   Time of week in seconds.
-   * @return  Returns the cost and time (seconds)
-   */
-  virtual Cost EdgeCost(const baldr::DirectedEdge* edge,
-                        const baldr::GraphTile* tile,
-                        const uint32_t seconds) const;
-
-  /**
-   * Returns the cost to make the transition from the predecessor edge.
-   * Defaults to 0. Costing models that wish to include edge transition
-   * costs (i.e., intersection/turn costs) must override this method.
-   * @param  edge  Directed edge (the to edge)
-   * @param  node  Node (intersection) where transition occurs.
-   * @param  pred  Predecessor edge information.
-   * @return  Returns the cost and time (seconds)
-   */
-  virtual Cost TransitionCost(const baldr::DirectedEdge* edge,
-                              const baldr::NodeInfo* node,
-                              const EdgeLabel& pred) const;
-
-  /**
-   * Returns the cost to make the transition from the predecessor edge
-   * when using a reverse search (from destination towards the origin).
-   * Defaults to 0. Costing models that wish to include edge transition
-   * costs (i.e., intersection/turn costs) must override this method.
-   * @param  idx   Directed edge local index
-   * @param  node  Node (intersection) where transition occurs.
-   * @param  pred  the opposing current edge in the reverse tree.
-   * @param  edge  the opposing predecessor in the reverse tree
-   * @return  Returns the cost and time (seconds)
-   */
-  virtual Cost TransitionCostReverse(const uint32_t idx,
-                                     const baldr::NodeInfo* node,
-                                     const baldr::DirectedEdge* pred,
-                                     const baldr::DirectedEdge* edge) const;
-
   /**
    * Get the cost factor for A* heuristics. This factor is multiplied
    * with the distance to the destination to produce an estimate of the
@@ -353,7 +252,7 @@ public:
 
       return (speedfactor_ * factor);
     } else {
-      return (kSecPerHour * 0.001f) / static_cast<float>(kMaxFerrySpeedKph);
+      return (midgard::kSecPerHour * 0.001f) / static_cast<float>(baldr::kMaxFerrySpeedKph);
     }
   }
 
@@ -377,7 +276,7 @@ public:
     auto access_mask = access_mask_;
     auto max_sac_scale = max_hiking_difficulty_;
     return [access_mask, max_sac_scale](const baldr::DirectedEdge* edge) {
-      return !(edge->is_shortcut() || edge->use() >= Use::kRail ||
+      return !(edge->is_shortcut() || edge->use() >= baldr::Use::kRail ||
                edge->sac_scale() > max_sac_scale || !(edge->forwardaccess() & access_mask));
     };
   }
@@ -393,15 +292,9 @@ public:
     return [access_mask](const baldr::NodeInfo* node) { return !(node->access() & access_mask); };
   }
 
-public:
   // Type: foot (default), wheelchair, etc.
   PedestrianType type_;
 
-  uint32_t access_mask_;
-
-  // Maximum pedestrian distance.
-  uint32_t max_distance_;
-
   // This is the factor for this mode.  The higher the value the more the
   // mode is favored.
   float mode_factor_;
@@ -418,114 +311,17 @@ public:
   // you are willing to walk between transfers.
   uint32_t transit_transfer_max_distance_;
 
-  // Minimal surface type usable by the pedestrian type
-  Surface minimal_allowed_surface_;
-
-  uint32_t max_grade_;             // Maximum grade (percent).
-  SacScale max_hiking_difficulty_; // Max sac_scale (0 - 6)
-  float speed_;                    // Pedestrian speed.
-  float speedfactor_;              // Speed factor for costing. Based on speed.
-  float walkway_factor_;           // Factor for favoring walkways and paths.
-  float sidewalk_factor_;          // Factor for favoring sidewalks.
-  float alley_factor_;             // Avoid alleys factor.
-  float driveway_factor_;          // Avoid driveways factor.
-  float step_penalty_;             // Penalty applied to steps/stairs (seconds).
-
-  /**
-   * Override the base transition cost to not add maneuver penalties onto transit edges.
-   * Base transition cost that all costing methods use. Includes costs for
-   * country crossing, boarding a ferry, toll booth, gates, entering destination
-   * only, alleys, and maneuver penalties. Each costing method can provide different
-   * costs for these transitions (via costing options).
-   * @param node Node at the intersection where the edge transition occurs.
-   * @param edge Directed edge entering.
-   * @param pred Predecessor edge information.
-   * @param idx  Index used for name consistency.
-   * @return Returns the transition cost (cost, elapsed time).
-   */
-  sif::Cost base_transition_cost(const baldr::NodeInfo* node,
-                                 const baldr::DirectedEdge* edge,
-                                 const sif::EdgeLabel& pred,
-                                 const uint32_t idx) const {
-    // Cases with both time and penalty: country crossing, ferry, gate, toll booth
-    sif::Cost c;
-    if (node->type() == baldr::NodeType::kBorderControl) {
-      c += country_crossing_cost_;
-    }
-    if (node->type() == baldr::NodeType::kGate) {
-      c += gate_cost_;
-    }
-    if (node->type() == baldr::NodeType::kTollBooth) {
-      c += toll_booth_cost_;
-    }
-    if (edge->use() == baldr::Use::kFerry && pred.use() != baldr::Use::kFerry) {
-      c += ferry_transition_cost_;
-    }
-
-    // Additional penalties without any time cost
-    if (edge->destonly() && !pred.destonly()) {
-      c.cost += destination_only_penalty_;
-    }
-    if (edge->use() == baldr::Use::kAlley && pred.use() != baldr::Use::kAlley) {
-      c.cost += alley_penalty_;
-    }
-    if (!edge->link() && edge->use() != Use::kEgressConnection &&
-        edge->use() != Use::kPlatformConnection && !edge->name_consistency(idx)) {
-      c.cost += maneuver_penalty_;
-    }
-    return c;
-  }
-
-  /**
-   * Override the base transition cost to not add maneuver penalties onto transit edges.
-   * Base transition cost that all costing methods use. Includes costs for
-   * country crossing, boarding a ferry, toll booth, gates, entering destination
-   * only, alleys, and maneuver penalties. Each costing method can provide different
-   * costs for these transitions (via costing options).
-   * @param node Node at the intersection where the edge transition occurs.
-   * @param edge Directed edge entering.
-   * @param pred Predecessor edge.
-   * @param idx  Index used for name consistency.
-   * @return Returns the transition cost (cost, elapsed time).
-   */
-  sif::Cost base_transition_cost(const baldr::NodeInfo* node,
-                                 const baldr::DirectedEdge* edge,
-                                 const baldr::DirectedEdge* pred,
-                                 const uint32_t idx) const {
-    // Cases with both time and penalty: country crossing, ferry, gate, toll booth
-    sif::Cost c;
-    if (node->type() == baldr::NodeType::kBorderControl) {
-      c += country_crossing_cost_;
-    }
-    if (node->type() == baldr::NodeType::kGate) {
-      c += gate_cost_;
-    }
-    if (node->type() == baldr::NodeType::kTollBooth) {
-      c += toll_booth_cost_;
-    }
-    if (edge->use() == baldr::Use::kFerry && pred->use() != baldr::Use::kFerry) {
-      c += ferry_transition_cost_;
-    }
-
-    // Additional penalties without any time cost
-    if (edge->destonly() && !pred->destonly()) {
-      c.cost += destination_only_penalty_;
-    }
-    if (edge->use() == baldr::Use::kAlley && pred->use() != baldr::Use::kAlley) {
-      c.cost += alley_penalty_;
-    }
-    if (!edge->link() && edge->use() != Use::kEgressConnection &&
-        edge->use() != Use::kPlatformConnection && !edge->name_consistency(idx)) {
-      c.cost += maneuver_penalty_;
-    }
-    return c;
-  }
+  float speed_; // Pedestrian speed.
 };
 
+bool PedestrianCostBase::Is(const DynamicCost& costing) {
+  return typeid(costing) == typeid(PedestrianCost);
+}
+
 // Constructor. Parse pedestrian options from property tree. If option is
 // not present, set the default.
 PedestrianCost::PedestrianCost(const Costing costing, const Options& options)
-    : DynamicCost(options, TravelMode::kPedestrian) {
+    : PedestrianCostBase(options, TravelMode::kPedestrian) {
   // Grab the costing options based on the specified costing type
   const CostingOptions& costing_options = options.costing_options(static_cast<int>(costing));
 
@@ -581,144 +377,6 @@ PedestrianCost::PedestrianCost(const Costing costing, const Options& options)
   speedfactor_ = (kSecPerHour * 0.001f) / speed_;
 }
 
-// Check if access is allowed on the specified edge. Disallow if no
-// access for this pedestrian type, if surface type exceeds (worse than)
-// the minimum allowed surface type, or if max grade is exceeded.
-// Disallow edges where max. distance will be exceeded.
-bool PedestrianCost::Allowed(const baldr::DirectedEdge* edge,
-                             const EdgeLabel& pred,
-                             const baldr::GraphTile*& tile,
-                             const baldr::GraphId& edgeid,
-                             const uint64_t current_time,
-                             const uint32_t tz_index,
-                             bool& has_time_restrictions) const {
-  if (!(edge->forwardaccess() & access_mask_) || (edge->surface() > minimal_allowed_surface_) ||
-      edge->is_shortcut() || IsUserAvoidEdge(edgeid) || edge->sac_scale() > max_hiking_difficulty_ ||
-      //      (edge->max_up_slope() > max_grade_ || edge->max_down_slope() > max_grade_) ||
-      ((pred.path_distance() + edge->length()) > max_distance_)) {
-    return false;
-  }
-  // Disallow transit connections (except when set for multi-modal routes)
-  if (!allow_transit_connections_ &&
-      (edge->use() == Use::kPlatformConnection || edge->use() == Use::kEgressConnection ||
-       edge->use() == Use::kTransitConnection)) {
-    return false;
-  }
-
-  return DynamicCost::EvaluateRestrictions(access_mask_, edge, tile, edgeid, current_time, tz_index,
-                                           has_time_restrictions);
-}
-
-// Checks if access is allowed for an edge on the reverse path (from
-// destination towards origin). Both opposing edges are provided.
-bool PedestrianCost::AllowedReverse(const baldr::DirectedEdge* edge,
-                                    const EdgeLabel& pred,
-                                    const baldr::DirectedEdge* opp_edge,
-                                    const baldr::GraphTile*& tile,
-                                    const baldr::GraphId& opp_edgeid,
-                                    const uint64_t current_time,
-                                    const uint32_t tz_index,
-                                    bool& has_time_restrictions) const {
-  // TODO - obtain and check the access restrictions.
-
-  // Do not check max walking distance and assume we are not allowing
-  // transit connections. Assume this method is never used in
-  // multimodal routes).
-  if (!(opp_edge->forwardaccess() & access_mask_) ||
-      (opp_edge->surface() > minimal_allowed_surface_) || opp_edge->is_shortcut() ||
-      IsUserAvoidEdge(opp_edgeid) || edge->sac_scale() > max_hiking_difficulty_ ||
-      //      (opp_edge->max_up_slope() > max_grade_ || opp_edge->max_down_slope() > max_grade_) ||
-      opp_edge->use() == Use::kTransitConnection || opp_edge->use() == Use::kEgressConnection ||
-      opp_edge->use() == Use::kPlatformConnection) {
-    return false;
-  }
-
-  return DynamicCost::EvaluateRestrictions(access_mask_, edge, tile, opp_edgeid, current_time,
-                                           tz_index, has_time_restrictions);
-}
-
-// Returns the cost to traverse the edge and an estimate of the actual time
-// (in seconds) to traverse the edge.
-Cost PedestrianCost::EdgeCost(const baldr::DirectedEdge* edge,
-                              const baldr::GraphTile* tile,
-                              const uint32_t seconds) const {
-
-  // Ferries are a special case - they use the ferry speed (stored on the edge)
-  if (edge->use() == Use::kFerry) {
-    auto speed = tile->GetSpeed(edge, flow_mask_, seconds);
-    float sec = edge->length() * (kSecPerHour * 0.001f) / static_cast<float>(speed);
-    return {sec * ferry_factor_, sec};
-  }
-
-  // TODO - consider using an array of "use factors" to avoid this conditional
-  float factor = 1.0f + kSacScaleCostFactor[static_cast<uint8_t>(edge->sac_scale())];
-  if (edge->use() == Use::kFootway || edge->use() == Use::kSidewalk) {
-    factor *= walkway_factor_;
-  } else if (edge->use() == Use::kAlley) {
-    factor *= alley_factor_;
-  } else if (edge->use() == Use::kDriveway) {
-    factor *= driveway_factor_;
-  } else if (edge->sidewalk_left() || edge->sidewalk_right()) {
-    factor *= sidewalk_factor_;
-  } else if (edge->roundabout()) {
-    factor *= kRoundaboutFactor;
-  }
-
-  // Slightly favor walkways/paths and penalize alleys and driveways.
-  float sec =
-      edge->length() * speedfactor_ * kSacScaleSpeedFactor[static_cast<uint8_t>(edge->sac_scale())];
-  return {sec * factor, sec};
-}
-
-// Returns the time (in seconds) to make the transition from the predecessor
-Cost PedestrianCost::TransitionCost(const baldr::DirectedEdge* edge,
-                                    const baldr::NodeInfo* node,
-                                    const EdgeLabel& pred) const {
-  // Special cases: fixed penalty for steps/stairs
-  if (edge->use() == Use::kSteps) {
-    return {step_penalty_, 0.0f};
-  }
-
-  // Get the transition cost for country crossing, ferry, gate, toll booth,
-  // destination only, alley, maneuver penalty
-  uint32_t idx = pred.opp_local_idx();
-  Cost c = base_transition_cost(node, edge, pred, idx);
-
-  // Costs for crossing an intersection.
-  if (edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
-    float seconds = kCrossingCosts[edge->stopimpact(idx)];
-    c.secs += seconds;
-    c.cost += seconds;
-  }
-  return c;
-}
-
-// Returns the cost to make the transition from the predecessor edge
-// when using a reverse search (from destination towards the origin).
-// Defaults to 0. Costing models that wish to include edge transition
-// costs (i.e., intersection/turn costs) must override this method.
-Cost PedestrianCost::TransitionCostReverse(const uint32_t idx,
-                                           const baldr::NodeInfo* node,
-                                           const baldr::DirectedEdge* pred,
-                                           const baldr::DirectedEdge* edge) const {
-  // Special cases: fixed penalty for steps/stairs
-  if (edge->use() == Use::kSteps) {
-    return {step_penalty_, 0.0f};
-  }
-
-  // Get the transition cost for country crossing, ferry, gate, toll booth,
-  // destination only, alley, maneuver penalty
-  Cost c = base_transition_cost(node, edge, pred, idx);
-
-  // Costs for crossing an intersection.
-  if (edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
-    float seconds = kCrossingCosts[edge->stopimpact(idx)];
-    c.secs += seconds;
-    c.cost += seconds;
-  }
-  return c;
-}
-
 void ParsePedestrianCostOptions(const rapidjson::Document& doc,
                                 const std::string& costing_options_key,
                                 CostingOptions* pbf_costing_options) {
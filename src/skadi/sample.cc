@@ -1,5 +1,6 @@
 #include "skadi/sample.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <fstream>
@@ -9,6 +10,7 @@
 #include <stdexcept>
 #include <string>
 #include <sys/stat.h>
+#include <unordered_map>
 
 #include <boost/optional.hpp>
 
@@ -101,14 +103,155 @@ uint64_t file_size(const std::string& file_name) {
   return rc == 0 ? s.st_size : -1;
 }
 
+// the index of the data tile a posting falls in or TILE_COUNT if its outside of the valid range
+template <class coord_t> uint32_t tile_index(const coord_t& coord) {
+  auto lon = std::floor(coord.first);
+  auto lat = std::floor(coord.second);
+  if (!(lon >= -180 && lon < 180 && lat >= -90 && lat < 90)) {
+    return TILE_COUNT;
+  }
+  return static_cast<uint32_t>(lat + 90) * 360 + static_cast<uint32_t>(lon + 180);
+}
+
+// bilinear interpolation of the posting within the given data tile
+template <class coord_t> double interpolate(const int16_t* t, const coord_t& coord) {
+  auto lon = std::floor(coord.first);
+  auto lat = std::floor(coord.second);
+
+  // figure out what row and column we need from the array of data
+  // NOTE: data is arranged from upper left to bottom right, so y is flipped
+
+  // fractional pixel
+  double u = (coord.first - lon) * (HGT_DIM - 1);
+  double v = (1.0 - (coord.second - lat)) * (HGT_DIM - 1);
+
+  // integer pixel
+  size_t x = std::floor(u);
+  size_t y = std::floor(v);
+
+  // coefficients
+  double u_ratio = u - x;
+  double v_ratio = v - y;
+  double u_inv = 1 - u_ratio;
+  double v_inv = 1 - v_ratio;
+  double a_coef = u_inv * v_inv;
+  double b_coef = u_ratio * v_inv;
+  double c_coef = u_inv * v_ratio;
+  double d_coef = u_ratio * v_ratio;
+
+  // values
+  double adjust = 0;
+  auto a = flip(t[y * HGT_DIM + x]);
+  auto b = flip(t[y * HGT_DIM + x + 1]);
+  if (out_of_range(a)) {
+    a_coef = 0;
+  }
+  if (out_of_range(b)) {
+    b_coef = 0;
+  }
+
+  // first part of the bilinear interpolation
+  auto value = a * a_coef + b * b_coef;
+  adjust += a_coef + b_coef;
+  // LOG_INFO('{' + std::to_string(y * HGT_DIM + x) + ',' + std::to_string(a) + '}');
+  // LOG_INFO('{' + std::to_string(y * HGT_DIM + x + 1) + ',' + std::to_string(b) + '}');
+  // only need the second part if you aren't right on the row
+  // this also protects from a corner case where you sample past the end of the image
+  if (y < HGT_DIM - 1) {
+    auto c = flip(t[(y + 1) * HGT_DIM + x]);
+    auto d = flip(t[(y + 1) * HGT_DIM + x + 1]);
+    if (out_of_range(c)) {
+      c_coef = 0;
+    }
+    if (out_of_range(d)) {
+      d_coef = 0;
+    }
+    // LOG_INFO('{' + std::to_string((y + 1) * HGT_DIM + x) + ',' + std::to_string(c) + '}');
+    // LOG_INFO('{' + std::to_string((y + 1) * HGT_DIM + x + 1) + ',' + std::to_string(d) + '}');
+    value += c * c_coef + d * d_coef;
+    adjust += c_coef + d_coef;
+  }
+  // if we are missing everything then give up
+  if (adjust == 0) {
+    return NO_DATA_VALUE;
+  }
+  // if we were missing some we need to adjust by that
+  return value / adjust;
+}
+
 } // namespace
 
 namespace valhalla {
 namespace skadi {
 
-::valhalla::skadi::sample::sample(const std::string& data_source)
-    : mapped_cache(TILE_COUNT), unzipped_cache(-1, std::vector<int16_t>(HGT_PIXELS)),
-      data_source(data_source) {
+constexpr size_t sample::kTileSize;
+constexpr size_t sample::kDefaultCacheSize;
+
+// a thread safe LRU of decompressed tiles with a memory budget
+class sample::tile_cache_t {
+public:
+  tile_cache_t(size_t cache_size) : max_tiles(std::max(cache_size / HGT_BYTES, size_t(1))) {
+  }
+
+  // get the cache for a data source, every sample of the same data source shares one
+  static std::shared_ptr<tile_cache_t> shared(std::string data_source, size_t cache_size) {
+    while (data_source.size() && data_source.back() == filesystem::path::preferred_separator) {
+      data_source.pop_back();
+    }
+    static std::mutex caches_lock;
+    static std::unordered_map<std::string, std::weak_ptr<tile_cache_t>> caches;
+    std::lock_guard<std::mutex> lock(caches_lock);
+    auto& weak = caches[data_source];
+    auto cache = weak.lock();
+    if (!cache) {
+      cache = std::make_shared<tile_cache_t>(cache_size);
+      weak = cache;
+    } else {
+      std::lock_guard<std::mutex> cache_lock(cache->lock);
+      cache->max_tiles = std::max(cache->max_tiles, cache_size / HGT_BYTES);
+    }
+    return cache;
+  }
+
+  // get a tile if its in the cache and mark it as the most recently used
+  tile_t get(uint16_t index) {
+    std::lock_guard<std::mutex> _(lock);
+    auto found = indices.find(index);
+    if (found == indices.cend()) {
+      return nullptr;
+    }
+    tiles.splice(tiles.begin(), tiles, found->second);
+    return found->second->second;
+  }
+
+  // add a tile evicting the least recently used ones if over budget. if another thread
+  // already added the same tile that one is returned instead
+  tile_t put(uint16_t index, tile_t tile) {
+    std::lock_guard<std::mutex> _(lock);
+    auto found = indices.find(index);
+    if (found != indices.cend()) {
+      tiles.splice(tiles.begin(), tiles, found->second);
+      return found->second->second;
+    }
+    tiles.emplace_front(index, std::move(tile));
+    indices.emplace(index, tiles.begin());
+    while (tiles.size() > max_tiles) {
+      indices.erase(tiles.back().first);
+      tiles.pop_back();
+    }
+    return tiles.front().second;
+  }
+
+protected:
+  std::mutex lock;
+  size_t max_tiles;
+  std::list<std::pair<uint16_t, tile_t>> tiles;
+  std::unordered_map<uint16_t, std::list<std::pair<uint16_t, tile_t>>::iterator> indices;
+};
+
+::valhalla::skadi::sample::sample(const std::string& data_source, size_t cache_size)
+    : mapped_cache(TILE_COUNT), mapped_lock(new std::mutex),
+      unzipped_cache(tile_cache_t::shared(data_source, cache_size)), data_source(data_source) {
   // messy but needed
   while (this->data_source.size() &&
          this->data_source.back() == filesystem::path::preferred_separator) {
@@ -133,7 +276,7 @@ namespace skadi {
   }
 }
 
-const int16_t* sample::source(uint16_t index) const {
+const int16_t* sample::source(uint16_t index, tile_t& unzipped) const {
   // bail if its out of bounds
   if (index >= TILE_COUNT) {
     return nullptr;
@@ -141,14 +284,17 @@ const int16_t* sample::source(uint16_t index) const {
 
   // if we dont have anything maybe its lazy loaded
   auto& mapped = mapped_cache[index];
-  if (mapped.second.get() == nullptr) {
-    auto f = data_source + name_hgt(index);
-    auto size = file_size(f);
-    if (size != HGT_BYTES) {
-      return nullptr;
+  {
+    std::lock_guard<std::mutex> lock(*mapped_lock);
+    if (mapped.second.get() == nullptr) {
+      auto f = data_source + name_hgt(index);
+      auto size = file_size(f);
+      if (size != HGT_BYTES) {
+        return nullptr;
+      }
+      mapped.first = format_t::RAW;
+      mapped.second.map(f, size, POSIX_MADV_SEQUENTIAL);
     }
-    mapped.first = format_t::RAW;
-    mapped.second.map(f, size, POSIX_MADV_SEQUENTIAL);
   }
 
   // we have it raw or we dont
@@ -157,8 +303,9 @@ const int16_t* sample::source(uint16_t index) const {
   }
 
   // if we have it already unzipped
-  if (unzipped_cache.first == index) {
-    return unzipped_cache.second.data();
+  unzipped = unzipped_cache->get(index);
+  if (unzipped) {
+    return unzipped->data();
   }
 
   // for setting where to read compressed data from
@@ -168,8 +315,9 @@ const int16_t* sample::source(uint16_t index) const {
   };
 
   // for setting where to write the uncompressed data to
-  auto dst_func = [this](z_stream& s) -> int {
-    s.next_out = static_cast<Byte*>(static_cast<void*>(unzipped_cache.second.data()));
+  auto tile = std::make_shared<std::vector<int16_t>>(HGT_PIXELS);
+  auto dst_func = [&tile](z_stream& s) -> int {
+    s.next_out = static_cast<Byte*>(static_cast<void*>(tile->data()));
     s.avail_out = HGT_BYTES;
     return Z_FINISH; // we know the output will hold all the input
   };
@@ -177,94 +325,52 @@ const int16_t* sample::source(uint16_t index) const {
   // we have to unzip it
   if (!baldr::inflate(src_func, dst_func)) {
     LOG_WARN("Corrupt compressed elevation data");
-    unzipped_cache.first = -1;
     return nullptr;
   }
 
-  // update the simple cache
-  // TODO: LRU
-  unzipped_cache.first = index;
-  return unzipped_cache.second.data();
+  // share it with everyone else
+  unzipped = unzipped_cache->put(index, std::move(tile));
+  return unzipped->data();
 }
 
 template <class coord_t> double sample::get(const coord_t& coord) const {
-  // check the cache and load
-  auto lon = std::floor(coord.first);
-  auto lat = std::floor(coord.second);
-  auto index = static_cast<uint16_t>(lat + 90) * 360 + static_cast<uint16_t>(lon + 180);
-
   // get the proper source of the data
-  const auto* t = source(index);
+  tile_t unzipped;
+  const auto* t = source(tile_index(coord), unzipped);
   if (t == nullptr) {
     return NO_DATA_VALUE;
   }
-
-  // figure out what row and column we need from the array of data
-  // NOTE: data is arranged from upper left to bottom right, so y is flipped
-
-  // fractional pixel
-  double u = (coord.first - lon) * (HGT_DIM - 1);
-  double v = (1.0 - (coord.second - lat)) * (HGT_DIM - 1);
-
-  // integer pixel
-  size_t x = std::floor(u);
-  size_t y = std::floor(v);
-
-  // coefficients
-  double u_ratio = u - x;
-  double v_ratio = v - y;
-  double u_inv = 1 - u_ratio;
-  double v_inv = 1 - v_ratio;
-  double a_coef = u_inv * v_inv;
-  double b_coef = u_ratio * v_inv;
-  double c_coef = u_inv * v_ratio;
-  double d_coef = u_ratio * v_ratio;
-
-  // values
-  double adjust = 0;
-  auto a = flip(t[y * HGT_DIM + x]);
-  auto b = flip(t[y * HGT_DIM + x + 1]);
-  if (out_of_range(a)) {
-    a_coef = 0;
-  }
-  if (out_of_range(b)) {
-    b_coef = 0;
-  }
-
-  // first part of the bilinear interpolation
-  auto value = a * a_coef + b * b_coef;
-  adjust += a_coef + b_coef;
-  // LOG_INFO('{' + std::to_string(y * HGT_DIM + x) + ',' + std::to_string(a) + '}');
-  // LOG_INFO('{' + std::to_string(y * HGT_DIM + x + 1) + ',' + std::to_string(b) + '}');
-  // only need the second part if you aren't right on the row
-  // this also protects from a corner case where you sample past the end of the image
-  if (y < HGT_DIM - 1) {
-    auto c = flip(t[(y + 1) * HGT_DIM + x]);
-    auto d = flip(t[(y + 1) * HGT_DIM + x + 1]);
-    if (out_of_range(c)) {
-      c_coef = 0;
-    }
-    if (out_of_range(d)) {
-      d_coef = 0;
-    }
-    // LOG_INFO('{' + std::to_string((y + 1) * HGT_DIM + x) + ',' + std::to_string(c) + '}');
-    // LOG_INFO('{' + std::to_string((y + 1) * HGT_DIM + x + 1) + ',' + std::to_string(d) + '}');
-    value += c * c_coef + d * d_coef;
-    adjust += c_coef + d_coef;
-  }
-  // if we are missing everything then give up
-  if (adjust == 0) {
-    return NO_DATA_VALUE;
-  }
-  // if we were missing some we need to adjust by that
-  return value / adjust;
+  return interpolate(t, coord);
 }
 
 template <class coords_t> std::vector<double> sample::get_all(const coords_t& coords) const {
-  std::vector<double> values;
-  values.reserve(coords.size());
+  // remember which tile each posting is in and where it came from in the input
+  std::vector<const typename coords_t::value_type*> postings;
+  std::vector<std::pair<uint32_t, uint32_t>> order;
+  postings.reserve(coords.size());
+  order.reserve(coords.size());
   for (const auto& coord : coords) {
-    values.emplace_back(get(coord));
+    order.emplace_back(tile_index(coord), static_cast<uint32_t>(postings.size()));
+    postings.push_back(&coord);
+  }
+
+  // group the postings by tile so we only have to get each tile once
+  std::sort(order.begin(), order.end());
+
+  // sample each tile's postings in one go and write them back in the original order
+  std::vector<double> values(postings.size(), NO_DATA_VALUE);
+  tile_t unzipped;
+  for (auto group = order.cbegin(); group != order.cend();) {
+    auto next = std::find_if(group, order.cend(), [&group](const std::pair<uint32_t, uint32_t>& o) {
+      return o.first != group->first;
+    });
+    const auto* t = source(group->first, unzipped);
+    if (t != nullptr) {
+      for (; group != next; ++group) {
+        values[group->second] = interpolate(t, *postings[group->second]);
+      }
+    }
+    group = next;
   }
   return values;
 }
@@ -33,15 +33,35 @@ AStarPathAlgorithm::~AStarPathAlgorithm() {
 
 // Clear the temporary information generated during path construction.
 void AStarPathAlgorithm::Clear() {
-  // Clear the edge labels and destination list. Reset the adjacency list
-  // and clear edge status.
-  edgelabels_.clear();
+  ClearWorkingMemory(0, !edgelabels_.empty());
+}
+
+// Clear the temporary information, keeping the memory for the next search
+// unless it is above the high-water mark
+bool AStarPathAlgorithm::ClearWorkingMemory(const size_t reserved, const bool searched) {
+  const bool release =
+      working_memory_.Reserved(reserved + WorkingMemory::Bytes(edgelabels_) +
+                                   edgestatus_.reserved() +
+                                   (adjacencylist_ ? adjacencylist_->reserved() : 0),
+                               searched);
+
+  // Clear the edge labels and destination list. Clear the adjacency list
+  // and edge status.
+  WorkingMemory::Clear(edgelabels_, release);
   destinations_percent_along_.clear();
-  adjacencylist_.reset();
-  edgestatus_.clear();
+  if (release) {
+    adjacencylist_.reset();
+    edgestatus_.release();
+  } else {
+    if (adjacencylist_) {
+      adjacencylist_->clear();
+    }
+    edgestatus_.clear();
+  }
 
   // Set the ferry flag to false
   has_ferry_ = false;
+  return release;
 }
 
 // Initialize prior to finding best path
@@ -63,11 +83,15 @@ void AStarPathAlgorithm::Init(const midgard::PointLL& origll, const midgard::Poi
   // Set up lambda to get sort costs
   const auto edgecost = [this](const uint32_t label) { return edgelabels_[label].sortcost(); };
 
-  // Construct adjacency list, clear edge status.
+  // Construct (or reuse) adjacency list, clear edge status.
   // Set bucket size and cost range based on DynamicCost.
   uint32_t bucketsize = costing_->UnitSize();
   float range = kBucketCount * bucketsize;
-  adjacencylist_.reset(new DoubleBucketQueue(mincost, range, bucketsize, edgecost));
+  if (adjacencylist_) {
+    adjacencylist_->reuse(mincost, range, bucketsize, edgecost);
+  } else {
+    adjacencylist_.reset(new DoubleBucketQueue(mincost, range, bucketsize, edgecost));
+  }
   edgestatus_.clear();
 
   // Get hierarchy limits from the costing. Get a copy since we increment
@@ -107,7 +131,9 @@ void AStarPathAlgorithm::ModifyHierarchyLimits(const float dist, const uint32_t
 // from the end node of any transition edge (so no transition edges are added
 // to the adjacency list or EdgeLabel list). Does not expand transition
 // edges if from_transition is false.
-void AStarPathAlgorithm::ExpandForward(GraphReader& graphreader,
+template <class costing_t>
+void AStarPathAlgorithm::ExpandForward(const DirectCost<costing_t>& costing,
+                                       GraphReader& graphreader,
                                        const GraphId& node,
                                        const EdgeLabel& pred,
                                        const uint32_t pred_idx,
@@ -121,7 +147,7 @@ void AStarPathAlgorithm::ExpandForward(GraphReader& graphreader,
     return;
   }
   const NodeInfo* nodeinfo = tile->node(node);
-  if (!costing_->Allowed(nodeinfo)) {
+  if (!costing.Allowed(nodeinfo)) {
     return;
   }
 
@@ -155,14 +181,14 @@ void AStarPathAlgorithm::ExpandForward(GraphReader& graphreader,
     // or if a complex restriction exists.
     bool has_time_restrictions = false;
     if (es->set() == EdgeSet::kPermanent ||
-        !costing_->Allowed(directededge, pred, tile, edgeid, 0, 0, has_time_restrictions) ||
+        !costing.Allowed(directededge, pred, tile, edgeid, 0, 0, has_time_restrictions) ||
         costing_->Restricted(directededge, pred, edgelabels_, tile, edgeid, true, &edgestatus_)) {
       continue;
     }
 
     // Compute the cost to the end of this edge
-    auto edge_cost = costing_->EdgeCost(directededge, tile);
-    auto transition_cost = costing_->TransitionCost(directededge, nodeinfo, pred);
+    auto edge_cost = costing.EdgeCost(directededge, tile);
+    auto transition_cost = costing.TransitionCost(directededge, nodeinfo, pred);
     Cost newcost = pred.cost() + edge_cost + transition_cost;
 
     // If this edge is a destination, subtract the partial/remainder cost
@@ -232,9 +258,11 @@ void AStarPathAlgorithm::ExpandForward(GraphReader& graphreader,
     for (uint32_t i = 0; i < nodeinfo->transition_count(); ++i, ++trans) {
       if (trans->up()) {
         hierarchy_limits_[node.level()].up_transition_count++;
-        ExpandForward(graphreader, trans->endnode(), pred, pred_idx, true, destination, best_path);
+        ExpandForward(costing, graphreader, trans->endnode(), pred, pred_idx, true, destination,
+                      best_path);
       } else if (!hierarchy_limits_[trans->endnode().level()].StopExpanding(pred.distance())) {
-        ExpandForward(graphreader, trans->endnode(), pred, pred_idx, true, destination, best_path);
+        ExpandForward(costing, graphreader, trans->endnode(), pred, pred_idx, true, destination,
+                      best_path);
       }
     }
   }
@@ -271,6 +299,21 @@ AStarPathAlgorithm::GetBestPath(valhalla::Location& origin,
   // Update hierarchy limits
   ModifyHierarchyLimits(mindist, density);
 
+  // Find shortest path using the concrete type of the costing
+  return visit_costing(*costing_, [&](const auto& costing) {
+    return Expand(costing, graphreader, origin, destination, mindist);
+  });
+}
+
+// Run the search with the costing of the request. The per edge costing calls
+// of the expansion are bound to the concrete costing type.
+template <class costing_t>
+std::vector<std::vector<PathInfo>>
+AStarPathAlgorithm::Expand(const DirectCost<costing_t>& costing,
+                           GraphReader& graphreader,
+                           valhalla::Location& origin,
+                           const valhalla::Location& destination,
+                           float mindist) {
   // Find shortest path
   uint32_t nc = 0; // Count of iterations with no convergence
                    // towards destination
@@ -341,7 +384,8 @@ AStarPathAlgorithm::GetBestPath(valhalla::Location& origin,
     }
 
     // Expand forward from the end node of the predecessor edge.
-    ExpandForward(graphreader, pred.endnode(), pred, predindex, false, destination, best_path);
+    ExpandForward(costing, graphreader, pred.endnode(), pred, predindex, false, destination,
+                  best_path);
   }
   return {}; // Should never get here
 }
@@ -63,6 +63,7 @@ const std::unordered_map<std::string, bool> AttributesController::kDefaultAttrib
     {kEdgeMeanElevation, true},
     {kEdgeLaneCount, true},
     {kEdgeLaneConnectivity, true},
+    {kEdgeTurnLanes, true},
     {kEdgeCycleLane, true},
     {kEdgeBicycleNetwork, true},
     {kEdgeSidewalk, true},
@@ -148,5 +149,74 @@ bool AttributesController::category_attribute_enabled(const std::string& categor
   return false;
 }
 
+FieldPlan::FieldPlan(const AttributesController& controller)
+    : controller(controller), edge_signs(controller.category_attribute_enabled(kEdgeSignCategory)),
+      intersecting_edges(controller.category_attribute_enabled(kNodeIntersectingEdgeCategory)),
+      admins(controller.category_attribute_enabled(kAdminCategory)),
+      shape_attributes(controller.category_attribute_enabled(kShapeAttributesCategory)) {
+  const auto& attributes = controller.attributes;
+  edge_names = attributes.at(kEdgeNames);
+  edge_length = attributes.at(kEdgeLength);
+  edge_speed = attributes.at(kEdgeSpeed);
+  edge_road_class = attributes.at(kEdgeRoadClass);
+  edge_begin_heading = attributes.at(kEdgeBeginHeading);
+  edge_end_heading = attributes.at(kEdgeEndHeading);
+  edge_headings = edge_begin_heading || edge_end_heading;
+  edge_begin_shape_index = attributes.at(kEdgeBeginShapeIndex);
+  edge_end_shape_index = attributes.at(kEdgeEndShapeIndex);
+  edge_traversability = attributes.at(kEdgeTraversability);
+  edge_use = attributes.at(kEdgeUse);
+  edge_toll = attributes.at(kEdgeToll);
+  edge_unpaved = attributes.at(kEdgeUnpaved);
+  edge_tunnel = attributes.at(kEdgeTunnel);
+  edge_bridge = attributes.at(kEdgeBridge);
+  edge_roundabout = attributes.at(kEdgeRoundabout);
+  edge_internal_intersection = attributes.at(kEdgeInternalIntersection);
+  edge_drive_on_right = attributes.at(kEdgeDriveOnRight);
+  edge_surface = attributes.at(kEdgeSurface);
+  edge_travel_mode = attributes.at(kEdgeTravelMode);
+  edge_vehicle_type = attributes.at(kEdgeVehicleType);
+  edge_pedestrian_type = attributes.at(kEdgePedestrianType);
+  edge_bicycle_type = attributes.at(kEdgeBicycleType);
+  edge_id = attributes.at(kEdgeId);
+  edge_way_id = attributes.at(kEdgeWayId);
+  edge_weighted_grade = attributes.at(kEdgeWeightedGrade);
+  edge_max_upward_grade = attributes.at(kEdgeMaxUpwardGrade);
+  edge_max_downward_grade = attributes.at(kEdgeMaxDownwardGrade);
+  edge_mean_elevation = attributes.at(kEdgeMeanElevation);
+  edge_lane_count = attributes.at(kEdgeLaneCount);
+  edge_lane_connectivity = attributes.at(kEdgeLaneConnectivity);
+  edge_turn_lanes = attributes.at(kEdgeTurnLanes);
+  edge_cycle_lane = attributes.at(kEdgeCycleLane);
+  edge_bicycle_network = attributes.at(kEdgeBicycleNetwork);
+  edge_sidewalk = attributes.at(kEdgeSidewalk);
+  edge_density = attributes.at(kEdgeDensity);
+  edge_speed_limit = attributes.at(kEdgeSpeedLimit);
+  edge_default_speed = attributes.at(kEdgeDefaultSpeed);
+  edge_truck_speed = attributes.at(kEdgeTruckSpeed);
+  edge_truck_route = attributes.at(kEdgeTruckRoute);
+
+  intersecting_edge_begin_heading = attributes.at(kNodeIntersectingEdgeBeginHeading);
+  intersecting_edge_from_edge_name_consistency =
+      attributes.at(kNodeIntersectingEdgeFromEdgeNameConsistency);
+  intersecting_edge_to_edge_name_consistency =
+      attributes.at(kNodeIntersectingEdgeToEdgeNameConsistency);
+  intersecting_edge_driveability = attributes.at(kNodeIntersectingEdgeDriveability);
+  intersecting_edge_cyclability = attributes.at(kNodeIntersectingEdgeCyclability);
+  intersecting_edge_walkability = attributes.at(kNodeIntersectingEdgeWalkability);
+  intersecting_edge_use = attributes.at(kNodeIntersectingEdgeUse);
+  intersecting_edge_road_class = attributes.at(kNodeIntersectingEdgeRoadClass);
+
+  node_elapsed_time = attributes.at(kNodeElapsedTime);
+  node_admin_index = attributes.at(kNodeaAdminIndex);
+  node_type = attributes.at(kNodeType);
+  node_fork = attributes.at(kNodeFork);
+  node_time_zone = attributes.at(kNodeTimeZone);
+  node_transition_time = attributes.at(kNodeTransitionTime);
+
+  osm_changeset = attributes.at(kOsmChangeset);
+  shape = attributes.at(kShape);
+}
+
 } // namespace thor
 } // namespace valhalla
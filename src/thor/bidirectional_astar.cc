@@ -25,6 +25,23 @@ constexpr uint64_t kInitialEdgeLabelCountBD = 1000000;
 // cost creates large performance drops - so perhaps some other metric can be found?
 constexpr float kThresholdDelta = 420.0f;
 
+// When looking for alternates the search continues until this factor times the
+// cost of the first connection and alternates can cost up to this factor times
+// the cost of the best path
+constexpr float kAlternativeCostExtend = 1.2f;
+
+// Maximum part of the length of an alternate shared with any better path
+constexpr float kAlternativeMaxShareRatio = 0.5f;
+
+// Maximum number of candidate connections whose paths are checked as alternates
+constexpr uint32_t kMaxAlternateCandidates = 64;
+
+// Threshold to extend the search to once the first connection has been found
+float GetThreshold(const float sortcost, const uint32_t desired_paths_count) {
+  return (desired_paths_count > 1 ? sortcost * kAlternativeCostExtend : sortcost) +
+         kThresholdDelta;
+}
+
 } // namespace
 
 namespace valhalla {
@@ -33,6 +50,7 @@ namespace thor {
 // Default constructor
 BidirectionalAStar::BidirectionalAStar() : PathAlgorithm() {
   threshold_ = 0;
+  desired_paths_count_ = 1;
   mode_ = TravelMode::kDrive;
   access_mode_ = kAutoAccess;
   travel_type_ = 0;
@@ -48,12 +66,32 @@ BidirectionalAStar::~BidirectionalAStar() {
 
 // Clear the temporary information generated during path construction.
 void BidirectionalAStar::Clear() {
-  edgelabels_forward_.clear();
-  edgelabels_reverse_.clear();
-  adjacencylist_forward_.reset();
-  adjacencylist_reverse_.reset();
-  edgestatus_forward_.clear();
-  edgestatus_reverse_.clear();
+  // Keep the memory for the next search unless it is above the high-water mark
+  const bool release = working_memory_.Reserved(
+      WorkingMemory::Bytes(edgelabels_forward_) + WorkingMemory::Bytes(edgelabels_reverse_) +
+      edgestatus_forward_.reserved() + edgestatus_reverse_.reserved() +
+      (adjacencylist_forward_ ? adjacencylist_forward_->reserved() : 0) +
+      (adjacencylist_reverse_ ? adjacencylist_reverse_->reserved() : 0),
+      !edgelabels_forward_.empty() || !edgelabels_reverse_.empty());
+
+  WorkingMemory::Clear(edgelabels_forward_, release);
+  WorkingMemory::Clear(edgelabels_reverse_, release);
+  if (release) {
+    adjacencylist_forward_.reset();
+    adjacencylist_reverse_.reset();
+    edgestatus_forward_.release();
+    edgestatus_reverse_.release();
+  } else {
+    if (adjacencylist_forward_) {
+      adjacencylist_forward_->clear();
+    }
+    if (adjacencylist_reverse_) {
+      adjacencylist_reverse_->clear();
+    }
+    edgestatus_forward_.clear();
+    edgestatus_reverse_.clear();
+  }
+  candidates_.clear();
 
   // Set the ferry flag to false
   has_ferry_ = false;
@@ -80,14 +118,21 @@ void BidirectionalAStar::Init(const PointLL& origll, const PointLL& destll) {
     return edgelabels_reverse_[label].sortcost();
   };
 
-  // Construct adjacency list and initialize edge status lookup.
+  // Construct (or reuse) adjacency list and initialize edge status lookup.
   // Set bucket size and cost range based on DynamicCost.
   uint32_t bucketsize = costing_->UnitSize();
   float range = kBucketCount * bucketsize;
   float mincostf = astarheuristic_forward_.Get(origll);
-  adjacencylist_forward_.reset(new DoubleBucketQueue(mincostf, range, bucketsize, forward_edgecost));
   float mincostr = astarheuristic_reverse_.Get(destll);
-  adjacencylist_reverse_.reset(new DoubleBucketQueue(mincostr, range, bucketsize, reverse_edgecost));
+  if (adjacencylist_forward_ && adjacencylist_reverse_) {
+    adjacencylist_forward_->reuse(mincostf, range, bucketsize, forward_edgecost);
+    adjacencylist_reverse_->reuse(mincostr, range, bucketsize, reverse_edgecost);
+  } else {
+    adjacencylist_forward_.reset(
+        new DoubleBucketQueue(mincostf, range, bucketsize, forward_edgecost));
+    adjacencylist_reverse_.reset(
+        new DoubleBucketQueue(mincostr, range, bucketsize, reverse_edgecost));
+  }
   edgestatus_forward_.clear();
   edgestatus_reverse_.clear();
 
@@ -98,6 +143,7 @@ void BidirectionalAStar::Init(const PointLL& origll, const PointLL& destll) {
 
   // Initialize best connection with max cost
   best_connection_ = {GraphId(), GraphId(), std::numeric_limits<float>::max()};
+  candidates_.clear();
 
   // Set the cost threshold to the maximum float value. Once the initial connection is found
   // the threshold is set.
@@ -109,7 +155,9 @@ void BidirectionalAStar::Init(const PointLL& origll, const PointLL& destll) {
 }
 
 // Returns true if function ended up adding an edge for expansion
-bool BidirectionalAStar::ExpandForward(GraphReader& graphreader,
+template <class costing_t>
+bool BidirectionalAStar::ExpandForward(const DirectCost<costing_t>& costing,
+                                       GraphReader& graphreader,
                                        const GraphId& node,
                                        BDEdgeLabel& pred,
                                        const uint32_t pred_idx,
@@ -121,7 +169,7 @@ bool BidirectionalAStar::ExpandForward(GraphReader& graphreader,
     return false;
   }
   const NodeInfo* nodeinfo = tile->node(node);
-  if (!costing_->Allowed(nodeinfo)) {
+  if (!costing.Allowed(nodeinfo)) {
     return false;
   }
 
@@ -146,7 +194,7 @@ bool BidirectionalAStar::ExpandForward(GraphReader& graphreader,
     }
 
     found_valid_edge =
-        ExpandForwardInner(graphreader, pred, nodeinfo, pred_idx, meta, shortcuts, tile) ||
+        ExpandForwardInner(costing, graphreader, pred, nodeinfo, pred_idx, meta, shortcuts, tile) ||
         found_valid_edge;
   }
 
@@ -157,10 +205,12 @@ bool BidirectionalAStar::ExpandForward(GraphReader& graphreader,
       if (trans->up()) {
         hierarchy_limits_forward_[node.level()].up_transition_count++;
         found_valid_edge =
-            ExpandForward(graphreader, trans->endnode(), pred, pred_idx, true) || found_valid_edge;
+            ExpandForward(costing, graphreader, trans->endnode(), pred, pred_idx, true) ||
+            found_valid_edge;
       } else if (!hierarchy_limits_forward_[trans->endnode().level()].StopExpanding()) {
         found_valid_edge =
-            ExpandForward(graphreader, trans->endnode(), pred, pred_idx, true) || found_valid_edge;
+            ExpandForward(costing, graphreader, trans->endnode(), pred, pred_idx, true) ||
+            found_valid_edge;
       }
     }
   }
@@ -184,8 +234,8 @@ bool BidirectionalAStar::ExpandForward(GraphReader& graphreader,
         found_valid_edge = true;
       } else {
         // We didn't add any shortcut of the uturn, therefore evaluate the regular uturn instead
-        bool uturn_added =
-            ExpandForwardInner(graphreader, pred, nodeinfo, pred_idx, uturn_meta, shortcuts, tile);
+        bool uturn_added = ExpandForwardInner(costing, graphreader, pred, nodeinfo, pred_idx,
+                                              uturn_meta, shortcuts, tile);
         found_valid_edge = found_valid_edge || uturn_added;
       }
     }
@@ -200,7 +250,9 @@ bool BidirectionalAStar::ExpandForward(GraphReader& graphreader,
 // TODO: Merge this with ExpandReverseInner
 //
 // Returns true if any edge _could_ have been expanded after restrictions etc.
-inline bool BidirectionalAStar::ExpandForwardInner(GraphReader& graphreader,
+template <class costing_t>
+inline bool BidirectionalAStar::ExpandForwardInner(const DirectCost<costing_t>& costing,
+                                                   GraphReader& graphreader,
                                                    const BDEdgeLabel& pred,
                                                    const NodeInfo* nodeinfo,
                                                    const uint32_t pred_idx,
@@ -231,17 +283,17 @@ inline bool BidirectionalAStar::ExpandForwardInner(GraphReader& graphreader,
   const uint64_t localtime = 0; // Bidirectional is not yet time-aware
   const uint32_t tz_index = 0;
   bool has_time_restrictions = false;
-  if (!costing_->Allowed(meta.edge, pred, tile, meta.edge_id, localtime, tz_index,
-                         has_time_restrictions) ||
+  if (!costing.Allowed(meta.edge, pred, tile, meta.edge_id, localtime, tz_index,
+                       has_time_restrictions) ||
       costing_->Restricted(meta.edge, pred, edgelabels_forward_, tile, meta.edge_id, true,
                            &edgestatus_forward_, localtime, tz_index)) {
     return false;
   }
 
   // Get cost. Separate out transition cost.
-  Cost transition_cost = costing_->TransitionCost(meta.edge, nodeinfo, pred);
+  Cost transition_cost = costing.TransitionCost(meta.edge, nodeinfo, pred);
   Cost newcost = pred.cost() + transition_cost +
-                 costing_->EdgeCost(meta.edge, tile, kConstrainedFlowSecondOfDay);
+                 costing.EdgeCost(meta.edge, tile, kConstrainedFlowSecondOfDay);
 
   // Check if edge is temporarily labeled and this path has less cost. If
   // less cost the predecessor is updated and the sort cost is decremented
@@ -290,7 +342,9 @@ inline bool BidirectionalAStar::ExpandForwardInner(GraphReader& graphreader,
 // Expand from a node in reverse direction.
 //
 // Returns true if function ended up adding an edge for expansion
-bool BidirectionalAStar::ExpandReverse(GraphReader& graphreader,
+template <class costing_t>
+bool BidirectionalAStar::ExpandReverse(const DirectCost<costing_t>& costing,
+                                       GraphReader& graphreader,
                                        const GraphId& node,
                                        BDEdgeLabel& pred,
                                        const uint32_t pred_idx,
@@ -303,7 +357,7 @@ bool BidirectionalAStar::ExpandReverse(GraphReader& graphreader,
     return false;
   }
   const NodeInfo* nodeinfo = tile->node(node);
-  if (!costing_->Allowed(nodeinfo)) {
+  if (!costing.Allowed(nodeinfo)) {
     return false;
   }
 
@@ -327,8 +381,8 @@ bool BidirectionalAStar::ExpandReverse(GraphReader& graphreader,
       continue;
     }
 
-    edge_was_added = ExpandReverseInner(graphreader, pred, opp_pred_edge, nodeinfo, pred_idx, meta,
-                                        shortcuts, tile) ||
+    edge_was_added = ExpandReverseInner(costing, graphreader, pred, opp_pred_edge, nodeinfo,
+                                        pred_idx, meta, shortcuts, tile) ||
                      edge_was_added;
   }
 
@@ -338,13 +392,13 @@ bool BidirectionalAStar::ExpandReverse(GraphReader& graphreader,
     for (uint32_t i = 0; i < nodeinfo->transition_count(); ++i, ++trans) {
       if (trans->up()) {
         hierarchy_limits_reverse_[node.level()].up_transition_count++;
-        edge_was_added =
-            ExpandReverse(graphreader, trans->endnode(), pred, pred_idx, opp_pred_edge, true) ||
-            edge_was_added;
+        edge_was_added = ExpandReverse(costing, graphreader, trans->endnode(), pred, pred_idx,
+                                       opp_pred_edge, true) ||
+                         edge_was_added;
       } else if (!hierarchy_limits_reverse_[trans->endnode().level()].StopExpanding()) {
-        edge_was_added =
-            ExpandReverse(graphreader, trans->endnode(), pred, pred_idx, opp_pred_edge, true) ||
-            edge_was_added;
+        edge_was_added = ExpandReverse(costing, graphreader, trans->endnode(), pred, pred_idx,
+                                       opp_pred_edge, true) ||
+                         edge_was_added;
       }
     }
   }
@@ -368,8 +422,8 @@ bool BidirectionalAStar::ExpandReverse(GraphReader& graphreader,
         edge_was_added = true;
       } else {
         // We didn't add any shortcut of the uturn, therefore evaluate the regular uturn instead
-        edge_was_added = ExpandReverseInner(graphreader, pred, opp_pred_edge, nodeinfo, pred_idx,
-                                            uturn_meta, shortcuts, tile) ||
+        edge_was_added = ExpandReverseInner(costing, graphreader, pred, opp_pred_edge, nodeinfo,
+                                            pred_idx, uturn_meta, shortcuts, tile) ||
                          edge_was_added;
       }
     }
@@ -383,7 +437,9 @@ bool BidirectionalAStar::ExpandReverse(GraphReader& graphreader,
 // TODO: Merge this with ExpandForwardInner
 //
 // Returns true if any edge _could_ have been expanded after restrictions etc.
-inline bool BidirectionalAStar::ExpandReverseInner(GraphReader& graphreader,
+template <class costing_t>
+inline bool BidirectionalAStar::ExpandReverseInner(const DirectCost<costing_t>& costing,
+                                                   GraphReader& graphreader,
                                                    const BDEdgeLabel& pred,
                                                    const DirectedEdge* opp_pred_edge,
                                                    const NodeInfo* nodeinfo,
@@ -430,8 +486,8 @@ inline bool BidirectionalAStar::ExpandReverseInner(GraphReader& graphreader,
   const uint64_t localtime = 0; // Bidirectional is not yet time-aware
   const uint32_t tz_index = 0;
   bool has_time_restrictions = false;
-  if (!costing_->AllowedReverse(meta.edge, pred, opp_edge, t2, opp_edge_id, localtime, tz_index,
-                                has_time_restrictions) ||
+  if (!costing.AllowedReverse(meta.edge, pred, opp_edge, t2, opp_edge_id, localtime, tz_index,
+                              has_time_restrictions) ||
       costing_->Restricted(meta.edge, pred, edgelabels_reverse_, tile, meta.edge_id, false,
                            &edgestatus_reverse_, localtime, tz_index)) {
     return false;
@@ -440,8 +496,8 @@ inline bool BidirectionalAStar::ExpandReverseInner(GraphReader& graphreader,
   // Get cost. Use opposing edge for EdgeCost. Separate the transition seconds so we
   // can properly recover elapsed time on the reverse path.
   Cost transition_cost =
-      costing_->TransitionCostReverse(meta.edge->localedgeidx(), nodeinfo, opp_edge, opp_pred_edge);
-  Cost newcost = pred.cost() + costing_->EdgeCost(opp_edge, t2, kConstrainedFlowSecondOfDay);
+      costing.TransitionCostReverse(meta.edge->localedgeidx(), nodeinfo, opp_edge, opp_pred_edge);
+  Cost newcost = pred.cost() + costing.EdgeCost(opp_edge, t2, kConstrainedFlowSecondOfDay);
   newcost.cost += transition_cost.cost;
 
   // Check if edge is temporarily labeled and this path has less cost. If
@@ -494,6 +550,7 @@ BidirectionalAStar::GetBestPath(valhalla::Location& origin,
   costing_ = mode_costing[static_cast<uint32_t>(mode_)];
   travel_type_ = costing_->travel_type();
   access_mode_ = costing_->access_mode();
+  desired_paths_count_ = 1 + options.alternates();
 
   // Initialize - create adjacency list, edgestatus support, A*, etc.
   PointLL origin_new(origin.path_edges(0).ll().lng(), origin.path_edges(0).ll().lat());
@@ -508,6 +565,19 @@ BidirectionalAStar::GetBestPath(valhalla::Location& origin,
   SetOrigin(graphreader, origin);
   SetDestination(graphreader, destination);
 
+  // Find shortest path using the concrete type of the costing
+  return visit_costing(*costing_, [&](const auto& costing) {
+    return Expand(costing, graphreader, options);
+  });
+}
+
+// Run the search with the costing of the request. The per edge costing calls
+// of the expansions are bound to the concrete costing type.
+template <class costing_t>
+std::vector<std::vector<PathInfo>>
+BidirectionalAStar::Expand(const DirectCost<costing_t>& costing,
+                           GraphReader& graphreader,
+                           const Options& options) {
   // Find shortest path. Switch between a forward direction and a reverse
   // direction search based on the current costs. Alternating like this
   // prevents one tree from expanding much more quickly (if in a sparser
@@ -608,7 +678,7 @@ BidirectionalAStar::GetBestPath(valhalla::Location& origin,
       }
 
       // Expand from the end node in forward direction.
-      ExpandForward(graphreader, fwd_pred.endnode(), fwd_pred, forward_pred_idx, false);
+      ExpandForward(costing, graphreader, fwd_pred.endnode(), fwd_pred, forward_pred_idx, false);
     } else {
       // Expand reverse - set to get next edge from reverse adj. list on the next pass
       expand_forward = false;
@@ -634,8 +704,8 @@ BidirectionalAStar::GetBestPath(valhalla::Location& origin,
           graphreader.GetGraphTile(rev_pred.opp_edgeid())->directededge(rev_pred.opp_edgeid());
 
       // Expand from the end node in reverse direction.
-      ExpandReverse(graphreader, rev_pred.endnode(), rev_pred, reverse_pred_idx, opp_pred_edge,
-                    false);
+      ExpandReverse(costing, graphreader, rev_pred.endnode(), rev_pred, reverse_pred_idx,
+                    opp_pred_edge, false);
     }
   }
   return {}; // If we are here the route failed
@@ -682,9 +752,14 @@ bool BidirectionalAStar::SetForwardConnection(GraphReader& graphreader, const BD
     best_connection_ = {pred.edgeid(), oppedge, c};
   }
 
+  // Keep the connection as a candidate alternate
+  if (desired_paths_count_ > 1) {
+    candidates_.push_back({pred.edgeid(), oppedge, c});
+  }
+
   // Set a threshold to extend search
   if (threshold_ == std::numeric_limits<float>::max()) {
-    threshold_ = pred.sortcost() + cost_diff_ + kThresholdDelta;
+    threshold_ = GetThreshold(pred.sortcost() + cost_diff_, desired_paths_count_);
   }
 
   // setting this edge as connected
@@ -735,9 +810,14 @@ bool BidirectionalAStar::SetReverseConnection(GraphReader& graphreader, const BD
     best_connection_ = {fwd_edge_id, rev_pred.edgeid(), c};
   }
 
+  // Keep the connection as a candidate alternate
+  if (desired_paths_count_ > 1) {
+    candidates_.push_back({fwd_edge_id, rev_pred.edgeid(), c});
+  }
+
   // Set a threshold to extend search
   if (threshold_ == std::numeric_limits<float>::max()) {
-    threshold_ = rev_pred.sortcost() + kThresholdDelta;
+    threshold_ = GetThreshold(rev_pred.sortcost(), desired_paths_count_);
   }
 
   // setting this edge as connected, sending the opposing because this is the reverse tree
@@ -898,23 +978,114 @@ void BidirectionalAStar::SetDestination(GraphReader& graphreader, const valhalla
   }
 }
 
-// Form the path from the adjacency list.
+// Form the path from the adjacency list. Alternates are formed from the other
+// connections between the search trees, cheapest first.
 std::vector<std::vector<PathInfo>> BidirectionalAStar::FormPath(GraphReader& graphreader,
                                                                 const valhalla::Options&) {
-  // Get the indexes where the connection occurs.
-  uint32_t idx1 = edgestatus_forward_.Get(best_connection_.edgeid).index();
-  uint32_t idx2 = edgestatus_reverse_.Get(best_connection_.opp_edgeid).index();
-
   // Metrics (TODO - more accurate cost)
-  uint32_t pathcost = edgelabels_forward_[idx1].cost().cost + edgelabels_reverse_[idx2].cost().cost;
-  LOG_DEBUG("path_cost::" + std::to_string(pathcost));
+  LOG_DEBUG("path_cost::" + std::to_string(best_connection_.cost));
   LOG_DEBUG("FormPath path_iterations::" + std::to_string(edgelabels_forward_.size()) + "," +
             std::to_string(edgelabels_reverse_.size()));
 
-  // Work backwards on the forward path
   std::vector<std::vector<PathInfo>> paths;
-  paths.emplace_back();
-  std::vector<PathInfo>& path = paths.back();
+  paths.emplace_back(FormPath(best_connection_));
+  if (desired_paths_count_ == 1) {
+    return paths;
+  }
+
+  // Edges of each path for the overlap checks
+  std::vector<std::unordered_set<GraphId>> path_edges(1);
+  for (const auto& p : paths.back()) {
+    path_edges.back().insert(p.edgeid);
+  }
+
+  // Both searches can find the same connection so only try each connecting edge once
+  std::sort(candidates_.begin(), candidates_.end());
+  std::unordered_set<GraphId> tried;
+  uint32_t checked = 0;
+  const float max_cost = best_connection_.cost * kAlternativeCostExtend;
+  for (const auto& candidate : candidates_) {
+    if (paths.size() == desired_paths_count_ || checked == kMaxAlternateCandidates ||
+        candidate.cost > max_cost) {
+      break;
+    }
+
+    // A connection on one of the paths gives that path again
+    if (!tried.insert(candidate.edgeid).second ||
+        std::any_of(path_edges.begin(), path_edges.end(),
+                    [&candidate](const std::unordered_set<GraphId>& edges) {
+                      return edges.count(candidate.edgeid) > 0;
+                    })) {
+      continue;
+    }
+
+    // Labels can have improved since the connection was found so check the cost
+    // of the path again
+    ++checked;
+    auto path = FormPath(candidate);
+    if (path.empty() || path.back().elapsed_cost > max_cost ||
+        !IsValidAlternate(graphreader, path, path_edges)) {
+      continue;
+    }
+    path_edges.emplace_back();
+    for (const auto& p : path) {
+      path_edges.back().insert(p.edgeid);
+    }
+    paths.emplace_back(std::move(path));
+  }
+  LOG_DEBUG("FormPath alternates::" + std::to_string(paths.size() - 1) + " of " +
+            std::to_string(candidates_.size()) + " connections");
+  return paths;
+}
+
+// Check if the path through a connection is a good alternate to the paths so far
+bool BidirectionalAStar::IsValidAlternate(
+    GraphReader& graphreader,
+    const std::vector<PathInfo>& path,
+    const std::vector<std::unordered_set<GraphId>>& path_edges) {
+  // The trees are shortest paths from the origin and to the destination so the
+  // path can only be a poor one around the connection. Reject the path if it goes
+  // out and back along the same edges there.
+  std::unordered_set<GraphId> edges;
+  const GraphTile* tile = nullptr;
+  for (const auto& p : path) {
+    if (!edges.insert(p.edgeid).second) {
+      return false;
+    }
+    GraphId opp_edgeid = graphreader.GetOpposingEdgeId(p.edgeid, tile);
+    if (opp_edgeid.Is_Valid() && edges.count(opp_edgeid) > 0) {
+      return false;
+    }
+  }
+
+  // Get the length of the path and how much of it each of the other paths shares
+  float length = 0.0f;
+  std::vector<float> shared(path_edges.size(), 0.0f);
+  for (const auto& p : path) {
+    const DirectedEdge* edge = graphreader.directededge(p.edgeid, tile);
+    if (edge == nullptr) {
+      return false;
+    }
+    length += edge->length();
+    for (size_t i = 0; i < path_edges.size(); ++i) {
+      if (path_edges[i].count(p.edgeid) > 0) {
+        shared[i] += edge->length();
+      }
+    }
+  }
+  return std::all_of(shared.begin(), shared.end(), [length](const float s) {
+    return s <= length * kAlternativeMaxShareRatio;
+  });
+}
+
+// Form the path through a connection between the search trees
+std::vector<PathInfo> BidirectionalAStar::FormPath(const CandidateConnection& connection) {
+  // Get the indexes where the connection occurs.
+  uint32_t idx1 = edgestatus_forward_.Get(connection.edgeid).index();
+  uint32_t idx2 = edgestatus_reverse_.Get(connection.opp_edgeid).index();
+
+  // Work backwards on the forward path
+  std::vector<PathInfo> path;
   for (auto edgelabel_index = idx1; edgelabel_index != kInvalidLabel;
        edgelabel_index = edgelabels_forward_[edgelabel_index].predecessor()) {
     const BDEdgeLabel& edgelabel = edgelabels_forward_[edgelabel_index];
@@ -945,7 +1116,7 @@ std::vector<std::vector<PathInfo>> BidirectionalAStar::FormPath(GraphReader& gra
       path.back().elapsed_time = edgelabels_reverse_[idx2].cost().secs;
       path.back().elapsed_cost = edgelabels_reverse_[idx2].cost().cost;
     }
-    return paths;
+    return path;
   }
 
   // Get the elapsed time at the end of the forward path. NOTE: PathInfo
@@ -990,7 +1161,7 @@ std::vector<std::vector<PathInfo>> BidirectionalAStar::FormPath(GraphReader& gra
     previous_transition_cost.secs = edgelabel.transition_secs();
     previous_transition_cost.cost = edgelabel.transition_cost();
   }
-  return paths;
+  return path;
 }
 
 bool IsBridgingEdgeRestricted(GraphReader& graphreader,
@@ -125,6 +125,23 @@ std::vector<TimeDistance> CostMatrix::SourceToTarget(
   // location set.
   Initialize(source_location_list, target_location_list);
 
+  // Search using the concrete type of the costing
+  visit_costing(*costing_, [&](const auto& costing) { Expand(costing, graphreader); });
+
+  // Form the time, distance matrix from the destinations list
+  uint32_t idx = 0;
+  std::vector<TimeDistance> td;
+  for (const auto& connection : best_connection_) {
+    td.emplace_back(std::round(connection.cost.secs), std::round(connection.distance));
+    idx++;
+  }
+  return td;
+}
+
+// Run the searches. The per edge costing calls of the expansions are bound to
+// the concrete costing type.
+template <class costing_t>
+void CostMatrix::Expand(const DirectCost<costing_t>& costing, GraphReader& graphreader) {
   // Perform backward search from all target locations. Perform forward
   // search from all source locations. Connections between the 2 search
   // spaces is checked during the forward search.
@@ -134,7 +151,7 @@ std::vector<TimeDistance> CostMatrix::SourceToTarget(
     for (uint32_t i = 0; i < target_count_; i++) {
       if (target_status_[i].threshold > 0) {
         target_status_[i].threshold--;
-        BackwardSearch(i, graphreader);
+        BackwardSearch(costing, i, graphreader);
         if (target_status_[i].threshold == 0) {
           target_status_[i].threshold = -1;
           if (remaining_targets_ > 0) {
@@ -148,7 +165,7 @@ std::vector<TimeDistance> CostMatrix::SourceToTarget(
     for (uint32_t i = 0; i < source_count_; i++) {
       if (source_status_[i].threshold > 0) {
         source_status_[i].threshold--;
-        ForwardSearch(i, n, graphreader);
+        ForwardSearch(costing, i, n, graphreader);
         if (source_status_[i].threshold == 0) {
           source_status_[i].threshold = -1;
           if (remaining_sources_ > 0) {
@@ -171,15 +188,6 @@ std::vector<TimeDistance> CostMatrix::SourceToTarget(
     }
     n++;
   }
-
-  // Form the time, distance matrix from the destinations list
-  uint32_t idx = 0;
-  std::vector<TimeDistance> td;
-  for (const auto& connection : best_connection_) {
-    td.emplace_back(std::round(connection.cost.secs), std::round(connection.distance));
-    idx++;
-  }
-  return td;
 }
 
 // Initialize all time distance to "not found". Any locations that
@@ -232,7 +240,11 @@ void CostMatrix::Initialize(
 }
 
 // Iterate the forward search from the source/origin location.
-void CostMatrix::ForwardSearch(const uint32_t index, const uint32_t n, GraphReader& graphreader) {
+template <class costing_t>
+void CostMatrix::ForwardSearch(const DirectCost<costing_t>& costing,
+                               const uint32_t index,
+                               const uint32_t n,
+                               GraphReader& graphreader) {
   // Get the next edge from the adjacency list for this source location
   auto& adj = source_adjacency_[index];
   auto& edgelabels = source_edgelabel_[index];
@@ -309,14 +321,14 @@ void CostMatrix::ForwardSearch(const uint32_t index, const uint32_t n, GraphRead
       // Skip this edge if no access is allowed (based on costing method)
       // or if a complex restriction prevents transition onto this edge.
       bool has_time_restrictions = false;
-      if (!costing_->Allowed(directededge, pred, tile, edgeid, 0, 0, has_time_restrictions) ||
+      if (!costing.Allowed(directededge, pred, tile, edgeid, 0, 0, has_time_restrictions) ||
           costing_->Restricted(directededge, pred, edgelabels, tile, edgeid, true)) {
         continue;
       }
 
       // Get cost. Separate out transition cost.
-      Cost tc = costing_->TransitionCost(directededge, nodeinfo, pred);
-      Cost newcost = pred.cost() + tc + costing_->EdgeCost(directededge, tile);
+      Cost tc = costing.TransitionCost(directededge, nodeinfo, pred);
+      Cost newcost = pred.cost() + tc + costing.EdgeCost(directededge, tile);
 
       // Check if edge is temporarily labeled and this path has less cost. If
       // less cost the predecessor is updated along with new cost and distance.
@@ -374,7 +386,7 @@ void CostMatrix::ForwardSearch(const uint32_t index, const uint32_t n, GraphRead
   const GraphTile* tile = graphreader.GetGraphTile(node);
   if (tile != nullptr) {
     const NodeInfo* nodeinfo = tile->node(node);
-    if (costing_->Allowed(nodeinfo)) {
+    if (costing.Allowed(nodeinfo)) {
       expand(tile, node, nodeinfo, pred, pred_idx, false);
     }
   }
@@ -496,7 +508,10 @@ void CostMatrix::UpdateStatus(const uint32_t source, const uint32_t target) {
 }
 
 // Expand the backwards search trees.
-void CostMatrix::BackwardSearch(const uint32_t index, GraphReader& graphreader) {
+template <class costing_t>
+void CostMatrix::BackwardSearch(const DirectCost<costing_t>& costing,
+                                const uint32_t index,
+                                GraphReader& graphreader) {
   // Get the next edge from the adjacency list for this target location
   auto& adj = target_adjacency_[index];
   auto& edgelabels = target_edgelabel_[index];
@@ -581,17 +596,17 @@ void CostMatrix::BackwardSearch(const uint32_t index, GraphReader& graphreader)
       // or if a complex restriction prevents transition onto this edge.
       const DirectedEdge* opp_edge = t2->directededge(oppedge);
       bool has_time_restrictions = false;
-      if (!costing_->AllowedReverse(directededge, pred, opp_edge, t2, oppedge, 0, 0,
-                                    has_time_restrictions) ||
+      if (!costing.AllowedReverse(directededge, pred, opp_edge, t2, oppedge, 0, 0,
+                                  has_time_restrictions) ||
           costing_->Restricted(directededge, pred, edgelabels, tile, edgeid, false)) {
         continue;
       }
 
       // Get cost. Use opposing edge for EdgeCost. Separate the transition seconds so
       // we can properly recover elapsed time on the reverse path.
-      Cost tc = costing_->TransitionCostReverse(directededge->localedgeidx(), nodeinfo, opp_edge,
-                                                opp_pred_edge);
-      Cost newcost = pred.cost() + tc + costing_->EdgeCost(opp_edge, tile);
+      Cost tc = costing.TransitionCostReverse(directededge->localedgeidx(), nodeinfo, opp_edge,
+                                              opp_pred_edge);
+      Cost newcost = pred.cost() + tc + costing.EdgeCost(opp_edge, tile);
 
       // Check if edge is temporarily labeled and this path has less cost. If
       // less cost the predecessor is updated along with new cost and distance.
@@ -644,7 +659,7 @@ void CostMatrix::BackwardSearch(const uint32_t index, GraphReader& graphreader)
   const GraphTile* tile = graphreader.GetGraphTile(node);
   if (tile != nullptr) {
     const NodeInfo* nodeinfo = tile->node(node);
-    if (costing_->Allowed(nodeinfo)) {
+    if (costing.Allowed(nodeinfo)) {
       // Get the opposing predecessor directed edge. Need to make sure we get
       // the correct one if a transition occurred
       const DirectedEdge* opp_pred_edge;
@@ -704,7 +719,7 @@ void CostMatrix::SetSources(GraphReader& graphreader,
       GraphId oppedge = graphreader.GetOpposingEdgeId(edgeid);
 
       // Get cost. Get distance along the remainder of this edge.
-      Cost edgecost = costing_->EdgeCost(directededge, tile);
+      Cost edgecost = costing_->CachedEdgeCost(directededge, tile);
       Cost cost = edgecost * (1.0f - edge.percent_along());
       uint32_t d = std::round(directededge->length() * (1.0f - edge.percent_along()));
 
@@ -791,7 +806,7 @@ void CostMatrix::SetTargets(baldr::GraphReader& graphreader,
       // Get cost. Get distance along the remainder of this edge.
       // Use the directed edge for costing, as this is the forward direction
       // along the destination edge.
-      Cost edgecost = costing_->EdgeCost(directededge, tile);
+      Cost edgecost = costing_->CachedEdgeCost(directededge, tile);
       Cost cost = edgecost * edge.percent_along();
       uint32_t d = std::round(directededge->length() * edge.percent_along());
 
@@ -47,12 +47,25 @@ Dijkstras::Dijkstras()
 
 // Clear the temporary information generated during path construction.
 void Dijkstras::Clear() {
+  // Keep the memory for the next expansion unless it is above the high-water mark
+  const bool release = working_memory_.Reserved(
+      WorkingMemory::Bytes(bdedgelabels_) + WorkingMemory::Bytes(mmedgelabels_) +
+      edgestatus_.reserved() + (adjacencylist_ ? adjacencylist_->reserved() : 0),
+      !bdedgelabels_.empty() || !mmedgelabels_.empty());
+
   // Clear the edge labels, edge status flags, and adjacency list
   // TODO - clear only the edge label set that was used?
-  bdedgelabels_.clear();
-  mmedgelabels_.clear();
-  adjacencylist_.reset();
-  edgestatus_.clear();
+  WorkingMemory::Clear(bdedgelabels_, release);
+  WorkingMemory::Clear(mmedgelabels_, release);
+  if (release) {
+    adjacencylist_.reset();
+    edgestatus_.release();
+  } else {
+    if (adjacencylist_) {
+      adjacencylist_->clear();
+    }
+    edgestatus_.clear();
+  }
 }
 
 // Initialize - create adjacency list, edgestatus support, and reserve
@@ -68,7 +81,11 @@ void Dijkstras::Initialize(label_container_t& labels, const uint32_t bucket_size
   // Set up lambda to get sort costs
   const auto edgecost = [&labels](const uint32_t label) { return labels[label].sortcost(); };
   float range = bucket_count * bucket_size;
-  adjacencylist_.reset(new DoubleBucketQueue(0.0f, range, bucket_size, edgecost));
+  if (adjacencylist_) {
+    adjacencylist_->reuse(0.0f, range, bucket_size, edgecost);
+  } else {
+    adjacencylist_.reset(new DoubleBucketQueue(0.0f, range, bucket_size, edgecost));
+  }
 }
 template void
 Dijkstras::Initialize<decltype(Dijkstras::bdedgelabels_)>(decltype(Dijkstras::bdedgelabels_)&,
@@ -135,7 +152,9 @@ Dijkstras::SetTime(google::protobuf::RepeatedPtrField<valhalla::Location>& locat
 }
 
 // Expand from a node in the forward direction
-void Dijkstras::ExpandForward(GraphReader& graphreader,
+template <class costing_t>
+void Dijkstras::ExpandForward(const DirectCost<costing_t>& costing,
+                              GraphReader& graphreader,
                               const GraphId& node,
                               const EdgeLabel& pred,
                               const uint32_t pred_idx,
@@ -161,7 +180,7 @@ void Dijkstras::ExpandForward(GraphReader& graphreader,
   }
 
   // Bail if we cant expand from here
-  if (!costing_->Allowed(nodeinfo)) {
+  if (!costing.Allowed(nodeinfo)) {
     return;
   }
 
@@ -194,25 +213,25 @@ void Dijkstras::ExpandForward(GraphReader& graphreader,
     bool has_time_restrictions = false;
     if (has_date_time_) {
       // With date time we check time dependent restrictions and access
-      if (!costing_->Allowed(directededge, pred, tile, edgeid, localtime, nodeinfo->timezone(),
-                             has_time_restrictions) ||
+      if (!costing.Allowed(directededge, pred, tile, edgeid, localtime, nodeinfo->timezone(),
+                           has_time_restrictions) ||
           costing_->Restricted(directededge, pred, bdedgelabels_, tile, edgeid, true, todo, localtime,
                                nodeinfo->timezone())) {
         continue;
       }
     } else {
-      if (!costing_->Allowed(directededge, pred, tile, edgeid, 0, 0, has_time_restrictions) ||
+      if (!costing.Allowed(directededge, pred, tile, edgeid, 0, 0, has_time_restrictions) ||
           costing_->Restricted(directededge, pred, bdedgelabels_, tile, edgeid, true)) {
         continue;
       }
     }
 
     // Compute the cost to the end of this edge
-    Cost transition_cost = costing_->TransitionCost(directededge, nodeinfo, pred);
+    Cost transition_cost = costing.TransitionCost(directededge, nodeinfo, pred);
     Cost newcost =
         pred.cost() +
-        costing_->EdgeCost(directededge, tile,
-                           has_date_time_ ? seconds_of_week : kConstrainedFlowSecondOfDay) +
+        costing.EdgeCost(directededge, tile,
+                         has_date_time_ ? seconds_of_week : kConstrainedFlowSecondOfDay) +
         transition_cost;
 
     // Check if edge is temporarily labeled and this path has less cost. If
@@ -244,7 +263,8 @@ void Dijkstras::ExpandForward(GraphReader& graphreader,
   if (!from_transition && nodeinfo->transition_count() > 0) {
     const NodeTransition* trans = tile->transition(nodeinfo->transition_index());
     for (uint32_t i = 0; i < nodeinfo->transition_count(); ++i, ++trans) {
-      ExpandForward(graphreader, trans->endnode(), pred, pred_idx, true, localtime, seconds_of_week);
+      ExpandForward(costing, graphreader, trans->endnode(), pred, pred_idx, true, localtime,
+                    seconds_of_week);
     }
   }
 }
@@ -270,7 +290,19 @@ void Dijkstras::Compute(google::protobuf::RepeatedPtrField<valhalla::Location>&
   auto node_id = bdedgelabels_.empty() ? GraphId{} : bdedgelabels_[0].endnode();
   std::tie(start_time, start_seconds_of_week) = SetTime(origin_locations, node_id, graphreader);
 
-  // Compute the isotile
+  // Compute the isotile using the concrete type of the costing
+  visit_costing(*costing_, [&](const auto& costing) {
+    Traverse(costing, graphreader, start_time, start_seconds_of_week);
+  });
+}
+
+// Run the forward graph traversal. The per edge costing calls of the
+// expansion are bound to the concrete costing type.
+template <class costing_t>
+void Dijkstras::Traverse(const DirectCost<costing_t>& costing,
+                         GraphReader& graphreader,
+                         const uint64_t start_time,
+                         const uint32_t start_seconds_of_week) {
   auto cb_decision = ExpansionRecommendation::continue_expansion;
   while (cb_decision != ExpansionRecommendation::stop_expansion) {
     // Get next element from adjacency list. Check that it is valid. An
@@ -295,13 +327,16 @@ void Dijkstras::Compute(google::protobuf::RepeatedPtrField<valhalla::Location>&
     cb_decision = ShouldExpand(graphreader, pred, InfoRoutingType::forward);
     if (cb_decision != ExpansionRecommendation::prune_expansion) {
       // Expand from the end node in forward direction.
-      ExpandForward(graphreader, pred.endnode(), pred, predindex, false, localtime, seconds_of_week);
+      ExpandForward(costing, graphreader, pred.endnode(), pred, predindex, false, localtime,
+                    seconds_of_week);
     }
   }
 }
 
 // Expand from a node in reverse direction.
-void Dijkstras::ExpandReverse(GraphReader& graphreader,
+template <class costing_t>
+void Dijkstras::ExpandReverse(const DirectCost<costing_t>& costing,
+                              GraphReader& graphreader,
                               const GraphId& node,
                               const BDEdgeLabel& pred,
                               const uint32_t pred_idx,
@@ -328,7 +363,7 @@ void Dijkstras::ExpandReverse(GraphReader& graphreader,
   }
 
   // Bail if we cant expand from here
-  if (!costing_->Allowed(nodeinfo)) {
+  if (!costing.Allowed(nodeinfo)) {
     return;
   }
 
@@ -367,26 +402,27 @@ void Dijkstras::ExpandReverse(GraphReader& graphreader,
     bool has_time_restrictions = false;
     if (has_date_time_) {
       // With date time we check time dependent restrictions and access
-      if (!costing_->AllowedReverse(directededge, pred, opp_edge, t2, opp_edge_id, localtime,
-                                    nodeinfo->timezone(), has_time_restrictions) ||
+      if (!costing.AllowedReverse(directededge, pred, opp_edge, t2, opp_edge_id, localtime,
+                                  nodeinfo->timezone(), has_time_restrictions) ||
           costing_->Restricted(directededge, pred, bdedgelabels_, tile, edgeid, false, todo,
                                localtime, nodeinfo->timezone())) {
         continue;
       }
     } else {
-      if (!costing_->AllowedReverse(directededge, pred, opp_edge, t2, opp_edge_id, 0, 0,
-                                    has_time_restrictions) ||
+      if (!costing.AllowedReverse(directededge, pred, opp_edge, t2, opp_edge_id, 0, 0,
+                                  has_time_restrictions) ||
           costing_->Restricted(directededge, pred, bdedgelabels_, tile, edgeid, false)) {
         continue;
       }
     }
 
     // Compute the cost to the end of this edge with separate transition cost
-    Cost transition_cost = costing_->TransitionCostReverse(directededge->localedgeidx(), nodeinfo,
-                                                           opp_edge, opp_pred_edge);
-    Cost newcost = pred.cost() +
-                   costing_->EdgeCost(opp_edge, t2,
-                                      has_date_time_ ? seconds_of_week : kConstrainedFlowSecondOfDay);
+    Cost transition_cost = costing.TransitionCostReverse(directededge->localedgeidx(), nodeinfo,
+                                                         opp_edge, opp_pred_edge);
+    Cost newcost =
+        pred.cost() +
+        costing.EdgeCost(opp_edge, t2,
+                         has_date_time_ ? seconds_of_week : kConstrainedFlowSecondOfDay);
     newcost.cost += transition_cost.cost;
 
     // Check if edge is temporarily labeled and this path has less cost. If
@@ -414,8 +450,8 @@ void Dijkstras::ExpandReverse(GraphReader& graphreader,
   if (!from_transition && nodeinfo->transition_count() > 0) {
     const NodeTransition* trans = tile->transition(nodeinfo->transition_index());
     for (uint32_t i = 0; i < nodeinfo->transition_count(); ++i, ++trans) {
-      ExpandReverse(graphreader, trans->endnode(), pred, pred_idx, opp_pred_edge, true, localtime,
-                    seconds_of_week);
+      ExpandReverse(costing, graphreader, trans->endnode(), pred, pred_idx, opp_pred_edge, true,
+                    localtime, seconds_of_week);
     }
   }
 }
@@ -440,7 +476,19 @@ void Dijkstras::ComputeReverse(google::protobuf::RepeatedPtrField<valhalla::Loca
   auto node_id = bdedgelabels_.empty() ? GraphId{} : bdedgelabels_[0].endnode();
   std::tie(start_time, start_seconds_of_week) = SetTime(dest_locations, node_id, graphreader);
 
-  // Compute the isotile
+  // Compute the isotile using the concrete type of the costing
+  visit_costing(*costing_, [&](const auto& costing) {
+    TraverseReverse(costing, graphreader, start_time, start_seconds_of_week);
+  });
+}
+
+// Run the reverse graph traversal. The per edge costing calls of the
+// expansion are bound to the concrete costing type.
+template <class costing_t>
+void Dijkstras::TraverseReverse(const DirectCost<costing_t>& costing,
+                                GraphReader& graphreader,
+                                const uint64_t start_time,
+                                const uint32_t start_seconds_of_week) {
   auto cb_decision = ExpansionRecommendation::continue_expansion;
   while (cb_decision != ExpansionRecommendation::stop_expansion) {
     // Get next element from adjacency list. Check that it is valid. An
@@ -468,8 +516,8 @@ void Dijkstras::ComputeReverse(google::protobuf::RepeatedPtrField<valhalla::Loca
     cb_decision = ShouldExpand(graphreader, pred, InfoRoutingType::forward);
     if (cb_decision != ExpansionRecommendation::prune_expansion) {
       // Expand from the end node in forward direction.
-      ExpandReverse(graphreader, pred.endnode(), pred, predindex, opp_pred_edge, false, localtime,
-                    seconds_of_week);
+      ExpandReverse(costing, graphreader, pred.endnode(), pred, predindex, opp_pred_edge, false,
+                    localtime, seconds_of_week);
     }
   }
 }
@@ -672,7 +720,7 @@ void Dijkstras::ExpandForwardMultiModal(GraphReader& graphreader,
         continue;
       }
 
-      Cost c = mode_costing[static_cast<uint32_t>(mode_)]->EdgeCost(directededge, tile);
+      Cost c = mode_costing[static_cast<uint32_t>(mode_)]->CachedEdgeCost(directededge, tile);
       c.cost *= mode_costing[static_cast<uint32_t>(mode_)]->GetModeFactor();
       newcost += c;
 
@@ -877,7 +925,7 @@ void Dijkstras::SetOriginLocations(GraphReader& graphreader,
       const DirectedEdge* opp_dir_edge = opp_tile->directededge(opp_edge_id);
 
       // Get cost
-      Cost cost = costing->EdgeCost(directededge, tile) * (1.0f - edge.percent_along());
+      Cost cost = costing->CachedEdgeCost(directededge, tile) * (1.0f - edge.percent_along());
 
       // We need to penalize this location based on its score (distance in meters from input)
       // We assume the slowest speed you could travel to cover that distance to start/end the route
@@ -942,7 +990,7 @@ void Dijkstras::SetDestinationLocations(
       const DirectedEdge* opp_dir_edge = opp_tile->directededge(opp_edge_id);
 
       // Get the cost
-      Cost cost = costing->EdgeCost(directededge, tile) * edge.percent_along();
+      Cost cost = costing->CachedEdgeCost(directededge, tile) * edge.percent_along();
 
       // We need to penalize this location based on its score (distance in meters from input)
       // We assume the slowest speed you could travel to cover that distance to start/end the route
@@ -1002,7 +1050,7 @@ void Dijkstras::SetOriginLocationsMultiModal(
       }
 
       // Get cost
-      Cost cost = costing->EdgeCost(directededge, endtile) * (1.0f - edge.percent_along());
+      Cost cost = costing->CachedEdgeCost(directededge, endtile) * (1.0f - edge.percent_along());
 
       // We need to penalize this location based on its score (distance in meters from input)
       // We assume the slowest speed you could travel to cover that distance to start/end the route
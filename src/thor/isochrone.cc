@@ -40,7 +40,6 @@ uint32_t GetOperatorId(const GraphTile* tile,
 namespace valhalla {
 namespace thor {
 
-constexpr uint32_t kBucketCount = 20000;
 constexpr uint32_t kInitialEdgeLabelCount = 500000;
 
 // Default constructor
@@ -182,6 +181,31 @@ Isochrone::ComputeMultiModal(google::protobuf::RepeatedPtrField<valhalla::Locati
   return isotile_;
 }
 
+// Compute isochrone for multi-modal route using the round based transit algorithm.
+std::shared_ptr<const GriddedData<PointLL>>
+Isochrone::ComputeMultiModal(google::protobuf::RepeatedPtrField<valhalla::Location>& origin_locations,
+                             const unsigned int max_minutes,
+                             GraphReader& graphreader,
+                             const std::shared_ptr<DynamicCost>* mode_costing,
+                             const TravelMode mode,
+                             RaptorPathAlgorithm& raptor) {
+  // Initialize and create the isotile
+  ConstructIsoTile(true, max_minutes, origin_locations, mode);
+
+  // Mark the cells along each walked edge up to its end node. An edge can be walked
+  // in more than one round, the grid keeps the earliest time
+  edgestatus_.clear();
+  raptor.Clear();
+  raptor.Expand(origin_locations, graphreader, mode_costing, max_seconds_,
+                [this, &graphreader](const MMEdgeLabel& label, const float secs0) {
+                  const GraphTile* tile = graphreader.GetGraphTile(label.endnode());
+                  if (tile != nullptr) {
+                    UpdateIsoTile(label, graphreader, tile->get_node_ll(label.endnode()), secs0);
+                  }
+                });
+  return isotile_;
+}
+
 // Update the isotile
 void Isochrone::UpdateIsoTile(const EdgeLabel& pred,
                               GraphReader& graphreader,
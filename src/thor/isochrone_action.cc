@@ -9,6 +9,14 @@ namespace valhalla {
 namespace thor {
 
 std::string thor_worker_t::isochrones(Api& request) {
+  // identical requests are answered with the response to the first one
+  std::string response;
+  auto response_key =
+      response_cache ? ResponseCache::Key(request.options(), *reader) : std::string();
+  if (!response_key.empty() && response_cache->Find(response_key, response)) {
+    return response;
+  }
+
   parse_locations(request);
   auto costing = parse_costing(request);
   auto& options = *request.mutable_options();
@@ -30,19 +38,37 @@ std::string thor_worker_t::isochrones(Api& request) {
   // Extend the times in the 2-D grid to be 10 minutes beyond the highest contour time.
   // Cost (including penalties) is used when adding to the adjacency list but the elapsed
   // time in seconds is used when terminating the search. The + 10 minutes adds a buffer for edges
-  // where there has been a higher cost that might still be marked in the isochrone
-  auto grid = (costing == "multimodal" || costing == "transit")
-                  ? isochrone_gen.ComputeMultiModal(*options.mutable_locations(),
-                                                    contours.back() + 10, *reader, mode_costing, mode)
-                  : isochrone_gen.Compute(*options.mutable_locations(), contours.back() + 10, *reader,
-                                          mode_costing, mode);
+  // where there has been a higher cost that might still be marked in the isochrone.
+  // Requests differing only in how the grid is contoured reuse the grid of an earlier expansion
+  const bool multimodal = costing == "multimodal" || costing == "transit";
+  const unsigned int max_minutes = contours.back() + 10;
+  const std::string key = IsochroneCache::Key(options, multimodal, max_minutes);
+  auto grid = isochrone_cache.Find(key);
+  if (!grid) {
+    if (multimodal && use_raptor) {
+      raptor.set_interrupt(interrupt);
+      grid = isochrone_gen.ComputeMultiModal(*options.mutable_locations(), max_minutes, *reader,
+                                             mode_costing, mode, raptor);
+    } else if (multimodal) {
+      grid = isochrone_gen.ComputeMultiModal(*options.mutable_locations(), max_minutes, *reader,
+                                             mode_costing, mode);
+    } else {
+      grid = isochrone_gen.Compute(*options.mutable_locations(), max_minutes, *reader, mode_costing,
+                                   mode);
+    }
+    isochrone_cache.Insert(key, grid);
+  }
 
   // turn it into geojson
   auto isolines =
       grid->GenerateContours(contours, options.polygons(), options.denoise(), options.generalize());
 
-  return tyr::serializeIsochrones<PointLL>(request, isolines, options.polygons(), colors,
-                                           options.show_locations());
+  response = tyr::serializeIsochrones<PointLL>(request, isolines, options.polygons(), colors,
+                                               options.show_locations());
+  if (!response_key.empty()) {
+    response_cache->Insert(response_key, response);
+  }
+  return response;
 }
 
 } // namespace thor
@@ -0,0 +1,77 @@
+#include "thor/isochrone_cache.h"
+#include "baldr/cache_utils.h"
+
+namespace valhalla {
+namespace thor {
+
+IsochroneCache::IsochroneCache(const size_t max_size)
+    : max_size_(max_size), size_(0), hits_(0), misses_(0) {
+}
+
+// The key is the deterministically serialized request without the options that only change how
+// the grid is contoured and serialized, plus the time the grid extends to
+std::string
+IsochroneCache::Key(const Options& options, const bool multimodal, const unsigned int max_minutes) {
+  Options expansion = options;
+  expansion.clear_contours();
+  expansion.clear_polygons();
+  expansion.clear_denoise();
+  expansion.clear_generalize();
+  expansion.clear_show_locations();
+  expansion.clear_id();
+  expansion.clear_jsonp();
+  expansion.clear_format();
+  expansion.clear_do_not_track();
+  std::string key = baldr::cache_serialize(expansion);
+  key.push_back(multimodal ? 'm' : 's');
+  key += std::to_string(max_minutes) + '|';
+  key += baldr::cache_time_bucket(options);
+  return key;
+}
+
+IsochroneCache::grid_t IsochroneCache::Find(const std::string& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return found->second->grid;
+}
+
+void IsochroneCache::Insert(const std::string& key, const grid_t& grid) {
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    Erase(found->second);
+  }
+
+  // Grids larger than the cache are not kept
+  size_t size = key.size() + grid->data().size() * sizeof(float) + sizeof(entry_t);
+  if (size > max_size_) {
+    return;
+  }
+  entries_.push_front({key, grid, size});
+  index_.emplace(key, entries_.begin());
+  size_ += size;
+  while (size_ > max_size_) {
+    Erase(std::prev(entries_.end()));
+  }
+}
+
+void IsochroneCache::Clear() {
+  entries_.clear();
+  index_.clear();
+  size_ = 0;
+  hits_ = 0;
+  misses_ = 0;
+}
+
+void IsochroneCache::Erase(entries_t::iterator entry) {
+  size_ -= entry->size;
+  index_.erase(entry->key);
+  entries_.erase(entry);
+}
+
+} // namespace thor
+} // namespace valhalla
@@ -0,0 +1,258 @@
+#include "thor/local_search_optimizer.h"
+#include "midgard/logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <thread>
+
+namespace {
+
+// Smallest cost reduction accepted as an improvement (guards against cycling
+// through moves that only differ by rounding)
+constexpr double kMinImprovement = 1e-4;
+
+// Number of nearest unvisited locations the randomized constructions choose from
+constexpr uint32_t kRandomizedChoices = 3;
+
+} // namespace
+
+namespace valhalla {
+namespace thor {
+
+LocalSearchOptimizer::LocalSearchOptimizer(const uint32_t restarts,
+                                           const uint32_t threads,
+                                           const uint32_t time_budget)
+    : restarts_(std::max(restarts, 1u)), threads_(std::max(threads, 1u)),
+      time_budget_(time_budget), seed_(0), seeded_(false), count_(0), costs_(nullptr) {
+}
+
+// Optimize the tour through a set of locations given the cost matrix
+// among all locations. The first location (origin) and last location
+// (destination) remain fixed in the tour.
+std::vector<uint32_t> LocalSearchOptimizer::Solve(const uint32_t count,
+                                                  const std::vector<float>& costs) {
+  // Handle trivial cases.
+  count_ = count;
+  costs_ = &costs;
+  if (count <= 3) {
+    std::vector<uint32_t> tour(count);
+    std::iota(tour.begin(), tour.end(), 0);
+    return tour;
+  }
+  SetNeighbours();
+
+  // Run the restarts on a pool of threads. Restarts are handed out in order and,
+  // unless a seed was set, no more are started once the time budget is spent.
+  // When seeded they all run so the tour does not depend on the timing.
+  std::vector<std::vector<uint32_t>> tours(restarts_);
+  std::vector<double> tour_costs(restarts_, std::numeric_limits<double>::max());
+  std::atomic<uint32_t> next_restart(0);
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(time_budget_);
+  auto run = [&]() {
+    for (uint32_t r = next_restart++; r < restarts_; r = next_restart++) {
+      if (r > 0 && !seeded_ && std::chrono::steady_clock::now() > deadline) {
+        break;
+      }
+      std::mt19937_64 generator(seed_ + r);
+      auto tour = ConstructTour(generator, r == 0 ? 1 : kRandomizedChoices);
+      ImproveTour(tour);
+      tour_costs[r] = TourCost(tour);
+      tours[r] = std::move(tour);
+    }
+  };
+  uint32_t nthreads = std::min(threads_, restarts_);
+  std::vector<std::shared_ptr<std::thread>> threads(nthreads - 1);
+  for (auto& thread : threads) {
+    thread.reset(new std::thread(run));
+  }
+  run();
+  for (auto& thread : threads) {
+    thread->join();
+  }
+
+  // Return the best tour, ties go to the lowest restart
+  auto best = std::min_element(tour_costs.begin(), tour_costs.end()) - tour_costs.begin();
+  LOG_DEBUG("Best tour cost = " + std::to_string(tour_costs[best]) +
+            " restart = " + std::to_string(best));
+  return tours[best];
+}
+
+// Find the nearest successors and predecessors of each location. Nothing goes to
+// the origin and nothing leaves the destination so they are left out.
+void LocalSearchOptimizer::SetNeighbours() {
+  auto nearest = [](std::vector<uint32_t> locations, const auto& cost) {
+    auto n = std::min(static_cast<size_t>(kOptimizerNeighbours), locations.size());
+    std::partial_sort(locations.begin(), locations.begin() + n, locations.end(),
+                      [&cost](const uint32_t a, const uint32_t b) {
+                        return cost(a) < cost(b) || (cost(a) == cost(b) && a < b);
+                      });
+    locations.resize(n);
+    return locations;
+  };
+
+  successors_.resize(count_);
+  predecessors_.resize(count_);
+  for (uint32_t i = 0; i < count_; ++i) {
+    std::vector<uint32_t> locations;
+    for (uint32_t j = 1; j < count_ - 1; ++j) {
+      if (j != i) {
+        locations.push_back(j);
+      }
+    }
+    successors_[i] = nearest(locations, [this, i](const uint32_t j) { return Cost(i, j); });
+    predecessors_[i] = nearest(locations, [this, i](const uint32_t j) { return Cost(j, i); });
+  }
+}
+
+// Construct a tour by repeatedly going to one of the nearest unvisited locations.
+// The first and last locations remain fixed.
+std::vector<uint32_t> LocalSearchOptimizer::ConstructTour(std::mt19937_64& generator,
+                                                          const uint32_t choices) const {
+  std::vector<uint32_t> unvisited(count_ - 2);
+  std::iota(unvisited.begin(), unvisited.end(), 1);
+  std::vector<uint32_t> tour = {0};
+  while (!unvisited.empty()) {
+    // Move the nearest few unvisited locations to the front and pick one of them
+    const uint32_t from = tour.back();
+    const uint32_t n = std::min(choices, static_cast<uint32_t>(unvisited.size()));
+    std::partial_sort(unvisited.begin(), unvisited.begin() + n, unvisited.end(),
+                      [this, from](const uint32_t a, const uint32_t b) {
+                        return Cost(from, a) < Cost(from, b) ||
+                               (Cost(from, a) == Cost(from, b) && a < b);
+                      });
+    const uint32_t pick =
+        n == 1 ? 0 : std::uniform_int_distribution<uint32_t>(0, n - 1)(generator);
+    tour.push_back(unvisited[pick]);
+    unvisited.erase(unvisited.begin() + pick);
+  }
+  tour.push_back(count_ - 1);
+  return tour;
+}
+
+// Apply improving moves until the tour is a local optimum for both move types
+void LocalSearchOptimizer::ImproveTour(std::vector<uint32_t>& tour) const {
+  tour_state_t state;
+  state.tour = std::move(tour);
+  UpdateState(state);
+  while (TwoOpt(state) || OrOpt(state)) {
+    UpdateState(state);
+  }
+  tour = std::move(state.tour);
+}
+
+// Reversing the locations between tour indexes i and j replaces the connections
+// (i-1, i) and (j, j+1) with (i-1, j) and (i, j+1) and reverses the direction of
+// travel in between. The cost sums give the cost of both directions in constant
+// time so asymmetric costs are handled. Candidate moves are the ones creating a
+// connection to a nearest neighbour.
+bool LocalSearchOptimizer::TwoOpt(tour_state_t& state) const {
+  const auto& t = state.tour;
+  const uint32_t last = count_ - 2;
+  auto try_reverse = [&](const uint32_t i, const uint32_t j) {
+    if (j <= i || j > last) {
+      return false;
+    }
+    double removed = Cost(t[i - 1], t[i]) + Cost(t[j], t[j + 1]) + state.forward[j] -
+                     state.forward[i];
+    double added = Cost(t[i - 1], t[j]) + Cost(t[i], t[j + 1]) + state.backward[j] -
+                   state.backward[i];
+    if (added - removed < -kMinImprovement) {
+      std::reverse(state.tour.begin() + i, state.tour.begin() + j + 1);
+      return true;
+    }
+    return false;
+  };
+
+  for (uint32_t i = 1; i <= last; ++i) {
+    // New connection from the location before i to a successor
+    for (const auto s : successors_[t[i - 1]]) {
+      if (try_reverse(i, state.position[s])) {
+        return true;
+      }
+    }
+    // New connection from the location at i to a successor
+    for (const auto s : successors_[t[i]]) {
+      if (try_reverse(i, state.position[s] - 1)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+// Moving the locations between tour indexes i and i+len-1 between the locations at
+// p and p+1 replaces the connections (i-1, i), (i+len-1, i+len) and (p, p+1) with
+// (i-1, i+len), (p, i) and (i+len-1, p+1). Candidate moves are the ones creating a
+// connection to a nearest neighbour.
+bool LocalSearchOptimizer::OrOpt(tour_state_t& state) const {
+  auto& t = state.tour;
+  const uint32_t last = count_ - 2;
+  for (uint32_t len = 1; len <= 3; ++len) {
+    for (uint32_t i = 1; i + len - 1 <= last; ++i) {
+      const uint32_t first = t[i], end = t[i + len - 1];
+      const double removed =
+          Cost(t[i - 1], first) + Cost(end, t[i + len]) - Cost(t[i - 1], t[i + len]);
+      auto try_move = [&](const uint32_t p) {
+        if (p > last || (p + 1 >= i && p < i + len)) {
+          return false;
+        }
+        double added = Cost(t[p], first) + Cost(end, t[p + 1]) - Cost(t[p], t[p + 1]);
+        if (added - removed >= -kMinImprovement) {
+          return false;
+        }
+        if (p < i) {
+          std::rotate(t.begin() + p + 1, t.begin() + i, t.begin() + i + len);
+        } else {
+          std::rotate(t.begin() + i, t.begin() + i + len, t.begin() + p + 1);
+        }
+        return true;
+      };
+
+      // New connection from a predecessor to the first moved location
+      for (const auto p : predecessors_[first]) {
+        if (try_move(state.position[p])) {
+          return true;
+        }
+      }
+      // New connection from the last moved location to a successor
+      for (const auto s : successors_[end]) {
+        if (try_move(state.position[s] - 1)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+// Update the positions and cost sums after the tour changed
+void LocalSearchOptimizer::UpdateState(tour_state_t& state) const {
+  const auto& t = state.tour;
+  state.position.resize(count_);
+  state.forward.resize(count_);
+  state.backward.resize(count_);
+  state.forward[0] = state.backward[0] = 0.0;
+  for (uint32_t i = 0; i < count_; ++i) {
+    state.position[t[i]] = i;
+    if (i > 0) {
+      state.forward[i] = state.forward[i - 1] + Cost(t[i - 1], t[i]);
+      state.backward[i] = state.backward[i - 1] + Cost(t[i], t[i - 1]);
+    }
+  }
+}
+
+// Get the cost for the specified tour (order of locations).
+double LocalSearchOptimizer::TourCost(const std::vector<uint32_t>& tour) const {
+  double c = 0.0;
+  for (uint32_t i = 0; i < count_ - 1; i++) {
+    c += Cost(tour[i], tour[i + 1]);
+  }
+  return c;
+}
+
+} // namespace thor
+} // namespace valhalla
@@ -1,3 +1,4 @@
+#include "midgard/metrics.h"
 #include "sif/autocost.h"
 #include "sif/bicyclecost.h"
 #include "sif/pedestriancost.h"
@@ -29,8 +30,8 @@ std::string thor_worker_t::matrix(Api& request) {
   const auto& options = request.options();
 
   if (!options.do_not_track()) {
-    valhalla::midgard::logging::Log("matrix_type::" + Options_Action_Enum_Name(options.action()),
-                                    " [ANALYTICS] ");
+    midgard::metrics::Increment("valhalla_matrix_requests_total",
+                                {{"type", Options_Action_Enum_Name(options.action())}});
   }
 
   // Parse out units; if none specified, use kilometers
@@ -48,6 +49,34 @@ std::string thor_worker_t::matrix(Api& request) {
                                  max_matrix_distance.find(costing)->second);
   };
   auto timedistancematrix = [&]() {
+    if (matrix_pool.size() > 1) {
+      // every search state but the first gets its own costing, edge cost caches can't be shared
+      std::vector<std::vector<cost_ptr_t>> costings;
+      costings.reserve(matrix_pool.size() - 1);
+      std::vector<const cost_ptr_t*> mode_costings{mode_costing};
+      for (size_t i = 1; i < matrix_pool.size(); ++i) {
+        costings.emplace_back(std::begin(mode_costing), std::end(mode_costing));
+        auto& cost = costings.back()[static_cast<uint32_t>(mode)];
+        cost = factory.Create(options);
+        if (mode_costing[static_cast<uint32_t>(mode)]->edge_cost_cache()) {
+          cost->EnableEdgeCostCache(edge_cost_cache_size);
+        }
+        mode_costings.push_back(costings.back().data());
+      }
+      auto result =
+          thor::TimeDistanceMatrix::SourceToTarget(matrix_pool, mode_costings, options.sources(),
+                                                   options.targets(), *matrix_reader, mode,
+                                                   max_matrix_distance.find(costing)->second);
+      // the edge cost caches of the other threads' costings go away with them, count them now
+      for (const auto& other : costings) {
+        if (const auto* cache = other[static_cast<uint32_t>(mode)]->edge_cost_cache()) {
+          midgard::metrics::Increment("valhalla_edge_cost_cache_hits_total", {}, cache->hits());
+          midgard::metrics::Increment("valhalla_edge_cost_cache_misses_total", {},
+                                      cache->misses());
+        }
+      }
+      return result;
+    }
     thor::TimeDistanceMatrix matrix;
     return matrix.SourceToTarget(options.sources(), options.targets(), *reader, mode_costing, mode,
                                  max_matrix_distance.find(costing)->second);
@@ -69,7 +69,11 @@ void MultiModalPathAlgorithm::Init(const midgard::PointLL& origll,
   // Set bucket size and cost range based on DynamicCost.
   uint32_t bucketsize = costing->UnitSize();
   float range = kBucketCount * bucketsize;
-  adjacencylist_.reset(new DoubleBucketQueue(0.0f, range, bucketsize, edgecost));
+  if (adjacencylist_) {
+    adjacencylist_->reuse(0.0f, range, bucketsize, edgecost);
+  } else {
+    adjacencylist_.reset(new DoubleBucketQueue(0.0f, range, bucketsize, edgecost));
+  }
   edgestatus_.clear();
 
   // Get hierarchy limits from the costing. Get a copy since we increment
@@ -79,15 +83,26 @@ void MultiModalPathAlgorithm::Init(const midgard::PointLL& origll,
 
 // Clear the temporary information generated during path construction.
 void MultiModalPathAlgorithm::Clear() {
+  // Keep the memory for the next search unless it is above the high-water mark
+  const bool release =
+      working_memory_.Reserved(WorkingMemory::Bytes(edgelabels_) + edgestatus_.reserved() +
+                                   (adjacencylist_ ? adjacencylist_->reserved() : 0),
+                               !edgelabels_.empty());
+
   // Clear the edge labels and destination list
-  edgelabels_.clear();
+  WorkingMemory::Clear(edgelabels_, release);
   destinations_.clear();
 
-  // Clear elements from the adjacency list
-  adjacencylist_.reset();
-
-  // Clear the edge status flags
-  edgestatus_.clear();
+  // Clear elements from the adjacency list and the edge status flags
+  if (release) {
+    adjacencylist_.reset();
+    edgestatus_.release();
+  } else {
+    if (adjacencylist_) {
+      adjacencylist_->clear();
+    }
+    edgestatus_.clear();
+  }
 
   // Set the ferry flag to false
   has_ferry_ = false;
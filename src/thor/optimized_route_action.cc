@@ -2,6 +2,7 @@
 
 #include "midgard/constants.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include "sif/autocost.h"
 #include "sif/bicyclecost.h"
 #include "sif/pedestriancost.h"
@@ -24,7 +25,7 @@ void thor_worker_t::optimized_route(Api& request) {
   auto& options = *request.mutable_options();
 
   if (!options.do_not_track()) {
-    valhalla::midgard::logging::Log("matrix_type::optimized_route", " [ANALYTICS] ");
+    midgard::metrics::Increment("valhalla_matrix_requests_total", {{"type", "optimized_route"}});
   }
 
   // Use CostMatrix to find costs from each location to every other location
@@ -53,9 +54,14 @@ void thor_worker_t::optimized_route(Api& request) {
     time_costs.emplace_back(static_cast<float>(td[i].time));
   }
 
-  Optimizer optimizer;
   // returns the optimal order of the path_locations
-  auto optimal_order = optimizer.Solve(correlated.size(), time_costs);
+  std::vector<uint32_t> optimal_order;
+  if (use_local_search) {
+    optimal_order = local_search_optimizer.Solve(correlated.size(), time_costs);
+  } else {
+    Optimizer optimizer;
+    optimal_order = optimizer.Solve(correlated.size(), time_costs);
+  }
   // put the optimal order into the locations array
   options.mutable_locations()->Clear();
   for (size_t i = 0; i < optimal_order.size(); i++) {
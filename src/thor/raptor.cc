@@ -0,0 +1,669 @@
+#include "thor/raptor.h"
+#include "baldr/datetime.h"
+#include "midgard/logging.h"
+#include <algorithm>
+#include <limits>
+
+using namespace valhalla::baldr;
+using namespace valhalla::sif;
+
+namespace {
+
+// Time (seconds) allowed to change trips without leaving the stop
+constexpr uint32_t kInStationTransferTime = 30;
+
+// Departures of frequency based trips are allocated by the tile, keep a copy instead
+bool copy_departure(const TransitDeparture* departure, std::unique_ptr<TransitDeparture>& copy) {
+  if (departure == nullptr) {
+    return false;
+  }
+  if (departure->type() == kFrequencySchedule) {
+    copy.reset(const_cast<TransitDeparture*>(departure));
+  } else {
+    copy.reset(new TransitDeparture(*departure));
+  }
+  return true;
+}
+
+} // namespace
+
+namespace valhalla {
+namespace thor {
+
+constexpr uint64_t kInitialEdgeLabelCount = 200000;
+
+// Default constructor
+RaptorPathAlgorithm::RaptorPathAlgorithm(const uint32_t max_rounds)
+    : PathAlgorithm(), max_rounds_(max_rounds), date_set_(false), date_before_tile_(false), day_(0),
+      dow_(0), start_time_(0), start_tz_index_(0), max_seconds_(0), max_transfer_distance_(0),
+      adjacencylist_(nullptr), walked_(nullptr) {
+}
+
+// Destructor
+RaptorPathAlgorithm::~RaptorPathAlgorithm() {
+  Clear();
+}
+
+// Clear the temporary information generated during path construction.
+void RaptorPathAlgorithm::Clear() {
+  // Keep the memory for the next search unless it is above the high-water mark
+  const bool release =
+      working_memory_.Reserved(WorkingMemory::Bytes(edgelabels_) + edgestatus_.reserved() +
+                                   (adjacencylist_ ? adjacencylist_->reserved() : 0),
+                               !edgelabels_.empty());
+  WorkingMemory::Clear(edgelabels_, release);
+  if (release) {
+    adjacencylist_.reset();
+    edgestatus_.release();
+  } else {
+    if (adjacencylist_) {
+      adjacencylist_->clear();
+    }
+    edgestatus_.clear();
+  }
+  stop_arrivals_.clear();
+  marked_stops_.clear();
+  destinations_.clear();
+  destination_arrivals_.clear();
+  processed_tiles_.clear();
+  tz_diffs_.clear();
+  walked_ = nullptr;
+  has_ferry_ = false;
+}
+
+// Calculate the best paths using walking and transit.
+std::vector<std::vector<PathInfo>>
+RaptorPathAlgorithm::GetBestPath(valhalla::Location& origin,
+                                 valhalla::Location& destination,
+                                 GraphReader& graphreader,
+                                 const std::shared_ptr<DynamicCost>* mode_costing,
+                                 const TravelMode mode,
+                                 const Options& options) {
+  // Walking is done with pedestrian costing which is allowed to use transit connections
+  const auto& pc = mode_costing[static_cast<uint32_t>(TravelMode::kPedestrian)];
+  const auto& tc = mode_costing[static_cast<uint32_t>(TravelMode::kPublicTransit)];
+  pc->SetAllowTransitConnections(true);
+  pc->UseMaxMultiModalDistance();
+  max_transfer_distance_ = mode_costing[static_cast<uint32_t>(mode)]->GetMaxTransferDistanceMM();
+  max_seconds_ = std::numeric_limits<uint32_t>::max();
+
+  // For now the date_time must be set on the origin.
+  if (!origin.has_date_time()) {
+    return {};
+  }
+
+  // Initialize the destination first in case the origin edge includes a destination edge
+  edgelabels_.reserve(kInitialEdgeLabelCount);
+  SetDestination(graphreader, destination, pc);
+  SetOrigin(graphreader, origin, pc);
+  if (!Init(graphreader, origin)) {
+    return {};
+  }
+
+  // Run the rounds
+  Compute(graphreader, pc, tc);
+
+  // Every arrival at the destination was faster than those of the prior rounds (the
+  // destination bounds the search) so each of them is on the Pareto front. Return the
+  // earliest first followed by the ones with fewer trips
+  std::vector<std::vector<PathInfo>> paths;
+  for (auto arrival = destination_arrivals_.rbegin(); arrival != destination_arrivals_.rend();
+       ++arrival) {
+    if (arrival->label == kInvalidLabel) {
+      continue;
+    }
+    paths.emplace_back(FormPath(*arrival));
+    if (paths.size() > static_cast<size_t>(options.alternates())) {
+      break;
+    }
+  }
+  if (paths.empty()) {
+    LOG_ERROR("Route failed after iterations = " + std::to_string(edgelabels_.size()));
+  }
+  return paths;
+}
+
+// Expand from the origins until the time limit.
+void RaptorPathAlgorithm::Expand(google::protobuf::RepeatedPtrField<valhalla::Location>& origins,
+                                 GraphReader& graphreader,
+                                 const std::shared_ptr<DynamicCost>* mode_costing,
+                                 const uint32_t max_seconds,
+                                 const walk_callback_t& walked) {
+  const auto& pc = mode_costing[static_cast<uint32_t>(TravelMode::kPedestrian)];
+  const auto& tc = mode_costing[static_cast<uint32_t>(TravelMode::kPublicTransit)];
+  pc->SetAllowTransitConnections(true);
+  pc->UseMaxMultiModalDistance();
+  max_transfer_distance_ = pc->GetMaxTransferDistanceMM();
+  max_seconds_ = max_seconds;
+  walked_ = &walked;
+
+  // For now the date_time must be set on the origin.
+  if (!origins.Get(0).has_date_time()) {
+    LOG_ERROR("No date time set on the origin location");
+    return;
+  }
+
+  edgelabels_.reserve(kInitialEdgeLabelCount);
+  for (auto& origin : origins) {
+    SetOrigin(graphreader, origin, pc);
+  }
+  if (!Init(graphreader, origins.Get(0))) {
+    return;
+  }
+  Compute(graphreader, pc, tc);
+  walked_ = nullptr;
+}
+
+// Initialize the start time, timezone and date.
+bool RaptorPathAlgorithm::Init(GraphReader& graphreader, const valhalla::Location& origin) {
+  origin_date_time_ = origin.date_time();
+  start_time_ = DateTime::seconds_from_midnight(origin_date_time_);
+  start_tz_index_ = edgelabels_.empty() ? 0 : GetTimezone(graphreader, edgelabels_[0].endnode());
+  if (start_tz_index_ == 0) {
+    // TODO - should we throw an exception and return an error
+    LOG_ERROR("Could not get the timezone at the origin location");
+    return false;
+  }
+  date_set_ = false;
+  date_before_tile_ = false;
+  return true;
+}
+
+// Add edge labels for the edges at the origin.
+void RaptorPathAlgorithm::SetOrigin(GraphReader& graphreader,
+                                    valhalla::Location& origin,
+                                    const std::shared_ptr<DynamicCost>& pc) {
+  // Only skip inbound edges if we have other options
+  bool has_other_edges = false;
+  std::for_each(origin.path_edges().begin(), origin.path_edges().end(),
+                [&has_other_edges](const valhalla::Location::PathEdge& e) {
+                  has_other_edges = has_other_edges || !e.end_node();
+                });
+
+  // Iterate through edges and add to adjacency list
+  const NodeInfo* closest_ni = nullptr;
+  for (const auto& edge : origin.path_edges()) {
+    // If origin is at a node - skip any inbound edge (dist = 1)
+    if (has_other_edges && edge.end_node()) {
+      continue;
+    }
+
+    // Disallow any user avoid edges if the avoid location is ahead of the origin along the edge
+    GraphId edgeid(edge.graph_id());
+    if (pc->AvoidAsOriginEdge(edgeid, edge.percent_along())) {
+      continue;
+    }
+
+    // Skip if the end node tile is not found as we won't be able to expand from this edge
+    const GraphTile* tile = graphreader.GetGraphTile(edgeid);
+    const DirectedEdge* directededge = tile->directededge(edgeid);
+    const GraphTile* endtile = graphreader.GetGraphTile(directededge->endnode());
+    if (endtile == nullptr) {
+      continue;
+    }
+    if (closest_ni == nullptr) {
+      closest_ni = endtile->node(directededge->endnode());
+    }
+
+    // Time and cost from the origin to the end of the edge. The destination is
+    // checked when the label is settled so there is nothing to subtract here
+    Cost cost = pc->EdgeCost(directededge, tile) * (1.0f - edge.percent_along());
+    uint32_t d = static_cast<uint32_t>(directededge->length() * (1.0f - edge.percent_along()));
+    MMEdgeLabel edge_label(kInvalidLabel, edgeid, directededge, cost, cost.secs, 0.0f,
+                           TravelMode::kPedestrian, d, 0, GraphId(), 0, 0, false, Cost{});
+    edge_label.set_origin();
+    edgelabels_.push_back(std::move(edge_label));
+  }
+
+  // Set the origin timezone
+  if (closest_ni != nullptr && origin.has_date_time() && origin.date_time() == "current") {
+    origin.set_date_time(
+        DateTime::iso_date_time(DateTime::get_tz_db().from_index(closest_ni->timezone())));
+  }
+}
+
+// Add the destination edges.
+void RaptorPathAlgorithm::SetDestination(GraphReader& graphreader,
+                                         const valhalla::Location& dest,
+                                         const std::shared_ptr<DynamicCost>& pc) {
+  // Only skip outbound edges if we have other options
+  bool has_other_edges = false;
+  std::for_each(dest.path_edges().begin(), dest.path_edges().end(),
+                [&has_other_edges](const valhalla::Location::PathEdge& e) {
+                  has_other_edges = has_other_edges || !e.begin_node();
+                });
+
+  for (const auto& edge : dest.path_edges()) {
+    // If destination is at a node skip any outbound edges
+    if (has_other_edges && edge.begin_node()) {
+      continue;
+    }
+
+    // Disallow any user avoided edges if the avoid location is behind the destination along the edge
+    GraphId edgeid(edge.graph_id());
+    if (pc->AvoidAsDestinationEdge(edgeid, edge.percent_along())) {
+      continue;
+    }
+
+    // Keep the cost to traverse the partial distance for the remainder of the edge. This cost
+    // is subtracted from the total cost up to the end of the destination edge.
+    const GraphTile* tile = graphreader.GetGraphTile(edgeid);
+    const DirectedEdge* dest_diredge = tile->directededge(edgeid);
+    destinations_[edge.graph_id()] =
+        pc->EdgeCost(dest_diredge, tile) * (1.0f - edge.percent_along());
+  }
+}
+
+// Run the rounds.
+void RaptorPathAlgorithm::Compute(GraphReader& graphreader,
+                                  const std::shared_ptr<DynamicCost>& pc,
+                                  const std::shared_ptr<DynamicCost>& tc) {
+  // Round 0 walks from the origin edges
+  std::vector<uint32_t> seeds;
+  for (uint32_t idx = 0; idx < edgelabels_.size(); ++idx) {
+    seeds.push_back(idx);
+  }
+  Walk(graphreader, seeds, pc);
+
+  // Each following round rides one more trip
+  for (uint32_t round = 1; round <= max_rounds_ && !marked_stops_.empty(); ++round) {
+    seeds = RideTrips(graphreader, tc);
+    Walk(graphreader, seeds, pc);
+  }
+}
+
+// Ride the trips which can be boarded at the stops improved in the prior round.
+std::vector<uint32_t> RaptorPathAlgorithm::RideTrips(GraphReader& graphreader,
+                                                     const std::shared_ptr<DynamicCost>& tc) {
+  // Board at the arrivals of the prior round, not at those improved by this round's rides
+  std::vector<std::pair<GraphId, uint32_t>> boardings;
+  for (const auto stop : marked_stops_) {
+    boardings.emplace_back(GraphId(stop), stop_arrivals_[stop]);
+  }
+  marked_stops_.clear();
+
+  // A trip reaches the same stops at the same times no matter where it was boarded so
+  // once a trip has been ridden through a stop in this round it need not be ridden again
+  std::unordered_map<uint32_t, std::unordered_set<uint64_t>> ridden;
+
+  std::vector<uint32_t> arrivals;
+  std::unique_ptr<TransitDeparture> departure;
+  bool has_time_restrictions;
+  for (const auto& boarding : boardings) {
+    // Get the stop and check it isnt excluded
+    const GraphTile* tile = graphreader.GetGraphTile(boarding.first);
+    if (tile == nullptr) {
+      continue;
+    }
+    if (processed_tiles_.insert(tile->id().tileid()).second) {
+      tc->AddToExcludeList(tile);
+    }
+    const NodeInfo* nodeinfo = tile->node(boarding.first);
+    if (tc->IsExcluded(tile, nodeinfo)) {
+      continue;
+    }
+
+    // The date has to come from the transit tiles as the schedules are relative to
+    // when the transit data was fetched
+    if (!date_set_) {
+      uint32_t date =
+          DateTime::days_from_pivot_date(DateTime::get_formatted_date(origin_date_time_));
+      dow_ = DateTime::day_of_week_mask(origin_date_time_);
+      uint32_t date_created = tile->header()->date_created();
+      if (date < date_created) {
+        date_before_tile_ = true;
+      } else {
+        day_ = date - date_created;
+      }
+      date_set_ = true;
+    }
+
+    // Allow time to transfer. Staying at the stop after a ride is quicker than walking
+    // to it and there is no transfer on the first ride
+    const MMEdgeLabel pred = edgelabels_[boarding.second];
+    uint32_t transfer_time = pred.mode() == TravelMode::kPublicTransit
+                                 ? kInStationTransferTime
+                                 : pred.has_transit() ? tc->TransferCost().secs
+                                                      : tc->DefaultTransferCost().secs;
+    uint32_t localtime = LocalTime(pred.cost().secs + transfer_time, nodeinfo->timezone());
+
+    // Board the next departure of each line leaving the stop
+    GraphId edgeid(boarding.first.tileid(), boarding.first.level(), nodeinfo->edge_index());
+    const DirectedEdge* directededge = tile->directededge(nodeinfo->edge_index());
+    for (uint32_t i = 0; i < nodeinfo->edge_count(); ++i, ++directededge, ++edgeid) {
+      if (!directededge->IsTransitLine() ||
+          !tc->Allowed(directededge, pred, tile, edgeid, 0, 0, has_time_restrictions) ||
+          tc->IsExcluded(tile, directededge)) {
+        continue;
+      }
+      if (!copy_departure(tile->GetNextDeparture(directededge->lineid(), localtime, day_, dow_,
+                                                 date_before_tile_, tc->wheelchair(),
+                                                 tc->bicycle()),
+                          departure)) {
+        continue;
+      }
+
+      // Ride the trip until it ends, it reaches a stop it has already been ridden
+      // through or it can no longer improve anything
+      auto& ridden_stops = ridden[departure->tripid()];
+      GraphId stop = boarding.first;
+      uint32_t pred_idx = boarding.second;
+      const GraphTile* ride_tile = tile;
+      const DirectedEdge* ride_edge = directededge;
+      GraphId ride_edgeid = edgeid;
+      uint32_t ride_localtime = localtime;
+      uint32_t tz_index = nodeinfo->timezone();
+      while (ridden_stops.insert(stop).second) {
+        // Arrival at the next stop
+        const MMEdgeLabel& ride_pred = edgelabels_[pred_idx];
+        float secs =
+            ElapsedTime(departure->departure_time() + departure->elapsed_time(), tz_index);
+        if (secs > Bound()) {
+          break;
+        }
+        Cost cost = tc->EdgeCost(ride_edge, departure.get(), ride_localtime);
+        cost.cost += ride_pred.cost().cost;
+        cost.secs = secs;
+        if (ride_pred.mode() == TravelMode::kPedestrian) {
+          cost.cost += tc->TransitionCost(ride_edge, nodeinfo, ride_pred).cost;
+        }
+        uint32_t idx = edgelabels_.size();
+        edgelabels_.emplace_back(pred_idx, ride_edgeid, ride_edge, cost, cost.secs, 0.0f,
+                                 TravelMode::kPublicTransit, 0, departure->tripid(), stop,
+                                 departure->blockid(), 0, true, Cost{});
+        stop = ride_edge->endnode();
+        if (ImproveStop(stop, idx)) {
+          arrivals.push_back(idx);
+        }
+        pred_idx = idx;
+        if (expansion_callback_) {
+          expansion_callback_(graphreader, "raptor", ride_edgeid, "s", false);
+        }
+
+        // Find where the trip departs to from this stop
+        ride_tile = graphreader.GetGraphTile(stop);
+        if (ride_tile == nullptr) {
+          break;
+        }
+        const NodeInfo* ride_node = ride_tile->node(stop);
+        tz_index = ride_node->timezone();
+        ride_localtime = LocalTime(secs, tz_index);
+        uint32_t tripid = departure->tripid();
+        departure.reset();
+        ride_edgeid = GraphId(stop.tileid(), stop.level(), ride_node->edge_index());
+        ride_edge = ride_tile->directededge(ride_node->edge_index());
+        for (uint32_t j = 0; j < ride_node->edge_count(); ++j, ++ride_edge, ++ride_edgeid) {
+          if (ride_edge->IsTransitLine() && !tc->IsExcluded(ride_tile, ride_edge) &&
+              copy_departure(ride_tile->GetTransitDeparture(ride_edge->lineid(), tripid,
+                                                            ride_localtime),
+                             departure)) {
+            break;
+          }
+        }
+        if (!departure) {
+          break;
+        }
+      }
+    }
+  }
+  return arrivals;
+}
+
+// Walk from the origin or from the stops reached by this round's rides.
+void RaptorPathAlgorithm::Walk(GraphReader& graphreader,
+                               const std::vector<uint32_t>& seeds,
+                               const std::shared_ptr<DynamicCost>& pc) {
+  destination_arrivals_.push_back({kInvalidLabel, Cost{}});
+  if (seeds.empty()) {
+    return;
+  }
+
+  // Labels are sorted by time. Each walking phase has its own edge status so edges
+  // can be walked again in later rounds (at an earlier or later time)
+  float mintime = std::numeric_limits<float>::max();
+  for (const auto seed : seeds) {
+    mintime = std::min(mintime, edgelabels_[seed].cost().secs);
+  }
+  const auto edgetime = [this](const uint32_t label) { return edgelabels_[label].sortcost(); };
+  if (adjacencylist_) {
+    adjacencylist_->reuse(mintime, kBucketCount, 1, edgetime);
+  } else {
+    adjacencylist_.reset(new DoubleBucketQueue(mintime, kBucketCount, 1, edgetime));
+  }
+  edgestatus_.clear();
+
+  // Origin edges are walked along, rides are walked from their arrival stop
+  for (const auto seed : seeds) {
+    if (edgelabels_[seed].origin()) {
+      adjacencylist_->add(seed);
+    } else {
+      const MMEdgeLabel pred = edgelabels_[seed];
+      ExpandWalk(graphreader, pred.endnode(), pred, seed, pc, false);
+    }
+  }
+
+  size_t total_labels = 0;
+  uint32_t predindex;
+  while ((predindex = adjacencylist_->pop()) != kInvalidLabel) {
+    // Allow this process to be aborted
+    size_t current_labels = edgelabels_.size();
+    if (interrupt &&
+        total_labels / kInterruptIterationsInterval < current_labels / kInterruptIterationsInterval) {
+      (*interrupt)();
+    }
+    total_labels = current_labels;
+
+    // Everything left in the queue arrives after what we have already found
+    const MMEdgeLabel pred = edgelabels_[predindex];
+    if (pred.cost().secs > Bound()) {
+      break;
+    }
+
+    // Mark the edge as permanently labeled. Do not do this for an origin
+    // edge (this will allow loops/around the block cases)
+    if (!pred.origin()) {
+      edgestatus_.Update(pred.edgeid(), EdgeSet::kPermanent);
+    }
+    if (expansion_callback_) {
+      expansion_callback_(graphreader, "raptor", pred.edgeid(), "s", false);
+    }
+    if (walked_ != nullptr) {
+      float secs0 = pred.predecessor() == kInvalidLabel
+                        ? 0.0f
+                        : edgelabels_[pred.predecessor()].cost().secs;
+      (*walked_)(pred, secs0);
+    }
+
+    // Check if the destination is reached. A path starting on the destination edge
+    // must be trivial (reach the destination along this one edge)
+    auto p = destinations_.find(pred.edgeid());
+    if (p != destinations_.end()) {
+      Cost cost = pred.cost() - p->second;
+      auto& arrival = destination_arrivals_.back();
+      if (cost.secs >= 0.0f && cost.secs < Bound() &&
+          (arrival.label == kInvalidLabel || cost.secs < arrival.cost.secs)) {
+        arrival = {predindex, cost};
+        if (expansion_callback_) {
+          expansion_callback_(graphreader, "raptor", pred.edgeid(), "c", false);
+        }
+      }
+    }
+
+    // Expand from the end node of the predecessor edge
+    ExpandWalk(graphreader, pred.endnode(), pred, predindex, pc, false);
+  }
+}
+
+// Expand from a node while walking.
+void RaptorPathAlgorithm::ExpandWalk(GraphReader& graphreader,
+                                     const GraphId& node,
+                                     const MMEdgeLabel& pred,
+                                     const uint32_t pred_idx,
+                                     const std::shared_ptr<DynamicCost>& pc,
+                                     const bool from_transition) {
+  // Get the tile and the node info. Skip if tile is null (can happen
+  // with regional data sets) or if no access at the node.
+  const GraphTile* tile = graphreader.GetGraphTile(node);
+  if (tile == nullptr) {
+    return;
+  }
+  const NodeInfo* nodeinfo = tile->node(node);
+  if (!pc->Allowed(nodeinfo)) {
+    return;
+  }
+
+  // Reaching a stop on foot. After transit this is a transfer which is limited in distance
+  if (nodeinfo->type() == NodeType::kMultiUseTransitPlatform &&
+      pred.mode() == TravelMode::kPedestrian &&
+      (!pred.has_transit() || pred.path_distance() <= max_transfer_distance_)) {
+    ImproveStop(node, pred_idx);
+  }
+
+  GraphId edgeid(node.tileid(), node.level(), nodeinfo->edge_index());
+  EdgeStatusInfo* es = edgestatus_.GetPtr(edgeid, tile);
+  const DirectedEdge* directededge = tile->directededge(nodeinfo->edge_index());
+  for (uint32_t i = 0; i < nodeinfo->edge_count(); i++, directededge++, ++edgeid, ++es) {
+    // Transit lines are ridden, not walked. Skip shortcuts and edges that are
+    // permanently labeled (best path already found to this directed edge).
+    bool has_time_restrictions;
+    if (directededge->IsTransitLine() || directededge->is_shortcut() ||
+        es->set() == EdgeSet::kPermanent ||
+        !pc->Allowed(directededge, pred, tile, edgeid, 0, 0, has_time_restrictions)) {
+      continue;
+    }
+
+    // Prevent going from one transit connection directly to another at a transit
+    // stop - this is like entering a station and exiting without getting on transit
+    if (nodeinfo->type() == NodeType::kTransitEgress && pred.use() == Use::kTransitConnection &&
+        directededge->use() == Use::kTransitConnection) {
+      continue;
+    }
+
+    // No transition cost when getting off of transit
+    Cost transition_cost = pred.mode() == TravelMode::kPedestrian
+                               ? pc->TransitionCost(directededge, nodeinfo, pred)
+                               : Cost{};
+    Cost newcost = pred.cost() + pc->EdgeCost(directededge, tile) + transition_cost;
+    uint32_t walking_distance = pred.path_distance() + directededge->length();
+    if (newcost.secs > Bound()) {
+      continue;
+    }
+
+    // Check if edge is temporarily labeled and this path is quicker
+    if (es->set() == EdgeSet::kTemporary) {
+      MMEdgeLabel& lab = edgelabels_[es->index()];
+      if (newcost.secs < lab.cost().secs) {
+        adjacencylist_->decrease(es->index(), newcost.secs);
+        lab.Update(pred_idx, newcost, newcost.secs, walking_distance, 0, 0, transition_cost,
+                   has_time_restrictions);
+        if (expansion_callback_) {
+          expansion_callback_(graphreader, "raptor", edgeid, "r", false);
+        }
+      }
+      continue;
+    }
+
+    // Add edge label, add to the adjacency list and set edge status
+    uint32_t idx = edgelabels_.size();
+    *es = {EdgeSet::kTemporary, idx};
+    edgelabels_.emplace_back(pred_idx, edgeid, directededge, newcost, newcost.secs, 0.0f,
+                             TravelMode::kPedestrian, walking_distance, 0, pred.prior_stopid(), 0,
+                             0, pred.has_transit(), transition_cost, has_time_restrictions);
+    adjacencylist_->add(idx);
+    if (expansion_callback_) {
+      expansion_callback_(graphreader, "raptor", edgeid, "r", false);
+    }
+  }
+
+  // Handle transitions - expand from the end node each transition
+  if (!from_transition && nodeinfo->transition_count() > 0) {
+    const NodeTransition* trans = tile->transition(nodeinfo->transition_index());
+    for (uint32_t i = 0; i < nodeinfo->transition_count(); ++i, ++trans) {
+      ExpandWalk(graphreader, trans->endnode(), pred, pred_idx, pc, true);
+    }
+  }
+}
+
+// Update the earliest arrival at a stop and mark it for the next round.
+bool RaptorPathAlgorithm::ImproveStop(const GraphId& stop, const uint32_t label) {
+  float secs = edgelabels_[label].cost().secs;
+  if (secs > Bound()) {
+    return false;
+  }
+  auto inserted = stop_arrivals_.emplace(stop, label);
+  if (!inserted.second) {
+    if (edgelabels_[inserted.first->second].cost().secs <= secs) {
+      return false;
+    }
+    inserted.first->second = label;
+  }
+  marked_stops_.insert(stop);
+  return true;
+}
+
+// The time beyond which nothing can improve the result.
+float RaptorPathAlgorithm::Bound() const {
+  float bound = static_cast<float>(max_seconds_);
+  for (const auto& arrival : destination_arrivals_) {
+    if (arrival.label != kInvalidLabel) {
+      bound = std::min(bound, arrival.cost.secs);
+    }
+  }
+  return bound;
+}
+
+// Local time at a node with the given timezone.
+uint32_t RaptorPathAlgorithm::LocalTime(const float secs, const uint32_t tz_index) {
+  uint32_t localtime = start_time_ + static_cast<uint32_t>(secs);
+  if (static_cast<int>(tz_index) == start_tz_index_) {
+    return localtime;
+  }
+  auto diff = tz_diffs_.find(tz_index);
+  if (diff == tz_diffs_.end()) {
+    diff = tz_diffs_
+               .emplace(tz_index, DateTime::timezone_diff(
+                                      localtime, DateTime::get_tz_db().from_index(start_tz_index_),
+                                      DateTime::get_tz_db().from_index(tz_index)))
+               .first;
+  }
+  return localtime + diff->second;
+}
+
+// Seconds from the start given a local time at a node with the given timezone.
+float RaptorPathAlgorithm::ElapsedTime(const uint32_t localtime, const uint32_t tz_index) {
+  int diff = static_cast<int>(LocalTime(0, tz_index)) - static_cast<int>(start_time_);
+  return static_cast<float>(static_cast<int>(localtime) - diff - static_cast<int>(start_time_));
+}
+
+// Form the path from the edge labels.
+std::vector<PathInfo> RaptorPathAlgorithm::FormPath(const destination_t& dest) {
+  // Metrics to track
+  LOG_DEBUG("path_cost::" + std::to_string(dest.cost.cost));
+  LOG_DEBUG("path_iterations::" + std::to_string(edgelabels_.size()));
+
+  // Work backwards from the destination
+  std::vector<PathInfo> path;
+  for (auto edgelabel_index = dest.label; edgelabel_index != kInvalidLabel;
+       edgelabel_index = edgelabels_[edgelabel_index].predecessor()) {
+    const MMEdgeLabel& edgelabel = edgelabels_[edgelabel_index];
+    path.emplace_back(edgelabel.mode(), edgelabel.cost().secs, edgelabel.edgeid(), edgelabel.tripid(),
+                      edgelabel.cost().cost, edgelabel.has_time_restriction(),
+                      edgelabel.transition_secs());
+
+    // Check if this is a ferry
+    if (edgelabel.use() == Use::kFerry) {
+      has_ferry_ = true;
+    }
+  }
+
+  // The path ends part way along the destination edge
+  path.front().elapsed_time = dest.cost.secs;
+  path.front().elapsed_cost = dest.cost.cost;
+
+  // Reverse the list and return
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+} // namespace thor
+} // namespace valhalla
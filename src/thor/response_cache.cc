@@ -0,0 +1,256 @@
+#include "thor/response_cache.h"
+#include "baldr/cache_utils.h"
+#include "filesystem.h"
+#include "midgard/logging.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace {
+
+// Extension of the spilled responses so that nothing else in the directory is touched
+const std::string kSpillExtension = ".response";
+
+// FNV-1a, the file names have to be the same for every process
+uint64_t hash(const std::string& key) {
+  uint64_t h = 14695981039346656037ull;
+  for (auto c : key) {
+    h ^= static_cast<uint8_t>(c);
+    h *= 1099511628211ull;
+  }
+  return h;
+}
+
+} // namespace
+
+namespace valhalla {
+namespace thor {
+
+ResponseCache::ResponseCache(const size_t max_size,
+                             const std::string& spill_dir,
+                             const size_t max_spill_size)
+    : max_size_(max_size), size_(0), spill_dir_(max_spill_size ? spill_dir : ""),
+      max_spill_size_(max_spill_size), spill_size_(0), hits_(0), misses_(0) {
+  if (spill_dir_.empty()) {
+    return;
+  }
+  if (!filesystem::create_directories(spill_dir_)) {
+    LOG_WARN("Cannot create the response cache directory " + spill_dir_);
+    spill_dir_.clear();
+    return;
+  }
+
+  // Responses spilled by an earlier process are still valid, their keys have the dataset id
+  for (filesystem::directory_iterator i(spill_dir_), end; i != end; ++i) {
+    const auto& file = i->path().string();
+    if (i->is_regular_file() && file.size() > kSpillExtension.size() &&
+        file.compare(file.size() - kSpillExtension.size(), kSpillExtension.size(),
+                     kSpillExtension) == 0) {
+      std::ifstream in(file, std::ios::binary | std::ios::ate);
+      AddSpilled(file, static_cast<size_t>(in.tellg()));
+    }
+  }
+}
+
+std::shared_ptr<ResponseCache> ResponseCache::Shared(const boost::property_tree::ptree& config) {
+  auto max_size = config.get<size_t>("thor.response_cache_size", 0);
+  if (!max_size) {
+    return nullptr;
+  }
+  auto spill_dir = config.get<std::string>("thor.response_cache_dir", "");
+  auto max_spill_size = config.get<size_t>("thor.response_cache_dir_size", 0);
+  auto source = baldr::cache_tile_source(config) + "|" + spill_dir;
+  return baldr::shared_cache<ResponseCache>(source, [&]() {
+    return std::make_shared<ResponseCache>(max_size, spill_dir, max_spill_size);
+  });
+}
+
+// The key is the deterministically serialized request, which includes the action, the format and
+// the id that is echoed in the response, and the dataset id of the tiles
+std::string ResponseCache::Key(const Options& options, baldr::GraphReader& reader) {
+  if (options.locations_size() == 0) {
+    return {};
+  }
+  const auto& ll = options.locations(0).ll();
+  const auto* tile = reader.GetGraphTile(midgard::PointLL(ll.lng(), ll.lat()));
+  if (!tile) {
+    return {};
+  }
+
+  Options request = options;
+  request.clear_do_not_track();
+  std::string key = baldr::cache_serialize(request);
+  key += std::to_string(tile->header()->dataset_id());
+  key += baldr::cache_time_bucket(options);
+  return key;
+}
+
+bool ResponseCache::Find(const std::string& key, std::string& response) {
+  std::shared_ptr<const std::string> cached;
+  {
+    std::lock_guard<std::mutex> _(lock_);
+    auto found = index_.find(key);
+    if (found != index_.end()) {
+      ++hits_;
+      entries_.splice(entries_.begin(), entries_, found->second);
+      cached = found->second->response;
+    }
+  }
+  if (cached) {
+    response = *cached;
+    return true;
+  }
+
+  // The file holds the key before the response so that a hash collision is a miss
+  if (!spill_dir_.empty()) {
+    std::ifstream in(File(key), std::ios::binary);
+    uint64_t key_size = 0;
+    std::string spilled_key;
+    if (in.read(reinterpret_cast<char*>(&key_size), sizeof(key_size)) && key_size == key.size()) {
+      spilled_key.resize(key_size);
+      if (in.read(&spilled_key[0], key_size) && spilled_key == key) {
+        response.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        entries_t evicted;
+        {
+          std::lock_guard<std::mutex> _(lock_);
+          ++hits_;
+          evicted = Add({key, std::make_shared<const std::string>(response), 0});
+        }
+        Spill(evicted);
+        return true;
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> _(lock_);
+  ++misses_;
+  return false;
+}
+
+void ResponseCache::Insert(const std::string& key, const std::string& response) {
+  entries_t evicted;
+  {
+    std::lock_guard<std::mutex> _(lock_);
+    evicted = Add({key, std::make_shared<const std::string>(response), 0});
+  }
+  Spill(evicted);
+}
+
+uint64_t ResponseCache::hits() const {
+  std::lock_guard<std::mutex> _(lock_);
+  return hits_;
+}
+
+uint64_t ResponseCache::misses() const {
+  std::lock_guard<std::mutex> _(lock_);
+  return misses_;
+}
+
+size_t ResponseCache::size() const {
+  std::lock_guard<std::mutex> _(lock_);
+  return size_;
+}
+
+size_t ResponseCache::spill_size() const {
+  std::lock_guard<std::mutex> _(lock_);
+  return spill_size_;
+}
+
+std::string ResponseCache::File(const std::string& key) const {
+  std::ostringstream file;
+  file << spill_dir_ << filesystem::path::preferred_separator << std::hex << std::setw(16)
+       << std::setfill('0') << hash(key) << kSpillExtension;
+  return file.str();
+}
+
+ResponseCache::entries_t ResponseCache::Add(entry_t&& entry) {
+  entries_t evicted;
+  auto found = index_.find(entry.key);
+  if (found != index_.end()) {
+    size_ -= found->second->size;
+    entries_.erase(found->second);
+    index_.erase(found);
+  }
+
+  // Responses larger than the memory can only be spilled
+  entry.size = baldr::kCacheEntryOverhead + entry.key.size() + entry.response->size();
+  if (entry.size > max_size_) {
+    evicted.emplace_back(std::move(entry));
+    return evicted;
+  }
+  size_ += entry.size;
+  entries_.emplace_front(std::move(entry));
+  index_.emplace(entries_.front().key, entries_.begin());
+  while (size_ > max_size_) {
+    size_ -= entries_.back().size;
+    index_.erase(entries_.back().key);
+    evicted.splice(evicted.end(), entries_, std::prev(entries_.end()));
+  }
+  return evicted;
+}
+
+void ResponseCache::Spill(const entries_t& evicted) {
+  if (spill_dir_.empty()) {
+    return;
+  }
+  for (const auto& entry : evicted) {
+    auto file = File(entry.key);
+    size_t size = sizeof(uint64_t) + entry.key.size() + entry.response->size();
+    {
+      std::lock_guard<std::mutex> _(lock_);
+      auto found = spilled_index_.find(file);
+      if (found != spilled_index_.end()) {
+        spilled_.splice(spilled_.begin(), spilled_, found->second);
+        continue;
+      }
+    }
+    if (size > max_spill_size_) {
+      continue;
+    }
+
+    // Write it to the side and move it in place so readers never see part of a file
+    auto partial = file + ".tmp";
+    {
+      std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+      uint64_t key_size = entry.key.size();
+      out.write(reinterpret_cast<const char*>(&key_size), sizeof(key_size));
+      out.write(entry.key.data(), entry.key.size());
+      out.write(entry.response->data(), entry.response->size());
+      if (!out) {
+        LOG_WARN("Cannot write the response cache file " + partial);
+        filesystem::remove(partial);
+        continue;
+      }
+    }
+    if (std::rename(partial.c_str(), file.c_str()) != 0) {
+      filesystem::remove(partial);
+      continue;
+    }
+    std::lock_guard<std::mutex> _(lock_);
+    AddSpilled(file, size);
+  }
+}
+
+void ResponseCache::AddSpilled(const std::string& file, const size_t size) {
+  auto found = spilled_index_.find(file);
+  if (found != spilled_index_.end()) {
+    spill_size_ -= found->second->size;
+    spilled_.erase(found->second);
+    spilled_index_.erase(found);
+  }
+  spill_size_ += size;
+  spilled_.push_front({file, size});
+  spilled_index_.emplace(file, spilled_.begin());
+  while (spill_size_ > max_spill_size_) {
+    spill_size_ -= spilled_.back().size;
+    filesystem::remove(spilled_.back().file);
+    spilled_index_.erase(spilled_.back().file);
+    spilled_.pop_back();
+  }
+}
+
+} // namespace thor
+} // namespace valhalla
@@ -129,6 +129,14 @@ namespace valhalla {
 namespace thor {
 
 std::string thor_worker_t::expansion(Api& request) {
+  // identical requests are answered with the response to the first one
+  std::string response;
+  auto response_key =
+      response_cache ? ResponseCache::Key(request.options(), *reader) : std::string();
+  if (!response_key.empty() && response_cache->Find(response_key, response)) {
+    return response;
+  }
+
   // default the expansion geojson so its easy to add to as we go
   rapidjson::Document dom;
   dom.SetObject();
@@ -179,6 +187,7 @@ std::string thor_worker_t::expansion(Api& request) {
   // tell all the algorithms how to track expansion
   for (auto* alg : std::vector<PathAlgorithm*>{
            &multi_modal_astar,
+           &raptor,
            &timedep_forward,
            &timedep_reverse,
            &astar,
@@ -193,6 +202,7 @@ std::string thor_worker_t::expansion(Api& request) {
   // tell all the algorithms to stop tracking the expansion
   for (auto* alg : std::vector<PathAlgorithm*>{
            &multi_modal_astar,
+           &raptor,
            &timedep_forward,
            &timedep_reverse,
            &astar,
@@ -202,7 +212,11 @@ std::string thor_worker_t::expansion(Api& request) {
   }
 
   // serialize it
-  return rapidjson::to_string(dom, 5);
+  response = rapidjson::to_string(dom, 5);
+  if (!response_key.empty()) {
+    response_cache->Insert(response_key, response);
+  }
+  return response;
 }
 
 void thor_worker_t::route(Api& request) {
@@ -232,6 +246,10 @@ thor::PathAlgorithm* thor_worker_t::get_path_algorithm(const std::string& routet
                                                        const valhalla::Location& destination) {
   // Have to use multimodal for transit based routing
   if (routetype == "multimodal" || routetype == "transit") {
+    if (use_raptor) {
+      raptor.set_interrupt(interrupt);
+      return &raptor;
+    }
     multi_modal_astar.set_interrupt(interrupt);
     return &multi_modal_astar;
   }
@@ -165,7 +165,7 @@ inline bool TimeDepForward::ExpandForwardInner(GraphReader& graphreader,
   }
 
   // Compute the cost to the end of this edge
-  auto edge_cost = costing_->EdgeCost(meta.edge, tile, seconds_of_week);
+  auto edge_cost = costing_->CachedEdgeCost(meta.edge, tile, seconds_of_week);
   auto transition_cost = costing_->TransitionCost(meta.edge, nodeinfo, pred);
   Cost newcost = pred.cost() + edge_cost + transition_cost;
 
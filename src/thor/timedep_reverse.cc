@@ -35,8 +35,9 @@ TimeDepReverse::~TimeDepReverse() {
 }
 
 void TimeDepReverse::Clear() {
-  AStarPathAlgorithm::Clear();
-  edgelabels_rev_.clear();
+  const bool release =
+      ClearWorkingMemory(WorkingMemory::Bytes(edgelabels_rev_), !edgelabels_rev_.empty());
+  WorkingMemory::Clear(edgelabels_rev_, release);
 }
 
 // Initialize prior to finding best path
@@ -60,7 +61,11 @@ void TimeDepReverse::Init(const midgard::PointLL& origll, const midgard::PointLL
   // Set bucket size and cost range based on DynamicCost.
   uint32_t bucketsize = costing_->UnitSize();
   float range = kBucketCount * bucketsize;
-  adjacencylist_.reset(new DoubleBucketQueue(mincost, range, bucketsize, edgecost));
+  if (adjacencylist_) {
+    adjacencylist_->reuse(mincost, range, bucketsize, edgecost);
+  } else {
+    adjacencylist_.reset(new DoubleBucketQueue(mincost, range, bucketsize, edgecost));
+  }
   edgestatus_.clear();
 
   // Get hierarchy limits from the costing. Get a copy since we increment
@@ -221,7 +226,7 @@ inline bool TimeDepReverse::ExpandReverseInner(GraphReader& graphreader,
   // can properly recover elapsed time on the reverse path.
   auto transition_cost =
       costing_->TransitionCostReverse(meta.edge->localedgeidx(), nodeinfo, opp_edge, opp_pred_edge);
-  auto edge_cost = costing_->EdgeCost(opp_edge, t2, seconds_of_week);
+  auto edge_cost = costing_->CachedEdgeCost(opp_edge, t2, seconds_of_week);
   Cost newcost = pred.cost() + edge_cost;
   newcost.cost += transition_cost.cost;
 
@@ -487,7 +492,7 @@ void TimeDepReverse::SetOrigin(GraphReader& graphreader,
     const DirectedEdge* opp_dir_edge = graphreader.GetOpposingEdge(edgeid);
 
     // Get cost
-    Cost cost = costing_->EdgeCost(directededge, tile, seconds_of_week) * edge.percent_along();
+    Cost cost = costing_->CachedEdgeCost(directededge, tile, seconds_of_week) * edge.percent_along();
     float dist = astarheuristic_.GetDistance(tile->get_node_ll(opp_dir_edge->endnode()));
 
     // We need to penalize this location based on its score (distance in meters from input)
@@ -511,7 +516,7 @@ void TimeDepReverse::SetOrigin(GraphReader& graphreader,
             // remaining must be zero.
             GraphId id(dest_path_edge.graph_id());
             const DirectedEdge* dest_edge = tile->directededge(id);
-            Cost remainder_cost = costing_->EdgeCost(dest_edge, tile, seconds_of_week) *
+            Cost remainder_cost = costing_->CachedEdgeCost(dest_edge, tile, seconds_of_week) *
                                   (dest_path_edge.percent_along());
             // Remove the cost of the final "unused" part of the destination edge
             cost -= remainder_cost;
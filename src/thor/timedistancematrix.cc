@@ -1,6 +1,9 @@
 #include "thor/timedistancematrix.h"
 #include "midgard/logging.h"
 #include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
 #include <vector>
 
 using namespace valhalla::baldr;
@@ -102,7 +105,7 @@ void TimeDistanceMatrix::ExpandForward(GraphReader& graphreader,
 
     // Get cost and update distance
     auto transition_cost = costing_->TransitionCost(directededge, nodeinfo, pred);
-    Cost newcost = pred.cost() + costing_->EdgeCost(directededge, tile) + transition_cost;
+    Cost newcost = pred.cost() + costing_->CachedEdgeCost(directededge, tile) + transition_cost;
     uint32_t distance = pred.path_distance() + directededge->length();
 
     // Check if edge is temporarily labeled and this path has less cost. If
@@ -263,7 +266,7 @@ void TimeDistanceMatrix::ExpandReverse(GraphReader& graphreader,
     // Get cost. Use the opposing edge for EdgeCost.
     auto transition_cost = costing_->TransitionCostReverse(directededge->localedgeidx(), nodeinfo,
                                                            opp_edge, opp_pred_edge);
-    Cost newcost = pred.cost() + costing_->EdgeCost(opp_edge, t2) + transition_cost;
+    Cost newcost = pred.cost() + costing_->CachedEdgeCost(opp_edge, t2) + transition_cost;
     uint32_t distance = pred.path_distance() + directededge->length();
 
     // Check if edge is temporarily labeled and this path has less cost. If
@@ -406,6 +409,66 @@ std::vector<TimeDistance> TimeDistanceMatrix::SourceToTarget(
   return many_to_many;
 }
 
+// Run the rows of SourceToTarget on a pool of threads. Rows are handed out in
+// order and each is stored in its own slot so the threads never share results.
+std::vector<TimeDistance> TimeDistanceMatrix::SourceToTarget(
+    std::vector<TimeDistanceMatrix>& pool,
+    const std::vector<const std::shared_ptr<sif::DynamicCost>*>& mode_costings,
+    const google::protobuf::RepeatedPtrField<valhalla::Location>& source_location_list,
+    const google::protobuf::RepeatedPtrField<valhalla::Location>& target_location_list,
+    baldr::GraphReader& graphreader,
+    const sif::TravelMode mode,
+    const float max_matrix_distance) {
+  // Same choice of rows as the serial version
+  const bool one_to_many = source_location_list.size() <= target_location_list.size();
+  const auto& row_locations = one_to_many ? source_location_list : target_location_list;
+  const auto& column_locations = one_to_many ? target_location_list : source_location_list;
+
+  std::vector<std::vector<TimeDistance>> rows(row_locations.size());
+  std::vector<std::exception_ptr> errors(pool.size());
+  std::atomic<int> next_row(0);
+  auto run = [&](const size_t state) {
+    auto& matrix = pool[state];
+    try {
+      for (int r = next_row++; r < row_locations.size(); r = next_row++) {
+        rows[r] = one_to_many ? matrix.OneToMany(row_locations.Get(r), column_locations,
+                                                 graphreader, mode_costings[state], mode,
+                                                 max_matrix_distance)
+                              : matrix.ManyToOne(row_locations.Get(r), column_locations,
+                                                 graphreader, mode_costings[state], mode,
+                                                 max_matrix_distance);
+        matrix.Clear();
+      }
+    } catch (...) {
+      // Stop handing out rows, the error is rethrown once all threads are done
+      errors[state] = std::current_exception();
+      next_row = row_locations.size();
+      matrix.Clear();
+    }
+  };
+  size_t nthreads = std::max<size_t>(std::min<size_t>(pool.size(), rows.size()), 1);
+  std::vector<std::shared_ptr<std::thread>> threads(nthreads - 1);
+  for (size_t i = 0; i < threads.size(); ++i) {
+    threads[i].reset(new std::thread(run, i + 1));
+  }
+  run(0);
+  for (auto& thread : threads) {
+    thread->join();
+  }
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  // Concatenate the rows
+  std::vector<TimeDistance> many_to_many;
+  for (const auto& row : rows) {
+    many_to_many.insert(many_to_many.end(), row.begin(), row.end());
+  }
+  return many_to_many;
+}
+
 // Add edges at the origin to the adjacency list
 void TimeDistanceMatrix::SetOriginOneToMany(GraphReader& graphreader,
                                             const valhalla::Location& origin) {
@@ -442,7 +505,7 @@ void TimeDistanceMatrix::SetOriginOneToMany(GraphReader& graphreader,
 
     // Get cost. Use this as sortcost since A* is not used for time+distance
     // matrix computations. . Get distance along the remainder of this edge.
-    Cost cost = costing_->EdgeCost(directededge, tile) * (1.0f - edge.percent_along());
+    Cost cost = costing_->CachedEdgeCost(directededge, tile) * (1.0f - edge.percent_along());
     uint32_t d = static_cast<uint32_t>(directededge->length() * (1.0f - edge.percent_along()));
 
     // We need to penalize this location based on its score (distance in meters from input)
@@ -491,7 +554,7 @@ void TimeDistanceMatrix::SetOriginManyToOne(GraphReader& graphreader,
 
     // Get cost. Use this as sortcost since A* is not used for time
     // distance matrix computations. Get the distance along the edge.
-    Cost cost = costing_->EdgeCost(opp_dir_edge, endtile) * edge.percent_along();
+    Cost cost = costing_->CachedEdgeCost(opp_dir_edge, endtile) * edge.percent_along();
     uint32_t d = static_cast<uint32_t>(directededge->length() * edge.percent_along());
 
     // We need to penalize this location based on its score (distance in meters from input)
@@ -542,7 +605,7 @@ void TimeDistanceMatrix::SetDestinations(
       GraphId id(static_cast<GraphId>(edge.graph_id()));
       const GraphTile* tile = graphreader.GetGraphTile(id);
       const DirectedEdge* directededge = tile->directededge(id);
-      float c = costing_->EdgeCost(directededge, tile).cost;
+      float c = costing_->CachedEdgeCost(directededge, tile).cost;
 
       // We need to penalize this location based on its score (distance in meters from input)
       // We assume the slowest speed you could travel to cover that distance to start/end the route
@@ -588,7 +651,7 @@ void TimeDistanceMatrix::SetDestinationsManyToOne(
       GraphId id(static_cast<GraphId>(edge.graph_id()));
       const GraphTile* tile = graphreader.GetGraphTile(id);
       const DirectedEdge* directededge = tile->directededge(id);
-      float c = costing_->EdgeCost(directededge, tile).cost;
+      float c = costing_->CachedEdgeCost(directededge, tile).cost;
 
       // We need to penalize this location based on its score (distance in meters from input)
       // We assume the slowest speed you could travel to cover that distance to start/end the route
@@ -649,7 +712,7 @@ bool TimeDistanceMatrix::UpdateDestinations(
     // Get the cost. The predecessor cost is cost to the end of the edge.
     // Subtract the partial remaining cost and distance along the edge.
     float remainder = dest_edge->second;
-    Cost newcost = pred.cost() - (costing_->EdgeCost(edge, tile) * remainder);
+    Cost newcost = pred.cost() - (costing_->CachedEdgeCost(edge, tile) * remainder);
     if (newcost.cost < dest.best_cost.cost) {
       dest.best_cost = newcost;
       dest.distance = pred.path_distance() - (edge->length() * remainder);
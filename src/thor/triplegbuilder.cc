@@ -58,38 +58,38 @@ GetAdminIndex(const AdminInfo& admin_info,
   return admin_index;
 }
 
-void AssignAdmins(const AttributesController& controller,
+void AssignAdmins(const FieldPlan& plan,
                   TripLeg& trip_path,
                   const std::vector<AdminInfo>& admin_info_list) {
-  if (controller.category_attribute_enabled(kAdminCategory)) {
+  if (plan.admins) {
     // Assign the admins
     for (const auto& admin_info : admin_info_list) {
       TripLeg_Admin* trip_admin = trip_path.add_admin();
 
       // Set country code if requested
-      if (controller.attributes.at(kAdminCountryCode)) {
+      if (plan.controller.attributes.at(kAdminCountryCode)) {
         trip_admin->set_country_code(admin_info.country_iso());
       }
 
       // Set country text if requested
-      if (controller.attributes.at(kAdminCountryText)) {
+      if (plan.controller.attributes.at(kAdminCountryText)) {
         trip_admin->set_country_text(admin_info.country_text());
       }
 
       // Set state code if requested
-      if (controller.attributes.at(kAdminStateCode)) {
+      if (plan.controller.attributes.at(kAdminStateCode)) {
         trip_admin->set_state_code(admin_info.state_iso());
       }
 
       // Set state text if requested
-      if (controller.attributes.at(kAdminStateText)) {
+      if (plan.controller.attributes.at(kAdminStateText)) {
         trip_admin->set_state_text(admin_info.state_text());
       }
     }
   }
 }
 
-void SetShapeAttributes(const AttributesController& controller,
+void SetShapeAttributes(const FieldPlan& plan,
                         const GraphTile* tile,
                         const DirectedEdge* edge,
                         const std::shared_ptr<sif::DynamicCost>& costing,
@@ -113,19 +113,19 @@ void SetShapeAttributes(const AttributesController& controller,
       double time = edge_time * distance_pct;                      // seconds
 
       // Set shape attributes time per shape point if requested
-      if (controller.attributes.at(kShapeAttributesTime)) {
+      if (plan.controller.attributes.at(kShapeAttributesTime)) {
         // convert time to milliseconds and then round to an integer
         trip_path.mutable_shape_attributes()->add_time((time * kMillisecondPerSec) + 0.5);
       }
 
       // Set shape attributes length per shape point if requested
-      if (controller.attributes.at(kShapeAttributesLength)) {
+      if (plan.controller.attributes.at(kShapeAttributesLength)) {
         // convert length to decimeters and then round to an integer
         trip_path.mutable_shape_attributes()->add_length((distance * kDecimeterPerMeter) + 0.5);
       }
 
       // Set shape attributes speed per shape point if requested
-      if (controller.attributes.at(kShapeAttributesSpeed)) {
+      if (plan.controller.attributes.at(kShapeAttributesSpeed)) {
         // convert speed to decimeters per sec and then round to an integer
         trip_path.mutable_shape_attributes()->add_speed((distance * kDecimeterPerMeter / time) + 0.5);
       }
@@ -144,6 +144,14 @@ void SetBoundingBox(TripLeg& trip_path, std::vector<PointLL>& shape) {
   max_ll->set_lng(bbox.maxx());
 }
 
+// Set the shape as fixed point deltas, it is only turned into text when the response is serialized
+void SetShape(TripLeg& trip_path, const std::vector<PointLL>& shape) {
+  auto* deltas = trip_path.mutable_shape();
+  deltas->Clear();
+  deltas->Reserve(shape.size() * 2);
+  delta_encode(shape, google::protobuf::RepeatedFieldBackInserter(deltas));
+}
+
 // Associate RoadClass values to TripLeg proto
 constexpr TripLeg_RoadClass kTripLegRoadClass[] =
     {TripLeg_RoadClass_kMotorway,    TripLeg_RoadClass_kTrunk,       TripLeg_RoadClass_kPrimary,
@@ -386,22 +394,22 @@ void CopyLocations(TripLeg& trip_path,
 /**
  * Set begin and end heading if requested.
  * @param  trip_edge  Trip path edge to add headings.
- * @param  controller Controller specifying attributes to add to trip edge.
+ * @param  plan       Attributes to add to trip edge.
  * @param  edge       Directed edge.
  * @param  shape      Trip shape.
  */
 void SetHeadings(TripLeg_Edge* trip_edge,
-                 const AttributesController& controller,
+                 const FieldPlan& plan,
                  const DirectedEdge* edge,
                  const std::vector<PointLL>& shape,
                  const uint32_t begin_index) {
-  if (controller.attributes.at(kEdgeBeginHeading) || controller.attributes.at(kEdgeEndHeading)) {
+  if (plan.edge_headings) {
     float offset = GetOffsetForHeading(edge->classification(), edge->use());
-    if (controller.attributes.at(kEdgeBeginHeading)) {
+    if (plan.edge_begin_heading) {
       trip_edge->set_begin_heading(
           std::round(PointLL::HeadingAlongPolyline(shape, offset, begin_index, shape.size() - 1)));
     }
-    if (controller.attributes.at(kEdgeEndHeading)) {
+    if (plan.edge_end_heading) {
       trip_edge->set_end_heading(
           std::round(PointLL::HeadingAtEndOfPolyline(shape, offset, begin_index, shape.size() - 1)));
     }
@@ -414,7 +422,7 @@ void SetHeadings(TripLeg_Edge* trip_edge,
  * @param startnode   Start node of the current edge.
  * @param start_tile  Tile of the start node.
  * @param graphtile   Graph tile of the current edge.
- * @param controller  Controller specifying attributes to add to trip edge.
+ * @param plan        Attributes to add to trip edge.
  *
  */
 void AddTransitNodes(TripLeg_Node* trip_node,
@@ -422,7 +430,7 @@ void AddTransitNodes(TripLeg_Node* trip_node,
                      const GraphId& startnode,
                      const GraphTile* start_tile,
                      const GraphTile* graphtile,
-                     const AttributesController& controller) {
+                     const FieldPlan& plan) {
 
   if (node->type() == NodeType::kTransitStation) {
     const TransitStop* transit_station =
@@ -431,20 +439,21 @@ void AddTransitNodes(TripLeg_Node* trip_node,
 
     if (transit_station) {
       // Set onstop_id if requested
-      if (controller.attributes.at(kNodeTransitStationInfoOnestopId) &&
+      if (plan.controller.attributes.at(kNodeTransitStationInfoOnestopId) &&
           transit_station->one_stop_offset()) {
         transit_station_info->set_onestop_id(graphtile->GetName(transit_station->one_stop_offset()));
       }
 
       // Set name if requested
-      if (controller.attributes.at(kNodeTransitStationInfoName) && transit_station->name_offset()) {
+      if (plan.controller.attributes.at(kNodeTransitStationInfoName) &&
+          transit_station->name_offset()) {
         transit_station_info->set_name(graphtile->GetName(transit_station->name_offset()));
       }
 
       // Set latitude and longitude
       LatLng* stop_ll = transit_station_info->mutable_ll();
       // Set transit stop lat/lon if requested
-      if (controller.attributes.at(kNodeTransitStationInfoLatLon)) {
+      if (plan.controller.attributes.at(kNodeTransitStationInfoLatLon)) {
         PointLL ll = node->latlng(start_tile->header()->base_ll());
         stop_ll->set_lat(ll.lat());
         stop_ll->set_lng(ll.lng());
@@ -459,20 +468,21 @@ void AddTransitNodes(TripLeg_Node* trip_node,
 
     if (transit_egress) {
       // Set onstop_id if requested
-      if (controller.attributes.at(kNodeTransitEgressInfoOnestopId) &&
+      if (plan.controller.attributes.at(kNodeTransitEgressInfoOnestopId) &&
           transit_egress->one_stop_offset()) {
         transit_egress_info->set_onestop_id(graphtile->GetName(transit_egress->one_stop_offset()));
       }
 
       // Set name if requested
-      if (controller.attributes.at(kNodeTransitEgressInfoName) && transit_egress->name_offset()) {
+      if (plan.controller.attributes.at(kNodeTransitEgressInfoName) &&
+          transit_egress->name_offset()) {
         transit_egress_info->set_name(graphtile->GetName(transit_egress->name_offset()));
       }
 
       // Set latitude and longitude
       LatLng* stop_ll = transit_egress_info->mutable_ll();
       // Set transit stop lat/lon if requested
-      if (controller.attributes.at(kNodeTransitEgressInfoLatLon)) {
+      if (plan.controller.attributes.at(kNodeTransitEgressInfoLatLon)) {
         PointLL ll = node->latlng(start_tile->header()->base_ll());
         stop_ll->set_lat(ll.lat());
         stop_ll->set_lng(ll.lng());
@@ -520,7 +530,7 @@ void SetTripEdgeRoadClass(TripLeg_Edge* trip_edge,
 
 /**
  * Add trip edge. (TODO more comments)
- * @param  controller         Controller to determine which attributes to set.
+ * @param  plan               Attributes to set.
  * @param  edge               Identifier of an edge within the tiled, hierarchical graph.
  * @param  trip_id            Trip Id (0 if not a transit edge).
  * @param  block_id           Transit block Id (0 if not a transit edge)
@@ -538,7 +548,7 @@ void SetTripEdgeRoadClass(TripLeg_Edge* trip_edge,
  * @param  start_tile         The start tile of the start node
  *
  */
-TripLeg_Edge* AddTripEdge(const AttributesController& controller,
+TripLeg_Edge* AddTripEdge(const FieldPlan& plan,
                           const GraphId& edge,
                           const uint32_t trip_id,
                           const uint32_t block_id,
@@ -566,7 +576,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   auto edgeinfo = graphtile->edgeinfo(directededge->edgeinfo_offset());
 
   // Add names to edge if requested
-  if (controller.attributes.at(kEdgeNames)) {
+  if (plan.edge_names) {
     auto names_and_types = edgeinfo.GetNamesAndTypes();
     for (const auto& name_and_type : names_and_types) {
       auto* trip_edge_name = trip_edge->mutable_name()->Add();
@@ -580,7 +590,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
 #endif
 
   // Set the signs (if the directed edge has sign information) and if requested
-  if (directededge->sign()) {
+  if (plan.edge_signs && directededge->sign()) {
     // Add the edge signs
     std::vector<SignInfo> edge_signs = graphtile->GetSigns(idx);
     if (!edge_signs.empty()) {
@@ -588,7 +598,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
       for (const auto& sign : edge_signs) {
         switch (sign.type()) {
           case Sign::Type::kExitNumber: {
-            if (controller.attributes.at(kEdgeSignExitNumber)) {
+            if (plan.controller.attributes.at(kEdgeSignExitNumber)) {
               auto* trip_sign_exit_number = trip_sign->mutable_exit_numbers()->Add();
               trip_sign_exit_number->set_text(sign.text());
               trip_sign_exit_number->set_is_route_number(sign.is_route_num());
@@ -596,7 +606,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
             break;
           }
           case Sign::Type::kExitBranch: {
-            if (controller.attributes.at(kEdgeSignExitBranch)) {
+            if (plan.controller.attributes.at(kEdgeSignExitBranch)) {
               auto* trip_sign_exit_onto_street = trip_sign->mutable_exit_onto_streets()->Add();
               trip_sign_exit_onto_street->set_text(sign.text());
               trip_sign_exit_onto_street->set_is_route_number(sign.is_route_num());
@@ -604,7 +614,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
             break;
           }
           case Sign::Type::kExitToward: {
-            if (controller.attributes.at(kEdgeSignExitToward)) {
+            if (plan.controller.attributes.at(kEdgeSignExitToward)) {
               auto* trip_sign_exit_toward_location =
                   trip_sign->mutable_exit_toward_locations()->Add();
               trip_sign_exit_toward_location->set_text(sign.text());
@@ -613,7 +623,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
             break;
           }
           case Sign::Type::kExitName: {
-            if (controller.attributes.at(kEdgeSignExitName)) {
+            if (plan.controller.attributes.at(kEdgeSignExitName)) {
               auto* trip_sign_exit_name = trip_sign->mutable_exit_names()->Add();
               trip_sign_exit_name->set_text(sign.text());
               trip_sign_exit_name->set_is_route_number(sign.is_route_num());
@@ -621,7 +631,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
             break;
           }
           case Sign::Type::kGuideBranch: {
-            if (controller.attributes.at(kEdgeSignGuideBranch)) {
+            if (plan.controller.attributes.at(kEdgeSignGuideBranch)) {
               auto* trip_sign_guide_onto_street = trip_sign->mutable_guide_onto_streets()->Add();
               trip_sign_guide_onto_street->set_text(sign.text());
               trip_sign_guide_onto_street->set_is_route_number(sign.is_route_num());
@@ -629,7 +639,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
             break;
           }
           case Sign::Type::kGuideToward: {
-            if (controller.attributes.at(kEdgeSignGuideToward)) {
+            if (plan.controller.attributes.at(kEdgeSignGuideToward)) {
               auto* trip_sign_guide_toward_location =
                   trip_sign->mutable_guide_toward_locations()->Add();
               trip_sign_guide_toward_location->set_text(sign.text());
@@ -638,7 +648,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
             break;
           }
           case Sign::Type::kGuidanceViewJunction: {
-            if (controller.attributes.at(kEdgeSignGuidanceViewJunction)) {
+            if (plan.controller.attributes.at(kEdgeSignGuidanceViewJunction)) {
               auto* trip_sign_guidance_view_junction =
                   trip_sign->mutable_guidance_view_junctions()->Add();
               trip_sign_guidance_view_junction->set_text(sign.text());
@@ -652,7 +662,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   }
 
   // Process the named junctions at nodes
-  if (has_junction_name && start_tile) {
+  if (plan.edge_signs && has_junction_name && start_tile) {
     // Add the node signs
     std::vector<SignInfo> node_signs = start_tile->GetSigns(start_node_idx, true);
     if (!node_signs.empty()) {
@@ -660,7 +670,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
       for (const auto& sign : node_signs) {
         switch (sign.type()) {
           case Sign::Type::kJunctionName: {
-            if (controller.attributes.at(kEdgeSignJunctionName)) {
+            if (plan.controller.attributes.at(kEdgeSignJunctionName)) {
               auto* trip_sign_junction_name = trip_sign->mutable_junction_names()->Add();
               trip_sign_junction_name->set_text(sign.text());
               trip_sign_junction_name->set_is_route_number(sign.is_route_num());
@@ -672,8 +682,8 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     }
   }
 
-  // If turn lanes exist
-  if (directededge->turnlanes()) {
+  // Add the turn lanes if they exist and are requested
+  if (directededge->turnlanes() && plan.edge_turn_lanes) {
     auto turnlanes = graphtile->turnlanes(idx);
     for (auto tl : turnlanes) {
       TurnLane* turn_lane = trip_edge->add_turn_lanes();
@@ -682,18 +692,18 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   }
 
   // Set road class if requested
-  if (controller.attributes.at(kEdgeRoadClass)) {
+  if (plan.edge_road_class) {
     SetTripEdgeRoadClass(trip_edge, directededge, graphtile, graphreader);
   }
 
   // Set length if requested. Convert to km
-  if (controller.attributes.at(kEdgeLength)) {
+  if (plan.edge_length) {
     float km = std::max((directededge->length() * kKmPerMeter * length_percentage), 0.001f);
     trip_edge->set_length(km);
   }
 
   // Set speed if requested
-  if (controller.attributes.at(kEdgeSpeed)) {
+  if (plan.edge_speed) {
     // TODO: could get better precision speed here by calling GraphTile::GetSpeed but we'd need to
     // know whether or not the costing actually cares about the speed of the edge. Perhaps a refactor
     // of costing to have a GetSpeed function which EdgeCost calls internally but which we can also
@@ -715,7 +725,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   // Test whether edge is traversed forward or reverse
   if (directededge->forward()) {
     // Set traversability for forward directededge if requested
-    if (controller.attributes.at(kEdgeTraversability)) {
+    if (plan.edge_traversability) {
       if ((directededge->forwardaccess() & kAccess) && (directededge->reverseaccess() & kAccess)) {
         trip_edge->set_traversability(TripLeg_Traversability::TripLeg_Traversability_kBoth);
       } else if ((directededge->forwardaccess() & kAccess) &&
@@ -730,7 +740,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     }
   } else {
     // Set traversability for reverse directededge if requested
-    if (controller.attributes.at(kEdgeTraversability)) {
+    if (plan.edge_traversability) {
       if ((directededge->forwardaccess() & kAccess) && (directededge->reverseaccess() & kAccess)) {
         trip_edge->set_traversability(TripLeg_Traversability::TripLeg_Traversability_kBoth);
       } else if (!(directededge->forwardaccess() & kAccess) &&
@@ -750,47 +760,47 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   }
 
   // Set the trip path use based on directed edge use if requested
-  if (controller.attributes.at(kEdgeUse)) {
+  if (plan.edge_use) {
     trip_edge->set_use(GetTripLegUse(directededge->use()));
   }
 
   // Set toll flag if requested
-  if (directededge->toll() && controller.attributes.at(kEdgeToll)) {
+  if (directededge->toll() && plan.edge_toll) {
     trip_edge->set_toll(true);
   }
 
   // Set unpaved flag if requested
-  if (directededge->unpaved() && controller.attributes.at(kEdgeUnpaved)) {
+  if (directededge->unpaved() && plan.edge_unpaved) {
     trip_edge->set_unpaved(true);
   }
 
   // Set tunnel flag if requested
-  if (directededge->tunnel() && controller.attributes.at(kEdgeTunnel)) {
+  if (directededge->tunnel() && plan.edge_tunnel) {
     trip_edge->set_tunnel(true);
   }
 
   // Set bridge flag if requested
-  if (directededge->bridge() && controller.attributes.at(kEdgeBridge)) {
+  if (directededge->bridge() && plan.edge_bridge) {
     trip_edge->set_bridge(true);
   }
 
   // Set roundabout flag if requested
-  if (directededge->roundabout() && controller.attributes.at(kEdgeRoundabout)) {
+  if (directededge->roundabout() && plan.edge_roundabout) {
     trip_edge->set_roundabout(true);
   }
 
   // Set internal intersection flag if requested
-  if (directededge->internal() && controller.attributes.at(kEdgeInternalIntersection)) {
+  if (directededge->internal() && plan.edge_internal_intersection) {
     trip_edge->set_internal_intersection(true);
   }
 
   // Set drive_on_right if requested
-  if (controller.attributes.at(kEdgeDriveOnRight)) {
+  if (plan.edge_drive_on_right) {
     trip_edge->set_drive_on_right(drive_on_right);
   }
 
   // Set surface if requested
-  if (controller.attributes.at(kEdgeSurface)) {
+  if (plan.edge_surface) {
     trip_edge->set_surface(GetTripLegSurface(directededge->surface()));
   }
 
@@ -798,64 +808,64 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   if (mode == sif::TravelMode::kBicycle) {
     // Override bicycle mode with pedestrian if dismount flag or steps
     if (directededge->dismount() || directededge->use() == Use::kSteps) {
-      if (controller.attributes.at(kEdgeTravelMode)) {
+      if (plan.edge_travel_mode) {
         trip_edge->set_travel_mode(TripLeg_TravelMode::TripLeg_TravelMode_kPedestrian);
       }
-      if (controller.attributes.at(kEdgePedestrianType)) {
+      if (plan.edge_pedestrian_type) {
         trip_edge->set_pedestrian_type(TripLeg_PedestrianType::TripLeg_PedestrianType_kFoot);
       }
     } else {
-      if (controller.attributes.at(kEdgeTravelMode)) {
+      if (plan.edge_travel_mode) {
         trip_edge->set_travel_mode(TripLeg_TravelMode::TripLeg_TravelMode_kBicycle);
       }
-      if (controller.attributes.at(kEdgeBicycleType)) {
+      if (plan.edge_bicycle_type) {
         trip_edge->set_bicycle_type(GetTripLegBicycleType(travel_type));
       }
     }
   } else if (mode == sif::TravelMode::kDrive) {
-    if (controller.attributes.at(kEdgeTravelMode)) {
+    if (plan.edge_travel_mode) {
       trip_edge->set_travel_mode(TripLeg_TravelMode::TripLeg_TravelMode_kDrive);
     }
-    if (controller.attributes.at(kEdgeVehicleType)) {
+    if (plan.edge_vehicle_type) {
       trip_edge->set_vehicle_type(GetTripLegVehicleType(travel_type));
     }
   } else if (mode == sif::TravelMode::kPedestrian) {
-    if (controller.attributes.at(kEdgeTravelMode)) {
+    if (plan.edge_travel_mode) {
       trip_edge->set_travel_mode(TripLeg_TravelMode::TripLeg_TravelMode_kPedestrian);
     }
-    if (controller.attributes.at(kEdgePedestrianType)) {
+    if (plan.edge_pedestrian_type) {
       trip_edge->set_pedestrian_type(GetTripLegPedestrianType(travel_type));
     }
   } else if (mode == sif::TravelMode::kPublicTransit) {
-    if (controller.attributes.at(kEdgeTravelMode)) {
+    if (plan.edge_travel_mode) {
       trip_edge->set_travel_mode(TripLeg_TravelMode::TripLeg_TravelMode_kTransit);
     }
   }
 
   // Set edge id (graphid value) if requested
-  if (controller.attributes.at(kEdgeId)) {
+  if (plan.edge_id) {
     trip_edge->set_id(edge.value);
   }
 
   // Set way id (base data id) if requested
-  if (controller.attributes.at(kEdgeWayId)) {
+  if (plan.edge_way_id) {
     trip_edge->set_way_id(edgeinfo.wayid());
   }
 
   // Set weighted grade if requested
-  if (controller.attributes.at(kEdgeWeightedGrade)) {
+  if (plan.edge_weighted_grade) {
     trip_edge->set_weighted_grade((directededge->weighted_grade() - 6.f) / 0.6f);
   }
 
   // Set maximum upward and downward grade if requested (set to kNoElevationData if unavailable)
-  if (controller.attributes.at(kEdgeMaxUpwardGrade)) {
+  if (plan.edge_max_upward_grade) {
     if (graphtile->header()->has_elevation()) {
       trip_edge->set_max_upward_grade(directededge->max_up_slope());
     } else {
       trip_edge->set_max_upward_grade(kNoElevationData);
     }
   }
-  if (controller.attributes.at(kEdgeMaxDownwardGrade)) {
+  if (plan.edge_max_downward_grade) {
     if (graphtile->header()->has_elevation()) {
       trip_edge->set_max_downward_grade(directededge->max_down_slope());
     } else {
@@ -864,7 +874,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
   }
 
   // Set mean elevation if requested (set to kNoElevationData if unavailable)
-  if (controller.attributes.at(kEdgeMeanElevation)) {
+  if (plan.edge_mean_elevation) {
     if (graphtile->header()->has_elevation()) {
       trip_edge->set_mean_elevation(edgeinfo.mean_elevation());
     } else {
@@ -872,11 +882,11 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     }
   }
 
-  if (controller.attributes.at(kEdgeLaneCount)) {
+  if (plan.edge_lane_count) {
     trip_edge->set_lane_count(directededge->lanecount());
   }
 
-  if (directededge->laneconnectivity() && controller.attributes.at(kEdgeLaneConnectivity)) {
+  if (directededge->laneconnectivity() && plan.edge_lane_connectivity) {
     for (const auto& l : graphtile->GetLaneConnectivity(idx)) {
       TripLeg_LaneConnectivity* path_lane = trip_edge->add_lane_connectivity();
       path_lane->set_from_way_id(l.from());
@@ -885,15 +895,15 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     }
   }
 
-  if (directededge->cyclelane() != CycleLane::kNone && controller.attributes.at(kEdgeCycleLane)) {
+  if (directededge->cyclelane() != CycleLane::kNone && plan.edge_cycle_lane) {
     trip_edge->set_cycle_lane(GetTripLegCycleLane(directededge->cyclelane()));
   }
 
-  if (controller.attributes.at(kEdgeBicycleNetwork)) {
+  if (plan.edge_bicycle_network) {
     trip_edge->set_bicycle_network(directededge->bike_network());
   }
 
-  if (controller.attributes.at(kEdgeSidewalk)) {
+  if (plan.edge_sidewalk) {
     if (directededge->sidewalk_left() && directededge->sidewalk_right()) {
       trip_edge->set_sidewalk(TripLeg_Sidewalk::TripLeg_Sidewalk_kBothSides);
     } else if (directededge->sidewalk_left()) {
@@ -903,23 +913,23 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     }
   }
 
-  if (controller.attributes.at(kEdgeDensity)) {
+  if (plan.edge_density) {
     trip_edge->set_density(directededge->density());
   }
 
-  if (controller.attributes.at(kEdgeSpeedLimit)) {
+  if (plan.edge_speed_limit) {
     trip_edge->set_speed_limit(edgeinfo.speed_limit());
   }
 
-  if (controller.attributes.at(kEdgeDefaultSpeed)) {
+  if (plan.edge_default_speed) {
     trip_edge->set_default_speed(directededge->speed());
   }
 
-  if (controller.attributes.at(kEdgeTruckSpeed)) {
+  if (plan.edge_truck_speed) {
     trip_edge->set_truck_speed(directededge->truck_speed());
   }
 
-  if (directededge->truck_route() && controller.attributes.at(kEdgeTruckRoute)) {
+  if (directededge->truck_route() && plan.edge_truck_route) {
     trip_edge->set_truck_route(true);
   }
 
@@ -930,12 +940,12 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     TripLeg_TransitRouteInfo* transit_route_info = trip_edge->mutable_transit_route_info();
 
     // Set block_id if requested
-    if (controller.attributes.at(kEdgeTransitRouteInfoBlockId)) {
+    if (plan.controller.attributes.at(kEdgeTransitRouteInfoBlockId)) {
       transit_route_info->set_block_id(block_id);
     }
 
     // Set trip_id if requested
-    if (controller.attributes.at(kEdgeTransitRouteInfoTripId)) {
+    if (plan.controller.attributes.at(kEdgeTransitRouteInfoTripId)) {
       transit_route_info->set_trip_id(trip_id);
     }
 
@@ -946,7 +956,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
     if (transit_departure) {
 
       // Set headsign if requested
-      if (controller.attributes.at(kEdgeTransitRouteInfoHeadsign) &&
+      if (plan.controller.attributes.at(kEdgeTransitRouteInfoHeadsign) &&
           transit_departure->headsign_offset()) {
         transit_route_info->set_headsign(graphtile->GetName(transit_departure->headsign_offset()));
       }
@@ -955,60 +965,60 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
 
       if (transit_route) {
         // Set transit type if requested
-        if (controller.attributes.at(kEdgeTransitType)) {
+        if (plan.controller.attributes.at(kEdgeTransitType)) {
           trip_edge->set_transit_type(GetTripLegTransitType(transit_route->route_type()));
         }
 
         // Set onestop_id if requested
-        if (controller.attributes.at(kEdgeTransitRouteInfoOnestopId) &&
+        if (plan.controller.attributes.at(kEdgeTransitRouteInfoOnestopId) &&
             transit_route->one_stop_offset()) {
           transit_route_info->set_onestop_id(graphtile->GetName(transit_route->one_stop_offset()));
         }
 
         // Set short_name if requested
-        if (controller.attributes.at(kEdgeTransitRouteInfoShortName) &&
+        if (plan.controller.attributes.at(kEdgeTransitRouteInfoShortName) &&
             transit_route->short_name_offset()) {
           transit_route_info->set_short_name(graphtile->GetName(transit_route->short_name_offset()));
         }
 
         // Set long_name if requested
-        if (controller.attributes.at(kEdgeTransitRouteInfoLongName) &&
+        if (plan.controller.attributes.at(kEdgeTransitRouteInfoLongName) &&
             transit_route->long_name_offset()) {
           transit_route_info->set_long_name(graphtile->GetName(transit_route->long_name_offset()));
         }
 
         // Set color if requested
-        if (controller.attributes.at(kEdgeTransitRouteInfoColor)) {
+        if (plan.controller.attributes.at(kEdgeTransitRouteInfoColor)) {
           transit_route_info->set_color(transit_route->route_color());
         }
 
         // Set text_color if requested
-        if (controller.attributes.at(kEdgeTransitRouteInfoTextColor)) {
+        if (plan.controller.attributes.at(kEdgeTransitRouteInfoTextColor)) {
           transit_route_info->set_text_color(transit_route->route_text_color());
         }
 
         // Set description if requested
-        if (controller.attributes.at(kEdgeTransitRouteInfoDescription) &&
+        if (plan.controller.attributes.at(kEdgeTransitRouteInfoDescription) &&
             transit_route->desc_offset()) {
           transit_route_info->set_description(graphtile->GetName(transit_route->desc_offset()));
         }
 
         // Set operator_onestop_id if requested
-        if (controller.attributes.at(kEdgeTransitRouteInfoOperatorOnestopId) &&
+        if (plan.controller.attributes.at(kEdgeTransitRouteInfoOperatorOnestopId) &&
             transit_route->op_by_onestop_id_offset()) {
           transit_route_info->set_operator_onestop_id(
               graphtile->GetName(transit_route->op_by_onestop_id_offset()));
         }
 
         // Set operator_name if requested
-        if (controller.attributes.at(kEdgeTransitRouteInfoOperatorName) &&
+        if (plan.controller.attributes.at(kEdgeTransitRouteInfoOperatorName) &&
             transit_route->op_by_name_offset()) {
           transit_route_info->set_operator_name(
               graphtile->GetName(transit_route->op_by_name_offset()));
         }
 
         // Set operator_url if requested
-        if (controller.attributes.at(kEdgeTransitRouteInfoOperatorUrl) &&
+        if (plan.controller.attributes.at(kEdgeTransitRouteInfoOperatorUrl) &&
             transit_route->op_by_website_offset()) {
           transit_route_info->set_operator_url(
               graphtile->GetName(transit_route->op_by_website_offset()));
@@ -1022,7 +1032,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
 
 /**
  * Add trip intersecting edge.
- * @param  controller   Controller to determine which attributes to set.
+ * @param  plan         Attributes to set.
  * @param  directededge Directed edge on the path.
  * @param  prev_de  Previous directed edge on the path.
  * @param  local_edge_index  Index of the local intersecting path edge at intersection.
@@ -1031,7 +1041,7 @@ TripLeg_Edge* AddTripEdge(const AttributesController& controller,
  * @param  intersecting_de Intersecting directed edge. Will be nullptr except when
  *                         on the local hierarchy.
  */
-void AddTripIntersectingEdge(const AttributesController& controller,
+void AddTripIntersectingEdge(const FieldPlan& plan,
                              const DirectedEdge* directededge,
                              const DirectedEdge* prev_de,
                              uint32_t local_edge_index,
@@ -1041,7 +1051,7 @@ void AddTripIntersectingEdge(const AttributesController& controller,
   TripLeg_IntersectingEdge* itersecting_edge = trip_node->add_intersecting_edge();
 
   // Set the heading for the intersecting edge if requested
-  if (controller.attributes.at(kNodeIntersectingEdgeBeginHeading)) {
+  if (plan.intersecting_edge_begin_heading) {
     itersecting_edge->set_begin_heading(nodeinfo->heading(local_edge_index));
   }
 
@@ -1057,7 +1067,7 @@ void AddTripIntersectingEdge(const AttributesController& controller,
                          : Traversability::kNone;
   }
   // Set the walkability flag for the intersecting edge if requested
-  if (controller.attributes.at(kNodeIntersectingEdgeWalkability)) {
+  if (plan.intersecting_edge_walkability) {
     itersecting_edge->set_walkability(GetTripLegTraversability(traversability));
   }
 
@@ -1071,35 +1081,35 @@ void AddTripIntersectingEdge(const AttributesController& controller,
                                                                          : Traversability::kNone;
   }
   // Set the cyclability flag for the intersecting edge if requested
-  if (controller.attributes.at(kNodeIntersectingEdgeCyclability)) {
+  if (plan.intersecting_edge_cyclability) {
     itersecting_edge->set_cyclability(GetTripLegTraversability(traversability));
   }
 
   // Set the driveability flag for the intersecting edge if requested
-  if (controller.attributes.at(kNodeIntersectingEdgeDriveability)) {
+  if (plan.intersecting_edge_driveability) {
     itersecting_edge->set_driveability(
         GetTripLegTraversability(nodeinfo->local_driveability(local_edge_index)));
   }
 
   // Set the previous/intersecting edge name consistency if requested
-  if (controller.attributes.at(kNodeIntersectingEdgeFromEdgeNameConsistency)) {
+  if (plan.intersecting_edge_from_edge_name_consistency) {
     bool name_consistency =
         (prev_de == nullptr) ? false : prev_de->name_consistency(local_edge_index);
     itersecting_edge->set_prev_name_consistency(name_consistency);
   }
 
   // Set the current/intersecting edge name consistency if requested
-  if (controller.attributes.at(kNodeIntersectingEdgeToEdgeNameConsistency)) {
+  if (plan.intersecting_edge_to_edge_name_consistency) {
     itersecting_edge->set_curr_name_consistency(directededge->name_consistency(local_edge_index));
   }
 
   // Set the use for the intersecting edge if requested
-  if (controller.attributes.at(kNodeIntersectingEdgeUse)) {
+  if (plan.intersecting_edge_use) {
     itersecting_edge->set_use(GetTripLegUse(intersecting_de->use()));
   }
 
   // Set the road class for the intersecting edge if requested
-  if (controller.attributes.at(kNodeIntersectingEdgeRoadClass)) {
+  if (plan.intersecting_edge_road_class) {
     itersecting_edge->set_road_class(GetTripLegRoadClass(intersecting_de->classification()));
   }
 }
@@ -1129,6 +1139,9 @@ void TripLegBuilder::Build(
     (*interrupt_callback)();
   }
 
+  // Compile the attributes once rather than looking them up for every edge
+  const FieldPlan plan(controller);
+
   // Set origin, any through locations, and destination. Origin and
   // destination are assumed to be breaks.
   CopyLocations(trip_path, origin, through_loc, dest, path_begin, path_end);
@@ -1209,7 +1222,7 @@ void TripLegBuilder::Build(
   std::vector<AdminInfo> admin_info_list;
 
   // initialize shape_attributes
-  if (controller.category_attribute_enabled(kShapeAttributesCategory)) {
+  if (plan.shape_attributes) {
     trip_path.mutable_shape_attributes();
   }
 
@@ -1249,43 +1262,43 @@ void TripLegBuilder::Build(
     bool drive_on_right = graphreader.nodeinfo(start_node)->drive_on_right();
 
     // Add trip edge
-    auto trip_edge = AddTripEdge(controller, path_begin->edgeid, path_begin->trip_id, 0,
-                                 path_begin->mode, travel_types[static_cast<int>(path_begin->mode)],
+    auto trip_edge = AddTripEdge(plan, path_begin->edgeid, path_begin->trip_id, 0, path_begin->mode,
+                                 travel_types[static_cast<int>(path_begin->mode)],
                                  mode_costing[static_cast<uint32_t>(path_begin->mode)], edge,
                                  drive_on_right, trip_path.add_node(), tile, graphreader,
-                                 origin_second_of_week, std::abs(end_pct - start_pct), startnode.id(),
-                                 false, nullptr, path_begin->has_time_restrictions);
+                                 origin_second_of_week, std::abs(end_pct - start_pct),
+                                 startnode.id(), false, nullptr, path_begin->has_time_restrictions);
 
     // Set begin shape index if requested
-    if (controller.attributes.at(kEdgeBeginShapeIndex)) {
+    if (plan.edge_begin_shape_index) {
       trip_edge->set_begin_shape_index(0);
     }
     // Set end shape index if requested
-    if (controller.attributes.at(kEdgeEndShapeIndex)) {
+    if (plan.edge_end_shape_index) {
       trip_edge->set_end_shape_index(shape.size() - 1);
     }
 
     // Set shape attributes
-    SetShapeAttributes(controller, tile, edge, mode_costing[static_cast<int>(path_begin->mode)],
+    SetShapeAttributes(plan, tile, edge, mode_costing[static_cast<int>(path_begin->mode)],
                        shape.begin(), shape.end(), trip_path, origin_second_of_week,
                        end_pct - start_pct);
 
     // Set begin and end heading if requested. Uses shape so
     // must be done after the edge's shape has been added.
-    SetHeadings(trip_edge, controller, edge, shape, 0);
+    SetHeadings(trip_edge, plan, edge, shape, 0);
 
     auto* node = trip_path.add_node();
-    if (controller.attributes.at(kNodeElapsedTime)) {
+    if (plan.node_elapsed_time) {
       node->set_elapsed_time(path_begin->elapsed_time - trim_begin - trim_end);
     }
 
     const GraphTile* end_tile = graphreader.GetGraphTile(edge->endnode());
     if (end_tile == nullptr) {
-      if (controller.attributes.at(kNodeaAdminIndex)) {
+      if (plan.node_admin_index) {
         node->set_admin_index(0);
       }
     } else {
-      if (controller.attributes.at(kNodeaAdminIndex)) {
+      if (plan.node_admin_index) {
         node->set_admin_index(
             GetAdminIndex(end_tile->admininfo(end_tile->node(edge->endnode())->admin_index()),
                           admin_info_map, admin_info_list));
@@ -1296,16 +1309,16 @@ void TripLegBuilder::Build(
     SetBoundingBox(trip_path, shape);
 
     // Set shape if requested
-    if (controller.attributes.at(kShape)) {
-      trip_path.set_shape(encode<std::vector<PointLL>>(shape));
+    if (plan.shape) {
+      SetShape(trip_path, shape);
     }
 
-    if (controller.attributes.at(kOsmChangeset)) {
+    if (plan.osm_changeset) {
       trip_path.set_osm_changeset(tile->header()->dataset_id());
     }
 
     // Assign the trip path admins
-    AssignAdmins(controller, trip_path, admin_info_list);
+    AssignAdmins(plan, trip_path, admin_info_list);
 
     // Trivial path is done
     return;
@@ -1341,7 +1354,7 @@ void TripLegBuilder::Build(
     start_tile = graphreader.GetGraphTile(startnode, start_tile);
     const NodeInfo* node = start_tile->node(startnode);
 
-    if (osmchangeset == 0 && controller.attributes.at(kOsmChangeset)) {
+    if (osmchangeset == 0 && plan.osm_changeset) {
       osmchangeset = start_tile->header()->dataset_id();
     }
 
@@ -1363,18 +1376,18 @@ void TripLegBuilder::Build(
     // Add a node to the trip path and set its attributes.
     TripLeg_Node* trip_node = trip_path.add_node();
 
-    if (controller.attributes.at(kNodeType)) {
+    if (plan.node_type) {
       trip_node->set_type(GetTripLegNodeType(node->type()));
     }
 
     if (node->intersection() == IntersectionType::kFork) {
-      if (controller.attributes.at(kNodeFork)) {
+      if (plan.node_fork) {
         trip_node->set_fork(true);
       }
     }
 
     // Assign the elapsed time from the start of the leg
-    if (controller.attributes.at(kNodeElapsedTime)) {
+    if (plan.node_elapsed_time) {
       trip_node->set_elapsed_time(elapsedtime);
     }
 
@@ -1385,23 +1398,23 @@ void TripLegBuilder::Build(
     }
 
     // Assign the admin index
-    if (controller.attributes.at(kNodeaAdminIndex)) {
+    if (plan.node_admin_index) {
       trip_node->set_admin_index(
           GetAdminIndex(start_tile->admininfo(node->admin_index()), admin_info_map, admin_info_list));
     }
 
-    if (controller.attributes.at(kNodeTimeZone)) {
+    if (plan.node_time_zone) {
       auto tz = DateTime::get_tz_db().from_index(node->timezone());
       if (tz) {
         trip_node->set_time_zone(tz->name());
       }
     }
 
-    if (controller.attributes.at(kNodeTransitionTime) && edge_itr->turn_cost > 0) {
+    if (plan.node_transition_time && edge_itr->turn_cost > 0) {
       trip_node->set_transition_time(edge_itr->turn_cost);
     }
 
-    AddTransitNodes(trip_node, node, startnode, start_tile, graphtile, controller);
+    AddTransitNodes(trip_node, node, startnode, start_tile, graphtile, plan);
 
     ///////////////////////////////////////////////////////////////////////////
     // Add transit information if this is a transit stop. TODO - can we move
@@ -1416,18 +1429,18 @@ void TripLegBuilder::Build(
       // Set type
       if (directededge->use() == Use::kRail) {
         // Set node transit info type if requested
-        if (controller.attributes.at(kNodeTransitPlatformInfoType)) {
+        if (plan.controller.attributes.at(kNodeTransitPlatformInfoType)) {
           transit_platform_info->set_type(TransitPlatformInfo_Type_kStation);
         }
         prev_transit_node_type = TransitPlatformInfo_Type_kStation;
       } else if (directededge->use() == Use::kPlatformConnection) {
         // Set node transit info type if requested
-        if (controller.attributes.at(kNodeTransitPlatformInfoType)) {
+        if (plan.controller.attributes.at(kNodeTransitPlatformInfoType)) {
           transit_platform_info->set_type(prev_transit_node_type);
         }
       } else { // bus logic
         // Set node transit info type if requested
-        if (controller.attributes.at(kNodeTransitPlatformInfoType)) {
+        if (plan.controller.attributes.at(kNodeTransitPlatformInfoType)) {
           transit_platform_info->set_type(TransitPlatformInfo_Type_kStop);
         }
         prev_transit_node_type = TransitPlatformInfo_Type_kStop;
@@ -1435,14 +1448,14 @@ void TripLegBuilder::Build(
 
       if (transit_platform) {
         // Set onstop_id if requested
-        if (controller.attributes.at(kNodeTransitPlatformInfoOnestopId) &&
+        if (plan.controller.attributes.at(kNodeTransitPlatformInfoOnestopId) &&
             transit_platform->one_stop_offset()) {
           transit_platform_info->set_onestop_id(
               graphtile->GetName(transit_platform->one_stop_offset()));
         }
 
         // Set name if requested
-        if (controller.attributes.at(kNodeTransitPlatformInfoName) &&
+        if (plan.controller.attributes.at(kNodeTransitPlatformInfoName) &&
             transit_platform->name_offset()) {
           transit_platform_info->set_name(graphtile->GetName(transit_platform->name_offset()));
         }
@@ -1457,14 +1470,14 @@ void TripLegBuilder::Build(
             const TransitStop* transit_station = endtile->GetTransitStop(nodeinfo2->stop_index());
 
             // Set station onstop_id if requested
-            if (controller.attributes.at(kNodeTransitPlatformInfoStationOnestopId) &&
+            if (plan.controller.attributes.at(kNodeTransitPlatformInfoStationOnestopId) &&
                 transit_station->one_stop_offset()) {
               transit_platform_info->set_station_onestop_id(
                   endtile->GetName(transit_station->one_stop_offset()));
             }
 
             // Set station name if requested
-            if (controller.attributes.at(kNodeTransitPlatformInfoStationName) &&
+            if (plan.controller.attributes.at(kNodeTransitPlatformInfoStationName) &&
                 transit_station->name_offset()) {
               transit_platform_info->set_station_name(
                   endtile->GetName(transit_station->name_offset()));
@@ -1478,7 +1491,7 @@ void TripLegBuilder::Build(
         // Set latitude and longitude
         LatLng* stop_ll = transit_platform_info->mutable_ll();
         // Set transit stop lat/lon if requested
-        if (controller.attributes.at(kNodeTransitPlatformInfoLatLon)) {
+        if (plan.controller.attributes.at(kNodeTransitPlatformInfoLatLon)) {
           PointLL ll = node->latlng(start_tile->header()->base_ll());
           stop_ll->set_lat(ll.lat());
           stop_ll->set_lng(ll.lng());
@@ -1487,7 +1500,7 @@ void TripLegBuilder::Build(
 
       // Set the arrival time at this node (based on schedule from last trip
       // departure) if requested
-      if (controller.attributes.at(kNodeTransitPlatformInfoArrivalDateTime) &&
+      if (plan.controller.attributes.at(kNodeTransitPlatformInfoArrivalDateTime) &&
           !arrival_time.empty()) {
         transit_platform_info->set_arrival_date_time(arrival_time);
       }
@@ -1506,7 +1519,7 @@ void TripLegBuilder::Build(
 
           if (graphtile->header()->date_created() > date) {
             // Set assumed schedule if requested
-            if (controller.attributes.at(kNodeTransitPlatformInfoAssumedSchedule)) {
+            if (plan.controller.attributes.at(kNodeTransitPlatformInfoAssumedSchedule)) {
               transit_platform_info->set_assumed_schedule(true);
             }
             assumed_schedule = true;
@@ -1514,7 +1527,7 @@ void TripLegBuilder::Build(
             day = date - graphtile->header()->date_created();
             if (day > graphtile->GetTransitSchedule(transit_departure->schedule_index())->end_day()) {
               // Set assumed schedule if requested
-              if (controller.attributes.at(kNodeTransitPlatformInfoAssumedSchedule)) {
+              if (plan.controller.attributes.at(kNodeTransitPlatformInfoAssumedSchedule)) {
                 transit_platform_info->set_assumed_schedule(true);
               }
               assumed_schedule = true;
@@ -1538,7 +1551,7 @@ void TripLegBuilder::Build(
           }
 
           // Set departure time from this transit stop if requested
-          if (controller.attributes.at(kNodeTransitPlatformInfoDepartureDateTime)) {
+          if (plan.controller.attributes.at(kNodeTransitPlatformInfoDepartureDateTime)) {
             transit_platform_info->set_departure_date_time(dt);
           }
 
@@ -1568,7 +1581,8 @@ void TripLegBuilder::Build(
         block_id = 0;
 
         // Set assumed schedule if requested
-        if (controller.attributes.at(kNodeTransitPlatformInfoAssumedSchedule) && assumed_schedule) {
+        if (plan.controller.attributes.at(kNodeTransitPlatformInfoAssumedSchedule) &&
+            assumed_schedule) {
           transit_platform_info->set_assumed_schedule(true);
         }
         assumed_schedule = false;
@@ -1579,7 +1593,7 @@ void TripLegBuilder::Build(
     auto is_last_edge = edge_itr == (path_end - 1);
     float length_pct = (is_first_edge ? 1.f - start_pct : (is_last_edge ? end_pct : 1.f));
     TripLeg_Edge* trip_edge =
-        AddTripEdge(controller, edge, trip_id, block_id, mode, travel_type, costing, directededge,
+        AddTripEdge(plan, edge, trip_id, block_id, mode, travel_type, costing, directededge,
                     node->drive_on_right(), trip_node, graphtile, graphreader, second_of_week,
                     length_pct, startnode.id(), node->named_intersection(), start_tile,
                     edge_itr->has_time_restrictions);
@@ -1667,22 +1681,22 @@ void TripLegBuilder::Build(
     }
 
     // Set begin shape index if requested
-    if (controller.attributes.at(kEdgeBeginShapeIndex)) {
+    if (plan.edge_begin_shape_index) {
       trip_edge->set_begin_shape_index(begin_index);
     }
 
     // Set end shape index if requested
-    if (controller.attributes.at(kEdgeEndShapeIndex)) {
+    if (plan.edge_end_shape_index) {
       trip_edge->set_end_shape_index(trip_shape.size() - 1);
     }
 
     // Set shape attributes
-    SetShapeAttributes(controller, graphtile, directededge, costing, trip_shape.begin() + begin_index,
+    SetShapeAttributes(plan, graphtile, directededge, costing, trip_shape.begin() + begin_index,
                        trip_shape.end(), trip_path, second_of_week, length_pct);
 
     // Set begin and end heading if requested. Uses trip_shape so
     // must be done after the edge's shape has been added.
-    SetHeadings(trip_edge, controller, directededge, trip_shape, begin_index);
+    SetHeadings(trip_edge, plan, directededge, trip_shape, begin_index);
 
     // Add connected edges from the start node. Do this after the first trip
     // edge is added
@@ -1703,7 +1717,9 @@ void TripLegBuilder::Build(
     //          A || \\ G
     //            ||  \\
     //            (1)  (X)
-    if (startnode.Is_Valid()) {
+    //
+    // None of this is needed unless some intersecting edge attribute was requested
+    if (plan.intersecting_edges && startnode.Is_Valid()) {
       // Iterate through edges on this level to find any intersecting edges
       // Follow any upwards or downward transitions
       const DirectedEdge* de = start_tile->directededge(node->edge_index());
@@ -1719,8 +1735,8 @@ void TripLegBuilder::Build(
         }
 
         // Add intersecting edges on the same hierarchy level and not on the path
-        AddTripIntersectingEdge(controller, directededge, prev_de, de->localedgeidx(), node,
-                                trip_node, de);
+        AddTripIntersectingEdge(plan, directededge, prev_de, de->localedgeidx(), node, trip_node,
+                                de);
       }
 
       // Add intersecting edges on different levels (follow NodeTransitions)
@@ -1741,7 +1757,7 @@ void TripLegBuilder::Build(
                 de2->localedgeidx() == directededge->localedgeidx()) {
               continue;
             }
-            AddTripIntersectingEdge(controller, directededge, prev_de, de2->localedgeidx(), nodeinfo2,
+            AddTripIntersectingEdge(plan, directededge, prev_de, de2->localedgeidx(), nodeinfo2,
                                     trip_node, de2);
           }
         }
@@ -1771,28 +1787,28 @@ void TripLegBuilder::Build(
 
   // Add the last node
   auto* node = trip_path.add_node();
-  if (controller.attributes.at(kNodeaAdminIndex)) {
+  if (plan.node_admin_index) {
     auto* last_tile = graphreader.GetGraphTile(startnode);
     node->set_admin_index(
         GetAdminIndex(last_tile->admininfo(last_tile->node(startnode)->admin_index()), admin_info_map,
                       admin_info_list));
   }
-  if (controller.attributes.at(kNodeElapsedTime)) {
+  if (plan.node_elapsed_time) {
     node->set_elapsed_time(elapsedtime);
   }
 
   // Assign the admins
-  AssignAdmins(controller, trip_path, admin_info_list);
+  AssignAdmins(plan, trip_path, admin_info_list);
 
   // Set the bounding box of the shape
   SetBoundingBox(trip_path, trip_shape);
 
   // Set shape if requested
-  if (controller.attributes.at(kShape)) {
-    trip_path.set_shape(encode<std::vector<PointLL>>(trip_shape));
+  if (plan.shape) {
+    SetShape(trip_path, trip_shape);
   }
 
-  if (osmchangeset != 0 && controller.attributes.at(kOsmChangeset)) {
+  if (osmchangeset != 0 && plan.osm_changeset) {
     trip_path.set_osm_changeset(osmchangeset);
   }
 }
@@ -9,6 +9,7 @@
 #include "baldr/json.h"
 #include "midgard/constants.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include <boost/property_tree/ptree.hpp>
 
 #include "thor/isochrone.h"
@@ -31,6 +32,23 @@ namespace {
 // route starts to become suspect (due to user breaks and other factors).
 constexpr float kDefaultMaxTimeDependentDistance = 500000.0f; // 500 km
 
+// Default maximum size of the edge costs remembered by requests running many searches
+constexpr size_t kDefaultEdgeCostCacheSize = 32 * 1024 * 1024; // 32 MiB
+
+// Default maximum size of the isochrone grids kept for later requests
+constexpr size_t kDefaultIsochroneCacheSize = 32 * 1024 * 1024; // 32 MiB
+
+// Count how well the working memory of a path algorithm is being recycled since the last time
+void count_working_memory(const std::string& algorithm, WorkingMemory& memory) {
+  const midgard::metrics::Labels labels{{"algorithm", algorithm}};
+  midgard::metrics::Increment("valhalla_working_memory_searches_total", labels,
+                              memory.searches());
+  midgard::metrics::Increment("valhalla_working_memory_growths_total", labels, memory.growths());
+  midgard::metrics::Increment("valhalla_working_memory_releases_total", labels,
+                              memory.releases());
+  memory.ResetCounters();
+}
+
 // Maximum edge score - base this on costing type.
 // Large values can cause very bad performance. Setting this back
 // to 2 hours for bike and pedestrian and 12 hours for driving routes.
@@ -58,7 +76,13 @@ thor_worker_t::thor_worker_t(const boost::property_tree::ptree& config,
                              const std::shared_ptr<baldr::GraphReader>& graph_reader)
     : mode(valhalla::sif::TravelMode::kPedestrian), matcher_factory(config, graph_reader),
       reader(graph_reader), controller{},
-      long_request(config.get<float>("thor.logging.long_request")) {
+      long_request(config.get<float>("thor.logging.long_request")),
+      local_search_optimizer(
+          config.get<uint32_t>("thor.optimizer.restarts", kDefaultOptimizerRestarts),
+          config.get<uint32_t>("thor.optimizer.threads", 1),
+          config.get<uint32_t>("thor.optimizer.time_budget", kDefaultOptimizerTimeBudget)),
+      isochrone_cache(config.get<size_t>("thor.isochrone_cache_size", kDefaultIsochroneCacheSize)),
+      response_cache(ResponseCache::Shared(config)) {
   // If we weren't provided with a graph reader make our own
   if (!reader)
     reader = matcher_factory.graphreader();
@@ -72,7 +96,7 @@ thor_worker_t::thor_worker_t(const boost::property_tree::ptree& config,
   for (const auto& kv : config.get_child("service_limits")) {
     if (kv.first == "max_avoid_locations" || kv.first == "max_reachability" ||
         kv.first == "max_radius" || kv.first == "max_timedep_distance" ||
-        kv.first == "max_alternates") {
+        kv.first == "max_alternates" || kv.first == "max_avoid_polygons_length") {
       continue;
     }
     if (kv.first != "skadi" && kv.first != "trace" && kv.first != "isochrone") {
@@ -91,6 +115,40 @@ thor_worker_t::thor_worker_t(const boost::property_tree::ptree& config,
 
   max_timedep_distance =
       config.get<float>("service_limits.max_timedep_distance", kDefaultMaxTimeDependentDistance);
+
+  // Select the multimodal algorithm based on the conf file (defaults to astar if not present)
+  use_raptor = config.get<std::string>("thor.multimodal_algorithm", "astar") == "raptor";
+
+  // Select the optimized_route algorithm based on the conf file (defaults to annealing)
+  use_local_search = config.get<std::string>("thor.optimizer.algorithm", "annealing") ==
+                     "local_search";
+  if (auto seed = config.get_optional<uint64_t>("thor.optimizer.seed")) {
+    local_search_optimizer.Seed(*seed);
+  }
+
+  // Size of the edge cost cache used by requests running many searches (0 disables it)
+  edge_cost_cache_size =
+      config.get<size_t>("thor.edge_cost_cache_size", kDefaultEdgeCostCacheSize);
+
+  // Time distance matrices run their rows on several threads sharing a reader over a synchronized
+  // tile cache of the worker's own, which cleanup trims once the threads are done
+  auto matrix_threads = config.get<size_t>("thor.matrix_threads", 1);
+  if (matrix_threads > 1) {
+    matrix_pool.resize(matrix_threads);
+    const auto& mjolnir = config.get_child("mjolnir");
+    std::shared_ptr<baldr::TileCache> matrix_cache(
+        baldr::TileCacheFactory::createSharedTileCache(mjolnir));
+    matrix_reader = std::make_shared<baldr::GraphReader>(mjolnir, matrix_cache);
+  }
+
+  // Memory each path algorithm may keep between searches (0 frees it after every search)
+  auto max_reserved_memory =
+      config.get<size_t>("thor.max_reserved_memory", kDefaultMaxReservedMemory);
+  for (auto* algorithm : std::vector<PathAlgorithm*>{&astar, &bidir_astar, &multi_modal_astar,
+                                                     &raptor, &timedep_forward, &timedep_reverse}) {
+    algorithm->working_memory().set_max_reserved(max_reserved_memory);
+  }
+  isochrone_gen.working_memory().set_max_reserved(max_reserved_memory);
 }
 
 thor_worker_t::~thor_worker_t() {
@@ -119,7 +177,7 @@ thor_worker_t::work(const std::list<zmq::message_t>& job,
     // do request specific processing
     switch (options.action()) {
       case Options::sources_to_targets:
-        result = to_response_json(matrix(request), info, request);
+        result = to_response(matrix(request), info, request);
         denominator = options.sources_size() + options.targets_size();
         break;
       case Options::optimized_route: {
@@ -129,7 +187,7 @@ thor_worker_t::work(const std::list<zmq::message_t>& job,
         break;
       }
       case Options::isochrone:
-        result = to_response_json(isochrones(request), info, request);
+        result = to_response(isochrones(request), info, request);
         denominator = options.sources_size() * options.targets_size();
         break;
       case Options::route: {
@@ -145,7 +203,7 @@ thor_worker_t::work(const std::list<zmq::message_t>& job,
         break;
       }
       case Options::trace_attributes:
-        result = to_response_json(trace_attributes(request), info, request);
+        result = to_response(trace_attributes(request), info, request);
         denominator = trace.size() / 1100;
         break;
       case Options::expansion: {
@@ -153,6 +211,11 @@ thor_worker_t::work(const std::list<zmq::message_t>& job,
         denominator = options.locations_size();
         break;
       }
+      case Options::metrics:
+        // odin responds, scraping the metrics shouldn't show up in them
+        add_metrics(request);
+        result.messages.emplace_back(request.SerializeAsString());
+        return result;
       default:
         throw valhalla_exception_t{400}; // this should never happen
     }
@@ -164,17 +227,23 @@ thor_worker_t::work(const std::list<zmq::message_t>& job,
                " request elapsed time (ms)::" + std::to_string(elapsed_time));
       LOG_WARN("thor::" + Options_Action_Enum_Name(options.action()) +
                " request exceeded threshold::" + std::to_string(info.id));
-      midgard::logging::Log("valhalla_thor_long_request_" +
-                                Options_Action_Enum_Name(options.action()),
-                            " [ANALYTICS] ");
+      midgard::metrics::Increment("valhalla_long_requests_total",
+                                  {{"stage", "thor"},
+                                   {"action", Options_Action_Enum_Name(options.action())}});
+    }
+    if (!options.do_not_track()) {
+      midgard::metrics::Observe("valhalla_stage_latency_ms", elapsed_time,
+                                {{"stage", "thor"},
+                                 {"action", Options_Action_Enum_Name(options.action())}});
     }
 
     return result;
   } catch (const valhalla_exception_t& e) {
-    valhalla::midgard::logging::Log("400::" + std::string(e.what()), " [ANALYTICS] ");
+    midgard::metrics::Increment("valhalla_errors_total",
+                                {{"stage", "thor"}, {"code", std::to_string(e.code)}});
     return jsonify_error(e, info, request);
   } catch (const std::exception& e) {
-    valhalla::midgard::logging::Log("400::" + std::string(e.what()), " [ANALYTICS] ");
+    midgard::metrics::Increment("valhalla_errors_total", {{"stage", "thor"}, {"code", "499"}});
     return jsonify_error({499, std::string(e.what())}, info, request);
   }
 }
@@ -222,9 +291,16 @@ std::string thor_worker_t::parse_costing(const Api& request) {
     valhalla::sif::cost_ptr_t cost = factory.Create(options);
     mode = cost->travel_mode();
     mode_costing[static_cast<uint32_t>(mode)] = cost;
+
+    // Requests running many searches over the same tiles remember the edge costs
+    if (options.action() == Options::sources_to_targets ||
+        options.action() == Options::optimized_route || options.action() == Options::isochrone ||
+        (options.action() == Options::route && options.locations_size() > 2)) {
+      cost->EnableEdgeCostCache(edge_cost_cache_size);
+    }
   }
-  valhalla::midgard::logging::Log("travel_mode::" + std::to_string(static_cast<uint32_t>(mode)),
-                                  " [ANALYTICS] ");
+  midgard::metrics::Increment("valhalla_travel_modes_total",
+                              {{"mode", std::to_string(static_cast<uint32_t>(mode))}});
   return costing_str;
 }
 
@@ -286,29 +362,16 @@ void thor_worker_t::parse_measurements(const Api& request) {
 }
 
 void thor_worker_t::log_admin(const valhalla::TripLeg& trip_path) {
+  // count each state and country once per leg
   std::unordered_set<std::string> state_iso;
   std::unordered_set<std::string> country_iso;
-  std::stringstream s_ss, c_ss;
-  if (trip_path.admin_size() > 0) {
-    for (const auto& admin : trip_path.admin()) {
-      if (admin.has_state_code()) {
-        state_iso.insert(admin.state_code());
-      }
-      if (admin.has_country_code()) {
-        country_iso.insert(admin.country_code());
-      }
-    }
-    for (const std::string& x : state_iso) {
-      s_ss << " " << x;
-    }
-    for (const std::string& x : country_iso) {
-      c_ss << " " << x;
+  for (const auto& admin : trip_path.admin()) {
+    if (admin.has_state_code() && state_iso.insert(admin.state_code()).second) {
+      midgard::metrics::Increment("valhalla_admin_states_total", {{"state", admin.state_code()}});
     }
-    if (!s_ss.eof()) {
-      valhalla::midgard::logging::Log("admin_state_iso::" + s_ss.str() + ' ', " [ANALYTICS] ");
-    }
-    if (!c_ss.eof()) {
-      valhalla::midgard::logging::Log("admin_country_iso::" + c_ss.str() + ' ', " [ANALYTICS] ");
+    if (admin.has_country_code() && country_iso.insert(admin.country_code()).second) {
+      midgard::metrics::Increment("valhalla_admin_countries_total",
+                                  {{"country", admin.country_code()}});
     }
   }
 }
@@ -348,17 +411,45 @@ void thor_worker_t::parse_filter_attributes(const Api& request, bool is_strict_f
 }
 
 void thor_worker_t::cleanup() {
+  // Count how well the edge cost cache did and free it
+  for (auto& costing : mode_costing) {
+    if (costing && costing->edge_cost_cache()) {
+      const auto* cache = costing->edge_cost_cache();
+      midgard::metrics::Increment("valhalla_edge_cost_cache_hits_total", {}, cache->hits());
+      midgard::metrics::Increment("valhalla_edge_cost_cache_misses_total", {}, cache->misses());
+      costing->EnableEdgeCostCache(0);
+    }
+  }
   astar.Clear();
   bidir_astar.Clear();
   timedep_forward.Clear();
   timedep_reverse.Clear();
   multi_modal_astar.Clear();
+  raptor.Clear();
   trace.clear();
   isochrone_gen.Clear();
+  count_working_memory("astar", astar.working_memory());
+  count_working_memory("bidirectional_astar", bidir_astar.working_memory());
+  count_working_memory("timedep_forward", timedep_forward.working_memory());
+  count_working_memory("timedep_reverse", timedep_reverse.working_memory());
+  count_working_memory("multimodal", multi_modal_astar.working_memory());
+  count_working_memory("raptor", raptor.working_memory());
+  // Report how the result caches did here rather than while answering from them
+  LOG_DEBUG("Isochrone cache hits: " + std::to_string(isochrone_cache.hits()) +
+            " misses: " + std::to_string(isochrone_cache.misses()) +
+            " size: " + std::to_string(isochrone_cache.size()));
+  if (response_cache) {
+    LOG_DEBUG("Response cache hits: " + std::to_string(response_cache->hits()) +
+              " misses: " + std::to_string(response_cache->misses()));
+  }
+  count_working_memory("isochrone", isochrone_gen.working_memory());
   matcher_factory.ClearFullCache();
   if (reader->OverCommitted()) {
     reader->Trim();
   }
+  if (matrix_reader && matrix_reader->OverCommitted()) {
+    matrix_reader->Trim();
+  }
 }
 
 } // namespace thor
@@ -15,8 +15,12 @@ namespace tyr {
 
 struct actor_t::pimpl_t {
   pimpl_t(const boost::property_tree::ptree& config)
-      : reader(new baldr::GraphReader(config.get_child("mjolnir"))), loki_worker(config, reader),
-        thor_worker(config, reader), odin_worker(config) {
+      : pimpl_t(config, std::make_shared<baldr::GraphReader>(config.get_child("mjolnir"))) {
+  }
+  pimpl_t(const boost::property_tree::ptree& config,
+          const std::shared_ptr<baldr::GraphReader>& reader)
+      : reader(reader), loki_worker(config, reader), thor_worker(config, reader),
+        odin_worker(config) {
   }
   void set_interrupts(const std::function<void()>& interrupt_function) {
     loki_worker.set_interrupt(interrupt_function);
@@ -38,6 +42,12 @@ actor_t::actor_t(const boost::property_tree::ptree& config, bool auto_cleanup)
     : pimpl(new pimpl_t(config)), auto_cleanup(auto_cleanup) {
 }
 
+actor_t::actor_t(const boost::property_tree::ptree& config,
+                 const std::shared_ptr<baldr::GraphReader>& reader,
+                 bool auto_cleanup)
+    : pimpl(new pimpl_t(config, reader)), auto_cleanup(auto_cleanup) {
+}
+
 void actor_t::cleanup() {
   pimpl->cleanup();
 }
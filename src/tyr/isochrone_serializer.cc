@@ -1,5 +1,6 @@
 
 #include "baldr/json.h"
+#include "midgard/encoded.h"
 #include "midgard/point2.h"
 #include "midgard/pointll.h"
 #include "tyr/serializers.h"
@@ -13,7 +14,26 @@ using namespace valhalla::baldr::json;
 
 namespace {
 using rgba_t = std::tuple<float, float, float>;
+
+template <class feature_t>
+void serialize_isoline(valhalla::Api& response,
+                       float time,
+                       const std::string& color,
+                       const feature_t& feature) {
+  auto* isoline = response.add_isolines();
+  isoline->set_time(time);
+  isoline->set_color(color);
+  // all the rings go in one run of deltas so only the first point is absolute
+  std::vector<typename feature_t::value_type::value_type> points;
+  for (const auto& contour : feature) {
+    isoline->add_ring_sizes(contour.size());
+    points.insert(points.end(), contour.begin(), contour.end());
+  }
+  auto* shape = isoline->mutable_shape();
+  shape->Reserve(points.size() * 2);
+  valhalla::midgard::delta_encode(points, google::protobuf::RepeatedFieldBackInserter(shape));
 }
+} // namespace
 
 namespace valhalla {
 namespace tyr {
@@ -25,6 +45,13 @@ serializeIsochrones(const Api& request,
                     bool polygons,
                     const std::unordered_map<float, std::string>& colors,
                     bool show_locations) {
+  // the compact response skips the geojson, the locations are in the options
+  Api response;
+  bool pbf = request.options().format() == Options::pbf;
+  if (pbf) {
+    *response.mutable_options() = request.options();
+  }
+
   // for each contour interval
   int i = 0;
   auto features = array({});
@@ -50,6 +77,10 @@ serializeIsochrones(const Api& request,
 
     // for each feature on that interval
     for (const auto& feature : interval.second) {
+      if (pbf) {
+        serialize_isoline(response, interval.first, hex.str(), feature);
+        continue;
+      }
       // for each contour in that feature
       auto geom = array({});
       for (const auto& contour : feature) {
@@ -85,6 +116,10 @@ serializeIsochrones(const Api& request,
       }));
     }
   }
+  if (pbf) {
+    return response.SerializeAsString();
+  }
+
   // Add input and snapped locations to the geojson
   if (show_locations) {
     int idx = 0;
@@ -124,6 +124,20 @@ std::string serializeLocate(const Api& request,
                             const std::vector<baldr::Location>& locations,
                             const std::unordered_map<baldr::Location, PathLocation>& projections,
                             GraphReader& reader) {
+  // the compact response is the options with the candidates of each location filled out
+  if (request.options().format() == Options::pbf) {
+    Api response;
+    auto* options = response.mutable_options();
+    *options = request.options();
+    for (size_t i = 0; i < locations.size(); ++i) {
+      auto projection = projections.find(locations[i]);
+      if (projection != projections.cend()) {
+        PathLocation::toPBF(projection->second, options->mutable_locations(i), reader);
+      }
+    }
+    return response.SerializeAsString();
+  }
+
   auto json = json::array({});
   for (const auto& location : locations) {
     try {
@@ -135,12 +135,36 @@ json::MapPtr serialize(const Api& request,
 }
 } // namespace valhalla_serializers
 
+namespace pbf_serializers {
+
+std::string serialize(const Api& request,
+                      const std::vector<TimeDistance>& time_distances,
+                      double distance_scale) {
+  Api response;
+  *response.mutable_options() = request.options();
+  auto* matrix = response.mutable_matrix();
+  matrix->mutable_times()->Reserve(time_distances.size());
+  matrix->mutable_distances()->Reserve(time_distances.size());
+  for (const auto& td : time_distances) {
+    // a negative distance marks a pair without a route
+    bool found = td.time != kMaxCost;
+    matrix->add_times(found ? td.time : 0);
+    matrix->add_distances(found ? td.dist * distance_scale : -1.f);
+  }
+  return response.SerializeAsString();
+}
+
+} // namespace pbf_serializers
+
 namespace valhalla {
 namespace tyr {
 
 std::string serializeMatrix(const Api& request,
                             const std::vector<TimeDistance>& time_distances,
                             double distance_scale) {
+  if (request.options().format() == Options::pbf) {
+    return pbf_serializers::serialize(request, time_distances, distance_scale);
+  }
 
   auto json = request.options().format() == Options::osrm
                   ? osrm_serializers::serialize(request, time_distances, distance_scale)
@@ -38,7 +38,7 @@ std::string pathToGPX(const google::protobuf::RepeatedPtrField<TripLeg>& legs) {
   // for each leg
   for (const auto& leg : legs) {
     // decode the shape for this leg
-    auto wpts = midgard::decode<std::vector<PointLL>>(leg.shape());
+    auto wpts = midgard::delta_decode<std::vector<PointLL>>(leg.shape());
 
     // throw the shape points in as way points
     // TODO: add time to each, need transition time at nodes
@@ -85,6 +85,8 @@ std::string serializeDirections(Api& request) {
       return pathToGPX(request.trip().routes(0).legs());
     case Options_Format_json:
       return valhalla_serializers::serialize(request);
+    case Options_Format_pbf:
+      return request.SerializeAsString();
     default:
       throw;
   }
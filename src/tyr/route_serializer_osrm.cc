@@ -282,28 +282,31 @@ json::MapPtr geojson_shape(const std::vector<PointLL> shape) {
   return geojson;
 }
 
-// Generate full shape of the route.
-std::vector<PointLL>
-full_shape(const google::protobuf::RepeatedPtrField<valhalla::DirectionsLeg>& legs,
-           const valhalla::Options& options) {
-  // If just one leg and it we want polyline6 then we just return the encoded leg shape
-  if (legs.size() == 1 && options.shape_format() == polyline6) {
-    return midgard::decode<std::vector<PointLL>>(legs.begin()->shape());
-  }
-
-  // TODO: there is a tricky way to do this... since the end of each leg is the same as the
-  // beginning we essentially could just peel off the first encoded shape point of all the legs (but
-  // the first) this way we wouldn't really have to do any decoding (would be far faster). it might
-  // even be the case that the string length of the first number is a fixed length (which would be
-  // great!) have to have a look should make this a function in midgard probably so the logic is all
-  // in the same place
-  std::vector<PointLL> decoded;
+// Generate the full shape of the route as fixed point deltas, see midgard::delta_encode. Since the
+// end of each leg is the same as the beginning of the next the first point of all the legs but the
+// first is dropped, which only needs the point after it rebased onto the end of the previous leg.
+std::vector<int32_t>
+full_shape(const google::protobuf::RepeatedPtrField<valhalla::DirectionsLeg>& legs) {
+  std::vector<int32_t> deltas;
+  int32_t last_lon = 0, last_lat = 0;
   for (const auto& leg : legs) {
-    auto decoded_leg = midgard::decode<std::vector<PointLL>>(leg.shape());
-    decoded.insert(decoded.end(), decoded.size() ? decoded_leg.begin() + 1 : decoded_leg.begin(),
-                   decoded_leg.end());
+    const auto& shape = leg.shape();
+    bool skip = !deltas.empty();
+    int32_t lon = 0, lat = 0;
+    for (auto delta = shape.begin(); delta + 1 < shape.end(); delta += 2) {
+      lon += *delta;
+      lat += *(delta + 1);
+      if (skip) {
+        skip = false;
+        continue;
+      }
+      deltas.push_back(lon - last_lon);
+      deltas.push_back(lat - last_lat);
+      last_lon = lon;
+      last_lat = lat;
+    }
   }
-  return decoded;
+  return deltas;
 }
 
 // Generate simplified shape of the route.
@@ -317,7 +320,7 @@ simplified_shape(const google::protobuf::RepeatedPtrField<valhalla::DirectionsLe
   std::unordered_set<size_t> indices;
 
   for (const auto& leg : legs) {
-    auto decoded_leg = midgard::decode<std::vector<PointLL>>(leg.shape());
+    auto decoded_leg = midgard::delta_decode<std::vector<PointLL>>(leg.shape());
     for (const auto& coord : decoded_leg) {
       south_west.lng = std::min(south_west.lng, toFixed(coord.lng()));
       south_west.lat = std::min(south_west.lat, toFixed(coord.lat()));
@@ -350,7 +353,13 @@ void route_geometry(json::MapPtr& route,
   if (options.has_generalize() && options.generalize() == 0.0f) {
     shape = simplified_shape(legs, options);
   } else if (!options.has_generalize() || (options.has_generalize() && options.generalize() > 0.0f)) {
-    shape = full_shape(legs, options);
+    auto deltas = full_shape(legs);
+    // polyline6 is made straight from the deltas without going through the points
+    if (options.shape_format() == polyline6) {
+      route->emplace("geometry", midgard::delta_to_polyline(deltas));
+      return;
+    }
+    shape = midgard::delta_decode<std::vector<PointLL>>(deltas);
   }
 
   if (options.shape_format() == geojson) {
@@ -1192,7 +1201,7 @@ json::ArrayPtr serialize_legs(const google::protobuf::RepeatedPtrField<valhalla:
 
     // Get the full shape for the leg. We want to use this for serializing
     // encoded shape for each step (maneuver) in OSRM output.
-    auto shape = midgard::decode<std::vector<PointLL>>(leg->shape());
+    auto shape = midgard::delta_decode<std::vector<PointLL>>(leg->shape());
 
     //#########################################################################
     // Iterate through maneuvers - convert to OSRM steps
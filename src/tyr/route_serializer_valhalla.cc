@@ -3,6 +3,7 @@
 
 #include "baldr/json.h"
 #include "midgard/aabb2.h"
+#include "midgard/encoded.h"
 #include "midgard/logging.h"
 #include "odin/util.h"
 #include "tyr/serializers.h"
@@ -554,7 +555,7 @@ legs(const google::protobuf::RepeatedPtrField<valhalla::DirectionsLeg>& directio
     summary->emplace("max_lon", json::fp_t{directions_leg.summary().bbox().max_ll().lng(), 6});
     summary->emplace("has_time_restrictions", json::Value{has_time_restrictions});
     leg->emplace("summary", summary);
-    leg->emplace("shape", directions_leg.shape());
+    leg->emplace("shape", midgard::delta_to_polyline(directions_leg.shape()));
 
     legs->emplace_back(leg);
   }
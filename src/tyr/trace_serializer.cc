@@ -2,6 +2,7 @@
 
 #include "baldr/graphconstants.h"
 #include "baldr/json.h"
+#include "midgard/encoded.h"
 #include "odin/enhancedtrippath.h"
 #include "thor/attributes_controller.h"
 #include "thor/match_result.h"
@@ -440,6 +441,81 @@ json::MapPtr serialize_shape_attributes(const AttributesController& controller,
   return attributes_map;
 }
 
+void serialize_matched_points(const AttributesController& controller,
+                              const std::vector<thor::MatchResult>& match_results,
+                              TraceMatch& trace_match) {
+  for (const auto& match_result : match_results) {
+    auto* matched_point = trace_match.add_matched_points();
+
+    if (controller.attributes.at(kMatchedPoint)) {
+      matched_point->mutable_ll()->set_lng(match_result.lnglat.first);
+      matched_point->mutable_ll()->set_lat(match_result.lnglat.second);
+    }
+
+    if (controller.attributes.at(kMatchedType)) {
+      switch (match_result.type) {
+        case thor::MatchResult::Type::kMatched:
+          matched_point->set_type(TraceMatch::MatchedPoint::matched);
+          break;
+        case thor::MatchResult::Type::kInterpolated:
+          matched_point->set_type(TraceMatch::MatchedPoint::interpolated);
+          break;
+        default:
+          matched_point->set_type(TraceMatch::MatchedPoint::unmatched);
+          break;
+      }
+    }
+
+    if (controller.attributes.at(kMatchedEdgeIndex) && match_result.HasEdgeIndex()) {
+      matched_point->set_edge_index(match_result.edge_index);
+    }
+
+    if (controller.attributes.at(kMatchedBeginRouteDiscontinuity) &&
+        match_result.begin_route_discontinuity) {
+      matched_point->set_begin_route_discontinuity(true);
+    }
+
+    if (controller.attributes.at(kMatchedEndRouteDiscontinuity) &&
+        match_result.end_route_discontinuity) {
+      matched_point->set_end_route_discontinuity(true);
+    }
+
+    if (match_result.type != thor::MatchResult::Type::kUnmatched) {
+      if (controller.attributes.at(kMatchedDistanceAlongEdge)) {
+        matched_point->set_distance_along_edge(match_result.distance_along);
+      }
+      if (controller.attributes.at(kMatchedDistanceFromTracePoint)) {
+        matched_point->set_distance_from_trace_point(match_result.distance_from);
+      }
+    }
+  }
+}
+
+// the compact response is the trip, whose legs are already filtered by the controller, and the
+// scores and matched points of each of its routes
+std::string serialize_pbf(
+    const Api& request,
+    const AttributesController& controller,
+    const std::vector<std::tuple<float, float, std::vector<thor::MatchResult>>>& results) {
+  Api response;
+  *response.mutable_options() = request.options();
+  *response.mutable_trip() = request.trip();
+  for (const auto& map_match_result : results) {
+    auto* trace_match = response.add_trace_matches();
+    if (controller.attributes.at(kConfidenceScore)) {
+      trace_match->set_confidence_score(std::get<kConfidenceScoreIndex>(map_match_result));
+    }
+    if (controller.attributes.at(kRawScore)) {
+      trace_match->set_raw_score(std::get<kRawScoreIndex>(map_match_result));
+    }
+    const auto& match_results = std::get<kMatchResultsIndex>(map_match_result);
+    if (controller.category_attribute_enabled(kMatchedCategory)) {
+      serialize_matched_points(controller, match_results, *trace_match);
+    }
+  }
+  return response.SerializeAsString();
+}
+
 void append_trace_info(
     const json::MapPtr& json,
     const AttributesController& controller,
@@ -455,8 +531,8 @@ void append_trace_info(
   }
 
   // Add shape
-  if (trip_path.has_shape()) {
-    json->emplace("shape", trip_path.shape());
+  if (trip_path.shape_size()) {
+    json->emplace("shape", midgard::delta_to_polyline(trip_path.shape()));
   }
 
   // Add confidence_score
@@ -497,6 +573,9 @@ std::string serializeTraceAttributes(
     const Api& request,
     const AttributesController& controller,
     std::vector<std::tuple<float, float, std::vector<thor::MatchResult>>>& map_match_results) {
+  if (request.options().format() == Options::pbf) {
+    return serialize_pbf(request, controller, map_match_results);
+  }
 
   // Create json map to return
   auto json = json::map({});
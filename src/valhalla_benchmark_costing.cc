@@ -0,0 +1,190 @@
+#include <boost/program_options.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "baldr/graphreader.h"
+#include "baldr/rapidjson_utils.h"
+#include "baldr/tilehierarchy.h"
+#include "config.h"
+#include "midgard/logging.h"
+#include "sif/costdispatch.h"
+#include "sif/costfactory.h"
+#include "worker.h"
+
+using namespace valhalla;
+using namespace valhalla::baldr;
+using namespace valhalla::sif;
+
+namespace bpo = boost::program_options;
+
+namespace {
+
+// An edge relaxation like the path algorithms do: the costing of the edge
+// leaving the end node of the predecessor edge
+struct relaxation_t {
+  EdgeLabel pred;
+  const GraphTile* tile;
+  const NodeInfo* node;
+  const DirectedEdge* edge;
+  GraphId edgeid;
+};
+
+// Collect the relaxations at every node of the first max_tiles tiles
+std::vector<relaxation_t> get_relaxations(GraphReader& reader, const size_t max_tiles) {
+  std::vector<relaxation_t> relaxations;
+  size_t tiles = 0;
+  for (const auto& tile_id : reader.GetTileSet()) {
+    const GraphTile* tile = reader.GetGraphTile(tile_id);
+    if (tile == nullptr || tile_id.level() == TileHierarchy::GetTransitLevel().level) {
+      continue;
+    }
+    if (tiles++ == max_tiles) {
+      break;
+    }
+    GraphId pred_id = tile->header()->graphid();
+    for (uint32_t i = 0; i < tile->header()->directededgecount(); ++i, ++pred_id) {
+      const DirectedEdge* pred_edge = tile->directededge(i);
+      if (pred_edge->leaves_tile()) {
+        continue;
+      }
+      EdgeLabel pred(kInvalidLabel, pred_id, pred_edge, {}, 0.0f, 0.0f, TravelMode::kDrive, 0, {});
+      const NodeInfo* node = tile->node(pred_edge->endnode());
+      GraphId edgeid(tile_id.tileid(), tile_id.level(), node->edge_index());
+      const DirectedEdge* edge = tile->directededge(node->edge_index());
+      for (uint32_t j = 0; j < node->edge_count(); ++j, ++edge, ++edgeid) {
+        relaxations.push_back({pred, tile, node, edge, edgeid});
+      }
+    }
+  }
+  return relaxations;
+}
+
+// Cost all of the relaxations. Returns the total cost so results can be compared and
+// so the compiler cannot skip any of the work.
+template <class costing_t>
+float relax(const costing_t& costing, const std::vector<relaxation_t>& relaxations) {
+  float total = 0.0f;
+  for (const auto& r : relaxations) {
+    bool has_time_restrictions = false;
+    const GraphTile* tile = r.tile;
+    if (!costing.Allowed(r.node) ||
+        !costing.Allowed(r.edge, r.pred, tile, r.edgeid, 0, 0, has_time_restrictions)) {
+      continue;
+    }
+    total += (costing.EdgeCost(r.edge, r.tile) + costing.TransitionCost(r.edge, r.node, r.pred)).cost;
+  }
+  return total;
+}
+
+// Time a number of passes over the relaxations in nanoseconds per relaxation
+template <class relax_t>
+double time_passes(const relax_t& pass, const size_t relaxations, const uint32_t passes) {
+  auto start = std::chrono::high_resolution_clock::now();
+  for (uint32_t i = 0; i < passes; ++i) {
+    pass();
+  }
+  auto end = std::chrono::high_resolution_clock::now();
+  auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+  return static_cast<double>(ns) / (static_cast<double>(relaxations) * passes);
+}
+
+} // namespace
+
+/**
+ * Benchmark of the per edge costing calls of the path algorithms. Costs the same
+ * edge relaxations through the DynamicCost interface (virtual calls) and through
+ * the concrete costing type the path algorithms dispatch to (sif::visit_costing).
+ */
+int main(int argc, char* argv[]) {
+  std::string config;
+  std::vector<std::string> costings;
+  size_t max_tiles;
+  uint32_t passes;
+
+  bpo::options_description options(
+      "valhalla " VALHALLA_VERSION "\n"
+      "\n"
+      " Usage: valhalla_benchmark_costing [options]\n"
+      "\n"
+      "valhalla_benchmark_costing compares the time per edge relaxation of costing through "
+      "the virtual DynamicCost interface to costing with the concrete costing type."
+      "\n"
+      "\n");
+
+  options.add_options()("help,h", "Print this help message.")(
+      "version,v", "Print the version of this software.")(
+      "config,c", bpo::value<std::string>(&config)->required(),
+      "Path to the json configuration file.")(
+      "costing", bpo::value<std::vector<std::string>>(&costings)->multitoken(),
+      "Costings to benchmark. Default: auto truck bicycle pedestrian motorcycle motor_scooter")(
+      "max-tiles", bpo::value<size_t>(&max_tiles)->default_value(64),
+      "Maximum number of tiles whose edges are costed.")(
+      "passes,p", bpo::value<uint32_t>(&passes)->default_value(20),
+      "Number of passes over the edges per costing.");
+
+  bpo::variables_map vm;
+  try {
+    bpo::store(bpo::command_line_parser(argc, argv).options(options).run(), vm);
+    if (vm.count("help")) {
+      std::cout << options << "\n";
+      return EXIT_SUCCESS;
+    }
+    if (vm.count("version")) {
+      std::cout << "valhalla_benchmark_costing " << VALHALLA_VERSION << "\n";
+      return EXIT_SUCCESS;
+    }
+    bpo::notify(vm);
+  } catch (std::exception& e) {
+    std::cerr << "Unable to parse command line options because: " << e.what() << "\n"
+              << "This is a bug, please report it at " PACKAGE_BUGREPORT << "\n";
+    return EXIT_FAILURE;
+  }
+  if (costings.empty()) {
+    costings = {"auto", "truck", "bicycle", "pedestrian", "motorcycle", "motor_scooter"};
+  }
+
+  boost::property_tree::ptree pt;
+  rapidjson::read_json(config, pt);
+  GraphReader reader(pt.get_child("mjolnir"));
+  auto relaxations = get_relaxations(reader, max_tiles);
+  if (relaxations.empty()) {
+    LOG_ERROR("No edges found in the tiles");
+    return EXIT_FAILURE;
+  }
+  LOG_INFO("Costing " + std::to_string(relaxations.size()) + " edge relaxations " +
+           std::to_string(passes) + " times per costing");
+
+  CostFactory<DynamicCost> factory;
+  factory.RegisterStandardCostingModels();
+  for (const auto& costing_str : costings) {
+    // Parse a request for the default costing options
+    Api request;
+    ParseApi(R"({"costing":")" + costing_str + R"("})", Options::route, request);
+    auto costing = factory.Create(request.options());
+
+    // Both have to cost the relaxations the same
+    const DynamicCost& dynamic = *costing;
+    float virtual_total = 0.0f, direct_total = 0.0f;
+    double virtual_ns = time_passes([&]() { virtual_total = relax(dynamic, relaxations); },
+                                    relaxations.size(), passes);
+    double direct_ns = time_passes(
+        [&]() {
+          direct_total = visit_costing(dynamic, [&](const auto& direct) {
+            return relax(direct, relaxations);
+          });
+        },
+        relaxations.size(), passes);
+    if (virtual_total != direct_total) {
+      LOG_ERROR(costing_str + ": virtual and direct costing differ " +
+                std::to_string(virtual_total) + " != " + std::to_string(direct_total));
+    }
+    LOG_INFO(costing_str + ": virtual " + std::to_string(virtual_ns) + " ns/edge, direct " +
+             std::to_string(direct_ns) + " ns/edge");
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -189,7 +189,7 @@ const valhalla::TripLeg* PathTest(GraphReader& reader,
     LOG_INFO("Testing RouteMatcher");
 
     // Get shape
-    std::vector<PointLL> shape = decode<std::vector<PointLL>>(trip_path.shape());
+    std::vector<PointLL> shape = delta_decode<std::vector<PointLL>>(trip_path.shape());
     std::vector<Measurement> trace;
     trace.reserve(shape.size());
     std::transform(shape.begin(), shape.end(), std::back_inserter(trace), [](const PointLL& p) {
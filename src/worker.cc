@@ -1,4 +1,5 @@
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <unordered_map>
 
@@ -7,6 +8,7 @@
 #include "baldr/location.h"
 #include "midgard/encoded.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include "midgard/util.h"
 #include "odin/util.h"
 #include "sif/costfactory.h"
@@ -92,14 +94,14 @@ const std::unordered_map<unsigned, unsigned> ERROR_TO_STATUS{
 
     {120, 400}, {121, 400}, {122, 400}, {123, 400}, {124, 400}, {125, 400}, {126, 400},
 
-    {130, 400}, {131, 400}, {132, 400}, {133, 400}, {136, 400},
+    {130, 400}, {131, 400}, {132, 400}, {133, 400}, {136, 400}, {137, 400},
 
     {140, 400}, {141, 501}, {142, 501},
 
     {150, 400}, {151, 400}, {152, 400}, {153, 400}, {154, 400}, {155, 400}, {156, 400},
     {157, 400}, {158, 400}, {159, 400},
 
-    {160, 400}, {161, 400}, {162, 400}, {163, 400}, {164, 400},
+    {160, 400}, {161, 400}, {162, 400}, {163, 400}, {164, 400}, {165, 400},
 
     {170, 400}, {171, 400}, {172, 400},
 
@@ -170,6 +172,8 @@ const std::unordered_map<unsigned, std::string> OSRM_ERRORS_CODES{
      R"({"code":"InvalidValue","message":"The successfully parsed query parameters are invalid."})"},
     {136,
      R"({"code":"InvalidValue","message":"The successfully parsed query parameters are invalid."})"},
+    {137,
+     R"({"code":"InvalidValue","message":"The successfully parsed query parameters are invalid."})"},
 
     {140,
      R"({"code":"InvalidValue","message":"The successfully parsed query parameters are invalid."})"},
@@ -205,6 +209,8 @@ const std::unordered_map<unsigned, std::string> OSRM_ERRORS_CODES{
      R"({"code":"InvalidValue","message":"The successfully parsed query parameters are invalid."})"},
     {164,
      R"({"code":"InvalidValue","message":"The successfully parsed query parameters are invalid."})"},
+    {165,
+     R"({"code":"InvalidValue","message":"The successfully parsed query parameters are invalid."})"},
 
     {170, R"({"code":"NoRoute","message":"Impossible route between points"})"},
     {171,
@@ -467,8 +473,8 @@ void parse_locations(const rapidjson::Document& doc,
       locations->Mutable(locations->size() - 1)->set_type(valhalla::Location::kBreak);
     }
     if (track) {
-      midgard::logging::Log(node + "_count::" + std::to_string(request_locations->Size()),
-                            " [ANALYTICS] ");
+      midgard::metrics::Observe("valhalla_request_locations", request_locations->Size(),
+                                {{"type", node}}, midgard::metrics::kSizeBounds);
     }
 
     // push the date time information down into the locations
@@ -478,6 +484,40 @@ void parse_locations(const rapidjson::Document& doc,
   }
 }
 
+void parse_avoid_polygons(const rapidjson::Document& doc, Options& options) {
+  auto rings = rapidjson::get_optional<rapidjson::Value::ConstArray>(doc, "/avoid_polygons");
+  if (!rings) {
+    return;
+  }
+
+  // each polygon is an outer ring of [lon, lat] coordinates, closing it is optional
+  for (const auto& json_ring : *rings) {
+    try {
+      if (!json_ring.IsArray()) {
+        throw std::runtime_error("avoid polygon must be an array of coordinates");
+      }
+      auto* ring = options.add_avoid_polygons();
+      for (const auto& json_coord : json_ring.GetArray()) {
+        if (!json_coord.IsArray() || json_coord.Size() < 2 || !json_coord[0].IsNumber() ||
+            !json_coord[1].IsNumber()) {
+          throw std::runtime_error("avoid polygon coordinates must be [lon, lat]");
+        }
+        auto lat = json_coord[1].GetFloat();
+        if (lat < -90.0f || lat > 90.0f) {
+          throw std::runtime_error("Latitude must be in the range [-90, 90] degrees");
+        }
+        auto lon = midgard::circular_range_clamp<float>(json_coord[0].GetFloat(), -180, 180);
+        auto* ll = ring->add_coords();
+        ll->set_lat(lat);
+        ll->set_lng(lon);
+      }
+      if (ring->coords_size() < 3) {
+        throw std::runtime_error("avoid polygon needs at least 3 coordinates");
+      }
+    } catch (...) { throw valhalla_exception_t{137}; }
+  }
+}
+
 void parse_contours(const rapidjson::Document& doc,
                     google::protobuf::RepeatedPtrField<Contour>* contours) {
 
@@ -552,7 +592,7 @@ void from_json(rapidjson::Document& doc, Options& options) {
   }
 
   auto language = rapidjson::get_optional<std::string>(doc, "/language");
-  if (language && odin::get_locales().find(*language) != odin::get_locales().end()) {
+  if (language && odin::is_supported_locale(*language)) {
     options.set_language(*language);
   }
 
@@ -790,6 +830,7 @@ void from_json(rapidjson::Document& doc, Options& options) {
 
   // get the avoids in there
   parse_locations(doc, options, "avoid_locations", 133, track);
+  parse_avoid_polygons(doc, options);
 
   // if not a time dependent route/mapmatch disable time dependent edge speed/flow data sources
   // TODO: this is because bidirectional a* defaults to middle of the day time for speed lookup
@@ -931,6 +972,7 @@ bool Options_Action_Enum_Parse(const std::string& action, Options::Action* a) {
       {"height", Options::height},
       {"transit_available", Options::transit_available},
       {"expansion", Options::expansion},
+      {"metrics", Options::metrics},
   };
   auto i = actions.find(action);
   if (i == actions.cend())
@@ -952,6 +994,7 @@ const std::string& Options_Action_Enum_Name(const Options::Action action) {
       {Options::height, "height"},
       {Options::transit_available, "transit_available"},
       {Options::expansion, "expansion"},
+      {Options::metrics, "metrics"},
   };
   auto i = actions.find(action);
   return i == actions.cend() ? empty : i->second;
@@ -1033,6 +1076,7 @@ bool Options_Format_Enum_Parse(const std::string& format, Options::Format* f) {
       {"json", Options::json},
       {"gpx", Options::gpx},
       {"osrm", Options::osrm},
+      {"pbf", Options::pbf},
   };
   auto i = formats.find(format);
   if (i == formats.cend())
@@ -1047,6 +1091,7 @@ const std::string& Options_Format_Enum_Name(const Options::Format match) {
       {Options::json, "json"},
       {Options::gpx, "gpx"},
       {Options::osrm, "osrm"},
+      {Options::pbf, "pbf"},
   };
   auto i = formats.find(match);
   return i == formats.cend() ? empty : i->second;
@@ -1128,6 +1173,59 @@ void ParseApi(const std::string& request, Options::Action action, valhalla::Api&
   from_json(document, *api.mutable_options());
 }
 
+void add_metrics(valhalla::Api& api) {
+  // the stages of a service may or may not run in the same process
+  static const uint64_t id = (uint64_t(std::random_device()()) << 32) | std::random_device()();
+  for (const auto& process : api.metrics().processes()) {
+    if (process.id() == id) {
+      return;
+    }
+  }
+  auto* process = api.mutable_metrics()->add_processes();
+  process->set_id(id);
+
+  auto snapshot = midgard::metrics::Registry::Get().GetSnapshot();
+  for (const auto& counter : snapshot.counters) {
+    auto* series = process->add_counters();
+    series->set_key(counter.first);
+    series->set_value(counter.second);
+  }
+  for (const auto& histogram : snapshot.histograms) {
+    auto* series = process->add_histograms();
+    series->set_key(histogram.first);
+    for (auto bound : histogram.second.bounds) {
+      series->add_bounds(bound);
+    }
+    for (auto bucket : histogram.second.buckets) {
+      series->add_buckets(bucket);
+    }
+    series->set_count(histogram.second.count);
+    series->set_sum(histogram.second.sum);
+  }
+}
+
+std::string serialize_metrics(const valhalla::Api& api) {
+  midgard::metrics::Snapshot merged;
+  for (const auto& process : api.metrics().processes()) {
+    midgard::metrics::Snapshot snapshot;
+    for (const auto& series : process.counters()) {
+      snapshot.counters[series.key()] = series.value();
+    }
+    for (const auto& series : process.histograms()) {
+      // there is a bucket above the last bound
+      if (series.buckets_size() != series.bounds_size() + 1) {
+        continue;
+      }
+      snapshot.histograms[series.key()] = {{series.bounds().begin(), series.bounds().end()},
+                                           {series.buckets().begin(), series.buckets().end()},
+                                           series.count(),
+                                           series.sum()};
+    }
+    merged.Merge(snapshot);
+  }
+  return merged.Serialize();
+}
+
 #ifdef HAVE_HTTP
 void ParseApi(const http_request_t& request, valhalla::Api& api) {
   api.Clear();
@@ -1198,6 +1296,9 @@ const headers_t::value_type JSON_MIME{"Content-type", "application/json;charset=
 const headers_t::value_type JS_MIME{"Content-type", "application/javascript;charset=utf-8"};
 const headers_t::value_type XML_MIME{"Content-type", "text/xml;charset=utf-8"};
 const headers_t::value_type GPX_MIME{"Content-type", "application/gpx+xml;charset=utf-8"};
+const headers_t::value_type PBF_MIME{"Content-type", "application/x-protobuf"};
+const headers_t::value_type TEXT_MIME{"Content-type",
+                                      "text/plain;version=0.0.4;charset=utf-8"};
 const headers_t::value_type ATTACHMENT{"Content-Disposition", "attachment; filename=route.gpx"};
 
 worker_t::result_t jsonify_error(const valhalla_exception_t& exception,
@@ -1305,6 +1406,32 @@ to_response_xml(const std::string& xml, http_request_info_t& request_info, const
   return result;
 }
 
+worker_t::result_t
+to_response_pbf(const std::string& pbf, http_request_info_t& request_info, const Api&) {
+  worker_t::result_t result{false, std::list<std::string>(), ""};
+  http_response_t response(200, "OK", pbf, headers_t{CORS, PBF_MIME});
+  response.from_info(request_info);
+  result.messages.emplace_back(response.to_string());
+  return result;
+}
+
+worker_t::result_t
+to_response_text(const std::string& text, http_request_info_t& request_info, const Api&) {
+  worker_t::result_t result{false, std::list<std::string>(), ""};
+  http_response_t response(200, "OK", text, headers_t{CORS, TEXT_MIME});
+  response.from_info(request_info);
+  result.messages.emplace_back(response.to_string());
+  return result;
+}
+
+worker_t::result_t
+to_response(const std::string& data, http_request_info_t& request_info, const Api& request) {
+  // the serializers of the actions supporting pbf fall back to json for every other format
+  return request.options().format() == Options::pbf
+             ? to_response_pbf(data, request_info, request)
+             : to_response_json(data, request_info, request);
+}
+
 #endif
 
 service_worker_t::service_worker_t() : interrupt(nullptr) {
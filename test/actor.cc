@@ -3,6 +3,8 @@
 #include "baldr/rapidjson_utils.h"
 #include <boost/property_tree/ptree.hpp>
 
+#include "midgard/encoded.h"
+#include "midgard/pointll.h"
 #include "tyr/actor.h"
 
 #include "test.h"
@@ -122,6 +124,130 @@ TEST_F(ActorInterrupt, TraceAttributes) {
                test_exception_t);
 }
 
+// the pbf responses decode to the same results as the json ones
+class ActorPbf : public ::testing::Test {
+protected:
+  void SetUp() override {
+    conf = make_conf();
+  }
+
+  boost::property_tree::ptree conf;
+};
+
+TEST_F(ActorPbf, Route) {
+  tyr::actor_t actor(conf, true);
+  std::string request = R"({"locations":[{"lat":40.546115,"lon":-76.385076,"type":"break"},
+        {"lat":40.544232,"lon":-76.385752,"type":"break"}],"costing":"auto")";
+  auto json = json_to_pt(actor.route(request + "}"));
+  Api pbf;
+  ASSERT_TRUE(pbf.ParseFromString(actor.route(request + R"(,"format":"pbf"})")));
+
+  ASSERT_EQ(pbf.directions().routes_size(), 1);
+  const auto& legs = json.get_child("trip.legs");
+  ASSERT_EQ(pbf.directions().routes(0).legs_size(), legs.size());
+  auto leg = pbf.directions().routes(0).legs().begin();
+  for (const auto& expected : legs) {
+    EXPECT_EQ(midgard::delta_to_polyline(leg->shape()), expected.second.get<std::string>("shape"));
+    EXPECT_EQ(leg->maneuver_size(), expected.second.get_child("maneuvers").size());
+    EXPECT_NEAR(leg->summary().time(), expected.second.get<double>("summary.time"), .001);
+    EXPECT_NEAR(leg->summary().length(), expected.second.get<float>("summary.length"), .001f);
+    ++leg;
+  }
+}
+
+TEST_F(ActorPbf, Matrix) {
+  tyr::actor_t actor(conf, true);
+  std::string request = R"({"sources":[{"lat":40.546115,"lon":-76.385076},
+        {"lat":40.544232,"lon":-76.385752}],"targets":[{"lat":40.546115,"lon":-76.385076},
+        {"lat":40.544232,"lon":-76.385752},{"lat":40.545,"lon":-76.3855}],"costing":"auto")";
+  auto json = json_to_pt(actor.matrix(request + "}"));
+  Api pbf;
+  ASSERT_TRUE(pbf.ParseFromString(actor.matrix(request + R"(,"format":"pbf"})")));
+
+  // row major, one entry per source and target pair
+  const auto& matrix = pbf.matrix();
+  ASSERT_EQ(matrix.times_size(), 6);
+  ASSERT_EQ(matrix.distances_size(), 6);
+  int i = 0;
+  for (const auto& row : json.get_child("sources_to_targets")) {
+    for (const auto& expected : row.second) {
+      EXPECT_EQ(expected.second.get<int>("from_index") * 3 + expected.second.get<int>("to_index"),
+                i);
+      EXPECT_EQ(matrix.times(i), expected.second.get<uint32_t>("time"));
+      EXPECT_NEAR(matrix.distances(i), expected.second.get<float>("distance"), .001f);
+      ++i;
+    }
+  }
+  EXPECT_EQ(i, 6);
+}
+
+TEST_F(ActorPbf, Isochrone) {
+  tyr::actor_t actor(conf, true);
+  std::string request = R"({"locations":[{"lat":40.546115,"lon":-76.385076}],"costing":"auto",
+        "contours":[{"time":2},{"time":4}],"polygons":true)";
+  auto json = json_to_pt(actor.isochrone(request + "}"));
+  Api pbf;
+  ASSERT_TRUE(pbf.ParseFromString(actor.isochrone(request + R"(,"format":"pbf"})")));
+
+  const auto& features = json.get_child("features");
+  ASSERT_GT(features.size(), 0u);
+  ASSERT_EQ(pbf.isolines_size(), features.size());
+  auto isoline = pbf.isolines().begin();
+  for (const auto& feature : features) {
+    EXPECT_EQ(isoline->time(), feature.second.get<float>("properties.contour"));
+    EXPECT_EQ(isoline->color(), feature.second.get<std::string>("properties.color"));
+
+    // the rings are one run of points split by their sizes
+    auto points = midgard::delta_decode<std::vector<midgard::PointLL>>(isoline->shape());
+    const auto& rings = feature.second.get_child("geometry.coordinates");
+    ASSERT_EQ(isoline->ring_sizes_size(), rings.size());
+    auto ring_size = isoline->ring_sizes().begin();
+    auto point = points.cbegin();
+    for (const auto& ring : rings) {
+      ASSERT_EQ(*ring_size, ring.second.size());
+      for (const auto& coordinate : ring.second) {
+        ASSERT_NE(point, points.cend());
+        EXPECT_NEAR(point->lng(), coordinate.second.front().second.get_value<double>(), 2e-6);
+        EXPECT_NEAR(point->lat(), coordinate.second.back().second.get_value<double>(), 2e-6);
+        ++point;
+      }
+      ++ring_size;
+    }
+    EXPECT_EQ(point, points.cend());
+    ++isoline;
+  }
+}
+
+TEST_F(ActorPbf, Locate) {
+  tyr::actor_t actor(conf, true);
+  std::string request = R"({"locations":[{"lat":40.546115,"lon":-76.385076},
+        {"lat":40.544232,"lon":-76.385752}],"costing":"auto")";
+  auto json = json_to_pt(actor.locate(request + "}"));
+  Api pbf;
+  ASSERT_TRUE(pbf.ParseFromString(actor.locate(request + R"(,"format":"pbf"})")));
+
+  // the candidate edges of each location are in the options
+  ASSERT_EQ(pbf.options().locations_size(), json.size());
+  auto location = pbf.options().locations().begin();
+  for (const auto& expected : json) {
+    const auto& edges = expected.second.get_child("edges");
+    ASSERT_GT(edges.size(), 0u);
+    ASSERT_EQ(location->path_edges_size(), edges.size());
+    auto edge = location->path_edges().begin();
+    for (const auto& expected_edge : edges) {
+      EXPECT_NEAR(edge->ll().lat(), expected_edge.second.get<double>("correlated_lat"), 1e-6);
+      EXPECT_NEAR(edge->ll().lng(), expected_edge.second.get<double>("correlated_lon"), 1e-6);
+      EXPECT_NEAR(edge->percent_along(), expected_edge.second.get<float>("percent_along"), 1e-5f);
+      auto side = expected_edge.second.get<std::string>("side_of_street");
+      EXPECT_EQ(edge->side_of_street(), side == "left" ? Location::kLeft
+                                                       : (side == "right" ? Location::kRight
+                                                                          : Location::kNone));
+      ++edge;
+    }
+    ++location;
+  }
+}
+
 // TODO: test the rest of them
 
 } // namespace
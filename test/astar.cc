@@ -11,6 +11,7 @@
 #include "filesystem.h"
 #include "loki/search.h"
 #include "loki/worker.h"
+#include "midgard/encoded.h"
 #include "midgard/pointll.h"
 #include "midgard/vector2.h"
 #include "mjolnir/graphbuilder.h"
@@ -21,6 +22,7 @@
 #include "mjolnir/util.h"
 #include "odin/directionsbuilder.h"
 #include "odin/worker.h"
+#include "sif/autocost.h"
 #include "sif/costconstants.h"
 #include "sif/dynamiccost.h"
 #include "sif/pedestriancost.h"
@@ -740,6 +742,31 @@ TEST(Astar, test_time_dep_forward_with_current_time) {
                                          boost::algorithm::join(correct_route, ", ");
 }
 
+TEST(Astar, test_raptor_walking_route) {
+  // Without transit data the round based algorithm should still find the walking route
+  std::string request =
+      R"({"locations":[{"lat":51.455768530466514,"lon":-2.5954368710517883},{"lat":51.456082740244824,"lon":-2.595050632953644}],"costing":"multimodal","date_time":{"type":1,"value":"2020-01-15T08:00"}})";
+  auto conf = get_conf("whitelion_tiles");
+  route_tester astar_tester(conf);
+  auto expected = astar_tester.test(request);
+
+  conf.put("thor.multimodal_algorithm", "raptor");
+  route_tester raptor_tester(conf);
+  auto response = raptor_tester.test(request);
+
+  ASSERT_EQ(response.trip().routes_size(), 1) << "Should have found a single route";
+  ASSERT_EQ(response.trip().routes(0).legs_size(), 1) << "Should have 1 leg";
+  for (const auto& node : response.trip().routes(0).legs(0).node()) {
+    if (node.has_edge()) {
+      EXPECT_EQ(node.edge().travel_mode(), TripLeg::kPedestrian) << "Route should only walk";
+    }
+  }
+
+  // The walk is the quickest one so it cannot take longer than the multimodal A* walk
+  EXPECT_LE(response.directions().routes(0).legs(0).summary().time(),
+            expected.directions().routes(0).legs(0).summary().time() + 1);
+}
+
 TEST(Astar, test_deadend_timedep_forward) {
   auto conf = get_conf("whitelion_tiles_reverse");
   route_tester tester(conf);
@@ -918,6 +945,84 @@ TEST(Astar, test_time_restricted_road_bidirectional) {
   }
 }
 
+TEST(Astar, test_alternates_bidirectional) {
+  // Alternates come from the same bidirectional search as the best route
+  auto conf = get_conf("utrecht_tiles");
+  route_tester tester(conf);
+  std::string locations =
+      R"("locations":[{"lat":52.106337,"lon":5.101728},{"lat":52.103948,"lon":5.06813}])";
+  auto best = tester.test(R"({)" + locations + R"(,"costing":"auto"})");
+  auto response = tester.test(R"({)" + locations + R"(,"costing":"auto","alternates":2})");
+
+  // The first route is the best route and the alternates are different routes
+  ASSERT_EQ(best.trip().routes_size(), 1);
+  ASSERT_GE(response.trip().routes_size(), 2);
+  ASSERT_LE(response.trip().routes_size(), 3);
+  auto best_shape = midgard::delta_to_polyline(best.directions().routes(0).legs(0).shape());
+  EXPECT_EQ(midgard::delta_to_polyline(response.directions().routes(0).legs(0).shape()),
+            best_shape);
+  for (int i = 1; i < response.directions().routes_size(); ++i) {
+    const auto& leg = response.directions().routes(i).legs(0);
+    EXPECT_NE(midgard::delta_to_polyline(leg.shape()), best_shape);
+  }
+
+  // The paths behind the routes: each alternate leaves the best path and costs at most 1.2 times
+  // as much. The limit comes from the cost of the connection between the searches which can be a
+  // little off the cost of the path formed through it, so allow for a bit more.
+  auto options = response.options();
+  std::shared_ptr<vs::DynamicCost> costs[int(vs::TravelMode::kMaxTravelMode)];
+  auto cost = vs::CreateAutoCost(Costing::auto_, options);
+  auto mode = cost->travel_mode();
+  costs[static_cast<uint32_t>(mode)] = cost;
+  vt::BidirectionalAStar astar;
+  auto paths = astar.GetBestPath(*options.mutable_locations(0), *options.mutable_locations(1),
+                                 *tester.reader, costs, mode, options);
+  ASSERT_EQ(paths.size(), response.trip().routes_size());
+  std::unordered_set<vb::GraphId> best_edges;
+  for (const auto& p : paths.front()) {
+    best_edges.insert(p.edgeid);
+  }
+  const float best_cost = paths.front().back().elapsed_cost;
+  for (size_t i = 1; i < paths.size(); ++i) {
+    EXPECT_GE(paths[i].back().elapsed_cost, best_cost);
+    EXPECT_LE(paths[i].back().elapsed_cost, best_cost * 1.2f * 1.01f);
+    EXPECT_TRUE(std::any_of(paths[i].begin(), paths[i].end(), [&best_edges](const vt::PathInfo& p) {
+      return best_edges.count(p.edgeid) == 0;
+    }));
+  }
+}
+
+TEST(Astar, test_working_memory_counts) {
+  auto conf = get_conf("utrecht_tiles");
+  route_tester tester(conf);
+  auto response = tester.test(
+      R"({"locations":[{"lat":52.106337,"lon":5.101728},{"lat":52.103948,"lon":5.06813}],)"
+      R"("costing":"auto"})");
+  auto options = response.options();
+  std::shared_ptr<vs::DynamicCost> costs[int(vs::TravelMode::kMaxTravelMode)];
+  auto cost = vs::CreateAutoCost(Costing::auto_, options);
+  auto mode = cost->travel_mode();
+  costs[static_cast<uint32_t>(mode)] = cost;
+
+  // The worker clears an algorithm before a search as well as after it, each search counts once
+  vt::BidirectionalAStar astar;
+  for (int i = 0; i < 2; ++i) {
+    astar.Clear();
+    ASSERT_FALSE(astar
+                     .GetBestPath(*options.mutable_locations(0), *options.mutable_locations(1),
+                                  *tester.reader, costs, mode, options)
+                     .empty());
+    astar.Clear();
+  }
+  astar.Clear();
+  EXPECT_EQ(astar.working_memory().searches(), 2);
+
+  // The second search fits in the memory kept from the first
+  EXPECT_EQ(astar.working_memory().growths(), 1);
+  EXPECT_EQ(astar.working_memory().releases(), 0);
+  EXPECT_GT(astar.working_memory().reserved(), 0);
+}
+
 Api route_on_timerestricted(const std::string& costing_str, int16_t hour) {
   // Try routing over "Via Montebello" in Rome which is a time restricted road
   // The restriction is
@@ -955,7 +1060,7 @@ void test_route_restricted(const std::string& costing_str, int16_t hour) {
     auto response = route_on_timerestricted(costing_str, hour);
     found_route = true;
     const auto& leg = response.directions().routes(0).legs(0);
-    LOG_INFO("Route that wasn't supposed to happen: " + leg.shape());
+    LOG_INFO("Route that wasn't supposed to happen: " + midgard::delta_to_polyline(leg.shape()));
   } catch (const std::exception& e) {
     EXPECT_EQ(std::string(e.what()), "No path could be found for input");
     return;
@@ -1093,8 +1198,9 @@ void test_backtrack_complex_restriction(int date_time_type) {
     default:
       throw std::runtime_error("unhandled case");
   }
-  if (leg.shape() != correct_shape) {
-    throw std::runtime_error("Did not find expected shape. Found \n" + leg.shape() +
+  auto shape = midgard::delta_to_polyline(leg.shape());
+  if (shape != correct_shape) {
+    throw std::runtime_error("Did not find expected shape. Found \n" + shape +
                              "\nbut expected \n" + correct_shape);
   }
 
@@ -1376,7 +1482,7 @@ TEST(Astar, test_timed_conditional_restriction_3) {
     auto response = timed_conditional_restriction_nh("truck", "2018-05-02T20:00");
     found_route = true;
     const auto& leg = response.directions().routes(0).legs(0);
-    LOG_INFO("Route that wasn't supposed to happen: " + leg.shape());
+    LOG_INFO("Route that wasn't supposed to happen: " + midgard::delta_to_polyline(leg.shape()));
   } catch (const std::exception& e) {
     EXPECT_EQ(std::string(e.what()), "No path could be found for input");
     return;
@@ -1481,7 +1587,7 @@ TEST(Astar, test_complex_restriction_short_path_melborne) {
         R"({"locations":[{"lat":-37.627860699397075,"lon":145.365825588286},{"lat":-37.62842169939707,"lon":145.36587158828598}],"costing":"auto"})";
     auto response = tester.test(request);
     const auto& leg = response.trip().routes(0).legs(0);
-    EXPECT_EQ(leg.shape(), "b|rwfAislgtGtN{UvDtDxLhM");
+    EXPECT_EQ(midgard::delta_to_polyline(leg.shape()), "b|rwfAislgtGtN{UvDtDxLhM");
   }
   {
     // Tests "X-crossing",
@@ -1490,7 +1596,7 @@ TEST(Astar, test_complex_restriction_short_path_melborne) {
         R"({"locations":[{"lat":-37.62403769939707,"lon":145.360320588286},{"lat":-37.624804699397075,"lon":145.36041758828597}],"costing":"auto"})";
     auto response = tester.test(request);
     const auto& leg = response.trip().routes(0).legs(0);
-    EXPECT_EQ(leg.shape(), "tmkwfAa{agtGjAyBpBwC`HkK`M]bR`R");
+    EXPECT_EQ(midgard::delta_to_polyline(leg.shape()), "tmkwfAa{agtGjAyBpBwC`HkK`M]bR`R");
   }
 }
 
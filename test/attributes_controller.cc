@@ -89,6 +89,36 @@ TEST(AttrController, TestAdminAttributeEnabled) {
   TryCategoryAttributeEnabled(controller, kAdminCategory, true);
 }
 
+TEST(AttrController, TestFieldPlan) {
+  AttributesController controller;
+  FieldPlan defaults(controller);
+  EXPECT_TRUE(defaults.edge_signs);
+  EXPECT_TRUE(defaults.intersecting_edges);
+  EXPECT_TRUE(defaults.edge_turn_lanes);
+  EXPECT_TRUE(defaults.edge_names);
+  EXPECT_EQ(defaults.osm_changeset, controller.attributes.at(kOsmChangeset));
+
+  // Only the requested attributes and the groups containing them are enabled
+  controller.disable_all();
+  controller.attributes.at(kEdgeWayId) = true;
+  controller.attributes.at(kEdgeSignExitName) = true;
+  controller.attributes.at(kNodeIntersectingEdgeUse) = true;
+  FieldPlan plan(controller);
+  EXPECT_TRUE(plan.edge_way_id);
+  EXPECT_FALSE(plan.edge_names);
+  EXPECT_FALSE(plan.edge_turn_lanes);
+  EXPECT_FALSE(plan.edge_headings);
+  EXPECT_FALSE(plan.admins);
+  EXPECT_FALSE(plan.shape_attributes);
+  EXPECT_TRUE(plan.edge_signs);
+  EXPECT_TRUE(plan.intersecting_edges);
+  EXPECT_TRUE(plan.intersecting_edge_use);
+  EXPECT_FALSE(plan.intersecting_edge_road_class);
+
+  controller.attributes.at(kEdgeEndHeading) = true;
+  EXPECT_TRUE(FieldPlan(controller).edge_headings);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -34,6 +34,24 @@ test('route: can get a route in Hershey', function(assert) {
   });
 });
 
+test('route: concurrent requests on one actor all succeed', function(assert) {
+  var hersheyRequest = '{"locations":[{"lat":40.546115,"lon":-76.385076,"type":"break"}, {"lat":40.544232,"lon":-76.385752,"type":"break"}],"costing":"auto"}';
+  var badRequest = '{"locations":[{"lat":5,"lon":-76.385076,"type":"break"}, {"lat":40.544232,"lon":-76.385752,"type":"break"}],"costing":"auto"}';
+  var pending = 16;
+  for (var i = 0; i < 16; ++i) {
+    var bad = i % 4 == 3;
+    valhalla.route(bad ? badRequest : hersheyRequest, ((bad) => (err, resp) => {
+      if (bad) {
+        assert.notOk(resp, 'a failing request does not affect the others');
+      } else {
+        if (err) assert.error(err, 'should not error');
+        assert.equal(JSON.parse(resp)['trip']['legs'][0]['maneuvers'].length, 2, 'Leg has two maneuvers');
+      }
+      if (--pending == 0) assert.end();
+    })(bad));
+  }
+});
+
 test('route: returns an error if no edges found', function(assert) {
   var hersheyRequest = '{"locations":[{"lat":5,"lon":-76.385076,"type":"break"}, {"lat":40.544232,"lon":-76.385752,"type":"break"}],"costing":"auto"}';
   valhalla.route(hersheyRequest, (err, resp) => {
@@ -17,3 +17,11 @@ assert('legs' in route['trip'] and len(route['trip']['legs']) > 0)
 assert('maneuvers' in route['trip']['legs'][0] and len(route['trip']['legs'][0]['maneuvers']) > 0)
 assert('instruction' in route['trip']['legs'][0]['maneuvers'][0])
 assert(route['trip']['legs'][0]['maneuvers'][0]['instruction'] == u'Едьте на восток по велосипедная дорожке.')
+
+# the same route in a batch on a pool of actors, in order and as completed
+pool = valhalla.ActorPool(2)
+routes = [json.loads(r) for r in pool.Route([query] * 4)]
+assert(len(routes) == 4)
+assert(all(r['trip']['summary'] == route['trip']['summary'] for r in routes))
+completed = sorted(index for index, r in pool.Route([query] * 4, ordered=False))
+assert(completed == [0, 1, 2, 3])
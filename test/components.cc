@@ -0,0 +1,261 @@
+#include "test.h"
+
+#include "baldr/graphreader.h"
+#include "baldr/nodecomponent.h"
+#include "baldr/rapidjson_utils.h"
+#include "loki/worker.h"
+#include "midgard/logging.h"
+#include "worker.h"
+
+#include <boost/property_tree/ptree.hpp>
+#include <sstream>
+#include <unordered_set>
+
+using namespace valhalla;
+using namespace valhalla::midgard;
+using namespace valhalla::baldr;
+
+namespace {
+
+boost::property_tree::ptree get_conf() {
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", "test/data/utrecht_tiles");
+  conf.put("concurrency", 1);
+  return conf;
+}
+
+// the connectivity map is off so that only the components can reject locations
+boost::property_tree::ptree get_loki_conf() {
+  std::stringstream ss;
+  ss << R"({
+    "mjolnir":{"tile_dir":"test/data/utrecht_tiles","concurrency":1},
+    "loki":{
+      "actions":["route","sources_to_targets"],
+      "use_connectivity":false,
+      "logging":{"long_request":100},
+      "service_defaults":{"minimum_reachability":50,"radius":0,"search_cutoff":35000,
+                          "node_snap_tolerance":5,"street_side_tolerance":5,"heading_tolerance":60}
+    },
+    "service_limits":{
+      "auto":{"max_distance":5000000.0,"max_locations":20,"max_matrix_distance":400000.0,"max_matrix_locations":50},
+      "pedestrian":{"max_distance":250000.0,"max_locations":50,"max_matrix_distance":200000.0,"max_matrix_locations":50,
+                    "max_transit_walking_distance":10000,"min_transit_walking_distance":1},
+      "multimodal":{"max_distance":500000.0,"max_locations":50,"max_matrix_distance":0.0,"max_matrix_locations":0},
+      "isochrone":{"max_contours":4,"max_distance":25000.0,"max_locations":1,"max_time":120},
+      "skadi":{"max_shape":750000,"min_resample":10.0},
+      "trace":{"max_distance":200000.0,"max_gps_accuracy":100.0,"max_search_radius":100,"max_shape":16000,
+               "max_best_paths":4,"max_best_paths_shape":100},
+      "max_avoid_locations":50,"max_radius":200,"max_reachability":100,"max_alternates":2
+    }
+  })";
+  boost::property_tree::ptree conf;
+  rapidjson::read_json(ss, conf);
+  return conf;
+}
+
+// a node with an edge usable in both directions by the access, on an island of the mode or in
+// its main component
+PointLL find_node(GraphReader& reader, uint32_t mode_access, uint32_t access, bool island) {
+  const auto mode = NodeComponent::mode_index(mode_access);
+  for (auto tile_id : reader.GetTileSet()) {
+    const auto* tile = reader.GetGraphTile(tile_id);
+    for (GraphId node_id = tile->header()->graphid(); node_id.id() < tile->header()->nodecount();
+         ++node_id) {
+      const auto* info = tile->node(node_id);
+      const auto* component = tile->node_component(node_id.id(), mode);
+      bool on_island = component && component->island() != kMainComponent;
+      if ((info->access() & access) != access || on_island != island || (!island && component)) {
+        continue;
+      }
+      for (const auto& edge : tile->GetDirectedEdges(info)) {
+        if (!edge.is_shortcut() && (edge.forwardaccess() & access) == access &&
+            (edge.reverseaccess() & access) == access) {
+          return tile->get_node_ll(node_id);
+        }
+      }
+    }
+  }
+  return {};
+}
+
+std::string location(const PointLL& ll) {
+  return R"({"lat":)" + std::to_string(ll.lat()) + R"(,"lon":)" + std::to_string(ll.lng()) +
+         R"(,"minimum_reachability":0})";
+}
+
+// the error loki returns for a request or 0 if there is none
+unsigned error_code(loki::loki_worker_t& worker,
+                    Options::Action action,
+                    const std::string& request) {
+  Api api;
+  ParseApi(request, action, api);
+  unsigned code = 0;
+  try {
+    if (action == Options::route) {
+      worker.route(api);
+    } else {
+      worker.matrix(api);
+    }
+  } catch (const valhalla_exception_t& e) { code = e.code; }
+  worker.cleanup();
+  return code;
+}
+
+unsigned route(loki::loki_worker_t& worker,
+               const PointLL& from,
+               const PointLL& to,
+               const std::string& costing) {
+  return error_code(worker, Options::route,
+                    R"({"locations":[)" + location(from) + "," + location(to) + "]," + costing +
+                        "}");
+}
+
+unsigned matrix(loki::loki_worker_t& worker,
+                const std::vector<PointLL>& sources,
+                const std::vector<PointLL>& targets,
+                const std::string& costing) {
+  auto locations = [](const std::vector<PointLL>& lls) {
+    std::string list;
+    for (const auto& ll : lls) {
+      list += (list.empty() ? "[" : ",") + location(ll);
+    }
+    return list + "]";
+  };
+  return error_code(worker, Options::sources_to_targets,
+                    R"({"sources":)" + locations(sources) + R"(,"targets":)" + locations(targets) +
+                        "," + costing + "}");
+}
+
+const std::string kAuto = R"("costing":"auto")";
+const std::string kPedestrian = R"("costing":"pedestrian")";
+const std::string kWheelchair =
+    R"("costing":"pedestrian","costing_options":{"pedestrian":{"type":"wheelchair"}})";
+const std::string kMultimodal = R"("costing":"multimodal")";
+
+TEST(Components, connected) {
+  const auto& main = NodeComponent::main();
+  EXPECT_TRUE(NodeComponent::Connected(main, main));
+
+  // a dead end on the main island can be left but not entered from the main component
+  NodeComponent dead_end(1, 0, 5, kMainComponent, true, false);
+  EXPECT_TRUE(NodeComponent::Connected(dead_end, main));
+  EXPECT_FALSE(NodeComponent::Connected(main, dead_end));
+  EXPECT_TRUE(NodeComponent::Connected(dead_end, dead_end));
+
+  // an island can never be reached from elsewhere
+  NodeComponent island(2, 0, 6, 3, false, false);
+  EXPECT_FALSE(NodeComponent::Connected(island, main));
+  EXPECT_FALSE(NodeComponent::Connected(main, island));
+  EXPECT_FALSE(NodeComponent::Connected(island, dead_end));
+  EXPECT_TRUE(NodeComponent::Connected(island, island));
+
+  // but small components on the same island might be connected to each other
+  NodeComponent other(3, 0, 7, 3, false, false);
+  EXPECT_TRUE(NodeComponent::Connected(island, other));
+
+  EXPECT_EQ(NodeComponent::mode_index(kAutoAccess), 0);
+  EXPECT_EQ(NodeComponent::mode_index(kWheelchairAccess), kComponentModeCount);
+}
+
+TEST(Components, check_stored_components) {
+  GraphReader reader(get_conf());
+  const auto mode = NodeComponent::mode_index(kAutoAccess);
+  ASSERT_LT(mode, kComponentModeCount) << "Auto components should be stored in the tiles";
+
+  // nodes that cannot reach the main component can only reach nodes that cannot either
+  for (auto tile_id : reader.GetTileSet()) {
+    const auto* tile = reader.GetGraphTile(tile_id);
+    for (GraphId node_id = tile->header()->graphid(); node_id.id() < tile->header()->nodecount();
+         ++node_id) {
+      const auto* component = tile->node_component(node_id.id(), mode);
+      ASSERT_NE(component, nullptr) << "Tiles should have been built with components";
+      if (component->reaches_main()) {
+        continue;
+      }
+
+      // search everything the node can reach, which cannot be much
+      std::unordered_set<GraphId> visited{node_id};
+      std::vector<GraphId> queue{node_id};
+      while (!queue.empty()) {
+        auto node = queue.back();
+        queue.pop_back();
+        const auto* t = reader.GetGraphTile(node);
+        const auto* c = t->node_component(node.id(), mode);
+        ASSERT_NE(c, nullptr);
+        EXPECT_FALSE(c->reaches_main()) << "Node " + std::to_string(node.value) +
+                                               " is reached from " + std::to_string(node_id.value) +
+                                               " which cannot reach the main component";
+        EXPECT_EQ(c->island(), component->island());
+
+        const auto* info = t->node(node);
+        if (!(info->access() & kAutoAccess)) {
+          continue;
+        }
+        auto enqueue = [&](const GraphId& next) {
+          if (visited.insert(next).second) {
+            queue.push_back(next);
+          }
+        };
+        for (const auto& edge : t->GetDirectedEdges(info)) {
+          if (!edge.is_shortcut() && (edge.forwardaccess() & kAutoAccess)) {
+            enqueue(edge.endnode());
+          }
+        }
+        for (const auto& transition : t->GetNodeTransitions(info)) {
+          enqueue(transition.endnode());
+        }
+      }
+    }
+  }
+}
+
+TEST(Components, loki_rejects_islands) {
+  auto conf = get_loki_conf();
+  auto reader = std::make_shared<GraphReader>(conf.get_child("mjolnir"));
+  loki::loki_worker_t worker(conf, reader);
+
+  for (const auto& mode : {std::make_pair(kAutoAccess, kAuto),
+                           std::make_pair(kPedestrianAccess, kPedestrian)}) {
+    auto main = find_node(*reader, mode.first, mode.first, false);
+    auto island = find_node(*reader, mode.first, mode.first, true);
+    ASSERT_TRUE(main.IsValid()) << "There should be a node in the main component";
+    ASSERT_TRUE(island.IsValid()) << "There should be an island in the tiles";
+
+    // neither way round, the locations being on different islands
+    EXPECT_EQ(route(worker, main, main, mode.second), 0);
+    EXPECT_EQ(route(worker, main, island, mode.second), 170);
+    EXPECT_EQ(route(worker, island, main, mode.second), 170);
+
+    // a matrix is only rejected if none of its pairs can be connected
+    EXPECT_EQ(matrix(worker, {main}, {island}, mode.second), 170);
+    EXPECT_EQ(matrix(worker, {island}, {main}, mode.second), 170);
+    EXPECT_EQ(matrix(worker, {main, island}, {main}, mode.second), 0);
+  }
+}
+
+TEST(Components, loki_skips_multimodal_and_wheelchair) {
+  auto conf = get_loki_conf();
+  auto reader = std::make_shared<GraphReader>(conf.get_child("mjolnir"));
+  loki::loki_worker_t worker(conf, reader);
+
+  // locations on different islands for pedestrians that wheelchairs can use too
+  const auto access = kPedestrianAccess | kWheelchairAccess;
+  auto main = find_node(*reader, kPedestrianAccess, access, false);
+  auto island = find_node(*reader, kPedestrianAccess, access, true);
+  ASSERT_TRUE(main.IsValid());
+  ASSERT_TRUE(island.IsValid());
+  ASSERT_EQ(route(worker, main, island, kPedestrian), 170);
+
+  // wheelchairs have no components stored and multimodal can ride transit off the island
+  EXPECT_EQ(route(worker, main, island, kWheelchair), 0);
+  EXPECT_EQ(matrix(worker, {main}, {island}, kWheelchair), 0);
+  EXPECT_EQ(route(worker, main, island, kMultimodal), 0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  logging::Configure({{"type", ""}});
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -72,6 +72,34 @@ TEST(DoubleBucketQueue, TestClear) {
   TryClear(costs);
 }
 
+TEST(DoubleBucketQueue, TestReuse) {
+  std::vector<float> edgelabels = {67, 325, 25, 466, 1000, 100005, 758, 167, 258, 16442};
+  const auto edgecost = [&edgelabels](const uint32_t label) { return edgelabels[label]; };
+  DoubleBucketQueue adjlist(0, 10000, 5, edgecost);
+  for (uint32_t i = 0; i < edgelabels.size(); ++i) {
+    adjlist.add(i);
+  }
+  adjlist.pop();
+  size_t reserved = adjlist.reserved();
+
+  // Labels of the previous search are gone, the buckets keep their memory and
+  // the new cost range is used
+  std::vector<float> costs = {20500, 20100, 30000, 20250};
+  const auto newcost = [&costs](const uint32_t label) { return costs[label]; };
+  adjlist.reuse(20000, 10000, 5, newcost);
+  EXPECT_EQ(adjlist.reserved(), reserved);
+  for (uint32_t i = 0; i < costs.size(); ++i) {
+    adjlist.add(i);
+  }
+  std::vector<float> expected = costs;
+  std::sort(expected.begin(), expected.end());
+  for (auto cost : expected) {
+    EXPECT_EQ(costs[adjlist.pop()], cost);
+  }
+  EXPECT_EQ(adjlist.pop(), kInvalidLabel);
+  EXPECT_THROW(adjlist.reuse(0, 10000, 0, newcost), runtime_error);
+}
+
 /**
    void TestDecreseCost() {
    std::vector<uint32_t> costs = { 67, 325, 25, 466, 1000, 100005, 758, 167,
@@ -0,0 +1,161 @@
+#include "test.h"
+
+#include "baldr/graphreader.h"
+#include "baldr/rapidjson_utils.h"
+#include "baldr/tilehierarchy.h"
+#include "sif/autocost.h"
+#include "sif/edgecostcache.h"
+
+#include <boost/property_tree/ptree.hpp>
+
+using namespace valhalla;
+using namespace valhalla::midgard;
+using namespace valhalla::baldr;
+using namespace valhalla::sif;
+
+namespace {
+
+// a tile with nothing but a header and some directed edges, all the cache looks at
+struct TestGraphTile : public GraphTile {
+  TestGraphTile(const GraphId& id, const uint32_t edge_count) : edges(edge_count) {
+    graphtile_ = std::make_shared<std::vector<char>>(sizeof(GraphTileHeader));
+    header_ = reinterpret_cast<GraphTileHeader*>(graphtile_->data());
+    header_->set_graphid(id);
+    header_->set_directededgecount(edge_count);
+    directededges_ = edges.data();
+  }
+  std::vector<DirectedEdge> edges;
+};
+
+// counts how many times the cache asks for the cost to be computed
+struct CountedCost {
+  Cost operator()() {
+    ++calls;
+    return cost;
+  }
+  Cost cost;
+  size_t calls = 0;
+};
+
+void check_same(const Cost& expected, const Cost& cost) {
+  EXPECT_EQ(cost.cost, expected.cost);
+  EXPECT_EQ(cost.secs, expected.secs);
+}
+
+TEST(EdgeCostCache, hit) {
+  TestGraphTile tile({100, 2, 0}, 10);
+  EdgeCostCache cache(1024 * 1024);
+  CountedCost cost_fn{{12.f, 34.f}};
+  auto cost = [&]() { return cost_fn(); };
+
+  check_same(cost_fn.cost, cache.Get(tile.directededge(3), &tile, 0, cost));
+  EXPECT_EQ(cost_fn.calls, 1);
+  EXPECT_EQ(cache.misses(), 1);
+  EXPECT_EQ(cache.hits(), 0);
+
+  // the same edge at any time in the same speed bucket is answered from the cache
+  for (uint32_t seconds = 0; seconds < kSpeedBucketSizeSeconds; seconds += 60) {
+    check_same(cost_fn.cost, cache.Get(tile.directededge(3), &tile, seconds, cost));
+  }
+  EXPECT_EQ(cost_fn.calls, 1);
+  EXPECT_EQ(cache.misses(), 1);
+  EXPECT_EQ(cache.hits(), kSpeedBucketSizeSeconds / 60);
+}
+
+TEST(EdgeCostCache, miss) {
+  TestGraphTile tile({100, 2, 0}, 10);
+  EdgeCostCache cache(1024 * 1024);
+  CountedCost cost_fn{{12.f, 34.f}};
+  auto cost = [&]() { return cost_fn(); };
+  cache.Get(tile.directededge(3), &tile, 0, cost);
+
+  // other edges, other speed buckets and no time at all each have to be costed
+  cache.Get(tile.directededge(4), &tile, 0, cost);
+  cache.Get(tile.directededge(3), &tile, kSpeedBucketSizeSeconds, cost);
+  cache.Get(tile.directededge(3), &tile, kInvalidSecondsOfWeek, cost);
+  EXPECT_EQ(cost_fn.calls, 4);
+  EXPECT_EQ(cache.misses(), 4);
+  EXPECT_EQ(cache.hits(), 0);
+
+  // an edge only keeps its last cost
+  cache.Get(tile.directededge(3), &tile, 0, cost);
+  EXPECT_EQ(cost_fn.calls, 5);
+  cache.Get(tile.directededge(3), &tile, 0, cost);
+  EXPECT_EQ(cost_fn.calls, 5);
+  EXPECT_EQ(cache.hits(), 1);
+}
+
+TEST(EdgeCostCache, full) {
+  TestGraphTile tile1({100, 2, 0}, 10);
+  TestGraphTile tile2({101, 2, 0}, 10);
+  CountedCost cost_fn{{12.f, 34.f}};
+  auto cost = [&]() { return cost_fn(); };
+
+  // find out the size of a tile's costs and make a cache with room for just one
+  EdgeCostCache one_tile(1024 * 1024);
+  one_tile.Get(tile1.directededge(0), &tile1, 0, cost);
+  ASSERT_GT(one_tile.size(), 0);
+  EdgeCostCache cache(one_tile.size() + one_tile.size() / 2);
+
+  cache.Get(tile1.directededge(0), &tile1, 0, cost);
+  cache.Get(tile2.directededge(0), &tile2, 0, cost);
+  EXPECT_EQ(cache.size(), one_tile.size());
+
+  // the tile that didn't fit is costed every time, the one cached before is kept
+  cost_fn.calls = 0;
+  cache.Get(tile2.directededge(0), &tile2, 0, cost);
+  cache.Get(tile1.directededge(0), &tile1, 0, cost);
+  cache.Get(tile2.directededge(0), &tile2, 0, cost);
+  EXPECT_EQ(cost_fn.calls, 2);
+  EXPECT_EQ(cache.hits(), 1);
+
+  // clearing frees the room and resets the counters
+  cache.Clear();
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.hits(), 0);
+  EXPECT_EQ(cache.misses(), 0);
+  cache.Get(tile2.directededge(0), &tile2, 0, cost);
+  cache.Get(tile2.directededge(0), &tile2, 0, cost);
+  EXPECT_EQ(cache.size(), one_tile.size());
+  EXPECT_EQ(cache.hits(), 1);
+}
+
+TEST(EdgeCostCache, same_as_costing) {
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", "test/data/utrecht_tiles");
+  GraphReader reader(conf);
+  const GraphTile* tile = reader.GetGraphTile(TileHierarchy::GetGraphId({5.11f, 52.09f}, 2));
+  ASSERT_NE(tile, nullptr);
+  ASSERT_GT(tile->header()->directededgecount(), 0);
+
+  Options options;
+  options.set_costing(Costing::auto_);
+  const rapidjson::Document doc;
+  ParseAutoCostOptions(doc, "/costing_options/auto", options.add_costing_options());
+  auto fresh = CreateAutoCost(Costing::auto_, options);
+  auto cached = CreateAutoCost(Costing::auto_, options);
+  cached->EnableEdgeCostCache(32 * 1024 * 1024);
+
+  // a Monday at night and during the day, then without a time, the second time from the cache
+  const std::vector<uint32_t> times{kSecondsPerDay + 3600, kSecondsPerDay + 43200,
+                                    kInvalidSecondsOfWeek};
+  for (auto seconds : times) {
+    for (int pass = 0; pass < 2; ++pass) {
+      for (uint32_t i = 0; i < tile->header()->directededgecount(); ++i) {
+        const DirectedEdge* edge = tile->directededge(i);
+        check_same(fresh->EdgeCost(edge, tile, seconds),
+                   cached->CachedEdgeCost(edge, tile, seconds));
+      }
+    }
+  }
+  const size_t costed = times.size() * tile->header()->directededgecount();
+  EXPECT_EQ(cached->edge_cost_cache()->misses(), costed);
+  EXPECT_EQ(cached->edge_cost_cache()->hits(), costed);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
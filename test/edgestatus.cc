@@ -66,6 +66,42 @@ TEST(EdgeStatus, TestStatus) {
   TryGet(edgestatus, GraphId(555, 3, 1), EdgeSet::kUnreachedOrReset);
 }
 
+TEST(EdgeStatus, TestReuse) {
+  EdgeStatus edgestatus;
+
+  GraphTileHeader header;
+  header.set_directededgecount(100000);
+  test_tile tt;
+  tt.header_ = &header;
+  const GraphTile* tile = &tt;
+
+  // The first search allocates, later searches touching no more edges do not
+  uint64_t allocations = 0;
+  for (uint32_t search = 0; search < 3; ++search) {
+    for (uint32_t tileid = 0; tileid < 5; ++tileid) {
+      TryGet(edgestatus, GraphId(tileid, 2, 99999), EdgeSet::kUnreachedOrReset);
+      edgestatus.Set(GraphId(tileid, 2, 99999), EdgeSet::kPermanent, search, tile);
+      edgestatus.GetPtr(GraphId(tileid, 2, 0), tile)->set_ =
+          static_cast<uint32_t>(EdgeSet::kTemporary);
+      TryGet(edgestatus, GraphId(tileid, 2, 99999), EdgeSet::kPermanent);
+      TryGet(edgestatus, GraphId(tileid, 2, 0), EdgeSet::kTemporary);
+      TryGet(edgestatus, GraphId(tileid, 2, 1), EdgeSet::kUnreachedOrReset);
+    }
+    EXPECT_EQ(edgestatus.Get(GraphId(3, 2, 99999)).index(), search);
+    if (search == 0) {
+      allocations = edgestatus.allocations();
+    }
+    edgestatus.clear();
+  }
+  EXPECT_EQ(edgestatus.allocations(), allocations);
+  EXPECT_GE(edgestatus.reserved(), 5 * 100000 * sizeof(EdgeStatusInfo));
+
+  // Releasing frees the memory
+  edgestatus.release();
+  EXPECT_EQ(edgestatus.reserved(), 0);
+  TryGet(edgestatus, GraphId(3, 2, 99999), EdgeSet::kUnreachedOrReset);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
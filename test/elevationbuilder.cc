@@ -0,0 +1,156 @@
+#include "test.h"
+
+#include "baldr/graphreader.h"
+#include "baldr/graphtile.h"
+#include "baldr/tilehierarchy.h"
+#include "filesystem.h"
+#include "mjolnir/elevationbuilder.h"
+
+#include <algorithm>
+#include <boost/property_tree/ptree.hpp>
+#include <cmath>
+#include <deque>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace valhalla;
+using namespace valhalla::baldr;
+
+namespace {
+
+const std::string utrecht_dir = "test/data/utrecht_tiles";
+const std::string dem_dir = "test/data/elevation_builder/dem";
+
+boost::property_tree::ptree get_conf(const std::string& tile_dir, unsigned int concurrency) {
+  boost::property_tree::ptree conf;
+  conf.put("mjolnir.tile_dir", tile_dir);
+  conf.put("additional_data.elevation", dem_dir);
+  conf.put("concurrency", concurrency);
+  return conf;
+}
+
+// a fresh copy of the utrecht tiles so each build starts without elevation
+std::unordered_set<GraphId> copy_tiles(const std::string& tile_dir) {
+  if (filesystem::exists(tile_dir)) {
+    filesystem::remove_all(tile_dir);
+  }
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", utrecht_dir);
+  GraphReader reader(conf);
+  auto tiles = reader.GetTileSet();
+  for (const auto& tile_id : tiles) {
+    auto suffix = GraphTile::FileSuffix(tile_id);
+    std::ifstream in(utrecht_dir + "/" + suffix, std::ios::binary);
+    auto out_name = tile_dir + "/" + suffix;
+    filesystem::create_directories(out_name.substr(0, out_name.rfind('/')));
+    std::ofstream out(out_name, std::ios::binary | std::ios::trunc);
+    out << in.rdbuf();
+  }
+  return tiles;
+}
+
+// utrecht is all in one DEM tile, heights rise 1m per column and drop back every 400 columns
+void write_dem() {
+  filesystem::create_directories(dem_dir + "/N52");
+  std::vector<int16_t> tile(3601 * 3601);
+  for (size_t i = 0; i < tile.size(); ++i) {
+    uint16_t height = static_cast<uint16_t>((i % 3601) % 400);
+    // hgt files are big endian
+    tile[i] = static_cast<int16_t>(((height & 0xFF) << 8) | ((height >> 8) & 0xFF));
+  }
+  std::ofstream file(dem_dir + "/N52/N52E005.hgt", std::ios::binary | std::ios::trunc);
+  file.write(static_cast<const char*>(static_cast<const void*>(tile.data())),
+             sizeof(int16_t) * tile.size());
+}
+
+std::pair<int, int> dem_tile(const GraphId& tile_id) {
+  const auto& level = tile_id.level() == TileHierarchy::GetTransitLevel().level
+                          ? TileHierarchy::GetTransitLevel()
+                          : TileHierarchy::levels().at(tile_id.level());
+  auto center = level.tiles.Center(tile_id.tileid());
+  return {static_cast<int>(std::floor(center.lat())), static_cast<int>(std::floor(center.lng()))};
+}
+
+TEST(ElevationBuilder, schedule_groups_dem_tiles) {
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", utrecht_dir);
+  GraphReader reader(conf);
+  auto tiles = reader.GetTileSet();
+  auto scheduled = mjolnir::ElevationBuilder::ScheduleTiles(tiles);
+
+  // every tile once
+  ASSERT_EQ(scheduled.size(), tiles.size());
+  EXPECT_EQ(std::unordered_set<GraphId>(scheduled.begin(), scheduled.end()), tiles);
+
+  // the tiles of a DEM tile come one after the other and there is one with a few of them
+  std::vector<std::pair<int, int>> seen;
+  size_t most = 0, run = 0;
+  for (const auto& tile_id : scheduled) {
+    auto dem = dem_tile(tile_id);
+    if (!seen.empty() && seen.back() == dem) {
+      most = std::max(most, ++run);
+      continue;
+    }
+    EXPECT_EQ(std::find(seen.begin(), seen.end(), dem), seen.end())
+        << "Tiles of DEM tile " + std::to_string(dem.first) + "," + std::to_string(dem.second) +
+               " are not grouped together";
+    seen.push_back(dem);
+    run = 1;
+    most = std::max(most, run);
+  }
+  EXPECT_GT(most, 1u) << "Some graph tiles should share a DEM tile";
+}
+
+TEST(ElevationBuilder, scheduled_matches_unscheduled) {
+  write_dem();
+
+  // build all the tiles grouped by DEM tile on a few threads
+  const std::string scheduled_dir = "test/data/elevation_builder/scheduled";
+  auto tiles = copy_tiles(scheduled_dir);
+  mjolnir::ElevationBuilder::Build(get_conf(scheduled_dir, 3));
+
+  // and one by one in an order which jumps between DEM tiles
+  const std::string unscheduled_dir = "test/data/elevation_builder/unscheduled";
+  copy_tiles(unscheduled_dir);
+  auto scheduled = mjolnir::ElevationBuilder::ScheduleTiles(tiles);
+  std::deque<GraphId> unscheduled;
+  for (size_t i = 0; i < scheduled.size(); ++i) {
+    unscheduled.push_back(scheduled[i % 2 ? i / 2 : scheduled.size() - 1 - i / 2]);
+  }
+  mjolnir::ElevationBuilder::Build(get_conf(unscheduled_dir, 1), unscheduled);
+
+  // the same tiles get the same elevation
+  GraphReader a(get_conf(scheduled_dir, 1).get_child("mjolnir"));
+  GraphReader b(get_conf(unscheduled_dir, 1).get_child("mjolnir"));
+  size_t graded = 0;
+  for (const auto& tile_id : tiles) {
+    const auto* ta = a.GetGraphTile(tile_id);
+    const auto* tb = b.GetGraphTile(tile_id);
+    ASSERT_NE(ta, nullptr);
+    ASSERT_NE(tb, nullptr);
+    EXPECT_TRUE(ta->header()->has_elevation());
+    EXPECT_TRUE(tb->header()->has_elevation());
+    ASSERT_EQ(ta->header()->directededgecount(), tb->header()->directededgecount());
+    for (uint32_t i = 0; i < ta->header()->directededgecount(); ++i) {
+      const auto* ea = ta->directededge(i);
+      const auto* eb = tb->directededge(i);
+      EXPECT_EQ(ea->weighted_grade(), eb->weighted_grade());
+      EXPECT_EQ(ea->max_up_slope(), eb->max_up_slope());
+      EXPECT_EQ(ea->max_down_slope(), eb->max_down_slope());
+      EXPECT_EQ(ta->edgeinfo(ea->edgeinfo_offset()).mean_elevation(),
+                tb->edgeinfo(eb->edgeinfo_offset()).mean_elevation());
+      graded += ea->weighted_grade() != 6;
+    }
+  }
+  EXPECT_GT(graded, 0u) << "The edges should have been graded with the DEM data";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -2,7 +2,9 @@
 
 #include "test.h"
 
+#include <iterator>
 #include <string>
+#include <vector>
 
 using namespace std;
 using namespace valhalla::midgard;
@@ -616,6 +618,20 @@ TEST(Encode, VarInt) {
                   {58.26482, -169.02219}});
 }
 
+TEST(Encode, Deltas) {
+  container_t points{{-76.3002, 40.0433}, {-76.3036, 40.043},     {41.37084, -5.03016},
+                     {76.8342, 42.01251}, {-9.42372, 152.03805}, {-9.42372, 152.03805}};
+  std::vector<int32_t> deltas;
+  delta_encode(points, std::back_inserter(deltas));
+  ASSERT_EQ(deltas.size(), points.size() * 2);
+
+  // the deltas make the same polyline and points as the polyline itself
+  auto encoded = encode<container_t>(points);
+  EXPECT_EQ(delta_to_polyline(deltas), encoded);
+  EXPECT_EQ(delta_decode<container_t>(deltas), decode<container_t>(encoded));
+  EXPECT_TRUE(delta_to_polyline(std::vector<int32_t>{}).empty());
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -1,4 +1,7 @@
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <thread>
 
 #include "baldr/connectivity_map.h"
 #include "baldr/graphreader.h"
@@ -871,6 +874,72 @@ TEST(CacheLruSoft, TrimOnExactlyFullCache) {
   CheckGraphTile(cache.Get(tile2_id), tile2_id, tile2_size);
 }
 
+TEST(SharedCache, TrimWithoutUsers) {
+  SharedTileCache cache(400);
+  GraphId id1(100, 2, 0);
+  TestGraphTile tile1(id1, 500);
+  CheckGraphTile(cache.Put(id1, tile1, 500), id1, 500);
+  EXPECT_TRUE(cache.OverCommitted());
+
+  cache.Trim();
+  EXPECT_FALSE(cache.OverCommitted());
+  EXPECT_FALSE(cache.Contains(id1));
+}
+
+TEST(SharedCache, TrimWaitsForUsers) {
+  SharedTileCache cache(400);
+  cache.Acquire();
+  cache.Acquire();
+
+  GraphId id1(100, 2, 0);
+  TestGraphTile tile1(id1, 123);
+  const GraphTile* inserted1 = cache.Put(id1, tile1, 123);
+  GraphId id2(300, 1, 0);
+  TestGraphTile tile2(id2, 500);
+  const GraphTile* inserted2 = cache.Put(id2, tile2, 500);
+  EXPECT_TRUE(cache.OverCommitted());
+
+  // The tiles stay valid as long as anyone uses the cache
+  cache.Trim();
+  cache.Clear();
+  EXPECT_TRUE(cache.Contains(id1));
+  cache.Release();
+  CheckGraphTile(inserted1, id1, 123);
+  CheckGraphTile(inserted2, id2, 500);
+  EXPECT_EQ(cache.Get(id2), inserted2);
+
+  // The last one out trims
+  cache.Release();
+  EXPECT_FALSE(cache.OverCommitted());
+  EXPECT_FALSE(cache.Contains(id1));
+  EXPECT_FALSE(cache.Contains(id2));
+}
+
+TEST(SharedCache, AcquireWaitsForPendingTrim) {
+  SharedTileCache cache(400);
+  cache.Acquire();
+  GraphId id1(100, 2, 0);
+  TestGraphTile tile1(id1, 500);
+  cache.Put(id1, tile1, 500);
+  cache.Trim();
+
+  // Another thread can't start using the cache until the pending trim is done
+  std::atomic<bool> acquired(false);
+  std::thread other([&]() {
+    cache.Acquire();
+    acquired = true;
+    EXPECT_FALSE(cache.Contains(id1));
+    cache.Release();
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(acquired);
+  EXPECT_TRUE(cache.Contains(id1));
+
+  cache.Release();
+  other.join();
+  EXPECT_TRUE(acquired);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,209 @@
+#include "gurka.h"
+#include <gtest/gtest.h>
+
+#include "baldr/datetime.h"
+#include "baldr/graphreader.h"
+#include "baldr/tilehierarchy.h"
+#include "mjolnir/graphtilebuilder.h"
+#include "mjolnir/transitconverter.h"
+
+#include <valhalla/proto/transit.pb.h>
+
+#include <fstream>
+#include <set>
+
+using namespace valhalla;
+
+namespace {
+
+// the converter dates the schedules from the day the tiles are built in New York
+std::string today() {
+  const auto* tz = baldr::DateTime::get_tz_db().from_index(
+      baldr::DateTime::get_tz_db().to_index("America/New_York"));
+  return baldr::DateTime::iso_date_time(tz).substr(0, 10);
+}
+
+// seconds from midnight
+uint32_t at(const uint32_t hours, const uint32_t minutes) {
+  return hours * 3600 + minutes * 60;
+}
+
+// the trip ids of each route in the order they are ridden
+std::vector<std::vector<uint32_t>> trips(const valhalla::Api& api) {
+  std::vector<std::vector<uint32_t>> routes;
+  for (const auto& route : api.trip().routes()) {
+    routes.emplace_back();
+    for (const auto& node : route.legs(0).node()) {
+      if (node.has_edge() && node.edge().travel_mode() == TripLeg::kTransit &&
+          (routes.back().empty() ||
+           routes.back().back() != node.edge().transit_route_info().trip_id())) {
+        routes.back().push_back(node.edge().transit_route_info().trip_id());
+      }
+    }
+  }
+  return routes;
+}
+
+} // namespace
+
+class Raptor : public ::testing::Test {
+protected:
+  static gurka::map map;
+
+  static void SetUpTestSuite() {
+    // a long road with a stop at either end and one in the middle
+    const std::string ascii_map = R"(
+      A--------------------------------------------------------------B
+        a                             b                            c
+    )";
+    const gurka::ways ways = {{"AB", {{"highway", "residential"}, {"name", "Long Road"}}}};
+
+    const std::string workdir = "test/data/gurka_raptor";
+    map.nodes = gurka::detail::map_to_coordinates(ascii_map, 100, {5.02, 52.1});
+    map.config =
+        gurka::detail::build_config(workdir, {{"mjolnir.transit_dir", workdir + "/transit"},
+                                              {"mjolnir.timezone", ""},
+                                              {"thor.multimodal_algorithm", "raptor"}});
+    if (boost::filesystem::exists(workdir))
+      boost::filesystem::remove_all(workdir);
+    boost::filesystem::create_directories(workdir);
+    midgard::logging::Configure({{"type", ""}});
+
+    // the road graph up to where transit is added
+    const std::string pbf = workdir + "/map.pbf";
+    gurka::detail::build_pbf(map.nodes, ways, {}, {}, pbf);
+    mjolnir::build_tile_set(map.config, {pbf}, mjolnir::BuildStage::kInitialize,
+                            mjolnir::BuildStage::kFilter, false);
+
+    // there is no timezone database so say where the road is
+    const auto amsterdam = baldr::DateTime::get_tz_db().to_index("Europe/Amsterdam");
+    baldr::GraphReader reader(map.config.get_child("mjolnir"));
+    const auto tile_id = baldr::TileHierarchy::GetGraphId(map.nodes["A"], 2);
+    uint64_t way_id = 0;
+    {
+      mjolnir::GraphTileBuilder tile(workdir, tile_id, true);
+      for (auto& node : tile.nodes()) {
+        node.set_timezone(amsterdam);
+      }
+      way_id = tile.edgeinfo(tile.directededge(0).edgeinfo_offset()).wayid();
+      tile.StoreTileData();
+    }
+
+    // an egress, station and platform at each stop
+    mjolnir::Transit transit;
+    for (const auto& stop : {"a", "b", "c"}) {
+      const auto& ll = map.nodes[stop];
+      for (auto type : {baldr::NodeType::kTransitEgress, baldr::NodeType::kTransitStation,
+                        baldr::NodeType::kMultiUseTransitPlatform}) {
+        baldr::GraphId id(tile_id.tileid(), tile_id.level(), transit.nodes_size());
+        auto* node = transit.add_nodes();
+        node->set_lon(ll.lng());
+        node->set_lat(ll.lat());
+        node->set_type(static_cast<uint32_t>(type));
+        node->set_graphid(id);
+        node->set_name(std::string(stop) + std::to_string(static_cast<int>(type)));
+        node->set_onestop_id(node->name());
+        node->set_osm_way_id(way_id);
+        node->set_timezone("Europe/Amsterdam");
+        node->set_wheelchair_boarding(true);
+        node->set_traversability(3);
+        // stations point at their egress and platforms at their station
+        if (type != baldr::NodeType::kTransitEgress) {
+          baldr::GraphId prev(tile_id.tileid(), tile_id.level(), id.id() - 1);
+          node->set_prev_type_graphid(prev);
+        }
+      }
+    }
+
+    // two quick trips with a transfer in the middle and a slower one straight through
+    const auto date = baldr::DateTime::days_from_pivot_date(
+        baldr::DateTime::get_formatted_date(today() + "T00:00"));
+    auto add_trip = [&](const uint32_t trip, const uint32_t from, const uint32_t to,
+                        const uint32_t depart, const uint32_t arrive) {
+      auto* route = transit.add_routes();
+      route->set_name("Line " + std::to_string(trip));
+      route->set_onestop_id("r-" + std::to_string(trip));
+      route->set_vehicle_type(mjolnir::Transit_VehicleType_kBus);
+      auto* pair = transit.add_stop_pairs();
+      pair->set_origin_graphid(transit.nodes(from * 3 + 2).graphid());
+      pair->set_destination_graphid(transit.nodes(to * 3 + 2).graphid());
+      pair->set_origin_onestop_id(transit.nodes(from * 3 + 2).onestop_id());
+      pair->set_destination_onestop_id(transit.nodes(to * 3 + 2).onestop_id());
+      pair->set_route_index(transit.routes_size() - 1);
+      pair->set_trip_id(trip);
+      pair->set_block_id(0);
+      pair->set_origin_departure_time(depart);
+      pair->set_destination_arrival_time(arrive);
+      pair->set_service_start_date(date - 1);
+      pair->set_service_end_date(date + 30);
+      for (int day = 0; day < 7; ++day) {
+        pair->add_service_days_of_week(true);
+      }
+      pair->set_trip_headsign(route->name());
+      pair->set_wheelchair_accessible(true);
+      pair->set_bikes_allowed(true);
+    };
+    add_trip(1, 0, 1, at(8, 10), at(8, 15));
+    add_trip(2, 1, 2, at(8, 20), at(8, 25));
+    add_trip(3, 0, 2, at(8, 12), at(8, 30));
+
+    auto suffix = baldr::GraphTile::FileSuffix(tile_id);
+    auto transit_pbf = workdir + "/transit/" + suffix.substr(0, suffix.size() - 3) + "pbf";
+    boost::filesystem::create_directories(boost::filesystem::path(transit_pbf).parent_path());
+    std::ofstream file(transit_pbf, std::ios::binary | std::ios::trunc);
+    ASSERT_TRUE(transit.SerializeToOstream(&file));
+    file.close();
+
+    // convert it into transit tiles next to the pbf and then connect those to the roads
+    auto transit_config = map.config;
+    transit_config.put("mjolnir.tile_dir", workdir + "/transit");
+    ASSERT_EQ(mjolnir::TransitConverter::Convert(transit_config).size(), 1u);
+    mjolnir::build_tile_set(map.config, {pbf}, mjolnir::BuildStage::kTransit,
+                            mjolnir::BuildStage::kValidate, false);
+  }
+
+  std::string request(const uint32_t alternates) {
+    return R"({"locations":[{"lat":)" + std::to_string(map.nodes["A"].lat()) + R"(,"lon":)" +
+           std::to_string(map.nodes["A"].lng()) + R"(},{"lat":)" +
+           std::to_string(map.nodes["B"].lat()) + R"(,"lon":)" +
+           std::to_string(map.nodes["B"].lng()) +
+           R"(}],"costing":"multimodal","date_time":{"type":1,"value":")" + today() +
+           R"(T08:00"},"alternates":)" + std::to_string(alternates) + "}";
+  }
+};
+
+gurka::map Raptor::map = {};
+
+TEST_F(Raptor, BoardsTrips) {
+  tyr::actor_t actor(map.config, true);
+  auto api = actor.unserialized_route(request(1));
+
+  // the earliest arrival transfers once, the alternate arrives later without a transfer
+  auto ridden = trips(api);
+  ASSERT_EQ(ridden.size(), 2u);
+  EXPECT_EQ(ridden[0], (std::vector<uint32_t>{1, 2}));
+  EXPECT_EQ(ridden[1], (std::vector<uint32_t>{3}));
+  EXPECT_EQ(ridden[0].size() - 1, 1u) << "The earliest arrival should transfer once";
+  EXPECT_EQ(ridden[1].size() - 1, 0u) << "The alternate should not transfer";
+  EXPECT_LT(api.directions().routes(0).legs(0).summary().time(),
+            api.directions().routes(1).legs(0).summary().time());
+}
+
+TEST_F(Raptor, TracksExpansion) {
+  tyr::actor_t actor(map.config, true);
+  auto json = actor.expansion(request(0));
+
+  rapidjson::Document expansion;
+  expansion.Parse(json.c_str());
+  ASSERT_FALSE(expansion.HasParseError());
+  EXPECT_STREQ(expansion["properties"]["algorithm"].GetString(), "raptor");
+
+  // the rides are settled along with the walks and the destination is connected
+  std::set<std::string> statuses;
+  for (const auto& status : expansion["features"][0]["properties"]["statuses"].GetArray()) {
+    statuses.insert(status.GetString());
+  }
+  EXPECT_EQ(statuses, (std::set<std::string>{"r", "s", "c"}));
+  EXPECT_EQ(expansion["features"][0]["properties"]["edge_ids"].Size(),
+            expansion["features"][0]["geometry"]["coordinates"].Size());
+}
@@ -121,6 +121,55 @@ TEST(Isochronies, Basic) {
 #endif
 }
 
+// Exposes the isochrone cache of a worker and what it needs for an expansion
+class isochrone_worker_t : public thor_worker_t {
+public:
+  using thor_worker_t::thor_worker_t;
+  using thor_worker_t::isochrone_cache;
+  using thor_worker_t::mode;
+  using thor_worker_t::mode_costing;
+  using thor_worker_t::reader;
+};
+
+TEST(Isochronies, CachedGrid) {
+  loki_worker_t loki_worker(config);
+  isochrone_worker_t worker(config);
+
+  // The second request only changes the contouring so it reuses the grid of the first, the third
+  // needs a shorter expansion and gets its own grid
+  const std::vector<std::pair<std::string, bool>> requests = {
+      {R"({"locations":[{"lat":52.078937,"lon":5.115321}],"costing":"bicycle","contours":[{"time":15}],"polygons":true})",
+       false},
+      {R"({"locations":[{"lat":52.078937,"lon":5.115321}],"costing":"bicycle","contours":[{"time":15}],"denoise":0.2})",
+       true},
+      {R"({"locations":[{"lat":52.078937,"lon":5.115321}],"costing":"bicycle","contours":[{"time":5},{"time":10}],"polygons":true,"generalize":50})",
+       false},
+  };
+  for (const auto& test_request : requests) {
+    Api request;
+    ParseApi(test_request.first, Options::isochrone, request);
+    loki_worker.isochrones(request);
+    auto hits = worker.isochrone_cache.hits();
+    worker.isochrones(request);
+    EXPECT_EQ(worker.isochrone_cache.hits(), hits + test_request.second) << test_request.first;
+
+    // The cached grid is the one a fresh expansion computes
+    const auto& contours = request.options().contours();
+    unsigned int max_minutes = contours.Get(contours.size() - 1).time() + 10;
+    auto key = IsochroneCache::Key(request.options(), false, max_minutes);
+    auto cached = worker.isochrone_cache.Find(key);
+    ASSERT_NE(cached, nullptr) << test_request.first;
+    Isochrone isochrone;
+    auto fresh = isochrone.Compute(*request.mutable_options()->mutable_locations(), max_minutes,
+                                   *worker.reader, worker.mode_costing, worker.mode);
+    EXPECT_EQ(cached->TileSize(), fresh->TileSize()) << test_request.first;
+    EXPECT_EQ(cached->data(), fresh->data()) << test_request.first;
+
+    loki_worker.cleanup();
+    worker.cleanup();
+  }
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -94,6 +94,57 @@ TEST(Logging, FileLoggerTest) {
   EXPECT_EQ(custom, 8);
 }
 
+TEST(Logging, AsyncFileLoggerTest) {
+  std::remove("test/async_file_log_test.log");
+
+  // logging is only configured once per process so do it in another one, its exit drains the queue
+  testing::FLAGS_gtest_death_test_style = "threadsafe";
+  EXPECT_EXIT(
+      {
+        // configure bogusly
+        try {
+          logging::Configure({{"type", "file"},
+                              {"file_name", "test/async_file_log_test.log"},
+                              {"async", "true"},
+                              {"queue_size", "-1"}});
+          std::exit(1);
+        } catch (const std::exception&) {}
+
+        // the writer thread of the async logger does the formatting and the writing
+        logging::Configure({{"type", "file"},
+                            {"file_name", "test/async_file_log_test.log"},
+                            {"async", "true"},
+                            {"queue_size", "1024"}});
+        std::vector<std::future<size_t>> results;
+        for (size_t i = 0; i < 4; ++i) {
+          results.emplace_back(std::async(std::launch::async, work));
+        }
+        for (auto& result : results) {
+          result.get();
+        }
+        std::exit(0);
+      },
+      testing::ExitedWithCode(0), "");
+
+  std::ifstream file("test/async_file_log_test.log");
+  std::string line;
+  size_t error = 0, warn = 0, info = 0, debug = 0, trace = 0, custom = 0;
+  while (std::getline(file, line)) {
+    error += (line.find(" [ERROR] ") != std::string::npos);
+    warn += (line.find(" [WARN] ") != std::string::npos);
+    info += (line.find(" [INFO] ") != std::string::npos);
+    debug += (line.find(" [DEBUG] ") != std::string::npos);
+    trace += (line.find(" [TRACE] ") != std::string::npos);
+    custom += (line.find(" [CUSTOM] ") != std::string::npos);
+  }
+  EXPECT_EQ(error, 8);
+  EXPECT_EQ(warn, 8);
+  EXPECT_EQ(info, 8);
+  EXPECT_EQ(debug, 8);
+  EXPECT_EQ(trace, 8);
+  EXPECT_EQ(custom, 8);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
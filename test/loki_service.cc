@@ -3,6 +3,7 @@
 
 #include "baldr/rapidjson_utils.h"
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include <boost/property_tree/ptree.hpp>
 #include <prime_server/http_protocol.hpp>
 #include <prime_server/prime_server.hpp>
@@ -10,6 +11,8 @@
 #include <unistd.h>
 
 #include "loki/worker.h"
+#include "odin/worker.h"
+#include "thor/worker.h"
 
 using namespace valhalla;
 using namespace prime_server;
@@ -327,21 +330,7 @@ const std::vector<std::pair<uint16_t, std::string>> osrm_responses{
     {400,
      R"({"code":"InvalidValue","message":"The successfully parsed query parameters are invalid."})"}};
 
-zmq::context_t context;
-void start_service() {
-  // server
-  std::thread server(
-      std::bind(&http_server_t::serve,
-                http_server_t(context, "ipc:///tmp/test_loki_server", "ipc:///tmp/test_loki_proxy_in",
-                              "ipc:///tmp/test_loki_results", "ipc:///tmp/test_loki_interrupt")));
-  server.detach();
-
-  // load balancer
-  std::thread proxy(std::bind(&proxy_t::forward, proxy_t(context, "ipc:///tmp/test_loki_proxy_in",
-                                                         "ipc:///tmp/test_loki_proxy_out")));
-  proxy.detach();
-
-  // make the config file
+boost::property_tree::ptree make_config() {
   boost::property_tree::ptree config;
   std::stringstream json;
   json << R"({
@@ -369,9 +358,25 @@ void start_service() {
       "costing_directions_options": { "auto": {}, "pedestrian": {} }
     })";
   rapidjson::read_json(json, config);
+  return config;
+}
+
+zmq::context_t context;
+void start_service() {
+  // server
+  std::thread server(
+      std::bind(&http_server_t::serve,
+                http_server_t(context, "ipc:///tmp/test_loki_server", "ipc:///tmp/test_loki_proxy_in",
+                              "ipc:///tmp/test_loki_results", "ipc:///tmp/test_loki_interrupt")));
+  server.detach();
+
+  // load balancer
+  std::thread proxy(std::bind(&proxy_t::forward, proxy_t(context, "ipc:///tmp/test_loki_proxy_in",
+                                                         "ipc:///tmp/test_loki_proxy_out")));
+  proxy.detach();
 
   // service worker
-  std::thread worker(valhalla::loki::run_service, config);
+  std::thread worker(valhalla::loki::run_service, make_config());
   worker.detach();
 }
 
@@ -427,6 +432,41 @@ TEST(LokiService, test_osrm_failure_requests) {
   run_requests(osrm_requests, osrm_responses);
 }
 
+TEST(LokiService, test_metrics) {
+  auto config = make_config();
+  config.put("thor.logging.long_request", 110.0);
+  config.put("meili.default.gps_accuracy", 4.07);
+  config.put("meili.default.search_radius", 40);
+  config.put("meili.grid.size", 500);
+  config.put("meili.grid.cache_size", 64);
+  config.put_child("meili.customizable", {});
+  loki::loki_worker_t loki_worker(config);
+  thor::thor_worker_t thor_worker(config);
+  odin::odin_worker_t odin_worker(config);
+  midgard::metrics::Increment("test_service_metrics_total", {}, 5);
+
+  // the request goes through every stage, which all run in this process
+  http_request_info_t info{};
+  std::string message = http_request_t(method_t::GET, "/metrics").to_string();
+  for (auto* worker : std::vector<service_worker_t*>{&loki_worker, &thor_worker, &odin_worker}) {
+    std::list<zmq::message_t> job;
+    job.emplace_back(static_cast<void*>(&message[0]), message.size());
+    auto result = worker->work(job, &info, []() {});
+    ASSERT_EQ(result.intermediate, worker != &odin_worker);
+    ASSERT_EQ(result.messages.size(), 1u);
+    message = result.messages.front();
+  }
+
+  auto response = http_response_t::from_string(message.c_str(), message.size());
+  EXPECT_EQ(response.code, 200);
+  const auto& text = response.body;
+  auto type = text.find("# TYPE test_service_metrics_total counter\n");
+  ASSERT_NE(type, std::string::npos) << text;
+  EXPECT_EQ(text.find("# TYPE test_service_metrics_total", type + 1), std::string::npos) << text;
+  // the stages share the series of the process so they are only counted once
+  EXPECT_NE(text.find("\ntest_service_metrics_total 5\n"), std::string::npos) << text;
+}
+
 // todo: test_success_requests??
 
 } // namespace
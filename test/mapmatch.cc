@@ -908,6 +908,34 @@ TEST(Mapmatch, test_now_matches) {
   actor.trace_route(test_case);
 }
 
+TEST(Mapmatch, test_trace_attributes_pbf) {
+  tyr::actor_t actor(conf, true);
+  std::string test_case =
+      R"({"shape_match":"map_snap","costing":"auto","encoded_polyline":"oeyjbBqfjwHeO~M}x@`u@wDmh@oCcd@sAiVcAaKe@cBaNe[u^qg@qH`u@cL{Tmr@c{AtTu_@xVsd@")";
+  auto json = json_to_pt(actor.trace_attributes(test_case + "}"));
+  Api pbf;
+  ASSERT_TRUE(pbf.ParseFromString(actor.trace_attributes(test_case + R"(,"format":"pbf"})")));
+
+  // the same path and matched points as the json response
+  ASSERT_EQ(pbf.trip().routes_size(), 1);
+  ASSERT_EQ(pbf.trace_matches_size(), 1);
+  const auto& leg = pbf.trip().routes(0).legs(0);
+  EXPECT_EQ(midgard::delta_to_polyline(leg.shape()), json.get<std::string>("shape"));
+  EXPECT_EQ(leg.node_size() - 1, json.get_child("edges").size());
+  const auto& trace_match = pbf.trace_matches(0);
+  EXPECT_NEAR(trace_match.confidence_score(), json.get<float>("confidence_score"), .001f);
+  const auto& matched_points = json.get_child("matched_points");
+  ASSERT_EQ(trace_match.matched_points_size(), matched_points.size());
+  auto matched_point = trace_match.matched_points().begin();
+  for (const auto& expected : matched_points) {
+    EXPECT_EQ(TraceMatch::MatchedPoint::Type_Name(matched_point->type()),
+              expected.second.get<std::string>("type"));
+    EXPECT_NEAR(matched_point->ll().lng(), expected.second.get<double>("lon"), 1e-6);
+    EXPECT_NEAR(matched_point->ll().lat(), expected.second.get<double>("lat"), 1e-6);
+    ++matched_point;
+  }
+}
+
 TEST(Mapmatch, test_leg_duration_trimming) {
   std::vector<std::vector<std::string>> test_cases = {
       // 2 routes, one leg per route
@@ -996,8 +1024,8 @@ TEST(Mapmatch, test_leg_duration_trimming) {
       for (size_t j = 0; j < rlegs.size(); ++j) {
         auto rtime = rlegs.Get(j).node().rbegin()->elapsed_time();
         auto mtime = mlegs.Get(j).node().rbegin()->elapsed_time();
-        printf("r: %.2f %s\n", rtime, rlegs.Get(j).shape().c_str());
-        printf("m: %.2f %s\n", mtime, mlegs.Get(j).shape().c_str());
+        printf("r: %.2f %s\n", rtime, midgard::delta_to_polyline(rlegs.Get(j).shape()).c_str());
+        printf("m: %.2f %s\n", mtime, midgard::delta_to_polyline(mlegs.Get(j).shape()).c_str());
         EXPECT_NEAR(rtime, mtime, 0.1) << "Leg time differs";
       }
     }
@@ -301,6 +301,60 @@ TEST(Matrix, test_matrix) {
   }
 }
 
+TEST(Matrix, test_parallel_timedistancematrix) {
+  loki_worker_t loki_worker(config);
+
+  Api request;
+  ParseApi(test_request, Options::sources_to_targets, request);
+  loki_worker.matrix(request);
+  adjust_scores(*request.mutable_options());
+
+  auto mjolnir = config.get_child("mjolnir");
+  mjolnir.put("global_synchronized_cache", true);
+  GraphReader reader(mjolnir);
+
+  cost_ptr_t costing = CreateSimpleCost(request.options());
+  TimeDistanceMatrix timedist_matrix;
+  auto serial =
+      timedist_matrix.SourceToTarget(request.options().sources(), request.options().targets(),
+                                     reader, &costing, TravelMode::kDrive, 400000.0);
+
+  // the rows run on 3 threads, each with its own costing, but the result is the same
+  std::vector<TimeDistanceMatrix> pool(3);
+  std::vector<cost_ptr_t> costings;
+  std::vector<const cost_ptr_t*> mode_costings;
+  for (size_t i = 0; i < pool.size(); ++i) {
+    costings.push_back(CreateSimpleCost(request.options()));
+  }
+  for (const auto& c : costings) {
+    mode_costings.push_back(&c);
+  }
+  auto parallel = TimeDistanceMatrix::SourceToTarget(pool, mode_costings,
+                                                     request.options().sources(),
+                                                     request.options().targets(), reader,
+                                                     TravelMode::kDrive, 400000.0);
+  ASSERT_EQ(parallel.size(), serial.size());
+  for (uint32_t i = 0; i < serial.size(); ++i) {
+    EXPECT_EQ(parallel[i].time, serial[i].time) << "result " + std::to_string(i);
+    EXPECT_EQ(parallel[i].dist, serial[i].dist) << "result " + std::to_string(i);
+  }
+
+  // with more sources than targets the rows are many to one searches
+  const auto& targets = request.options().targets();
+  google::protobuf::RepeatedPtrField<valhalla::Location> fewer_targets(targets.begin(),
+                                                                       targets.begin() + 2);
+  auto expected = timedist_matrix.SourceToTarget(request.options().sources(), fewer_targets,
+                                                 reader, &costing, TravelMode::kDrive, 400000.0);
+  auto many_to_one =
+      TimeDistanceMatrix::SourceToTarget(pool, mode_costings, request.options().sources(),
+                                         fewer_targets, reader, TravelMode::kDrive, 400000.0);
+  ASSERT_EQ(many_to_one.size(), expected.size());
+  for (uint32_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(many_to_one[i].time, expected[i].time) << "result " + std::to_string(i);
+    EXPECT_EQ(many_to_one[i].dist, expected[i].dist) << "result " + std::to_string(i);
+  }
+}
+
 // TODO: it was commented before. Why?
 TEST(Matrix, DISABLED_test_matrix_osrm) {
   loki_worker_t loki_worker(config);
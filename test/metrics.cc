@@ -0,0 +1,150 @@
+#include "midgard/metrics.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "test.h"
+
+using namespace valhalla::midgard;
+
+namespace {
+
+TEST(Metrics, counter) {
+  auto& registry = metrics::Registry::Get();
+  auto& counter = registry.counter("test_counter_total", {{"action", "route"}});
+  EXPECT_EQ(counter.value(), 0u);
+  metrics::Increment("test_counter_total", {{"action", "route"}});
+  metrics::Increment("test_counter_total", {{"action", "route"}}, 2);
+  EXPECT_EQ(counter.value(), 3u);
+
+  // other labels are another series
+  metrics::Increment("test_counter_total", {{"action", "locate"}});
+  EXPECT_EQ(counter.value(), 3u);
+  EXPECT_EQ(&registry.counter("test_counter_total", {{"action", "route"}}), &counter);
+}
+
+TEST(Metrics, histogram) {
+  auto& histogram = metrics::Registry::Get().histogram("test_histogram", {}, {1, 10, 100});
+  for (auto value : {0.5, 1.0, 5.0, 50.0, 50.0, 1000.0}) {
+    histogram.Observe(value);
+  }
+  EXPECT_EQ(histogram.bucket(0), 2u);
+  EXPECT_EQ(histogram.bucket(1), 1u);
+  EXPECT_EQ(histogram.bucket(2), 2u);
+  EXPECT_EQ(histogram.bucket(3), 1u);
+  EXPECT_EQ(histogram.count(), 6u);
+  EXPECT_DOUBLE_EQ(histogram.sum(), 1106.5);
+}
+
+TEST(Metrics, threads) {
+  // every thread finds the same series whether or not it made it
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < 8; ++i) {
+    threads.emplace_back([]() {
+      for (size_t j = 0; j < 10000; ++j) {
+        metrics::Increment("test_threads_total", {{"thread", "any"}});
+        metrics::Observe("test_threads_ms", 2, {{"thread", "any"}});
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto& registry = metrics::Registry::Get();
+  EXPECT_EQ(registry.counter("test_threads_total", {{"thread", "any"}}).value(), 80000u);
+  EXPECT_EQ(registry.histogram("test_threads_ms", {{"thread", "any"}}).count(), 80000u);
+  EXPECT_DOUBLE_EQ(registry.histogram("test_threads_ms", {{"thread", "any"}}).sum(), 160000);
+}
+
+TEST(Metrics, serialize) {
+  metrics::Increment("test_serialize_total", {{"costing", "auto"}});
+  metrics::Increment("test_serialize_total", {{"costing", "bi\"cycle"}}, 4);
+  metrics::Observe("test_serialize_km", 3, {{"action", "route"}}, {1, 5});
+  auto text = metrics::Registry::Get().Serialize();
+
+  // each metric has its type once and then all of its series
+  EXPECT_NE(text.find("# TYPE test_serialize_total counter\n"
+                      "test_serialize_total{costing=\"auto\"} 1\n"
+                      "test_serialize_total{costing=\"bi\\\"cycle\"} 4\n"),
+            std::string::npos)
+      << text;
+  EXPECT_NE(text.find("# TYPE test_serialize_km histogram\n"
+                      "test_serialize_km_bucket{action=\"route\",le=\"1\"} 0\n"
+                      "test_serialize_km_bucket{action=\"route\",le=\"5\"} 1\n"
+                      "test_serialize_km_bucket{action=\"route\",le=\"+Inf\"} 1\n"
+                      "test_serialize_km_sum{action=\"route\"} 3\n"
+                      "test_serialize_km_count{action=\"route\"} 1\n"),
+            std::string::npos)
+      << text;
+}
+
+TEST(Metrics, serialize_prefixed_names) {
+  // foo_bar sorts between foo and foo{...} but foo still has its type once
+  metrics::Increment("test_prefix_total");
+  metrics::Increment("test_prefix_total_other", {{"costing", "auto"}});
+  metrics::Increment("test_prefix_total", {{"costing", "auto"}}, 2);
+  metrics::Observe("test_prefix_ms", 3);
+  metrics::Observe("test_prefix_ms_other", 3, {{"action", "route"}});
+  metrics::Observe("test_prefix_ms", 3, {{"action", "route"}});
+  auto text = metrics::Registry::Get().Serialize();
+
+  for (const auto& type :
+       {"# TYPE test_prefix_total counter\n", "# TYPE test_prefix_ms histogram\n"}) {
+    auto first = text.find(type);
+    ASSERT_NE(first, std::string::npos) << text;
+    EXPECT_EQ(text.find(type, first + 1), std::string::npos) << text;
+  }
+  EXPECT_NE(text.find("# TYPE test_prefix_total counter\n"
+                      "test_prefix_total 1\n"
+                      "test_prefix_total{costing=\"auto\"} 2\n"
+                      "# TYPE test_prefix_total_other counter\n"
+                      "test_prefix_total_other{costing=\"auto\"} 1\n"),
+            std::string::npos)
+      << text;
+  EXPECT_NE(text.find("test_prefix_ms_count 1\n"
+                      "test_prefix_ms_bucket{action=\"route\",le=\"1\"} 0\n"),
+            std::string::npos)
+      << text;
+}
+
+TEST(Metrics, merge_snapshots) {
+  metrics::Snapshot first;
+  first.counters["test_merge_total"] = 2;
+  first.histograms["test_merge_ms"] = {{1, 10}, {1, 0, 1}, 2, 20.5};
+  first.histograms["test_merge_other_ms"] = {{1}, {1, 0}, 1, 0.5};
+
+  metrics::Snapshot second;
+  second.counters["test_merge_total"] = 3;
+  second.counters["test_merge_total{action=\"route\"}"] = 1;
+  second.histograms["test_merge_ms"] = {{1, 10}, {0, 1, 0}, 1, 5};
+  second.histograms["test_merge_other_ms"] = {{5}, {1, 0}, 1, 0.5};
+  first.Merge(second);
+
+  EXPECT_EQ(first.counters["test_merge_total"], 5u);
+  EXPECT_EQ(first.counters["test_merge_total{action=\"route\"}"], 1u);
+  EXPECT_EQ(first.histograms["test_merge_ms"].buckets, (std::vector<uint64_t>{1, 1, 1}));
+  EXPECT_EQ(first.histograms["test_merge_ms"].count, 3u);
+  EXPECT_EQ(first.histograms["test_merge_ms"].sum, 25.5);
+  // other bounds can't be summed
+  EXPECT_EQ(first.histograms["test_merge_other_ms"].bounds, std::vector<double>{1});
+  EXPECT_EQ(first.histograms["test_merge_other_ms"].count, 1u);
+
+  auto text = first.Serialize();
+  EXPECT_NE(text.find("# TYPE test_merge_total counter\n"
+                      "test_merge_total 5\n"
+                      "test_merge_total{action=\"route\"} 1\n"),
+            std::string::npos)
+      << text;
+  EXPECT_NE(text.find("test_merge_ms_bucket{le=\"10\"} 2\n"
+                      "test_merge_ms_bucket{le=\"+Inf\"} 3\n"),
+            std::string::npos)
+      << text;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -329,6 +329,34 @@ TEST(NarrativeDictionary, test_en_US_start) {
   validate(empty_street_name_labels, kExpectedEmptyStreetNameLabels);
 }
 
+TEST(NarrativeDictionary, test_en_US_start_templates) {
+  const NarrativeDictionary& dictionary = GetNarrativeDictionary("en-US");
+
+  // Every phrase is compiled into a template with the same phrase id
+  for (const auto& phrase : dictionary.start_subset.phrases) {
+    std::string rendered;
+    dictionary.start_subset.GetTemplate(std::stoul(phrase.first)).Render(rendered, {});
+    validate(rendered, phrase.second);
+  }
+
+  // "2": "Head <CARDINAL_DIRECTION> on <BEGIN_STREET_NAMES>. Continue on <STREET_NAMES>."
+  std::string instruction;
+  dictionary.start_subset.GetTemplate(2).Render(instruction,
+                                                {{PhraseTag::kCardinalDirection, "north"},
+                                                 {PhraseTag::kBeginStreetNames, "Main Street"},
+                                                 {PhraseTag::kStreetNames, "Broadway"}});
+  validate(instruction, "Head north on Main Street. Continue on Broadway.");
+
+  // Tags without a value are left as is
+  dictionary.start_subset.GetTemplate(1).Render(instruction,
+                                                {{PhraseTag::kCardinalDirection, "south"}});
+  validate(instruction, "Head south on <STREET_NAMES>.");
+
+  // "3" is not a start phrase
+  EXPECT_THROW(dictionary.start_subset.GetTemplate(3), std::out_of_range);
+  EXPECT_THROW(dictionary.start_subset.GetTemplate(100), std::out_of_range);
+}
+
 TEST(NarrativeDictionary, test_en_US_start_verbal) {
   const NarrativeDictionary& dictionary = GetNarrativeDictionary("en-US");
 
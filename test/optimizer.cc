@@ -1,6 +1,11 @@
 #include "thor/optimizer.h"
 #include "config.h"
+#include "thor/local_search_optimizer.h"
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <limits>
+#include <random>
 #include <vector>
 
 #include "test.h"
@@ -35,6 +40,90 @@ TEST(Optimizer, Basic) {
   TryOptimizer(11, costs, expected_order);
 }
 
+// Asymmetric costs between random points, scaled per direction
+std::vector<float> RandomCosts(const uint32_t nlocs) {
+  std::mt19937 generator(nlocs);
+  std::uniform_real_distribution<float> distribution(0.0f, 10000.0f);
+  std::vector<float> x(nlocs), y(nlocs);
+  for (uint32_t i = 0; i < nlocs; ++i) {
+    x[i] = distribution(generator);
+    y[i] = distribution(generator);
+  }
+  std::vector<float> costs(nlocs * nlocs);
+  for (uint32_t i = 0; i < nlocs; ++i) {
+    for (uint32_t j = 0; j < nlocs; ++j) {
+      costs[i * nlocs + j] = std::hypot(x[i] - x[j], y[i] - y[j]) * (1.0f + 0.05f * ((i + j) % 5));
+    }
+  }
+  return costs;
+}
+
+TEST(LocalSearchOptimizer, Basic) {
+  std::vector<float> costs = {0,    3036, 707,  956,  318,  1934, 355,  1170, 1286, 3171, 2133,
+                              2978, 0,    2664, 3613, 3102, 2011, 3139, 3846, 1764, 2050, 1143,
+                              638,  2638, 0,    1295, 763,  1536, 800,  1528, 888,  2773, 1735,
+                              940,  3457, 1281, 0,    582,  2450, 630,  655,  1796, 3681, 2643,
+                              357,  3037, 708,  637,  0,    1935, 47,   851,  1286, 3171, 2133,
+                              1839, 2004, 1525, 2480, 1963, 0,    2000, 2713, 690,  2578, 1100,
+                              387,  3066, 737,  715,  77,   1964, 0,    928,  1316, 3201, 2163,
+                              1129, 3803, 1537, 682,  769,  2707, 819,  0,    2052, 3230, 2899,
+                              1214, 1750, 900,  1849, 1338, 634,  1375, 2082, 0,    1907, 846,
+                              3128, 2036, 2814, 3763, 3252, 2549, 3290, 3228, 1914, 0,    2010,
+                              2068, 1133, 1754, 2704, 2193, 1102, 2230, 2937, 854,  2000, 0};
+  LocalSearchOptimizer optimizer;
+  optimizer.Seed(111111);
+  std::vector<uint32_t> expected_order = {0, 3, 7, 4, 6, 2, 8, 5, 9, 1, 10};
+  EXPECT_EQ(optimizer.Solve(11, costs), expected_order);
+}
+
+TEST(LocalSearchOptimizer, SmallCounts) {
+  EXPECT_EQ(LocalSearchOptimizer().Solve(2, {0, 1, 1, 0}), (std::vector<uint32_t>{0, 1}));
+  std::vector<float> costs = {0, 9, 1, 9, 9, 0, 9, 1, 9, 1, 0, 9, 9, 9, 9, 0};
+  EXPECT_EQ(LocalSearchOptimizer().Solve(4, costs), (std::vector<uint32_t>{0, 2, 1, 3}));
+}
+
+TEST(LocalSearchOptimizer, Deterministic) {
+  // The tour only depends on the seed, not on the number of threads
+  const uint32_t nlocs = 150;
+  auto costs = RandomCosts(nlocs);
+  LocalSearchOptimizer single(8, 1);
+  single.Seed(7);
+  auto order = single.Solve(nlocs, costs);
+  LocalSearchOptimizer pool(8, 4);
+  pool.Seed(7);
+  EXPECT_EQ(pool.Solve(nlocs, costs), order);
+
+  // Every location is visited once with the origin and destination fixed
+  ASSERT_EQ(order.size(), nlocs);
+  EXPECT_EQ(order.front(), 0);
+  EXPECT_EQ(order.back(), nlocs - 1);
+  std::sort(order.begin(), order.end());
+  for (uint32_t i = 0; i < nlocs; ++i) {
+    EXPECT_EQ(order[i], i);
+  }
+}
+
+TEST(LocalSearchOptimizer, SeededIgnoresTimeBudget) {
+  // A budget that runs out before the second restart starts does not change a seeded tour
+  const uint32_t nlocs = 150;
+  auto costs = RandomCosts(nlocs);
+  LocalSearchOptimizer unlimited(16, 2, std::numeric_limits<uint32_t>::max());
+  unlimited.Seed(7);
+  auto order = unlimited.Solve(nlocs, costs);
+  for (uint32_t i = 0; i < 3; ++i) {
+    LocalSearchOptimizer budgeted(16, 2, 0);
+    budgeted.Seed(7);
+    EXPECT_EQ(budgeted.Solve(nlocs, costs), order);
+  }
+
+  // Without a seed the budget still stops restarts but the tour stays complete
+  LocalSearchOptimizer unseeded(16, 2, 0);
+  auto unseeded_order = unseeded.Solve(nlocs, costs);
+  ASSERT_EQ(unseeded_order.size(), nlocs);
+  EXPECT_EQ(unseeded_order.front(), 0u);
+  EXPECT_EQ(unseeded_order.back(), nlocs - 1);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
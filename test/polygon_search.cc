@@ -0,0 +1,155 @@
+#include "test.h"
+
+#include "baldr/graphreader.h"
+#include "baldr/tilehierarchy.h"
+#include "loki/polygon_search.h"
+#include "midgard/pointll.h"
+
+#include <boost/property_tree/ptree.hpp>
+#include <unordered_set>
+#include <vector>
+
+using namespace valhalla;
+using namespace valhalla::midgard;
+using namespace valhalla::baldr;
+using namespace valhalla::loki;
+
+namespace {
+
+boost::property_tree::ptree get_conf() {
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", "test/data/utrecht_tiles");
+  return conf;
+}
+
+Ring make_ring(const std::vector<PointLL>& points) {
+  Ring ring;
+  for (const auto& p : points) {
+    auto* ll = ring.add_coords();
+    ll->set_lng(p.lng());
+    ll->set_lat(p.lat());
+  }
+  return ring;
+}
+
+double side(const PointLL& a, const PointLL& b, const PointLL& p) {
+  return (static_cast<double>(b.lng()) - a.lng()) * (static_cast<double>(p.lat()) - a.lat()) -
+         (static_cast<double>(b.lat()) - a.lat()) * (static_cast<double>(p.lng()) - a.lng());
+}
+
+// Proper crossings only, the test polygons are chosen so no shape point lies on them
+bool crosses(const PointLL& a, const PointLL& b, const PointLL& c, const PointLL& d) {
+  return (side(c, d, a) > 0) != (side(c, d, b) > 0) && (side(a, b, c) > 0) != (side(a, b, d) > 0);
+}
+
+bool contains(const std::vector<PointLL>& ring, const PointLL& p) {
+  bool inside = false;
+  for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+    if ((ring[i].lat() > p.lat()) != (ring[j].lat() > p.lat()) &&
+        p.lng() < (ring[j].lng() - ring[i].lng()) * (p.lat() - ring[i].lat()) /
+                          (ring[j].lat() - ring[i].lat()) +
+                      ring[i].lng()) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+// Brute force: every edge of every tile whose shape is inside or crosses the ring
+std::unordered_set<GraphId> edges_in_ring(GraphReader& reader, const std::vector<PointLL>& ring) {
+  std::unordered_set<GraphId> edges;
+  for (const auto& tile_id : reader.GetTileSet()) {
+    if (tile_id.level() > TileHierarchy::levels().rbegin()->first) {
+      continue;
+    }
+    const GraphTile* tile = reader.GetGraphTile(tile_id);
+    GraphId edge_id = tile_id;
+    for (uint32_t i = 0; i < tile->header()->directededgecount(); ++i, ++edge_id) {
+      const auto* edge = tile->directededge(i);
+      if (edge->is_shortcut() || edge->use() == Use::kTransitConnection ||
+          edge->use() == Use::kPlatformConnection || edge->use() == Use::kEgressConnection) {
+        continue;
+      }
+      const auto shape = tile->edgeinfo(edge->edgeinfo_offset()).shape();
+      bool inside = !shape.empty() && contains(ring, shape.front());
+      for (size_t j = 0; !inside && j + 1 < shape.size(); ++j) {
+        for (size_t k = 0; !inside && k < ring.size(); ++k) {
+          inside = crosses(shape[j], shape[j + 1], ring[k], ring[(k + 1) % ring.size()]);
+        }
+      }
+      if (inside) {
+        edges.insert(edge_id);
+      }
+    }
+  }
+  return edges;
+}
+
+void check_ring(const std::vector<PointLL>& points) {
+  GraphReader reader(get_conf());
+  google::protobuf::RepeatedPtrField<Ring> rings;
+  *rings.Add() = make_ring(points);
+  auto found = edges_in_rings(rings, reader);
+  auto expected = edges_in_ring(reader, points);
+  ASSERT_FALSE(expected.empty());
+
+  // Every edge in the polygon is found
+  for (const auto& edge_id : expected) {
+    EXPECT_TRUE(found.count(edge_id)) << "Missing edge " << edge_id;
+  }
+
+  // Any other edge found is a shortcut
+  for (const auto& edge_id : found) {
+    if (!expected.count(edge_id)) {
+      EXPECT_TRUE(reader.directededge(edge_id)->is_shortcut()) << "Extra edge " << edge_id;
+    }
+  }
+
+  // The bitsets hold exactly the edges found
+  size_t count = 0;
+  for (const auto& bitset : edge_bitsets(found)) {
+    for (size_t byte = 0; byte < bitset.second.size(); ++byte) {
+      for (uint32_t bit = 0; bit < 8; ++bit) {
+        if ((bitset.second[byte] >> bit) & 1) {
+          GraphId edge_id(bitset.first.tileid(), bitset.first.level(), byte * 8 + bit);
+          EXPECT_TRUE(found.count(edge_id));
+          ++count;
+        }
+      }
+    }
+  }
+  EXPECT_EQ(count, found.size());
+}
+
+TEST(PolygonSearch, Rectangle) {
+  check_ring({{5.1079, 52.0871}, {5.1233, 52.0871}, {5.1233, 52.0962}, {5.1079, 52.0962}});
+}
+
+TEST(PolygonSearch, Concave) {
+  // A U shape, closed and spanning several bins
+  check_ring({{5.0791, 52.0653},
+              {5.1527, 52.0653},
+              {5.1527, 52.1147},
+              {5.1303, 52.1147},
+              {5.1303, 52.0808},
+              {5.1011, 52.0808},
+              {5.1011, 52.1147},
+              {5.0791, 52.1147},
+              {5.0791, 52.0653}});
+}
+
+TEST(PolygonSearch, Length) {
+  google::protobuf::RepeatedPtrField<Ring> rings;
+  *rings.Add() = make_ring({{5.1, 52.08}, {5.11, 52.08}, {5.11, 52.09}});
+  const float expected = PointLL(5.1, 52.08).Distance(PointLL(5.11, 52.08)) +
+                         PointLL(5.11, 52.08).Distance(PointLL(5.11, 52.09)) +
+                         PointLL(5.11, 52.09).Distance(PointLL(5.1, 52.08));
+  EXPECT_NEAR(rings_length(rings), expected, 1.0f);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
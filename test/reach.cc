@@ -127,6 +127,35 @@ TEST(Reach, check_all_reach) {
   }
 }
 
+TEST(Reach, check_stored_reach) {
+  // get tile access
+  auto conf = get_conf();
+  GraphReader reader(conf.get_child("mjolnir"));
+
+  auto costing = create_costing();
+  auto mode = EdgeReach::mode_index(costing->access_mode());
+  ASSERT_LT(mode, kReachModeCount) << "Auto reach should be stored in the tiles";
+  Reach reach_finder;
+
+  // look at all the edges
+  for (auto tile_id : reader.GetTileSet()) {
+    const auto* tile = reader.GetGraphTile(tile_id);
+    for (GraphId edge_id = tile->header()->graphid();
+         edge_id.id() < tile->header()->directededgecount(); ++edge_id) {
+      const auto* edge_reach = tile->edge_reach(edge_id.id());
+      ASSERT_NE(edge_reach, nullptr) << "Tiles should have been built with reach";
+
+      // the stored reach has to be a lower bound of what the expansion finds
+      const auto* edge = tile->directededge(edge_id);
+      auto reach = reach_finder(edge, edge_id, 50, reader, costing, kInbound | kOutbound);
+      EXPECT_LE(std::min(edge_reach->outbound(mode), 50u), reach.outbound)
+          << "Stored outbound reach is too high for " + std::to_string(edge_id.value);
+      EXPECT_LE(std::min(edge_reach->inbound(mode), 50u), reach.inbound)
+          << "Stored inbound reach is too high for " + std::to_string(edge_id.value);
+    }
+  }
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
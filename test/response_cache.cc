@@ -0,0 +1,156 @@
+#include "test.h"
+
+#include "baldr/cache_utils.h"
+#include "baldr/graphreader.h"
+#include "filesystem.h"
+#include "thor/response_cache.h"
+
+#include <boost/property_tree/ptree.hpp>
+
+using namespace valhalla;
+using namespace valhalla::thor;
+
+namespace {
+
+// a response of about a kilobyte, with the overhead an entry is less than 1200 bytes
+std::string make_response(char c) {
+  return std::string(1000, c);
+}
+
+const std::string spill_dir = "test/data/response_cache";
+
+TEST(ResponseCache, evicts_least_recently_used) {
+  ResponseCache cache(2500);
+  cache.Insert("a", make_response('a'));
+  cache.Insert("b", make_response('b'));
+
+  // using a makes b the one to go
+  std::string response;
+  ASSERT_TRUE(cache.Find("a", response));
+  EXPECT_EQ(response, make_response('a'));
+  cache.Insert("c", make_response('c'));
+  EXPECT_FALSE(cache.Find("b", response));
+  EXPECT_TRUE(cache.Find("a", response));
+  EXPECT_TRUE(cache.Find("c", response));
+  EXPECT_EQ(cache.hits(), 3);
+  EXPECT_EQ(cache.misses(), 1);
+  EXPECT_LE(cache.size(), 2500);
+
+  // too large to ever keep
+  cache.Insert("d", std::string(3000, 'd'));
+  EXPECT_FALSE(cache.Find("d", response));
+  EXPECT_TRUE(cache.Find("c", response));
+}
+
+TEST(ResponseCache, spills_to_disk) {
+  filesystem::remove_all(spill_dir);
+  {
+    ResponseCache cache(1500, spill_dir, 1024 * 1024);
+    cache.Insert("a", make_response('a'));
+    cache.Insert("b", make_response('b'));
+    EXPECT_GT(cache.spill_size(), 0);
+
+    // a comes back from its file and b goes to one
+    std::string response;
+    ASSERT_TRUE(cache.Find("a", response));
+    EXPECT_EQ(response, make_response('a'));
+    ASSERT_TRUE(cache.Find("b", response));
+    EXPECT_EQ(response, make_response('b'));
+    EXPECT_FALSE(cache.Find("c", response));
+  }
+
+  // the files are used by the next cache with the same directory
+  ResponseCache cache(1500, spill_dir, 1024 * 1024);
+  EXPECT_GT(cache.spill_size(), 0);
+  std::string response;
+  ASSERT_TRUE(cache.Find("a", response));
+  EXPECT_EQ(response, make_response('a'));
+  filesystem::remove_all(spill_dir);
+}
+
+TEST(ResponseCache, spill_budget) {
+  filesystem::remove_all(spill_dir);
+  ResponseCache cache(1500, spill_dir, 2500);
+  for (char c = 'a'; c <= 'e'; ++c) {
+    cache.Insert(std::string(1, c), make_response(c));
+  }
+  EXPECT_LE(cache.spill_size(), 2500);
+
+  // the oldest files were removed, the newest is still in memory
+  std::string response;
+  EXPECT_FALSE(cache.Find("a", response));
+  EXPECT_TRUE(cache.Find("d", response));
+  EXPECT_TRUE(cache.Find("e", response));
+  size_t files = 0;
+  for (filesystem::directory_iterator i(spill_dir), end; i != end; ++i) {
+    ++files;
+  }
+  EXPECT_LE(files, 2);
+  filesystem::remove_all(spill_dir);
+}
+
+TEST(ResponseCache, uncacheable) {
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", "test/data/no_tiles_here");
+  baldr::GraphReader reader(conf);
+
+  // without a location or a tile there is no dataset to key the response on
+  Options options;
+  EXPECT_TRUE(ResponseCache::Key(options, reader).empty());
+  auto* ll = options.add_locations()->mutable_ll();
+  ll->set_lng(5.1f);
+  ll->set_lat(52.1f);
+  EXPECT_TRUE(ResponseCache::Key(options, reader).empty());
+
+  // and none unless it is configured
+  boost::property_tree::ptree config;
+  EXPECT_EQ(ResponseCache::Shared(config), nullptr);
+  config.put("thor.response_cache_size", 1024);
+  auto cache = ResponseCache::Shared(config);
+  EXPECT_NE(cache, nullptr);
+  EXPECT_EQ(ResponseCache::Shared(config), cache);
+}
+
+TEST(ResponseCache, shared_by_tiles_and_time) {
+  // requests at the current time share a bucket, others are keyed by their date_time alone
+  Options options;
+  options.add_locations()->set_date_time("2020-01-01T08:00");
+  EXPECT_TRUE(baldr::cache_time_bucket(options).empty());
+  options.add_locations()->set_date_time("current");
+  EXPECT_EQ(baldr::cache_time_bucket(options).front(), 'c');
+
+  // workers reading the same tiles share a cache, other tiles get their own
+  boost::property_tree::ptree config;
+  config.put("mjolnir.tile_dir", "test/data/utrecht_tiles");
+  config.put("thor.response_cache_size", 1024);
+  auto cache = ResponseCache::Shared(config);
+  EXPECT_EQ(ResponseCache::Shared(config), cache);
+  config.put("mjolnir.tile_dir", "test/data/other_tiles");
+  EXPECT_NE(ResponseCache::Shared(config), cache);
+}
+
+TEST(ResponseCache, deterministic_keys) {
+  // equal requests serialize to the same key however they were built
+  Options options;
+  options.set_costing(Costing::auto_);
+  options.add_locations()->set_date_time("2020-01-01T08:00");
+  options.mutable_locations(0)->mutable_ll()->set_lat(52.1f);
+  Options other;
+  other.add_locations()->mutable_ll()->set_lat(52.1f);
+  other.set_costing(Costing::auto_);
+  other.mutable_locations(0)->set_date_time("2020-01-01T08:00");
+  EXPECT_EQ(baldr::cache_serialize(options), baldr::cache_serialize(other));
+  Options parsed;
+  ASSERT_TRUE(parsed.ParseFromString(baldr::cache_serialize(options)));
+  EXPECT_EQ(baldr::cache_serialize(parsed), baldr::cache_serialize(options));
+
+  other.set_costing(Costing::bicycle);
+  EXPECT_NE(baldr::cache_serialize(options), baldr::cache_serialize(other));
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -103,6 +103,37 @@ TEST(Sample, getgz) {
   _get("test/data/samplegz");
 };
 
+TEST(Sample, get_all_order) {
+  // postings from different tiles (and no tile at all) mixed together
+  skadi::sample s("test/data/samplegz");
+  std::vector<std::pair<double, double>> postings = {{-76.503915, 40.678783}, {0.5, 0.5},
+                                                     {-76.9, 40.0},           {200.0, 200.0},
+                                                     {-76.537011, 40.723872}, {0.5, 0.5}};
+  auto heights = s.get_all(postings);
+  ASSERT_EQ(heights.size(), postings.size());
+  for (size_t i = 0; i < postings.size(); ++i) {
+    EXPECT_EQ(heights[i], s.get(postings[i])) << "Wrong height or order at " + std::to_string(i);
+  }
+  EXPECT_EQ(heights[1], skadi::sample::get_no_data_value());
+  EXPECT_EQ(heights[3], skadi::sample::get_no_data_value());
+}
+
+struct cache_sample_t : public skadi::sample {
+  using skadi::sample::sample;
+  const void* cache() const {
+    return unzipped_cache.get();
+  }
+};
+
+TEST(Sample, shared_cache) {
+  // samples of the same data source share their decompressed tiles
+  cache_sample_t a("test/data/samplegz"), b("test/data/samplegz/"), c("test/data/sample");
+  EXPECT_EQ(a.cache(), b.cache());
+  EXPECT_NE(a.cache(), c.cache());
+  EXPECT_EQ(a.get(std::make_pair(-76.503915, 40.678783)),
+            b.get(std::make_pair(-76.503915, 40.678783)));
+}
+
 struct testable_sample_t : public skadi::sample {
   testable_sample_t(const std::string& dir) : sample(dir) {
     {
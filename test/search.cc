@@ -439,6 +439,54 @@ TEST(Search, test_search_cutoff) {
   search(x, 2, 0);
 }
 
+TEST(Search, test_bin_segments) {
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", tile_dir);
+  valhalla::baldr::GraphReader reader(conf);
+  conf.put("cache_bin_segments", true);
+  valhalla::baldr::GraphReader cached_reader(conf);
+
+  // a grid of locations over the whole graph, some of them sharing bins
+  std::vector<Location> locations;
+  for (double lng = 0; lng <= .21; lng += .015) {
+    for (double lat = 0; lat <= .21; lat += .015) {
+      locations.emplace_back(PointLL{lng, lat});
+    }
+  }
+
+  // projecting onto the decoded bin segments has to find exactly the same candidates
+  const auto costing = create_costing();
+  const auto expected = Search(locations, reader, costing);
+  ASSERT_FALSE(expected.empty());
+  // the second search uses the segments that the first one kept with the tiles
+  for (int i = 0; i < 2; ++i) {
+    const auto results = Search(locations, cached_reader, costing);
+    ASSERT_EQ(results.size(), expected.size());
+    for (const auto& kv : expected) {
+      const auto& edges = results.at(kv.first).edges;
+      ASSERT_EQ(edges.size(), kv.second.edges.size());
+      for (size_t j = 0; j < edges.size(); ++j) {
+        EXPECT_EQ(edges[j].id, kv.second.edges[j].id);
+        EXPECT_EQ(edges[j].percent_along, kv.second.edges[j].percent_along);
+        EXPECT_EQ(edges[j].projected, kv.second.edges[j].projected);
+        EXPECT_EQ(edges[j].distance, kv.second.edges[j].distance);
+        EXPECT_EQ(edges[j].sos, kv.second.edges[j].sos);
+      }
+    }
+  }
+
+  // a tile from a reader which does not cache them has no bins allocated
+  EXPECT_FALSE(reader.GetGraphTile(tile_id)->bin_segments(0));
+
+  auto tile = cached_reader.GetGraphTile(tile_id);
+  auto segments = cached_reader.GetBinSegments(tile, 0);
+  ASSERT_TRUE(segments);
+  EXPECT_EQ(segments, tile->bin_segments(0));
+  EXPECT_EQ(segments->edges.size(), tile->GetBin(0).size());
+  EXPECT_EQ(segments->point_offsets.size(), segments->edges.size() + 1);
+  EXPECT_FALSE(reader.GetBinSegments(reader.GetGraphTile(tile_id), 0));
+}
+
 } // namespace
 
 // Setup and tearown will be called only once for the entire suite121
@@ -0,0 +1,126 @@
+#include "test.h"
+
+#include "baldr/graphreader.h"
+#include "baldr/rapidjson_utils.h"
+#include "loki/search.h"
+#include "loki/search_cache.h"
+#include "sif/autocost.h"
+
+#include <boost/property_tree/ptree.hpp>
+
+using namespace valhalla;
+using namespace valhalla::midgard;
+using namespace valhalla::baldr;
+using namespace valhalla::loki;
+namespace vs = valhalla::sif;
+
+namespace {
+
+Options make_options() {
+  Options options;
+  options.set_costing(Costing::auto_);
+  const rapidjson::Document doc;
+  sif::ParseAutoCostOptions(doc, "/costing_options/auto", options.add_costing_options());
+  return options;
+}
+
+boost::property_tree::ptree get_conf() {
+  boost::property_tree::ptree conf;
+  conf.put("tile_dir", "test/data/utrecht_tiles");
+  return conf;
+}
+
+std::vector<baldr::Location> make_locations() {
+  std::vector<baldr::Location> locations;
+  for (float lng = 5.09f; lng < 5.13f; lng += .004f) {
+    for (float lat = 52.08f; lat < 52.11f; lat += .004f) {
+      locations.emplace_back(PointLL{lng, lat}, baldr::Location::StopType::BREAK, 50, 50, 0);
+    }
+  }
+  return locations;
+}
+
+void check_same(const std::unordered_map<baldr::Location, PathLocation>& expected,
+                const std::unordered_map<baldr::Location, PathLocation>& results) {
+  ASSERT_EQ(results.size(), expected.size());
+  for (const auto& kv : expected) {
+    const auto& result = results.at(kv.first);
+    ASSERT_EQ(result.edges.size(), kv.second.edges.size());
+    for (size_t i = 0; i < result.edges.size(); ++i) {
+      EXPECT_EQ(result.edges[i].id, kv.second.edges[i].id);
+      EXPECT_EQ(result.edges[i].percent_along, kv.second.edges[i].percent_along);
+      EXPECT_EQ(result.edges[i].projected, kv.second.edges[i].projected);
+    }
+    EXPECT_EQ(result.filtered_edges.size(), kv.second.filtered_edges.size());
+  }
+}
+
+TEST(SearchCache, same_as_search) {
+  GraphReader reader(get_conf());
+  auto options = make_options();
+  auto costing = vs::CreateAutoCost(Costing::auto_, options);
+  auto locations = make_locations();
+  auto expected = Search(locations, reader, costing);
+  ASSERT_FALSE(expected.empty());
+
+  // the first search fills the cache and the second is answered from it
+  search_cache_t cache(1024 * 1024);
+  auto key = search_cache_t::costing_key(options);
+  check_same(expected, cache.search(locations, reader, costing, key));
+  auto filled = cache.size();
+  EXPECT_GT(filled, 0);
+  EXPECT_EQ(cache.hits(), 0);
+  EXPECT_EQ(cache.misses(), locations.size());
+  check_same(expected, cache.search(locations, reader, costing, key));
+  EXPECT_EQ(cache.size(), filled);
+  EXPECT_EQ(cache.hits(), locations.size());
+  EXPECT_EQ(cache.misses(), locations.size());
+
+  // different costing options are different entries
+  options.mutable_costing_options(static_cast<int>(Costing::auto_))->set_use_highways(0.1f);
+  check_same(expected, cache.search(locations, reader, costing,
+                                    search_cache_t::costing_key(options)));
+  EXPECT_GT(cache.size(), filled);
+  EXPECT_EQ(cache.hits(), locations.size());
+  EXPECT_EQ(cache.misses(), 2 * locations.size());
+}
+
+TEST(SearchCache, memory_bound) {
+  GraphReader reader(get_conf());
+  auto options = make_options();
+  auto costing = vs::CreateAutoCost(Costing::auto_, options);
+  auto locations = make_locations();
+  auto expected = Search(locations, reader, costing);
+
+  // a cache too small for all the locations still finds all of them
+  search_cache_t cache(2048);
+  auto key = search_cache_t::costing_key(options);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(cache.search(locations, reader, costing, key).size(), expected.size());
+    EXPECT_LE(cache.size(), 2048);
+  }
+}
+
+TEST(SearchCache, uncacheable) {
+  GraphReader reader(get_conf());
+  auto options = make_options();
+  EXPECT_FALSE(search_cache_t::costing_key(options).empty());
+  options.add_avoid_edges()->set_id(1);
+  EXPECT_TRUE(search_cache_t::costing_key(options).empty());
+
+  // without a costing key nothing is cached
+  auto costing = vs::CreateAutoCost(Costing::auto_, options);
+  auto locations = make_locations();
+  search_cache_t cache(1024 * 1024);
+  check_same(Search(locations, reader, costing), cache.search(locations, reader, costing, ""));
+  EXPECT_EQ(cache.size(), 0);
+  EXPECT_EQ(cache.hits(), 0);
+  EXPECT_EQ(cache.misses(), 0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -7,6 +7,7 @@
 #include "baldr/graphreader.h"
 #include "baldr/rapidjson_utils.h"
 #include "loki/worker.h"
+#include "midgard/encoded.h"
 #include "odin/worker.h"
 #include "thor/worker.h"
 #include "tyr/serializers.h"
@@ -90,7 +91,7 @@ TEST(Summary, test_time_summary) {
   auto response = tester.test(request);
   const auto& leg = response.trip().routes(0).legs(0);
   EXPECT_EQ(
-      leg.shape(),
+      midgard::delta_to_polyline(leg.shape()),
       "kbykbB{afxHWee@kAuh@{@qZmP{[_IsMaHoMgDcSu@mFM{@wDoIcAx@iR`LqHlE}IhFaShF{P{@eJAqL{MoNkLcRgSsUc^_IcPwIcUmOkf@qRss@sKig@{Po~@iM}|@wHe{@yCa_@s@{_@z@i^dEo_@nI}^lJcX~NoWhM{Npa@gYbk@yUro@_WnvAmn@~l@wVnc@kRhGcDnNaHxa@mShg@aUlqBq{@hdB_x@prDuyAt`Cy|@dZsKhWuLb|B_`Ajf@wOfgAy`@nr@q^bj@cY`q@qa@h]_UzZcTz`@i[tmAmbAfXwNp\\aPdPoAtTpAzUrJnNlKvMbQhM~WzKtZx\\p_BxQfbA~NjcAdJdj@|~@poEzn@fmC~DdPjKiJ~N_MfNuJdOkIfNkFv^kDjP`@fO`AdOtD~CnApCdApGhC~NxJpQhPbLdLfYjZlgAjnAh|@r{@zZnSje@x\\|aBfdAld@xZ~uBjtArKhHfkAhw@bWzNzJpF~IfGxLpIrLpInShQbPbR`NlTjP|ZzPhc@dKbZ`g@d{AbQnh@fXxv@vM`^j[~s@zQx]nMnTpRz[nh@pu@bVzZ|TtZt^rc@ra@vf@dYrZz`@h^l_@~W~]xSxyAxl@~|@j]b~Axm@xjAdd@zy@hZfgAra@nStJdJfIfElGtDpHfI|TvHfXrB`Mz@~ZGxb@{@hXcQ~qBm_@`vDcp@`aFoHxm@uE|SsFzX}Jjd@gIj\\oHlXqH|Z}DtQoDvS{ApLaCr\\UdE]vDGtCd@jEz@xCxBvDxHhBjo@nOr[jEdT~AbLYbGYdJeB`CY~R_FpWoKxHwDfeB_u@jViFrKm@xMvAvSdHxVdS`Xjd@bKhSlJfWvIna@`\\`zBxCjQhGhVpH`UpLpV|@lBvCpG~HnUjGfZzEld@zAna@dAva@Df_@aBpc@kB~^aCx^cAdKiBzKqBbMyClQwH`]aHxWqHbUy[rz@mE`L}O~`@zF|GtDdFxl@~{@zn@``Ani@`w@jUr_@hg@l~@`{@faBh\\hp@fYhg@`Wbd@xGnL}OvnAoCtd@yBbOaRzuAm@nDqCfM_C~MeAlFsAlKs@pHaCtUWpJwChXqBdH}@jFUjFOzHt@nHvCpK~DtGlDlC`XdO~CzBG~T}Jh}@yVaLqBbAsFhh@G`FOt`@e@xC");
 
   // loop over all routes all legs
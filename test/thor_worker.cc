@@ -1,6 +1,7 @@
 #include "test.h"
 
 #include "midgard/logging.h"
+#include "midgard/metrics.h"
 #include "thor/attributes_controller.h"
 #include "thor/worker.h"
 #include "tyr/actor.h"
@@ -131,6 +132,22 @@ TEST(ThorWorker, test_parse_filter_attributes_includes) {
         << "Expected " + included_keys[i] + " to be present";
   }
 }
+
+TEST(ThorWorker, test_edge_cost_cache_metrics) {
+  tyr::actor_t actor(conf, true);
+  auto& registry = metrics::Registry::Get();
+  auto& hits = registry.counter("valhalla_edge_cost_cache_hits_total");
+  auto& misses = registry.counter("valhalla_edge_cost_cache_misses_total");
+  auto hits_before = hits.value();
+  auto misses_before = misses.value();
+
+  // the searches of a matrix share the cache and cleanup counts how it did
+  actor.matrix(R"({"costing":"auto",
+      "sources":[{"lat":52.09110,"lon":5.09806},{"lat":52.09098,"lon":5.09679}],
+      "targets":[{"lat":52.10205,"lon":5.11453},{"lat":52.08774,"lon":5.12271}]})");
+  EXPECT_GT(misses.value(), misses_before);
+  EXPECT_GT(hits.value(), hits_before);
+}
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,111 @@
+#include "test.h"
+
+#include "baldr/graphreader.h"
+#include "baldr/graphtile.h"
+#include "filesystem.h"
+#include "midgard/sequence.h"
+#include "mjolnir/util.h"
+
+#include <boost/property_tree/ptree.hpp>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_set>
+
+using namespace valhalla;
+using namespace valhalla::baldr;
+
+namespace {
+
+const std::string tile_dir = "test/data/utrecht_tiles";
+
+// Write the extract once, every test uses the same one since the graph reader keeps it
+const std::string& get_extract() {
+  static const std::string extract = [] {
+    std::string extract = "test/data/utrecht_tiles.tar";
+    mjolnir::build_tile_extract(tile_dir, extract);
+    return extract;
+  }();
+  return extract;
+}
+
+std::unordered_set<GraphId> tiles_in_dir() {
+  std::unordered_set<GraphId> tiles;
+  for (filesystem::recursive_directory_iterator i(tile_dir), end; i != end; ++i) {
+    const auto file_name = i->path().string();
+    if (i->is_regular_file() && file_name.size() > 4 &&
+        file_name.compare(file_name.size() - 4, 4, ".gph") == 0) {
+      tiles.emplace(GraphTile::GetTileId(file_name));
+    }
+  }
+  return tiles;
+}
+
+std::string read_tile(const GraphId& tile_id) {
+  std::ifstream file(tile_dir + "/" + GraphTile::FileSuffix(tile_id), std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+TEST(TileExtract, PlainTar) {
+  // Plain tar readers see the index and every tile
+  midgard::tar archive(get_extract());
+  EXPECT_EQ(archive.corrupt_blocks, 0);
+  auto tiles = tiles_in_dir();
+  ASSERT_FALSE(tiles.empty());
+  ASSERT_EQ(archive.contents.size(), tiles.size() + 1);
+
+  // The index is sorted and points at the data of the tiles
+  const auto& index = archive.contents.at(kTileIndexName);
+  ASSERT_EQ(index.second, tiles.size() * sizeof(tile_index_entry_t));
+  const auto* entries = reinterpret_cast<const tile_index_entry_t*>(index.first);
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    GraphId tile_id(entries[i].tile_id);
+    EXPECT_TRUE(tiles.count(tile_id));
+    if (i > 0) {
+      EXPECT_LT(entries[i - 1].tile_id, entries[i].tile_id);
+    }
+    const auto& entry = archive.contents.at(GraphTile::FileSuffix(tile_id));
+    EXPECT_EQ(entry.first, archive.mm.get() + entries[i].offset);
+    EXPECT_EQ(entry.second, entries[i].size);
+    EXPECT_EQ(std::string(entry.first, entry.second), read_tile(tile_id));
+  }
+
+  // Only the index is read when not traversing the headers
+  midgard::tar first(get_extract(), true, false);
+  ASSERT_EQ(first.contents.size(), 1);
+  EXPECT_EQ(first.contents.begin()->first, kTileIndexName);
+}
+
+TEST(TileExtract, GraphReader) {
+  boost::property_tree::ptree conf;
+  conf.put("tile_extract", get_extract());
+  GraphReader reader(conf);
+
+  auto tiles = tiles_in_dir();
+  EXPECT_EQ(reader.GetTileSet(), tiles);
+  for (const auto& tile_id : tiles) {
+    EXPECT_TRUE(reader.DoesTileExist(tile_id));
+    const GraphTile* tile = reader.GetGraphTile(tile_id);
+    ASSERT_NE(tile, nullptr);
+    EXPECT_EQ(tile->header()->graphid(), tile_id);
+  }
+  for (const auto& level : TileHierarchy::levels()) {
+    for (const auto& tile_id : reader.GetTileSet(level.first)) {
+      EXPECT_EQ(tile_id.level(), level.first);
+      EXPECT_TRUE(tiles.count(tile_id));
+    }
+  }
+
+  // Tiles not in the extract are not found
+  GraphId missing(0, 0, 0);
+  ASSERT_FALSE(tiles.count(missing));
+  EXPECT_FALSE(reader.DoesTileExist(missing));
+  EXPECT_EQ(reader.GetGraphTile(missing), nullptr);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,23 @@ TEST(UtilOdin, test_get_locales) {
   EXPECT_NE(init.find("en-US"), init.cend()) << "Should find 'en-US' locales file";
 }
 
+TEST(UtilOdin, test_get_locale) {
+  EXPECT_TRUE(is_supported_locale("en-US"));
+  EXPECT_TRUE(is_supported_locale("en"));
+  EXPECT_FALSE(is_supported_locale("xx-XX"));
+  EXPECT_EQ(get_locale("xx-XX"), nullptr);
+
+  // an alias shares the dictionary of its locale
+  const auto en_us = get_locale("en-US");
+  ASSERT_NE(en_us, nullptr);
+  EXPECT_EQ(en_us->GetLanguageTag(), "en-US");
+  EXPECT_EQ(get_locale("en"), en_us);
+
+  // and so does every later lookup
+  EXPECT_EQ(get_locale("en-US"), en_us);
+  EXPECT_EQ(get_locales().find("en-US")->second, en_us);
+}
+
 void try_get_formatted_time(const std::string& date_time,
                             const std::string& expected_date_time,
                             const std::locale& locale) {
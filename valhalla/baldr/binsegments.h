@@ -0,0 +1,44 @@
+#ifndef VALHALLA_BALDR_BINSEGMENTS_H_
+#define VALHALLA_BALDR_BINSEGMENTS_H_
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <valhalla/baldr/graphid.h>
+
+namespace valhalla {
+namespace baldr {
+
+/**
+ * The decoded shape of every edge in one bin of a tile, kept as a structure of
+ * arrays so that a point can be projected onto all of the segments of the bin in
+ * one pass. The coordinates are the ones the shape decoder produces, so projecting
+ * onto them gives the same results as projecting onto the decoded shape.
+ *
+ * The points of edge i are [point_offsets[i], point_offsets[i + 1]) and its
+ * segments are the consecutive pairs of those points. The pair made of the last
+ * point of an edge and the first point of the next one is not a segment.
+ */
+struct BinSegments {
+  // Edge info offset used for edges whose tile could not be loaded
+  static constexpr uint32_t kNoEdgeInfo = std::numeric_limits<uint32_t>::max();
+
+  // The edges in the bin, in the same order as GraphTile::GetBin returns them
+  std::vector<GraphId> edges;
+
+  // Offset of the edge info (within the edge's own tile) that the shape was decoded from
+  std::vector<uint32_t> edgeinfo_offsets;
+
+  // Index of the first point of each edge, with one more entry for the end of the last edge
+  std::vector<uint32_t> point_offsets;
+
+  // Longitude and latitude of the points of all the edges
+  std::vector<float> lngs;
+  std::vector<float> lats;
+};
+
+} // namespace baldr
+} // namespace valhalla
+
+#endif // VALHALLA_BALDR_BINSEGMENTS_H_
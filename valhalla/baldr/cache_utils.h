@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <boost/property_tree/ptree.hpp>
+#include <google/protobuf/message_lite.h>
+#include <valhalla/proto/options.pb.h>
+
+namespace valhalla {
+namespace baldr {
+
+// Rough bookkeeping cost of a cache entry on top of its key and value
+constexpr size_t kCacheEntryOverhead = 128;
+
+// Requests for the current time share cached results computed within this many seconds
+constexpr uint32_t kCacheTimeBucket = 300;
+
+/* Identifies the tiles a configuration reads, caches of results computed from the tiles are
+ * shared by the workers reading the same ones
+ * @param config  the configuration, mjolnir.tile_extract and mjolnir.tile_dir are used
+ * @return        the tile source
+ */
+std::string cache_tile_source(const boost::property_tree::ptree& config);
+
+/* Gets the part of a cache key for requests at the current time, whose date_time changes
+ * between otherwise identical requests
+ * @param options  the request options
+ * @return         the current time bucket (see kCacheTimeBucket) if any of the locations
+ *                 uses the current time, an empty string otherwise
+ */
+std::string cache_time_bucket(const Options& options);
+
+/* Serializes a message for a cache key. Protobuf only serializes equal messages to the same
+ * bytes when asked to be deterministic, otherwise the entries of map fields can come in any order
+ * @param message  the message, e.g. the options of a request
+ * @return         the serialized message
+ */
+std::string cache_serialize(const google::protobuf::MessageLite& message);
+
+/* Gets the cache shared by everyone asking for it with the same key, making it if there is
+ * none. It lives as long as someone holds on to it.
+ * @param key   identifies the cache, e.g. its cache_tile_source
+ * @param make  makes the cache if there is none
+ * @return      the shared cache
+ */
+template <class cache_t>
+std::shared_ptr<cache_t> shared_cache(const std::string& key,
+                                      const std::function<std::shared_ptr<cache_t>()>& make) {
+  static std::mutex caches_lock;
+  static std::unordered_map<std::string, std::weak_ptr<cache_t>> caches;
+  std::lock_guard<std::mutex> _(caches_lock);
+  auto& weak = caches[key];
+  auto cache = weak.lock();
+  if (!cache) {
+    cache = make();
+    weak = cache;
+  }
+  return cache;
+}
+
+} // namespace baldr
+} // namespace valhalla
@@ -45,36 +45,38 @@ public:
                     const float range,
                     const uint32_t bucketsize,
                     const LabelCost& labelcost) {
-    // We need at least a bucketsize of 1 or more
-    if (bucketsize < 1) {
-      throw std::runtime_error("Bucketsize must be 1 or greater");
-    }
-
-    // We need at least a bucketrange of something larger than 0
-    if (range <= 0.f) {
-      throw std::runtime_error("Bucketrange must be greater than 0");
-    }
-
-    // Adjust min cost to be the start of a bucket
-    uint32_t c = static_cast<uint32_t>(mincost);
-    currentcost_ = (c - (c % bucketsize));
-    mincost_ = currentcost_;
-    bucketrange_ = range;
-    bucketsize_ = static_cast<float>(bucketsize);
-    inv_ = 1.0f / bucketsize_;
-
-    // Set the maximum cost (above this goes into the overflow bucket)
-    maxcost_ = mincost_ + bucketrange_;
-
-    // Allocate the low-level buckets
-    size_t bucketcount = (range / bucketsize_) + 1;
-    buckets_.resize(bucketcount);
+    init(mincost, range, bucketsize, labelcost);
+  }
 
-    // Set the current bucket to the lowest cost low level bucket
-    currentbucket_ = buckets_.begin();
+  /**
+   * Clear all labels and set up the queue for a new search with a new cost
+   * range. The memory held by the buckets is kept, so searches reusing a queue
+   * do not allocate it again.
+   * @param mincost    Minimum cost. Used to create the initial range for
+   *                   bucket sorting.
+   * @param range      Cost range for low-level buckets.
+   * @param bucketsize Bucket size (range of costs within same bucket).
+   *                   Must be an integer value.
+   * @param labelcost  Functor to get a cost given a label index.
+   */
+  void reuse(const float mincost,
+             const float range,
+             const uint32_t bucketsize,
+             const LabelCost& labelcost) {
+    clear();
+    init(mincost, range, bucketsize, labelcost);
+  }
 
-    // Set the cost function.
-    labelcost_ = labelcost;
+  /**
+   * Returns the memory (bytes) reserved by the buckets.
+   */
+  size_t reserved() const {
+    size_t bytes = buckets_.capacity() * sizeof(bucket_t) +
+                   overflowbucket_.capacity() * sizeof(uint32_t);
+    for (const auto& bucket : buckets_) {
+      bytes += bucket.capacity() * sizeof(uint32_t);
+    }
+    return bytes;
   }
 
   /**
@@ -173,6 +175,46 @@ private:
   // Cost function to get cost given the label index.
   LabelCost labelcost_;
 
+  /**
+   * Set the cost range and the cost function, allocating the low-level
+   * buckets if needed. The buckets must be empty.
+   */
+  void init(const float mincost,
+            const float range,
+            const uint32_t bucketsize,
+            const LabelCost& labelcost) {
+    // We need at least a bucketsize of 1 or more
+    if (bucketsize < 1) {
+      throw std::runtime_error("Bucketsize must be 1 or greater");
+    }
+
+    // We need at least a bucketrange of something larger than 0
+    if (range <= 0.f) {
+      throw std::runtime_error("Bucketrange must be greater than 0");
+    }
+
+    // Adjust min cost to be the start of a bucket
+    uint32_t c = static_cast<uint32_t>(mincost);
+    currentcost_ = (c - (c % bucketsize));
+    mincost_ = currentcost_;
+    bucketrange_ = range;
+    bucketsize_ = static_cast<float>(bucketsize);
+    inv_ = 1.0f / bucketsize_;
+
+    // Set the maximum cost (above this goes into the overflow bucket)
+    maxcost_ = mincost_ + bucketrange_;
+
+    // Allocate the low-level buckets
+    size_t bucketcount = (range / bucketsize_) + 1;
+    buckets_.resize(bucketcount);
+
+    // Set the current bucket to the lowest cost low level bucket
+    currentbucket_ = buckets_.begin();
+
+    // Set the cost function.
+    labelcost_ = labelcost;
+  }
+
   /**
    * Returns the bucket given the cost.
    * @param  cost  Cost.
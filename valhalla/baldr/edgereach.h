@@ -0,0 +1,82 @@
+#ifndef VALHALLA_BALDR_EDGEREACH_H_
+#define VALHALLA_BALDR_EDGEREACH_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include <valhalla/baldr/graphconstants.h>
+
+namespace valhalla {
+namespace baldr {
+
+// Access modes for which reach is computed at build time and stored per directed edge
+constexpr uint32_t kReachAccessModes[] = {kAutoAccess, kTruckAccess, kPedestrianAccess};
+constexpr size_t kReachModeCount = sizeof(kReachAccessModes) / sizeof(kReachAccessModes[0]);
+
+// Largest reach that can be stored (8 bits per direction)
+constexpr uint32_t kMaxStoredReach = 255;
+
+/**
+ * Inbound and outbound reach of a directed edge for each of the access modes in
+ * kReachAccessModes. Reach is the number of nodes which can be reached from (outbound)
+ * or can reach (inbound) the edge, capped at the max reachability used to build the
+ * tiles. The values are computed with the same conservative expansion loki uses to
+ * estimate reach at request time, so they are a lower bound on what loki would find.
+ */
+class EdgeReach {
+public:
+  /**
+   * Default constructor. No reach in any direction for any mode.
+   */
+  EdgeReach() : outbound_{}, inbound_{} {
+  }
+
+  /**
+   * Gets the index of an access mode within the stored modes.
+   * @param  access_mode  Access mode (e.g. kAutoAccess)
+   * @return Returns the index of the mode or kReachModeCount if reach is not stored for it.
+   */
+  static size_t mode_index(const uint32_t access_mode) {
+    return std::find(std::begin(kReachAccessModes), std::end(kReachAccessModes), access_mode) -
+           std::begin(kReachAccessModes);
+  }
+
+  /**
+   * Gets the outbound reach for the access mode at the given index.
+   * @param  mode  Index of the access mode within kReachAccessModes.
+   * @return Returns the outbound reach.
+   */
+  uint32_t outbound(const size_t mode) const {
+    return outbound_[mode];
+  }
+
+  /**
+   * Gets the inbound reach for the access mode at the given index.
+   * @param  mode  Index of the access mode within kReachAccessModes.
+   * @return Returns the inbound reach.
+   */
+  uint32_t inbound(const size_t mode) const {
+    return inbound_[mode];
+  }
+
+  /**
+   * Sets the reach for the access mode at the given index. Values above kMaxStoredReach
+   * are clamped.
+   * @param  mode      Index of the access mode within kReachAccessModes.
+   * @param  outbound  Outbound reach.
+   * @param  inbound   Inbound reach.
+   */
+  void set_reach(const size_t mode, const uint32_t outbound, const uint32_t inbound) {
+    outbound_[mode] = static_cast<uint8_t>(std::min(outbound, kMaxStoredReach));
+    inbound_[mode] = static_cast<uint8_t>(std::min(inbound, kMaxStoredReach));
+  }
+
+protected:
+  uint8_t outbound_[kReachModeCount];
+  uint8_t inbound_[kReachModeCount];
+};
+
+} // namespace baldr
+} // namespace valhalla
+
+#endif // VALHALLA_BALDR_EDGEREACH_H_
@@ -1,7 +1,9 @@
 #ifndef VALHALLA_BALDR_GRAPHREADER_H_
 #define VALHALLA_BALDR_GRAPHREADER_H_
 
+#include <condition_variable>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <unordered_map>
@@ -17,6 +19,22 @@
 namespace valhalla {
 namespace baldr {
 
+// Name of the entry holding the index of the tiles in a tile extract
+constexpr char kTileIndexName[] = "index.bin";
+
+/**
+ * An entry in the index of a tile extract. A tile extract is a tar of tiles and an indexed
+ * extract starts with a regular tar entry (so that plain tar tools still see every tile) holding
+ * these entries sorted by tile id. The index lets the extract be loaded without reading the
+ * header of every tile in it.
+ */
+struct tile_index_entry_t {
+  uint64_t offset;  // Offset of the tile data from the start of the extract
+  uint32_t tile_id; // Value of the GraphId of the tile
+  uint32_t size;    // Size of the tile data in bytes
+};
+static_assert(sizeof(tile_index_entry_t) == 16, "tile_index_entry_t must be 16 bytes");
+
 /**
  * Tile cache interface.
  */
@@ -309,6 +327,86 @@ private:
   std::mutex& mutex_ref_;
 };
 
+/**
+ * Tile cache shared by the graph readers of a group of threads, e.g. the actors of a pool. Readers
+ * hand out raw pointers to the cached tiles so no tile is freed while another thread may be using
+ * it: puts never evict, and a Trim or Clear while threads are between Acquire and Release is put
+ * off until the last of them releases the cache (threads acquiring it meanwhile wait for that).
+ * Unlike the global synchronized cache each group has its own, sized by its own configuration.
+ * It is thread-safe.
+ */
+class SharedTileCache : public TileCache {
+public:
+  /**
+   * Constructor.
+   * @param max_size  maximum size of the cache
+   */
+  explicit SharedTileCache(size_t max_size);
+
+  /**
+   * Reserves enough cache to hold (max_cache_size / tile_size) items.
+   * @param tile_size appeoximate size of one tile
+   */
+  void Reserve(size_t tile_size) override;
+
+  /**
+   * Checks if tile exists in the cache.
+   * @param graphid  the graphid of the tile
+   * @return true if tile exists in the cache
+   */
+  bool Contains(const GraphId& graphid) const override;
+
+  /**
+   * Puts a copy of a tile of into the cache.
+   * @param graphid  the graphid of the tile
+   * @param tile the graph tile
+   * @param size size of the tile in memory
+   */
+  const GraphTile* Put(const GraphId& graphid, const GraphTile& tile, size_t size) override;
+
+  /**
+   * Get a pointer to a graph tile object given a GraphId.
+   * @param graphid  the graphid of the tile
+   * @return GraphTile* a pointer to the graph tile
+   */
+  const GraphTile* Get(const GraphId& graphid) const override;
+
+  /**
+   * Lets you know if the cache is too large.
+   * @return true if the cache is over committed with respect to the limit
+   */
+  bool OverCommitted() const override;
+
+  /**
+   * Clears the cache, once no thread is using it.
+   */
+  void Clear() override;
+
+  /**
+   * Clears the cache, once no thread is using it.
+   */
+  void Trim() override;
+
+  /**
+   * Marks the start of the use of the cache by the calling thread. The tiles it gets stay valid
+   * until it calls Release. Waits for a pending Trim or Clear to be done first.
+   */
+  void Acquire();
+
+  /**
+   * Marks the end of the use of the cache by the calling thread. The last thread to release it
+   * does the pending Trim or Clear.
+   */
+  void Release();
+
+private:
+  SimpleTileCache cache_;
+  mutable std::mutex mutex_;
+  std::condition_variable released_;
+  size_t users_;      // Threads between Acquire and Release
+  bool trim_pending_; // Trim or Clear put off until there are no users
+};
+
 /**
  * Creates tile caches.
  */
@@ -321,6 +419,12 @@ public:
    * @param pt  Property tree listing the configuration for the cahce configuration
    */
   static TileCache* createTileCache(const boost::property_tree::ptree& pt);
+
+  /**
+   * Constructs a tile cache for the readers of a group of threads to share.
+   * @param pt  Property tree listing the configuration for the cache, only its size is used
+   */
+  static SharedTileCache* createSharedTileCache(const boost::property_tree::ptree& pt);
 };
 
 /**
@@ -335,6 +439,13 @@ public:
    */
   GraphReader(const boost::property_tree::ptree& pt);
 
+  /**
+   * Constructor using a tile cache it may share with other readers.
+   * @param pt     Property tree listing the configuration for the tile storage.
+   * @param cache  Tile cache to use instead of the one the configuration describes.
+   */
+  GraphReader(const boost::property_tree::ptree& pt, const std::shared_ptr<TileCache>& cache);
+
   /**
    * Test if tile exists
    * @param  graphid  GraphId of the tile to test (tile id and level).
@@ -385,6 +496,16 @@ public:
     return GetGraphTile(pointll, TileHierarchy::levels().rbegin()->second.level);
   }
 
+  /**
+   * Get the decoded shape of the edges in a bin of a tile. The segments are built the
+   * first time a bin is requested and are then kept with the tile in the cache. Their
+   * memory is not counted towards max_cache_size.
+   * @param  tile  the tile containing the bin
+   * @param  bin   the bin's index in the row major array
+   * @return the segments of the bin or nullptr if mjolnir.cache_bin_segments is not enabled
+   */
+  std::shared_ptr<const BinSegments> GetBinSegments(const GraphTile* tile, size_t bin);
+
   /**
    * Clears the cache
    */
@@ -754,7 +875,10 @@ protected:
   std::mutex _404s_lock;
   std::unordered_set<GraphId> _404s;
 
-  std::unique_ptr<TileCache> cache_;
+  std::shared_ptr<TileCache> cache_;
+
+  // Whether to keep the decoded shape of the edges in each bin with the tiles
+  const bool cache_bin_segments_;
 };
 
 } // namespace baldr
@@ -4,14 +4,17 @@
 #include "filesystem.h"
 #include <valhalla/baldr/accessrestriction.h>
 #include <valhalla/baldr/admininfo.h>
+#include <valhalla/baldr/binsegments.h>
 #include <valhalla/baldr/complexrestriction.h>
 #include <valhalla/baldr/curler.h>
 #include <valhalla/baldr/datetime.h>
 #include <valhalla/baldr/directededge.h>
 #include <valhalla/baldr/edgeinfo.h>
+#include <valhalla/baldr/edgereach.h>
 #include <valhalla/baldr/graphconstants.h>
 #include <valhalla/baldr/graphid.h>
 #include <valhalla/baldr/graphtileheader.h>
+#include <valhalla/baldr/nodecomponent.h>
 #include <valhalla/baldr/laneconnectivity.h>
 #include <valhalla/baldr/nodeinfo.h>
 #include <valhalla/baldr/nodetransition.h>
@@ -28,6 +31,7 @@
 #include <valhalla/midgard/logging.h>
 #include <valhalla/midgard/util.h>
 
+#include <array>
 #include <cstdint>
 #include <memory>
 
@@ -465,6 +469,25 @@ public:
    */
   midgard::iterable_t<GraphId> GetBin(size_t index) const;
 
+  /**
+   * Get the decoded segments of a bin if they were previously set on this tile.
+   * Safe to call while another thread sets them.
+   * @param  index the bin's index in the row major array
+   * @return the segments of the bin or nullptr if they have not been set
+   */
+  std::shared_ptr<const BinSegments> bin_segments(size_t index) const {
+    auto bins = std::atomic_load(&bin_segments_);
+    return bins ? std::atomic_load(&(*bins)[index]) : nullptr;
+  }
+
+  /**
+   * Keep the decoded segments of a bin with this tile. The segments are not part
+   * of the tile data, they are built by the GraphReader on demand.
+   * @param  index     the bin's index in the row major array
+   * @param  segments  the segments of the bin
+   */
+  void set_bin_segments(size_t index, std::shared_ptr<const BinSegments> segments) const;
+
   /**
    * Get lane connections ending on this edge.
    * @param  idx  GraphId of the directed edge.
@@ -472,6 +495,34 @@ public:
    */
   std::vector<LaneConnectivity> GetLaneConnectivity(const uint32_t idx) const;
 
+  /**
+   * Get the reach of a directed edge that was computed when the tile was built.
+   * @param  idx  Index of the directed edge within the tile.
+   * @return  Returns a pointer to the reach of the edge or nullptr if the tile
+   *          does not have reach data.
+   */
+  const EdgeReach* edge_reach(const size_t idx) const {
+    if (edge_reach_ == nullptr) {
+      return nullptr;
+    }
+    if (idx < header_->directededgecount()) {
+      return &edge_reach_[idx];
+    }
+    throw std::runtime_error(
+        "GraphTile EdgeReach index out of bounds: " + std::to_string(header_->graphid().tileid()) +
+        "," + std::to_string(header_->graphid().level()) + "," + std::to_string(idx) +
+        " directededgecount= " + std::to_string(header_->directededgecount()));
+  }
+
+  /**
+   * Get the connected component of a node that was computed when the tile was built.
+   * @param  idx   Index of the node within the tile.
+   * @param  mode  Index of the access mode within kComponentAccessModes.
+   * @return  Returns a pointer to the component of the node or nullptr if the tile does
+   *          not have components. Nodes which are not stored are in the main component.
+   */
+  const NodeComponent* node_component(const uint32_t idx, const size_t mode) const;
+
   /**
    * Convenience method to get the speed for an edge given the directed
    * edge and a time (seconds since start of the week).
@@ -655,6 +706,20 @@ protected:
   // Predicted speeds
   PredictedSpeeds predictedspeeds_;
 
+  // Reach computed at build time (indexed by directed edge index)
+  EdgeReach* edge_reach_;
+
+  // Components computed at build time of the nodes outside of the main component (sorted by
+  // node and mode)
+  NodeComponent* node_components_;
+  size_t node_component_count_;
+
+  // Decoded shape of the edges in each bin, built lazily for edge correlation. The array is
+  // only allocated once a bin is set so tiles which are never searched dont pay for it. It is
+  // shared rather than unique because the tile cache keeps copies of tiles.
+  using BinSegmentsArray = std::array<std::shared_ptr<const BinSegments>, kBinCount>;
+  mutable std::shared_ptr<BinSegmentsArray> bin_segments_;
+
   // Map of stop one stops in this tile.
   std::unordered_map<std::string, GraphId> stop_one_stops;
 
@@ -16,7 +16,7 @@ namespace baldr {
 // something to the tile simply subtract one from this number and add it
 // just before the empty_slots_ array below. NOTE that it can ONLY be an
 // offset in bytes and NOT a bitfield or union or anything of that sort
-constexpr size_t kEmptySlots = 11;
+constexpr size_t kEmptySlots = 9;
 
 // Maximum size of the version string (stored as a fixed size
 // character array so the GraphTileHeader size remains fixed).
@@ -566,6 +566,42 @@ public:
     predictedspeeds_offset_ = offset;
   }
 
+  /**
+   * Gets the offset to the precomputed edge reach. The reach data is at the end of the tile
+   * (only followed by node components) and there is one record per directed edge. An offset
+   * of 0 means there is no reach data.
+   * @return  Returns the offset (bytes) to the edge reach data.
+   */
+  uint32_t reach_offset() const {
+    return reach_offset_;
+  }
+
+  /**
+   * Sets the offset to the precomputed edge reach within the tile.
+   * @param offset Offset to the edge reach data within the tile (0 if there is none).
+   */
+  void set_reach_offset(const uint32_t offset) {
+    reach_offset_ = offset;
+  }
+
+  /**
+   * Gets the offset to the precomputed node components. The components follow the edge reach
+   * (if any) at the end of the tile and only the nodes outside of the main component of a mode
+   * are stored. An offset of 0 means there are no components.
+   * @return  Returns the offset (bytes) to the node components.
+   */
+  uint32_t component_offset() const {
+    return component_offset_;
+  }
+
+  /**
+   * Sets the offset to the precomputed node components within the tile.
+   * @param offset Offset to the node components within the tile (0 if there are none).
+   */
+  void set_component_offset(const uint32_t offset) {
+    component_offset_ = offset;
+  }
+
   /**
    * Get the offset to the end of the tile
    * @return the number of bytes in the tile, unless the last slot is used
@@ -679,6 +715,12 @@ protected:
   // GraphTile data size in bytes
   uint32_t tile_size_;
 
+  // Offset to the beginning of the precomputed edge reach data
+  uint32_t reach_offset_;
+
+  // Offset to the beginning of the precomputed node components
+  uint32_t component_offset_;
+
   // Marks the end of this version of the tile with the rest of the slots
   // being available for growth. If you want to use one of the empty slots,
   // simply add a uint32_t some_offset_; just above empty_slots_ and decrease
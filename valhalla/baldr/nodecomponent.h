@@ -0,0 +1,168 @@
+#ifndef VALHALLA_BALDR_NODECOMPONENT_H_
+#define VALHALLA_BALDR_NODECOMPONENT_H_
+
+#include <algorithm>
+#include <cstdint>
+
+#include <valhalla/baldr/graphconstants.h>
+
+namespace valhalla {
+namespace baldr {
+
+// Access modes for which connected components are computed at build time and stored per node
+constexpr uint32_t kComponentAccessModes[] = {kAutoAccess, kTruckAccess, kBicycleAccess,
+                                              kPedestrianAccess};
+constexpr size_t kComponentModeCount =
+    sizeof(kComponentAccessModes) / sizeof(kComponentAccessModes[0]);
+
+// Component and island of the nodes in the largest strongly connected component of a mode
+constexpr uint32_t kMainComponent = 0;
+
+/**
+ * Connected component of a node for one of the access modes in kComponentAccessModes. The
+ * graph of a mode has an arc along every edge the mode can take, starting at every node the
+ * mode can pass. Nodes in the same (strongly connected) component can all reach each other
+ * and nodes on different islands (weakly connected components) can never reach each other.
+ * Most nodes are in the largest component, the main component, so the tiles only store the
+ * nodes that are not, together with whether they can reach or be reached from the main one.
+ */
+class NodeComponent {
+public:
+  /**
+   * Default constructor. A node in the main component.
+   */
+  NodeComponent()
+      : node_(0), mode_(0), reaches_main_(1), reached_from_main_(1), spare_(0),
+        component_(kMainComponent), island_(kMainComponent) {
+  }
+
+  /**
+   * Constructor.
+   * @param  node               Index of the node within its tile.
+   * @param  mode               Index of the access mode within kComponentAccessModes.
+   * @param  component          Strongly connected component of the node.
+   * @param  island             Weakly connected component of the node.
+   * @param  reaches_main       Can the node reach the main component.
+   * @param  reached_from_main  Can the node be reached from the main component.
+   */
+  NodeComponent(const uint32_t node,
+                const size_t mode,
+                const uint32_t component = kMainComponent,
+                const uint32_t island = kMainComponent,
+                const bool reaches_main = true,
+                const bool reached_from_main = true)
+      : node_(node), mode_(mode), reaches_main_(reaches_main),
+        reached_from_main_(reached_from_main), spare_(0), component_(component), island_(island) {
+  }
+
+  /**
+   * Gets the index of an access mode within the stored modes.
+   * @param  access_mode  Access mode (e.g. kAutoAccess)
+   * @return Returns the index of the mode or kComponentModeCount if components are not
+   *         stored for it.
+   */
+  static size_t mode_index(const uint32_t access_mode) {
+    return std::find(std::begin(kComponentAccessModes), std::end(kComponentAccessModes),
+                     access_mode) -
+           std::begin(kComponentAccessModes);
+  }
+
+  /**
+   * Gets the component of the nodes which are not stored in a tile.
+   * @return Returns the main component.
+   */
+  static const NodeComponent& main() {
+    static const NodeComponent main_component;
+    return main_component;
+  }
+
+  /**
+   * Can there be a path from a node in one component to a node in another. This is only
+   * false when there certainly is no path: the nodes are on different islands or one of
+   * them is in the main component and the other one cannot reach or be reached from it.
+   * @param  from  Component of the node the path leaves from.
+   * @param  to    Component of the node the path arrives at.
+   * @return Returns false if there is no path.
+   */
+  static bool Connected(const NodeComponent& from, const NodeComponent& to) {
+    if (from.component_ == to.component_ || (from.reaches_main_ && to.reached_from_main_)) {
+      return true;
+    }
+    if (from.island_ != to.island_ || from.component_ == kMainComponent ||
+        to.component_ == kMainComponent) {
+      return false;
+    }
+    // two small components on the same island may still be connected to each other
+    return true;
+  }
+
+  /**
+   * Gets the index of the node within its tile.
+   * @return Returns the node index.
+   */
+  uint32_t node() const {
+    return node_;
+  }
+
+  /**
+   * Gets the index of the access mode within kComponentAccessModes.
+   * @return Returns the mode index.
+   */
+  size_t mode() const {
+    return mode_;
+  }
+
+  /**
+   * Gets the strongly connected component of the node, kMainComponent for the main one.
+   * @return Returns the component.
+   */
+  uint32_t component() const {
+    return component_;
+  }
+
+  /**
+   * Gets the weakly connected component of the node, kMainComponent for the one with the
+   * main component.
+   * @return Returns the island.
+   */
+  uint32_t island() const {
+    return island_;
+  }
+
+  /**
+   * Can the node reach the main component.
+   * @return Returns true if there is a path from the node to the main component.
+   */
+  bool reaches_main() const {
+    return reaches_main_;
+  }
+
+  /**
+   * Can the node be reached from the main component.
+   * @return Returns true if there is a path from the main component to the node.
+   */
+  bool reached_from_main() const {
+    return reached_from_main_;
+  }
+
+  /**
+   * Components are sorted by node and then by mode within a tile.
+   */
+  bool operator<(const NodeComponent& other) const {
+    return node_ < other.node_ || (node_ == other.node_ && mode_ < other.mode_);
+  }
+
+protected:
+  uint32_t node_ : 21;
+  uint32_t mode_ : 3;
+  uint32_t reaches_main_ : 1;
+  uint32_t reached_from_main_ : 1;
+  uint32_t spare_ : 6;
+  uint32_t component_;
+  uint32_t island_;
+};
+
+} // namespace baldr
+} // namespace valhalla
+
+#endif // VALHALLA_BALDR_NODECOMPONENT_H_
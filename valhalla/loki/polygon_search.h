@@ -0,0 +1,52 @@
+#ifndef VALHALLA_LOKI_POLYGON_SEARCH_H_
+#define VALHALLA_LOKI_POLYGON_SEARCH_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <valhalla/baldr/graphid.h>
+#include <valhalla/baldr/graphreader.h>
+#include <valhalla/proto/options.pb.h>
+
+namespace valhalla {
+namespace loki {
+
+/**
+ * Find the edges intersecting a set of polygons. The polygons are rasterized against the bins
+ * of the tiles: all of the edges in a bin entirely inside a polygon are taken without looking at
+ * their shape, only the edges in bins crossed by the boundary of a polygon are tested against the
+ * parts of the boundary crossing the bin. Both directions of the edges are returned along with any
+ * shortcuts containing them.
+ *
+ * @param rings   the outer rings of the polygons, closing the rings is optional
+ * @param reader  an object used to access tiled route data
+ * @return the ids of the edges intersecting any of the polygons
+ */
+std::unordered_set<baldr::GraphId>
+edges_in_rings(const google::protobuf::RepeatedPtrField<valhalla::Ring>& rings,
+               baldr::GraphReader& reader);
+
+/**
+ * Group a set of edges into one bitset per tile, bit i of byte j being the edge with id 8 * j + i,
+ * as the edges to avoid are passed from loki to the path algorithms (see Options::avoid_tiles).
+ *
+ * @param edges  the ids of the edges
+ * @return the bitset of each tile (keyed by the tile base id)
+ */
+std::unordered_map<baldr::GraphId, std::string>
+edge_bitsets(const std::unordered_set<baldr::GraphId>& edges);
+
+/**
+ * Get the total length of the rings of a set of polygons.
+ *
+ * @param rings   the outer rings of the polygons
+ * @return the length in meters
+ */
+float rings_length(const google::protobuf::RepeatedPtrField<valhalla::Ring>& rings);
+
+} // namespace loki
+} // namespace valhalla
+
+#endif // VALHALLA_LOKI_POLYGON_SEARCH_H_
@@ -0,0 +1,138 @@
+#ifndef VALHALLA_LOKI_SEARCH_CACHE_H_
+#define VALHALLA_LOKI_SEARCH_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <valhalla/baldr/graphreader.h>
+#include <valhalla/baldr/location.h>
+#include <valhalla/baldr/pathlocation.h>
+#include <valhalla/proto/options.pb.h>
+#include <valhalla/sif/dynamiccost.h>
+
+namespace valhalla {
+namespace loki {
+
+/**
+ * A memory bounded, least recently used cache of the edge candidates found for locations. It is
+ * safe to use from many threads at once so the loki workers of a process share one per tile set.
+ *
+ * Entries are keyed by the location's coordinates and every other input that changes what
+ * Search finds for it, the costing and its options, and the dataset id of the tile containing
+ * the location. Loading a new set of tiles changes the dataset id so the old entries are never
+ * returned again and are evicted as new ones are added.
+ */
+class search_cache_t {
+public:
+  /**
+   * Constructor
+   * @param max_size  the number of bytes the entries may use
+   */
+  explicit search_cache_t(size_t max_size);
+
+  /**
+   * Get the cache for a tile set, every worker reading the same tiles shares one
+   * @param tile_source  identifies the tile set, see baldr::cache_tile_source
+   * @param max_size     the number of bytes the entries may use
+   * @return the shared cache
+   */
+  static std::shared_ptr<search_cache_t> shared(const std::string& tile_source, size_t max_size);
+
+  /**
+   * Get the part of the key that identifies the costing of a request
+   * @param options  the request options
+   * @return the costing key or an empty string if the request has avoids, which are
+   *         specific to the request and make its candidates uncacheable
+   */
+  static std::string costing_key(const Options& options);
+
+  /**
+   * Same as loki::Search but the candidates of locations found in the cache are returned
+   * directly and only the remaining locations are searched, in a single call, and then cached.
+   *
+   * @param locations    the positions which need to be correlated to the route network
+   * @param reader       an object used to access tiled route data
+   * @param costing      the costing used to filter the edges
+   * @param costing_key  the key of the costing, see costing_key()
+   * @return the correlated locations, a location without candidates has no entry
+   */
+  std::unordered_map<baldr::Location, baldr::PathLocation>
+  search(const std::vector<baldr::Location>& locations,
+         baldr::GraphReader& reader,
+         const std::shared_ptr<sif::DynamicCost>& costing,
+         const std::string& costing_key);
+
+  /**
+   * Get the number of bytes used by the entries
+   * @return the number of bytes
+   */
+  size_t size() const;
+
+  /**
+   * Get the number of cacheable locations whose candidates were found in the cache
+   * @return the number of hits
+   */
+  uint64_t hits() const;
+
+  /**
+   * Get the number of cacheable locations that had to be searched
+   * @return the number of misses
+   */
+  uint64_t misses() const;
+
+protected:
+  struct key_t {
+    float lng;
+    float lat;
+    baldr::Location::StopType stop_type;
+    baldr::Location::PreferredSide preferred_side;
+    bool has_heading;
+    float heading;
+    float heading_tolerance;
+    float node_snap_tolerance;
+    float street_side_tolerance;
+    float search_cutoff;
+    unsigned int min_outbound_reach;
+    unsigned int min_inbound_reach;
+    unsigned long radius;
+    uint64_t dataset_id;
+    std::string costing;
+
+    bool operator==(const key_t& other) const;
+  };
+
+  struct key_hash_t {
+    size_t operator()(const key_t& key) const;
+  };
+
+  struct entry_t {
+    key_t key;
+    std::vector<baldr::PathLocation::PathEdge> edges;
+    std::vector<baldr::PathLocation::PathEdge> filtered_edges;
+    size_t size;
+  };
+
+  // get the entry for a key, marking it as the most recently used
+  bool get(const key_t& key, baldr::PathLocation& correlated);
+
+  // add an entry evicting the least recently used ones if over budget
+  void put(entry_t&& entry);
+
+  mutable std::mutex lock;
+  size_t max_size;
+  size_t cur_size;
+  uint64_t hit_count;
+  uint64_t miss_count;
+  std::list<entry_t> entries;
+  std::unordered_map<key_t, std::list<entry_t>::iterator, key_hash_t> index;
+};
+
+} // namespace loki
+} // namespace valhalla
+
+#endif // VALHALLA_LOKI_SEARCH_CACHE_H_
@@ -11,6 +11,7 @@
 #include <valhalla/baldr/location.h>
 #include <valhalla/baldr/pathlocation.h>
 #include <valhalla/baldr/rapidjson_utils.h>
+#include <valhalla/loki/search_cache.h>
 #include <valhalla/midgard/pointll.h>
 #include <valhalla/proto/options.pb.h>
 #include <valhalla/sif/costfactory.h>
@@ -51,6 +52,16 @@ protected:
   void parse_trace(Api& request);
   void parse_costing(Api& request, bool allow_none = false);
   void locations_from_shape(Api& request);
+  std::unordered_map<baldr::Location, baldr::PathLocation>
+  search(const std::vector<baldr::Location>& locations, const Options& options);
+  /**
+   * Can there be a path between two correlated locations for the current costing. This is
+   * only false when the node components stored in the tiles prove that there is none.
+   * @param  from  Correlated location the path leaves from.
+   * @param  to    Correlated location the path arrives at.
+   * @return Returns false if the locations cannot be connected.
+   */
+  bool connected(const valhalla::Location& from, const valhalla::Location& to);
 
   void init_locate(Api& request);
   void init_route(Api& request);
@@ -63,14 +74,18 @@ protected:
   boost::property_tree::ptree config;
   sif::CostFactory<sif::DynamicCost> factory;
   sif::cost_ptr_t costing;
+  // index of the access mode of the costing in baldr::kComponentAccessModes, if it is stored
+  size_t component_mode;
   std::shared_ptr<baldr::GraphReader> reader;
   std::shared_ptr<baldr::connectivity_map_t> connectivity_map;
+  std::shared_ptr<search_cache_t> search_cache;
   std::string action_str;
   std::unordered_map<std::string, size_t> max_locations;
   std::unordered_map<std::string, float> max_distance;
   std::unordered_map<std::string, float> max_matrix_distance;
   std::unordered_map<std::string, float> max_matrix_locations;
   size_t max_avoid_locations;
+  float max_avoid_polygons_length;
   unsigned int max_reachability;
   unsigned int default_reachability;
   unsigned int max_radius;
@@ -4,6 +4,7 @@
 #include <valhalla/midgard/shape_decoder.h>
 
 #include <cmath>
+#include <cstdint>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -163,6 +164,81 @@ template <class container_t> std::string encode7(const container_t& points) {
   return output;
 }
 
+/**
+ * Delta encode a container of points as fixed point integers with 6 digits of precision, the
+ * longitude and then the latitude of each point relative to the previous point. These are the
+ * integers a polyline6 string is made of so the deltas can be turned into a polyline or back
+ * into points without decoding any text, see delta_decode and delta_to_polyline.
+ *
+ * @param points  the list of points to encode
+ * @param out     output iterator receiving two integers per point
+ * @return        the output iterator past the last integer written
+ */
+template <class container_t, class output_t>
+output_t delta_encode(const container_t& points, output_t out) {
+  int last_lon = 0, last_lat = 0;
+  for (const auto& p : points) {
+    // same truncation as encode so the polyline we make from these matches it exactly
+    int lon = static_cast<int>(floor(static_cast<double>(p.first) * 1e6));
+    int lat = static_cast<int>(floor(static_cast<double>(p.second) * 1e6));
+    *out++ = lon - last_lon;
+    *out++ = lat - last_lat;
+    last_lon = lon;
+    last_lat = lat;
+  }
+  return out;
+}
+
+/**
+ * Decode delta encoded points, see delta_encode, into a container of points. The points are
+ * the same as the ones decoding the equivalent polyline would give.
+ *
+ * @param deltas  the longitude and latitude deltas of each point
+ * @return        the container of points
+ */
+template <class container_t, class deltas_t> container_t delta_decode(const deltas_t& deltas) {
+  container_t c;
+  c.reserve(deltas.size() / 2);
+  int32_t lon = 0, lat = 0;
+  for (auto delta = deltas.begin(); delta + 1 < deltas.end(); delta += 2) {
+    lon += *delta;
+    lat += *(delta + 1);
+    c.emplace_back(double(lon) * 1e-6, double(lat) * 1e-6);
+  }
+  return c;
+}
+
+/**
+ * Polyline encode delta encoded points, see delta_encode, into a string with 6 digits of
+ * precision. This is the same string as encoding the original points would give.
+ *
+ * @param deltas  the longitude and latitude deltas of each point
+ * @return string the encoded points
+ */
+template <class deltas_t> std::string delta_to_polyline(const deltas_t& deltas) {
+  std::string output;
+  output.reserve(deltas.size() * 4);
+
+  // handy lambda to turn an integer into an encoded string
+  auto serialize = [&output](int number) {
+    number = number < 0 ? ~(number << 1) : (number << 1);
+    while (number >= 0x20) {
+      int nextValue = (0x20 | (number & 0x1f)) + 63;
+      output.push_back(static_cast<char>(nextValue));
+      number >>= 5;
+    }
+    number += 63;
+    output.push_back(static_cast<char>(number));
+  };
+
+  // the polyline has the latitude first
+  for (auto delta = deltas.begin(); delta + 1 < deltas.end(); delta += 2) {
+    serialize(*(delta + 1));
+    serialize(*delta);
+  }
+  return output;
+}
+
 } // namespace midgard
 } // namespace valhalla
 
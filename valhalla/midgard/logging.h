@@ -38,6 +38,12 @@ public:
   virtual ~Logger();
   virtual void Log(const std::string&, const LogLevel);
   virtual void Log(const std::string&, const std::string& custom_directive = " [TRACE] ");
+  // the file and line are only formatted into the message if and when it is written
+  virtual void Log(const std::string&, const LogLevel, const char* file, const int line);
+  // writes one or more lines which are already formatted, each ending in a newline
+  virtual void Write(const std::string& lines);
+  // the directive written between the time stamp and the message of a level
+  virtual const std::string& Directive(const LogLevel) const;
 
 protected:
   std::mutex lock;
@@ -54,6 +60,9 @@ void Log(const std::string&, const std::string& custom_directive = " [TRACE] ");
 // try something like:
 // logging::Configure({ {"type", "std_out"}, {"color", ""} })
 // logging::Configure({ {"type", "file"}, {"file_name", "test.log"}, {"reopen_interval", "1"} })
+// any type of logger can be made asynchronous, the lines are then queued in a lock-free ring
+// buffer and formatted and written by a background thread, dropping them when it is full:
+// logging::Configure({ {"type", "std_out"}, {"async", "true"}, {"queue_size", "8192"} })
 void Configure(const LoggingConfig& config);
 
 // guarding against redefinitions
@@ -123,9 +132,8 @@ void Configure(const LoggingConfig& config);
 #define LOG_ERROR(x)                                                                                 \
   ::valhalla::midgard::logging::GetLogger().Log(x, ::valhalla::midgard::logging::LogLevel::ERROR)
 #define LOGLN_ERROR(x)                                                                               \
-  ::valhalla::midgard::logging::GetLogger().Log(std::string(__FILE__) + ": " +                       \
-                                                    std::to_string(__LINE__) + ": " + x,             \
-                                                ::valhalla::midgard::logging::LogLevel::ERROR)
+  ::valhalla::midgard::logging::GetLogger().Log(x, ::valhalla::midgard::logging::LogLevel::ERROR,    \
+                                                __FILE__, __LINE__)
 #else
 #define LOG_ERROR(x)
 #define LOGLN_ERROR(x)
@@ -134,9 +142,8 @@ void Configure(const LoggingConfig& config);
 #define LOG_WARN(x)                                                                                  \
   ::valhalla::midgard::logging::GetLogger().Log(x, ::valhalla::midgard::logging::LogLevel::WARN)
 #define LOGLN_WARN(x)                                                                                \
-  ::valhalla::midgard::logging::GetLogger().Log(std::string(__FILE__) + ":" +                        \
-                                                    std::to_string(__LINE__) + ": " + x,             \
-                                                ::valhalla::midgard::logging::LogLevel::WARN)
+  ::valhalla::midgard::logging::GetLogger().Log(x, ::valhalla::midgard::logging::LogLevel::WARN,     \
+                                                __FILE__, __LINE__)
 #else
 #define LOG_WARN(x)
 #define LOGLN_WARN(x)
@@ -145,9 +152,8 @@ void Configure(const LoggingConfig& config);
 #define LOG_INFO(x)                                                                                  \
   ::valhalla::midgard::logging::GetLogger().Log(x, ::valhalla::midgard::logging::LogLevel::INFO)
 #define LOGLN_INFO(x)                                                                                \
-  ::valhalla::midgard::logging::GetLogger().Log(std::string(__FILE__) + ":" +                        \
-                                                    std::to_string(__LINE__) + ": " + x,             \
-                                                ::valhalla::midgard::logging::LogLevel::INFO)
+  ::valhalla::midgard::logging::GetLogger().Log(x, ::valhalla::midgard::logging::LogLevel::INFO,     \
+                                                __FILE__, __LINE__)
 #else
 #define LOG_INFO(x) ;
 #define LOGLN_INFO(x) ;
@@ -160,9 +166,8 @@ void Configure(const LoggingConfig& config);
 #endif
 #ifdef LOGGING_LEVEL_TRACE
 #define LOG_TRACE(x)                                                                                 \
-  ::valhalla::midgard::logging::GetLogger().Log(std::string(__FILE__) + ":" +                        \
-                                                    std::to_string(__LINE__) + ": " + x,             \
-                                                ::valhalla::midgard::logging::LogLevel::TRACE)
+  ::valhalla::midgard::logging::GetLogger().Log(x, ::valhalla::midgard::logging::LogLevel::TRACE,    \
+                                                __FILE__, __LINE__)
 #else
 #define LOG_TRACE(x)
 #endif
@@ -0,0 +1,212 @@
+#ifndef VALHALLA_MIDGARD_METRICS_H_
+#define VALHALLA_MIDGARD_METRICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace valhalla {
+namespace midgard {
+
+namespace metrics {
+
+// label names and values of a series, e.g. {{"action", "route"}, {"costing", "auto"}}
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * A count that only goes up, e.g. the number of requests.
+ */
+class Counter {
+public:
+  Counter() : value_(0) {
+  }
+
+  /**
+   * Add to the count.
+   * @param  n  Amount to add.
+   */
+  void Increment(const uint64_t n = 1) {
+    value_.fetch_add(n, std::memory_order_relaxed);
+  }
+
+  /**
+   * Gets the count.
+   * @return Returns the count.
+   */
+  uint64_t value() const {
+    return value_.load(std::memory_order_relaxed);
+  }
+
+protected:
+  std::atomic<uint64_t> value_;
+};
+
+/**
+ * Distribution of observed values, e.g. latencies, counted in buckets with fixed upper bounds.
+ */
+class Histogram {
+public:
+  /**
+   * Constructor.
+   * @param  bounds  Upper bounds of the buckets, ascending. Values above the last one are only
+   *                 counted in the total.
+   */
+  explicit Histogram(const std::vector<double>& bounds);
+
+  /**
+   * Count a value in its bucket.
+   * @param  value  Observed value.
+   */
+  void Observe(const double value);
+
+  /**
+   * Gets the upper bounds of the buckets.
+   * @return Returns the bounds.
+   */
+  const std::vector<double>& bounds() const {
+    return bounds_;
+  }
+
+  /**
+   * Gets the number of values in a bucket, not including the ones of the buckets before it.
+   * @param  bucket  Index of the bucket.
+   * @return Returns the count.
+   */
+  uint64_t bucket(const size_t bucket) const {
+    return buckets_[bucket].load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Gets the number of observed values.
+   * @return Returns the count.
+   */
+  uint64_t count() const {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Gets the sum of the observed values.
+   * @return Returns the sum.
+   */
+  double sum() const {
+    return sum_.load(std::memory_order_relaxed);
+  }
+
+protected:
+  std::vector<double> bounds_;
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+  std::atomic<uint64_t> count_;
+  std::atomic<double> sum_;
+};
+
+// Default histogram bounds, latencies in milliseconds and sizes (locations, distances in km etc.)
+extern const std::vector<double> kLatencyBounds;
+extern const std::vector<double> kSizeBounds;
+
+/**
+ * The values of the series at one point in time, keyed the way they are written, e.g.
+ * name{action="route"}. When the stages of a service run in separate processes the snapshots of
+ * each of them are merged into one before they are written.
+ */
+struct Snapshot {
+  struct HistogramValues {
+    std::vector<double> bounds;
+    std::vector<uint64_t> buckets; // Not cumulative, the last one is above the bounds
+    uint64_t count;
+    double sum;
+  };
+
+  /**
+   * Adds the series of another snapshot, summing the ones both have. A histogram with other
+   * bounds than the one here keeps the values here.
+   * @param  other  The snapshot to add.
+   */
+  void Merge(const Snapshot& other);
+
+  /**
+   * Writes all of the series in the Prometheus text format.
+   * @return Returns the text.
+   */
+  std::string Serialize() const;
+
+  std::map<std::string, uint64_t> counters;
+  std::map<std::string, HistogramValues> histograms;
+};
+
+/**
+ * The counters and histograms of the process. Series are made the first time they are used and
+ * live as long as the process. Each thread remembers where the series it used are so after that
+ * updating one is a lookup in a thread local map and an atomic add, without any locking.
+ */
+class Registry {
+public:
+  /**
+   * Gets the registry of the process.
+   * @return Returns the registry.
+   */
+  static Registry& Get();
+
+  /**
+   * Gets a counter, making it if it did not exist.
+   * @param  name    Name of the metric.
+   * @param  labels  Labels of the series.
+   * @return Returns the counter.
+   */
+  Counter& counter(const std::string& name, const Labels& labels = {});
+
+  /**
+   * Gets a histogram, making it if it did not exist.
+   * @param  name    Name of the metric.
+   * @param  labels  Labels of the series.
+   * @param  bounds  Upper bounds of the buckets if the histogram is made.
+   * @return Returns the histogram.
+   */
+  Histogram& histogram(const std::string& name,
+                       const Labels& labels = {},
+                       const std::vector<double>& bounds = kLatencyBounds);
+
+  /**
+   * Gets the current values of all of the series.
+   * @return Returns the snapshot.
+   */
+  Snapshot GetSnapshot() const;
+
+  /**
+   * Writes all of the series in the Prometheus text format.
+   * @return Returns the text.
+   */
+  std::string Serialize() const {
+    return GetSnapshot().Serialize();
+  }
+
+protected:
+  Registry() = default;
+
+  // name and labels formatted the way they are written, e.g. name{action="route"}
+  static std::string Key(const std::string& name, const Labels& labels);
+
+  mutable std::mutex lock_;
+  std::map<std::string, std::unique_ptr<Counter>> counters_;
+  std::map<std::string, std::unique_ptr<Histogram>> histograms_;
+};
+
+// statically count without getting the registry first
+void Increment(const std::string& name, const Labels& labels = {}, const uint64_t n = 1);
+
+// statically observe a value without getting the registry first
+void Observe(const std::string& name,
+             const double value,
+             const Labels& labels = {},
+             const std::vector<double>& bounds = kLatencyBounds);
+
+} // namespace metrics
+
+} // namespace midgard
+} // namespace valhalla
+
+#endif // VALHALLA_MIDGARD_METRICS_H_
@@ -572,9 +572,49 @@ struct tar {
       uint64_t rsum = octal_to_int(chksum);
       return rsum == usum || rsum == sum;
     }
+    // write a number as zero padded octal digits followed by a NUL
+    static void int_to_octal(uint64_t value, char* data, size_t size) {
+      data[--size] = '\0';
+      while (size > 0) {
+        data[--size] = static_cast<char>('0' + (value & 7));
+        value >>= 3;
+      }
+    }
+    // make the ustar header of a regular file
+    static header_t create(const std::string& name, uint64_t size, uint64_t mtime = 0) {
+      if (name.size() >= sizeof(header_t::name)) {
+        throw std::runtime_error("Tar entry name too long: " + name);
+      }
+      header_t h{};
+      memcpy(h.name, name.data(), name.size());
+      int_to_octal(0644, h.mode, sizeof(h.mode));
+      int_to_octal(0, h.uid, sizeof(h.uid));
+      int_to_octal(0, h.gid, sizeof(h.gid));
+      int_to_octal(size, h.size, sizeof(h.size));
+      int_to_octal(mtime, h.mtime, sizeof(h.mtime));
+      h.typeflag = '0';
+      memcpy(h.magic, "ustar", 6);
+      memcpy(h.version, "00", 2);
+      // the checksum is computed with the checksum field blank
+      memset(h.chksum, ' ', sizeof(h.chksum));
+      uint64_t sum = 0;
+      for (size_t i = 0; i < sizeof(header_t); ++i) {
+        sum += reinterpret_cast<const unsigned char*>(&h)[i];
+      }
+      int_to_octal(sum, h.chksum, sizeof(h.chksum) - 1);
+      return h;
+    }
   };
 
-  tar(const std::string& tar_file, bool regular_files_only = true)
+  /**
+   * Map a tar file and find its entries.
+   * @param tar_file            the tar file
+   * @param regular_files_only  only keep regular file entries
+   * @param traverse_headers    read the header of every entry. If false only the first
+   *                            entry is read, which is enough to find an index written
+   *                            at the start of the archive without touching the rest of it
+   */
+  tar(const std::string& tar_file, bool regular_files_only = true, bool traverse_headers = true)
       : tar_file(tar_file), corrupt_blocks(0) {
     // get the file size
     struct stat s;
@@ -612,6 +652,10 @@ struct tar {
       // every entry's data is rounded to the nearst header_t sized "block"
       auto blocks = static_cast<size_t>(std::ceil(static_cast<double>(size) / sizeof(header_t)));
       position += blocks * sizeof(header_t);
+      // only the first entry was wanted
+      if (!traverse_headers) {
+        break;
+      }
     }
   }
 
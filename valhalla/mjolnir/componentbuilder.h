@@ -0,0 +1,29 @@
+#ifndef VALHALLA_MJOLNIR_COMPONENTBUILDER_H
+#define VALHALLA_MJOLNIR_COMPONENTBUILDER_H
+
+#include <boost/property_tree/ptree.hpp>
+#include <cstdint>
+
+namespace valhalla {
+namespace mjolnir {
+
+/**
+ * Class used to compute the connected components of the graph of each of the access modes
+ * in kComponentAccessModes and store them in the graph tiles. Loki can then reject
+ * locations which cannot be connected (e.g. on an island or behind a gate) without thor
+ * running a search that expands everything it can reach before failing.
+ */
+class ComponentBuilder {
+public:
+  /**
+   * Add the components of the nodes outside of the main component of each mode to the
+   * graph tiles. The whole graph of a mode is kept in memory (a few bytes per node) while
+   * its components are computed.
+   */
+  static void Build(const boost::property_tree::ptree& pt);
+};
+
+} // namespace mjolnir
+} // namespace valhalla
+
+#endif // VALHALLA_MJOLNIR_COMPONENTBUILDER_H
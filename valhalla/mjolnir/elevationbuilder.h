@@ -3,6 +3,10 @@
 
 #include <boost/property_tree/ptree.hpp>
 #include <cstdint>
+#include <deque>
+#include <unordered_set>
+
+#include <valhalla/baldr/graphid.h>
 
 namespace valhalla {
 namespace mjolnir {
@@ -16,6 +20,22 @@ public:
    * Add elevation information to the graph tiles.
    */
   static void Build(const boost::property_tree::ptree& pt);
+
+  /**
+   * Add elevation information to the given graph tiles. Threads take the tiles in order.
+   * @param  pt        Configuration.
+   * @param  tile_ids  Graph tiles to add elevation to.
+   */
+  static void Build(const boost::property_tree::ptree& pt, std::deque<baldr::GraphId> tile_ids);
+
+  /**
+   * Orders graph tiles by the 1x1 degree DEM tile their center falls in, so that the graph tiles
+   * being worked on at the same time mostly sample DEM tiles which are already decompressed.
+   * @param  tile_ids  Graph tiles to order.
+   * @return Returns the graph tiles grouped by DEM tile.
+   */
+  static std::deque<baldr::GraphId>
+  ScheduleTiles(const std::unordered_set<baldr::GraphId>& tile_ids);
 };
 
 } // namespace mjolnir
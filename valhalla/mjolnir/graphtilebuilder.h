@@ -14,9 +14,11 @@
 #include <utility>
 
 #include <valhalla/baldr/admin.h>
+#include <valhalla/baldr/edgereach.h>
 #include <valhalla/baldr/graphid.h>
 #include <valhalla/baldr/graphtile.h>
 #include <valhalla/baldr/graphtileheader.h>
+#include <valhalla/baldr/nodecomponent.h>
 #include <valhalla/baldr/nodetransition.h>
 #include <valhalla/baldr/sign.h>
 #include <valhalla/baldr/signinfo.h>
@@ -444,6 +446,22 @@ public:
    */
   void UpdatePredictedSpeeds(const std::vector<DirectedEdge>& directededges);
 
+  /**
+   * Updates a tile with the reach of each directed edge. The reach is written
+   * at the end of the tile (before any node components), replacing any reach
+   * already in the tile.
+   * @param  reach  Reach for each directed edge in the tile.
+   */
+  void UpdateReach(const std::vector<EdgeReach>& reach);
+
+  /**
+   * Updates a tile with the components of the nodes outside of the main component of each
+   * mode. The components are written as the last section of the tile, replacing any
+   * components already in the tile.
+   * @param  components  Components of the nodes, in any order.
+   */
+  void UpdateComponents(std::vector<NodeComponent> components);
+
 protected:
   struct EdgeTupleHasher {
     std::size_t operator()(const edge_tuple& k) const {
@@ -0,0 +1,28 @@
+#ifndef VALHALLA_MJOLNIR_REACHBUILDER_H
+#define VALHALLA_MJOLNIR_REACHBUILDER_H
+
+#include <boost/property_tree/ptree.hpp>
+#include <cstdint>
+
+namespace valhalla {
+namespace mjolnir {
+
+/**
+ * Class used to compute the inbound and outbound reach of every directed edge
+ * for a set of access modes and store it in the graph tiles. Loki can then check
+ * whether a candidate edge meets the minimum reachability of a location without
+ * running an expansion at request time.
+ */
+class ReachBuilder {
+public:
+  /**
+   * Add the reach of each directed edge to the graph tiles. The reach is capped at
+   * service_limits.max_reachability.
+   */
+  static void Build(const boost::property_tree::ptree& pt);
+};
+
+} // namespace mjolnir
+} // namespace valhalla
+
+#endif // VALHALLA_MJOLNIR_REACHBUILDER_H
@@ -0,0 +1,31 @@
+#ifndef VALHALLA_MJOLNIR_TRANSITCONVERTER_H
+#define VALHALLA_MJOLNIR_TRANSITCONVERTER_H
+
+#include <boost/property_tree/ptree.hpp>
+#include <unordered_set>
+
+#include <valhalla/baldr/graphid.h>
+
+namespace valhalla {
+namespace mjolnir {
+
+/**
+ * Class used to convert fetched transit data into transit graph tiles.
+ */
+class TransitConverter {
+public:
+  /**
+   * Convert the transit pbf tiles within the transit directory into transit
+   * graph tiles. TransitBuilder later connects these to the road graph.
+   * @param pt   Property tree containing the hierarchy configuration. The pbf
+   *             tiles are read from mjolnir.transit_dir and the graph tiles are
+   *             written to mjolnir.tile_dir.
+   * @return Returns the ids of the (local level) tiles which had transit data.
+   */
+  static std::unordered_set<baldr::GraphId> Convert(const boost::property_tree::ptree& pt);
+};
+
+} // namespace mjolnir
+} // namespace valhalla
+
+#endif // VALHALLA_MJOLNIR_TRANSITCONVERTER_H
@@ -28,7 +28,9 @@ enum class BuildStage : int8_t {
   kRestrictions = 9,
   kElevation = 10,
   kValidate = 11,
-  kCleanup = 12
+  kReach = 12,
+  kComponents = 13,
+  kCleanup = 14
 };
 
 // Convert string to BuildStage
@@ -46,6 +48,8 @@ inline BuildStage string_to_buildstage(const std::string& s) {
        {"restrictions", BuildStage::kRestrictions},
        {"elevation", BuildStage::kElevation},
        {"validate", BuildStage::kValidate},
+       {"reach", BuildStage::kReach},
+       {"components", BuildStage::kComponents},
        {"cleanup", BuildStage::kCleanup}};
 
   auto i = stringToBuildStage.find(s);
@@ -67,6 +71,8 @@ inline std::string to_string(BuildStage stg) {
        {static_cast<int8_t>(BuildStage::kRestrictions), "restrictions"},
        {static_cast<int8_t>(BuildStage::kElevation), "elevation"},
        {static_cast<int8_t>(BuildStage::kValidate), "validate"},
+       {static_cast<int8_t>(BuildStage::kReach), "reach"},
+       {static_cast<int8_t>(BuildStage::kComponents), "components"},
        {static_cast<int8_t>(BuildStage::kCleanup), "cleanup"}};
 
   auto i = BuildStageStrings.find(static_cast<int8_t>(stg));
@@ -120,9 +126,21 @@ uint32_t compute_curvature(const std::list<midgard::PointLL>& shape);
 bool build_tile_set(const boost::property_tree::ptree& config,
                     const std::vector<std::string>& input_files,
                     const BuildStage start_stage = BuildStage::kInitialize,
-                    const BuildStage end_stage = BuildStage::kValidate,
+                    const BuildStage end_stage = BuildStage::kCleanup,
                     const bool release_osmpbf_memory = true);
 
+/**
+ * Write the tiles of a tile directory to an indexed tile extract. The extract is a
+ * tar of the tiles whose first entry is an index of the tiles sorted by id (see
+ * baldr::tile_index_entry_t), so that it can be loaded without reading the header
+ * of every tile while remaining a plain tar. Gzipped tiles are skipped since they
+ * can not be used from a memory mapped extract.
+ * @param tile_dir      Directory of the tiles.
+ * @param tile_extract  Path of the extract to write.
+ * @return Returns the number of tiles written.
+ */
+size_t build_tile_extract(const std::string& tile_dir, const std::string& tile_extract);
+
 } // namespace mjolnir
 } // namespace valhalla
 #endif // VALHALLA_MJOLNIR_UTIL_H_
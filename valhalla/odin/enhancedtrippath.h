@@ -26,7 +26,7 @@ class EnhancedTripLeg {
 public:
   EnhancedTripLeg(TripLeg& trip_path);
 
-  const std::string& shape() const {
+  const ::google::protobuf::RepeatedField<int32_t>& shape() const {
     return trip_path_.shape();
   }
 
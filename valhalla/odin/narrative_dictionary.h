@@ -1,6 +1,8 @@
 #ifndef VALHALLA_ODIN_NARRATIVE_DICTIONARY_H_
 #define VALHALLA_ODIN_NARRATIVE_DICTIONARY_H_
 
+#include <cstdint>
+#include <initializer_list>
 #include <locale>
 #include <string>
 #include <unordered_map>
@@ -152,8 +154,102 @@ constexpr auto kTransitPlatformCountLabelTag = "<TRANSIT_STOP_COUNT_LABEL>";
 namespace valhalla {
 namespace odin {
 
+// The tags that may be found within a localized phrase
+enum class PhraseTag : uint8_t {
+  kNone = 0,
+  kCardinalDirection,
+  kRelativeDirection,
+  kOrdinalValue,
+  kStreetNames,
+  kPreviousStreetNames,
+  kBeginStreetNames,
+  kCrossStreetNames,
+  kLength,
+  kDestination,
+  kCurrentVerbalCue,
+  kNextVerbalCue,
+  kNumberSign,
+  kBranchSign,
+  kTowardSign,
+  kNameSign,
+  kFerryLabel,
+  kTransitPlatform,
+  kStationLabel,
+  kTime,
+  kTransitName,
+  kTransitHeadSign,
+  kTransitPlatformCount,
+  kTransitPlatformCountLabel
+};
+
+// The value that replaces a phrase tag when a phrase template is rendered
+struct PhraseTagValue {
+  PhraseTag tag;
+  const std::string& value;
+};
+
+/**
+ * A localized phrase that is compiled once, when the dictionary is loaded, into
+ * a list of literal text and tag segments. Rendering the template writes the
+ * literal text and the tag values into the output in a single pass rather than
+ * copying the phrase and scanning it once per tag.
+ */
+class PhraseTemplate {
+public:
+  PhraseTemplate();
+
+  /**
+   * Constructor.
+   *
+   * @param  phrase  The tagged phrase to compile.
+   */
+  explicit PhraseTemplate(const std::string& phrase);
+
+  /**
+   * Renders this template into the specified output, replacing each tag with
+   * its value. Tags without a value are written as they appear in the phrase.
+   *
+   * @param  output  The string to render into, its contents are replaced.
+   * @param  values  The values to substitute for the phrase tags.
+   */
+  void Render(std::string& output, std::initializer_list<PhraseTagValue> values) const;
+
+  /**
+   * Returns true if this template was compiled from a phrase.
+   *
+   * @return true if this template was compiled from a phrase.
+   */
+  bool defined() const {
+    return defined_;
+  }
+
+protected:
+  struct Segment {
+    uint32_t offset;
+    uint32_t length;
+    PhraseTag tag;
+  };
+
+  // The phrase text, segments reference ranges of it
+  std::string text_;
+  std::vector<Segment> segments_;
+  bool defined_;
+};
+
 struct PhraseSet {
   std::unordered_map<std::string, std::string> phrases;
+
+  // The compiled phrases indexed by phrase id
+  std::vector<PhraseTemplate> templates;
+
+  /**
+   * Returns the compiled phrase for the specified phrase id.
+   * Throws std::out_of_range if the phrase id does not exist.
+   *
+   * @param  phrase_id  The id of the phrase.
+   * @return the compiled phrase for the specified phrase id.
+   */
+  const PhraseTemplate& GetTemplate(size_t phrase_id) const;
 };
 
 struct StartSubset : PhraseSet {
@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <locale>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -46,9 +47,29 @@ std::string get_localized_time(const std::string& date_time, const std::locale&
  */
 std::string get_localized_date(const std::string& date_time, const std::locale& locale);
 
+/**
+ * Returns true if narrative is available for the specified language tag. The
+ * tag can be a locale or one of its aliases. No locale is parsed to answer this.
+ *
+ * @param language_tag  the locale or alias to look for
+ * @return true if the language tag is supported
+ */
+bool is_supported_locale(const std::string& language_tag);
+
+/**
+ * Returns the NarrativeDictionary for the specified language tag. The locale is
+ * parsed the first time any of its tags is requested and is then shared, read
+ * only, by every caller.
+ *
+ * @param language_tag  the locale or alias to look for
+ * @return the NarrativeDictionary or nullptr if the language tag is not supported
+ */
+std::shared_ptr<const NarrativeDictionary> get_locale(const std::string& language_tag);
+
 using locales_singleton_t = std::unordered_map<std::string, std::shared_ptr<NarrativeDictionary>>;
 /**
- * Returns locale strings mapped to NarrativeDictionaries containing parsed narrative information
+ * Returns locale strings mapped to NarrativeDictionaries containing parsed narrative information.
+ * Note that this parses every locale, prefer get_locale when only some languages are needed.
  *
  * @return the map of locales to NarrativeDictionaries
  */
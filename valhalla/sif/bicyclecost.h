@@ -2,6 +2,7 @@
 #define VALHALLA_SIF_BICYCLECOST_H_
 
 #include <cstdint>
+#include <valhalla/baldr/graphconstants.h>
 #include <valhalla/baldr/rapidjson_utils.h>
 #include <valhalla/proto/options.pb.h>
 #include <valhalla/sif/dynamiccost.h>
@@ -27,6 +28,584 @@ void ParseBicycleCostOptions(const rapidjson::Document& doc,
  */
 cost_ptr_t CreateBicycleCost(const Costing costing, const Options& options);
 
+/**
+ * The part of BicycleCost (see bicyclecost.cc) the path algorithms call for every edge they
+ * relax, with the values it reads. DirectCost inlines it.
+ */
+class BicycleCostBase : public DynamicCost {
+public:
+  /**
+   * Checks if the costing is exactly a BicycleCost, whose per edge costing this is.
+   * @param  costing  Costing of a request.
+   * @return Returns false for any other costing, including the ones derived from it.
+   */
+  static bool Is(const DynamicCost& costing);
+
+  /**
+   * Checks if access is allowed for the provided directed edge.
+   * This is generally based on mode of travel and the access modes
+   * allowed on the edge. However, it can be extended to exclude access
+   * based on other parameters such as conditional restrictions and
+   * conditional access that can depend on time and travel mode.
+   * @param  edge           Pointer to a directed edge.
+   * @param  pred           Predecessor edge information.
+   * @param  tile           Current tile.
+   * @param  edgeid         GraphId of the directed edge.
+   * @param  current_time   Current time (seconds since epoch). A value of 0
+   *                        indicates the route is not time dependent.
+   * @param  tz_index       timezone index for the node
+   * @return Returns true if access is allowed, false if not.
+   */
+  virtual bool Allowed(const baldr::DirectedEdge* edge,
+                       const EdgeLabel& pred,
+                       const baldr::GraphTile*& tile,
+                       const baldr::GraphId& edgeid,
+                       const uint64_t current_time,
+                       const uint32_t tz_index,
+                       bool& time_restricted) const;
+
+  /**
+   * Checks if access is allowed for an edge on the reverse path
+   * (from destination towards origin). Both opposing edges (current and
+   * predecessor) are provided. The access check is generally based on mode
+   * of travel and the access modes allowed on the edge. However, it can be
+   * extended to exclude access based on other parameters such as conditional
+   * restrictions and conditional access that can depend on time and travel
+   * mode.
+   * @param  edge           Pointer to a directed edge.
+   * @param  pred           Predecessor edge information.
+   * @param  opp_edge       Pointer to the opposing directed edge.
+   * @param  tile           Current tile.
+   * @param  edgeid         GraphId of the opposing edge.
+   * @param  current_time   Current time (seconds since epoch). A value of 0
+   *                        indicates the route is not time dependent.
+   * @param  tz_index       timezone index for the node
+   * @return  Returns true if access is allowed, false if not.
+   */
+  virtual bool AllowedReverse(const baldr::DirectedEdge* edge,
+                              const EdgeLabel& pred,
+                              const baldr::DirectedEdge* opp_edge,
+                              const baldr::GraphTile*& tile,
+                              const baldr::GraphId& opp_edgeid,
+                              const uint64_t current_time,
+                              const uint32_t tz_index,
+                              bool& has_time_restrictions) const;
+
+  /**
+   * Checks if access is allowed for the provided node. Node access can
+   * be restricted if bollards or gates are present. (TODO - others?)
+   * @param  node  Pointer to node information.
+   * @return  Returns true if access is allowed, false if not.
+   */
+  virtual bool Allowed(const baldr::NodeInfo* node) const {
+    return (node->access() & baldr::kBicycleAccess);
+  }
+
+  /**
+   * Get the cost to traverse the specified directed edge. Cost includes
+   * the time (seconds) to traverse the edge.
+   * @param   edge      Pointer to a directed edge.
+   * @param   tile      Current tile.
+   * @param   seconds   Time of week in seconds.
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost EdgeCost(const baldr::DirectedEdge* edge,
+                        const baldr::GraphTile* tile,
+                        const uint32_t seconds) const;
+
+  /**
+   * Returns the cost to make the transition from the predecessor edge.
+   * Defaults to 0. Costing models that wish to include edge transition
+   * costs (i.e., intersection/turn costs) must override this method.
+   * @param  edge  Directed edge (the to edge)
+   * @param  node  Node (intersection) where transition occurs.
+   * @param  pred  Predecessor edge information.
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost TransitionCost(const baldr::DirectedEdge* edge,
+                              const baldr::NodeInfo* node,
+                              const EdgeLabel& pred) const;
+
+  /**
+   * Returns the cost to make the transition from the predecessor edge
+   * when using a reverse search (from destination towards the origin).
+   * @param  idx   Directed edge local index
+   * @param  node  Node (intersection) where transition occurs.
+   * @param  pred  the opposing current edge in the reverse tree.
+   * @param  edge  the opposing predecessor in the reverse tree
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost TransitionCostReverse(const uint32_t idx,
+                                     const baldr::NodeInfo* node,
+                                     const baldr::DirectedEdge* pred,
+                                     const baldr::DirectedEdge* edge) const;
+
+  // Public so the cost tests can inspect it
+
+  float speedfactor_[baldr::kMaxSpeedKph + 1]; // Cost factors based on speed in kph
+  float use_roads_;                     // Preference of using roads between 0 and 1
+  float road_factor_;                   // Road factor based on use_roads_
+  float avoid_bad_surfaces_;            // Preference of avoiding bad surfaces for the bike type
+
+  // Average speed (kph) on smooth, flat roads.
+  float speed_;
+
+  // Bicycle type
+  BicycleType type_;
+
+  // Minimal surface type that will be penalized for costing
+  baldr::Surface minimal_surface_penalized_;
+  baldr::Surface worst_allowed_surface_;
+
+  // Surface speed factors (based on road surface type).
+  const float* surface_speed_factor_;
+
+  // Speed penalty factor. Penalties apply above a threshold
+  // (based on the use_roads factor)
+  float speedpenalty_[baldr::kMaxSpeedKph + 1];
+  uint32_t speed_penalty_threshold_;
+
+  // Elevation/grade penalty (weighting applied based on the edge's weighted
+  // grade (relative value from 0-15)
+  float grade_penalty[16];
+
+protected:
+  BicycleCostBase(const Options& options, const TravelMode mode) : DynamicCost(options, mode) {
+  }
+
+  // Default turn costs - modified by the stop impact.
+  static constexpr float kTCStraight = 0.15f;
+  static constexpr float kTCFavorableSlight = 0.2f;
+  static constexpr float kTCFavorable = 0.3f;
+  static constexpr float kTCFavorableSharp = 0.5f;
+  static constexpr float kTCCrossing = 0.75f;
+  static constexpr float kTCUnfavorableSlight = 0.4f;
+  static constexpr float kTCUnfavorable = 1.0f;
+  static constexpr float kTCUnfavorableSharp = 1.5f;
+  static constexpr float kTCReverse = 5.0f;
+
+  // Turn costs based on side of street driving
+  static constexpr float kRightSideTurnCosts[] = {kTCStraight,    kTCFavorableSlight,
+                                                  kTCFavorable,   kTCFavorableSharp,
+                                                  kTCReverse,     kTCUnfavorableSharp,
+                                                  kTCUnfavorable, kTCUnfavorableSlight};
+  static constexpr float kLeftSideTurnCosts[] = {kTCStraight,    kTCUnfavorableSlight,
+                                                 kTCUnfavorable, kTCUnfavorableSharp,
+                                                 kTCReverse,     kTCFavorableSharp,
+                                                 kTCFavorable,   kTCFavorableSlight};
+
+  // Turn stress penalties for low-stress bike.
+  static constexpr float kTPStraight = 0.0f;
+  static constexpr float kTPFavorableSlight = 0.25f;
+  static constexpr float kTPFavorable = 0.75f;
+  static constexpr float kTPFavorableSharp = 1.0f;
+  static constexpr float kTPUnfavorableSlight = 0.75f;
+  static constexpr float kTPUnfavorable = 1.75f;
+  static constexpr float kTPUnfavorableSharp = 2.25f;
+  static constexpr float kTPReverse = 4.0f;
+  static constexpr float kRightSideTurnPenalties[] = {kTPStraight,    kTPFavorableSlight,
+                                                      kTPFavorable,   kTPFavorableSharp,
+                                                      kTPReverse,     kTPUnfavorableSharp,
+                                                      kTPUnfavorable, kTPUnfavorableSlight};
+  static constexpr float kLeftSideTurnPenalties[] = {kTPStraight,    kTPUnfavorableSlight,
+                                                     kTPUnfavorable, kTPUnfavorableSharp,
+                                                     kTPReverse,     kTPFavorableSharp,
+                                                     kTPFavorable,   kTPFavorableSlight};
+
+  // Additional stress factor for designated truck routes
+  static constexpr float kTruckStress = 0.5f;
+
+  // Cost of traversing an edge with steps. Make this high but not impassible.
+  static constexpr float kBicycleStepsFactor = 8.0f;
+  static constexpr float kDismountSpeed = 5.1f;
+
+  // Weighting factor based on road class. These apply penalties to higher class
+  // roads. These penalties are modulated by the useroads factor - further
+  // avoiding higher class roads for those with low propensity for using roads.
+  static constexpr float kRoadClassFactor[] = {
+      1.0f,  // Motorway
+      0.4f,  // Trunk
+      0.2f,  // Primary
+      0.1f,  // Secondary
+      0.05f, // Tertiary
+      0.05f, // Unclassified
+      0.0f,  // Residential
+      0.5f   // Service, other
+  };
+
+  // Speed adjustment factors based on weighted grade. Comments here show an
+  // example of speed changes based on "grade", using a base speed of 18 MPH
+  // on flat roads
+  static constexpr float kGradeBasedSpeedFactor[] = {
+      2.2f,  // -10%  - 39.6
+      2.0f,  // -8%   - 36
+      1.9f,  // -6.5% - 34.2
+      1.7f,  // -5%   - 30.6
+      1.4f,  // -3%   - 25
+      1.2f,  // -1.5% - 21.6
+      1.0f,  // 0%    - 18
+      0.95f, // 1.5%  - 17
+      0.85f, // 3%    - 15
+      0.75f, // 5%    - 13.5
+      0.65f, // 6.5%  - 12
+      0.55f, // 8%    - 10
+      0.5f,  // 10%   - 9
+      0.45f, // 11.5% - 8
+      0.4f,  // 13%   - 7
+      0.3f   // 15%   - 5.5
+  };
+  static constexpr float kSurfaceFactors[] = {1.0f, 2.5f, 4.5f, 7.0f};
+
+  // How much to favor bicycle networks.
+  static constexpr float kBicycleNetworkFactor = 0.95f;
+};
+
+// Check if access is allowed on the specified edge.
+inline bool BicycleCostBase::Allowed(const baldr::DirectedEdge* edge,
+                                     const EdgeLabel& pred,
+                                     const baldr::GraphTile*& tile,
+                                     const baldr::GraphId& edgeid,
+                                     const uint64_t current_time,
+                                     const uint32_t tz_index,
+                                     bool& has_time_restrictions) const {
+
+  // Check bicycle access and turn restrictions. Bicycles should obey
+  // vehicular turn restrictions. Allow Uturns at dead ends only.
+  // Skip impassable edges and shortcut edges.
+  if (!(edge->forwardaccess() & baldr::kBicycleAccess) || edge->is_shortcut() ||
+      (!pred.deadend() && pred.opp_local_idx() == edge->localedgeidx()) ||
+      (pred.restrictions() & (1 << edge->localedgeidx())) || IsUserAvoidEdge(edgeid)) {
+    return false;
+  }
+
+  // Disallow transit connections
+  // (except when set for multi-modal routes (FUTURE)
+  if (edge->use() == baldr::Use::kTransitConnection ||
+      edge->use() == baldr::Use::kEgressConnection ||
+      edge->use() == baldr::Use::kPlatformConnection /* && !allow_transit_connections_*/) {
+    return false;
+  }
+
+  // Prohibit certain roads based on surface type and bicycle type
+  if (edge->surface() > worst_allowed_surface_) {
+    return false;
+  }
+  return DynamicCost::EvaluateRestrictions(baldr::kBicycleAccess, edge, tile, edgeid, current_time,
+                                           tz_index, has_time_restrictions);
+}
+
+// Checks if access is allowed for an edge on the reverse path (from
+// destination towards origin). Both opposing edges are provided.
+inline bool BicycleCostBase::AllowedReverse(const baldr::DirectedEdge* edge,
+                                            const EdgeLabel& pred,
+                                            const baldr::DirectedEdge* opp_edge,
+                                            const baldr::GraphTile*& tile,
+                                            const baldr::GraphId& opp_edgeid,
+                                            const uint64_t current_time,
+                                            const uint32_t tz_index,
+                                            bool& has_time_restrictions) const {
+
+  // Check access, U-turn (allow at dead-ends), and simple turn restriction.
+  // Do not allow transit connection edges.
+  if (!(opp_edge->forwardaccess() & baldr::kBicycleAccess) || opp_edge->is_shortcut() ||
+      opp_edge->use() == baldr::Use::kTransitConnection ||
+      opp_edge->use() == baldr::Use::kEgressConnection ||
+      opp_edge->use() == baldr::Use::kPlatformConnection ||
+      (!pred.deadend() && pred.opp_local_idx() == edge->localedgeidx()) ||
+      (opp_edge->restrictions() & (1 << pred.opp_local_idx())) || IsUserAvoidEdge(opp_edgeid)) {
+    return false;
+  }
+
+  // Prohibit certain roads based on surface type and bicycle type
+  if (edge->surface() > worst_allowed_surface_) {
+    return false;
+  }
+  return DynamicCost::EvaluateRestrictions(baldr::kBicycleAccess, edge, tile, opp_edgeid,
+                                           current_time, tz_index, has_time_restrictions);
+}
+
+// Returns the cost to traverse the edge and an estimate of the actual time
+// (in seconds) to traverse the edge.
+inline Cost BicycleCostBase::EdgeCost(const baldr::DirectedEdge* edge,
+                                      const baldr::GraphTile* tile,
+                                      const uint32_t seconds) const {
+  auto speed = tile->GetSpeed(edge, flow_mask_, seconds);
+
+  // Stairs/steps - high cost (travel speed = 1kph) so they are generally avoided.
+  if (edge->use() == baldr::Use::kSteps) {
+    float sec = (edge->length() * speedfactor_[1]);
+    return {sec * kBicycleStepsFactor, sec};
+  }
+
+  // Ferries are a special case - they use the ferry speed (stored on the edge)
+  if (edge->use() == baldr::Use::kFerry) {
+    // Compute elapsed time based on speed. Modulate cost with weighting factors.
+    float sec = (edge->length() * speedfactor_[speed]);
+    return {sec * ferry_factor_, sec};
+  }
+
+  // If you have to dismount on the edge then we set speed to an average walking speed
+  // Otherwise, Update speed based on surface factor. Lower speed for rougher surfaces
+  // depending on the bicycle type. Modulate speed based on weighted grade
+  // (relative measure of elevation change along the edge)
+  uint32_t bike_speed =
+      edge->dismount()
+          ? kDismountSpeed
+          : static_cast<uint32_t>((speed_ *
+                                   surface_speed_factor_[static_cast<uint32_t>(edge->surface())] *
+                                   kGradeBasedSpeedFactor[edge->weighted_grade()]) +
+                                  0.5f);
+
+  // Represents how stressful a roadway is without looking at grade or cycle accommodations
+  float roadway_stress = 1.0f;
+  // Represents the amount of accommodation that is being made for bicycling
+  float accommodation_factor = 1.0f;
+
+  // Special use cases: cycleway, footway, and path
+  uint32_t road_speed = static_cast<uint32_t>(speed + 0.5f);
+  if (edge->use() == baldr::Use::kCycleway || edge->use() == baldr::Use::kFootway ||
+      edge->use() == baldr::Use::kPath) {
+
+    // Differentiate how segregated the way is from pedestrians
+    if (edge->cyclelane() == baldr::CycleLane::kSeparated) {
+      // No pedestrians allowed on path
+      accommodation_factor = use_roads_ * 0.8f;
+    } else if (edge->cyclelane() == baldr::CycleLane::kDedicated) {
+      // Segregated lane from pedestrians
+      accommodation_factor = 0.1f + use_roads_ * 0.9f;
+    } else { // Share path with pedestrians
+      accommodation_factor = 0.2f + use_roads_;
+    }
+  } else if (edge->use() == baldr::Use::kMountainBike && type_ == BicycleType::kMountain) {
+    // Slightly less reduction than a footway or path because even with a mountain bike
+    // these paths can be a little stressful to ride. No traffic though so still favorable
+    accommodation_factor = 0.3f + use_roads_;
+  } else if (edge->use() == baldr::Use::kLivingStreet) {
+    roadway_stress = 0.2f + use_roads_ * 0.8f;
+  } else if (edge->use() == baldr::Use::kTrack) {
+    roadway_stress = 0.5f + use_roads_;
+  } else {
+    // Favor roads where a cycle lane exists
+    if (edge->cyclelane() == baldr::CycleLane::kShared) {
+      accommodation_factor = 0.9f + use_roads_ * 0.05f;
+    } else if (edge->cyclelane() == baldr::CycleLane::kDedicated) {
+      accommodation_factor = 0.4f + use_roads_ * 0.45f;
+    } else if (edge->cyclelane() == baldr::CycleLane::kSeparated) {
+      accommodation_factor = 0.15f + use_roads_ * 0.6f;
+    } else if (edge->shoulder()) {
+      // If no cycle lane, but there is a shoulder then have a slight preference for this road
+      accommodation_factor = 0.7f + use_roads_ * 0.2f;
+    }
+
+    // Penalize roads that have more than one lane (in the direction of travel)
+    if (edge->lanecount() > 1) {
+      roadway_stress += (static_cast<float>(edge->lanecount()) - 1) * 0.05f * road_factor_;
+    }
+
+    // Designated truck routes add to roadway stress
+    if (edge->truck_route()) {
+      roadway_stress += kTruckStress;
+    }
+
+    // Add in penalization for road classification
+    roadway_stress +=
+        road_factor_ * kRoadClassFactor[static_cast<uint32_t>(edge->classification())];
+    // Then multiply by speed so that higher classified roads are more severely punished for being
+    // fast.
+    roadway_stress *= speedpenalty_[road_speed];
+  }
+
+  // We want to try and avoid roads that specify to use a cycling path to the side
+  if (edge->use_sidepath()) {
+    accommodation_factor += 3.0f * (1.0f - use_roads_);
+  }
+
+  // Favor bicycle networks very slightly.
+  // TODO - do we need to differentiate between types of network?
+  if (edge->bike_network() > 0) {
+    accommodation_factor *= kBicycleNetworkFactor;
+  }
+
+  // The stress of this road after accommodation but before grade
+  float total_stress = accommodation_factor * roadway_stress;
+
+  float surface_factor = 0.0f;
+  if (edge->surface() >= minimal_surface_penalized_) {
+    surface_factor =
+        avoid_bad_surfaces_ * kSurfaceFactors[static_cast<uint32_t>(edge->surface()) -
+                                              static_cast<uint32_t>(minimal_surface_penalized_)];
+  }
+
+  // Create a final edge factor based on total stress and the weighted grade penalty for the edge.
+  float factor = 1.0f + grade_penalty[edge->weighted_grade()] + total_stress + surface_factor;
+
+  // Compute elapsed time based on speed. Modulate cost with weighting factors.
+  float sec = (edge->length() * speedfactor_[bike_speed]);
+  return {sec * factor, sec};
+}
+
+// Returns the time (in seconds) to make the transition from the predecessor
+inline Cost BicycleCostBase::TransitionCost(const baldr::DirectedEdge* edge,
+                                            const baldr::NodeInfo* node,
+                                            const EdgeLabel& pred) const {
+
+  // Get the transition cost for country crossing, ferry, gate, toll booth,
+  // destination only, alley, maneuver penalty
+  uint32_t idx = pred.opp_local_idx();
+  Cost c = base_transition_cost(node, edge, pred, idx);
+
+  // Accumulate cost and penalty
+  float seconds = 0.0f;
+  float penalty = 0.0f;
+  float class_factor = kRoadClassFactor[static_cast<uint32_t>(edge->classification())];
+
+  // Reduce penalty to make this turn if the road we are turning on has some kind of bicycle
+  // accommodation
+  float bike_accom = 1.0f;
+  if (edge->use() == baldr::Use::kCycleway || edge->use() == baldr::Use::kFootway ||
+      edge->use() == baldr::Use::kPath) {
+    bike_accom = 0.05f;
+    // These uses are classified as "service/other" roads but should not be penalized as such so we
+    // change it's factor
+    class_factor = 0.1f;
+  } else if (edge->use() == baldr::Use::kLivingStreet) {
+    bike_accom = 0.15f;
+  } else {
+    if (edge->cyclelane() == baldr::CycleLane::kShared) {
+      bike_accom = 0.5f;
+    } else if (edge->cyclelane() == baldr::CycleLane::kDedicated) {
+      bike_accom = 0.25f;
+    } else if (edge->cyclelane() == baldr::CycleLane::kSeparated) {
+      bike_accom = 0.1f;
+    } else if (edge->shoulder()) {
+      bike_accom = 0.4f;
+    }
+  }
+
+  float turn_stress = 1.0f;
+
+  if (edge->stopimpact(idx) > 0) {
+    // Increase turn stress depending on the kind of turn that has to be made.
+    float turn_penalty = (node->drive_on_right())
+                             ? kRightSideTurnPenalties[static_cast<uint32_t>(edge->turntype(idx))]
+                             : kLeftSideTurnPenalties[static_cast<uint32_t>(edge->turntype(idx))];
+    turn_stress += turn_penalty;
+
+    // Take the higher of the turn degree cost and the crossing cost
+    float turn_cost = (node->drive_on_right())
+                          ? kRightSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))]
+                          : kLeftSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))];
+    if (turn_cost < kTCCrossing && edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
+      turn_cost = kTCCrossing;
+    }
+
+    // Transition time = stopimpact * turncost
+    seconds += edge->stopimpact(idx) * turn_cost;
+  }
+
+  // Reduce stress by road class factor the closer use_roads_ is to 0
+  float avoid_roads = 1.0f - use_roads_;
+  turn_stress *= (class_factor * avoid_roads) + use_roads_ + 1.0f;
+
+  // Penalize transition to higher class road.
+  if (edge->classification() < pred.classification() && edge->use() != baldr::Use::kLivingStreet) {
+    penalty += 10.0f * (static_cast<uint32_t>(pred.classification()) -
+                        static_cast<uint32_t>(edge->classification()));
+    // Reduce the turn stress if there is a traffic signal
+    turn_stress += (node->traffic_signal()) ? 0.4 : 1.0;
+  }
+
+  // Reduce penalty by bike_accom the closer use_roads_ is to 0
+  penalty *= (bike_accom * avoid_roads) + use_roads_;
+
+  // Return cost (time and penalty)
+  c.cost += (seconds * (turn_stress + 1.0f)) + penalty;
+  c.secs += seconds;
+  return c;
+}
+
+// Returns the cost to make the transition from the predecessor edge
+// when using a reverse search (from destination towards the origin).
+// pred is the opposing current edge in the reverse tree
+// edge is the opposing predecessor in the reverse tree
+inline Cost BicycleCostBase::TransitionCostReverse(const uint32_t idx,
+                                                   const baldr::NodeInfo* node,
+                                                   const baldr::DirectedEdge* pred,
+                                                   const baldr::DirectedEdge* edge) const {
+
+  // Get the transition cost for country crossing, ferry, gate, toll booth,
+  // destination only, alley, maneuver penalty
+  Cost c = base_transition_cost(node, edge, pred, idx);
+
+  // Additional costs
+  float seconds = 0.0f;
+  float penalty = 0.0f;
+
+  // Reduce penalty to make this turn if the road we are turning on has some kind of bicycle
+  // accommodation
+  float class_factor = kRoadClassFactor[static_cast<uint32_t>(edge->classification())];
+  float bike_accom = 1.0f;
+  if (edge->use() == baldr::Use::kCycleway || edge->use() == baldr::Use::kFootway ||
+      edge->use() == baldr::Use::kPath) {
+    bike_accom = 0.05f;
+    // These uses are considered "service/other" roads but should not be penalized as such so we
+    // change it's factor
+    class_factor = 0.1f;
+  } else if (edge->use() == baldr::Use::kLivingStreet) {
+    bike_accom = 0.15f;
+  } else {
+    if (edge->cyclelane() == baldr::CycleLane::kShared) {
+      bike_accom = 0.5f;
+    } else if (edge->cyclelane() == baldr::CycleLane::kDedicated) {
+      bike_accom = 0.25f;
+    } else if (edge->cyclelane() == baldr::CycleLane::kSeparated) {
+      bike_accom = 0.1f;
+    } else if (edge->shoulder()) {
+      bike_accom = 0.4f;
+    }
+  }
+
+  float turn_stress = 1.0f;
+  if (edge->stopimpact(idx) > 0) {
+    // Increase turn stress depending on the kind of turn that has to be made.
+    float turn_penalty = (node->drive_on_right())
+                             ? kRightSideTurnPenalties[static_cast<uint32_t>(edge->turntype(idx))]
+                             : kLeftSideTurnPenalties[static_cast<uint32_t>(edge->turntype(idx))];
+    turn_stress += turn_penalty;
+
+    // Take the higher of the turn degree cost and the crossing cost
+    float turn_cost = (node->drive_on_right())
+                          ? kRightSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))]
+                          : kLeftSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))];
+    if (turn_cost < kTCCrossing && edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
+      turn_cost = kTCCrossing;
+    }
+
+    // Transition time = stopimpact * turncost
+    seconds += edge->stopimpact(idx) * turn_cost;
+  }
+
+  // Reduce stress by road class factor the closer use_roads_ is to 0
+  float avoid_roads = 1.0f - use_roads_;
+  turn_stress *= (class_factor * avoid_roads) + use_roads_ + 1.0f;
+
+  // Penalize transition to higher class road.
+  if (edge->classification() < pred->classification() && edge->use() != baldr::Use::kLivingStreet) {
+    penalty += 10.0f * (static_cast<uint32_t>(pred->classification()) -
+                        static_cast<uint32_t>(edge->classification()));
+    // Reduce the turn stress if there is a traffic signal
+    turn_stress += (node->traffic_signal()) ? 0.4 : 1.0;
+  }
+
+  // Reduce penalty by bike_accom the closer use_roads_ is to 0
+  penalty *= (bike_accom * avoid_roads) + use_roads_;
+
+  // Return cost (time and penalty)
+  c.cost += (seconds * (turn_stress + 1.0f)) + penalty;
+  c.secs += seconds;
+  return c;
+}
+
 } // namespace sif
 } // namespace valhalla
 
@@ -0,0 +1,186 @@
+#ifndef VALHALLA_SIF_COSTDISPATCH_H_
+#define VALHALLA_SIF_COSTDISPATCH_H_
+
+#include <cstdint>
+
+#include <valhalla/baldr/directededge.h>
+#include <valhalla/baldr/graphconstants.h>
+#include <valhalla/baldr/graphid.h>
+#include <valhalla/baldr/graphtile.h>
+#include <valhalla/baldr/nodeinfo.h>
+#include <valhalla/sif/autocost.h>
+#include <valhalla/sif/bicyclecost.h>
+#include <valhalla/sif/dynamiccost.h>
+#include <valhalla/sif/edgecostcache.h>
+#include <valhalla/sif/edgelabel.h>
+#include <valhalla/sif/motorcyclecost.h>
+#include <valhalla/sif/motorscootercost.h>
+#include <valhalla/sif/pedestriancost.h>
+#include <valhalla/sif/truckcost.h>
+
+namespace valhalla {
+namespace sif {
+
+/**
+ * Gives a path algorithm access to the costing methods it calls for every edge
+ * it relaxes. The calls are qualified with costing_t, the part of a costing its
+ * header exposes for this (e.g. AutoCostBase), so they are bound at compile time
+ * rather than through the vtable, which lets the compiler inline them. The
+ * costing must not override those methods (visit_costing makes sure of that).
+ * Edge costs go through the edge cost cache of the costing when it is enabled.
+ */
+template <class costing_t> class DirectCost {
+public:
+  explicit DirectCost(const DynamicCost& costing)
+      : costing_(static_cast<const costing_t&>(costing)), cache_(costing.edge_cost_cache()) {
+  }
+
+  bool Allowed(const baldr::NodeInfo* node) const {
+    return costing_.costing_t::Allowed(node);
+  }
+
+  bool Allowed(const baldr::DirectedEdge* edge,
+               const EdgeLabel& pred,
+               const baldr::GraphTile*& tile,
+               const baldr::GraphId& edgeid,
+               const uint64_t current_time,
+               const uint32_t tz_index,
+               bool& has_time_restrictions) const {
+    return costing_.costing_t::Allowed(edge, pred, tile, edgeid, current_time, tz_index,
+                                       has_time_restrictions);
+  }
+
+  bool AllowedReverse(const baldr::DirectedEdge* edge,
+                      const EdgeLabel& pred,
+                      const baldr::DirectedEdge* opp_edge,
+                      const baldr::GraphTile*& tile,
+                      const baldr::GraphId& opp_edgeid,
+                      const uint64_t current_time,
+                      const uint32_t tz_index,
+                      bool& has_time_restrictions) const {
+    return costing_.costing_t::AllowedReverse(edge, pred, opp_edge, tile, opp_edgeid, current_time,
+                                              tz_index, has_time_restrictions);
+  }
+
+  Cost EdgeCost(const baldr::DirectedEdge* edge,
+                const baldr::GraphTile* tile,
+                const uint32_t seconds = baldr::kInvalidSecondsOfWeek) const {
+    if (cache_ == nullptr) {
+      return costing_.costing_t::EdgeCost(edge, tile, seconds);
+    }
+    return cache_->Get(edge, tile, seconds,
+                       [&]() { return costing_.costing_t::EdgeCost(edge, tile, seconds); });
+  }
+
+  Cost TransitionCost(const baldr::DirectedEdge* edge,
+                      const baldr::NodeInfo* node,
+                      const EdgeLabel& pred) const {
+    return costing_.costing_t::TransitionCost(edge, node, pred);
+  }
+
+  Cost TransitionCostReverse(const uint32_t idx,
+                             const baldr::NodeInfo* node,
+                             const baldr::DirectedEdge* opp_edge,
+                             const baldr::DirectedEdge* opp_pred_edge) const {
+    return costing_.costing_t::TransitionCostReverse(idx, node, opp_edge, opp_pred_edge);
+  }
+
+protected:
+  const costing_t& costing_;
+  EdgeCostCache* cache_;
+};
+
+/**
+ * Fallback for the other costings, including the ones derived from the costings
+ * visit_costing knows. Calls through the vtable.
+ */
+template <> class DirectCost<DynamicCost> {
+public:
+  explicit DirectCost(const DynamicCost& costing) : costing_(costing) {
+  }
+
+  bool Allowed(const baldr::NodeInfo* node) const {
+    return costing_.Allowed(node);
+  }
+
+  bool Allowed(const baldr::DirectedEdge* edge,
+               const EdgeLabel& pred,
+               const baldr::GraphTile*& tile,
+               const baldr::GraphId& edgeid,
+               const uint64_t current_time,
+               const uint32_t tz_index,
+               bool& has_time_restrictions) const {
+    return costing_.Allowed(edge, pred, tile, edgeid, current_time, tz_index,
+                            has_time_restrictions);
+  }
+
+  bool AllowedReverse(const baldr::DirectedEdge* edge,
+                      const EdgeLabel& pred,
+                      const baldr::DirectedEdge* opp_edge,
+                      const baldr::GraphTile*& tile,
+                      const baldr::GraphId& opp_edgeid,
+                      const uint64_t current_time,
+                      const uint32_t tz_index,
+                      bool& has_time_restrictions) const {
+    return costing_.AllowedReverse(edge, pred, opp_edge, tile, opp_edgeid, current_time, tz_index,
+                                   has_time_restrictions);
+  }
+
+  Cost EdgeCost(const baldr::DirectedEdge* edge,
+                const baldr::GraphTile* tile,
+                const uint32_t seconds = baldr::kInvalidSecondsOfWeek) const {
+    return costing_.CachedEdgeCost(edge, tile, seconds);
+  }
+
+  Cost TransitionCost(const baldr::DirectedEdge* edge,
+                      const baldr::NodeInfo* node,
+                      const EdgeLabel& pred) const {
+    return costing_.TransitionCost(edge, node, pred);
+  }
+
+  Cost TransitionCostReverse(const uint32_t idx,
+                             const baldr::NodeInfo* node,
+                             const baldr::DirectedEdge* opp_edge,
+                             const baldr::DirectedEdge* opp_pred_edge) const {
+    return costing_.TransitionCostReverse(idx, node, opp_edge, opp_pred_edge);
+  }
+
+protected:
+  const DynamicCost& costing_;
+};
+
+/**
+ * Calls the visitor with a DirectCost for the costing. This is done once per
+ * request so the per edge costing calls of the templated path algorithms are not
+ * virtual. Each costing listed here instantiates the algorithm templates the
+ * visitor calls. The check is on the exact type (XCostBase::Is): the costings
+ * derived from these (bus, hov, taxi, auto_shorter, auto_data_fix, ...) override
+ * their per edge methods, so they and any other costing get the virtual calls of
+ * DirectCost<DynamicCost>.
+ * @param  costing  Costing of the request.
+ * @param  visitor  Callable taking any DirectCost<costing_t>.
+ * @return Returns what the visitor returns.
+ */
+template <class visitor_t>
+auto visit_costing(const DynamicCost& costing, visitor_t&& visitor)
+    -> decltype(visitor(DirectCost<DynamicCost>(costing))) {
+  if (AutoCostBase::Is(costing)) {
+    return visitor(DirectCost<AutoCostBase>(costing));
+  } else if (TruckCostBase::Is(costing)) {
+    return visitor(DirectCost<TruckCostBase>(costing));
+  } else if (BicycleCostBase::Is(costing)) {
+    return visitor(DirectCost<BicycleCostBase>(costing));
+  } else if (PedestrianCostBase::Is(costing)) {
+    return visitor(DirectCost<PedestrianCostBase>(costing));
+  } else if (MotorcycleCostBase::Is(costing)) {
+    return visitor(DirectCost<MotorcycleCostBase>(costing));
+  } else if (MotorScooterCostBase::Is(costing)) {
+    return visitor(DirectCost<MotorScooterCostBase>(costing));
+  }
+  return visitor(DirectCost<DynamicCost>(costing));
+}
+
+} // namespace sif
+} // namespace valhalla
+
+#endif // VALHALLA_SIF_COSTDISPATCH_H_
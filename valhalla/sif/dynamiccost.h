@@ -16,11 +16,13 @@
 #include <valhalla/midgard/logging.h>
 #include <valhalla/proto/options.pb.h>
 #include <valhalla/sif/costconstants.h>
+#include <valhalla/sif/edgecostcache.h>
 #include <valhalla/sif/edgelabel.h>
 #include <valhalla/sif/hierarchylimits.h>
 #include <valhalla/thor/edgestatus.h>
 
 #include <memory>
+#include <string>
 #include <third_party/rapidjson/include/rapidjson/document.h>
 #include <unordered_map>
 
@@ -87,6 +89,24 @@ public:
    */
   virtual bool AllowMultiPass() const;
 
+  /**
+   * Can the reach computed for this costing's access mode when the tiles were built be
+   * used in place of a reach expansion. This is only the case when the edge and node
+   * filters of the costing are never more restrictive than the access based filtering
+   * used to compute the stored reach.
+   * @return  Returns true if the costing model can use the precomputed reach.
+   */
+  virtual bool AllowPrecomputedReach() const;
+
+  /**
+   * Can the connected components computed for this costing's access mode when the tiles
+   * were built be used to reject locations which cannot be connected. This is only the
+   * case when the costing never allows an edge or a node without access for its mode,
+   * since the components only look at access.
+   * @return  Returns true if the costing model can use the precomputed components.
+   */
+  virtual bool AllowPrecomputedComponents() const;
+
   /**
    * Get the pass number.
    * @return  Returns the pass through the algorithm.
@@ -228,6 +248,40 @@ public:
    */
   virtual Cost EdgeCost(const baldr::DirectedEdge* edge, const baldr::GraphTile* tile) const;
 
+  /**
+   * Get the cost to traverse the specified directed edge from the edge cost cache
+   * when it is enabled, costing (and remembering) the edge if it is not cached.
+   * @param   edge    Pointer to a directed edge.
+   * @param   tile    Pointer to the tile which contains the directed edge for speed lookup
+   * @param   seconds Seconds of week for predicted speed or free and constrained speed lookup
+   * @return  Returns the cost and time (seconds).
+   */
+  Cost CachedEdgeCost(const baldr::DirectedEdge* edge,
+                      const baldr::GraphTile* tile,
+                      const uint32_t seconds = baldr::kInvalidSecondsOfWeek) const {
+    if (!edge_cost_cache_) {
+      return EdgeCost(edge, tile, seconds);
+    }
+    return edge_cost_cache_->Get(edge, tile, seconds,
+                                 [&]() { return EdgeCost(edge, tile, seconds); });
+  }
+
+  /**
+   * Enable the edge cost cache for the rest of the request. Worthwhile when the
+   * request runs many searches over the same tiles (matrix, optimized route, etc.).
+   * @param  max_size  Maximum size of the cached costs in bytes. 0 disables the cache.
+   */
+  void EnableEdgeCostCache(const size_t max_size);
+
+  /**
+   * Get the edge cost cache. Filling it does not change the costs so it can be
+   * used through a const costing.
+   * @return  Returns the edge cost cache or nullptr if it is not enabled.
+   */
+  EdgeCostCache* edge_cost_cache() const {
+    return edge_cost_cache_.get();
+  }
+
   /**
    * Returns the cost to make the transition from the predecessor edge.
    * Defaults to 0. Costing models that wish to include edge transition
@@ -612,14 +666,31 @@ public:
   void AddUserAvoidEdges(const std::vector<AvoidEdge>& avoid_edges);
 
   /**
-   * Check if the edge is in the user-specified avoid list.
+   * Check if the edge is in the user-specified avoid list or inside one of the
+   * user-specified avoid polygons.
    * @param  edgeid  Directed edge Id.
    * @return Returns true if the edge Id is in the user avoid edges set,
    *         false otherwise.
    */
   bool IsUserAvoidEdge(const baldr::GraphId& edgeid) const {
     return (user_avoid_edges_.size() != 0 &&
-            user_avoid_edges_.find(edgeid) != user_avoid_edges_.end());
+            user_avoid_edges_.find(edgeid) != user_avoid_edges_.end()) ||
+           (user_avoid_tiles_.size() != 0 && IsUserAvoidTileEdge(edgeid));
+  }
+
+  /**
+   * Check if the edge is set in the bitset of edges to avoid of its tile (edges
+   * inside the user-specified avoid polygons).
+   * @param  edgeid  Directed edge Id.
+   * @return Returns true if the edge is set in the bitset of its tile.
+   */
+  bool IsUserAvoidTileEdge(const baldr::GraphId& edgeid) const {
+    auto tile = user_avoid_tiles_.find(edgeid.Tile_Base());
+    if (tile == user_avoid_tiles_.end()) {
+      return false;
+    }
+    const uint32_t byte = edgeid.id() >> 3;
+    return byte < tile->second.size() && (tile->second[byte] >> (edgeid.id() & 7)) & 1;
   }
 
   /**
@@ -679,6 +750,9 @@ protected:
   // User specified edges to avoid with percent along (for avoiding PathEdges of locations)
   std::unordered_map<baldr::GraphId, float> user_avoid_edges_;
 
+  // User specified edges to avoid (inside avoid polygons) as a bitset of the edges in each tile
+  std::unordered_map<baldr::GraphId, std::string> user_avoid_tiles_;
+
   // Weighting to apply to ferry edges
   float ferry_factor_;
 
@@ -696,6 +770,9 @@ protected:
   // A mask which determines which flow data the costing should use from the tile
   uint8_t flow_mask_;
 
+  // Edge costs remembered for the rest of the request (null when not enabled)
+  std::unique_ptr<EdgeCostCache> edge_cost_cache_;
+
   /**
    * Get the base transition costs (and ferry factor) from the costing options.
    * @param costing_options Protocol buffer of costing options.
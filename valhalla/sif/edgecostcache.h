@@ -0,0 +1,152 @@
+#ifndef VALHALLA_SIF_EDGECOSTCACHE_H_
+#define VALHALLA_SIF_EDGECOSTCACHE_H_
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <valhalla/baldr/directededge.h>
+#include <valhalla/baldr/graphconstants.h>
+#include <valhalla/baldr/graphtile.h>
+#include <valhalla/baldr/predictedspeeds.h>
+#include <valhalla/midgard/constants.h>
+#include <valhalla/sif/costconstants.h>
+
+namespace valhalla {
+namespace sif {
+
+/**
+ * Remembers the edge costs a costing computes during a single request so that
+ * requests running many searches over the same tiles (matrices, optimized routes,
+ * isochrones, multi-leg routes) only compute the cost of each edge once.
+ *
+ * Costs are stored per tile in an array with a slot for every directed edge of the
+ * tile. The arrays are carved out of large blocks so there is no allocation per
+ * edge. Each slot remembers the time of week it was costed for: edge costs only
+ * change with the predicted speed bucket and with the constrained (daytime) flow
+ * period, so a cost is reused for any time falling in the same bucket and period.
+ * Once the maximum size is reached edges in tiles not yet cached are costed
+ * without being remembered.
+ */
+class EdgeCostCache {
+public:
+  /**
+   * Constructor.
+   * @param  max_size  Maximum size of the cached costs in bytes.
+   */
+  explicit EdgeCostCache(const size_t max_size);
+
+  /**
+   * Get the cost of an edge, computing and remembering it if it is not cached.
+   * @param  edge     Directed edge.
+   * @param  tile     Tile containing the directed edge.
+   * @param  seconds  Seconds of week the edge is costed for.
+   * @param  cost_fn  Computes the cost of the edge when it is not cached.
+   * @return Returns the cost of the edge.
+   */
+  template <class cost_function_t>
+  Cost Get(const baldr::DirectedEdge* edge,
+           const baldr::GraphTile* tile,
+           const uint32_t seconds,
+           const cost_function_t& cost_fn) {
+    entry_t* entries = TileEntries(tile);
+    if (entries == nullptr) {
+      ++misses_;
+      return cost_fn();
+    }
+    entry_t& entry = entries[edge - tile->directededge(0)];
+    const uint32_t key = Key(seconds);
+    if (entry.key == key) {
+      ++hits_;
+      return entry.cost;
+    }
+    ++misses_;
+    entry.cost = cost_fn();
+    entry.key = key;
+    return entry.cost;
+  }
+
+  /**
+   * Forget all of the cached costs (and reset the counters).
+   */
+  void Clear();
+
+  /**
+   * Number of edge costs found in the cache.
+   */
+  uint64_t hits() const {
+    return hits_;
+  }
+
+  /**
+   * Number of edge costs that had to be computed.
+   */
+  uint64_t misses() const {
+    return misses_;
+  }
+
+  /**
+   * Size in bytes of the cached costs.
+   */
+  size_t size() const;
+
+protected:
+  // Cached cost of an edge. The key identifies the time the edge was costed for,
+  // 0 meaning nothing is cached.
+  struct entry_t {
+    uint32_t key;
+    Cost cost;
+  };
+
+  // Number of entries in each block of memory (unless a tile needs more)
+  static constexpr size_t kBlockEntries = 64 * 1024;
+
+  /**
+   * Key of the time an edge is costed for. Equal keys give equal edge costs, see
+   * GraphTile::GetSpeed.
+   */
+  static uint32_t Key(const uint32_t seconds) {
+    if (seconds == baldr::kInvalidSecondsOfWeek) {
+      return 1;
+    }
+    const uint32_t day_seconds = seconds % midgard::kSecondsPerDay;
+    const uint32_t is_daytime = (25200 < day_seconds && day_seconds < 68400);
+    const uint32_t bucket = (seconds % midgard::kSecondsPerWeek) / baldr::kSpeedBucketSizeSeconds;
+    return 2 + ((bucket << 1) | is_daytime);
+  }
+
+  /**
+   * Get the entries of the edges in a tile, allocating them if needed.
+   * @return Returns nullptr if the tile is not cached and the cache is full.
+   */
+  entry_t* TileEntries(const baldr::GraphTile* tile) {
+    const uint64_t tile_id = tile->header()->graphid().value;
+    if (tile_id != last_tile_id_) {
+      last_tile_id_ = tile_id;
+      last_entries_ = AllocateTile(tile);
+    }
+    return last_entries_;
+  }
+
+  /**
+   * Find or allocate the entries of the edges in a tile.
+   */
+  entry_t* AllocateTile(const baldr::GraphTile* tile);
+
+  size_t max_entries_;                             // Maximum number of entries to use
+  size_t entries_;                                 // Number of entries in use
+  size_t block_used_;                              // Entries handed out from the last block
+  size_t block_size_;                              // Number of entries in the last block
+  std::vector<std::unique_ptr<entry_t[]>> blocks_; // Memory of the entries
+  std::unordered_map<uint64_t, entry_t*> tiles_;   // Entries of each tile (null if not cached)
+  uint64_t last_tile_id_;                          // Tile of the last lookup
+  entry_t* last_entries_;                          // Entries of the last tile
+  uint64_t hits_;
+  uint64_t misses_;
+};
+
+} // namespace sif
+} // namespace valhalla
+
+#endif // VALHALLA_SIF_EDGECOSTCACHE_H_
@@ -4,6 +4,7 @@
 #include <cstdint>
 
 #include <boost/property_tree/ptree.hpp>
+#include <valhalla/baldr/graphconstants.h>
 #include <valhalla/baldr/rapidjson_utils.h>
 #include <valhalla/proto/options.pb.h>
 #include <valhalla/sif/dynamiccost.h>
@@ -31,6 +32,365 @@ void ParseMotorScooterCostOptions(const rapidjson::Document& doc,
  */
 cost_ptr_t CreateMotorScooterCost(const Costing costing, const Options& options);
 
+constexpr baldr::Surface kMinimumScooterSurface = baldr::Surface::kDirt;
+
+/**
+ * What the path algorithms call on MotorScooterCost (see motorscootercost.cc) for every edge
+ * they relax, and the values it reads. DirectCost inlines it.
+ */
+class MotorScooterCostBase : public DynamicCost {
+public:
+  /**
+   * Checks if the costing is exactly a MotorScooterCost, whose per edge costing this is.
+   * @param  costing  Costing of a request.
+   * @return Returns false for any other costing, including the ones derived from it.
+   */
+  static bool Is(const DynamicCost& costing);
+
+  /**
+   * Checks if access is allowed for the provided directed edge.
+   * This is generally based on mode of travel and the access modes
+   * allowed on the edge. However, it can be extended to exclude access
+   * based on other parameters such as conditional restrictions and
+   * conditional access that can depend on time and travel mode.
+   * @param  edge           Pointer to a directed edge.
+   * @param  pred           Predecessor edge information.
+   * @param  tile           Current tile.
+   * @param  edgeid         GraphId of the directed edge.
+   * @param  current_time   Current time (seconds since epoch). A value of 0
+   *                        indicates the route is not time dependent.
+   * @param  tz_index       timezone index for the node
+   * @return Returns true if access is allowed, false if not.
+   */
+  virtual bool Allowed(const baldr::DirectedEdge* edge,
+                       const EdgeLabel& pred,
+                       const baldr::GraphTile*& tile,
+                       const baldr::GraphId& edgeid,
+                       const uint64_t current_time,
+                       const uint32_t tz_index,
+                       bool& time_restricted) const;
+
+  /**
+   * Checks if access is allowed for an edge on the reverse path
+   * (from destination towards origin). Both opposing edges (current and
+   * predecessor) are provided. The access check is generally based on mode
+   * of travel and the access modes allowed on the edge. However, it can be
+   * extended to exclude access based on other parameters such as conditional
+   * restrictions and conditional access that can depend on time and travel
+   * mode.
+   * @param  edge           Pointer to a directed edge.
+   * @param  pred           Predecessor edge information.
+   * @param  opp_edge       Pointer to the opposing directed edge.
+   * @param  tile           Current tile.
+   * @param  edgeid         GraphId of the opposing edge.
+   * @param  current_time   Current time (seconds since epoch). A value of 0
+   *                        indicates the route is not time dependent.
+   * @param  tz_index       timezone index for the node
+   * @return  Returns true if access is allowed, false if not.
+   */
+  virtual bool AllowedReverse(const baldr::DirectedEdge* edge,
+                              const EdgeLabel& pred,
+                              const baldr::DirectedEdge* opp_edge,
+                              const baldr::GraphTile*& tile,
+                              const baldr::GraphId& opp_edgeid,
+                              const uint64_t current_time,
+                              const uint32_t tz_index,
+                              bool& has_time_restrictions) const;
+
+  /**
+   * Checks if access is allowed for the provided node. Node access can
+   * be restricted if bollards or gates are present.
+   * @param  node  Pointer to node information.
+   * @return  Returns true if access is allowed, false if not.
+   */
+  virtual bool Allowed(const baldr::NodeInfo* node) const {
+    return (node->access() & baldr::kMopedAccess);
+  }
+
+  /**
+   * Get the cost to traverse the specified directed edge. Cost includes
+   * the time (seconds) to traverse the edge.
+   * @param  edge      Pointer to a directed edge.
+   * @param  tile      Current tile.
+   * @param  seconds   Time of week in seconds.
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost EdgeCost(const baldr::DirectedEdge* edge,
+                        const baldr::GraphTile* tile,
+                        const uint32_t seconds) const;
+
+  /**
+   * Returns the cost to make the transition from the predecessor edge.
+   * Defaults to 0. Costing models that wish to include edge transition
+   * costs (i.e., intersection/turn costs) must override this method.
+   * @param  edge  Directed edge (the to edge)
+   * @param  node  Node (intersection) where transition occurs.
+   * @param  pred  Predecessor edge information.
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost TransitionCost(const baldr::DirectedEdge* edge,
+                              const baldr::NodeInfo* node,
+                              const EdgeLabel& pred) const;
+
+  /**
+   * Returns the cost to make the transition from the predecessor edge
+   * when using a reverse search (from destination towards the origin).
+   * @param  idx   Directed edge local index
+   * @param  node  Node (intersection) where transition occurs.
+   * @param  pred  the opposing current edge in the reverse tree.
+   * @param  edge  the opposing predecessor in the reverse tree
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost TransitionCostReverse(const uint32_t idx,
+                                     const baldr::NodeInfo* node,
+                                     const baldr::DirectedEdge* pred,
+                                     const baldr::DirectedEdge* edge) const;
+
+  // Public so the cost tests can inspect it
+public:
+  float speedfactor_[baldr::kMaxSpeedKph + 1];
+  float density_factor_[16]; // Density factor
+  float ferry_factor_;       // Weighting to apply to ferry edges
+
+  // Density factor used in edge transition costing
+  std::vector<float> trans_density_factor_;
+
+  uint32_t top_speed_; // Top speed the motorized scooter can go. Used to avoid roads
+                       // with higher speeds than it
+  float road_factor_;  // Road factor based on use_primary
+
+  // Elevation/grade penalty (weighting applied based on the edge's weighted
+  // grade (relative value from 0-15)
+  float grade_penalty_[16];
+
+protected:
+  MotorScooterCostBase(const Options& options, const TravelMode mode)
+      : DynamicCost(options, mode), trans_density_factor_{1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.1f,
+                                                          1.2f, 1.3f, 1.4f, 1.6f, 1.9f, 2.2f,
+                                                          2.5f, 2.8f, 3.1f, 3.5f} {
+  }
+
+  // Default turn costs
+  static constexpr float kTCStraight = 0.5f;
+  static constexpr float kTCSlight = 0.75f;
+  static constexpr float kTCFavorable = 1.0f;
+  static constexpr float kTCFavorableSharp = 1.5f;
+  static constexpr float kTCCrossing = 2.0f;
+  static constexpr float kTCUnfavorable = 2.5f;
+  static constexpr float kTCUnfavorableSharp = 3.5f;
+  static constexpr float kTCReverse = 5.0f;
+
+  // Turn costs based on side of street driving
+  static constexpr float kRightSideTurnCosts[] = {kTCStraight,    kTCSlight,
+                                                  kTCFavorable,   kTCFavorableSharp,
+                                                  kTCReverse,     kTCUnfavorableSharp,
+                                                  kTCUnfavorable, kTCSlight};
+  static constexpr float kLeftSideTurnCosts[] = {kTCStraight,         kTCSlight,  kTCUnfavorable,
+                                                 kTCUnfavorableSharp, kTCReverse, kTCFavorableSharp,
+                                                 kTCFavorable,        kTCSlight};
+
+  // Additional penalty to avoid destination only
+  static constexpr float kDestinationOnlyFactor = 0.2f;
+
+  // Weighting factor based on road class. These apply penalties to higher class
+  // roads. These penalties are modulated by the road factor - further
+  // avoiding higher class roads for those with low propensity for using
+  // primary roads.
+  static constexpr float kRoadClassFactor[] = {
+      1.0f,  // Motorway
+      0.5f,  // Trunk
+      0.2f,  // Primary
+      0.1f,  // Secondary
+      0.05f, // Tertiary
+      0.05f, // Unclassified
+      0.0f,  // Residential
+      0.5f   // Service, other
+  };
+  static constexpr float kGradeBasedSpeedFactor[] = {
+      1.25f, // -10%  - 45
+      1.2f,  // -8%   - 40.5
+      1.15f, // -6.5% - 36
+      1.1f,  // -5%   - 30.6
+      1.05f, // -3%   - 25
+      1.0f,  // -1.5% - 21.6
+      1.0f,  // 0%    - 18
+      1.0f,  // 1.5%  - 17
+      0.95f, // 3%    - 15
+      0.75f, // 5%    - 13.5
+      0.6f,  // 6.5%  - 12
+      0.5f,  // 8%    - 10
+      0.45f, // 10%   - 9
+      0.4f,  // 11.5% - 8
+      0.35f, // 13%   - 7
+      0.25f  // 15%   - 5.5
+  };
+  static constexpr float kSurfaceSpeedFactors[] = {1.0f, 1.0f, 0.9f, 0.6f, 0.1f, 0.0f, 0.0f, 0.0f};
+};
+
+// Check if access is allowed on the specified edge.
+inline bool MotorScooterCostBase::Allowed(const baldr::DirectedEdge* edge,
+                                          const EdgeLabel& pred,
+                                          const baldr::GraphTile*& tile,
+                                          const baldr::GraphId& edgeid,
+                                          const uint64_t current_time,
+                                          const uint32_t tz_index,
+                                          bool& has_time_restrictions) const {
+
+  // Check access, U-turn, and simple turn restriction.
+  // Allow U-turns at dead-end nodes.
+  if (!(edge->forwardaccess() & baldr::kMopedAccess) ||
+      (!pred.deadend() && pred.opp_local_idx() == edge->localedgeidx()) ||
+      (pred.restrictions() & (1 << edge->localedgeidx())) || IsUserAvoidEdge(edgeid) ||
+      (!allow_destination_only_ && !pred.destonly() && edge->destonly())) {
+    return false;
+  }
+  if (edge->surface() > kMinimumScooterSurface) {
+    return false;
+  }
+  return DynamicCost::EvaluateRestrictions(baldr::kMopedAccess, edge, tile, edgeid, current_time,
+                                           tz_index, has_time_restrictions);
+}
+
+// Checks if access is allowed for an edge on the reverse path (from
+// destination towards origin). Both opposing edges are provided.
+inline bool MotorScooterCostBase::AllowedReverse(const baldr::DirectedEdge* edge,
+                                                 const EdgeLabel& pred,
+                                                 const baldr::DirectedEdge* opp_edge,
+                                                 const baldr::GraphTile*& tile,
+                                                 const baldr::GraphId& opp_edgeid,
+                                                 const uint64_t current_time,
+                                                 const uint32_t tz_index,
+                                                 bool& has_time_restrictions) const {
+
+  // Check access, U-turn, and simple turn restriction.
+  // Allow U-turns at dead-end nodes.
+  if (!(opp_edge->forwardaccess() & baldr::kMopedAccess) ||
+      (!pred.deadend() && pred.opp_local_idx() == edge->localedgeidx()) ||
+      (opp_edge->restrictions() & (1 << pred.opp_local_idx())) || IsUserAvoidEdge(opp_edgeid) ||
+      (!allow_destination_only_ && !pred.destonly() && opp_edge->destonly())) {
+    return false;
+  }
+  if (opp_edge->surface() > kMinimumScooterSurface) {
+    return false;
+  }
+  return DynamicCost::EvaluateRestrictions(baldr::kMopedAccess, edge, tile, opp_edgeid,
+                                           current_time, tz_index, has_time_restrictions);
+}
+
+inline Cost MotorScooterCostBase::EdgeCost(const baldr::DirectedEdge* edge,
+                                           const baldr::GraphTile* tile,
+                                           const uint32_t seconds) const {
+  auto speed = tile->GetSpeed(edge, flow_mask_, seconds);
+
+  if (edge->use() == baldr::Use::kFerry) {
+    float sec = (edge->length() * speedfactor_[speed]);
+    return {sec * ferry_factor_, sec};
+  }
+
+  uint32_t scooter_speed =
+      (std::min(top_speed_, speed) * kSurfaceSpeedFactors[static_cast<uint32_t>(edge->surface())] *
+       kGradeBasedSpeedFactor[static_cast<uint32_t>(edge->weighted_grade())]);
+
+  float speed_penalty = (speed > top_speed_) ? (speed - top_speed_) * 0.05f : 0.0f;
+  float factor = 1.0f + (density_factor_[edge->density()] - 0.85f) +
+                 (road_factor_ * kRoadClassFactor[static_cast<uint32_t>(edge->classification())]) +
+                 grade_penalty_[static_cast<uint32_t>(edge->weighted_grade())] + speed_penalty;
+
+  if (edge->destonly()) {
+    factor += kDestinationOnlyFactor;
+  }
+
+  float sec = (edge->length() * speedfactor_[scooter_speed]);
+  return {sec * factor, sec};
+}
+
+// Returns the time (in seconds) to make the transition from the predecessor
+inline Cost MotorScooterCostBase::TransitionCost(const baldr::DirectedEdge* edge,
+                                                 const baldr::NodeInfo* node,
+                                                 const EdgeLabel& pred) const {
+
+  // Get the transition cost for country crossing, ferry, gate, toll booth,
+  // destination only, alley, maneuver penalty
+  uint32_t idx = pred.opp_local_idx();
+  Cost c = base_transition_cost(node, edge, pred, idx);
+
+  // Transition time = densityfactor * stopimpact * turncost
+  if (edge->stopimpact(idx) > 0) {
+    float turn_cost;
+    if (edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
+      turn_cost = kTCCrossing;
+    } else {
+      turn_cost = (node->drive_on_right())
+                      ? kRightSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))]
+                      : kLeftSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))];
+    }
+
+    if ((edge->use() != baldr::Use::kRamp && pred.use() == baldr::Use::kRamp) ||
+        (edge->use() == baldr::Use::kRamp && pred.use() != baldr::Use::kRamp)) {
+      turn_cost += 1.5f;
+      if (edge->roundabout())
+        turn_cost += 0.5f;
+    }
+
+    // Separate time and penalty when traffic is present. With traffic, edge speeds account for
+    // much of the intersection transition time (TODO - evaluate different elapsed time settings).
+    // Still want to add a penalty so routes avoid high cost intersections.
+    float seconds = turn_cost * edge->stopimpact(idx);
+    // Apply density factor penality if there isnt traffic on this edge or youre not using traffic
+    if (!edge->has_flow_speed() || flow_mask_ == 0)
+      seconds *= trans_density_factor_[node->density()];
+
+    c.cost += seconds;
+    c.secs += seconds;
+  }
+  return c;
+}
+
+// Returns the cost to make the transition from the predecessor edge
+// when using a reverse search (from destination towards the origin).
+// pred is the opposing current edge in the reverse tree
+// edge is the opposing predecessor in the reverse tree
+inline Cost MotorScooterCostBase::TransitionCostReverse(const uint32_t idx,
+                                                        const baldr::NodeInfo* node,
+                                                        const baldr::DirectedEdge* pred,
+                                                        const baldr::DirectedEdge* edge) const {
+
+  // Get the transition cost for country crossing, ferry, gate, toll booth,
+  // destination only, alley, maneuver penalty
+  Cost c = base_transition_cost(node, edge, pred, idx);
+
+  // Transition time = densityfactor * stopimpact * turncost
+  if (edge->stopimpact(idx) > 0) {
+    float turn_cost;
+    if (edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
+      turn_cost = kTCCrossing;
+    } else {
+      turn_cost = (node->drive_on_right())
+                      ? kRightSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))]
+                      : kLeftSideTurnCosts[static_cast<uint32_t>(edge->turntype(idx))];
+    }
+
+    if ((edge->use() != baldr::Use::kRamp && pred->use() == baldr::Use::kRamp) ||
+        (edge->use() == baldr::Use::kRamp && pred->use() != baldr::Use::kRamp)) {
+      turn_cost += 1.5f;
+      if (edge->roundabout())
+        turn_cost += 0.5f;
+    }
+
+    // Separate time and penalty when traffic is present. With traffic, edge speeds account for
+    // much of the intersection transition time (TODO - evaluate different elapsed time settings).
+    // Still want to add a penalty so routes avoid high cost intersections.
+    float seconds = turn_cost * edge->stopimpact(idx);
+    // Apply density factor penality if there isnt traffic on this edge or youre not using traffic
+    if (!edge->has_flow_speed() || flow_mask_ == 0)
+      seconds *= trans_density_factor_[node->density()];
+
+    c.cost += seconds;
+    c.secs += seconds;
+  }
+  return c;
+}
+
 } // namespace sif
 } // namespace valhalla
 
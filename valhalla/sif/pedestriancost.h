@@ -3,8 +3,10 @@
 
 #include <cstdint>
 #include <valhalla/baldr/directededge.h>
+#include <valhalla/baldr/graphconstants.h>
 #include <valhalla/baldr/nodeinfo.h>
 #include <valhalla/baldr/rapidjson_utils.h>
+#include <valhalla/midgard/constants.h>
 #include <valhalla/proto/options.pb.h>
 #include <valhalla/sif/dynamiccost.h>
 
@@ -29,6 +31,402 @@ void ParsePedestrianCostOptions(const rapidjson::Document& doc,
  */
 cost_ptr_t CreatePedestrianCost(const Costing costing, const Options& options);
 
+/**
+ * What the path algorithms call on PedestrianCost (see pedestriancost.cc) for every edge they
+ * relax, along with the values it uses. DirectCost inlines it.
+ */
+class PedestrianCostBase : public DynamicCost {
+public:
+  /**
+   * Checks if the costing is exactly a PedestrianCost, whose per edge costing this is.
+   * @param  costing  Costing of a request.
+   * @return Returns false for any other costing, including the ones derived from it.
+   */
+  static bool Is(const DynamicCost& costing);
+
+  /**
+   * Checks if access is allowed for the provided directed edge.
+   * This is generally based on mode of travel and the access modes
+   * allowed on the edge. However, it can be extended to exclude access
+   * based on other parameters such as conditional restrictions and
+   * conditional access that can depend on time and travel mode.
+   * @param  edge           Pointer to a directed edge.
+   * @param  pred           Predecessor edge information.
+   * @param  tile           Current tile.
+   * @param  edgeid         GraphId of the directed edge.
+   * @param  current_time   Current time (seconds since epoch). A value of 0
+   *                        indicates the route is not time dependent.
+   * @param  tz_index       timezone index for the node
+   * @return Returns true if access is allowed, false if not.
+   */
+  virtual bool Allowed(const baldr::DirectedEdge* edge,
+                       const EdgeLabel& pred,
+                       const baldr::GraphTile*& tile,
+                       const baldr::GraphId& edgeid,
+                       const uint64_t current_time,
+                       const uint32_t tz_index,
+                       bool& time_restricted) const;
+
+  /**
+   * Checks if access is allowed for an edge on the reverse path
+   * (from destination towards origin). Both opposing edges (current and
+   * predecessor) are provided. The access check is generally based on mode
+   * of travel and the access modes allowed on the edge. However, it can be
+   * extended to exclude access based on other parameters such as conditional
+   * restrictions and conditional access that can depend on time and travel
+   * mode.
+   * @param  edge           Pointer to a directed edge.
+   * @param  pred           Predecessor edge information.
+   * @param  opp_edge       Pointer to the opposing directed edge.
+   * @param  tile           Current tile.
+   * @param  edgeid         GraphId of the opposing edge.
+   * @param  current_time   Current time (seconds since epoch). A value of 0
+   *                        indicates the route is not time dependent.
+   * @param  tz_index       timezone index for the node
+   * @return  Returns true if access is allowed, false if not.
+   */
+  virtual bool AllowedReverse(const baldr::DirectedEdge* edge,
+                              const EdgeLabel& pred,
+                              const baldr::DirectedEdge* opp_edge,
+                              const baldr::GraphTile*& tile,
+                              const baldr::GraphId& opp_edgeid,
+                              const uint64_t current_time,
+                              const uint32_t tz_index,
+                              bool& has_time_restrictions) const;
+
+  /**
+   * Checks if access is allowed for the provided node. Node access can
+   * be restricted if bollards or gates are present.
+   * @param  node  Pointer to node information.
+   * @return  Returns true if access is allowed, false if not.
+   */
+  virtual bool Allowed(const baldr::NodeInfo* node) const {
+    return (node->access() & access_mask_);
+  }
+
+  /**
+   * Get the cost to traverse the specified directed edge. Cost includes
+   * the time (seconds) to traverse the edge.
+   * @param  edge      Pointer to a directed edge.
+   * @param  tile      Current tile.
+   * @param  seconds   Time of week in seconds.
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost EdgeCost(const baldr::DirectedEdge* edge,
+                        const baldr::GraphTile* tile,
+                        const uint32_t seconds) const;
+
+  /**
+   * Returns the cost to make the transition from the predecessor edge.
+   * Defaults to 0. Costing models that wish to include edge transition
+   * costs (i.e., intersection/turn costs) must override this method.
+   * @param  edge  Directed edge (the to edge)
+   * @param  node  Node (intersection) where transition occurs.
+   * @param  pred  Predecessor edge information.
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost TransitionCost(const baldr::DirectedEdge* edge,
+                              const baldr::NodeInfo* node,
+                              const EdgeLabel& pred) const;
+
+  /**
+   * Returns the cost to make the transition from the predecessor edge
+   * when using a reverse search (from destination towards the origin).
+   * Defaults to 0. Costing models that wish to include edge transition
+   * costs (i.e., intersection/turn costs) must override this method.
+   * @param  idx   Directed edge local index
+   * @param  node  Node (intersection) where transition occurs.
+   * @param  pred  the opposing current edge in the reverse tree.
+   * @param  edge  the opposing predecessor in the reverse tree
+   * @return  Returns the cost and time (seconds)
+   */
+  virtual Cost TransitionCostReverse(const uint32_t idx,
+                                     const baldr::NodeInfo* node,
+                                     const baldr::DirectedEdge* pred,
+                                     const baldr::DirectedEdge* edge) const;
+
+public:
+  uint32_t access_mask_;
+
+  // Maximum pedestrian distance.
+  uint32_t max_distance_;
+
+  // Minimal surface type usable by the pedestrian type
+  baldr::Surface minimal_allowed_surface_;
+
+  uint32_t max_grade_;             // Maximum grade (percent).
+  baldr::SacScale max_hiking_difficulty_; // Max sac_scale (0 - 6)
+  float speedfactor_;              // Speed factor for costing. Based on speed.
+  float walkway_factor_;           // Factor for favoring walkways and paths.
+  float sidewalk_factor_;          // Factor for favoring sidewalks.
+  float alley_factor_;             // Avoid alleys factor.
+  float driveway_factor_;          // Avoid driveways factor.
+  float step_penalty_;             // Penalty applied to steps/stairs (seconds).
+
+  /**
+   * Override the base transition cost to not add maneuver penalties onto transit edges.
+   * Base transition cost that all costing methods use. Includes costs for
+   * country crossing, boarding a ferry, toll booth, gates, entering destination
+   * only, alleys, and maneuver penalties. Each costing method can provide different
+   * costs for these transitions (via costing options).
+   * @param node Node at the intersection where the edge transition occurs.
+   * @param edge Directed edge entering.
+   * @param pred Predecessor edge information.
+   * @param idx  Index used for name consistency.
+   * @return Returns the transition cost (cost, elapsed time).
+   */
+  sif::Cost base_transition_cost(const baldr::NodeInfo* node,
+                                 const baldr::DirectedEdge* edge,
+                                 const sif::EdgeLabel& pred,
+                                 const uint32_t idx) const {
+    // Cases with both time and penalty: country crossing, ferry, gate, toll booth
+    sif::Cost c;
+    if (node->type() == baldr::NodeType::kBorderControl) {
+      c += country_crossing_cost_;
+    }
+    if (node->type() == baldr::NodeType::kGate) {
+      c += gate_cost_;
+    }
+    if (node->type() == baldr::NodeType::kTollBooth) {
+      c += toll_booth_cost_;
+    }
+    if (edge->use() == baldr::Use::kFerry && pred.use() != baldr::Use::kFerry) {
+      c += ferry_transition_cost_;
+    }
+
+    // Additional penalties without any time cost
+    if (edge->destonly() && !pred.destonly()) {
+      c.cost += destination_only_penalty_;
+    }
+    if (edge->use() == baldr::Use::kAlley && pred.use() != baldr::Use::kAlley) {
+      c.cost += alley_penalty_;
+    }
+    if (!edge->link() && edge->use() != baldr::Use::kEgressConnection &&
+        edge->use() != baldr::Use::kPlatformConnection && !edge->name_consistency(idx)) {
+      c.cost += maneuver_penalty_;
+    }
+    return c;
+  }
+
+  /**
+   * Override the base transition cost to not add maneuver penalties onto transit edges.
+   * Base transition cost that all costing methods use. Includes costs for
+   * country crossing, boarding a ferry, toll booth, gates, entering destination
+   * only, alleys, and maneuver penalties. Each costing method can provide different
+   * costs for these transitions (via costing options).
+   * @param node Node at the intersection where the edge transition occurs.
+   * @param edge Directed edge entering.
+   * @param pred Predecessor edge.
+   * @param idx  Index used for name consistency.
+   * @return Returns the transition cost (cost, elapsed time).
+   */
+  sif::Cost base_transition_cost(const baldr::NodeInfo* node,
+                                 const baldr::DirectedEdge* edge,
+                                 const baldr::DirectedEdge* pred,
+                                 const uint32_t idx) const {
+    // Cases with both time and penalty: country crossing, ferry, gate, toll booth
+    sif::Cost c;
+    if (node->type() == baldr::NodeType::kBorderControl) {
+      c += country_crossing_cost_;
+    }
+    if (node->type() == baldr::NodeType::kGate) {
+      c += gate_cost_;
+    }
+    if (node->type() == baldr::NodeType::kTollBooth) {
+      c += toll_booth_cost_;
+    }
+    if (edge->use() == baldr::Use::kFerry && pred->use() != baldr::Use::kFerry) {
+      c += ferry_transition_cost_;
+    }
+
+    // Additional penalties without any time cost
+    if (edge->destonly() && !pred->destonly()) {
+      c.cost += destination_only_penalty_;
+    }
+    if (edge->use() == baldr::Use::kAlley && pred->use() != baldr::Use::kAlley) {
+      c.cost += alley_penalty_;
+    }
+    if (!edge->link() && edge->use() != baldr::Use::kEgressConnection &&
+        edge->use() != baldr::Use::kPlatformConnection && !edge->name_consistency(idx)) {
+      c.cost += maneuver_penalty_;
+    }
+    return c;
+  }
+
+protected:
+  PedestrianCostBase(const Options& options, const TravelMode mode) : DynamicCost(options, mode) {
+  }
+
+  // Avoid roundabouts
+  static constexpr float kRoundaboutFactor = 2.0f;
+
+  // Crossing penalties. TODO - may want to lower stop impact when
+  // 2 cycleways or walkways cross
+  static constexpr uint32_t kCrossingCosts[] = {0, 0, 1, 1, 2, 3, 5, 15};
+  static constexpr float kSacScaleSpeedFactor[] = {
+      1.0f,  // kNone
+      1.11f, // kHiking (~90% speed)
+      1.25f, // kMountainHiking (80% speed)
+      1.54f, // kDemandingMountainHiking (~65% speed)
+      2.5f,  // kAlpineHiking (40% speed)
+      4.0f,  // kDemandingAlpineHiking (25% speed)
+      6.67f  // kDifficultAlpineHiking (~15% speed)
+  };
+  static constexpr float kSacScaleCostFactor[] = {
+      0.0f,  // kNone
+      0.25f, // kHiking
+      0.75f, // kMountainHiking
+      1.25f, // kDemandingMountainHiking
+      2.0f,  // kAlpineHiking
+      2.5f,  // kDemandingAlpineHiking
+      3.0f   // kDifficultAlpineHiking
+  };
+};
+
+// Check if access is allowed on the specified edge. Disallow if no
+// access for this pedestrian type, if surface type exceeds (worse than)
+// the minimum allowed surface type, or if max grade is exceeded.
+// Disallow edges where max. distance will be exceeded.
+inline bool PedestrianCostBase::Allowed(const baldr::DirectedEdge* edge,
+                                        const EdgeLabel& pred,
+                                        const baldr::GraphTile*& tile,
+                                        const baldr::GraphId& edgeid,
+                                        const uint64_t current_time,
+                                        const uint32_t tz_index,
+                                        bool& has_time_restrictions) const {
+  if (!(edge->forwardaccess() & access_mask_) || (edge->surface() > minimal_allowed_surface_) ||
+      edge->is_shortcut() || IsUserAvoidEdge(edgeid) ||
+      edge->sac_scale() > max_hiking_difficulty_ ||
+      //      (edge->max_up_slope() > max_grade_ || edge->max_down_slope() > max_grade_) ||
+      ((pred.path_distance() + edge->length()) > max_distance_)) {
+    return false;
+  }
+  // Disallow transit connections (except when set for multi-modal routes)
+  if (!allow_transit_connections_ &&
+      (edge->use() == baldr::Use::kPlatformConnection ||
+       edge->use() == baldr::Use::kEgressConnection ||
+       edge->use() == baldr::Use::kTransitConnection)) {
+    return false;
+  }
+
+  return DynamicCost::EvaluateRestrictions(access_mask_, edge, tile, edgeid, current_time, tz_index,
+                                           has_time_restrictions);
+}
+
+// Checks if access is allowed for an edge on the reverse path (from
+// destination towards origin). Both opposing edges are provided.
+inline bool PedestrianCostBase::AllowedReverse(const baldr::DirectedEdge* edge,
+                                               const EdgeLabel& pred,
+                                               const baldr::DirectedEdge* opp_edge,
+                                               const baldr::GraphTile*& tile,
+                                               const baldr::GraphId& opp_edgeid,
+                                               const uint64_t current_time,
+                                               const uint32_t tz_index,
+                                               bool& has_time_restrictions) const {
+
+  // TODO - obtain and check the access restrictions.
+
+  // Do not check max walking distance and assume we are not allowing
+  // transit connections. Assume this method is never used in
+  // multimodal routes).
+  if (!(opp_edge->forwardaccess() & access_mask_) ||
+      (opp_edge->surface() > minimal_allowed_surface_) || opp_edge->is_shortcut() ||
+      IsUserAvoidEdge(opp_edgeid) || edge->sac_scale() > max_hiking_difficulty_ ||
+      //      (opp_edge->max_up_slope() > max_grade_ || opp_edge->max_down_slope() > max_grade_) ||
+      opp_edge->use() == baldr::Use::kTransitConnection ||
+      opp_edge->use() == baldr::Use::kEgressConnection ||
+      opp_edge->use() == baldr::Use::kPlatformConnection) {
+    return false;
+  }
+
+  return DynamicCost::EvaluateRestrictions(access_mask_, edge, tile, opp_edgeid, current_time,
+                                           tz_index, has_time_restrictions);
+}
+
+// Returns the cost to traverse the edge and an estimate of the actual time
+// (in seconds) to traverse the edge.
+inline Cost PedestrianCostBase::EdgeCost(const baldr::DirectedEdge* edge,
+                                         const baldr::GraphTile* tile,
+                                         const uint32_t seconds) const {
+
+  // Ferries are a special case - they use the ferry speed (stored on the edge)
+  if (edge->use() == baldr::Use::kFerry) {
+    auto speed = tile->GetSpeed(edge, flow_mask_, seconds);
+    float sec = edge->length() * (midgard::kSecPerHour * 0.001f) / static_cast<float>(speed);
+    return {sec * ferry_factor_, sec};
+  }
+
+  // TODO - consider using an array of "use factors" to avoid this conditional
+  float factor = 1.0f + kSacScaleCostFactor[static_cast<uint8_t>(edge->sac_scale())];
+  if (edge->use() == baldr::Use::kFootway || edge->use() == baldr::Use::kSidewalk) {
+    factor *= walkway_factor_;
+  } else if (edge->use() == baldr::Use::kAlley) {
+    factor *= alley_factor_;
+  } else if (edge->use() == baldr::Use::kDriveway) {
+    factor *= driveway_factor_;
+  } else if (edge->sidewalk_left() || edge->sidewalk_right()) {
+    factor *= sidewalk_factor_;
+  } else if (edge->roundabout()) {
+    factor *= kRoundaboutFactor;
+  }
+
+  // Slightly favor walkways/paths and penalize alleys and driveways.
+  float sec =
+      edge->length() * speedfactor_ * kSacScaleSpeedFactor[static_cast<uint8_t>(edge->sac_scale())];
+  return {sec * factor, sec};
+}
+
+// Returns the time (in seconds) to make the transition from the predecessor
+inline Cost PedestrianCostBase::TransitionCost(const baldr::DirectedEdge* edge,
+                                               const baldr::NodeInfo* node,
+                                               const EdgeLabel& pred) const {
+
+  // Special cases: fixed penalty for steps/stairs
+  if (edge->use() == baldr::Use::kSteps) {
+    return {step_penalty_, 0.0f};
+  }
+
+  // Get the transition cost for country crossing, ferry, gate, toll booth,
+  // destination only, alley, maneuver penalty
+  uint32_t idx = pred.opp_local_idx();
+  Cost c = base_transition_cost(node, edge, pred, idx);
+
+  // Costs for crossing an intersection.
+  if (edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
+    float seconds = kCrossingCosts[edge->stopimpact(idx)];
+    c.secs += seconds;
+    c.cost += seconds;
+  }
+  return c;
+}
+
+// Returns the cost to make the transition from the predecessor edge
+// when using a reverse search (from destination towards the origin).
+// Defaults to 0. Costing models that wish to include edge transition
+// costs (i.e., intersection/turn costs) must override this method.
+inline Cost PedestrianCostBase::TransitionCostReverse(const uint32_t idx,
+                                                      const baldr::NodeInfo* node,
+                                                      const baldr::DirectedEdge* pred,
+                                                      const baldr::DirectedEdge* edge) const {
+
+  // Special cases: fixed penalty for steps/stairs
+  if (edge->use() == baldr::Use::kSteps) {
+    return {step_penalty_, 0.0f};
+  }
+
+  // Get the transition cost for country crossing, ferry, gate, toll booth,
+  // destination only, alley, maneuver penalty
+  Cost c = base_transition_cost(node, edge, pred, idx);
+
+  // Costs for crossing an intersection.
+  if (edge->edge_to_right(idx) && edge->edge_to_left(idx)) {
+    float seconds = kCrossingCosts[edge->stopimpact(idx)];
+    c.secs += seconds;
+    c.cost += seconds;
+  }
+  return c;
+}
+
 } // namespace sif
 } // namespace valhalla
 
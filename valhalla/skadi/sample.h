@@ -3,6 +3,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -25,8 +26,16 @@ public:
   /**
    * Constructor
    * @param data_source  directory name of the datasource from which to sample
+   * @param cache_size   bytes of decompressed tiles to keep in memory. the cache is shared by all
+   *                     samples of the same datasource in the process and uses the largest size
    */
-  sample(const std::string& data_source);
+  sample(const std::string& data_source, size_t cache_size = kDefaultCacheSize);
+
+  // bytes of a decompressed data tile (about 25MB)
+  static constexpr size_t kTileSize = 3601 * 3601 * sizeof(int16_t);
+
+  // by default keep a handful of decompressed tiles around
+  static constexpr size_t kDefaultCacheSize = 8 * kTileSize;
 
   /**
    * Get a single sample from the datasource
@@ -35,7 +44,8 @@ public:
   template <class coord_t> double get(const coord_t& coord) const;
 
   /**
-   * Get multiple samples from the datasource
+   * Get multiple samples from the datasource. The postings are grouped by data tile so
+   * that each tile is fetched (and decompressed) at most once per call
    * @param coords  the list of postings at which to sample the datasource
    */
   template <class coords_t> std::vector<double> get_all(const coords_t& coords) const;
@@ -46,11 +56,15 @@ public:
   static double get_no_data_value();
 
 protected:
+  // a decompressed data tile
+  using tile_t = std::shared_ptr<const std::vector<int16_t>>;
+
   /**
-   * @param  index  the index of the data tile being requested
+   * @param  index     the index of the data tile being requested
+   * @param  unzipped  holds on to the decompressed tile (if it was compressed) while it is in use
    * @return the array of data or nullptr if there was none
    */
-  const int16_t* source(uint16_t index) const;
+  const int16_t* source(uint16_t index, tile_t& unzipped) const;
 
   enum class format_t { UNKNOWN = 0, GZIP = 1, RAW = 3 };
   /**
@@ -66,9 +80,12 @@ protected:
   // using memory maps
   mutable std::vector<std::pair<format_t, midgard::mem_map<char>>> mapped_cache;
 
-  // TODO: make an LRU
-  using unzipped_t = std::pair<int16_t, std::vector<int16_t>>;
-  mutable unzipped_t unzipped_cache;
+  // sources can be lazily mapped from multiple threads
+  std::unique_ptr<std::mutex> mapped_lock;
+
+  // LRU of decompressed tiles shared by all samples of this data source
+  class tile_cache_t;
+  std::shared_ptr<tile_cache_t> unzipped_cache;
 
   std::string data_source;
 };
@@ -11,6 +11,7 @@
 #include <valhalla/baldr/double_bucket_queue.h>
 #include <valhalla/baldr/graphid.h>
 #include <valhalla/baldr/graphreader.h>
+#include <valhalla/sif/costdispatch.h>
 #include <valhalla/sif/dynamiccost.h>
 #include <valhalla/sif/edgelabel.h>
 #include <valhalla/sif/hierarchylimits.h>
@@ -109,6 +110,16 @@ protected:
    */
   virtual void Init(const midgard::PointLL& origll, const midgard::PointLL& destll);
 
+  /**
+   * Clear the temporary information generated during path construction. The
+   * memory of the edge labels, edge status and adjacency list is kept for the
+   * next search unless it is above the high-water mark of the working memory.
+   * @param  reserved  Memory (bytes) also kept by a derived class.
+   * @param  searched  Whether a search ran since the last clear.
+   * @return Returns true if the memory was released.
+   */
+  bool ClearWorkingMemory(const size_t reserved, const bool searched);
+
   /**
    * Modify hierarchy limits based on distance between origin and destination
    * and the relative road density at the destination. For shorter routes
@@ -125,6 +136,7 @@ protected:
    * from the end node of any transition edge (so no transition edges are added
    * to the adjacency list or EdgeLabel list). Does not expand transition
    * edges if from_transition is false.
+   * @param  costing      Costing of the request (see sif::visit_costing).
    * @param  graphreader  Graph tile reader.
    * @param  node         Graph Id of the node being expanded.
    * @param  pred         Predecessor edge label (for costing).
@@ -133,7 +145,9 @@ protected:
    *                         edge.
    * @param   dest        Location information of the destination.
    */
-  void ExpandForward(baldr::GraphReader& graphreader,
+  template <class costing_t>
+  void ExpandForward(const sif::DirectCost<costing_t>& costing,
+                     baldr::GraphReader& graphreader,
                      const baldr::GraphId& node,
                      const sif::EdgeLabel& pred,
                      const uint32_t pred_idx,
@@ -141,6 +155,22 @@ protected:
                      const valhalla::Location& dest,
                      std::pair<int32_t, float>& best_path);
 
+  /**
+   * Run the search once the origin and destination are set.
+   * @param  costing      Costing of the request (see sif::visit_costing).
+   * @param  graphreader  Graph tile reader.
+   * @param  origin       Location information of the origin.
+   * @param  dest         Location information of the destination.
+   * @param  mindist      Distance from the origin to the destination.
+   * @return Returns the path edges or an empty list if no path was found.
+   */
+  template <class costing_t>
+  std::vector<std::vector<PathInfo>> Expand(const sif::DirectCost<costing_t>& costing,
+                                            baldr::GraphReader& graphreader,
+                                            valhalla::Location& origin,
+                                            const valhalla::Location& dest,
+                                            float mindist);
+
   /**
    * Add edges at the origin to the adjacency list.
    * @param  graphreader  Graph tile reader.
@@ -60,6 +60,7 @@ const std::string kEdgeMaxDownwardGrade = "edge.max_downward_grade";
 const std::string kEdgeMeanElevation = "edge.mean_elevation";
 const std::string kEdgeLaneCount = "edge.lane_count";
 const std::string kEdgeLaneConnectivity = "edge.lane_connectivity";
+const std::string kEdgeTurnLanes = "edge.turn_lanes";
 const std::string kEdgeCycleLane = "edge.cycle_lane";
 const std::string kEdgeBicycleNetwork = "edge.bicycle_network";
 const std::string kEdgeSidewalk = "edge.sidewalk";
@@ -130,6 +131,8 @@ const std::string kShapeAttributesLength = "shape_attributes.length";
 const std::string kShapeAttributesSpeed = "shape_attributes.speed";
 
 // Categories
+const std::string kEdgeSignCategory = "edge.sign.";
+const std::string kNodeIntersectingEdgeCategory = "node.intersecting_edge.";
 const std::string kNodeCategory = "node.";
 const std::string kAdminCategory = "admin.";
 const std::string kMatchedCategory = "matched.";
@@ -163,6 +166,92 @@ struct AttributesController {
   std::unordered_map<std::string, bool> attributes;
 };
 
+/**
+ * The attributes of a controller compiled into flags for the trip leg builder. The builder checks
+ * dozens of attributes for every edge and node of a path, which is a flag test instead of a hash
+ * lookup this way. The group flags let it skip whole lookups (signs, turn lanes, lane connectivity,
+ * intersecting edges, admins) when none of their attributes were requested.
+ */
+struct FieldPlan {
+  /**
+   * Compile the attributes of a controller. The plan only refers to the controller for the
+   * attributes of rarely used groups (transit) so it must outlive the plan.
+   */
+  explicit FieldPlan(const AttributesController& controller);
+
+  const AttributesController& controller;
+
+  // Groups of attributes that need a lookup of their own
+  bool edge_signs;
+  bool edge_headings;
+  bool intersecting_edges;
+  bool admins;
+  bool shape_attributes;
+
+  // Edge attributes
+  bool edge_names;
+  bool edge_length;
+  bool edge_speed;
+  bool edge_road_class;
+  bool edge_begin_heading;
+  bool edge_end_heading;
+  bool edge_begin_shape_index;
+  bool edge_end_shape_index;
+  bool edge_traversability;
+  bool edge_use;
+  bool edge_toll;
+  bool edge_unpaved;
+  bool edge_tunnel;
+  bool edge_bridge;
+  bool edge_roundabout;
+  bool edge_internal_intersection;
+  bool edge_drive_on_right;
+  bool edge_surface;
+  bool edge_travel_mode;
+  bool edge_vehicle_type;
+  bool edge_pedestrian_type;
+  bool edge_bicycle_type;
+  bool edge_id;
+  bool edge_way_id;
+  bool edge_weighted_grade;
+  bool edge_max_upward_grade;
+  bool edge_max_downward_grade;
+  bool edge_mean_elevation;
+  bool edge_lane_count;
+  bool edge_lane_connectivity;
+  bool edge_turn_lanes;
+  bool edge_cycle_lane;
+  bool edge_bicycle_network;
+  bool edge_sidewalk;
+  bool edge_density;
+  bool edge_speed_limit;
+  bool edge_default_speed;
+  bool edge_truck_speed;
+  bool edge_truck_route;
+
+  // Intersecting edge attributes
+  bool intersecting_edge_begin_heading;
+  bool intersecting_edge_from_edge_name_consistency;
+  bool intersecting_edge_to_edge_name_consistency;
+  bool intersecting_edge_driveability;
+  bool intersecting_edge_cyclability;
+  bool intersecting_edge_walkability;
+  bool intersecting_edge_use;
+  bool intersecting_edge_road_class;
+
+  // Node attributes
+  bool node_elapsed_time;
+  bool node_admin_index;
+  bool node_type;
+  bool node_fork;
+  bool node_time_zone;
+  bool node_transition_time;
+
+  // Top level attributes
+  bool osm_changeset;
+  bool shape;
+};
+
 } // namespace thor
 } // namespace valhalla
 
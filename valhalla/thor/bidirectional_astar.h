@@ -5,11 +5,13 @@
 #include <map>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include <valhalla/baldr/double_bucket_queue.h>
 #include <valhalla/proto/api.pb.h>
+#include <valhalla/sif/costdispatch.h>
 #include <valhalla/sif/edgelabel.h>
 #include <valhalla/sif/hierarchylimits.h>
 #include <valhalla/thor/astarheuristic.h>
@@ -112,6 +114,11 @@ protected:
   float threshold_;
   CandidateConnection best_connection_;
 
+  // Number of paths wanted (1 + alternates) and the connections found between
+  // the searches, which are the candidate alternates
+  uint32_t desired_paths_count_;
+  std::vector<CandidateConnection> candidates_;
+
   /**
    * Initialize the A* heuristic and adjacency lists for both the forward
    * and reverse search.
@@ -123,13 +130,17 @@ protected:
   /**
    * Expand from the node along the forward search path.
    */
-  bool ExpandForward(baldr::GraphReader& graphreader,
+  template <class costing_t>
+  bool ExpandForward(const sif::DirectCost<costing_t>& costing,
+                     baldr::GraphReader& graphreader,
                      const baldr::GraphId& node,
                      sif::BDEdgeLabel& pred,
                      const uint32_t pred_idx,
                      const bool from_transition);
   // Private helper function for `ExpandForward`
-  bool ExpandForwardInner(baldr::GraphReader& graphreader,
+  template <class costing_t>
+  bool ExpandForwardInner(const sif::DirectCost<costing_t>& costing,
+                          baldr::GraphReader& graphreader,
                           const sif::BDEdgeLabel& pred,
                           const baldr::NodeInfo* nodeinfo,
                           const uint32_t pred_idx,
@@ -140,7 +151,9 @@ protected:
   /**
    * Expand from the node along the reverse search path.
    */
-  bool ExpandReverse(baldr::GraphReader& graphreader,
+  template <class costing_t>
+  bool ExpandReverse(const sif::DirectCost<costing_t>& costing,
+                     baldr::GraphReader& graphreader,
                      const baldr::GraphId& node,
                      sif::BDEdgeLabel& pred,
                      const uint32_t pred_idx,
@@ -148,7 +161,9 @@ protected:
                      const bool from_transition);
 
   // Private helper function for `ExpandReverse`
-  bool ExpandReverseInner(baldr::GraphReader& graphreader,
+  template <class costing_t>
+  bool ExpandReverseInner(const sif::DirectCost<costing_t>& costing,
+                          baldr::GraphReader& graphreader,
                           const sif::BDEdgeLabel& pred,
                           const baldr::DirectedEdge* opp_pred_edge,
                           const baldr::NodeInfo* nodeinfo,
@@ -156,6 +171,19 @@ protected:
                           const EdgeMetadata& meta,
                           uint32_t& shortcuts,
                           const baldr::GraphTile* tile);
+
+  /**
+   * Run the search once the origin and destination are set.
+   * @param  costing      Costing of the request (see sif::visit_costing).
+   * @param  graphreader  Graph tile reader.
+   * @param  options      Request options.
+   * @return Returns the path edges or an empty list if no path was found.
+   */
+  template <class costing_t>
+  std::vector<std::vector<PathInfo>> Expand(const sif::DirectCost<costing_t>& costing,
+                                            baldr::GraphReader& graphreader,
+                                            const Options& options);
+
   /**
    * Add edges at the origin to the forward adjacency list.
    * @param  graphreader  Graph tile reader.
@@ -197,10 +225,32 @@ protected:
    * @param   options      Controls whether or not we get alternatives
    * @return  Returns the path infos, a list of GraphIds representing the
    *          directed edges along the path - ordered from origin to
-   *          destination - along with travel modes and elapsed time.
+   *          destination - along with travel modes and elapsed time. Any
+   *          alternates follow the best path.
    */
   std::vector<std::vector<PathInfo>> FormPath(baldr::GraphReader& graphreader,
                                               const Options& options);
+
+  /**
+   * Form the path through a connection between the forward and reverse search trees.
+   * @param   connection  Connection between the search trees.
+   * @return  Returns the path infos ordered from origin to destination.
+   */
+  std::vector<PathInfo> FormPath(const CandidateConnection& connection);
+
+  /**
+   * Check if the path through a connection is a good alternate to the paths found
+   * so far: it must not double back on itself (a cheap stand in for checking the
+   * path is locally optimal around the connection) and must not share too much of
+   * its length with any of the paths.
+   * @param   graphreader  Graph tile reader.
+   * @param   path         Path through the connection.
+   * @param   path_edges   Edges of the paths found so far.
+   * @return  Returns true if the path should be returned as an alternate.
+   */
+  bool IsValidAlternate(baldr::GraphReader& graphreader,
+                        const std::vector<PathInfo>& path,
+                        const std::vector<std::unordered_set<baldr::GraphId>>& path_edges);
 };
 
 // This function checks if the path formed by the two expanding trees
@@ -13,6 +13,7 @@
 #include <valhalla/baldr/graphid.h>
 #include <valhalla/baldr/graphreader.h>
 #include <valhalla/proto/tripcommon.pb.h>
+#include <valhalla/sif/costdispatch.h>
 #include <valhalla/sif/dynamiccost.h>
 #include <valhalla/sif/edgelabel.h>
 #include <valhalla/thor/edgestatus.h>
@@ -178,13 +179,27 @@ protected:
   void Initialize(const google::protobuf::RepeatedPtrField<valhalla::Location>& source_location_list,
                   const google::protobuf::RepeatedPtrField<valhalla::Location>& target_location_list);
 
+  /**
+   * Alternate the backward and forward searches until every source and
+   * target location is done.
+   * @param  costing      Costing of the request (see sif::visit_costing).
+   * @param  graphreader  Graph reader for accessing routing graph.
+   */
+  template <class costing_t>
+  void Expand(const sif::DirectCost<costing_t>& costing, baldr::GraphReader& graphreader);
+
   /**
    * Iterate the forward search from the source/origin location.
+   * @param  costing      Costing of the request (see sif::visit_costing).
    * @param  index        Index of the source location.
    * @param  n            Iteration counter.
    * @param  graphreader  Graph reader for accessing routing graph.
    */
-  void ForwardSearch(const uint32_t index, const uint32_t n, baldr::GraphReader& graphreader);
+  template <class costing_t>
+  void ForwardSearch(const sif::DirectCost<costing_t>& costing,
+                     const uint32_t index,
+                     const uint32_t n,
+                     baldr::GraphReader& graphreader);
 
   /**
    * Check if the edge on the forward search connects to a reached edge
@@ -204,10 +219,14 @@ protected:
 
   /**
    * Iterate the backward search from the target/destination location.
+   * @param  costing      Costing of the request (see sif::visit_costing).
    * @param  index        Index of the target location.
    * @param  graphreader  Graph reader for accessing routing graph.
    */
-  void BackwardSearch(const uint32_t index, baldr::GraphReader& graphreader);
+  template <class costing_t>
+  void BackwardSearch(const sif::DirectCost<costing_t>& costing,
+                      const uint32_t index,
+                      baldr::GraphReader& graphreader);
 
   /**
    * Sets the source/origin locations. Search expands forward from these
@@ -13,9 +13,11 @@
 #include <valhalla/baldr/graphreader.h>
 #include <valhalla/baldr/location.h>
 #include <valhalla/proto/tripcommon.pb.h>
+#include <valhalla/sif/costdispatch.h>
 #include <valhalla/sif/dynamiccost.h>
 #include <valhalla/sif/edgelabel.h>
 #include <valhalla/thor/edgestatus.h>
+#include <valhalla/thor/workingmemory.h>
 
 namespace valhalla {
 namespace thor {
@@ -46,6 +48,15 @@ public:
    */
   virtual void Clear();
 
+  /**
+   * Get the working memory kept between expansions, to set its high-water mark
+   * or read its counters.
+   * @return Returns the working memory.
+   */
+  WorkingMemory& working_memory() {
+    return working_memory_;
+  }
+
   /**
    * Compute the best first graph traversal from a list of origin locations
    * @param  origin_locs  List of origin locations.
@@ -129,6 +140,9 @@ protected:
   // Edge status. Mark edges that are in adjacency list or settled.
   EdgeStatus edgestatus_;
 
+  // Edge labels, edge status and adjacency list kept between expansions
+  WorkingMemory working_memory_;
+
   /**
    * Initialization prior to computing the graph expansion
    *
@@ -156,6 +170,7 @@ protected:
 
   /**
    * Expand from the node along the forward search path.
+   * @param costing Costing of the request (see sif::visit_costing).
    * @param graphreader  Graph reader.
    * @param node Graph Id of the node to expand.
    * @param pred Edge label of the predecessor edge leading to the node.
@@ -164,7 +179,9 @@ protected:
    * @param localtime Current local time.  Seconds since epoch.
    * @param seconds_of_week For time dependent Dijkstrass this allows lookup of predicted traffic.
    */
-  void ExpandForward(baldr::GraphReader& graphreader,
+  template <class costing_t>
+  void ExpandForward(const sif::DirectCost<costing_t>& costing,
+                     baldr::GraphReader& graphreader,
                      const baldr::GraphId& node,
                      const sif::EdgeLabel& pred,
                      const uint32_t pred_idx,
@@ -172,8 +189,22 @@ protected:
                      uint64_t localtime,
                      int32_t seconds_of_week);
 
+  /**
+   * Run the forward traversal once the origins are set.
+   * @param costing Costing of the request (see sif::visit_costing).
+   * @param graphreader  Graph reader.
+   * @param start_time Local time at the origins. Seconds since epoch.
+   * @param start_seconds_of_week Seconds from the beginning of the week at the origins.
+   */
+  template <class costing_t>
+  void Traverse(const sif::DirectCost<costing_t>& costing,
+                baldr::GraphReader& graphreader,
+                const uint64_t start_time,
+                const uint32_t start_seconds_of_week);
+
   /**
    * Expand from the node along the reverse search path.
+   * @param costing Costing of the request (see sif::visit_costing).
    * @param graphreader  Graph reader.
    * @param node Graph Id of the node to expand.
    * @param pred Edge label of the predecessor edge leading to the node.
@@ -182,7 +213,9 @@ protected:
    * @param localtime Current local time.  Seconds since epoch.
    * @param seconds_of_week For time dependent Dijkstrass this allows lookup of predicted traffic.
    */
-  void ExpandReverse(baldr::GraphReader& graphreader,
+  template <class costing_t>
+  void ExpandReverse(const sif::DirectCost<costing_t>& costing,
+                     baldr::GraphReader& graphreader,
                      const baldr::GraphId& node,
                      const sif::BDEdgeLabel& pred,
                      const uint32_t pred_idx,
@@ -191,6 +224,19 @@ protected:
                      uint64_t localtime,
                      int32_t seconds_of_week);
 
+  /**
+   * Run the reverse traversal once the destinations are set.
+   * @param costing Costing of the request (see sif::visit_costing).
+   * @param graphreader  Graph reader.
+   * @param start_time Local time at the destinations. Seconds since epoch.
+   * @param start_seconds_of_week Seconds from the beginning of the week at the destinations.
+   */
+  template <class costing_t>
+  void TraverseReverse(const sif::DirectCost<costing_t>& costing,
+                       baldr::GraphReader& graphreader,
+                       const uint64_t start_time,
+                       const uint32_t start_seconds_of_week);
+
   /**
    * Expand from the node using multimodal algorithm.
    * @param graphreader  Graph reader.
@@ -1,7 +1,12 @@
 #ifndef VALHALLA_THOR_EDGESTATUS_H_
 #define VALHALLA_THOR_EDGESTATUS_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <unordered_map>
+#include <vector>
+
 #include <valhalla/baldr/graphid.h>
 #include <valhalla/baldr/graphtile.h>
 
@@ -19,6 +24,9 @@ enum class EdgeSet : uint8_t {
                          //   be "adjacent" to an edge that is permanently labeled.
 };
 
+// Minimum number of EdgeStatusInfo in a block of the arena backing EdgeStatus
+constexpr uint32_t kMinEdgeStatusBlockSize = 65536;
+
 // Store the edge label status and its index in the EdgeLabels list
 struct EdgeStatusInfo {
   uint32_t index_ : 28;
@@ -47,27 +55,51 @@ struct EdgeStatusInfo {
  * edges within arrays for each tile. This allows the path algorithms to get
  * a pointer to the first edge status and iterate that pointer over sequential
  * edges. This reduces the number of map lookups.
+ *
+ * The arrays are carved out of blocks that are kept when the status is cleared,
+ * so a path algorithm reusing its EdgeStatus for many searches only allocates
+ * when a search touches more edges than any search before it.
  */
 class EdgeStatus {
 public:
   /**
-   * Destructor. Delete any allocated EdgeStatusInfo arrays.
+   * Clear the EdgeStatusInfo arrays and the edge status map. The memory of the
+   * arrays is kept for the next search.
    */
-  ~EdgeStatus() {
-    clear();
+  void clear() {
+    // Reset the part of each block that was handed out
+    for (auto& block : blocks_) {
+      std::fill(block.data.get(), block.data.get() + block.used, EdgeStatusInfo());
+      block.used = 0;
+    }
+    current_block_ = 0;
+    edgestatus_.clear();
   }
 
   /**
-   * Clear the EdgeStatusInfo arrays and the edge status map.
+   * Clear the edge status and free the memory of the arrays.
    */
-  void clear() {
-    // Delete any allocated arrays for tiles within the map.
-    for (auto& iter : edgestatus_) {
-      delete[] iter.second;
-    }
+  void release() {
+    blocks_.clear();
+    current_block_ = 0;
+    reserved_ = 0;
     edgestatus_.clear();
   }
 
+  /**
+   * Returns the memory (bytes) reserved for the EdgeStatusInfo arrays.
+   */
+  size_t reserved() const {
+    return reserved_ * sizeof(EdgeStatusInfo);
+  }
+
+  /**
+   * Returns the number of blocks allocated since construction.
+   */
+  uint64_t allocations() const {
+    return allocations_;
+  }
+
   /**
    * Set the status of a directed edge given its GraphId.
    * @param  edgeid   GraphId of the directed edge to set.
@@ -86,7 +118,7 @@ public:
       // Tile is not in the map. Add an array of EdgeStatusInfo, sized to
       // the number of directed edges in the specified tile.
       auto inserted = edgestatus_.emplace(edgeid.tile_value(),
-                                          new EdgeStatusInfo[tile->header()->directededgecount()]);
+                                          allocate(tile->header()->directededgecount()));
       inserted.first->second[edgeid.id()] = {set, index};
     }
   }
@@ -132,16 +164,52 @@ public:
       // Tile is not in the map. Add an array of EdgeStatusInfo, sized to
       // the number of directed edges in the specified tile.
       auto inserted = edgestatus_.emplace(edgeid.tile_value(),
-                                          new EdgeStatusInfo[tile->header()->directededgecount()]);
+                                          allocate(tile->header()->directededgecount()));
       return &(inserted.first->second)[edgeid.id()];
     }
   }
 
 private:
+  // A block of EdgeStatusInfo, the first used of which are handed out
+  struct block_t {
+    std::unique_ptr<EdgeStatusInfo[]> data;
+    uint32_t size;
+    uint32_t used;
+  };
+
+  /**
+   * Get an array of count EdgeStatusInfo (all kUnreachedOrReset) from the
+   * blocks, adding a block if none of the remaining blocks has room.
+   * @param  count  Number of EdgeStatusInfo in the array.
+   * @return Returns a pointer to the first EdgeStatusInfo.
+   */
+  EdgeStatusInfo* allocate(const uint32_t count) {
+    for (; current_block_ < blocks_.size(); ++current_block_) {
+      auto& block = blocks_[current_block_];
+      if (block.size - block.used >= count) {
+        block.used += count;
+        return block.data.get() + block.used - count;
+      }
+    }
+
+    // Each new block is at least as large as all of the blocks before it so
+    // the number of blocks grows logarithmically with the memory used
+    uint32_t size = std::max(std::max(count, kMinEdgeStatusBlockSize), reserved_);
+    blocks_.push_back({std::unique_ptr<EdgeStatusInfo[]>(new EdgeStatusInfo[size]), size, count});
+    reserved_ += size;
+    ++allocations_;
+    return blocks_.back().data.get();
+  }
+
   // Edge status - keys are the tile Ids (level and tile Id) and the
-  // values are dynamically allocated arrays of EdgeStatusInfo (sized
-  // based on the directed edge count within the tile).
+  // values are arrays of EdgeStatusInfo (sized based on the directed
+  // edge count within the tile) within the blocks.
   std::unordered_map<uint32_t, EdgeStatusInfo*> edgestatus_;
+
+  std::vector<block_t> blocks_; // Blocks the arrays are taken from
+  size_t current_block_ = 0;    // First block that may have room
+  uint32_t reserved_ = 0;       // Number of EdgeStatusInfo in the blocks
+  uint64_t allocations_ = 0;    // Number of blocks allocated
 };
 
 } // namespace thor
@@ -18,6 +18,7 @@
 #include <valhalla/sif/edgelabel.h>
 #include <valhalla/thor/dijkstras.h>
 #include <valhalla/thor/edgestatus.h>
+#include <valhalla/thor/raptor.h>
 
 namespace valhalla {
 namespace thor {
@@ -87,6 +88,25 @@ public:
                     const std::shared_ptr<sif::DynamicCost>* mode_costing,
                     const sif::TravelMode mode);
 
+  /**
+   * Compute an isochrone grid for multi-modal routes using the round based
+   * transit algorithm rather than a single multi-modal expansion. The grid is
+   * populated with the earliest time each walked edge is reached.
+   * @param  origin_locations  List of origin locations.
+   * @param  max_minutes  Maximum time (minutes) for largest contour
+   * @param  graphreader  Graphreader
+   * @param  mode_costing List of costing objects
+   * @param  mode         Travel mode
+   * @param  raptor       Round based transit algorithm to expand with
+   */
+  std::shared_ptr<const midgard::GriddedData<midgard::PointLL>>
+  ComputeMultiModal(google::protobuf::RepeatedPtrField<valhalla::Location>& origin_locations,
+                    const unsigned int max_minutes,
+                    baldr::GraphReader& graphreader,
+                    const std::shared_ptr<sif::DynamicCost>* mode_costing,
+                    const sif::TravelMode mode,
+                    RaptorPathAlgorithm& raptor);
+
 protected:
   // when we expand up to a node we color the cells of the grid that the edge that ends at the
   // node touches
@@ -0,0 +1,113 @@
+#ifndef VALHALLA_THOR_ISOCHRONE_CACHE_H_
+#define VALHALLA_THOR_ISOCHRONE_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include <valhalla/midgard/gridded_data.h>
+#include <valhalla/midgard/pointll.h>
+#include <valhalla/proto/options.pb.h>
+
+namespace valhalla {
+namespace thor {
+
+/**
+ * Keeps the grids of recent isochrone expansions so that requests differing only
+ * in how the grid is turned into contours (contour times and colors, polygons or
+ * lines, denoise, generalize, show_locations) do not expand the graph again.
+ *
+ * Grids are keyed by the request with those output only options removed, which
+ * covers the snapped locations, the costing and its options and the date_time,
+ * and by the time the grid extends to. The grid of a longer expansion is not used
+ * for a shorter one as its cells (and the edges marked in them) differ. The least
+ * recently used grids are evicted once the total size of the grids exceeds the
+ * maximum size. A cache is used by a single worker so it is not locked.
+ */
+class IsochroneCache {
+public:
+  using grid_t = std::shared_ptr<const midgard::GriddedData<midgard::PointLL>>;
+
+  /**
+   * Constructor.
+   * @param  max_size  Maximum size of the cached grids in bytes (0 disables caching).
+   */
+  explicit IsochroneCache(const size_t max_size);
+
+  /**
+   * Get the key of the expansion an isochrone request needs.
+   * @param  options      Options of the request (after the locations are correlated).
+   * @param  multimodal   True if the expansion is multimodal.
+   * @param  max_minutes  Time (minutes) the grid extends to.
+   * @return Returns the key.
+   */
+  static std::string
+  Key(const Options& options, const bool multimodal, const unsigned int max_minutes);
+
+  /**
+   * Find the cached grid of an expansion.
+   * @param  key  Key of the expansion.
+   * @return Returns the grid or nullptr if there is none.
+   */
+  grid_t Find(const std::string& key);
+
+  /**
+   * Remember the grid of an expansion, replacing any grid with the same key.
+   * @param  key   Key of the expansion.
+   * @param  grid  The grid.
+   */
+  void Insert(const std::string& key, const grid_t& grid);
+
+  /**
+   * Forget all of the cached grids (and reset the counters).
+   */
+  void Clear();
+
+  /**
+   * Number of requests answered from a cached grid.
+   */
+  uint64_t hits() const {
+    return hits_;
+  }
+
+  /**
+   * Number of requests that had to expand the graph.
+   */
+  uint64_t misses() const {
+    return misses_;
+  }
+
+  /**
+   * Size in bytes of the cached grids.
+   */
+  size_t size() const {
+    return size_;
+  }
+
+protected:
+  struct entry_t {
+    std::string key;
+    grid_t grid;
+    size_t size;
+  };
+  using entries_t = std::list<entry_t>;
+
+  /**
+   * Remove an entry.
+   */
+  void Erase(entries_t::iterator entry);
+
+  size_t max_size_;                                            // Maximum size of the grids
+  size_t size_;                                                // Size of the cached grids
+  entries_t entries_;                                          // Most recently used first
+  std::unordered_map<std::string, entries_t::iterator> index_; // Entry of each key
+  uint64_t hits_;
+  uint64_t misses_;
+};
+
+} // namespace thor
+} // namespace valhalla
+
+#endif // VALHALLA_THOR_ISOCHRONE_CACHE_H_
@@ -0,0 +1,152 @@
+#ifndef VALHALLA_THOR_LOCAL_SEARCH_OPTIMIZER_H_
+#define VALHALLA_THOR_LOCAL_SEARCH_OPTIMIZER_H_
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace valhalla {
+namespace thor {
+
+// Default number of independent restarts (constructed tour + local search)
+constexpr uint32_t kDefaultOptimizerRestarts = 8;
+
+// Default time budget (milliseconds) after which no more restarts are started
+// (only applies to optimizers that were not seeded)
+constexpr uint32_t kDefaultOptimizerTimeBudget = 1000;
+
+// Number of nearest locations considered when looking for tour improvements
+constexpr uint32_t kOptimizerNeighbours = 10;
+
+/**
+ * Optimization method for larger numbers of locations. Builds tours with a
+ * (randomized) nearest neighbour construction and improves them with 2-opt and
+ * Or-opt moves restricted to the nearest neighbours of each location. Several
+ * independent restarts run on a pool of threads and the best tour is returned.
+ * Like Optimizer it keeps the first location (origin) and last location
+ * (destination) fixed and supports asymmetric costs.
+ *
+ * Once seeded the result only depends on the seed: each restart has its own
+ * random number generator, ties between restarts go to the lowest restart and
+ * all of the restarts run. Without a seed the time budget stops new restarts from
+ * starting (the first restart always runs), which bounds the time taken at the
+ * expense of the result depending on how fast the restarts ran.
+ */
+class LocalSearchOptimizer {
+public:
+  /**
+   * Constructor.
+   * @param  restarts     Number of independent restarts.
+   * @param  threads      Number of threads running the restarts.
+   * @param  time_budget  Milliseconds after which no more restarts are started
+   *                      unless the optimizer is seeded.
+   */
+  LocalSearchOptimizer(const uint32_t restarts = kDefaultOptimizerRestarts,
+                       const uint32_t threads = 1,
+                       const uint32_t time_budget = kDefaultOptimizerTimeBudget);
+
+  /**
+   * Optimize the tour through a set of locations given the cost matrix
+   * among all locations. The first location (origin) and last location
+   * (destination) remain fixed in the tour.
+   * @param  count  Number of locations.
+   * @param  costs  2-D cost matrix.
+   * @return Returns the tour as an updated order of locations visited to
+   *         complete the tour.
+   */
+  std::vector<uint32_t> Solve(const uint32_t count, const std::vector<float>& costs);
+
+  /**
+   * Seed the random number generators of the restarts. A seeded optimizer runs
+   * all of its restarts regardless of the time budget so that the same seed
+   * always gives the same tour.
+   * @param  seed  Seed to use for the random number generators.
+   */
+  void Seed(const uint64_t seed) {
+    seed_ = seed;
+    seeded_ = true;
+  }
+
+protected:
+  // A tour being improved along with what is needed to cost moves in constant time
+  struct tour_state_t {
+    std::vector<uint32_t> tour;     // Order of locations
+    std::vector<uint32_t> position; // Index in the tour of each location
+    std::vector<double> forward;    // Cost of the tour up to each index
+    std::vector<double> backward;   // Cost of the reversed tour up to each index
+  };
+
+  uint32_t restarts_;    // # of restarts
+  uint32_t threads_;     // # of threads running restarts
+  uint32_t time_budget_; // Milliseconds after which no restarts are started
+  uint64_t seed_;        // Seed of the first restart (restart r uses seed + r)
+  bool seeded_;          // Whether a seed was set (the time budget is then ignored)
+
+  uint32_t count_;                                  // # of locations
+  const std::vector<float>* costs_;                 // 2-D cost matrix
+  std::vector<std::vector<uint32_t>> successors_;   // Nearest locations from each location
+  std::vector<std::vector<uint32_t>> predecessors_; // Nearest locations to each location
+
+  /**
+   * Find the nearest successors and predecessors of each location.
+   */
+  void SetNeighbours();
+
+  /**
+   * Construct a tour by repeatedly going to a near unvisited location.
+   * @param  generator  Random number generator.
+   * @param  choices    Number of nearest unvisited locations to choose from
+   *                    (1 gives the plain nearest neighbour tour).
+   * @return Returns the tour.
+   */
+  std::vector<uint32_t> ConstructTour(std::mt19937_64& generator, const uint32_t choices) const;
+
+  /**
+   * Apply improving 2-opt and Or-opt moves until there are none left.
+   * @param  tour  Tour to improve.
+   */
+  void ImproveTour(std::vector<uint32_t>& tour) const;
+
+  /**
+   * Find and apply an improving 2-opt move (reversal of part of the tour).
+   * @param  state  Tour being improved.
+   * @return Returns true if the tour was improved.
+   */
+  bool TwoOpt(tour_state_t& state) const;
+
+  /**
+   * Find and apply an improving Or-opt move (moving 1 to 3 consecutive locations
+   * elsewhere in the tour).
+   * @param  state  Tour being improved.
+   * @return Returns true if the tour was improved.
+   */
+  bool OrOpt(tour_state_t& state) const;
+
+  /**
+   * Update the positions and cost sums after the tour changed.
+   * @param  state  Tour being improved.
+   */
+  void UpdateState(tour_state_t& state) const;
+
+  /**
+   * Get the cost for the specified tour (order of locations).
+   * @param  tour  Order that locations are traversed.
+   * @return Returns the total cost for the tour.
+   */
+  double TourCost(const std::vector<uint32_t>& tour) const;
+
+  /**
+   * Get the cost between two locations.
+   * @param  loc1  Location index 1.
+   * @param  loc2  Location index 2.
+   * @return Returns the cost between the 2 locations.
+   */
+  double Cost(const uint32_t loc1, const uint32_t loc2) const {
+    return (*costs_)[(loc1 * count_) + loc2];
+  }
+};
+
+} // namespace thor
+} // namespace valhalla
+
+#endif // VALHALLA_THOR_LOCAL_SEARCH_OPTIMIZER_H_
@@ -13,6 +13,7 @@
 #include <valhalla/sif/dynamiccost.h>
 #include <valhalla/thor/edgestatus.h>
 #include <valhalla/thor/pathinfo.h>
+#include <valhalla/thor/workingmemory.h>
 
 namespace valhalla {
 namespace thor {
@@ -91,6 +92,15 @@ public:
     expansion_callback_ = expansion_callback;
   }
 
+  /**
+   * Get the working memory kept between searches, to set its high-water mark
+   * or read its counters.
+   * @return Returns the working memory.
+   */
+  WorkingMemory& working_memory() {
+    return working_memory_;
+  }
+
 protected:
   const std::function<void()>* interrupt;
 
@@ -99,6 +109,9 @@ protected:
   // for tracking the expansion of the algorithm visually
   expansion_callback_t expansion_callback_;
 
+  // Edge labels, edge status and adjacency lists kept between searches
+  WorkingMemory working_memory_;
+
   /**
    * Check for path completion along the same edge. Edge ID in question
    * is along both an origin and destination and origin shows up at the
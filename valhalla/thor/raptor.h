@@ -0,0 +1,251 @@
+#ifndef VALHALLA_THOR_RAPTOR_H_
+#define VALHALLA_THOR_RAPTOR_H_
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <valhalla/baldr/double_bucket_queue.h>
+#include <valhalla/baldr/graphid.h>
+#include <valhalla/baldr/graphreader.h>
+#include <valhalla/baldr/transitdeparture.h>
+#include <valhalla/proto/tripcommon.pb.h>
+#include <valhalla/sif/dynamiccost.h>
+#include <valhalla/sif/edgelabel.h>
+#include <valhalla/thor/edgestatus.h>
+#include <valhalla/thor/pathalgorithm.h>
+#include <valhalla/thor/pathinfo.h>
+
+namespace valhalla {
+namespace thor {
+
+// Default maximum number of transit trips (rounds) in a path
+constexpr uint32_t kDefaultMaxTransitRounds = 5;
+
+/**
+ * Round based (RAPTOR style) multi-modal path algorithm for walking and transit.
+ * Rather than expanding walking and transit edges in a single priority queue
+ * each round rides every trip that can be boarded at the stops improved in the
+ * prior round and then walks (using pedestrian costing) from the stops reached
+ * by those rides to other stops and to the destination. Round k therefore finds
+ * the earliest arrival using at most k trips which yields the paths on the
+ * Pareto front of arrival time and number of transfers.
+ */
+class RaptorPathAlgorithm : public PathAlgorithm {
+public:
+  /**
+   * Callback with each walking edge settled during an expansion.
+   * @param  label  Edge label of the settled edge. Its time is the arrival at the end of the edge.
+   * @param  secs0  Time at the start of the edge.
+   */
+  using walk_callback_t = std::function<void(const sif::MMEdgeLabel& label, const float secs0)>;
+
+  /**
+   * Constructor.
+   * @param  max_rounds  Maximum number of transit trips in a path.
+   */
+  RaptorPathAlgorithm(const uint32_t max_rounds = kDefaultMaxTransitRounds);
+
+  /**
+   * Destructor
+   */
+  virtual ~RaptorPathAlgorithm();
+
+  /**
+   * Form multi-modal paths between an origin and destination location. Returns
+   * the earliest arriving path first followed by paths which arrive later but
+   * use fewer transit trips (up to the number of alternates requested).
+   * @param  origin  Origin location
+   * @param  dest    Destination location
+   * @param  graphreader  Graph reader for accessing routing graph.
+   * @param  mode_costing  An array of costing methods, one per TravelMode.
+   * @param  mode     Travel mode from the origin.
+   * @return  Returns the path edges (and elapsed time/modes at end of
+   *          each edge).
+   */
+  std::vector<std::vector<PathInfo>>
+  GetBestPath(valhalla::Location& origin,
+              valhalla::Location& dest,
+              baldr::GraphReader& graphreader,
+              const std::shared_ptr<sif::DynamicCost>* mode_costing,
+              const sif::TravelMode mode,
+              const Options& options = Options::default_instance());
+
+  /**
+   * Expand from the origin locations without a destination until the time limit
+   * is reached. Used to compute multi-modal isochrones.
+   * @param  origins      Origin locations. The first one must have a date_time.
+   * @param  graphreader  Graph reader for accessing routing graph.
+   * @param  mode_costing  An array of costing methods, one per TravelMode.
+   * @param  max_seconds  Time limit of the expansion.
+   * @param  walked       Called with every walking edge settled by the expansion.
+   */
+  void Expand(google::protobuf::RepeatedPtrField<valhalla::Location>& origins,
+              baldr::GraphReader& graphreader,
+              const std::shared_ptr<sif::DynamicCost>* mode_costing,
+              const uint32_t max_seconds,
+              const walk_callback_t& walked);
+
+  /**
+   * Clear the temporary information generated during path construction.
+   */
+  void Clear();
+
+protected:
+  uint32_t max_rounds_; // Max number of transit trips in a path
+
+  // Start time and timezone, date information used for the transit schedules
+  bool date_set_;
+  bool date_before_tile_;
+  uint32_t day_;
+  uint32_t dow_;
+  uint32_t start_time_;
+  int start_tz_index_;
+  std::string origin_date_time_;
+  std::unordered_map<uint32_t, int> tz_diffs_;
+
+  uint32_t max_seconds_;           // Time limit of the expansion
+  uint32_t max_transfer_distance_; // Max walking distance between transit stops
+  std::unordered_set<uint32_t> processed_tiles_;
+
+  // Edge labels of all phases (requires access by index). Labels are never
+  // modified once settled so paths can be formed from any of them.
+  std::vector<sif::MMEdgeLabel> edgelabels_;
+
+  // Adjacency list and edge status of the current walking phase
+  std::shared_ptr<baldr::DoubleBucketQueue> adjacencylist_;
+  EdgeStatus edgestatus_;
+
+  // Earliest arrival (label index) at each transit stop over all rounds and the
+  // stops improved in the current round
+  std::unordered_map<uint64_t, uint32_t> stop_arrivals_;
+  std::unordered_set<uint64_t> marked_stops_;
+
+  // Destination edges and the remainder cost from the destination to the end of the edge
+  std::map<uint64_t, sif::Cost> destinations_;
+
+  // Earliest arrival at the destination found in each round
+  struct destination_t {
+    uint32_t label;
+    sif::Cost cost;
+  };
+  std::vector<destination_t> destination_arrivals_;
+
+  // Called with every settled walking edge (for isochrones)
+  const walk_callback_t* walked_;
+
+  /**
+   * Initialize the start time, timezone and date information.
+   * @param  graphreader  Graph reader.
+   * @param  origin       Origin location with a date_time.
+   * @return Returns false if the timezone at the origin is unknown.
+   */
+  bool Init(baldr::GraphReader& graphreader, const valhalla::Location& origin);
+
+  /**
+   * Add edge labels for the edges at the origin. They are walked in the first round.
+   * @param  graphreader  Graph tile reader.
+   * @param  origin       Location information of the origin.
+   * @param  pc           Pedestrian costing.
+   */
+  void SetOrigin(baldr::GraphReader& graphreader,
+                 valhalla::Location& origin,
+                 const std::shared_ptr<sif::DynamicCost>& pc);
+
+  /**
+   * Set the destination edge(s).
+   * @param   graphreader  Graph tile reader.
+   * @param   dest         Location information of the destination.
+   * @param   pc           Pedestrian costing.
+   */
+  void SetDestination(baldr::GraphReader& graphreader,
+                      const valhalla::Location& dest,
+                      const std::shared_ptr<sif::DynamicCost>& pc);
+
+  /**
+   * Run the rounds. Walks from the origin edge labels and
+   * then alternates riding trips and walking until no stops are improved.
+   * @param  graphreader  Graph tile reader.
+   * @param  pc           Pedestrian costing.
+   * @param  tc           Transit costing.
+   */
+  void Compute(baldr::GraphReader& graphreader,
+               const std::shared_ptr<sif::DynamicCost>& pc,
+               const std::shared_ptr<sif::DynamicCost>& tc);
+
+  /**
+   * Ride the trips that can be boarded at the stops improved in the prior round.
+   * @param  graphreader  Graph tile reader.
+   * @param  tc           Transit costing.
+   * @return Returns the label indexes of the rides arriving at stops they improved.
+   */
+  std::vector<uint32_t> RideTrips(baldr::GraphReader& graphreader,
+                                  const std::shared_ptr<sif::DynamicCost>& tc);
+
+  /**
+   * Walk from the labels in the adjacency list (and from the end nodes of the
+   * seeds) until no labels remain within the time bound.
+   * @param  graphreader  Graph tile reader.
+   * @param  seeds        Labels (rides) to walk from the end nodes of.
+   * @param  pc           Pedestrian costing.
+   */
+  void Walk(baldr::GraphReader& graphreader,
+            const std::vector<uint32_t>& seeds,
+            const std::shared_ptr<sif::DynamicCost>& pc);
+
+  /**
+   * Expand from a node while walking.
+   * @param  graphreader  Graph tile reader.
+   * @param  node         Graph Id of the node being expanded.
+   * @param  pred         Predecessor edge label.
+   * @param  pred_idx     Predecessor index into the edge label list.
+   * @param  pc           Pedestrian costing.
+   * @param  from_transition True if this method is called from a transition edge.
+   */
+  void ExpandWalk(baldr::GraphReader& graphreader,
+                  const baldr::GraphId& node,
+                  const sif::MMEdgeLabel& pred,
+                  const uint32_t pred_idx,
+                  const std::shared_ptr<sif::DynamicCost>& pc,
+                  const bool from_transition);
+
+  /**
+   * Update the earliest arrival at a transit stop.
+   * @param  stop   Graph Id of the stop (platform) node.
+   * @param  label  Index of the label arriving at the stop.
+   * @return Returns true if this is the earliest arrival at the stop so far.
+   */
+  bool ImproveStop(const baldr::GraphId& stop, const uint32_t label);
+
+  /**
+   * The time beyond which labels cannot improve the result. This is the earliest
+   * arrival at the destination so far or the time limit of the expansion.
+   */
+  float Bound() const;
+
+  /**
+   * Convert between seconds from the start and local (schedule) time at a node.
+   */
+  uint32_t LocalTime(const float secs, const uint32_t tz_index);
+  float ElapsedTime(const uint32_t localtime, const uint32_t tz_index);
+
+  /**
+   * Form the path from the edge labels. Recovers the path from the destination
+   * backwards towards the origin (using predecessor information).
+   * @param   dest  Arrival at the destination.
+   * @return  Returns the path info, a list of GraphIds representing the
+   *          directed edges along the path - ordered from origin to
+   *          destination - along with travel modes and elapsed time.
+   */
+  std::vector<PathInfo> FormPath(const destination_t& dest);
+};
+
+} // namespace thor
+} // namespace valhalla
+
+#endif // VALHALLA_THOR_RAPTOR_H_
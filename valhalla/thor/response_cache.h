@@ -0,0 +1,145 @@
+#ifndef VALHALLA_THOR_RESPONSE_CACHE_H_
+#define VALHALLA_THOR_RESPONSE_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <boost/property_tree/ptree.hpp>
+
+#include <valhalla/baldr/graphreader.h>
+#include <valhalla/proto/options.pb.h>
+
+namespace valhalla {
+namespace thor {
+
+/**
+ * Keeps the serialized responses of heavy requests (isochrones and expansions) so that
+ * requests repeated with the same parameters are answered without any work. One cache is
+ * shared by all of the thor workers of a process reading the same tiles and it is locked.
+ *
+ * Responses are keyed by the parsed request, which covers the action, the output format and
+ * the snapped locations, plus the dataset id of the tile of the first location so that loading
+ * new tiles never returns old responses. The least recently used responses are evicted once
+ * their total size exceeds the maximum size. If a spill directory is configured the evicted
+ * responses are written to files named by the hash of their key, with their own maximum size,
+ * and are read back from there (by this or a later process) when requested again.
+ */
+class ResponseCache {
+public:
+  /**
+   * Constructor.
+   * @param  max_size        Maximum size of the responses kept in memory in bytes.
+   * @param  spill_dir       Directory the evicted responses are written to, empty for none.
+   * @param  max_spill_size  Maximum size of the responses in the spill directory in bytes.
+   */
+  ResponseCache(const size_t max_size,
+                const std::string& spill_dir = "",
+                const size_t max_spill_size = 0);
+
+  /**
+   * Get the cache configured by thor.response_cache_size, thor.response_cache_dir and
+   * thor.response_cache_dir_size, every worker reading the same tiles shares one.
+   * @param  config  The configuration.
+   * @return Returns the shared cache or nullptr if the size is 0 (the default).
+   */
+  static std::shared_ptr<ResponseCache> Shared(const boost::property_tree::ptree& config);
+
+  /**
+   * Get the key of the response to a request.
+   * @param  options  Options of the request (after the locations are correlated).
+   * @param  reader   Graph reader to get the dataset id of the tiles with.
+   * @return Returns the key or an empty string if the response cannot be cached.
+   */
+  static std::string Key(const Options& options, baldr::GraphReader& reader);
+
+  /**
+   * Find the response to a request.
+   * @param  key       Key of the response.
+   * @param  response  Set to the response if it was found.
+   * @return Returns true if the response was found.
+   */
+  bool Find(const std::string& key, std::string& response);
+
+  /**
+   * Remember the response to a request.
+   * @param  key       Key of the response.
+   * @param  response  The response.
+   */
+  void Insert(const std::string& key, const std::string& response);
+
+  /**
+   * Number of requests answered from the cache.
+   */
+  uint64_t hits() const;
+
+  /**
+   * Number of requests not found in the cache.
+   */
+  uint64_t misses() const;
+
+  /**
+   * Size in bytes of the responses kept in memory.
+   */
+  size_t size() const;
+
+  /**
+   * Size in bytes of the responses in the spill directory.
+   */
+  size_t spill_size() const;
+
+protected:
+  struct entry_t {
+    std::string key;
+    std::shared_ptr<const std::string> response;
+    size_t size;
+  };
+  using entries_t = std::list<entry_t>;
+
+  struct spilled_t {
+    std::string file;
+    size_t size;
+  };
+  using spilled_entries_t = std::list<spilled_t>;
+
+  /**
+   * The file a response is spilled to.
+   */
+  std::string File(const std::string& key) const;
+
+  /**
+   * Add an entry to the memory, returning the entries it evicted.
+   */
+  entries_t Add(entry_t&& entry);
+
+  /**
+   * Write evicted entries to the spill directory and evict the oldest files over its size.
+   */
+  void Spill(const entries_t& evicted);
+
+  /**
+   * Account for a file in the spill directory and remove the oldest files over its size.
+   */
+  void AddSpilled(const std::string& file, const size_t size);
+
+  mutable std::mutex lock_;
+  size_t max_size_;                                            // Maximum size of the responses
+  size_t size_;                                                // Size of the responses
+  entries_t entries_;                                          // Most recently used first
+  std::unordered_map<std::string, entries_t::iterator> index_; // Entry of each key
+  std::string spill_dir_;                                      // Empty if nothing is spilled
+  size_t max_spill_size_;                                      // Maximum size of the files
+  size_t spill_size_;                                          // Size of the files
+  spilled_entries_t spilled_;                                  // Most recently written first
+  std::unordered_map<std::string, spilled_entries_t::iterator> spilled_index_; // Of each file
+  uint64_t hits_;
+  uint64_t misses_;
+};
+
+} // namespace thor
+} // namespace valhalla
+
+#endif // VALHALLA_THOR_RESPONSE_CACHE_H_
@@ -132,6 +132,33 @@ public:
                  const sif::TravelMode mode,
                  const float max_matrix_distance);
 
+  /**
+   * Forms a time distance matrix from the set of source locations to the set
+   * of target locations, running the one to many (or many to one) searches
+   * of the rows on several threads. Each thread searches with its own search
+   * state from the pool and its own costing. The rows are put together in the
+   * same order as SourceToTarget so the result is identical.
+   * @param  pool                  Search states, one per thread (at least one).
+   * @param  mode_costings         Costing methods of each search state. Edge
+   *                               cost caches are not thread safe so the
+   *                               costings cannot be shared.
+   * @param  source_location_list  List of source/origin locations.
+   * @param  target_location_list  List of target/destination locations.
+   * @param  graphreader           Graph reader shared by the threads. Its tile
+   *                               cache has to be synchronized.
+   * @param  mode                  Travel mode to use.
+   * @param  max_matrix_distance   Maximum arc-length distance for current mode.
+   * @return time/distance from origin index to all other locations
+   */
+  static std::vector<TimeDistance>
+  SourceToTarget(std::vector<TimeDistanceMatrix>& pool,
+                 const std::vector<const std::shared_ptr<sif::DynamicCost>*>& mode_costings,
+                 const google::protobuf::RepeatedPtrField<valhalla::Location>& source_location_list,
+                 const google::protobuf::RepeatedPtrField<valhalla::Location>& target_location_list,
+                 baldr::GraphReader& graphreader,
+                 const sif::TravelMode mode,
+                 const float max_matrix_distance);
+
   /**
    * Clear the temporary information generated during time+distance
    * matrix construction.
@@ -21,9 +21,14 @@
 #include <valhalla/thor/attributes_controller.h>
 #include <valhalla/thor/bidirectional_astar.h>
 #include <valhalla/thor/isochrone.h>
+#include <valhalla/thor/isochrone_cache.h>
+#include <valhalla/thor/local_search_optimizer.h>
 #include <valhalla/thor/match_result.h>
 #include <valhalla/thor/multimodal.h>
+#include <valhalla/thor/raptor.h>
+#include <valhalla/thor/response_cache.h>
 #include <valhalla/thor/timedep.h>
+#include <valhalla/thor/timedistancematrix.h>
 #include <valhalla/thor/triplegbuilder.h>
 #include <valhalla/tyr/actor.h>
 #include <valhalla/worker.h>
@@ -93,12 +98,21 @@ protected:
   AStarPathAlgorithm astar;
   BidirectionalAStar bidir_astar;
   MultiModalPathAlgorithm multi_modal_astar;
+  RaptorPathAlgorithm raptor;
+  bool use_raptor; // Use the round based transit algorithm for multimodal requests
   TimeDepForward timedep_forward;
   TimeDepReverse timedep_reverse;
   Isochrone isochrone_gen;
+  IsochroneCache isochrone_cache; // Grids of recent isochrone expansions
+  std::shared_ptr<ResponseCache> response_cache; // Responses shared by the workers, may be null
+  bool use_local_search; // Order optimized routes with local search instead of annealing
+  LocalSearchOptimizer local_search_optimizer;
   std::shared_ptr<meili::MapMatcher> matcher;
   float long_request;
   float max_timedep_distance;
+  size_t edge_cost_cache_size; // Max bytes of edge costs remembered by multi-search requests
+  std::vector<TimeDistanceMatrix> matrix_pool; // Search states of parallel time distance matrices
+  std::shared_ptr<baldr::GraphReader> matrix_reader; // Synchronized reader shared by their threads
   std::unordered_map<std::string, float> max_matrix_distance;
   SOURCE_TO_TARGET_ALGORITHM source_to_target_algorithm;
   meili::MapMatcherFactory matcher_factory;
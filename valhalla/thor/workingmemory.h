@@ -0,0 +1,123 @@
+#ifndef VALHALLA_THOR_WORKINGMEMORY_H_
+#define VALHALLA_THOR_WORKINGMEMORY_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace valhalla {
+namespace thor {
+
+// Default memory (bytes) a path algorithm may keep between searches
+constexpr size_t kDefaultMaxReservedMemory = 128 * 1024 * 1024; // 128 MiB
+
+/**
+ * Keeps track of the working memory (edge labels, edge status and adjacency
+ * lists) a path algorithm holds on to between searches. Searches reuse the
+ * memory of earlier searches so that in the steady state they do not make any
+ * large allocations. When a search leaves more memory than the high-water mark
+ * it is released, so that one very long search does not pin that memory for
+ * the life of the worker.
+ *
+ * The counters show whether the memory is being recycled: once the searches of
+ * a worker are warmed up the number of growths should stop going up.
+ */
+class WorkingMemory {
+public:
+  /**
+   * Constructor.
+   * @param  max_reserved  High-water mark (bytes) of the memory kept between searches.
+   */
+  explicit WorkingMemory(const size_t max_reserved = kDefaultMaxReservedMemory)
+      : max_reserved_(max_reserved), reserved_(0), searches_(0), growths_(0), releases_(0) {
+  }
+
+  /**
+   * Record the memory reserved at the end of a search.
+   * @param  reserved  Memory (bytes) reserved by the path algorithm.
+   * @param  searched  Whether a search ran since the memory was last recorded. Path
+   *                   algorithms are cleared before a search as well as after it, a
+   *                   clear without a search in between is not counted again.
+   * @return Returns true if the memory is above the high-water mark and should
+   *         be released.
+   */
+  bool Reserved(const size_t reserved, const bool searched) {
+    if (!searched) {
+      return false;
+    }
+    ++searches_;
+    if (reserved > reserved_) {
+      ++growths_;
+    }
+    if (reserved > max_reserved_) {
+      ++releases_;
+      reserved_ = 0;
+      return true;
+    }
+    reserved_ = reserved;
+    return false;
+  }
+
+  /**
+   * Get the memory (bytes) reserved by a vector.
+   */
+  template <typename T> static size_t Bytes(const std::vector<T>& v) {
+    return v.capacity() * sizeof(T);
+  }
+
+  /**
+   * Clear a vector, freeing its memory if release is true.
+   */
+  template <typename T> static void Clear(std::vector<T>& v, const bool release) {
+    v.clear();
+    if (release) {
+      v.shrink_to_fit();
+    }
+  }
+
+  void set_max_reserved(const size_t max_reserved) {
+    max_reserved_ = max_reserved;
+  }
+
+  size_t max_reserved() const {
+    return max_reserved_;
+  }
+
+  // Memory (bytes) kept after the last search
+  size_t reserved() const {
+    return reserved_;
+  }
+
+  // Number of searches
+  uint64_t searches() const {
+    return searches_;
+  }
+
+  // Number of searches that had to reserve more memory than the search before
+  uint64_t growths() const {
+    return growths_;
+  }
+
+  // Number of searches after which the memory was released
+  uint64_t releases() const {
+    return releases_;
+  }
+
+  // Start counting again, e.g. once the counts have been reported
+  void ResetCounters() {
+    searches_ = 0;
+    growths_ = 0;
+    releases_ = 0;
+  }
+
+protected:
+  size_t max_reserved_;
+  size_t reserved_;
+  uint64_t searches_;
+  uint64_t growths_;
+  uint64_t releases_;
+};
+
+} // namespace thor
+} // namespace valhalla
+
+#endif // VALHALLA_THOR_WORKINGMEMORY_H_
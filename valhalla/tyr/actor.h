@@ -8,11 +8,17 @@
 #include <valhalla/proto/api.pb.h>
 
 namespace valhalla {
+namespace baldr {
+class GraphReader;
+}
 namespace tyr {
 
 class actor_t {
 public:
   actor_t(const boost::property_tree::ptree& config, bool auto_cleanup = false);
+  actor_t(const boost::property_tree::ptree& config,
+          const std::shared_ptr<baldr::GraphReader>& reader,
+          bool auto_cleanup = false);
   void cleanup();
   std::string route(const std::string& request_str,
                     const std::function<void()>& interrupt = []() -> void {});
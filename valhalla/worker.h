@@ -59,6 +59,7 @@ const std::unordered_map<unsigned, std::string>
                 {134, "Failed to parse shape"},
                 {135, "Failed to parse trace"},
                 {136, "durations size not compatible with trace size"},
+                {137, "Failed to parse avoid polygon"},
 
                 {140, "Action does not support multimodal costing"},
                 {141, "Arrive by for multimodal not implemented yet"},
@@ -81,6 +82,7 @@ const std::unordered_map<unsigned, std::string>
                 {162, "Date and time is invalid.  Format is YYYY-MM-DDTHH:MM"},
                 {163, "Invalid date_type"},
                 {164, "Invalid shape format"},
+                {165, "Exceeded max avoid polygons length"},
 
                 {170, "Locations are in unconnected regions. Go check/edit the map at osm.org"},
                 {171, "No suitable edges near location"},
@@ -165,6 +167,11 @@ void ParseApi(const std::string& json_request, Options::Action action, Api& api)
 void ParseApi(const prime_server::http_request_t& http_request, Api& api);
 #endif
 
+// adds the metrics of this process to the request unless a previous stage in it already did
+void add_metrics(Api& api);
+// merges the metrics every stage added into the Prometheus text format
+std::string serialize_metrics(const Api& api);
+
 #ifdef HAVE_HTTP
 prime_server::worker_t::result_t jsonify_error(const valhalla_exception_t& exception,
                                                prime_server::http_request_info_t& request_info,
@@ -181,6 +188,16 @@ prime_server::worker_t::result_t to_response_json(const std::string& json,
 prime_server::worker_t::result_t to_response_xml(const std::string& xml,
                                                  prime_server::http_request_info_t& request_info,
                                                  const Api& options);
+prime_server::worker_t::result_t to_response_pbf(const std::string& pbf,
+                                                 prime_server::http_request_info_t& request_info,
+                                                 const Api& options);
+prime_server::worker_t::result_t to_response_text(const std::string& text,
+                                                  prime_server::http_request_info_t& request_info,
+                                                  const Api& options);
+// responds with pbf if it was the requested format and with json otherwise
+prime_server::worker_t::result_t to_response(const std::string& data,
+                                             prime_server::http_request_info_t& request_info,
+                                             const Api& options);
 #endif
 
 class service_worker_t {